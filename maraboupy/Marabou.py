@@ -108,7 +108,8 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
                   preprocessorBoundTolerance=0.0000000001, dumpBounds=False,
                   tighteningStrategy="deeppoly", milpTightening="none", milpSolverTimeout=0,
                   numSimulations=10, numBlasThreads=1, performLpTighteningAfterSplit=False,
-                  lpSolver="", produceProofs=False):
+                  lpSolver="", produceProofs=False, streamSymbolicBounds=False,
+                  singlePrecisionSymbolicBounds=False, conflictLearning=False):
     """Create an options object for how Marabou should solve the query
 
     Args:
@@ -128,13 +129,16 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
         solveWithMILP (bool, optional): Whther to solve the input query with a MILP encoding. Currently only works when Gurobi is installed. Defaults to False.
         preprocessorBoundTolerance ( float, optional): epsilon value for preprocess bound tightening . Defaults to 10^-10.
         dumpBounds (bool, optional): Print out the bounds of each neuron after preprocessing. defaults to False
-        tighteningStrategy (string, optional): The abstract-interpretation-based bound tightening techniques used during the search (deeppoly/sbt/none). default to deeppoly.
+        tighteningStrategy (string, optional): The abstract-interpretation-based bound tightening techniques used during the search (deeppoly/alpha-deeppoly/sbt/none). default to deeppoly.
         milpTightening (string, optional): The (mi)lp-based bound tightening techniques used to preprocess the query (milp-inc/lp-inc/milp/lp/none). default to lp.
         milpSolverTimeout (float, optional): Timeout duration for MILP
         numSimulations (int, optional): Number of simulations generated per neuron, defaults to 10
         numBlasThreads (int, optional): Number of threads to use when using OpenBLAS matrix multiplication (e.g., for DeepPoly analysis), defaults to 1
         performLpTighteningAfterSplit (bool, optional): Whether to perform a LP tightening after a case split, defaults to False
         lpSolver (string, optional): the engine for solving LP (native/gurobi).
+        streamSymbolicBounds (bool, optional): Whether symbolic bound tightening frees the symbolic bounds of each layer once its successors are computed, defaults to False
+        singlePrecisionSymbolicBounds (bool, optional): Whether symbolic bound tightening stores its symbolic bounds in single precision, rounded outwards, defaults to False
+        conflictLearning (bool, optional): Whether to learn conflict clauses over the case splits and backjump non-chronologically, defaults to False
     Returns:
         :class:`~maraboupy.MarabouCore.Options`
     """
@@ -162,4 +166,7 @@ def createOptions(numWorkers=1, initialTimeout=5, initialSplits=0, onlineSplits=
     options._performLpTighteningAfterSplit = performLpTighteningAfterSplit
     options._lpSolver = lpSolver
     options._produceProofs = produceProofs
+    options._streamSymbolicBounds = streamSymbolicBounds
+    options._singlePrecisionSymbolicBounds = singlePrecisionSymbolicBounds
+    options._conflictLearning = conflictLearning
     return options
@@ -28,10 +28,12 @@
 #include "MarabouError.h"
 #include "MarabouMain.h"
 #include "MaxConstraint.h"
+#include "NetworkLevelReasoner.h"
 #include "NonlinearConstraint.h"
 #include "Options.h"
 #include "PiecewiseLinearConstraint.h"
 #include "PropertyParser.h"
+#include "Query.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
 #include "RoundConstraint.h"
@@ -44,6 +46,7 @@
 
 #include <fcntl.h>
 #include <map>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <set>
@@ -311,7 +314,11 @@ struct MarabouOptions
         , _milpTighteningString(
               Options::get()->getString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ).ascii() )
         , _lpSolverString( Options::get()->getString( Options::LP_SOLVER ).ascii() )
-        , _produceProofs( Options::get()->getBool( Options::PRODUCE_PROOFS ) ){};
+        , _produceProofs( Options::get()->getBool( Options::PRODUCE_PROOFS ) )
+        , _streamSymbolicBounds( Options::get()->getBool( Options::STREAM_SYMBOLIC_BOUNDS ) )
+        , _singlePrecisionSymbolicBounds(
+              Options::get()->getBool( Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS ) )
+        , _conflictLearning( Options::get()->getBool( Options::CONFLICT_DRIVEN_LEARNING ) ){};
 
     void setOptions()
     {
@@ -323,6 +330,10 @@ struct MarabouOptions
         Options::get()->setBool( Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT,
                                  _performLpTighteningAfterSplit );
         Options::get()->setBool( Options::PRODUCE_PROOFS, _produceProofs );
+        Options::get()->setBool( Options::STREAM_SYMBOLIC_BOUNDS, _streamSymbolicBounds );
+        Options::get()->setBool( Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS,
+                                 _singlePrecisionSymbolicBounds );
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, _conflictLearning );
 
         // int options
         Options::get()->setInt( Options::NUM_WORKERS, _numWorkers );
@@ -356,6 +367,9 @@ struct MarabouOptions
     bool _dumpBounds;
     bool _performLpTighteningAfterSplit;
     bool _produceProofs;
+    bool _streamSymbolicBounds;
+    bool _singlePrecisionSymbolicBounds;
+    bool _conflictLearning;
     unsigned _numWorkers;
     unsigned _numBlasThreads;
     unsigned _initialTimeout;
@@ -520,6 +534,85 @@ calculateBounds( InputQuery &inputQuery, MarabouOptions &options, std::string re
     return std::make_tuple( resultString, ret, retStats );
 }
 
+/*
+  Evaluate the network encoded in an input query on a batch of inputs,
+  given as a (batchSize x numInputVariables) array ordered by input
+  index. The network is recovered from the equations and constraints of
+  the query, as done by the preprocessor, and all samples are evaluated
+  together. Returns a (batchSize x numOutputVariables) array of the
+  outputs, ordered by output index.
+*/
+py::array_t<double>
+evaluateNetwork( InputQuery &inputQuery,
+                 py::array_t<double, py::array::c_style | py::array::forcecast> inputs )
+{
+    std::unique_ptr<Query> query( inputQuery.generateQuery() );
+    unsigned numInputs = query->getNumInputVariables();
+    unsigned numOutputs = query->getNumOutputVariables();
+
+    if ( inputs.ndim() != 2 || (unsigned)inputs.shape( 1 ) != numInputs )
+        throw py::value_error( "Expected an array of shape (batchSize, " +
+                               std::to_string( numInputs ) + ")" );
+
+    List<Equation> unhandledEquations;
+    Set<unsigned> varsInUnhandledConstraints;
+    if ( !query->constructNetworkLevelReasoner( unhandledEquations, varsInUnhandledConstraints ) )
+        throw py::value_error( "Could not construct a network from the input query" );
+    NLR::NetworkLevelReasoner *nlr = query->getNetworkLevelReasoner();
+
+    Map<unsigned, NLR::NeuronIndex> variableToNeuron;
+    for ( const auto &pair : nlr->getLayerIndexToLayer() )
+    {
+        for ( unsigned neuron = 0; neuron < pair.second->getSize(); ++neuron )
+        {
+            if ( pair.second->neuronHasVariable( neuron ) )
+                variableToNeuron[pair.second->neuronToVariable( neuron )] =
+                    NLR::NeuronIndex( pair.first, neuron );
+        }
+    }
+
+    for ( unsigned i = 0; i < numOutputs; ++i )
+    {
+        if ( !variableToNeuron.exists( query->outputVariableByIndex( i ) ) )
+            throw py::value_error( "Output variable " +
+                                   std::to_string( query->outputVariableByIndex( i ) ) +
+                                   " is not part of the network" );
+    }
+
+    unsigned batchSize = inputs.shape( 0 );
+    py::array_t<double> result( { (py::ssize_t)batchSize, (py::ssize_t)numOutputs } );
+    if ( batchSize == 0 )
+        return result;
+
+    // The input layer of the network is ordered by variable, not by input
+    // index
+    const double *inputData = inputs.data();
+    std::vector<double> networkInputs( batchSize * numInputs );
+    for ( unsigned i = 0; i < numInputs; ++i )
+    {
+        unsigned neuron = variableToNeuron[query->inputVariableByIndex( i )]._neuron;
+        for ( unsigned b = 0; b < batchSize; ++b )
+            networkInputs[b * numInputs + neuron] = inputData[b * numInputs + i];
+    }
+
+    const NLR::Layer *lastLayer = nlr->getLayer( nlr->getNumberOfLayers() - 1 );
+    std::vector<double> networkOutputs( batchSize * lastLayer->getSize() );
+    nlr->evaluate( networkInputs.data(), batchSize, networkOutputs.data() );
+
+    // Output variables may belong to any layer
+    double *resultData = result.mutable_data();
+    for ( unsigned i = 0; i < numOutputs; ++i )
+    {
+        NLR::NeuronIndex index = variableToNeuron[query->outputVariableByIndex( i )];
+        const NLR::Layer *layer = nlr->getLayer( index._layer );
+        const double *values = layer->getBatchAssignment();
+        for ( unsigned b = 0; b < batchSize; ++b )
+            resultData[b * numOutputs + i] = values[b * layer->getSize() + index._neuron];
+    }
+
+    return result;
+}
+
 void saveQuery( InputQuery &inputQuery, std::string filename )
 {
     inputQuery.saveQuery( String( filename ) );
@@ -566,7 +659,11 @@ PYBIND11_MODULE( MarabouCore, m )
         .def_readwrite( "_numSimulations", &MarabouOptions::_numSimulations )
         .def_readwrite( "_performLpTighteningAfterSplit",
                         &MarabouOptions::_performLpTighteningAfterSplit )
-        .def_readwrite( "_produceProofs", &MarabouOptions::_produceProofs );
+        .def_readwrite( "_produceProofs", &MarabouOptions::_produceProofs )
+        .def_readwrite( "_streamSymbolicBounds", &MarabouOptions::_streamSymbolicBounds )
+        .def_readwrite( "_singlePrecisionSymbolicBounds",
+                        &MarabouOptions::_singlePrecisionSymbolicBounds )
+        .def_readwrite( "_conflictLearning", &MarabouOptions::_conflictLearning );
     m.def( "maraboupyMain", &maraboupyMain, "Run the Marabou command-line interface" );
     m.def( "loadProperty", &loadProperty, "Load a property file into a input query" );
     m.def( "createInputQuery",
@@ -610,6 +707,20 @@ PYBIND11_MODULE( MarabouCore, m )
            py::arg( "inputQuery" ),
            py::arg( "options" ),
            py::arg( "redirect" ) = "" );
+    m.def( "evaluateNetwork",
+           &evaluateNetwork,
+           R"pbdoc(
+        Evaluate the network encoded in the input query on a batch of inputs
+
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query encoding the network
+            inputs (numpy.ndarray): Array of shape (batchSize, number of input variables), ordered by input index
+
+        Returns:
+            (numpy.ndarray): Array of shape (batchSize, number of output variables), ordered by output index
+        )pbdoc",
+           py::arg( "inputQuery" ),
+           py::arg( "inputs" ) );
     m.def( "saveQuery",
            &saveQuery,
            R"pbdoc(
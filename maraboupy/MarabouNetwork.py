@@ -160,6 +160,33 @@ class MarabouNetwork(InputQueryBuilder):
             outputValues[i] = outputValues[i].reshape(outputVars[i].shape)
         return outputValues
 
+    def evaluateBatch(self, inputValues):
+        """Function to evaluate network at a batch of points, without invoking the solver
+
+        The network is recovered from the input query and all points are evaluated together
+        in native code, which is much faster than evaluating the points one at a time.
+
+        Args:
+            inputValues (list of np arrays): Inputs to evaluate, where the i-th array has shape
+                (batchSize,) + shape of the i-th input
+
+        Returns:
+            (list of np arrays): Values representing the outputs of the network, where the i-th
+                array has shape (batchSize,) + shape of the i-th output
+        """
+        inputValues = [np.array(inVal, dtype=np.float64) for inVal in inputValues]
+        batchSize = inputValues[0].shape[0]
+        inputArray = np.concatenate([inVal.reshape(batchSize, -1) for inVal in inputValues], axis=1)
+
+        outputArray = MarabouCore.evaluateNetwork(self.getInputQuery(), inputArray)
+
+        outputValues = []
+        start = 0
+        for outVars in self.outputVars:
+            outputValues.append(outputArray[:, start:start + outVars.size].reshape((batchSize,) + outVars.shape))
+            start += outVars.size
+        return outputValues
+
     def evaluate(self, inputValues, useMarabou=True, options=None, filename="evaluateWithMarabou.log"):
         """Function to evaluate network at a given point
 
@@ -5,6 +5,7 @@ warnings.filterwarnings('ignore', category = PendingDeprecationWarning)
 
 import pytest
 from maraboupy import Marabou
+import numpy as np
 import os
 
 # Global settings
@@ -116,6 +117,28 @@ def test_acas_2_9_normalize():
     ]
     evaluateFile(filename, testInputs, testOutputs, normalize = True)
 
+def test_evaluate_batch():
+    """
+    Test evaluating a batch of points of the 1,1 experimental ACAS Xu network at once
+    """
+    filename = "acasxu/ACASXU_experimental_v2a_1_1.nnet"
+    filename = os.path.join(os.path.dirname(__file__), NETWORK_FOLDER, filename)
+    network = Marabou.read_nnet(filename)
+
+    testInputs = np.array([
+        [-0.31182839647533234, 0.0, -0.2387324146378273, -0.5, -0.4166666666666667],
+        [-0.16247807039378703, -0.4774648292756546, -0.2387324146378273, -0.3181818181818182, -0.25],
+        [-0.2454504737724233, -0.4774648292756546, 0.0, -0.3181818181818182, 0.0]
+    ])
+    testOutputs = np.array([
+        [0.45556007, 0.44454904, 0.49616356, 0.38924966, 0.50136678],
+        [-0.02158248, -0.01885345, -0.01892334, -0.01892597, -0.01893113],
+        [0.05990158, 0.05273383, 0.10029709, 0.01883183, 0.10521622]
+    ])
+
+    batchEval = network.evaluateBatch([testInputs])[0].reshape(len(testInputs), -1)
+    assert np.max(np.abs(batchEval - testOutputs)) < TOL
+
 def test_evaluateUNSAT():
     """
     When an UNSAT system is evaluated, evaluateWithMarabou should return None
@@ -19,6 +19,7 @@
 #include "ForrestTomlinFactorization.h"
 #include "GlobalConfiguration.h"
 #include "LUFactorization.h"
+#include "Options.h"
 #include "SparseFTFactorization.h"
 #include "SparseLUFactorization.h"
 
@@ -38,12 +39,24 @@ IBasisFactorization *BasisFactorizationFactory::createBasisFactorization(
     // FT
     else if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE ==
               GlobalConfiguration::FORREST_TOMLIN_FACTORIZATION )
-        return new ForrestTomlinFactorization( basisSize, basisColumnOracle );
+    {
+        IBasisFactorization *factorization =
+            new ForrestTomlinFactorization( basisSize, basisColumnOracle );
+        factorization->setRefactorizationPolicyType(
+            Options::get()->getRefactorizationPolicyType() );
+        return factorization;
+    }
 
     // Sparse FT
     else if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE ==
               GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION )
-        return new SparseFTFactorization( basisSize, basisColumnOracle );
+    {
+        IBasisFactorization *factorization =
+            new SparseFTFactorization( basisSize, basisColumnOracle );
+        factorization->setRefactorizationPolicyType(
+            Options::get()->getRefactorizationPolicyType() );
+        return factorization;
+    }
 
     throw BasisFactorizationError( BasisFactorizationError::UNKNOWN_BASIS_FACTORIZATION_TYPE );
 }
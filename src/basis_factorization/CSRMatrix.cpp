@@ -20,6 +20,7 @@
 #include "FloatUtils.h"
 #include "MString.h"
 #include "SparseUnsortedList.h"
+#include "Vector.h"
 
 CSRMatrix::CSRMatrix()
     : _m( 0 )
@@ -77,6 +78,60 @@ void CSRMatrix::initialize( const double *M, unsigned m, unsigned n )
     }
 }
 
+void CSRMatrix::initialize( const SparseUnsortedList **V, unsigned m, unsigned n )
+{
+    freeMemoryIfNeeded();
+
+    _m = m;
+    _n = n;
+
+    // Allocate exactly as much memory as needed, which is proportional to nnz
+    _estimatedNnz = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+        _estimatedNnz += V[i]->getNnz();
+    _estimatedNnz = std::max( 2U, _estimatedNnz );
+
+    _A = new double[_estimatedNnz];
+    if ( !_A )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::A" );
+
+    _IA = new unsigned[_m + 1];
+    if ( !_IA )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "CSRMatrix::IA" );
+
+    _JA = new unsigned[_estimatedNnz];
+    if ( !_JA )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "CSRMatrix::JA" );
+
+    // The rows are unsorted, so sort each one before storing it
+    Vector<std::pair<unsigned, double>> row;
+
+    _nnz = 0;
+    _IA[0] = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        row.clear();
+        for ( const auto &entry : *V[i] )
+        {
+            // Ignore zero entries
+            if ( !FloatUtils::isZero( entry._value ) )
+                row.append( std::make_pair( entry._index, entry._value ) );
+        }
+        row.sort();
+
+        for ( const auto &entry : row )
+        {
+            _A[_nnz] = entry.second;
+            _JA[_nnz] = entry.first;
+            ++_nnz;
+        }
+
+        _IA[i + 1] = _nnz;
+    }
+}
+
 void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
 {
     _m = m;
@@ -107,8 +162,9 @@ void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
 
 void CSRMatrix::increaseCapacity()
 {
+    // Grow geometrically, so that memory stays proportional to nnz
     unsigned estimatedNumRowEntries = std::max( 2U, _n / ROW_DENSITY_ESTIMATE );
-    unsigned newEstimatedNnz = _estimatedNnz + ( estimatedNumRowEntries * _m );
+    unsigned newEstimatedNnz = _estimatedNnz + std::max( _estimatedNnz, estimatedNumRowEntries );
 
     double *newA = new double[newEstimatedNnz];
     if ( !newA )
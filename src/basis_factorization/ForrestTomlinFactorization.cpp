@@ -19,6 +19,8 @@
 #include "EtaMatrix.h"
 #include "FloatUtils.h"
 #include "MalformedBasisException.h"
+#include "Statistics.h"
+#include "TimeUtils.h"
 
 #include <cstdlib>
 #include <cstring>
@@ -32,6 +34,7 @@ ForrestTomlinFactorization::ForrestTomlinFactorization( unsigned m,
     , _invQ( m )
     , _U( NULL )
     , _explicitBasisAvailable( false )
+    , _statistics( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
     , _workW( NULL )
@@ -299,8 +302,10 @@ void ForrestTomlinFactorization::updateToAdjacentBasis( unsigned columnIndex,
     // Finally, append the new As to the list
     _A.append( newAs );
 
-    // If the number of A matrices is too great, condense them.
-    if ( _A.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+    _refactorizationPolicy.notifyUpdate( computeTransformationCost() );
+
+    // If the A matrices have become too costly, condense them.
+    if ( _refactorizationPolicy.shouldRefactorize( _A.size() ) )
         obtainFreshBasis();
 }
 
@@ -393,6 +398,8 @@ void ForrestTomlinFactorization::forwardTransformation( const double *y, double
     // We are now left with invQ x = w (for our modified w). Multiply by Q and be done.
     for ( unsigned i = 0; i < _m; ++i )
         x[i] = _workW[_Q._rowOrdering[i]];
+
+    _refactorizationPolicy.notifyTransformation();
 }
 
 void ForrestTomlinFactorization::backwardTransformation( const double *y, double *x ) const
@@ -498,6 +505,8 @@ void ForrestTomlinFactorization::backwardTransformation( const double *y, double
                 x[columnIndex] = 0.0;
         }
     }
+
+    _refactorizationPolicy.notifyTransformation();
 }
 
 void ForrestTomlinFactorization::storeFactorization( IBasisFactorization *other )
@@ -570,6 +579,10 @@ void ForrestTomlinFactorization::restoreFactorization( const IBasisFactorization
 
     for ( const auto &a : otherFTFactorization->_A )
         _A.append( new AlmostIdentityMatrix( *a ) );
+
+    // Refactorizing later will cost as much as if these factors had been computed here
+    _refactorizationPolicy.notifyRefactorization( computeRefactorizationCost(),
+                                                  computeTransformationCost() );
 }
 
 void ForrestTomlinFactorization::clearFactorization()
@@ -877,9 +890,50 @@ void ForrestTomlinFactorization::obtainFreshBasis()
             _B[row * _m + column] = _workVector[row];
     }
 
+    struct timespec start = TimeUtils::sampleMicro();
+
     clearFactorization();
     initialLUFactorization();
     _explicitBasisAvailable = true;
+
+    _refactorizationPolicy.notifyRefactorization( computeRefactorizationCost(),
+                                                  computeTransformationCost() );
+
+    if ( _statistics )
+    {
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics->incLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS );
+        _statistics->incLongAttribute( Statistics::TOTAL_TIME_BASIS_REFACTORIZATION_MICRO,
+                                       TimeUtils::timePassed( start, end ) );
+    }
+}
+
+unsigned long long ForrestTomlinFactorization::computeRefactorizationCost() const
+{
+    // Dense Gaussian elimination
+    return (unsigned long long)_m * _m * _m / 3 + (unsigned long long)_m * _m;
+}
+
+unsigned long long ForrestTomlinFactorization::computeTransformationCost() const
+{
+    // The L matrices are dense columns, U is triangular, and each A matrix has a single entry
+    return (unsigned long long)_LP.size() * _m + (unsigned long long)_m * _m / 2 + _A.size();
+}
+
+void ForrestTomlinFactorization::setStatistics( Statistics *statistics )
+{
+    _statistics = statistics;
+    _refactorizationPolicy.setStatistics( statistics );
+}
+
+void ForrestTomlinFactorization::setRefactorizationPolicyType( RefactorizationPolicyType type )
+{
+    _refactorizationPolicy.setType( type );
+}
+
+void ForrestTomlinFactorization::notifyDegradation( double degradation )
+{
+    _refactorizationPolicy.notifyDegradation( degradation );
 }
 
 //
@@ -21,6 +21,7 @@
 #include "LPElement.h"
 #include "List.h"
 #include "PermutationMatrix.h"
+#include "RefactorizationPolicy.h"
 
 /*
   Forrest-Tomlin factorization looks like this:
@@ -99,6 +100,18 @@ public:
      */
     void invertBasis( double *result );
 
+    /*
+      Have the Basis Factoriaztion object start reporting statistics.
+    */
+    void setStatistics( Statistics *statistics );
+
+    /*
+      Select when the factorization is recomputed from scratch, and
+      inform it of the numerical degradation observed by the engine.
+    */
+    void setRefactorizationPolicyType( RefactorizationPolicyType type );
+    void notifyDegradation( double degradation );
+
 public:
     /*
       For testing purposes only
@@ -139,6 +152,17 @@ private:
     */
     bool _explicitBasisAvailable;
 
+    /*
+      An object for reporting statistics
+    */
+    Statistics *_statistics;
+
+    /*
+      Decides when the factorization is recomputed from scratch. It is
+      informed of every transformation, hence mutable.
+    */
+    mutable RefactorizationPolicy _refactorizationPolicy;
+
     /*
       Work memory
     */
@@ -155,6 +179,14 @@ private:
     void clearFactorization();
     void initialLUFactorization();
 
+    /*
+      Estimates, for the refactorization policy, of the number of entries
+      touched by a refactorization, and by a single forward or backward
+      transformation with the current factors and A matrices.
+    */
+    unsigned long long computeRefactorizationCost() const;
+    unsigned long long computeTransformationCost() const;
+
     /*
       Swap two rows of a matrix.
     */
@@ -16,6 +16,9 @@
 #ifndef __IBasisFactorization_h__
 #define __IBasisFactorization_h__
 
+#include "BasisFactorizationError.h"
+#include "RefactorizationPolicyType.h"
+
 class SparseColumnsOfBasis;
 class SparseMatrix;
 class SparseUnsortedList;
@@ -78,6 +81,42 @@ public:
     */
     virtual void backwardTransformation( const double *y, double *x ) const = 0;
 
+    /*
+      Hypersparse variants of the forward and backward transformations,
+      for right-hand sides with few non-zero entries. The non-zero entries
+      of y are confined to the yNnz indices listed in yIndices. x needs to
+      be all zeros on entry. On exit, the non-zero entries of x are
+      confined to the indices listed in xIndices, and the number of these
+      indices is returned. Both index arrays need to be of size m.
+
+      These are only available if supportsHypersparseTransformations()
+      returns true.
+    */
+    virtual bool supportsHypersparseTransformations() const
+    {
+        return false;
+    }
+
+    virtual unsigned hypersparseForwardTransformation( const double * /* y */,
+                                                       const unsigned * /* yIndices */,
+                                                       unsigned /* yNnz */,
+                                                       double * /* x */,
+                                                       unsigned * /* xIndices */ ) const
+    {
+        throw BasisFactorizationError( BasisFactorizationError::FEATURE_NOT_YET_SUPPORTED,
+                                       "Hypersparse forward transformation" );
+    }
+
+    virtual unsigned hypersparseBackwardTransformation( const double * /* y */,
+                                                        const unsigned * /* yIndices */,
+                                                        unsigned /* yNnz */,
+                                                        double * /* x */,
+                                                        unsigned * /* xIndices */ ) const
+    {
+        throw BasisFactorizationError( BasisFactorizationError::FEATURE_NOT_YET_SUPPORTED,
+                                       "Hypersparse backward transformation" );
+    }
+
     /*
       Store/restore the basis factorization.
     */
@@ -116,6 +155,14 @@ public:
     */
     virtual void setStatistics( Statistics * ){};
 
+    /*
+      Select when a factorization that is updated in place is recomputed
+      from scratch, and inform it of the numerical degradation observed by
+      the engine. Factorizations that are not updated in place ignore these.
+    */
+    virtual void setRefactorizationPolicyType( RefactorizationPolicyType /* type */ ){};
+    virtual void notifyDegradation( double /* degradation */ ){};
+
     /*
       For debugging
     */
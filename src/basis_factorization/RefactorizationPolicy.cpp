@@ -0,0 +1,130 @@
+/*********************                                                        */
+/*! \file RefactorizationPolicy.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "RefactorizationPolicy.h"
+
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "Statistics.h"
+
+RefactorizationPolicy::RefactorizationPolicy()
+    : _type( RefactorizationPolicyType::FIXED )
+    , _refactorizationCost( 0 )
+    , _transformationCost( 0 )
+    , _accumulatedCost( 0 )
+    , _numUpdates( 0 )
+    , _numTransformations( 0 )
+    , _degradation( 0 )
+    , _statistics( NULL )
+{
+}
+
+void RefactorizationPolicy::setType( RefactorizationPolicyType type )
+{
+    _type = type;
+}
+
+RefactorizationPolicyType RefactorizationPolicy::getType() const
+{
+    return _type;
+}
+
+void RefactorizationPolicy::setStatistics( Statistics *statistics )
+{
+    _statistics = statistics;
+}
+
+void RefactorizationPolicy::notifyRefactorization( unsigned long long refactorizationCost,
+                                                   unsigned long long transformationCost )
+{
+    _refactorizationCost = refactorizationCost;
+    _transformationCost = transformationCost;
+    _accumulatedCost = refactorizationCost;
+    _numUpdates = 0;
+    _numTransformations = 0;
+    _degradation = 0;
+}
+
+void RefactorizationPolicy::notifyUpdate( unsigned long long transformationCost )
+{
+    ++_numUpdates;
+    _transformationCost = transformationCost;
+}
+
+void RefactorizationPolicy::notifyDegradation( double degradation )
+{
+    _degradation = degradation;
+}
+
+bool RefactorizationPolicy::shouldRefactorize( unsigned numUpdateMatrices )
+{
+    if ( _type == RefactorizationPolicyType::FIXED )
+    {
+        if ( numUpdateMatrices <= GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+            return false;
+
+        if ( _statistics )
+            _statistics->incLongAttribute(
+                Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST );
+        return true;
+    }
+
+    // Nothing to gain from refactorizing factors that have not been updated
+    if ( _numUpdates == 0 )
+        return false;
+
+    if ( FloatUtils::gt( _degradation,
+                         GlobalConfiguration::ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD ) )
+    {
+        if ( _statistics )
+            _statistics->incLongAttribute(
+                Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION );
+        return true;
+    }
+
+    // The expected cost of the next update, assuming it performs as many
+    // transformations as the previous ones did on average
+    double expectedCostOfNextUpdate =
+        (double)_numTransformations / _numUpdates * _transformationCost;
+
+    if ( _numUpdates < GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES &&
+         expectedCostOfNextUpdate <= getAverageCostPerUpdate() )
+        return false;
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST );
+    return true;
+}
+
+unsigned RefactorizationPolicy::getNumUpdates() const
+{
+    return _numUpdates;
+}
+
+double RefactorizationPolicy::getAverageCostPerUpdate() const
+{
+    if ( _numUpdates == 0 )
+        return (double)_accumulatedCost;
+
+    return (double)_accumulatedCost / _numUpdates;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
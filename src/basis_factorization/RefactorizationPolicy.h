@@ -0,0 +1,135 @@
+/*********************                                                        */
+/*! \file RefactorizationPolicy.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __RefactorizationPolicy_h__
+#define __RefactorizationPolicy_h__
+
+#include "RefactorizationPolicyType.h"
+
+class Statistics;
+
+/*
+  This class decides when a basis factorization that is updated in place
+  (e.g., Forrest-Tomlin) should be recomputed from scratch.
+
+  Under the fixed policy, this happens once the number of update
+  matrices exceeds REFACTORIZATION_THRESHOLD.
+
+  Under the adaptive policy, the factorization reports the cost of the
+  last refactorization, and the cost of a single transformation (FTRAN or
+  BTRAN) with the current factors and update matrices. Costs are measured
+  in the number of entries touched, so the decisions are deterministic.
+  After k updates, the average cost per update is
+
+      ( refactorization cost + cost of all transformations so far ) / k
+
+  Each update makes the transformations more expensive, so this average
+  first decreases and then increases. The basis is refactorized once the
+  expected cost of the next update exceeds the current average, i.e. when
+  the average is minimal. Independently, the basis is refactorized when
+  the numerical degradation reported by the engine is high, or when the
+  number of updates reaches ADAPTIVE_REFACTORIZATION_MAX_UPDATES.
+*/
+class RefactorizationPolicy
+{
+public:
+    RefactorizationPolicy();
+
+    void setType( RefactorizationPolicyType type );
+    RefactorizationPolicyType getType() const;
+
+    /*
+      Have the policy start reporting statistics.
+    */
+    void setStatistics( Statistics *statistics );
+
+    /*
+      The basis has been factorized from scratch. The parameters are the
+      cost of the factorization, and the cost of a single transformation
+      with the new factors.
+    */
+    void notifyRefactorization( unsigned long long refactorizationCost,
+                                unsigned long long transformationCost );
+
+    /*
+      The factorization has been updated to an adjacent basis. The
+      parameter is the cost of a single transformation after the update.
+    */
+    void notifyUpdate( unsigned long long transformationCost );
+
+    /*
+      A forward or backward transformation has been performed.
+    */
+    inline void notifyTransformation()
+    {
+        ++_numTransformations;
+        _accumulatedCost += _transformationCost;
+    }
+
+    /*
+      The engine has measured the numerical degradation of the current
+      assignment.
+    */
+    void notifyDegradation( double degradation );
+
+    /*
+      Return true iff the factorization, currently holding numUpdateMatrices
+      update (eta) matrices, should be recomputed from scratch. If it
+      returns true, the reason is recorded in the statistics.
+    */
+    bool shouldRefactorize( unsigned numUpdateMatrices );
+
+    /*
+      For testing purposes
+    */
+    unsigned getNumUpdates() const;
+    double getAverageCostPerUpdate() const;
+
+private:
+    RefactorizationPolicyType _type;
+
+    /*
+      The cost of the last refactorization, of a single transformation with
+      the current factorization, and of the last refactorization together
+      with all the transformations performed since.
+    */
+    unsigned long long _refactorizationCost;
+    unsigned long long _transformationCost;
+    unsigned long long _accumulatedCost;
+
+    /*
+      The number of updates and transformations since the last
+      refactorization.
+    */
+    unsigned _numUpdates;
+    unsigned long long _numTransformations;
+
+    /*
+      The last degradation reported by the engine.
+    */
+    double _degradation;
+
+    Statistics *_statistics;
+};
+
+#endif // __RefactorizationPolicy_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -20,6 +20,7 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "MalformedBasisException.h"
+#include "TimeUtils.h"
 
 SparseFTFactorization::SparseFTFactorization( unsigned m,
                                               const BasisColumnOracle &basisColumnOracle )
@@ -33,6 +34,9 @@ SparseFTFactorization::SparseFTFactorization( unsigned m,
     , _z2( NULL )
     , _z3( NULL )
     , _z4( NULL )
+    , _hypersparseWork( NULL )
+    , _hypersparseIndices( NULL )
+    , _hypersparseMarked( NULL )
 {
     _z1 = new double[m];
     if ( !_z1 )
@@ -53,6 +57,23 @@ SparseFTFactorization::SparseFTFactorization( unsigned m,
     if ( !_z4 )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseFTFactorization::z4" );
+
+    _hypersparseWork = new double[m];
+    if ( !_hypersparseWork )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseFTFactorization::hypersparseWork" );
+    std::fill_n( _hypersparseWork, m, 0.0 );
+
+    _hypersparseIndices = new unsigned[m];
+    if ( !_hypersparseIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseFTFactorization::hypersparseIndices" );
+
+    _hypersparseMarked = new bool[m];
+    if ( !_hypersparseMarked )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseFTFactorization::hypersparseMarked" );
+    std::fill_n( _hypersparseMarked, m, false );
 }
 
 SparseFTFactorization::~SparseFTFactorization()
@@ -87,6 +108,24 @@ void SparseFTFactorization::freeIfNeeded()
         delete[] _z4;
         _z4 = NULL;
     }
+
+    if ( _hypersparseWork )
+    {
+        delete[] _hypersparseWork;
+        _hypersparseWork = NULL;
+    }
+
+    if ( _hypersparseIndices )
+    {
+        delete[] _hypersparseIndices;
+        _hypersparseIndices = NULL;
+    }
+
+    if ( _hypersparseMarked )
+    {
+        delete[] _hypersparseMarked;
+        _hypersparseMarked = NULL;
+    }
 }
 
 const double *SparseFTFactorization::getBasis() const
@@ -110,7 +149,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     // p = vRowDiagonalIndex
     // t = lastNonZeroEntryInU
 
-    if ( _etas.size() > GlobalConfiguration::REFACTORIZATION_THRESHOLD )
+    if ( _refactorizationPolicy.shouldRefactorize( _etas.size() ) )
     {
         obtainFreshBasis();
         return;
@@ -176,6 +215,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     {
         _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = pivotElement;
         ASSERT( uColumnIndex == lastNonZeroEntryInU ); // Otherwise, singular matrix
+        _refactorizationPolicy.notifyUpdate( computeTransformationCost() );
         return;
     }
 
@@ -229,6 +269,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
     if ( !haveSpike )
     {
         _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = pivotElement;
+        _refactorizationPolicy.notifyUpdate( computeTransformationCost() );
         return;
     }
 
@@ -309,6 +350,7 @@ void SparseFTFactorization::updateToAdjacentBasis( unsigned columnIndex,
         _sparseLUFactors._Vt->set( i, vRowDiagonalIndex, _z3[i] );
 
     _sparseLUFactors._vDiagonalElements[vRowDiagonalIndex] = _z3[columnIndex];
+    _refactorizationPolicy.notifyUpdate( computeTransformationCost() );
 }
 
 void SparseFTFactorization::forwardTransformation( const double *y, double *x ) const
@@ -327,6 +369,8 @@ void SparseFTFactorization::forwardTransformation( const double *y, double *x )
 
     // Eliminate V
     _sparseLUFactors.vForwardTransformation( _z2, x );
+
+    _refactorizationPolicy.notifyTransformation();
 }
 
 void SparseFTFactorization::backwardTransformation( const double *y, double *x ) const
@@ -345,6 +389,69 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
 
     // Eliminate F
     _sparseLUFactors.fBackwardTransformation( _z2, x );
+
+    _refactorizationPolicy.notifyTransformation();
+}
+
+bool SparseFTFactorization::supportsHypersparseTransformations() const
+{
+    return true;
+}
+
+unsigned SparseFTFactorization::hypersparseForwardTransformation( const double *y,
+                                                                  const unsigned *yIndices,
+                                                                  unsigned yNnz,
+                                                                  double *x,
+                                                                  unsigned *xIndices ) const
+{
+    /*
+      Same as the dense forwardTransformation, with F and H eliminated in
+      place in the work vector.
+    */
+    for ( unsigned i = 0; i < yNnz; ++i )
+    {
+        _hypersparseIndices[i] = yIndices[i];
+        _hypersparseWork[yIndices[i]] = y[yIndices[i]];
+    }
+
+    unsigned nnz = _sparseLUFactors.fForwardTransformation(
+        _hypersparseWork, _hypersparseIndices, yNnz );
+    nnz = hForwardTransformation( _hypersparseWork, _hypersparseIndices, nnz );
+    nnz = _sparseLUFactors.vForwardTransformation(
+        _hypersparseWork, _hypersparseIndices, nnz, x, xIndices );
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_HYPERSPARSE_FORWARD_TRANSFORMATIONS );
+
+    _refactorizationPolicy.notifyTransformation();
+
+    return nnz;
+}
+
+unsigned SparseFTFactorization::hypersparseBackwardTransformation( const double *y,
+                                                                   const unsigned *yIndices,
+                                                                   unsigned yNnz,
+                                                                   double *x,
+                                                                   unsigned *xIndices ) const
+{
+    /*
+      Same as the dense backwardTransformation, with H and F eliminated in
+      place in the output vector.
+    */
+    for ( unsigned i = 0; i < yNnz; ++i )
+        _hypersparseWork[yIndices[i]] = y[yIndices[i]];
+
+    unsigned nnz = _sparseLUFactors.vBackwardTransformation(
+        _hypersparseWork, yIndices, yNnz, x, xIndices );
+    nnz = hBackwardTransformation( x, xIndices, nnz );
+    nnz = _sparseLUFactors.fBackwardTransformation( x, xIndices, nnz );
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_HYPERSPARSE_BACKWARD_TRANSFORMATIONS );
+
+    _refactorizationPolicy.notifyTransformation();
+
+    return nnz;
 }
 
 void SparseFTFactorization::clearFactorization()
@@ -358,6 +465,8 @@ void SparseFTFactorization::clearFactorization()
 
 void SparseFTFactorization::factorizeBasis()
 {
+    struct timespec start = TimeUtils::sampleMicro();
+
     clearFactorization();
 
     try
@@ -372,8 +481,31 @@ void SparseFTFactorization::factorizeBasis()
             throw e;
     }
 
+    _refactorizationPolicy.notifyRefactorization( computeRefactorizationCost(),
+                                                  computeTransformationCost() );
+
     if ( _statistics )
+    {
+        struct timespec end = TimeUtils::sampleMicro();
         _statistics->incLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS );
+        _statistics->incLongAttribute( Statistics::TOTAL_TIME_BASIS_REFACTORIZATION_MICRO,
+                                       TimeUtils::timePassed( start, end ) );
+    }
+}
+
+unsigned long long SparseFTFactorization::computeRefactorizationCost() const
+{
+    // Each elimination step scans the active submatrix, and every row it
+    // eliminates (one per entry of F) is processed densely
+    return (unsigned long long)_m * ( _m + _sparseLUFactors._F->getNnz() );
+}
+
+unsigned long long SparseFTFactorization::computeTransformationCost() const
+{
+    unsigned long long cost = _m + _sparseLUFactors._F->getNnz() + _sparseLUFactors._V->getNnz();
+    for ( const auto &eta : _etas )
+        cost += eta->_sparseColumn.size();
+    return cost;
 }
 
 void SparseFTFactorization::storeFactorization( IBasisFactorization *other )
@@ -400,6 +532,10 @@ void SparseFTFactorization::restoreFactorization( const IBasisFactorization *oth
 
     // Store the new basis and factorization
     otherSparseFTFactorization->_sparseLUFactors.storeToOther( &_sparseLUFactors );
+
+    // Refactorizing later will cost as much as if these factors had been computed here
+    _refactorizationPolicy.notifyRefactorization( computeRefactorizationCost(),
+                                                  computeTransformationCost() );
 }
 
 void SparseFTFactorization::invertBasis( double *result )
@@ -483,6 +619,64 @@ void SparseFTFactorization::hBackwardTransformation( const double *y, double *x
     }
 }
 
+unsigned SparseFTFactorization::hForwardTransformation( double *x,
+                                                        unsigned *indices,
+                                                        unsigned nnz ) const
+{
+    for ( unsigned i = 0; i < nnz; ++i )
+        _hypersparseMarked[indices[i]] = true;
+
+    for ( const auto &eta : _etas )
+    {
+        unsigned pivotIndex = eta->_columnIndex;
+
+        for ( const auto &entry : eta->_sparseColumn )
+            x[pivotIndex] -= entry._value * x[entry._index];
+
+        if ( !_hypersparseMarked[pivotIndex] && x[pivotIndex] != 0.0 )
+        {
+            _hypersparseMarked[pivotIndex] = true;
+            indices[nnz++] = pivotIndex;
+        }
+    }
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _hypersparseMarked[indices[i]] = false;
+
+    return nnz;
+}
+
+unsigned SparseFTFactorization::hBackwardTransformation( double *x,
+                                                         unsigned *indices,
+                                                         unsigned nnz ) const
+{
+    for ( unsigned i = 0; i < nnz; ++i )
+        _hypersparseMarked[indices[i]] = true;
+
+    for ( auto eta = _etas.rbegin(); eta != _etas.rend(); ++eta )
+    {
+        double pivotValue = x[( *eta )->_columnIndex];
+        if ( pivotValue == 0.0 )
+            continue;
+
+        for ( const auto &entry : ( *eta )->_sparseColumn )
+        {
+            x[entry._index] -= entry._value * pivotValue;
+
+            if ( !_hypersparseMarked[entry._index] )
+            {
+                _hypersparseMarked[entry._index] = true;
+                indices[nnz++] = entry._index;
+            }
+        }
+    }
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _hypersparseMarked[indices[i]] = false;
+
+    return nnz;
+}
+
 void SparseFTFactorization::fixPForL()
 {
     if ( !_sparseLUFactors._usePForF )
@@ -559,6 +753,17 @@ void SparseFTFactorization::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
     _sparseGaussianEliminator.setStatistics( statistics );
+    _refactorizationPolicy.setStatistics( statistics );
+}
+
+void SparseFTFactorization::setRefactorizationPolicyType( RefactorizationPolicyType type )
+{
+    _refactorizationPolicy.setType( type );
+}
+
+void SparseFTFactorization::notifyDegradation( double degradation )
+{
+    _refactorizationPolicy.notifyDegradation( degradation );
 }
 
 //
@@ -17,6 +17,7 @@
 #define __SparseFTFactorization_h__
 
 #include "IBasisFactorization.h"
+#include "RefactorizationPolicy.h"
 #include "SparseColumnsOfBasis.h"
 #include "SparseEtaMatrix.h"
 #include "SparseGaussianEliminator.h"
@@ -72,6 +73,23 @@ public:
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hypersparse variants of the forward and backward transformations.
+      Only the entries of F, H and V reachable from the non-zero pattern
+      of y are touched.
+    */
+    bool supportsHypersparseTransformations() const;
+    unsigned hypersparseForwardTransformation( const double *y,
+                                               const unsigned *yIndices,
+                                               unsigned yNnz,
+                                               double *x,
+                                               unsigned *xIndices ) const;
+    unsigned hypersparseBackwardTransformation( const double *y,
+                                                const unsigned *yIndices,
+                                                unsigned yNnz,
+                                                double *x,
+                                                unsigned *xIndices ) const;
+
     /*
       Store and restore the basis factorization.
     */
@@ -100,6 +118,18 @@ public:
     const double *getBasis() const;
     const SparseMatrix *getSparseBasis() const;
 
+    /*
+      Have the Basis Factoriaztion object start reporting statistics.
+    */
+    void setStatistics( Statistics *statistics );
+
+    /*
+      Select when the factorization is recomputed from scratch, and
+      inform it of the numerical degradation observed by the engine.
+    */
+    void setRefactorizationPolicyType( RefactorizationPolicyType type );
+    void notifyDegradation( double degradation );
+
     /*
       Debug
     */
@@ -137,6 +167,12 @@ private:
     */
     Statistics *_statistics;
 
+    /*
+      Decides when the factorization is recomputed from scratch. It is
+      informed of every transformation, hence mutable.
+    */
+    mutable RefactorizationPolicy _refactorizationPolicy;
+
     /*
       Work memory.
     */
@@ -145,12 +181,29 @@ private:
     double *_z3;
     double *_z4;
 
+    /*
+      Work memory for the hypersparse transformations. _hypersparseWork is
+      kept all zeros between calls.
+    */
+    double *_hypersparseWork;
+    unsigned *_hypersparseIndices;
+    bool *_hypersparseMarked;
+
     /*
       Transformations on the H matrix (the list of etas)
     */
     void hForwardTransformation( const double *y, double *x ) const;
     void hBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      In-place hypersparse transformations on the H matrix. x contains y on
+      entry, and the solution on exit. indices holds the non-zero pattern of
+      y on entry, and that of the solution on exit. Returns the new number
+      of indices.
+    */
+    unsigned hForwardTransformation( double *x, unsigned *indices, unsigned nnz ) const;
+    unsigned hBackwardTransformation( double *x, unsigned *indices, unsigned nnz ) const;
+
     /*
       Free any allocated memory.
     */
@@ -161,6 +214,14 @@ private:
     */
     void factorizeBasis();
 
+    /*
+      Estimates, for the refactorization policy, of the number of entries
+      touched by a refactorization, and by a single forward or backward
+      transformation with the current factors and etas.
+    */
+    unsigned long long computeRefactorizationCost() const;
+    unsigned long long computeTransformationCost() const;
+
     /*
       Compute the inverse of B0, using the LP factorization already stored.
     */
@@ -177,10 +238,6 @@ private:
     */
     void clearFactorization();
 
-    /*
-      Have the Basis Factoriaztion object start reporting statistics.
-    */
-    void setStatistics( Statistics *statistics );
 };
 
 #endif // __SparseFTFactorization_h__
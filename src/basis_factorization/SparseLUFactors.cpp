@@ -20,6 +20,8 @@
 #include "FloatUtils.h"
 #include "MString.h"
 
+#include <algorithm>
+
 SparseLUFactors::SparseLUFactors( unsigned m )
     : _m( m )
     , _F( NULL )
@@ -34,6 +36,10 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     , _z( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
+    , _reach( NULL )
+    , _reachStack( NULL )
+    , _reachStackPosition( NULL )
+    , _reachMarked( NULL )
 {
     _F = new SparseUnsortedArrays();
     if ( !_F )
@@ -74,6 +80,27 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     if ( !_workVector )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseLUFactors::workVector" );
+
+    _reach = new unsigned[m];
+    if ( !_reach )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseLUFactors::reach" );
+
+    _reachStack = new unsigned[m];
+    if ( !_reachStack )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseLUFactors::reachStack" );
+
+    _reachStackPosition = new unsigned[m];
+    if ( !_reachStackPosition )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseLUFactors::reachStackPosition" );
+
+    _reachMarked = new bool[m];
+    if ( !_reachMarked )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseLUFactors::reachMarked" );
+    std::fill_n( _reachMarked, m, false );
 }
 
 SparseLUFactors::~SparseLUFactors()
@@ -125,6 +152,30 @@ SparseLUFactors::~SparseLUFactors()
         delete[] _workVector;
         _workVector = NULL;
     }
+
+    if ( _reach )
+    {
+        delete[] _reach;
+        _reach = NULL;
+    }
+
+    if ( _reachStack )
+    {
+        delete[] _reachStack;
+        _reachStack = NULL;
+    }
+
+    if ( _reachStackPosition )
+    {
+        delete[] _reachStackPosition;
+        _reachStackPosition = NULL;
+    }
+
+    if ( _reachMarked )
+    {
+        delete[] _reachMarked;
+        _reachMarked = NULL;
+    }
 }
 
 void SparseLUFactors::dump() const
@@ -413,6 +464,258 @@ void SparseLUFactors::vBackwardTransformation( const double *y, double *x ) cons
     }
 }
 
+const SparseUnsortedArray *SparseLUFactors::getAdjacentNodes( TransformationType type,
+                                                              unsigned node ) const
+{
+    switch ( type )
+    {
+    case F_FORWARD:
+        // Node i of F is eliminated from the rows of column i of F
+        return _Ft->getRow( node );
+
+    case F_BACKWARD:
+        // Node i of F is eliminated from the columns of row i of F
+        return _F->getRow( node );
+
+    case V_FORWARD:
+        // Nodes are rows of V. The row is eliminated through the column of its diagonal element
+        return _Vt->getRow( _Q._rowOrdering[_P._rowOrdering[node]] );
+
+    case V_BACKWARD:
+        // Nodes are columns of V. The column is eliminated through the row of its diagonal element
+        return _V->getRow( _P._columnOrdering[_Q._columnOrdering[node]] );
+    }
+
+    return NULL;
+}
+
+unsigned SparseLUFactors::nodeToPosition( TransformationType type, unsigned node ) const
+{
+    switch ( type )
+    {
+    case F_FORWARD:
+    case F_BACKWARD:
+        return ( _usePForF ? _PForF : _P )._rowOrdering[node];
+
+    case V_FORWARD:
+        return _P._rowOrdering[node];
+
+    case V_BACKWARD:
+        return _Q._columnOrdering[node];
+    }
+
+    return 0;
+}
+
+unsigned SparseLUFactors::computeReach( TransformationType type,
+                                        const unsigned *indices,
+                                        unsigned nnz ) const
+{
+    /*
+      An iterative depth-first search from each of the non-zero entries.
+      Every node reached is marked, so that each node (and each edge) is
+      only visited once.
+    */
+    unsigned reachSize = 0;
+
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        if ( _reachMarked[indices[i]] )
+            continue;
+
+        unsigned stackSize = 1;
+        _reachStack[0] = indices[i];
+        _reachStackPosition[0] = 0;
+        _reachMarked[indices[i]] = true;
+        _reach[reachSize++] = indices[i];
+
+        while ( stackSize > 0 )
+        {
+            unsigned node = _reachStack[stackSize - 1];
+            const SparseUnsortedArray *adjacent = getAdjacentNodes( type, node );
+            const SparseUnsortedArray::Entry *entry = adjacent->getArray();
+            unsigned adjacentNnz = adjacent->getNnz();
+
+            unsigned position = _reachStackPosition[stackSize - 1];
+            while ( position < adjacentNnz && _reachMarked[entry[position]._index] )
+                ++position;
+
+            if ( position == adjacentNnz )
+            {
+                // All successors visited
+                --stackSize;
+                continue;
+            }
+
+            unsigned next = entry[position]._index;
+            _reachStackPosition[stackSize - 1] = position + 1;
+            _reachStack[stackSize] = next;
+            _reachStackPosition[stackSize] = 0;
+            ++stackSize;
+
+            _reachMarked[next] = true;
+            _reach[reachSize++] = next;
+        }
+    }
+
+    /*
+      Replace the nodes by their elimination positions, and sort them. This
+      makes the numeric phase perform exactly the same operations as the
+      dense transformations.
+    */
+    for ( unsigned i = 0; i < reachSize; ++i )
+    {
+        _reachMarked[_reach[i]] = false;
+        _reach[i] = nodeToPosition( type, _reach[i] );
+    }
+
+    std::sort( _reach, _reach + reachSize );
+
+    return reachSize;
+}
+
+unsigned SparseLUFactors::fForwardTransformation( double *x,
+                                                 unsigned *indices,
+                                                 unsigned nnz ) const
+{
+    // See the dense fForwardTransformation for details
+    const PermutationMatrix *p = ( _usePForF ) ? &_PForF : &_P;
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    double xElement;
+
+    unsigned reachSize = computeReach( F_FORWARD, indices, nnz );
+    for ( unsigned i = 0; i < reachSize; ++i )
+    {
+        unsigned fColumn = p->_columnOrdering[_reach[i]];
+        indices[i] = fColumn;
+
+        xElement = x[fColumn];
+        if ( xElement != 0.0 )
+        {
+            sparseColumn = _Ft->getRow( fColumn );
+            entry = sparseColumn->getArray();
+            nnz = sparseColumn->getNnz();
+
+            for ( unsigned j = 0; j < nnz; ++j )
+                x[entry[j]._index] -= xElement * entry[j]._value;
+        }
+    }
+
+    return reachSize;
+}
+
+unsigned SparseLUFactors::fBackwardTransformation( double *x,
+                                                  unsigned *indices,
+                                                  unsigned nnz ) const
+{
+    // See the dense fBackwardTransformation for details
+    const PermutationMatrix *p = ( _usePForF ) ? &_PForF : &_P;
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    double xElement;
+
+    unsigned reachSize = computeReach( F_BACKWARD, indices, nnz );
+    for ( int i = reachSize - 1; i >= 0; --i )
+    {
+        unsigned fColumn = p->_columnOrdering[_reach[i]];
+        indices[i] = fColumn;
+
+        xElement = x[fColumn];
+        if ( xElement != 0.0 )
+        {
+            sparseRow = _F->getRow( fColumn );
+            entry = sparseRow->getArray();
+            nnz = sparseRow->getNnz();
+
+            for ( unsigned j = 0; j < nnz; ++j )
+                x[entry[j]._index] -= xElement * entry[j]._value;
+        }
+    }
+
+    return reachSize;
+}
+
+unsigned SparseLUFactors::vForwardTransformation( double *y,
+                                                  const unsigned *yIndices,
+                                                  unsigned yNnz,
+                                                  double *x,
+                                                  unsigned *xIndices ) const
+{
+    // See the dense vForwardTransformation for details
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    double xElement;
+    unsigned nnz;
+
+    unsigned reachSize = computeReach( V_FORWARD, yIndices, yNnz );
+    for ( int i = reachSize - 1; i >= 0; --i )
+    {
+        unsigned uRow = _reach[i];
+        unsigned vRow = _P._columnOrdering[uRow];
+        unsigned vColumn = _Q._rowOrdering[uRow];
+        xIndices[i] = vColumn;
+
+        xElement = x[vColumn] = ( y[vRow] / _vDiagonalElements[vRow] );
+
+        if ( xElement != 0.0 )
+        {
+            sparseColumn = _Vt->getRow( vColumn );
+            entry = sparseColumn->getArray();
+            nnz = sparseColumn->getNnz();
+
+            for ( unsigned j = 0; j < nnz; ++j )
+                y[entry[j]._index] -= xElement * entry[j]._value;
+        }
+    }
+
+    // Only reached entries of y could have been changed
+    for ( unsigned i = 0; i < reachSize; ++i )
+        y[_P._columnOrdering[_reach[i]]] = 0;
+
+    return reachSize;
+}
+
+unsigned SparseLUFactors::vBackwardTransformation( double *y,
+                                                   const unsigned *yIndices,
+                                                   unsigned yNnz,
+                                                   double *x,
+                                                   unsigned *xIndices ) const
+{
+    // See the dense vBackwardTransformation for details
+    const SparseUnsortedArray *sparseRow;
+    const SparseUnsortedArray::Entry *entry;
+    double xElement;
+    unsigned nnz;
+
+    unsigned reachSize = computeReach( V_BACKWARD, yIndices, yNnz );
+    for ( unsigned i = 0; i < reachSize; ++i )
+    {
+        unsigned utIndex = _reach[i];
+        unsigned vRow = _P._columnOrdering[utIndex];
+        unsigned vColumn = _Q._rowOrdering[utIndex];
+        xIndices[i] = vRow;
+
+        xElement = x[vRow] = ( y[vColumn] / _vDiagonalElements[vRow] );
+
+        if ( xElement != 0.0 )
+        {
+            sparseRow = _V->getRow( vRow );
+            entry = sparseRow->getArray();
+            nnz = sparseRow->getNnz();
+
+            for ( unsigned j = 0; j < nnz; ++j )
+                y[entry[j]._index] -= xElement * entry[j]._value;
+        }
+    }
+
+    // Only reached entries of y could have been changed
+    for ( unsigned i = 0; i < reachSize; ++i )
+        y[_Q._rowOrdering[_reach[i]]] = 0;
+
+    return reachSize;
+}
+
 void SparseLUFactors::forwardTransformation( const double *y, double *x ) const
 {
     /*
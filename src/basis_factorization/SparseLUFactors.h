@@ -110,6 +110,39 @@ public:
     void vForwardTransformation( const double *y, double *x ) const;
     void vBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hypersparse variants of the above transformations, for right-hand
+      sides with few non-zero entries. The non-zero pattern of the input
+      is given explicitly, and the entries that the solution can reach
+      are found symbolically, by a depth-first search over the graph of
+      F or V (Gilbert-Peierls). Only these entries are then eliminated,
+      in the same order as in the dense transformations.
+
+      The F transformations work in place: x contains y on entry, and
+      the solution on exit; indices contains the non-zero pattern of y
+      on entry, and that of the solution on exit. The new number of
+      indices is returned.
+
+      The V transformations read y, which is all zeros on exit, and
+      write the solution into x, which needs to be all zeros on entry.
+      The pattern of the solution is stored in xIndices, and its size
+      is returned.
+
+      All index arrays need to be of size m.
+    */
+    unsigned fForwardTransformation( double *x, unsigned *indices, unsigned nnz ) const;
+    unsigned fBackwardTransformation( double *x, unsigned *indices, unsigned nnz ) const;
+    unsigned vForwardTransformation( double *y,
+                                     const unsigned *yIndices,
+                                     unsigned yNnz,
+                                     double *x,
+                                     unsigned *xIndices ) const;
+    unsigned vBackwardTransformation( double *y,
+                                      const unsigned *yIndices,
+                                      unsigned yNnz,
+                                      double *x,
+                                      unsigned *xIndices ) const;
+
     /*
       Compute the inverse of the factorized basis
     */
@@ -122,6 +155,14 @@ public:
     double *_workMatrix;
     double *_workVector;
 
+    /*
+      Work memory for the symbolic phase of the hypersparse transformations
+    */
+    unsigned *_reach;
+    unsigned *_reachStack;
+    unsigned *_reachStackPosition;
+    bool *_reachMarked;
+
     /*
       Clone this SparseLUFactors object into another object
     */
@@ -131,6 +172,32 @@ public:
       For debugging purposes
     */
     void dump() const;
+
+private:
+    /*
+      The matrix graphs explored when computing reachability
+    */
+    enum TransformationType {
+        F_FORWARD,
+        F_BACKWARD,
+        V_FORWARD,
+        V_BACKWARD,
+    };
+
+    /*
+      Find all entries reachable from the given non-zero pattern, in the
+      graph of the given transformation. The reached entries are stored in
+      _reach as their (sorted) positions in the elimination order of L or U.
+      Returns the number of reached entries.
+    */
+    unsigned computeReach( TransformationType type, const unsigned *indices, unsigned nnz ) const;
+
+    /*
+      The adjacency list of a node in the graph of a transformation, and
+      the node's position in the elimination order
+    */
+    const SparseUnsortedArray *getAdjacentNodes( TransformationType type, unsigned node ) const;
+    unsigned nodeToPosition( TransformationType type, unsigned node ) const;
 };
 
 #endif // __SparseLUFactors_h__
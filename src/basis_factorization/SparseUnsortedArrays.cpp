@@ -243,7 +243,7 @@ void SparseUnsortedArrays::countElements( unsigned *numRowElements, unsigned *nu
     }
 }
 
-void SparseUnsortedArrays::transposeIntoOther( SparseUnsortedArrays *other )
+void SparseUnsortedArrays::transposeIntoOther( SparseUnsortedArrays *other ) const
 {
     other->initializeToEmpty( _n, _m );
 
@@ -71,7 +71,7 @@ public:
     /*
       Transpose the matrix and store it in another matrix
     */
-    void transposeIntoOther( SparseUnsortedArrays *other );
+    void transposeIntoOther( SparseUnsortedArrays *other ) const;
 
     /*
       For debugging purposes.
@@ -19,34 +19,111 @@
 #include "Debug.h"
 #include "FloatUtils.h"
 
+#include <cstring>
+
 SparseUnsortedList::SparseUnsortedList()
     : _size( 0 )
+    , _indices( NULL )
+    , _values( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( unsigned size )
     : _size( size )
+    , _indices( NULL )
+    , _values( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( const SparseUnsortedList &other )
+    : _size( 0 )
+    , _indices( NULL )
+    , _values( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
     *this = other;
 }
 
 SparseUnsortedList::SparseUnsortedList( const double *V, unsigned size )
+    : _size( 0 )
+    , _indices( NULL )
+    , _values( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
     initialize( V, size );
 }
 
 SparseUnsortedList::~SparseUnsortedList()
 {
+    freeMemoryIfNeeded();
+}
+
+void SparseUnsortedList::freeMemoryIfNeeded()
+{
+    if ( _indices )
+    {
+        delete[] _indices;
+        _indices = NULL;
+    }
+
+    if ( _values )
+    {
+        delete[] _values;
+        _values = NULL;
+    }
+
+    _allocatedSize = 0;
+}
+
+void SparseUnsortedList::reserve( unsigned capacity )
+{
+    if ( capacity <= _allocatedSize )
+        return;
+
+    unsigned *newIndices = new unsigned[capacity];
+    if ( !newIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseUnsortedList::indices" );
+
+    double *newValues = new double[capacity];
+    if ( !newValues )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseUnsortedList::values" );
+
+    if ( _nnz > 0 )
+    {
+        memcpy( newIndices, _indices, sizeof( unsigned ) * _nnz );
+        memcpy( newValues, _values, sizeof( double ) * _nnz );
+    }
+
+    unsigned nnz = _nnz;
+    freeMemoryIfNeeded();
+
+    _indices = newIndices;
+    _values = newValues;
+    _nnz = nnz;
+    _allocatedSize = capacity;
 }
 
 void SparseUnsortedList::initialize( const double *V, unsigned size )
 {
     _size = size;
-    _list.clear();
+    _nnz = 0;
+
+    unsigned nnz = 0;
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( !FloatUtils::isZero( V[i] ) )
+            ++nnz;
+    }
+
+    reserve( nnz );
 
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -54,47 +131,59 @@ void SparseUnsortedList::initialize( const double *V, unsigned size )
         if ( FloatUtils::isZero( V[i] ) )
             continue;
 
-        _list.append( Entry( i, V[i] ) );
+        _indices[_nnz] = i;
+        _values[_nnz] = V[i];
+        ++_nnz;
     }
 }
 
 void SparseUnsortedList::initializeToEmpty()
 {
     _size = 0;
-    _list.clear();
+    _nnz = 0;
 }
 
 void SparseUnsortedList::clear()
 {
-    _list.clear();
+    _nnz = 0;
 }
 
 unsigned SparseUnsortedList::getNnz() const
 {
-    return _list.size();
+    return _nnz;
 }
 
 bool SparseUnsortedList::empty() const
 {
-    return _list.empty();
+    return _nnz == 0;
 }
 
 double SparseUnsortedList::get( unsigned entry ) const
 {
-    for ( const auto &listEntry : _list )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( listEntry._index == entry )
-            return listEntry._value;
+        if ( _indices[i] == entry )
+            return _values[i];
     }
 
     return 0;
 }
 
+const unsigned *SparseUnsortedList::getIndices() const
+{
+    return _indices;
+}
+
+const double *SparseUnsortedList::getValues() const
+{
+    return _values;
+}
+
 void SparseUnsortedList::dump() const
 {
-    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _list.size() );
-    for ( const auto &entry : _list )
-        printf( "\tEntry %u: %6.2lf\n", entry._index, entry._value );
+    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _nnz );
+    for ( unsigned i = 0; i < _nnz; ++i )
+        printf( "\tEntry %u: %6.2lf\n", _indices[i], _values[i] );
     printf( "\n" );
 }
 
@@ -113,74 +202,80 @@ void SparseUnsortedList::toDense( double *result ) const
 {
     std::fill_n( result, _size, 0 );
 
-    for ( const auto &entry : _list )
-        result[entry._index] = entry._value;
+    for ( unsigned i = 0; i < _nnz; ++i )
+        result[_indices[i]] = _values[i];
 }
 
 SparseUnsortedList &SparseUnsortedList::operator=( const SparseUnsortedList &other )
 {
+    if ( this == &other )
+        return *this;
+
     _size = other._size;
-    _list = other._list;
+    _nnz = 0;
 
-    return *this;
-}
+    reserve( other._nnz );
 
-void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
-{
-    other->_size = _size;
-    other->_list = _list;
-}
+    if ( other._nnz > 0 )
+    {
+        memcpy( _indices, other._indices, sizeof( unsigned ) * other._nnz );
+        memcpy( _values, other._values, sizeof( double ) * other._nnz );
+    }
+    _nnz = other._nnz;
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::begin() const
-{
-    return _list.begin();
+    return *this;
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::end() const
+void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
 {
-    return _list.end();
+    *other = *this;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::begin()
+SparseUnsortedList::const_iterator SparseUnsortedList::begin() const
 {
-    return _list.begin();
+    return const_iterator( _indices, _values, 0 );
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::end()
+SparseUnsortedList::const_iterator SparseUnsortedList::end() const
 {
-    return _list.end();
+    return const_iterator( _indices, _values, _nnz );
 }
 
 void SparseUnsortedList::set( unsigned index, double value )
 {
     bool isZero = FloatUtils::isZero( value );
 
-    for ( auto it = begin(); it != end(); ++it )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( it->_index == index )
+        if ( _indices[i] == index )
         {
             if ( isZero )
-                _list.erase( it );
+                eraseAt( i );
             else
-                it->_value = value;
+                _values[i] = value;
 
             return;
         }
     }
 
     if ( !isZero )
-        _list.append( Entry( index, value ) );
+        append( index, value );
 }
 
 void SparseUnsortedList::append( unsigned index, double value )
 {
-    _list.append( Entry( index, value ) );
+    if ( _nnz == _allocatedSize )
+        reserve( _allocatedSize == 0 ? (unsigned)CHUNK_SIZE : 2 * _allocatedSize );
+
+    _indices[_nnz] = index;
+    _values[_nnz] = value;
+    ++_nnz;
 }
 
 void SparseUnsortedList::addLastEntry( double entry )
 {
     if ( !FloatUtils::isZero( entry ) )
-        _list.append( Entry( _size, entry ) );
+        append( _size, entry );
 
     ++_size;
 }
@@ -192,50 +287,66 @@ void SparseUnsortedList::incrementSize()
 
 void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
 {
-    List<Entry>::iterator sourceIt = _list.end();
-    List<Entry>::iterator targetIt = _list.end();
-    List<Entry>::iterator it;
+    unsigned sourcePosition = _nnz;
+    unsigned targetPosition = _nnz;
 
-    for ( it = _list.begin(); it != _list.end(); ++it )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( it->_index == source )
+        if ( _indices[i] == source )
         {
-            sourceIt = it;
-            if ( targetIt != _list.end() )
+            sourcePosition = i;
+            if ( targetPosition != _nnz )
                 break;
         }
 
-        if ( it->_index == target )
+        if ( _indices[i] == target )
         {
-            targetIt = it;
-            if ( sourceIt != _list.end() )
+            targetPosition = i;
+            if ( sourcePosition != _nnz )
                 break;
         }
     }
 
     // If no source entry exists, we are done
-    if ( sourceIt == _list.end() )
+    if ( sourcePosition == _nnz )
         return;
 
     // If no target entry, simply change index on source entry
-    if ( targetIt == _list.end() )
+    if ( targetPosition == _nnz )
     {
-        sourceIt->_index = target;
+        _indices[sourcePosition] = target;
         return;
     }
 
     // Both source and target entries
-    targetIt->_value += sourceIt->_value;
+    _values[targetPosition] += _values[sourcePosition];
+
+    eraseAt( sourcePosition );
+    if ( sourcePosition < targetPosition )
+        --targetPosition;
+
+    if ( FloatUtils::isZero( _values[targetPosition] ) )
+        eraseAt( targetPosition );
+}
+
+void SparseUnsortedList::eraseAt( unsigned position )
+{
+    ASSERT( position < _nnz );
+
+    unsigned toMove = _nnz - position - 1;
+    if ( toMove > 0 )
+    {
+        memmove( _indices + position, _indices + position + 1, sizeof( unsigned ) * toMove );
+        memmove( _values + position, _values + position + 1, sizeof( double ) * toMove );
+    }
 
-    _list.erase( sourceIt );
-    if ( FloatUtils::isZero( targetIt->_value ) )
-        _list.erase( targetIt );
+    --_nnz;
 }
 
-List<SparseUnsortedList::Entry>::iterator
-SparseUnsortedList::erase( List<SparseUnsortedList::Entry>::iterator it )
+SparseUnsortedList::iterator SparseUnsortedList::erase( iterator it )
 {
-    return _list.erase( it );
+    eraseAt( it.getPosition() );
+    return const_iterator( _indices, _values, it.getPosition() );
 }
 
 unsigned SparseUnsortedList::getSize() const
@@ -19,6 +19,13 @@
 #include "HashMap.h"
 #include "SparseMatrix.h"
 
+/*
+  A sparse vector, stored contiguously as a structure of arrays: the
+  indices and values of the non-zero entries are kept in two parallel
+  arrays, in no particular order. Iterating over the entries thus
+  involves no pointer chasing, and copying a vector requires at most
+  two allocations.
+*/
 class SparseUnsortedList
 {
 public:
@@ -34,6 +41,68 @@ public:
         double _value;
     };
 
+    /*
+      Iteration over the non-zero entries. As entries are not stored as
+      such, iterators return them by value.
+    */
+    class const_iterator
+    {
+    public:
+        const_iterator( const unsigned *indices, const double *values, unsigned position )
+            : _indices( indices )
+            , _values( values )
+            , _position( position )
+            , _entry( 0, 0 )
+        {
+        }
+
+        Entry operator*() const
+        {
+            return Entry( _indices[_position], _values[_position] );
+        }
+
+        const Entry *operator->() const
+        {
+            _entry = Entry( _indices[_position], _values[_position] );
+            return &_entry;
+        }
+
+        const_iterator &operator++()
+        {
+            ++_position;
+            return *this;
+        }
+
+        const_iterator &operator--()
+        {
+            --_position;
+            return *this;
+        }
+
+        bool operator==( const const_iterator &other ) const
+        {
+            return _position == other._position;
+        }
+
+        bool operator!=( const const_iterator &other ) const
+        {
+            return _position != other._position;
+        }
+
+        unsigned getPosition() const
+        {
+            return _position;
+        }
+
+    private:
+        const unsigned *_indices;
+        const double *_values;
+        unsigned _position;
+        mutable Entry _entry;
+    };
+
+    typedef const_iterator iterator;
+
     /*
       Initialization: the size determines the dimension of the
       underlying storage.
@@ -74,6 +143,13 @@ public:
     */
     double get( unsigned entry ) const;
 
+    /*
+      Direct access to the parallel arrays of indices and values, each
+      holding getNnz() elements
+    */
+    const unsigned *getIndices() const;
+    const double *getValues() const;
+
     /*
       Convert the unsortedList to dense format
     */
@@ -94,15 +170,15 @@ public:
     /*
       Retrieve entries
     */
-    List<Entry>::const_iterator begin() const;
-    List<Entry>::const_iterator end() const;
-    List<Entry>::iterator begin();
-    List<Entry>::iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
 
     /*
-      Erasing an element by iterator
+      Erasing an element by iterator. The order of the remaining
+      elements is preserved, and the returned iterator points to the
+      element that followed the erased one.
     */
-    List<Entry>::iterator erase( List<Entry>::iterator it );
+    iterator erase( iterator it );
 
     /*
       Addes the coefficient for entry 'source' to entry 'target'
@@ -122,8 +198,30 @@ public:
     void dumpDense() const;
 
 private:
+    enum {
+        // Initial capacity of a non-empty list
+        CHUNK_SIZE = 8,
+    };
+
     unsigned _size;
-    List<Entry> _list;
+    unsigned *_indices;
+    double *_values;
+    unsigned _nnz;
+    unsigned _allocatedSize;
+
+    /*
+      Make room for at least the given number of entries, preserving the
+      existing ones
+    */
+    void reserve( unsigned capacity );
+
+    /*
+      Remove the entry at the given position, preserving the order of
+      the others
+    */
+    void eraseAt( unsigned position );
+
+    void freeMemoryIfNeeded();
 };
 
 #endif // __SparseUnsortedList_h__
@@ -0,0 +1,135 @@
+/*********************                                                        */
+/*! \file SparseUnsortedListBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A microbenchmark comparing iteration over SparseUnsortedList, which
+ ** stores its entries contiguously, with iteration over a linked list of
+ ** entries (the previous storage scheme). The access pattern mimics
+ ** Tableau::getTableauRow: a dot product of every column of the
+ ** constraint matrix with a dense vector of multipliers.
+
+ **/
+
+#include "List.h"
+#include "SparseUnsortedList.h"
+#include "TimeUtils.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+int main( int argc, char *argv[] )
+{
+    unsigned numColumns = 20000;
+    unsigned m = 2000;
+    unsigned nnzPerColumn = 30;
+    unsigned repetitions = 50;
+
+    if ( argc > 1 )
+        repetitions = atoi( argv[1] );
+
+    srand( 2024 );
+
+    double *multipliers = new double[m];
+    for ( unsigned i = 0; i < m; ++i )
+        multipliers[i] = (double)rand() / RAND_MAX;
+
+    // Build both representations column by column, interleaving the
+    // allocations as happens when the tableau is constructed
+    SparseUnsortedList **columns = new SparseUnsortedList *[numColumns];
+    List<SparseUnsortedList::Entry> **linkedColumns =
+        new List<SparseUnsortedList::Entry> *[numColumns];
+
+    for ( unsigned i = 0; i < numColumns; ++i )
+    {
+        columns[i] = new SparseUnsortedList( m );
+        linkedColumns[i] = new List<SparseUnsortedList::Entry>;
+    }
+
+    for ( unsigned j = 0; j < nnzPerColumn; ++j )
+    {
+        for ( unsigned i = 0; i < numColumns; ++i )
+        {
+            unsigned index = rand() % m;
+            double value = (double)rand() / RAND_MAX - 0.5;
+
+            columns[i]->append( index, value );
+            linkedColumns[i]->append( SparseUnsortedList::Entry( index, value ) );
+        }
+    }
+
+    double linkedSum = 0;
+    struct timespec start = TimeUtils::sampleMicro();
+    for ( unsigned r = 0; r < repetitions; ++r )
+    {
+        for ( unsigned i = 0; i < numColumns; ++i )
+        {
+            for ( const auto &entry : *linkedColumns[i] )
+                linkedSum += multipliers[entry._index] * entry._value;
+        }
+    }
+    struct timespec end = TimeUtils::sampleMicro();
+    unsigned long long linkedMicro = TimeUtils::timePassed( start, end );
+
+    double iteratorSum = 0;
+    start = TimeUtils::sampleMicro();
+    for ( unsigned r = 0; r < repetitions; ++r )
+    {
+        for ( unsigned i = 0; i < numColumns; ++i )
+        {
+            for ( const auto &entry : *columns[i] )
+                iteratorSum += multipliers[entry._index] * entry._value;
+        }
+    }
+    end = TimeUtils::sampleMicro();
+    unsigned long long iteratorMicro = TimeUtils::timePassed( start, end );
+
+    double arraySum = 0;
+    start = TimeUtils::sampleMicro();
+    for ( unsigned r = 0; r < repetitions; ++r )
+    {
+        for ( unsigned i = 0; i < numColumns; ++i )
+        {
+            const unsigned *indices = columns[i]->getIndices();
+            const double *values = columns[i]->getValues();
+            unsigned nnz = columns[i]->getNnz();
+            for ( unsigned j = 0; j < nnz; ++j )
+                arraySum += multipliers[indices[j]] * values[j];
+        }
+    }
+    end = TimeUtils::sampleMicro();
+    unsigned long long arrayMicro = TimeUtils::timePassed( start, end );
+
+    printf( "Iterating %u columns with %u entries each, %u times\n",
+            numColumns,
+            nnzPerColumn,
+            repetitions );
+    printf( "\tLinked list:                    %8llu micro (checksum: %.6lf)\n",
+            linkedMicro,
+            linkedSum );
+    printf( "\tSparseUnsortedList (iterators): %8llu micro (checksum: %.6lf). Speedup: %.2lfx\n",
+            iteratorMicro,
+            iteratorSum,
+            iteratorMicro > 0 ? (double)linkedMicro / iteratorMicro : 0 );
+    printf( "\tSparseUnsortedList (arrays):    %8llu micro (checksum: %.6lf). Speedup: %.2lfx\n",
+            arrayMicro,
+            arraySum,
+            arrayMicro > 0 ? (double)linkedMicro / arrayMicro : 0 );
+
+    for ( unsigned i = 0; i < numColumns; ++i )
+    {
+        delete columns[i];
+        delete linkedColumns[i];
+    }
+    delete[] columns;
+    delete[] linkedColumns;
+    delete[] multipliers;
+
+    return 0;
+}
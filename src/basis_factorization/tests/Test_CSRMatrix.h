@@ -78,6 +78,49 @@ public:
                 TS_ASSERT_EQUALS( M2[i * 4 + j], csr2.get( i, j ) );
     }
 
+    void test_initialize_from_sparse_rows()
+    {
+        double M[] = {
+            0, 0, 0, 0, //
+            5, 8, 0, 0, //
+            0, 0, 3, 0, //
+            0, 6, 0, 2, //
+        };
+
+        // The rows are unsorted
+        SparseUnsortedList rows[4];
+        for ( unsigned i = 0; i < 4; ++i )
+            rows[i].initialize( M + ( i * 4 ), 4 );
+        rows[1].clear();
+        rows[1].append( 1, 8 );
+        rows[1].append( 0, 5 );
+        rows[3].clear();
+        rows[3].append( 3, 2 );
+        rows[3].append( 1, 6 );
+
+        const SparseUnsortedList *rowPointers[] = { &rows[0], &rows[1], &rows[2], &rows[3] };
+
+        CSRMatrix csr;
+        TS_ASSERT_THROWS_NOTHING( csr.initialize( rowPointers, 4, 4 ) );
+
+        TS_ASSERT_EQUALS( csr.getNnz(), 5U );
+        for ( unsigned i = 0; i < 4; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT_EQUALS( M[i * 4 + j], csr.get( i, j ) );
+
+        // Adding rows beyond the exact initial capacity
+        double row[] = { 1, 2, 3, 4 };
+        TS_ASSERT_THROWS_NOTHING( csr.addLastRow( row ) );
+        TS_ASSERT_THROWS_NOTHING( csr.addLastRow( row ) );
+        TS_ASSERT_EQUALS( csr.getNnz(), 13U );
+        for ( unsigned j = 0; j < 4; ++j )
+        {
+            TS_ASSERT_EQUALS( csr.get( 4, j ), row[j] );
+            TS_ASSERT_EQUALS( csr.get( 5, j ), row[j] );
+        }
+        TS_ASSERT_EQUALS( csr.get( 3, 3 ), 2.0 );
+    }
+
     void test_store_restore()
     {
         double M1[] = {
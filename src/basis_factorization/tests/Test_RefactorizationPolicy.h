@@ -0,0 +1,180 @@
+/*********************                                                        */
+/*! \file Test_RefactorizationPolicy.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "RefactorizationPolicy.h"
+#include "Statistics.h"
+
+#include <cxxtest/TestSuite.h>
+
+class MockForRefactorizationPolicy
+{
+public:
+};
+
+class RefactorizationPolicyTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForRefactorizationPolicy *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForRefactorizationPolicy );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_fixed_policy()
+    {
+        RefactorizationPolicy policy;
+        Statistics statistics;
+        policy.setStatistics( &statistics );
+
+        TS_ASSERT_EQUALS( policy.getType(), RefactorizationPolicyType::FIXED );
+
+        // Costs and degradation are ignored
+        policy.notifyRefactorization( 1000, 10 );
+        policy.notifyUpdate( 1000000 );
+        policy.notifyDegradation( 100 );
+
+        TS_ASSERT( !policy.shouldRefactorize( 0 ) );
+        TS_ASSERT( !policy.shouldRefactorize( GlobalConfiguration::REFACTORIZATION_THRESHOLD ) );
+        TS_ASSERT(
+            policy.shouldRefactorize( GlobalConfiguration::REFACTORIZATION_THRESHOLD + 1 ) );
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST ),
+                          1U );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION ),
+                          0U );
+    }
+
+    void test_adaptive_policy_minimizes_average_cost()
+    {
+        RefactorizationPolicy policy;
+        Statistics statistics;
+        policy.setStatistics( &statistics );
+        policy.setType( RefactorizationPolicyType::ADAPTIVE );
+
+        // A refactorization costs 1000, and a transformation 10. Every update
+        // makes transformations 10 more expensive, and is followed by two
+        // transformations.
+        unsigned long long cost = 10;
+        policy.notifyRefactorization( 1000, cost );
+
+        unsigned numUpdates = 0;
+        while ( !policy.shouldRefactorize( numUpdates ) )
+        {
+            cost += 10;
+            policy.notifyUpdate( cost );
+            ++numUpdates;
+
+            policy.notifyTransformation();
+            policy.notifyTransformation();
+
+            TS_ASSERT( numUpdates < GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES );
+        }
+
+        // After k updates, the average cost per update is
+        //    ( 1000 + 2 * ( 20 + 30 + ... + 10( k + 1 ) ) ) / k = 1000 / k + 10k + 30
+        // and the next update is expected to cost 2 * 10( k + 1 ). The latter
+        // exceeds the former for the first time when k = 11.
+        TS_ASSERT_EQUALS( numUpdates, 11U );
+        TS_ASSERT_EQUALS( policy.getNumUpdates(), 11U );
+        TS_ASSERT( FloatUtils::areEqual( policy.getAverageCostPerUpdate(), 1000.0 / 11 + 140 ) );
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST ),
+                          1U );
+
+        // The accounting starts over after refactorization
+        policy.notifyRefactorization( 1000, 10 );
+        TS_ASSERT_EQUALS( policy.getNumUpdates(), 0U );
+        TS_ASSERT( !policy.shouldRefactorize( 0 ) );
+    }
+
+    void test_adaptive_policy_with_constant_cost()
+    {
+        RefactorizationPolicy policy;
+        policy.setType( RefactorizationPolicyType::ADAPTIVE );
+
+        // If updates do not make transformations more expensive, only the
+        // cap on the number of updates causes refactorization
+        policy.notifyRefactorization( 1000, 10 );
+
+        unsigned numUpdates = 0;
+        while ( !policy.shouldRefactorize( numUpdates ) )
+        {
+            policy.notifyUpdate( 10 );
+            ++numUpdates;
+
+            policy.notifyTransformation();
+            policy.notifyTransformation();
+        }
+
+        TS_ASSERT_EQUALS( numUpdates, GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES );
+    }
+
+    void test_adaptive_policy_degradation()
+    {
+        RefactorizationPolicy policy;
+        Statistics statistics;
+        policy.setStatistics( &statistics );
+        policy.setType( RefactorizationPolicyType::ADAPTIVE );
+
+        policy.notifyRefactorization( 1000, 10 );
+
+        // Fresh factors are not refactorized
+        policy.notifyDegradation( 1 );
+        TS_ASSERT( !policy.shouldRefactorize( 0 ) );
+
+        policy.notifyUpdate( 10 );
+        policy.notifyTransformation();
+
+        policy.notifyDegradation(
+            GlobalConfiguration::ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD / 2 );
+        TS_ASSERT( !policy.shouldRefactorize( 1 ) );
+
+        policy.notifyDegradation(
+            GlobalConfiguration::ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD * 2 );
+        TS_ASSERT( policy.shouldRefactorize( 1 ) );
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION ),
+                          1U );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST ),
+                          0U );
+
+        // The degradation is cleared by refactorization
+        policy.notifyRefactorization( 1000, 10 );
+        policy.notifyUpdate( 10 );
+        policy.notifyTransformation();
+        TS_ASSERT( !policy.shouldRefactorize( 1 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -22,6 +22,7 @@
 #include "MockErrno.h"
 #include "SparseFTFactorization.h"
 
+#include <algorithm>
 #include <cxxtest/TestSuite.h>
 
 class MockForSparseFTFactorization
@@ -301,6 +302,76 @@ public:
             TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
     }
 
+    void test_hypersparse_transformations()
+    {
+        SparseFTFactorization basis( 6, *oracle );
+
+        TS_ASSERT( basis.supportsHypersparseTransformations() );
+
+        double B[] = {
+            2, 0, 0, 1, 0, 0, //
+            0, 1, 0, 0, 0, 3, //
+            1, 0, 4, 0, 0, 0, //
+            0, 0, 0, 1, 0, 0, //
+            0, 2, 0, 0, 5, 0, //
+            0, 0, 1, 0, 0, 1, //
+        };
+        oracle->storeBasis( 6, B );
+        basis.obtainFreshBasis();
+
+        // Replace a couple of columns, so that the H matrix is non-trivial
+        double a1[] = { 0, 1, 0, 2, 0, 1 };
+        basis.updateToAdjacentBasis( 0, NULL, a1 );
+        double a2[] = { 1, 0, 0, 0, 3, 0 };
+        basis.updateToAdjacentBasis( 3, NULL, a2 );
+
+        double y[6];
+        double expected[6];
+        double x[6];
+        unsigned yIndices[6];
+        unsigned xIndices[6];
+
+        // The results should be identical to those of the dense transformations, up to the
+        // sign of zero entries
+        for ( unsigned i = 0; i < 6; ++i )
+        {
+            for ( unsigned j = i; j < 6; ++j )
+            {
+                std::fill_n( y, 6, 0.0 );
+                y[i] = 1;
+                y[j] = -2;
+                yIndices[0] = i;
+                yIndices[1] = j;
+                unsigned yNnz = ( i == j ) ? 1 : 2;
+
+                basis.forwardTransformation( y, expected );
+                std::fill_n( x, 6, 0.0 );
+                unsigned xNnz = 0;
+                TS_ASSERT_THROWS_NOTHING( xNnz = basis.hypersparseForwardTransformation(
+                                              y, yIndices, yNnz, x, xIndices ) );
+                for ( unsigned k = 0; k < 6; ++k )
+                {
+                    TS_ASSERT_EQUALS( x[k], expected[k] );
+                    if ( x[k] != 0 )
+                        TS_ASSERT( std::find( xIndices, xIndices + xNnz, k ) !=
+                                   xIndices + xNnz );
+                }
+
+                basis.backwardTransformation( y, expected );
+                std::fill_n( x, 6, 0.0 );
+                TS_ASSERT_THROWS_NOTHING( xNnz = basis.hypersparseBackwardTransformation(
+                                              y, yIndices, yNnz, x, xIndices ) );
+                for ( unsigned k = 0; k < 6; ++k )
+                {
+                    TS_ASSERT_EQUALS( x[k], expected[k] );
+                    if ( x[k] != 0 )
+                        TS_ASSERT( std::find( xIndices, xIndices + xNnz, k ) !=
+                                   xIndices + xNnz );
+                }
+            }
+        }
+    }
+
     void test_store_and_restore()
     {
         SparseFTFactorization basis( 3, *oracle );
@@ -375,6 +446,60 @@ public:
         TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a3, d3 ) );
         TS_ASSERT( memcmp( d3other, d3, sizeof( double ) * 3 ) );
     }
+
+    void test_adaptive_refactorization_on_degradation()
+    {
+        SparseFTFactorization basis( 3, *oracle );
+        Statistics statistics;
+        basis.setStatistics( &statistics );
+        basis.setRefactorizationPolicyType( RefactorizationPolicyType::ADAPTIVE );
+
+        double B[] = {
+            1, 0, 0, //
+            0, 1, 0, //
+            0, 0, 1, //
+        };
+        oracle->storeBasis( 3, B );
+        basis.obtainFreshBasis();
+
+        double a1[] = { 1, 1, 3 };
+        basis.updateToAdjacentBasis( 1, NULL, a1 );
+
+        double a2[] = { 3, 1, 4 };
+        double d2[] = { 0, 0, 0 };
+        double expected2[] = { 2, 1, 1 };
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a2, d2 ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT( FloatUtils::areEqual( expected2[i], d2[i] ) );
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ),
+                          1U );
+
+        // High degradation: the next update is performed by refactorizing the
+        // new basis, provided by the oracle
+        basis.notifyDegradation( 1 );
+
+        double newBasis[] = {
+            3, 1, 0, //
+            1, 1, 0, //
+            4, 3, 1, //
+        };
+        oracle->storeBasis( 3, newBasis );
+        basis.updateToAdjacentBasis( 0, NULL, a2 );
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ),
+                          2U );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION ),
+                          1U );
+
+        double a3[] = { 2, 1, 4 };
+        double d3[] = { 0, 0, 0 };
+        double expected3[] = { 0.5, 0.5, 0.5 };
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a3, d3 ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT( FloatUtils::areEqual( expected3[i], d3[i] ) );
+    }
 };
 
 //
@@ -174,6 +174,69 @@ public:
 
         TS_ASSERT_EQUALS( v1.getNnz(), 0U );
     }
+
+    void test_append_erase_and_copy()
+    {
+        SparseUnsortedList v1( 100 );
+
+        // Grow beyond the initial capacity
+        for ( unsigned i = 0; i < 50; ++i )
+            v1.append( 2 * i, i + 1 );
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 50U );
+        TS_ASSERT_EQUALS( v1.get( 40 ), 21 );
+        TS_ASSERT_EQUALS( v1.get( 41 ), 0 );
+
+        const unsigned *indices = v1.getIndices();
+        const double *values = v1.getValues();
+        for ( unsigned i = 0; i < 50; ++i )
+        {
+            TS_ASSERT_EQUALS( indices[i], 2 * i );
+            TS_ASSERT_EQUALS( values[i], i + 1 );
+        }
+
+        // Erase every entry with an odd value, the order of the rest is preserved
+        for ( auto it = v1.begin(); it != v1.end(); )
+        {
+            if ( ( (unsigned)it->_value ) % 2 == 1 )
+                it = v1.erase( it );
+            else
+                ++it;
+        }
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 25U );
+
+        unsigned expectedIndex = 2;
+        for ( const auto &entry : v1 )
+        {
+            TS_ASSERT_EQUALS( entry._index, expectedIndex );
+            TS_ASSERT_EQUALS( entry._value, expectedIndex / 2 + 1 );
+            expectedIndex += 4;
+        }
+
+        // Copies are deep
+        SparseUnsortedList v2( v1 );
+        SparseUnsortedList v3;
+        v3 = v1;
+
+        v1.set( 2, 0 );
+        v1.mergeEntries( 6, 10 );
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 23U );
+        TS_ASSERT_EQUALS( v1.get( 10 ), 10 );
+        TS_ASSERT_EQUALS( v1.getIndices()[0], 10U );
+
+        TS_ASSERT_EQUALS( v2.getNnz(), 25U );
+        TS_ASSERT_EQUALS( v3.getNnz(), 25U );
+        TS_ASSERT_EQUALS( v2.get( 2 ), 2 );
+        TS_ASSERT_EQUALS( v3.get( 6 ), 4 );
+        TS_ASSERT_EQUALS( v3.getSize(), 100U );
+
+        v1.clear();
+        TS_ASSERT( v1.empty() );
+        TS_ASSERT_EQUALS( v1.getSize(), 100U );
+        TS_ASSERT_EQUALS( v1.begin(), v1.end() );
+    }
 };
 
 //
@@ -0,0 +1,34 @@
+/*********************                                                        */
+/*! \file EntrySelectionStrategyType.h
+** \verbatim
+** Top contributors (to current version):
+**   Guy Katz
+** This file is part of the Marabou project.
+** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved. See the file COPYING in the top-level source
+** directory for licensing information.\endverbatim
+**
+** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __EntrySelectionStrategyType_h__
+#define __EntrySelectionStrategyType_h__
+
+enum class EntrySelectionStrategyType {
+    // Projected steepest edge: the most accurate pricing, but every pivot
+    // costs a backward transformation and a pass over the non-basic columns.
+    PROJECTED_STEEPEST_EDGE,
+
+    // Devex: approximate steepest edge weights, updated from the pivot row only.
+    DEVEX,
+
+    // Largest reduced cost
+    DANTZIG,
+
+    // Smallest eligible index. Slow, but guaranteed not to cycle.
+    BLAND,
+};
+
+#endif // __EntrySelectionStrategyType_h__
@@ -0,0 +1,29 @@
+/*********************                                                        */
+/*! \file RefactorizationPolicyType.h
+** \verbatim
+** Top contributors (to current version):
+**   Guy Katz
+** This file is part of the Marabou project.
+** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved. See the file COPYING in the top-level source
+** directory for licensing information.\endverbatim
+**
+** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __RefactorizationPolicyType_h__
+#define __RefactorizationPolicyType_h__
+
+enum class RefactorizationPolicyType {
+    // Refactorize once the number of update matrices exceeds REFACTORIZATION_THRESHOLD
+    FIXED,
+
+    // Refactorize when the average cost per basis update, including the cost
+    // of the last refactorization, is minimal; or when the numerical
+    // degradation grows too high.
+    ADAPTIVE,
+};
+
+#endif // __RefactorizationPolicyType_h__
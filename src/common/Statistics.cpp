@@ -48,6 +48,9 @@ Statistics::Statistics()
     _longAttributes[NUM_MAIN_LOOP_ITERATIONS] = 0;
     _longAttributes[NUM_SIMPLEX_STEPS] = 0;
     _longAttributes[TIME_SIMPLEX_STEPS_MICRO] = 0;
+    _longAttributes[NUM_DUAL_SIMPLEX_STEPS] = 0;
+    _longAttributes[TIME_DUAL_SIMPLEX_STEPS_MICRO] = 0;
+    _longAttributes[NUM_DUAL_SIMPLEX_FALLBACKS] = 0;
     _longAttributes[TIME_MAIN_LOOP_MICRO] = 0;
     _longAttributes[TIME_CONSTRAINT_FIXING_STEPS_MICRO] = 0;
     _longAttributes[NUM_CONSTRAINT_FIXING_STEPS] = 0;
@@ -59,9 +62,14 @@ Statistics::Statistics()
     _longAttributes[NUM_SIMPLEX_UNSTABLE_PIVOTS] = 0;
     _longAttributes[NUM_ADDED_ROWS] = 0;
     _longAttributes[NUM_MERGED_COLUMNS] = 0;
+    _longAttributes[NUM_INCREMENTAL_TABLEAU_RESTORATIONS] = 0;
     _longAttributes[NUM_TABLEAU_BOUND_HOPPING] = 0;
+    _longAttributes[NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED] = 0;
+    _longAttributes[NUM_TABLEAU_LONG_STEP_BOUND_FLIPS] = 0;
     _longAttributes[NUM_TIGHTENED_BOUNDS] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING] = 0;
+    _longAttributes[NUM_DEEP_POLY_LAYERS_EXECUTED] = 0;
+    _longAttributes[NUM_DEEP_POLY_LAYERS_SKIPPED] = 0;
     _longAttributes[NUM_ROWS_EXAMINED_BY_ROW_TIGHTENER] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_ROWS] = 0;
     _longAttributes[NUM_BOUND_TIGHTENINGS_ON_EXPLICIT_BASIS] = 0;
@@ -71,9 +79,19 @@ Statistics::Statistics()
     _longAttributes[NUM_BOUNDS_PROPOSED_BY_PL_CONSTRAINTS] = 0;
     _longAttributes[NUM_BOUND_TIGHTENINGS_ON_CONSTRAINT_MATRIX] = 0;
     _longAttributes[NUM_TIGHTENINGS_FROM_CONSTRAINT_MATRIX] = 0;
+    _longAttributes[NUM_ROWS_EXAMINED_ON_CONSTRAINT_MATRIX] = 0;
+    _longAttributes[NUM_ROWS_SKIPPED_ON_CONSTRAINT_MATRIX] = 0;
+    _longAttributes[NUM_ROWS_TIGHTENED_ON_CONSTRAINT_MATRIX] = 0;
     _longAttributes[NUM_BASIS_REFACTORIZATIONS] = 0;
+    _longAttributes[NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST] = 0;
+    _longAttributes[NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION] = 0;
+    _longAttributes[TOTAL_TIME_BASIS_REFACTORIZATION_MICRO] = 0;
+    _longAttributes[NUM_HYPERSPARSE_FORWARD_TRANSFORMATIONS] = 0;
+    _longAttributes[NUM_HYPERSPARSE_BACKWARD_TRANSFORMATIONS] = 0;
     _longAttributes[PSE_NUM_ITERATIONS] = 0;
     _longAttributes[PSE_NUM_RESET_REFERENCE_SPACE] = 0;
+    _longAttributes[DEVEX_NUM_RESET_REFERENCE_FRAMEWORK] = 0;
+    _longAttributes[PARTIAL_PRICING_NUM_POOL_REFRESHES] = 0;
     _longAttributes[TOTAL_TIME_PERFORMING_VALID_CASE_SPLITS_MICRO] = 0;
     _longAttributes[TOTAL_TIME_PERFORMING_SYMBOLIC_BOUND_TIGHTENING] = 0;
     _longAttributes[TOTAL_TIME_HANDLING_STATISTICS_MICRO] = 0;
@@ -83,6 +101,10 @@ Statistics::Statistics()
     _longAttributes[TOTAL_TIME_CONSTRAINT_MATRIX_BOUND_TIGHTENING_MICRO] = 0;
     _longAttributes[TOTAL_TIME_APPLYING_STORED_TIGHTENINGS_MICRO] = 0;
     _longAttributes[TOTAL_TIME_SMT_CORE_MICRO] = 0;
+    _longAttributes[NUM_CONFLICT_CLAUSES_LEARNED] = 0;
+    _longAttributes[NUM_NON_CHRONOLOGICAL_BACKJUMPS] = 0;
+    _longAttributes[NUM_CASE_SPLITS_IMPLIED_BY_CONFLICT_CLAUSES] = 0;
+    _longAttributes[TOTAL_TIME_CONFLICT_ANALYSIS_MICRO] = 0;
     _longAttributes[TOTAL_TIME_UPDATING_SOI_PHASE_PATTERN_MICRO] = 0;
     _longAttributes[NUM_PROPOSED_PHASE_PATTERN_UPDATE] = 0;
     _longAttributes[NUM_ACCEPTED_PHASE_PATTERN_UPDATE] = 0;
@@ -164,6 +186,11 @@ void Statistics::print()
     printf( "\t\t[%.2lf%%] Simplex steps: %llu milli\n",
             printPercents( timeSimplexStepsMicro, timeMainLoopMicro ),
             timeSimplexStepsMicro / 1000 );
+    unsigned long long timeDualSimplexStepsMicro =
+        getLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO );
+    printf( "\t\t[%.2lf%%] Dual simplex steps: %llu milli\n",
+            printPercents( timeDualSimplexStepsMicro, timeMainLoopMicro ),
+            timeDualSimplexStepsMicro / 1000 );
     unsigned long long totalTimeExplicitBasisBoundTighteningMicro =
         getLongAttribute( TOTAL_TIME_EXPLICIT_BASIS_BOUND_TIGHTENING_MICRO );
     printf( "\t\t[%.2lf%%] Explicit-basis bound tightening: %llu milli\n",
@@ -230,7 +257,7 @@ void Statistics::print()
             totalTimeAddingConstraintsToMILPSolver / 1000 );
 
     unsigned long long total =
-        timeSimplexStepsMicro + timeConstraintFixingStepsMicro +
+        timeSimplexStepsMicro + timeDualSimplexStepsMicro + timeConstraintFixingStepsMicro +
         totalTimePerformingValidCaseSplitsMicro + totalTimeHandlingStatisticsMicro +
         totalTimeExplicitBasisBoundTighteningMicro + totalTimeDegradationChecking +
         totalTimePrecisionRestoration + totalTimeConstraintMatrixBoundTighteningMicro +
@@ -268,6 +295,13 @@ void Statistics::print()
         numConstraintFixingSteps,
         timeConstraintFixingStepsMicro / 1000,
         printAverage( timeConstraintFixingStepsMicro / 1000, numConstraintFixingSteps ) );
+    unsigned long long numDualSimplexSteps = getLongAttribute( Statistics::NUM_DUAL_SIMPLEX_STEPS );
+    printf( "\tNumber of dual simplex steps: %llu. Total time: %llu milli. Average: %.2lf milli. "
+            "Fallbacks to primal simplex: %llu\n",
+            numDualSimplexSteps,
+            timeDualSimplexStepsMicro / 1000,
+            printAverage( timeDualSimplexStepsMicro / 1000, numDualSimplexSteps ),
+            getLongAttribute( Statistics::NUM_DUAL_SIMPLEX_FALLBACKS ) );
     printf( "\tNumber of active piecewise-linear constraints: %u / %u\n"
             "\t\tConstraints disabled by valid splits: %u. "
             "By SMT-originated splits: %u\n",
@@ -307,9 +341,14 @@ void Statistics::print()
 
     printf( "\tTotal number of fake pivots performed: %llu\n",
             getLongAttribute( Statistics::NUM_TABLEAU_BOUND_HOPPING ) );
+    printf( "\tBound-flipping ratio test: breakpoints passed: %llu. Long-step bound flips: %llu\n",
+            getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED ),
+            getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BOUND_FLIPS ) );
     printf( "\tTotal number of rows added: %llu. Number of merged columns: %llu\n",
             getLongAttribute( Statistics::NUM_ADDED_ROWS ),
             getLongAttribute( Statistics::NUM_MERGED_COLUMNS ) );
+    printf( "\tNumber of state restorations that kept the constraint matrix: %llu\n",
+            getLongAttribute( Statistics::NUM_INCREMENTAL_TABLEAU_RESTORATIONS ) );
     printf( "\tCurrent tableau dimensions: M = %u, N = %u\n",
             getUnsignedAttribute( Statistics::CURRENT_TABLEAU_M ),
             getUnsignedAttribute( Statistics::CURRENT_TABLEAU_N ) );
@@ -322,6 +361,12 @@ void Statistics::print()
         getUnsignedAttribute( Statistics::NUM_SPLITS ),
         getUnsignedAttribute( Statistics::NUM_POPS ) );
     printf( "\tMax stack depth: %u\n", getUnsignedAttribute( Statistics::MAX_DECISION_LEVEL ) );
+    printf( "\tConflict clauses learned: %llu. Non-chronological backjumps: %llu. Case splits "
+            "implied by conflict clauses: %llu. Time analyzing conflicts: %llu milli\n",
+            getLongAttribute( Statistics::NUM_CONFLICT_CLAUSES_LEARNED ),
+            getLongAttribute( Statistics::NUM_NON_CHRONOLOGICAL_BACKJUMPS ),
+            getLongAttribute( Statistics::NUM_CASE_SPLITS_IMPLIED_BY_CONFLICT_CLAUSES ),
+            getLongAttribute( Statistics::TOTAL_TIME_CONFLICT_ANALYSIS_MICRO ) / 1000 );
 
     printf( "\t--- Bound Tightening Statistics ---\n" );
     printf( "\tNumber of tightened bounds: %llu.\n",
@@ -339,6 +384,11 @@ void Statistics::print()
             "Consequent tightenings: %llu\n",
             getLongAttribute( Statistics::NUM_BOUND_TIGHTENINGS_ON_CONSTRAINT_MATRIX ),
             getLongAttribute( Statistics::NUM_TIGHTENINGS_FROM_CONSTRAINT_MATRIX ) );
+    printf( "\t\tNumber of constraint matrix rows examined: %llu (skipped: %llu). Rows "
+            "tightened: %llu\n",
+            getLongAttribute( Statistics::NUM_ROWS_EXAMINED_ON_CONSTRAINT_MATRIX ),
+            getLongAttribute( Statistics::NUM_ROWS_SKIPPED_ON_CONSTRAINT_MATRIX ),
+            getLongAttribute( Statistics::NUM_ROWS_TIGHTENED_ON_CONSTRAINT_MATRIX ) );
 
     printf( "\t\tNumber of bound notifications sent to PL constraints: %llu. Tightenings proposed: "
             "%llu\n",
@@ -346,8 +396,16 @@ void Statistics::print()
             getLongAttribute( Statistics::NUM_BOUNDS_PROPOSED_BY_PL_CONSTRAINTS ) );
 
     printf( "\t--- Basis Factorization statistics ---\n" );
-    printf( "\tNumber of basis refactorizations: %llu\n",
-            getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ) );
+    printf( "\tNumber of basis refactorizations: %llu. Due to update cost: %llu. Due to "
+            "degradation: %llu\n",
+            getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS ),
+            getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST ),
+            getLongAttribute( Statistics::NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION ) );
+    printf( "\tTotal time refactorizing the basis: %llu milli\n",
+            getLongAttribute( Statistics::TOTAL_TIME_BASIS_REFACTORIZATION_MICRO ) / 1000 );
+    printf( "\tNumber of hypersparse transformations: FTRAN: %llu. BTRAN: %llu\n",
+            getLongAttribute( Statistics::NUM_HYPERSPARSE_FORWARD_TRANSFORMATIONS ),
+            getLongAttribute( Statistics::NUM_HYPERSPARSE_BACKWARD_TRANSFORMATIONS ) );
 
     unsigned long long pseNumIterations = getLongAttribute( Statistics::PSE_NUM_ITERATIONS );
     unsigned long long pseNumResetReferenceSpace =
@@ -359,10 +417,18 @@ void Statistics::print()
             pseNumResetReferenceSpace > 0
                 ? (unsigned)( (double)pseNumIterations / pseNumResetReferenceSpace )
                 : 0 );
+    printf( "\t--- Devex and Partial Pricing Statistics ---\n" );
+    printf( "\tNumber of resets to the Devex reference framework: %llu\n",
+            getLongAttribute( Statistics::DEVEX_NUM_RESET_REFERENCE_FRAMEWORK ) );
+    printf( "\tNumber of partial pricing candidate pool refreshes: %llu\n",
+            getLongAttribute( Statistics::PARTIAL_PRICING_NUM_POOL_REFRESHES ) );
 
     printf( "\t--- SBT ---\n" );
     printf( "\tNumber of tightened bounds: %llu\n",
             getLongAttribute( Statistics::NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING ) );
+    printf( "\tDeepPoly layers executed: %llu. Skipped (bounds unchanged): %llu\n",
+            getLongAttribute( Statistics::NUM_DEEP_POLY_LAYERS_EXECUTED ),
+            getLongAttribute( Statistics::NUM_DEEP_POLY_LAYERS_SKIPPED ) );
 
     printf( "\t--- SoI-based local search ---\n" );
     unsigned long long num_proposed_phase_pattern_update =
@@ -93,6 +93,13 @@ public:
         // Total time spent on performing simplex steps, in microseconds
         TIME_SIMPLEX_STEPS_MICRO,
 
+        // Number of dual simplex steps performed by the main loop, the total time spent
+        // performing them, in microseconds, and the number of times the engine abandoned the
+        // dual simplex method and fell back to the primal one
+        NUM_DUAL_SIMPLEX_STEPS,
+        TIME_DUAL_SIMPLEX_STEPS_MICRO,
+        NUM_DUAL_SIMPLEX_FALLBACKS,
+
         // Total time spent in the main loop, in microseconds
         TIME_MAIN_LOOP_MICRO,
 
@@ -126,15 +133,30 @@ public:
         // Total number of merged columns in the tableau
         NUM_MERGED_COLUMNS,
 
+        // Number of tableau state restorations that kept the current constraint matrix,
+        // restoring only the basis and the assignment
+        NUM_INCREMENTAL_TABLEAU_RESTORATIONS,
+
         // opposite bound.
         NUM_TABLEAU_BOUND_HOPPING,
 
+        // Number of breakpoints passed by the bound-flipping ratio test, i.e. out-of-bounds basic
+        // variables that became feasible during a pivot without leaving the basis, and the
+        // number of bound flips it chose after passing at least one breakpoint.
+        NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED,
+        NUM_TABLEAU_LONG_STEP_BOUND_FLIPS,
+
         // This combines tightenings from all sources: rows, basis, PL constraints, etc.
         NUM_TIGHTENED_BOUNDS,
 
         // The number of bounds tightened via symbolic bound tightening
         NUM_TIGHTENINGS_FROM_SYMBOLIC_BOUND_TIGHTENING,
 
+        // Number of layers whose DeepPoly abstract elements were executed during symbolic bound
+        // tightening, and number of layers skipped because their bounds had not changed
+        NUM_DEEP_POLY_LAYERS_EXECUTED,
+        NUM_DEEP_POLY_LAYERS_SKIPPED,
+
         // Number of pivot rows examined by the row tightener, and consequent
         // tightenings proposed.
         NUM_ROWS_EXAMINED_BY_ROW_TIGHTENER,
@@ -159,13 +181,35 @@ public:
         NUM_BOUND_TIGHTENINGS_ON_CONSTRAINT_MATRIX,
         NUM_TIGHTENINGS_FROM_CONSTRAINT_MATRIX,
 
+        // Number of constraint matrix rows examined during these rounds, rows
+        // skipped because they could not yield tighter bounds, and rows that
+        // yielded at least one tighter bound.
+        NUM_ROWS_EXAMINED_ON_CONSTRAINT_MATRIX,
+        NUM_ROWS_SKIPPED_ON_CONSTRAINT_MATRIX,
+        NUM_ROWS_TIGHTENED_ON_CONSTRAINT_MATRIX,
+
         // Basis factorization statistics
         NUM_BASIS_REFACTORIZATIONS,
 
+        // Number of refactorizations triggered by the refactorization policy, either because of
+        // the cost of the accumulated updates or because of high degradation, and the total time
+        // spent refactorizing
+        NUM_BASIS_REFACTORIZATIONS_DUE_TO_UPDATE_COST,
+        NUM_BASIS_REFACTORIZATIONS_DUE_TO_DEGRADATION,
+        TOTAL_TIME_BASIS_REFACTORIZATION_MICRO,
+
+        // Number of forward and backward transformations performed hypersparsely
+        NUM_HYPERSPARSE_FORWARD_TRANSFORMATIONS,
+        NUM_HYPERSPARSE_BACKWARD_TRANSFORMATIONS,
+
         // Projected steepest edge statistics
         PSE_NUM_ITERATIONS,
         PSE_NUM_RESET_REFERENCE_SPACE,
 
+        // Devex and partial pricing statistics
+        DEVEX_NUM_RESET_REFERENCE_FRAMEWORK,
+        PARTIAL_PRICING_NUM_POOL_REFRESHES,
+
         // Total amount of time spent performing valid case splits
         TOTAL_TIME_PERFORMING_VALID_CASE_SPLITS_MICRO,
         TOTAL_TIME_PERFORMING_SYMBOLIC_BOUND_TIGHTENING,
@@ -191,6 +235,15 @@ public:
         // Total amount of time spent within the SMT core
         TOTAL_TIME_SMT_CORE_MICRO,
 
+        // Conflict-driven learning in the SMT core: the number of learned conflict clauses, the
+        // number of backjumps that discarded stack entries with untried alternatives, the number
+        // of case splits implied by conflict clauses, and the time spent analyzing conflicts
+        // (which is part of the SMT core time)
+        NUM_CONFLICT_CLAUSES_LEARNED,
+        NUM_NON_CHRONOLOGICAL_BACKJUMPS,
+        NUM_CASE_SPLITS_IMPLIED_BY_CONFLICT_CLAUSES,
+        TOTAL_TIME_CONFLICT_ANALYSIS_MICRO,
+
         // Total time heuristically updating the SoI phase pattern
         TOTAL_TIME_UPDATING_SOI_PHASE_PATTERN_MICRO,
 
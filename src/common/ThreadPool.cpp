@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file ThreadPool.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "ThreadPool.h"
+
+#include "Debug.h"
+
+ThreadPool::ThreadPool( unsigned numThreads )
+    : _numThreads( numThreads > 0 ? numThreads : 1 )
+    , _threads( NULL )
+    , _task( NULL )
+    , _numTasks( 0 )
+    , _nextTask( 0 )
+    , _batch( 0 )
+    , _numBusyThreads( 0 )
+    , _exception( nullptr )
+    , _shutdown( false )
+{
+    if ( _numThreads > 1 )
+    {
+        _threads = new boost::thread[_numThreads - 1];
+        for ( unsigned i = 0; i < _numThreads - 1; ++i )
+            _threads[i] = boost::thread( &ThreadPool::workerLoop, this, i + 1 );
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    if ( _threads )
+    {
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            _shutdown = true;
+        }
+        _workAvailable.notify_all();
+
+        for ( unsigned i = 0; i < _numThreads - 1; ++i )
+            _threads[i].join();
+
+        delete[] _threads;
+        _threads = NULL;
+    }
+}
+
+unsigned ThreadPool::getNumThreads() const
+{
+    return _numThreads;
+}
+
+void ThreadPool::run( unsigned numTasks, const Task &task )
+{
+    if ( numTasks == 0 )
+        return;
+
+    if ( _numThreads == 1 )
+    {
+        for ( unsigned i = 0; i < numTasks; ++i )
+            task( i, 0 );
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        ASSERT( _numBusyThreads == 0 );
+        _task = &task;
+        _numTasks = numTasks;
+        _nextTask = 0;
+        _exception = nullptr;
+        _numBusyThreads = _numThreads - 1;
+        ++_batch;
+    }
+    _workAvailable.notify_all();
+
+    processTasks( 0 );
+
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+        _workDone.wait( lock, [this] { return _numBusyThreads == 0; } );
+        _task = NULL;
+        exception = _exception;
+        _exception = nullptr;
+    }
+
+    if ( exception )
+        std::rethrow_exception( exception );
+}
+
+void ThreadPool::workerLoop( unsigned thread )
+{
+    unsigned batch = 0;
+    while ( true )
+    {
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+            _workAvailable.wait( lock, [this, batch] { return _shutdown || _batch != batch; } );
+            if ( _shutdown )
+                return;
+            batch = _batch;
+        }
+
+        processTasks( thread );
+
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            --_numBusyThreads;
+            if ( _numBusyThreads == 0 )
+                _workDone.notify_one();
+        }
+    }
+}
+
+void ThreadPool::processTasks( unsigned thread )
+{
+    while ( true )
+    {
+        unsigned i = _nextTask++;
+        if ( i >= _numTasks )
+            return;
+
+        try
+        {
+            ( *_task )( i, thread );
+        }
+        catch ( ... )
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            if ( !_exception )
+                _exception = std::current_exception();
+        }
+    }
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
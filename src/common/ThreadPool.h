@@ -0,0 +1,87 @@
+/*********************                                                        */
+/*! \file ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __ThreadPool_h__
+#define __ThreadPool_h__
+
+#include <atomic>
+#include <boost/thread.hpp>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+/*
+  A persistent pool of threads, for running batches of independent tasks
+  in parallel without spawning new threads for every batch. The thread
+  that calls run() takes part in the work as thread 0, so a pool of size
+  1 spawns no threads and runs all tasks inline.
+*/
+class ThreadPool
+{
+public:
+    /*
+      A task is invoked with its index, and with the index of the thread
+      running it.
+    */
+    typedef std::function<void( unsigned, unsigned )> Task;
+
+    ThreadPool( unsigned numThreads );
+    ~ThreadPool();
+
+    unsigned getNumThreads() const;
+
+    /*
+      Invoke task( i, t ) for every i in [0, numTasks), and return once all
+      invocations are done. t < getNumThreads() identifies the thread, e.g.
+      for selecting per-thread working memory; which thread runs which
+      task is arbitrary. If any invocation throws, the first exception is
+      rethrown once all the others are done. Not reentrant.
+    */
+    void run( unsigned numTasks, const Task &task );
+
+private:
+    unsigned _numThreads;
+    boost::thread *_threads;
+
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _workDone;
+
+    /*
+      The current batch. _batch is incremented whenever a new batch is
+      posted, and every thread takes part in every batch.
+    */
+    const Task *_task;
+    unsigned _numTasks;
+    std::atomic_uint _nextTask;
+    unsigned _batch;
+    unsigned _numBusyThreads;
+    std::exception_ptr _exception;
+    bool _shutdown;
+
+    void workerLoop( unsigned thread );
+    void processTasks( unsigned thread );
+};
+
+#endif // __ThreadPool_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,109 @@
+/*********************                                                        */
+/*! \file Test_ThreadPool.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "CommonError.h"
+#include "MockErrno.h"
+#include "ThreadPool.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <cxxtest/TestSuite.h>
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    void test_single_thread_runs_inline()
+    {
+        ThreadPool pool( 1 );
+        TS_ASSERT_EQUALS( pool.getNumThreads(), 1U );
+
+        Vector<unsigned> order;
+        TS_ASSERT_THROWS_NOTHING( pool.run( 5, [&]( unsigned task, unsigned thread ) {
+            TS_ASSERT_EQUALS( thread, 0U );
+            order.append( task );
+        } ) );
+        TS_ASSERT_EQUALS( order, Vector<unsigned>( { 0, 1, 2, 3, 4 } ) );
+
+        // A size of 0 is treated as 1
+        ThreadPool defaultPool( 0 );
+        TS_ASSERT_EQUALS( defaultPool.getNumThreads(), 1U );
+    }
+
+    void test_every_task_runs_once()
+    {
+        ThreadPool pool( 4 );
+        TS_ASSERT_EQUALS( pool.getNumThreads(), 4U );
+
+        // The pool is reused for several batches
+        for ( unsigned numTasks = 0; numTasks < 50; ++numTasks )
+        {
+            Vector<unsigned> timesRun( numTasks, 0 );
+            std::atomic_uint badThreads( 0 );
+
+            TS_ASSERT_THROWS_NOTHING( pool.run( numTasks, [&]( unsigned task, unsigned thread ) {
+                ++timesRun[task];
+                if ( thread >= 4 )
+                    ++badThreads;
+            } ) );
+
+            for ( unsigned i = 0; i < numTasks; ++i )
+                TS_ASSERT_EQUALS( timesRun[i], 1U );
+            TS_ASSERT_EQUALS( badThreads.load(), 0U );
+        }
+    }
+
+    void test_exceptions_are_rethrown()
+    {
+        ThreadPool pool( 3 );
+        std::atomic_uint numRun( 0 );
+
+        ThreadPool::Task throwingTask = [&]( unsigned task, unsigned ) {
+            ++numRun;
+            if ( task == 7 )
+                throw CommonError( CommonError::VECTOR_OUT_OF_BOUNDS );
+        };
+
+        TS_ASSERT_THROWS_EQUALS( pool.run( 20, throwingTask ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::VECTOR_OUT_OF_BOUNDS );
+        TS_ASSERT_EQUALS( numRun.load(), 20U );
+
+        // The pool is still usable afterwards
+        numRun = 0;
+        TS_ASSERT_THROWS_NOTHING( pool.run( 10, [&]( unsigned, unsigned ) { ++numRun; } ) );
+        TS_ASSERT_EQUALS( numRun.load(), 10U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -62,15 +62,29 @@ const unsigned GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS = 5;
 const DivideStrategy GlobalConfiguration::SPLITTING_HEURISTICS = DivideStrategy::ReLUViolation;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_FREQUENCY = 10;
 const unsigned GlobalConfiguration::INTERVAL_SPLITTING_THRESHOLD = 10;
+const unsigned GlobalConfiguration::MAX_NUMBER_OF_CONFLICT_CLAUSES = 1000;
+const unsigned GlobalConfiguration::MAX_CONFLICT_ANALYSIS_PROPAGATIONS = 16;
 const unsigned GlobalConfiguration::BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY = 100;
 const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS = 20;
+const bool GlobalConfiguration::ROW_BOUND_TIGHTENER_USE_WORKLIST = true;
 const double GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD = 0.0000000001;
 
 const unsigned GlobalConfiguration::SIMULATION_RANDOM_SEED = 1;
 
 const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
+const bool GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST = true;
+
+const bool GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES = true;
+const unsigned GlobalConfiguration::DUAL_SIMPLEX_MAX_ITERATIONS = 100;
 
 const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.00000000001;
+const unsigned GlobalConfiguration::SYMBOLIC_BOUND_TIGHTENING_CONVERSION_BLOCK_SIZE = 1048576;
+const bool GlobalConfiguration::DEEP_POLY_INCREMENTAL_ANALYSIS = true;
+const unsigned GlobalConfiguration::DEEP_POLY_BACK_SUBSTITUTION_BLOCK_SIZE = 128;
+const unsigned GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS = 5;
+const double GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE = 0.5;
+const double GlobalConfiguration::NLR_SPARSE_WEIGHTS_DENSITY_THRESHOLD = 0.05;
+const unsigned GlobalConfiguration::NLR_PARALLEL_BATCH_MIN_SIZE = 16384;
 
 const double GlobalConfiguration::SIGMOID_CUTOFF_CONSTANT = 20;
 
@@ -89,6 +103,9 @@ const unsigned GlobalConfiguration::MAX_ITERATIONS_WITHOUT_PROGRESS = 10000;
 const unsigned GlobalConfiguration::PSE_ITERATIONS_BEFORE_RESET = 1000;
 const double GlobalConfiguration::PSE_GAMMA_ERROR_THRESHOLD = 0.001;
 const double GlobalConfiguration::PSE_GAMMA_UPDATE_TOLERANCE = 0.000000001;
+const unsigned GlobalConfiguration::DEVEX_ITERATIONS_BEFORE_RESET = 1000;
+const double GlobalConfiguration::DEVEX_MAXIMAL_WEIGHT = 1000000;
+const unsigned GlobalConfiguration::PARTIAL_PRICING_ITERATIONS_BEFORE_REFRESH = 10;
 
 const double GlobalConfiguration::CONSTRAINT_COMPARISON_TOLERANCE = 0.00001;
 
@@ -103,12 +120,16 @@ const bool GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION = fal
 const double GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_ROUNDING_CONSTANT = 1e-6;
 
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
+const unsigned GlobalConfiguration::ADAPTIVE_REFACTORIZATION_MAX_UPDATES = 500;
+const double GlobalConfiguration::ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD = 0.001;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
     GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
+const double GlobalConfiguration::HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD = 0.1;
 
 const unsigned GlobalConfiguration::POLARITY_CANDIDATES_THRESHOLD = 5;
 
 const unsigned GlobalConfiguration::DNC_DEPTH_THRESHOLD = 5;
+const unsigned GlobalConfiguration::DNC_CONNECT_TIMEOUT_IN_SECONDS = 60;
 
 const double GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING = 0.01;
 const double GlobalConfiguration::LEMMA_CERTIFICATION_TOLERANCE = 0.000001;
@@ -117,6 +138,10 @@ const bool GlobalConfiguration::WRITE_JSON_PROOF = false;
 const unsigned GlobalConfiguration::BACKWARD_BOUND_PROPAGATION_DEPTH = 3;
 const unsigned GlobalConfiguration::MAX_ROUNDS_OF_BACKWARD_ANALYSIS = 10;
 
+const unsigned GlobalConfiguration::SIMPLEX_SOLVER_MAX_ITERATIONS = 100000;
+const unsigned GlobalConfiguration::SIMPLEX_SOLVER_DEGENERATE_STEPS_BEFORE_BLAND = 50;
+const double GlobalConfiguration::SIMPLEX_SOLVER_DUAL_BOUND_RELATIVE_TOLERANCE = 0.000000001;
+
 #ifdef ENABLE_GUROBI
 const unsigned GlobalConfiguration::GUROBI_NUMBER_OF_THREADS = 1;
 const bool GlobalConfiguration::GUROBI_LOGGING = false;
@@ -174,15 +199,46 @@ void GlobalConfiguration::print()
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
     printf( "  BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY );
+    printf( "  MAX_NUMBER_OF_CONFLICT_CLAUSES: %u\n", MAX_NUMBER_OF_CONFLICT_CLAUSES );
+    printf( "  MAX_CONFLICT_ANALYSIS_PROPAGATIONS: %u\n", MAX_CONFLICT_ANALYSIS_PROPAGATIONS );
+    printf( "  ROW_BOUND_TIGHTENER_USE_WORKLIST: %s\n",
+            ROW_BOUND_TIGHTENER_USE_WORKLIST ? "Yes" : "No" );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
     printf( "  USE_HARRIS_RATIO_TEST: %s\n", USE_HARRIS_RATIO_TEST ? "Yes" : "No" );
+    printf( "  USE_BOUND_FLIPPING_RATIO_TEST: %s\n",
+            USE_BOUND_FLIPPING_RATIO_TEST ? "Yes" : "No" );
+    printf( "  USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES: %s\n",
+            USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES ? "Yes" : "No" );
+    printf( "  DUAL_SIMPLEX_MAX_ITERATIONS: %u\n", DUAL_SIMPLEX_MAX_ITERATIONS );
 
     printf( "  PREPROCESS_INPUT_QUERY: %s\n", PREPROCESS_INPUT_QUERY ? "Yes" : "No" );
     printf( "  PREPROCESSOR_ELIMINATE_VARIABLES: %s\n",
             PREPROCESSOR_ELIMINATE_VARIABLES ? "Yes" : "No" );
     printf( "  PSE_ITERATIONS_BEFORE_RESET: %u\n", PSE_ITERATIONS_BEFORE_RESET );
     printf( "  PSE_GAMMA_ERROR_THRESHOLD: %.15lf\n", PSE_GAMMA_ERROR_THRESHOLD );
+    printf( "  DEVEX_ITERATIONS_BEFORE_RESET: %u\n", DEVEX_ITERATIONS_BEFORE_RESET );
+    printf( "  DEVEX_MAXIMAL_WEIGHT: %.15lf\n", DEVEX_MAXIMAL_WEIGHT );
+    printf( "  PARTIAL_PRICING_ITERATIONS_BEFORE_REFRESH: %u\n",
+            PARTIAL_PRICING_ITERATIONS_BEFORE_REFRESH );
     printf( "  CONSTRAINT_COMPARISON_TOLERANCE: %.15lf\n", CONSTRAINT_COMPARISON_TOLERANCE );
+    printf( "  SYMBOLIC_BOUND_TIGHTENING_CONVERSION_BLOCK_SIZE: %u\n",
+            SYMBOLIC_BOUND_TIGHTENING_CONVERSION_BLOCK_SIZE );
+    printf( "  DEEP_POLY_INCREMENTAL_ANALYSIS: %s\n",
+            DEEP_POLY_INCREMENTAL_ANALYSIS ? "Yes" : "No" );
+    printf( "  DEEP_POLY_BACK_SUBSTITUTION_BLOCK_SIZE: %u\n",
+            DEEP_POLY_BACK_SUBSTITUTION_BLOCK_SIZE );
+    printf( "  DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS: %u\n",
+            DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS );
+    printf( "  DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE: %.15lf\n",
+            DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE );
+    printf( "  NLR_SPARSE_WEIGHTS_DENSITY_THRESHOLD: %.15lf\n",
+            NLR_SPARSE_WEIGHTS_DENSITY_THRESHOLD );
+    printf( "  NLR_PARALLEL_BATCH_MIN_SIZE: %u\n", NLR_PARALLEL_BATCH_MIN_SIZE );
+    printf( "  SIMPLEX_SOLVER_MAX_ITERATIONS: %u\n", SIMPLEX_SOLVER_MAX_ITERATIONS );
+    printf( "  SIMPLEX_SOLVER_DEGENERATE_STEPS_BEFORE_BLAND: %u\n",
+            SIMPLEX_SOLVER_DEGENERATE_STEPS_BEFORE_BLAND );
+    printf( "  SIMPLEX_SOLVER_DUAL_BOUND_RELATIVE_TOLERANCE: %.15lf\n",
+            SIMPLEX_SOLVER_DUAL_BOUND_RELATIVE_TOLERANCE );
 
     String basisBoundTighteningType;
     switch ( EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE )
@@ -205,6 +261,9 @@ void GlobalConfiguration::print()
     printf( "  EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION: %s\n",
             EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION ? "Yes" : "No" );
     printf( "  REFACTORIZATION_THRESHOLD: %u\n", REFACTORIZATION_THRESHOLD );
+    printf( "  ADAPTIVE_REFACTORIZATION_MAX_UPDATES: %u\n", ADAPTIVE_REFACTORIZATION_MAX_UPDATES );
+    printf( "  ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD: %.15lf\n",
+            ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD );
 
     String basisFactorizationType;
     if ( GlobalConfiguration::BASIS_FACTORIZATION_TYPE == GlobalConfiguration::LU_FACTORIZATION )
@@ -219,6 +278,8 @@ void GlobalConfiguration::print()
         basisFactorizationType = "Unknown";
 
     printf( "  BASIS_FACTORIZATION_TYPE: %s\n", basisFactorizationType.ascii() );
+    printf( "  HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD: %.2lf\n",
+            HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD );
     printf( "****************************\n" );
 }
 
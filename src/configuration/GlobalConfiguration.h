@@ -81,6 +81,18 @@ public:
     // Toggle use of Harris' two-pass ratio test for selecting the leaving variable
     static const bool USE_HARRIS_RATIO_TEST;
 
+    // Toggle use of the bound-flipping (long-step) ratio test when minimizing the sum of
+    // infeasibilities. When on, it replaces the Harris/standard ratio test in that phase
+    static const bool USE_BOUND_FLIPPING_RATIO_TEST;
+
+    // Toggle use of the dual simplex method when re-solving a subproblem whose bounds changed
+    // (e.g., after a case split or bound tightening) from a previously feasible basis
+    static const bool USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES;
+
+    // The maximal number of dual simplex steps performed in a subproblem before the engine falls
+    // back to the primal simplex method
+    static const unsigned DUAL_SIMPLEX_MAX_ITERATIONS;
+
     // Toggle query-preprocessing on/off.
     static const bool PREPROCESS_INPUT_QUERY;
 
@@ -138,6 +150,15 @@ public:
     // the number of inputs is larger than this number.
     static const unsigned INTERVAL_SPLITTING_THRESHOLD;
 
+    // With --conflict-learning, the maximal number of conflict clauses kept by the SMT core. Once
+    // the limit is reached, the oldest clause is discarded for every newly learned one.
+    static const unsigned MAX_NUMBER_OF_CONFLICT_CLAUSES;
+
+    // With --conflict-learning, the maximal number of decisions that conflict analysis tries to
+    // drop from a conflict, each of which costs a bound propagation from the root. The older
+    // decisions are kept in the conflict clause once the limit is reached.
+    static const unsigned MAX_CONFLICT_ANALYSIS_PROPAGATIONS;
+
     // How often should we perform full bound tightening, on the entire contraints matrix A.
     static const unsigned BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY;
 
@@ -145,6 +166,10 @@ public:
     // due to tiny increments in bounds. This number limits the number of iterations it can perform.
     static const unsigned ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS;
 
+    // Whether bound tightening on the constraint matrix only examines rows that contain variables
+    // whose bounds were tightened since the rows were last examined, instead of sweeping all rows.
+    static const bool ROW_BOUND_TIGHTENER_USE_WORKLIST;
+
     // If the cost function error exceeds this threshold, it is recomputed
     static const double COST_FUNCTION_ERROR_THRESHOLD;
 
@@ -161,6 +186,16 @@ public:
     // PSE's Gamma function's update tolerance
     static const double PSE_GAMMA_UPDATE_TOLERANCE;
 
+    // How often should Devex reset its reference framework?
+    static const unsigned DEVEX_ITERATIONS_BEFORE_RESET;
+
+    // A Devex weight which, when crossed, causes the reference framework to be reset
+    static const double DEVEX_MAXIMAL_WEIGHT;
+
+    // How many iterations partial pricing performs over its candidate pool before it rescans all
+    // the non-basic variables
+    static const unsigned PARTIAL_PRICING_ITERATIONS_BEFORE_REFRESH;
+
     // The tolerance for checking whether f = Constraint( b ), Constraint \in { ReLU, ABS, Sign}
     static const double CONSTRAINT_COMPARISON_TOLERANCE;
 
@@ -198,6 +233,37 @@ public:
     // Symbolic tightening rounding constant
     static const double SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT;
 
+    // When symbolic bounds are stored in single precision (--sbt-single-precision), a weighted-sum
+    // layer converts the bounds of its source layers back to double precision in blocks of about
+    // this many entries, instead of all at once.
+    static const unsigned SYMBOLIC_BOUND_TIGHTENING_CONVERSION_BLOCK_SIZE;
+
+    // When re-running DeepPoly, should layers whose bounds (and whose predecessors' bounds) have
+    // not changed since the previous run be skipped, reusing their previous results?
+    static const bool DEEP_POLY_INCREMENTAL_ANALYSIS;
+
+    // The number of neurons of a layer whose symbolic bounds are back-substituted together by
+    // DeepPoly. Blocks are processed in parallel, and each needs working memory proportional to
+    // the block size times the maximal layer size.
+    static const unsigned DEEP_POLY_BACK_SUBSTITUTION_BLOCK_SIZE;
+
+    // With --tightening-strategy=alpha-deeppoly, the number of projected-gradient steps taken on
+    // the lower-bound slopes of unstable ReLUs in each DeepPoly invocation, and the largest change
+    // to a slope in the first step. The step size is halved whenever a step does not improve the
+    // output bounds.
+    static const unsigned DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS;
+    static const double DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE;
+
+    // When constructing the network-level reasoner, the weights from a source layer into a
+    // weighted-sum layer are stored in sparse form if the fraction of non-zero weights is below
+    // this threshold (e.g., for convolutional layers)
+    static const double NLR_SPARSE_WEIGHTS_DENSITY_THRESHOLD;
+
+    // Batched evaluations and simulations of the network-level reasoner apply activation
+    // functions to blocks of samples in parallel only if the layer holds at least this many
+    // values (samples times neurons); smaller layers are not worth the synchronization.
+    static const unsigned NLR_PARALLEL_BATCH_MIN_SIZE;
+
     static const double SIGMOID_CUTOFF_CONSTANT;
 
     /*
@@ -219,6 +285,15 @@ public:
     // The number of accumualted eta matrices, after which the basis will be refactorized
     static const unsigned REFACTORIZATION_THRESHOLD;
 
+    // Under the adaptive refactorization policy: the maximal number of basis updates between two
+    // refactorizations, regardless of their cost
+    static const unsigned ADAPTIVE_REFACTORIZATION_MAX_UPDATES;
+
+    // Under the adaptive refactorization policy: a degradation which, when crossed, causes the
+    // basis to be refactorized on its next update. This is well below DEGRADATION_THRESHOLD, so
+    // that refactorization can prevent the need for precision restoration.
+    static const double ADAPTIVE_REFACTORIZATION_DEGRADATION_THRESHOLD;
+
     // The kind of basis factorization algorithm in use
     enum BasisFactorizationType {
         LU_FACTORIZATION,
@@ -228,6 +303,10 @@ public:
     };
     static const BasisFactorizationType BASIS_FACTORIZATION_TYPE;
 
+    // Forward and backward transformations whose right-hand side has a fraction of non-zero
+    // entries below this threshold are performed hypersparsely, if the factorization supports it
+    static const double HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD;
+
     /* In the polarity-based branching heuristics, only this many earliest nodes
        are considered to branch on.
     */
@@ -237,6 +316,10 @@ public:
      */
     static const unsigned DNC_DEPTH_THRESHOLD;
 
+    /* How long a distributed DnC worker keeps trying to connect to its coordinator
+     */
+    static const unsigned DNC_CONNECT_TIMEOUT_IN_SECONDS;
+
     /* Minimal coefficient of a variable in a Tableau row, that is used for bound tightening
      */
     static const double MINIMAL_COEFFICIENT_FOR_TIGHTENING;
@@ -257,6 +340,18 @@ public:
      */
     static const unsigned MAX_ROUNDS_OF_BACKWARD_ANALYSIS;
 
+    /* The native LP solver used for LP-relaxation bound tightening gives up after this many
+       simplex iterations per solve, and switches to Bland's rule after this many consecutive
+       degenerate iterations.
+     */
+    static const unsigned SIMPLEX_SOLVER_MAX_ITERATIONS;
+    static const unsigned SIMPLEX_SOLVER_DEGENERATE_STEPS_BEFORE_BLAND;
+
+    /* The bounds that the native LP solver derives from its simplex multipliers are loosened by
+       this fraction of the magnitude of the terms they sum, to account for rounding errors.
+     */
+    static const double SIMPLEX_SOLVER_DUAL_BOUND_RELATIVE_TOLERANCE;
+
 #ifdef ENABLE_GUROBI
     /*
       The number of threads Gurobi spawns
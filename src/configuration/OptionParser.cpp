@@ -146,7 +146,7 @@ void OptionParser::initialize()
         boost::program_options::value<std::string>(
             &( ( *_stringOptions )[Options::SYMBOLIC_BOUND_TIGHTENING_TYPE] ) )
             ->default_value( ( *_stringOptions )[Options::SYMBOLIC_BOUND_TIGHTENING_TYPE] ),
-        "type of bound tightening technique to use: sbt/deeppoly/none." )(
+        "type of bound tightening technique to use: sbt/deeppoly/alpha-deeppoly/none." )(
         "branch",
         boost::program_options::value<std::string>(
             &( ( *_stringOptions )[Options::SPLITTING_STRATEGY] ) )
@@ -201,6 +201,40 @@ void OptionParser::initialize()
         boost::program_options::bool_switch( &( ( *_boolOptions )[Options::RESTORE_TREE_STATES] ) )
             ->default_value( ( *_boolOptions )[Options::RESTORE_TREE_STATES] ),
         "(SnC) Restore tree states in SnC mode.\n" )(
+        "dnc-processes",
+        boost::program_options::value<int>( &( ( *_intOptions )[Options::NUM_DNC_PROCESSES] ) )
+            ->default_value( ( *_intOptions )[Options::NUM_DNC_PROCESSES] ),
+        "(SnC) Number of local worker processes to fork and serve subqueries to. Implies "
+        "--snc." )(
+        "dnc-listen",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::DNC_LISTEN_ADDRESS] ) )
+            ->default_value( ( *_stringOptions )[Options::DNC_LISTEN_ADDRESS] ),
+        "(SnC) Coordinate a distributed solve: serve subqueries to the worker processes that "
+        "connect to this address, 'unix:<path>' or '<host>:<port>'. Implies --snc." )(
+        "dnc-connect",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::DNC_CONNECT_ADDRESS] ) )
+            ->default_value( ( *_stringOptions )[Options::DNC_CONNECT_ADDRESS] ),
+        "(SnC) Serve as a worker of the distributed solve coordinated at this address. The "
+        "network and property must be the same as the coordinator's. Implies --snc." )(
+        "dnc-checkpoint",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::DNC_CHECKPOINT_FILE] ) )
+            ->default_value( ( *_stringOptions )[Options::DNC_CHECKPOINT_FILE] ),
+        "(SnC) Periodically save the subqueries that are not solved yet to this file. Implies "
+        "--snc." )(
+        "dnc-checkpoint-interval",
+        boost::program_options::value<int>(
+            &( ( *_intOptions )[Options::DNC_CHECKPOINT_INTERVAL] ) )
+            ->default_value( ( *_intOptions )[Options::DNC_CHECKPOINT_INTERVAL] ),
+        "(SnC) The number of seconds between two checkpoints, 0 to only write one when the solve "
+        "stops." )(
+        "resume",
+        boost::program_options::bool_switch( &( ( *_boolOptions )[Options::DNC_RESUME] ) )
+            ->default_value( ( *_boolOptions )[Options::DNC_RESUME] ),
+        "(SnC) Resume the solve saved in the --dnc-checkpoint file, with the same network and "
+        "property. Implies --snc." )(
         "blas-threads",
         boost::program_options::value<int>( &( ( *_intOptions )[Options::NUM_BLAS_THREADS] ) )
             ->default_value( ( *_intOptions )[Options::NUM_BLAS_THREADS] ),
@@ -241,33 +275,67 @@ void OptionParser::initialize()
             &( *_boolOptions )[Options::DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS] )
             ->default_value(
                 ( *_boolOptions )[Options::DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS] ),
-        "Do no merge consecutive weighted-sum layers." )
+        "Do no merge consecutive weighted-sum layers." )(
+        "sbt-streaming",
+        boost::program_options::bool_switch( &( *_boolOptions )[Options::STREAM_SYMBOLIC_BOUNDS] )
+            ->default_value( ( *_boolOptions )[Options::STREAM_SYMBOLIC_BOUNDS] ),
+        "Free the symbolic bounds of each layer once its successors are computed, so that symbolic "
+        "bound tightening keeps only the layers it currently needs." )(
+        "sbt-single-precision",
+        boost::program_options::bool_switch(
+            &( *_boolOptions )[Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS] )
+            ->default_value( ( *_boolOptions )[Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS] ),
+        "Store the symbolic bounds of symbolic bound tightening in single precision, rounded "
+        "outwards." )(
+        "conflict-learning",
+        boost::program_options::bool_switch(
+            &( *_boolOptions )[Options::CONFLICT_DRIVEN_LEARNING] )
+            ->default_value( ( *_boolOptions )[Options::CONFLICT_DRIVEN_LEARNING] ),
+        "Learn conflict clauses over the case splits and backjump non-chronologically when a "
+        "search state is infeasible." )(
+        "entry-strategy",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::ENTRY_SELECTION_STRATEGY] ) )
+            ->default_value( ( *_stringOptions )[Options::ENTRY_SELECTION_STRATEGY] ),
+        "The pricing rule of the native simplex: pse/devex/dantzig/bland." )(
+        "partial-pricing",
+        boost::program_options::value<int>(
+            &( ( *_intOptions )[Options::PARTIAL_PRICING_POOL_SIZE] ) )
+            ->default_value( ( *_intOptions )[Options::PARTIAL_PRICING_POOL_SIZE] ),
+        "Size of the entering candidate pool kept between full pricing passes of the native "
+        "simplex. 0 disables partial pricing." )(
+        "refactorization-policy",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::REFACTORIZATION_POLICY] ) )
+            ->default_value( ( *_stringOptions )[Options::REFACTORIZATION_POLICY] ),
+        "When the native simplex refactorizes its basis: fixed (every fixed number of updates)/"
+        "adaptive (when the amortized cost per update is minimal, or on high degradation)." )(
+        "num-simulations",
+        boost::program_options::value<int>( &( ( *_intOptions )[Options::NUMBER_OF_SIMULATIONS] ) )
+            ->default_value( ( *_intOptions )[Options::NUMBER_OF_SIMULATIONS] ),
+        "Number of simulations generated per neuron." )(
+        "lp-tightening-after-split",
+        boost::program_options::bool_switch(
+            &( ( *_boolOptions )[Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT] ) )
+            ->default_value( ( *_boolOptions )[Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT] ),
+        "Whether to skip a LP tightening after a case split." )(
+        "milp-tightening",
+        boost::program_options::value<std::string>(
+            &( ( *_stringOptions )[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE] ) )
+            ->default_value( ( *_stringOptions )[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE] ),
+        "The MILP solver bound tightening type: "
+        "lp/fb-once/fb-converge/lp-inc/milp/milp-inc/iter-prop/none. Without Gurobi, the LP "
+        "relaxations are solved natively, and milp/milp-inc/iter-prop are unavailable." )
 #ifdef ENABLE_GUROBI
         ( "lp-solver",
           boost::program_options::value<std::string>( &( ( *_stringOptions )[Options::LP_SOLVER] ) )
               ->default_value( ( *_stringOptions )[Options::LP_SOLVER] ),
           "Solver for the LPs during the complete analysis: native/gurobi." )(
-            "num-simulations",
-            boost::program_options::value<int>(
-                &( ( *_intOptions )[Options::NUMBER_OF_SIMULATIONS] ) )
-                ->default_value( ( *_intOptions )[Options::NUMBER_OF_SIMULATIONS] ),
-            "Number of simulations generated per neuron." )(
-            "lp-tightening-after-split",
-            boost::program_options::bool_switch(
-                &( ( *_boolOptions )[Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT] ) )
-                ->default_value( ( *_boolOptions )[Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT] ),
-            "Whether to skip a LP tightening after a case split." )(
             "milp-timeout",
             boost::program_options::value<float>(
                 &( ( *_floatOptions )[Options::MILP_SOLVER_TIMEOUT] ) )
                 ->default_value( ( *_floatOptions )[Options::MILP_SOLVER_TIMEOUT] ),
-            "Per-ReLU timeout for iterative propagation." )(
-            "milp-tightening",
-            boost::program_options::value<std::string>(
-                &( ( *_stringOptions )[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE] ) )
-                ->default_value( ( *_stringOptions )[Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE] ),
-            "The MILP solver bound tightening type: "
-            "lp/fb-once/fb-converge/lp-inc/milp/milp-inc/iter-prop/none." )
+            "Per-ReLU timeout for iterative propagation." )
 #endif
         ;
 
@@ -46,6 +46,7 @@ void Options::initializeDefaultValues()
     _boolOptions[DNC_MODE] = false;
     _boolOptions[PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS] = false;
     _boolOptions[RESTORE_TREE_STATES] = false;
+    _boolOptions[DNC_RESUME] = false;
     _boolOptions[DUMP_BOUNDS] = false;
     _boolOptions[DUMP_TOPOLOGY] = false;
     _boolOptions[SOLVE_WITH_MILP] = false;
@@ -55,6 +56,9 @@ void Options::initializeDefaultValues()
     _boolOptions[DEBUG_ASSIGNMENT] = false;
     _boolOptions[PRODUCE_PROOFS] = false;
     _boolOptions[DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS] = false;
+    _boolOptions[STREAM_SYMBOLIC_BOUNDS] = false;
+    _boolOptions[SINGLE_PRECISION_SYMBOLIC_BOUNDS] = false;
+    _boolOptions[CONFLICT_DRIVEN_LEARNING] = false;
 
     /*
       Int options
@@ -63,6 +67,8 @@ void Options::initializeDefaultValues()
     _intOptions[NUM_INITIAL_DIVIDES] = 0;
     _intOptions[NUM_ONLINE_DIVIDES] = 2;
     _intOptions[INITIAL_TIMEOUT] = 5;
+    _intOptions[NUM_DNC_PROCESSES] = 0;
+    _intOptions[DNC_CHECKPOINT_INTERVAL] = 300;
     _intOptions[VERBOSITY] = 2;
     _intOptions[TIMEOUT] = 0;
     _intOptions[CONSTRAINT_VIOLATION_THRESHOLD] = 20;
@@ -71,6 +77,7 @@ void Options::initializeDefaultValues()
     _intOptions[SEED] = 1;
     _intOptions[NUM_BLAS_THREADS] = 1;
     _intOptions[NUM_CONSTRAINTS_TO_REFINE_INC_LIN] = 30;
+    _intOptions[PARTIAL_PRICING_POOL_SIZE] = 0;
 
     /*
       Float options
@@ -99,7 +106,12 @@ void Options::initializeDefaultValues()
     _stringOptions[SOI_SEARCH_STRATEGY] = "mcmc";
     _stringOptions[SOI_INITIALIZATION_STRATEGY] = "input-assignment";
     _stringOptions[LP_SOLVER] = gurobiEnabled() ? "gurobi" : "native";
+    _stringOptions[ENTRY_SELECTION_STRATEGY] = "pse";
+    _stringOptions[REFACTORIZATION_POLICY] = "fixed";
     _stringOptions[SOFTMAX_BOUND_TYPE] = "lse";
+    _stringOptions[DNC_LISTEN_ADDRESS] = "";
+    _stringOptions[DNC_CONNECT_ADDRESS] = "";
+    _stringOptions[DNC_CHECKPOINT_FILE] = "";
 }
 
 void Options::parseOptions( int argc, char **argv )
@@ -187,6 +199,8 @@ SymbolicBoundTighteningType Options::getSymbolicBoundTighteningType() const
         return SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING;
     else if ( strategyString == "deeppoly" )
         return SymbolicBoundTighteningType::DEEP_POLY;
+    else if ( strategyString == "alpha-deeppoly" )
+        return SymbolicBoundTighteningType::ALPHA_DEEP_POLY;
     else if ( strategyString == "none" )
         return SymbolicBoundTighteningType::NONE;
     else
@@ -195,33 +209,30 @@ SymbolicBoundTighteningType Options::getSymbolicBoundTighteningType() const
 
 MILPSolverBoundTighteningType Options::getMILPSolverBoundTighteningType() const
 {
-    if ( gurobiEnabled() )
-    {
-        String strategyString =
-            String( _stringOptions.get( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ) );
-        if ( strategyString == "lp" )
-            return MILPSolverBoundTighteningType::LP_RELAXATION;
-        else if ( strategyString == "lp-inc" )
-            return MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL;
-        if ( strategyString == "backward-once" )
-            return MILPSolverBoundTighteningType::BACKWARD_ANALYSIS_ONCE;
-        if ( strategyString == "backward-converge" )
-            return MILPSolverBoundTighteningType::BACKWARD_ANALYSIS_CONVERGE;
-        else if ( strategyString == "milp" )
-            return MILPSolverBoundTighteningType::MILP_ENCODING;
-        else if ( strategyString == "milp-inc" )
-            return MILPSolverBoundTighteningType::MILP_ENCODING_INCREMENTAL;
-        else if ( strategyString == "iter-prop" )
-            return MILPSolverBoundTighteningType::ITERATIVE_PROPAGATION;
-        else if ( strategyString == "none" )
-            return MILPSolverBoundTighteningType::NONE;
-        else
-            return MILPSolverBoundTighteningType::LP_RELAXATION;
-    }
-    else
-    {
+    String strategyString =
+        String( _stringOptions.get( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE ) );
+    if ( strategyString == "lp" )
+        return MILPSolverBoundTighteningType::LP_RELAXATION;
+    else if ( strategyString == "lp-inc" )
+        return MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL;
+    if ( strategyString == "backward-once" )
+        return MILPSolverBoundTighteningType::BACKWARD_ANALYSIS_ONCE;
+    if ( strategyString == "backward-converge" )
+        return MILPSolverBoundTighteningType::BACKWARD_ANALYSIS_CONVERGE;
+    else if ( strategyString == "none" )
         return MILPSolverBoundTighteningType::NONE;
-    }
+
+    // The MILP-based types require Gurobi
+    if ( !gurobiEnabled() )
+        return MILPSolverBoundTighteningType::NONE;
+    else if ( strategyString == "milp" )
+        return MILPSolverBoundTighteningType::MILP_ENCODING;
+    else if ( strategyString == "milp-inc" )
+        return MILPSolverBoundTighteningType::MILP_ENCODING_INCREMENTAL;
+    else if ( strategyString == "iter-prop" )
+        return MILPSolverBoundTighteningType::ITERATIVE_PROPAGATION;
+    else
+        return MILPSolverBoundTighteningType::LP_RELAXATION;
 }
 
 SoISearchStrategy Options::getSoISearchStrategy() const
@@ -262,6 +273,30 @@ LPSolverType Options::getLPSolverType() const
         return gurobiEnabled() ? LPSolverType::GUROBI : LPSolverType::NATIVE;
 }
 
+EntrySelectionStrategyType Options::getEntrySelectionStrategyType() const
+{
+    String strategyString = String( _stringOptions.get( Options::ENTRY_SELECTION_STRATEGY ) );
+    if ( strategyString == "pse" )
+        return EntrySelectionStrategyType::PROJECTED_STEEPEST_EDGE;
+    else if ( strategyString == "devex" )
+        return EntrySelectionStrategyType::DEVEX;
+    else if ( strategyString == "dantzig" )
+        return EntrySelectionStrategyType::DANTZIG;
+    else if ( strategyString == "bland" )
+        return EntrySelectionStrategyType::BLAND;
+    else
+        return EntrySelectionStrategyType::PROJECTED_STEEPEST_EDGE;
+}
+
+RefactorizationPolicyType Options::getRefactorizationPolicyType() const
+{
+    String policyString = String( _stringOptions.get( Options::REFACTORIZATION_POLICY ) );
+    if ( policyString == "adaptive" )
+        return RefactorizationPolicyType::ADAPTIVE;
+    else
+        return RefactorizationPolicyType::FIXED;
+}
+
 SoftmaxBoundType Options::getSoftmaxBoundType() const
 {
     String boundType = String( _stringOptions.get( Options::SOFTMAX_BOUND_TYPE ) );
@@ -17,11 +17,13 @@
 #define __Options_h__
 
 #include "DivideStrategy.h"
+#include "EntrySelectionStrategyType.h"
 #include "LPSolverType.h"
 #include "MILPSolverBoundTighteningType.h"
 #include "MString.h"
 #include "Map.h"
 #include "OptionParser.h"
+#include "RefactorizationPolicyType.h"
 #include "SnCDivideStrategy.h"
 #include "SoIInitializationStrategy.h"
 #include "SoISearchStrategy.h"
@@ -45,6 +47,10 @@ public:
         // Restore tree states of the parent when handling children in DnC.
         RESTORE_TREE_STATES,
 
+        // Resume a DnC solve from the frontier saved in its checkpoint file,
+        // instead of dividing the input query
+        DNC_RESUME,
+
         // Dump the bounds of each variable after preprocessing
         DUMP_BOUNDS,
 
@@ -83,6 +89,18 @@ public:
         // logically-consecutive weighted sum layers into a single
         // weighted sum layer, to reduce the number of variables
         DO_NOT_MERGE_CONSECUTIVE_WEIGHTED_SUM_LAYERS,
+
+        // Keep the symbolic bounds of a layer only until all the layers that
+        // read them have computed their own, to bound the memory of symbolic
+        // bound tightening
+        STREAM_SYMBOLIC_BOUNDS,
+
+        // Store computed symbolic bounds in single precision, rounded outwards
+        SINGLE_PRECISION_SYMBOLIC_BOUNDS,
+
+        // Learn conflict clauses over the case splits of the SMT core, and
+        // backjump non-chronologically when a search state is infeasible
+        CONFLICT_DRIVEN_LEARNING,
     };
 
     enum IntOptions {
@@ -92,6 +110,13 @@ public:
         NUM_ONLINE_DIVIDES,
         INITIAL_TIMEOUT,
 
+        // The number of local worker processes forked by a distributed DnC
+        // coordinator
+        NUM_DNC_PROCESSES,
+
+        // The number of seconds between two checkpoints of a DnC solve
+        DNC_CHECKPOINT_INTERVAL,
+
         // Engine verbosity
         VERBOSITY,
 
@@ -115,6 +140,10 @@ public:
 
         // Maximal number of constraints to refine in incremental linearization
         NUM_CONSTRAINTS_TO_REFINE_INC_LIN,
+
+        // The number of entering candidates kept by partial pricing between full
+        // pricing passes. 0 disables partial pricing.
+        PARTIAL_PRICING_POOL_SIZE,
     };
 
     enum FloatOptions {
@@ -155,7 +184,21 @@ public:
         SOI_INITIALIZATION_STRATEGY,
 
         // The procedure/solver for solving the LP
-        LP_SOLVER
+        LP_SOLVER,
+
+        // The pricing rule used by the native simplex to pick entering variables
+        ENTRY_SELECTION_STRATEGY,
+
+        // When the basis factorization of the native simplex is recomputed
+        REFACTORIZATION_POLICY,
+
+        // Distributed DnC: the address on which the coordinator accepts
+        // workers, and the address of the coordinator that a worker serves
+        DNC_LISTEN_ADDRESS,
+        DNC_CONNECT_ADDRESS,
+
+        // The file to which the frontier of a DnC solve is saved
+        DNC_CHECKPOINT_FILE,
     };
 
     /*
@@ -187,6 +230,8 @@ public:
     SoIInitializationStrategy getSoIInitializationStrategy() const;
     SoISearchStrategy getSoISearchStrategy() const;
     LPSolverType getLPSolverType() const;
+    EntrySelectionStrategyType getEntrySelectionStrategyType() const;
+    RefactorizationPolicyType getRefactorizationPolicyType() const;
     SoftmaxBoundType getSoftmaxBoundType() const;
 
     /*
@@ -496,6 +496,8 @@ PiecewiseLinearCaseSplit AbsoluteValueConstraint::getValidCaseSplit() const
 
 void AbsoluteValueConstraint::eliminateVariable( unsigned variable, double /* fixedValue */ )
 {
+    stateChanged();
+
     (void)variable;
     ASSERT( ( variable == _f ) || ( variable == _b ) ||
             ( _auxVarsInUse && ( variable == _posAux || variable == _negAux ) ) );
@@ -547,6 +549,8 @@ void AbsoluteValueConstraint::dump( String &output ) const
 
 void AbsoluteValueConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    stateChanged();
+
     // Variable reindexing can only occur in preprocessing before Gurobi is
     // registered.
     ASSERT( _gurobi == NULL );
@@ -687,6 +691,8 @@ void AbsoluteValueConstraint::getEntailedTightenings( List<Tightening> &tighteni
 
 void AbsoluteValueConstraint::transformToUseAuxVariables( Query &inputQuery )
 {
+    stateChanged();
+
     /*
       We want to add the two equations
 
@@ -963,6 +969,8 @@ const List<unsigned> AbsoluteValueConstraint::getNativeAuxVars() const
 
 void AbsoluteValueConstraint::addTableauAuxVar( unsigned tableauAuxVar, unsigned constraintAuxVar )
 {
+    stateChanged();
+
     ASSERT( constraintAuxVar == _negAux || constraintAuxVar == _posAux );
     if ( _tableauAuxVars.size() == 2 )
         return;
@@ -179,6 +179,8 @@ bool BoundManager::setLowerBound( unsigned variable, double value )
         *_tightenedLower[variable] = true;
         if ( !consistentBounds( variable ) )
             recordInconsistentBound( variable, value, Tightening::LB );
+        if ( _rowBoundTightener )
+            _rowBoundTightener->notifyBoundTightened( variable );
         return true;
     }
     return false;
@@ -194,6 +196,8 @@ bool BoundManager::setUpperBound( unsigned variable, double value )
         *_tightenedUpper[variable] = true;
         if ( !consistentBounds( variable ) )
             recordInconsistentBound( variable, value, Tightening::UB );
+        if ( _rowBoundTightener )
+            _rowBoundTightener->notifyBoundTightened( variable );
         return true;
     }
     return false;
@@ -120,6 +120,22 @@ void ConstraintMatrixAnalyzer::analyze( const SparseUnsortedList **matrix, unsig
     gaussianElimination();
 }
 
+void ConstraintMatrixAnalyzer::analyze( const SparseUnsortedArrays *matrix, unsigned m, unsigned n )
+{
+    freeMemoryIfNeeded();
+
+    _m = m;
+    _n = n;
+
+    matrix->storeIntoOther( &_A );
+    _A.transposeIntoOther( &_At );
+
+    allocateMemory();
+
+    // Perform the actual Gaussian elimination
+    gaussianElimination();
+}
+
 void ConstraintMatrixAnalyzer::allocateMemory()
 {
     // Initialize the row and column headers
@@ -61,6 +61,13 @@ void CostFunctionManager::freeMemoryIfNeeded()
 
 void CostFunctionManager::initialize()
 {
+    // The work memory is kept if the dimensions did not change
+    if ( _costFunction && _tableau->getN() == _n && _tableau->getM() == _m )
+    {
+        invalidateCostFunction();
+        return;
+    }
+
     _n = _tableau->getN();
     _m = _tableau->getM();
 
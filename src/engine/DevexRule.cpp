@@ -0,0 +1,178 @@
+/*********************                                                        */
+/*! \file DevexRule.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DevexRule.h"
+
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "MarabouError.h"
+#include "Statistics.h"
+#include "TableauRow.h"
+
+#include <algorithm>
+
+DevexRule::DevexRule()
+    : _weights( NULL )
+    , _m( 0 )
+    , _n( 0 )
+    , _iterationsUntilReset( GlobalConfiguration::DEVEX_ITERATIONS_BEFORE_RESET )
+    , _maximalWeight( 1.0 )
+{
+}
+
+DevexRule::~DevexRule()
+{
+    freeIfNeeded();
+}
+
+void DevexRule::freeIfNeeded()
+{
+    if ( _weights )
+    {
+        delete[] _weights;
+        _weights = NULL;
+    }
+}
+
+void DevexRule::initialize( const ITableau &tableau )
+{
+    freeIfNeeded();
+
+    _n = tableau.getN();
+    _m = tableau.getM();
+
+    _weights = new double[_n - _m];
+    if ( !_weights )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DevexRule::weights" );
+
+    resetReferenceFramework();
+}
+
+void DevexRule::resetReferenceFramework()
+{
+    std::fill_n( _weights, _n - _m, 1.0 );
+
+    _iterationsUntilReset = GlobalConfiguration::DEVEX_ITERATIONS_BEFORE_RESET;
+    _maximalWeight = 1.0;
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::DEVEX_NUM_RESET_REFERENCE_FRAMEWORK );
+}
+
+bool DevexRule::select( ITableau &tableau,
+                        const List<unsigned> &candidates,
+                        const Set<unsigned> &excluded )
+{
+    const double *costFunction = tableau.getCostFunction();
+
+    bool found = false;
+    unsigned bestCandidate = 0;
+    double bestValue = 0.0;
+
+    for ( const auto &candidate : candidates )
+    {
+        if ( excluded.exists( candidate ) )
+            continue;
+
+        double contenderValue =
+            ( costFunction[candidate] * costFunction[candidate] ) / _weights[candidate];
+
+        if ( !found || contenderValue > bestValue )
+        {
+            found = true;
+            bestCandidate = candidate;
+            bestValue = contenderValue;
+        }
+    }
+
+    if ( !found )
+        return false;
+
+    tableau.setEnteringVariableIndex( bestCandidate );
+    return true;
+}
+
+void DevexRule::prePivotHook( const ITableau &tableau, bool fakePivot )
+{
+    // If the pivot is fake, the basis does not change
+    if ( fakePivot )
+        return;
+
+    unsigned enteringIndex = tableau.getEnteringVariableIndex();
+    unsigned leavingIndex = tableau.getLeavingVariableIndex();
+    double pivotElement = tableau.getChangeColumn()[leavingIndex];
+
+    ASSERT( !FloatUtils::isZero( pivotElement ) );
+
+    const TableauRow &pivotRow = *tableau.getPivotRow();
+    double enteringWeight = _weights[enteringIndex];
+
+    /*
+      Each non-basic variable j inherits a share of the entering variable's
+      weight, according to its coefficient in the pivot row:
+
+        weight[j] = max( weight[j], ( pivotRow[j] / pivotElement )^2 * weight[q] )
+    */
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        if ( i == enteringIndex || FloatUtils::isZero( pivotRow[i] ) )
+            continue;
+
+        double ratio = pivotRow[i] / pivotElement;
+        double candidateWeight = ratio * ratio * enteringWeight;
+        if ( candidateWeight > _weights[i] )
+        {
+            _weights[i] = candidateWeight;
+            if ( candidateWeight > _maximalWeight )
+                _maximalWeight = candidateWeight;
+        }
+    }
+
+    // The leaving variable takes the entering variable's non-basic index
+    double leavingWeight = enteringWeight / ( pivotElement * pivotElement );
+    _weights[enteringIndex] = leavingWeight > 1.0 ? leavingWeight : 1.0;
+    if ( _weights[enteringIndex] > _maximalWeight )
+        _maximalWeight = _weights[enteringIndex];
+}
+
+void DevexRule::postPivotHook( const ITableau & /* tableau */, bool fakePivot )
+{
+    if ( fakePivot )
+        return;
+
+    --_iterationsUntilReset;
+    if ( _iterationsUntilReset <= 0 || _maximalWeight > GlobalConfiguration::DEVEX_MAXIMAL_WEIGHT )
+        resetReferenceFramework();
+}
+
+void DevexRule::resizeHook( const ITableau &tableau )
+{
+    initialize( tableau );
+}
+
+double DevexRule::getWeight( unsigned index ) const
+{
+    return _weights[index];
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,109 @@
+/*********************                                                        */
+/*! \file DevexRule.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DevexRule_h__
+#define __DevexRule_h__
+
+#include "EntrySelectionStrategy.h"
+
+class DevexRule : public EntrySelectionStrategy
+{
+public:
+    DevexRule();
+    ~DevexRule();
+
+    /*
+      Allocate the weights according to the size of the tableau, and
+      reset the reference framework.
+    */
+    void initialize( const ITableau &tableau );
+
+    /*
+      Apply the Devex rule: pick the candidate for which the value of
+
+                  costFunction[i]^2
+                  -----------------
+                      weight[i]
+
+      is maximal.
+    */
+    bool
+    select( ITableau &tableau, const List<unsigned> &candidates, const Set<unsigned> &excluded );
+
+    /*
+      Update the weights according to the pivot row. Unlike projected
+      steepest edge, this requires no additional transformations and no
+      access to the constraint matrix.
+    */
+    void prePivotHook( const ITableau &tableau, bool fakePivot );
+
+    /*
+      Reset the reference framework if the weights have grown too large,
+      or if too many iterations have passed since the last reset.
+    */
+    void postPivotHook( const ITableau &tableau, bool fakePivot );
+
+    /*
+      This hook is called when the tableau has been resized.
+    */
+    void resizeHook( const ITableau &tableau );
+
+    /*
+      For debugging purposes.
+    */
+    double getWeight( unsigned index ) const;
+
+private:
+    /*
+      The Devex reference weights, indexed by non-basic index.
+    */
+    double *_weights;
+
+    /*
+      Tableau dimensions.
+    */
+    unsigned _m;
+    unsigned _n;
+
+    /*
+      Remaining iterations before resetting the reference framework.
+    */
+    int _iterationsUntilReset;
+
+    /*
+      The largest weight computed in the previous iteration.
+    */
+    double _maximalWeight;
+
+    /*
+      Reset the reference framework to the current non-basic variables.
+    */
+    void resetReferenceFramework();
+
+    /*
+      Free all data structures.
+    */
+    void freeIfNeeded();
+};
+
+#endif // __DevexRule_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -252,6 +252,8 @@ PiecewiseLinearCaseSplit DisjunctionConstraint::getValidCaseSplit() const
 
 void DisjunctionConstraint::transformToUseAuxVariables( Query &inputQuery )
 {
+    stateChanged();
+
     Vector<PiecewiseLinearCaseSplit> newDisjuncts;
     for ( const auto &disjunct : _disjuncts )
     {
@@ -343,6 +345,8 @@ void DisjunctionConstraint::dump( String &output ) const
 
 void DisjunctionConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    stateChanged();
+
     // Variable reindexing can only occur in preprocessing before Gurobi is
     // registered.
     ASSERT( _gurobi == NULL );
@@ -433,6 +437,8 @@ String DisjunctionConstraint::serializeToString() const
 
 void DisjunctionConstraint::extractParticipatingVariables()
 {
+    stateChanged();
+
     _participatingVariables.clear();
 
     for ( const auto &disjunct : _disjuncts )
@@ -483,6 +489,8 @@ bool DisjunctionConstraint::disjunctSatisfied( const PiecewiseLinearCaseSplit &d
 
 void DisjunctionConstraint::updateFeasibleDisjuncts()
 {
+    stateChanged();
+
     _feasibleDisjuncts.clear();
 
     for ( unsigned ind = 0; ind < _disjuncts.size(); ++ind )
@@ -538,6 +546,8 @@ List<PiecewiseLinearCaseSplit> DisjunctionConstraint::getFeasibleDisjuncts() con
 
 bool DisjunctionConstraint::removeFeasibleDisjunct( const PiecewiseLinearCaseSplit &disjunct )
 {
+    stateChanged();
+
     for ( unsigned i = 0; i < _disjuncts.size(); ++i )
         if ( _disjuncts[i] == disjunct )
         {
@@ -550,6 +560,8 @@ bool DisjunctionConstraint::removeFeasibleDisjunct( const PiecewiseLinearCaseSpl
 
 bool DisjunctionConstraint::addFeasibleDisjunct( const PiecewiseLinearCaseSplit &disjunct )
 {
+    stateChanged();
+
     for ( unsigned i = 0; i < _disjuncts.size(); ++i )
         if ( _disjuncts[i] == disjunct )
         {
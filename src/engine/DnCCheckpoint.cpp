@@ -0,0 +1,227 @@
+/*********************                                                        */
+/*! \file DnCCheckpoint.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCCheckpoint.h"
+
+#include "DnCProtocol.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+DnCCheckpoint::DnCCheckpoint( const String &path, const String &hello )
+    : _path( path )
+    , _hello( hello )
+    , _version( 1 )
+    , _writtenVersion( 0 )
+    , _stopWriting( false )
+{
+}
+
+DnCCheckpoint::~DnCCheckpoint()
+{
+    stopWriter();
+}
+
+void DnCCheckpoint::add( const SubQueries &subQueries )
+{
+    List<Entry> entries;
+    encode( subQueries, entries );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    for ( const auto &entry : entries )
+        _frontier[entry.first] = entry.second;
+    ++_version;
+}
+
+void DnCCheckpoint::replace( const String &queryId, const SubQueries &subQueries )
+{
+    List<Entry> entries;
+    encode( subQueries, entries );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( _frontier.exists( queryId ) )
+        _frontier.erase( queryId );
+    for ( const auto &entry : entries )
+        _frontier[entry.first] = entry.second;
+    ++_version;
+}
+
+void DnCCheckpoint::remove( const String &queryId )
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    if ( _frontier.exists( queryId ) )
+        _frontier.erase( queryId );
+    ++_version;
+}
+
+unsigned DnCCheckpoint::size() const
+{
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _frontier.size();
+}
+
+void DnCCheckpoint::encode( const SubQueries &subQueries, List<Entry> &entries )
+{
+    // Done before locking, so that the workers only wait for the bookkeeping
+    for ( const auto &subQuery : subQueries )
+    {
+        String encoding;
+        DnCProtocol::encodeSubQuery( *subQuery, encoding );
+        entries.append( Entry( subQuery->_queryId, encoding ) );
+    }
+}
+
+void DnCCheckpoint::startWriting( unsigned intervalInSeconds )
+{
+    // Fail before solving if the file cannot be written
+    write();
+
+    if ( intervalInSeconds == 0 )
+        return;
+
+    _stopWriting = false;
+    _writer = std::thread( [this, intervalInSeconds] {
+        std::unique_lock<std::mutex> lock( _writerMutex );
+        while ( !_stopRequested.wait_for( lock,
+                                          std::chrono::seconds( intervalInSeconds ),
+                                          [this] { return _stopWriting; } ) )
+        {
+            lock.unlock();
+            try
+            {
+                write();
+            }
+            catch ( const MarabouError &e )
+            {
+                // Keep solving, the next write may succeed
+                fprintf( stderr, "DnCCheckpoint: %s\n", e.getUserMessage() );
+            }
+            lock.lock();
+        }
+    } );
+}
+
+void DnCCheckpoint::stopWriting()
+{
+    stopWriter();
+    write();
+}
+
+void DnCCheckpoint::stopWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock( _writerMutex );
+        _stopWriting = true;
+    }
+    _stopRequested.notify_all();
+
+    if ( _writer.joinable() )
+        _writer.join();
+}
+
+void DnCCheckpoint::write()
+{
+    std::lock_guard<std::mutex> writeLock( _writeMutex );
+
+    // Snapshot the frontier
+    List<String> subQueries;
+    unsigned long long version;
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        if ( _version == _writtenVersion )
+            return;
+
+        version = _version;
+        for ( const auto &subQuery : _frontier )
+            subQueries.append( subQuery.second );
+    }
+
+    // Through stdio, which buffers the many small writes
+    String temporaryPath = _path + ".tmp";
+    FILE *file = fopen( temporaryPath.ascii(), "w" );
+    if ( !file )
+        throw MarabouError(
+            MarabouError::DNC_CHECKPOINT_FAILED,
+            Stringf( "cannot write %s: %s", temporaryPath.ascii(), strerror( errno ) ).ascii() );
+
+    fputs( DnCProtocol::encodeCheckpointHeader( _hello, subQueries.size() ).ascii(), file );
+    for ( const auto &subQuery : subQueries )
+        fputs( subQuery.ascii(), file );
+
+    bool failed = ferror( file );
+    if ( fclose( file ) != 0 || failed )
+        throw MarabouError( MarabouError::DNC_CHECKPOINT_FAILED,
+                            Stringf( "cannot write %s", temporaryPath.ascii() ).ascii() );
+
+    // Replace the previous checkpoint at once
+    if ( std::rename( temporaryPath.ascii(), _path.ascii() ) != 0 )
+        throw MarabouError(
+            MarabouError::DNC_CHECKPOINT_FAILED,
+            Stringf( "cannot replace %s: %s", _path.ascii(), strerror( errno ) ).ascii() );
+
+    _writtenVersion = version;
+}
+
+void DnCCheckpoint::read( const String &path, const String &hello, SubQueries &subQueries )
+{
+    FILE *file = fopen( path.ascii(), "r" );
+    if ( !file )
+        throw MarabouError(
+            MarabouError::DNC_CHECKPOINT_FAILED,
+            Stringf( "cannot read %s: %s", path.ascii(), strerror( errno ) ).ascii() );
+
+    List<String> lines;
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    while ( ( length = getline( &line, &capacity, file ) ) >= 0 )
+    {
+        if ( length > 0 && line[length - 1] == '\n' )
+            line[length - 1] = '\0';
+        lines.append( line );
+    }
+    free( line );
+    fclose( file );
+
+    String checkpointHello;
+    SubQueries decoded;
+    DnCProtocol::decodeCheckpoint( lines, checkpointHello, decoded );
+
+    if ( checkpointHello != hello )
+    {
+        for ( const auto &subQuery : decoded )
+            delete subQuery;
+        throw MarabouError( MarabouError::DNC_CHECKPOINT_FAILED,
+                            Stringf( "the checkpoint (%s) is of another query than ours (%s)",
+                                     checkpointHello.ascii(),
+                                     hello.ascii() )
+                                .ascii() );
+    }
+
+    subQueries.append( decoded );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,147 @@
+/*********************                                                        */
+/*! \file DnCCheckpoint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __DnCCheckpoint_h__
+#define __DnCCheckpoint_h__
+
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "SubQuery.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/*
+  The frontier of a DnC solve, i.e. the subqueries that are not solved yet,
+  whether pending or being solved, saved periodically to a file so that a
+  solve that is stopped can be resumed without solving again the subtrees
+  that were done.
+
+  The workers record the subqueries as they are divided and solved, and the
+  frontier keeps them encoded as in DnCProtocol. A writer thread takes a
+  snapshot of the frontier, which only copies the encodings under the lock,
+  and writes it to a temporary file that then replaces the checkpoint. The
+  workers thus never wait for the file, and a solve that is killed while
+  writing leaves the previous checkpoint intact.
+
+  The SmtState of the subqueries is not saved, as it refers to the
+  constraints of the engine that stored it.
+*/
+class DnCCheckpoint
+{
+public:
+    /*
+      A checkpoint of the query introduced by the hello message (see
+      DnCProtocol), saved to the given path
+    */
+    DnCCheckpoint( const String &path, const String &hello );
+
+    /*
+      Stop the writer thread, if running, without writing
+    */
+    ~DnCCheckpoint();
+
+    /*
+      Record subqueries to be solved
+    */
+    void add( const SubQueries &subQueries );
+
+    /*
+      Record that the subquery of the given id timed out, and was replaced
+      by the subqueries its divider created. Must be called before these are
+      handed to other workers, which could solve them first.
+    */
+    void replace( const String &queryId, const SubQueries &subQueries );
+
+    /*
+      Record that the subquery of the given id was solved (UNSAT)
+    */
+    void remove( const String &queryId );
+
+    /*
+      The number of subqueries in the frontier
+    */
+    unsigned size() const;
+
+    /*
+      Write the frontier now, and then every intervalInSeconds seconds from a
+      writer thread, if it changed
+    */
+    void startWriting( unsigned intervalInSeconds );
+
+    /*
+      Stop the writer thread, and write the final frontier
+    */
+    void stopWriting();
+
+    /*
+      Write the frontier to the file, unless it is unchanged since the last
+      write
+    */
+    void write();
+
+    /*
+      Read the checkpoint of the query introduced by the hello message, and
+      throw if it was saved for another query, e.g. another property of the
+      same network, whose refuted subtrees may not be refuted for this one.
+      The caller owns the subqueries appended to subQueries.
+    */
+    static void read( const String &path, const String &hello, SubQueries &subQueries );
+
+private:
+    /*
+      A subquery id and its encoding
+    */
+    typedef std::pair<String, String> Entry;
+
+    static void encode( const SubQueries &subQueries, List<Entry> &entries );
+
+    void stopWriter();
+
+    String _path;
+    String _hello;
+
+    /*
+      The encoded subqueries, by id, and the number of times they changed
+    */
+    mutable std::mutex _mutex;
+    Map<String, String> _frontier;
+    unsigned long long _version;
+
+    /*
+      The version of the frontier in the file. Writes are serialized by
+      _writeMutex.
+    */
+    std::mutex _writeMutex;
+    unsigned long long _writtenVersion;
+
+    std::thread _writer;
+    std::mutex _writerMutex;
+    std::condition_variable _stopRequested;
+    bool _stopWriting;
+};
+
+#endif // __DnCCheckpoint_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
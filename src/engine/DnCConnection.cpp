@@ -0,0 +1,382 @@
+/*********************                                                        */
+/*! \file DnCConnection.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCConnection.h"
+
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "TimeUtils.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+enum {
+    // Messages are small; anything larger comes from a corrupted stream
+    MAX_MESSAGE_LENGTH = 1 << 30,
+
+    CONNECT_RETRY_INTERVAL_IN_MILLISECONDS = 100,
+};
+
+static const char *UNIX_ADDRESS_PREFIX = "unix:";
+
+static bool isUnixAddress( const String &address )
+{
+    return address.length() >= strlen( UNIX_ADDRESS_PREFIX ) &&
+           address.substring( 0, strlen( UNIX_ADDRESS_PREFIX ) ) == UNIX_ADDRESS_PREFIX;
+}
+
+static void toUnixSocketAddress( const String &address, struct sockaddr_un &socketAddress )
+{
+    String path = address.substring( strlen( UNIX_ADDRESS_PREFIX ), address.length() );
+    if ( path.length() == 0 || path.length() >= sizeof( socketAddress.sun_path ) )
+        throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                            Stringf( "invalid Unix socket path: %s", path.ascii() ).ascii() );
+
+    memset( &socketAddress, 0, sizeof( socketAddress ) );
+    socketAddress.sun_family = AF_UNIX;
+    strncpy( socketAddress.sun_path, path.ascii(), sizeof( socketAddress.sun_path ) - 1 );
+}
+
+/*
+  Resolve a "<host>:<port>" address. The caller frees the result with
+  freeaddrinfo().
+*/
+static struct addrinfo *resolveTcpAddress( const String &address, bool passive )
+{
+    std::string text( address.ascii() );
+    size_t separator = text.rfind( ':' );
+    if ( separator == std::string::npos || separator + 1 == text.size() )
+        throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                            Stringf( "invalid address (expected unix:<path> or <host>:<port>): %s",
+                                     address.ascii() )
+                                .ascii() );
+
+    std::string host = text.substr( 0, separator );
+    std::string port = text.substr( separator + 1 );
+
+    struct addrinfo hints;
+    memset( &hints, 0, sizeof( hints ) );
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if ( passive )
+        hints.ai_flags = AI_PASSIVE;
+
+    struct addrinfo *result = NULL;
+    int error = getaddrinfo( host.empty() ? NULL : host.c_str(), port.c_str(), &hints, &result );
+    if ( error != 0 )
+        throw MarabouError(
+            MarabouError::DNC_CONNECTION_FAILED,
+            Stringf( "cannot resolve %s: %s", address.ascii(), gai_strerror( error ) ).ascii() );
+
+    return result;
+}
+
+static void configureSocket( int descriptor, bool tcp )
+{
+#ifdef SO_NOSIGPIPE
+    // Where MSG_NOSIGNAL is unavailable, a closed peer must not kill us
+    int noSigPipe = 1;
+    setsockopt( descriptor, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof( noSigPipe ) );
+#endif
+    if ( tcp )
+    {
+        // Messages are sent whole and answered, so do not delay them
+        int noDelay = 1;
+        setsockopt( descriptor, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof( noDelay ) );
+    }
+}
+
+DnCConnection::DnCConnection( int descriptor )
+    : _descriptor( descriptor )
+{
+}
+
+DnCConnection::~DnCConnection()
+{
+    if ( _descriptor >= 0 )
+    {
+        close( _descriptor );
+        _descriptor = -1;
+    }
+}
+
+DnCConnection *DnCConnection::connect( const String &address, unsigned timeoutInSeconds )
+{
+    struct timespec start = TimeUtils::sampleMicro();
+    unsigned long long timeoutInMicroSeconds = (unsigned long long)timeoutInSeconds * 1000000;
+    bool unixSocket = isUnixAddress( address );
+
+    while ( true )
+    {
+        int descriptor = -1;
+        if ( unixSocket )
+        {
+            struct sockaddr_un socketAddress;
+            toUnixSocketAddress( address, socketAddress );
+            descriptor = socket( AF_UNIX, SOCK_STREAM, 0 );
+            if ( descriptor >= 0 && ::connect( descriptor,
+                                               (struct sockaddr *)&socketAddress,
+                                               sizeof( socketAddress ) ) != 0 )
+            {
+                close( descriptor );
+                descriptor = -1;
+            }
+        }
+        else
+        {
+            struct addrinfo *candidates = resolveTcpAddress( address, false );
+            for ( struct addrinfo *candidate = candidates; candidate && descriptor < 0;
+                  candidate = candidate->ai_next )
+            {
+                descriptor =
+                    socket( candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol );
+                if ( descriptor >= 0 &&
+                     ::connect( descriptor, candidate->ai_addr, candidate->ai_addrlen ) != 0 )
+                {
+                    close( descriptor );
+                    descriptor = -1;
+                }
+            }
+            freeaddrinfo( candidates );
+        }
+
+        if ( descriptor >= 0 )
+        {
+            configureSocket( descriptor, !unixSocket );
+            return new DnCConnection( descriptor );
+        }
+
+        struct timespec now = TimeUtils::sampleMicro();
+        if ( TimeUtils::timePassed( start, now ) >= timeoutInMicroSeconds )
+            throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                                Stringf( "cannot connect to %s: %s",
+                                         address.ascii(),
+                                         strerror( errno ) )
+                                    .ascii() );
+
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds( CONNECT_RETRY_INTERVAL_IN_MILLISECONDS ) );
+    }
+}
+
+void DnCConnection::send( const String &message )
+{
+    uint32_t header = htonl( message.length() );
+    String data = String( (const char *)&header, sizeof( header ) ) + message;
+
+    int flags = 0;
+#ifdef MSG_NOSIGNAL
+    flags = MSG_NOSIGNAL;
+#endif
+
+    const char *buffer = data.ascii();
+    unsigned remaining = data.length();
+    while ( remaining > 0 )
+    {
+        ssize_t sent = ::send( _descriptor, buffer, remaining, flags );
+        if ( sent < 0 && errno == EINTR )
+            continue;
+        if ( sent <= 0 )
+            throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                                Stringf( "send failed: %s", strerror( errno ) ).ascii() );
+        buffer += sent;
+        remaining -= sent;
+    }
+}
+
+bool DnCConnection::receive( String &message )
+{
+    uint32_t header = 0;
+    if ( !readFully( (char *)&header, sizeof( header ) ) )
+        return false;
+
+    unsigned length = ntohl( header );
+    if ( length > MAX_MESSAGE_LENGTH )
+        throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                            Stringf( "message of %u bytes", length ).ascii() );
+
+    std::string buffer( length, '\0' );
+    if ( length > 0 && !readFully( &buffer[0], length ) )
+        throw MarabouError( MarabouError::DNC_CONNECTION_FAILED, "connection closed mid-message" );
+
+    message = String( buffer );
+    return true;
+}
+
+bool DnCConnection::readFully( char *buffer, unsigned length )
+{
+    unsigned received = 0;
+    while ( received < length )
+    {
+        ssize_t count = recv( _descriptor, buffer + received, length - received, 0 );
+        if ( count < 0 && errno == EINTR )
+            continue;
+        if ( count < 0 )
+            throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                                Stringf( "receive failed: %s", strerror( errno ) ).ascii() );
+        if ( count == 0 )
+        {
+            if ( received == 0 )
+                return false;
+            throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                                "connection closed mid-message" );
+        }
+        received += count;
+    }
+    return true;
+}
+
+bool DnCConnection::waitForMessage( int timeoutInMilliseconds ) const
+{
+    struct pollfd descriptor;
+    descriptor.fd = _descriptor;
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+
+    int result = poll( &descriptor, 1, timeoutInMilliseconds );
+    return result > 0 && ( descriptor.revents & ( POLLIN | POLLHUP | POLLERR ) );
+}
+
+int DnCConnection::getDescriptor() const
+{
+    return _descriptor;
+}
+
+DnCListener::DnCListener( const String &address )
+    : _address( address )
+    , _descriptor( -1 )
+{
+    if ( isUnixAddress( address ) )
+    {
+        struct sockaddr_un socketAddress;
+        toUnixSocketAddress( address, socketAddress );
+        _descriptor = socket( AF_UNIX, SOCK_STREAM, 0 );
+        if ( _descriptor >= 0 )
+        {
+            // A file left behind by an earlier run would make bind() fail
+            unlink( socketAddress.sun_path );
+            if ( bind( _descriptor, (struct sockaddr *)&socketAddress, sizeof( socketAddress ) ) ==
+                 0 )
+                _socketPath = socketAddress.sun_path;
+            else
+            {
+                close( _descriptor );
+                _descriptor = -1;
+            }
+        }
+    }
+    else
+    {
+        struct addrinfo *candidates = resolveTcpAddress( address, true );
+        for ( struct addrinfo *candidate = candidates; candidate && _descriptor < 0;
+              candidate = candidate->ai_next )
+        {
+            _descriptor =
+                socket( candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol );
+            if ( _descriptor < 0 )
+                continue;
+
+            int reuse = 1;
+            setsockopt( _descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+            if ( bind( _descriptor, candidate->ai_addr, candidate->ai_addrlen ) != 0 )
+            {
+                close( _descriptor );
+                _descriptor = -1;
+            }
+        }
+        freeaddrinfo( candidates );
+    }
+
+    if ( _descriptor < 0 || listen( _descriptor, SOMAXCONN ) != 0 )
+    {
+        int error = errno;
+        if ( _descriptor >= 0 )
+            close( _descriptor );
+        throw MarabouError(
+            MarabouError::DNC_CONNECTION_FAILED,
+            Stringf( "cannot listen on %s: %s", address.ascii(), strerror( error ) ).ascii() );
+    }
+}
+
+DnCListener::~DnCListener()
+{
+    if ( _descriptor >= 0 )
+    {
+        close( _descriptor );
+        _descriptor = -1;
+        if ( _socketPath.length() > 0 )
+            unlink( _socketPath.ascii() );
+    }
+}
+
+String DnCListener::localAddress()
+{
+    const char *directory = getenv( "TMPDIR" );
+    if ( !directory || strlen( directory ) == 0 )
+        directory = "/tmp";
+    return Stringf( "%s%s/marabou-dnc-%d.sock", UNIX_ADDRESS_PREFIX, directory, (int)getpid() );
+}
+
+DnCConnection *DnCListener::accept()
+{
+    int descriptor = ::accept( _descriptor, NULL, NULL );
+    while ( descriptor < 0 && errno == EINTR )
+        descriptor = ::accept( _descriptor, NULL, NULL );
+
+    if ( descriptor < 0 )
+        throw MarabouError( MarabouError::DNC_CONNECTION_FAILED,
+                            Stringf( "accept failed: %s", strerror( errno ) ).ascii() );
+
+    configureSocket( descriptor, !isUnixAddress( _address ) );
+    return new DnCConnection( descriptor );
+}
+
+void DnCListener::release()
+{
+    if ( _descriptor >= 0 )
+    {
+        close( _descriptor );
+        _descriptor = -1;
+    }
+}
+
+int DnCListener::getDescriptor() const
+{
+    return _descriptor;
+}
+
+const String &DnCListener::getAddress() const
+{
+    return _address;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,117 @@
+/*********************                                                        */
+/*! \file DnCConnection.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __DnCConnection_h__
+#define __DnCConnection_h__
+
+#include "MString.h"
+
+/*
+  A stream socket between the coordinator and a worker of a distributed DnC
+  solve, over which whole messages are exchanged. Each message is sent as
+  its length (4 bytes, network order) followed by its text.
+
+  Addresses are either "unix:<path>", for a Unix domain socket, or
+  "<host>:<port>", for TCP. An empty host stands for all the interfaces
+  when listening.
+*/
+class DnCConnection
+{
+public:
+    /*
+      Take ownership of a connected socket
+    */
+    explicit DnCConnection( int descriptor );
+    ~DnCConnection();
+
+    /*
+      Connect to the given address, retrying until the timeout (in seconds)
+      is reached, e.g. while the coordinator is still preprocessing
+    */
+    static DnCConnection *connect( const String &address, unsigned timeoutInSeconds );
+
+    void send( const String &message );
+
+    /*
+      Block until a whole message is received. Return false if the peer
+      closed the connection.
+    */
+    bool receive( String &message );
+
+    /*
+      Return true if a message (or the closing of the connection) can be
+      received without blocking, waiting up to the timeout for it
+    */
+    bool waitForMessage( int timeoutInMilliseconds ) const;
+
+    int getDescriptor() const;
+
+private:
+    int _descriptor;
+
+    /*
+      Read exactly the given number of bytes. Return false if the peer
+      closed the connection before any of them were read.
+    */
+    bool readFully( char *buffer, unsigned length );
+};
+
+/*
+  A socket accepting the connections of the workers
+*/
+class DnCListener
+{
+public:
+    explicit DnCListener( const String &address );
+
+    /*
+      Close the socket, and remove its file if it is a Unix socket
+    */
+    ~DnCListener();
+
+    /*
+      A Unix socket address private to this process
+    */
+    static String localAddress();
+
+    /*
+      Accept a pending connection. The caller owns the returned connection.
+    */
+    DnCConnection *accept();
+
+    /*
+      Close the socket without removing its file. Used by forked workers,
+      which share the socket of the coordinator.
+    */
+    void release();
+
+    int getDescriptor() const;
+    const String &getAddress() const;
+
+private:
+    String _address;
+    String _socketPath;
+    int _descriptor;
+};
+
+#endif // __DnCConnection_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
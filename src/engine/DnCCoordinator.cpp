@@ -0,0 +1,307 @@
+/*********************                                                        */
+/*! \file DnCCoordinator.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCCoordinator.h"
+
+#include "DnCWorker.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "TimeUtils.h"
+#include "Vector.h"
+
+#include <poll.h>
+
+DnCCoordinator::DnCCoordinator( DnCListener *listener,
+                                const String &hello,
+                                const DnCProtocol::DivideConfig &config,
+                                unsigned verbosity,
+                                DnCCheckpoint *checkpoint )
+    : _listener( listener )
+    , _hello( hello )
+    , _config( config )
+    , _verbosity( verbosity )
+    , _checkpoint( checkpoint )
+    , _numConnections( 0 )
+    , _numWorkersJoined( 0 )
+    , _numUnsolvedSubQueries( 0 )
+    , _exitCode( IEngine::NOT_DONE )
+{
+}
+
+DnCCoordinator::~DnCCoordinator()
+{
+    dismissWorkers();
+
+    for ( const auto &subQuery : _pending )
+        delete subQuery;
+    _pending.clear();
+}
+
+IEngine::ExitCode DnCCoordinator::solve( SubQueries &subQueries,
+                                         unsigned long long timeoutInMicroSeconds,
+                                         std::function<bool()> workersMayJoin )
+{
+    struct timespec startTime = TimeUtils::sampleMicro();
+
+    _pending.append( subQueries );
+    _numUnsolvedSubQueries += subQueries.size();
+    subQueries.clear();
+    _exitCode = IEngine::NOT_DONE;
+
+    while ( _exitCode == IEngine::NOT_DONE )
+    {
+        if ( _numUnsolvedSubQueries <= 0 )
+        {
+            _exitCode = IEngine::UNSAT;
+            break;
+        }
+
+        struct timespec now = TimeUtils::sampleMicro();
+        if ( timeoutInMicroSeconds > 0 &&
+             TimeUtils::timePassed( startTime, now ) >= timeoutInMicroSeconds )
+        {
+            _exitCode = IEngine::TIMEOUT;
+            break;
+        }
+
+        if ( _workers.empty() && workersMayJoin && !workersMayJoin() )
+        {
+            printf( "DnCCoordinator: no worker left to solve the remaining subqueries\n" );
+            _exitCode = IEngine::ERROR;
+            break;
+        }
+
+        assignSubQueries();
+
+        // Wait for a connection or a message, the listener coming first
+        Vector<struct pollfd> descriptors;
+        Vector<Worker *> polledWorkers;
+        struct pollfd descriptor;
+        descriptor.fd = _listener->getDescriptor();
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        descriptors.append( descriptor );
+        for ( const auto &worker : _workers )
+        {
+            descriptor.fd = worker->_connection->getDescriptor();
+            descriptors.append( descriptor );
+            polledWorkers.append( worker );
+        }
+
+        if ( poll( descriptors.data(), descriptors.size(), POLL_INTERVAL_IN_MILLISECONDS ) <= 0 )
+            continue;
+
+        if ( descriptors[0].revents & POLLIN )
+            acceptWorker();
+
+        for ( unsigned i = 0; i < polledWorkers.size() && _exitCode == IEngine::NOT_DONE; ++i )
+        {
+            if ( descriptors[i + 1].revents == 0 )
+                continue;
+
+            Worker *worker = polledWorkers[i];
+            if ( !handleMessage( worker ) )
+                dropWorker( worker );
+        }
+    }
+
+    dismissWorkers();
+    return _exitCode;
+}
+
+const Map<unsigned, double> &DnCCoordinator::getSolution() const
+{
+    return _solution;
+}
+
+unsigned DnCCoordinator::getNumWorkersJoined() const
+{
+    return _numWorkersJoined;
+}
+
+void DnCCoordinator::acceptWorker()
+{
+    try
+    {
+        DnCConnection *connection = _listener->accept();
+        Worker *worker = new Worker;
+        worker->_id = _numConnections++;
+        worker->_connection = connection;
+        worker->_ready = false;
+        worker->_subQuery = NULL;
+        _workers.append( worker );
+    }
+    catch ( const MarabouError &e )
+    {
+        printf( "DnCCoordinator: %s\n", e.getUserMessage() );
+    }
+}
+
+bool DnCCoordinator::handleMessage( Worker *worker )
+{
+    try
+    {
+        String message;
+        if ( !worker->_connection->receive( message ) )
+            return false;
+
+        DnCProtocol::MessageType type = DnCProtocol::getType( message );
+        if ( type == DnCProtocol::HELLO && !worker->_ready )
+        {
+            if ( message != _hello )
+            {
+                printf( "DnCCoordinator: dismissing worker %u, whose query (%s) differs from "
+                        "ours (%s)\n",
+                        worker->_id,
+                        message.ascii(),
+                        _hello.ascii() );
+                worker->_connection->send( DnCProtocol::encodeQuit() );
+                return false;
+            }
+
+            worker->_connection->send( DnCProtocol::encodeConfig( _config ) );
+            worker->_ready = true;
+            ++_numWorkersJoined;
+            if ( _verbosity > 0 )
+                printf( "DnCCoordinator: worker %u joined\n", worker->_id );
+        }
+        else if ( type == DnCProtocol::RESULT && worker->_subQuery )
+        {
+            IEngine::ExitCode result;
+            SubQueries subQueries;
+            Map<unsigned, double> solution;
+            DnCProtocol::decodeResult( message, result, subQueries, solution );
+            handleResult( worker, result, subQueries, solution );
+        }
+        else
+            throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                                "unexpected message from a worker" );
+    }
+    catch ( const MarabouError &e )
+    {
+        printf( "DnCCoordinator: lost worker %u: %s\n", worker->_id, e.getUserMessage() );
+        return false;
+    }
+
+    return true;
+}
+
+void DnCCoordinator::handleResult( Worker *worker,
+                                   IEngine::ExitCode result,
+                                   SubQueries &subQueries,
+                                   const Map<unsigned, double> &solution )
+{
+    SubQuery *subQuery = worker->_subQuery;
+    worker->_subQuery = NULL;
+
+    if ( result == IEngine::UNSAT )
+    {
+        if ( _checkpoint )
+            _checkpoint->remove( subQuery->_queryId );
+        --_numUnsolvedSubQueries;
+    }
+    else if ( result == IEngine::TIMEOUT )
+    {
+        // Replace the subquery with those its divider created
+        if ( _checkpoint )
+            _checkpoint->replace( subQuery->_queryId, subQueries );
+        _numUnsolvedSubQueries += subQueries.size();
+        --_numUnsolvedSubQueries;
+        _pending.append( subQueries );
+        subQueries.clear();
+    }
+    else if ( result == IEngine::SAT )
+    {
+        --_numUnsolvedSubQueries;
+        _solution = solution;
+        _exitCode = IEngine::SAT;
+    }
+    else
+        _exitCode = IEngine::ERROR;
+
+    if ( _verbosity > 0 )
+        printf( "Worker %u: Query %s %s, %d tasks remaining\n",
+                worker->_id,
+                subQuery->_queryId.ascii(),
+                DnCWorker::exitCodeToString( result ).ascii(),
+                _numUnsolvedSubQueries );
+
+    for ( const auto &unused : subQueries )
+        delete unused;
+    delete subQuery;
+}
+
+void DnCCoordinator::assignSubQueries()
+{
+    for ( const auto &worker : _workers )
+    {
+        if ( _pending.empty() )
+            return;
+
+        if ( !worker->_ready || worker->_subQuery )
+            continue;
+
+        SubQuery *subQuery = _pending.back();
+        _pending.popBack();
+        worker->_subQuery = subQuery;
+        try
+        {
+            worker->_connection->send( DnCProtocol::encodeSolve( *subQuery ) );
+        }
+        catch ( const MarabouError &e )
+        {
+            // Noticed, and the subquery requeued, when polling the worker
+            printf( "DnCCoordinator: lost worker %u: %s\n", worker->_id, e.getUserMessage() );
+        }
+    }
+}
+
+void DnCCoordinator::dropWorker( Worker *worker )
+{
+    if ( worker->_subQuery )
+        _pending.append( worker->_subQuery );
+
+    _workers.erase( worker );
+    delete worker->_connection;
+    delete worker;
+}
+
+void DnCCoordinator::dismissWorkers()
+{
+    for ( const auto &worker : _workers )
+    {
+        try
+        {
+            worker->_connection->send( DnCProtocol::encodeQuit() );
+        }
+        catch ( const MarabouError & )
+        {
+            // The worker is gone already
+        }
+
+        delete worker->_subQuery;
+        delete worker->_connection;
+        delete worker;
+    }
+    _workers.clear();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
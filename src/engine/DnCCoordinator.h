@@ -0,0 +1,153 @@
+/*********************                                                        */
+/*! \file DnCCoordinator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __DnCCoordinator_h__
+#define __DnCCoordinator_h__
+
+#include "DnCCheckpoint.h"
+#include "DnCConnection.h"
+#include "DnCProtocol.h"
+#include "IEngine.h"
+#include "List.h"
+#include "Map.h"
+#include "SubQuery.h"
+
+#include <functional>
+
+/*
+  The coordinator of a distributed DnC solve. It accepts the connections of
+  worker processes, hands the pending subqueries out one at a time, and
+  collects the results: a subquery that times out is replaced by the
+  subqueries the worker's divider created from it, exactly as a DnCWorker
+  does with its workload. The solve is over when every subquery is UNSAT,
+  when a worker finds a satisfying assignment or fails, or on timeout.
+
+  The subquery of a worker that disconnects is handed to another worker.
+*/
+class DnCCoordinator
+{
+public:
+    /*
+      Workers must introduce themselves with the given hello message, i.e.
+      have preprocessed the query like the coordinator. The subqueries that
+      are solved or divided are recorded in the checkpoint, if given.
+    */
+    DnCCoordinator( DnCListener *listener,
+                    const String &hello,
+                    const DnCProtocol::DivideConfig &config,
+                    unsigned verbosity,
+                    DnCCheckpoint *checkpoint = NULL );
+
+    /*
+      Disconnect the workers and delete the subqueries still pending
+    */
+    ~DnCCoordinator();
+
+    /*
+      Solve the given subqueries, which the coordinator takes ownership of.
+      A timeout of 0 means no timeout. While no worker is connected,
+      workersMayJoin (if given) is checked; if it returns false, the solve
+      fails with ERROR.
+    */
+    IEngine::ExitCode solve( SubQueries &subQueries,
+                             unsigned long long timeoutInMicroSeconds,
+                             std::function<bool()> workersMayJoin = nullptr );
+
+    /*
+      The satisfying assignment found by a worker, in terms of the
+      variables of the input query
+    */
+    const Map<unsigned, double> &getSolution() const;
+
+    /*
+      The number of workers that joined the solve
+    */
+    unsigned getNumWorkersJoined() const;
+
+private:
+    enum {
+        POLL_INTERVAL_IN_MILLISECONDS = 100,
+    };
+
+    struct Worker
+    {
+        unsigned _id;
+        DnCConnection *_connection;
+
+        // Whether the worker was accepted, i.e. sent a matching hello
+        bool _ready;
+
+        // The subquery being solved by the worker, if any
+        SubQuery *_subQuery;
+    };
+
+    void acceptWorker();
+
+    /*
+      Receive and handle a message of the worker. Return false if the
+      worker is gone, or must be dismissed.
+    */
+    bool handleMessage( Worker *worker );
+
+    void handleResult( Worker *worker,
+                       IEngine::ExitCode result,
+                       SubQueries &subQueries,
+                       const Map<unsigned, double> &solution );
+
+    /*
+      Hand the pending subqueries to the idle workers
+    */
+    void assignSubQueries();
+
+    /*
+      Close the connection to the worker, and requeue its subquery
+    */
+    void dropWorker( Worker *worker );
+
+    /*
+      Tell the remaining workers to quit, and disconnect them
+    */
+    void dismissWorkers();
+
+    DnCListener *_listener;
+    String _hello;
+    DnCProtocol::DivideConfig _config;
+    unsigned _verbosity;
+    DnCCheckpoint *_checkpoint;
+
+    List<Worker *> _workers;
+    unsigned _numConnections;
+    unsigned _numWorkersJoined;
+
+    /*
+      The subqueries not yet handed out. The most recent ones are handed
+      out first, as in a worker's own deque.
+    */
+    SubQueries _pending;
+    int _numUnsolvedSubQueries;
+
+    IEngine::ExitCode _exitCode;
+    Map<unsigned, double> _solution;
+};
+
+#endif // __DnCCoordinator_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
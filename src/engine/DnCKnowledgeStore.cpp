@@ -0,0 +1,153 @@
+/*********************                                                        */
+/*! \file DnCKnowledgeStore.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCKnowledgeStore.h"
+
+#include <cstdio>
+
+DnCKnowledgeStore::DnCKnowledgeStore()
+    : _head( NULL )
+    , _numPublished( 0 )
+    , _numImported( 0 )
+    , _numImportedTightenings( 0 )
+    , _numFixedConstraints( 0 )
+    , _numSubQueriesImproved( 0 )
+    , _numPivotsImproved( 0 )
+    , _numSubQueriesNotImproved( 0 )
+    , _numPivotsNotImproved( 0 )
+{
+}
+
+DnCKnowledgeStore::~DnCKnowledgeStore()
+{
+    Entry *entry = _head.load();
+    while ( entry )
+    {
+        Entry *next = entry->_next;
+        delete entry;
+        entry = next;
+    }
+    _head = NULL;
+}
+
+void DnCKnowledgeStore::publish( const String &queryId, const List<Tightening> &tightenings )
+{
+    if ( tightenings.empty() )
+        return;
+
+    Entry *entry = new Entry;
+    entry->_queryId = queryId;
+    entry->_tightenings = tightenings;
+    // On failure, the exchange reloads the current head into entry->_next
+    entry->_next = _head.load();
+    while ( !_head.compare_exchange_weak( entry->_next, entry ) )
+        continue;
+
+    _numPublished += tightenings.size();
+}
+
+void DnCKnowledgeStore::collect( const String &queryId, List<Tightening> &tightenings ) const
+{
+    tightenings.clear();
+    for ( const Entry *entry = _head.load(); entry; entry = entry->_next )
+    {
+        if ( isDescendant( queryId, entry->_queryId ) )
+            tightenings.append( entry->_tightenings );
+    }
+}
+
+bool DnCKnowledgeStore::isDescendant( const String &queryId, const String &ancestorId )
+{
+    unsigned length = ancestorId.length();
+    if ( length == 0 )
+        return true;
+
+    if ( queryId.length() < length || queryId.substring( 0, length ) != ancestorId )
+        return false;
+
+    // Ids are extended with "-<index>", so "1-2" is not an ancestor of "1-23"
+    return queryId.length() == length || queryId[length] == '-';
+}
+
+void DnCKnowledgeStore::recordImport( unsigned numCollected,
+                                      unsigned numTightenings,
+                                      unsigned numFixedConstraints )
+{
+    _numImported += numCollected;
+    _numImportedTightenings += numTightenings;
+    _numFixedConstraints += numFixedConstraints;
+}
+
+void DnCKnowledgeStore::recordSubQuery( bool improvedByImports, unsigned long long numPivots )
+{
+    if ( improvedByImports )
+    {
+        ++_numSubQueriesImproved;
+        _numPivotsImproved += numPivots;
+    }
+    else
+    {
+        ++_numSubQueriesNotImproved;
+        _numPivotsNotImproved += numPivots;
+    }
+}
+
+unsigned long long DnCKnowledgeStore::getNumPublished() const
+{
+    return _numPublished.load();
+}
+
+unsigned long long DnCKnowledgeStore::getNumImported() const
+{
+    return _numImported.load();
+}
+
+unsigned long long DnCKnowledgeStore::getNumImportedTightenings() const
+{
+    return _numImportedTightenings.load();
+}
+
+unsigned long long DnCKnowledgeStore::getNumFixedConstraints() const
+{
+    return _numFixedConstraints.load();
+}
+
+void DnCKnowledgeStore::print() const
+{
+    unsigned long long numImproved = _numSubQueriesImproved.load();
+    unsigned long long numNotImproved = _numSubQueriesNotImproved.load();
+
+    printf( "Shared tightenings:\n" );
+    printf( "\tPublished: %llu. Imported: %llu, of which improved bounds: %llu. "
+            "Constraint phases fixed by imports: %llu\n",
+            _numPublished.load(),
+            _numImported.load(),
+            _numImportedTightenings.load(),
+            _numFixedConstraints.load() );
+    printf( "\tSubqueries improved by imports: %llu (average pivots: %.2lf). "
+            "Other subqueries: %llu (average pivots: %.2lf)\n",
+            numImproved,
+            numImproved ? (double)_numPivotsImproved.load() / numImproved : 0,
+            numNotImproved,
+            numNotImproved ? (double)_numPivotsNotImproved.load() / numNotImproved : 0 );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,114 @@
+/*********************                                                        */
+/*! \file DnCKnowledgeStore.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __DnCKnowledgeStore_h__
+#define __DnCKnowledgeStore_h__
+
+#include "List.h"
+#include "MString.h"
+#include "Tightening.h"
+
+#include <atomic>
+
+/*
+  Bound tightenings learned by the DnC workers, shared across threads.
+
+  A tightening is published together with the id of the subquery in which
+  it holds, e.g. a ReLU phase that a worker fixed by refuting the other
+  phase at the root of its search. Every subquery that the divider creates
+  from that subquery (ids "1-2" -> "1-2-1", "1-2-1-3", ...) restricts it
+  further, so the tightening holds there as well, whichever worker ends up
+  solving it.
+
+  The store is an append-only linked list: publishing is a compare-and-swap
+  on the head, and readers traverse the immutable entries without locking.
+  Entries are only freed with the store.
+*/
+class DnCKnowledgeStore
+{
+public:
+    DnCKnowledgeStore();
+    ~DnCKnowledgeStore();
+
+    /*
+      Publish tightenings that hold in the subquery of the given id
+    */
+    void publish( const String &queryId, const List<Tightening> &tightenings );
+
+    /*
+      Store the tightenings published for the given subquery and its
+      ancestors
+    */
+    void collect( const String &queryId, List<Tightening> &tightenings ) const;
+
+    /*
+      Return true if queryId is ancestorId or one of its descendants
+    */
+    static bool isDescendant( const String &queryId, const String &ancestorId );
+
+    /*
+      Record the import of tightenings into a subquery: how many were
+      collected, how many improved the worker's bounds, and how many
+      constraint phases (i.e., case splits) they fixed
+    */
+    void recordImport( unsigned numCollected,
+                       unsigned numTightenings,
+                       unsigned numFixedConstraints );
+
+    /*
+      Record the number of pivots spent on a subquery, and whether imported
+      tightenings improved its bounds
+    */
+    void recordSubQuery( bool improvedByImports, unsigned long long numPivots );
+
+    unsigned long long getNumPublished() const;
+    unsigned long long getNumImported() const;
+    unsigned long long getNumImportedTightenings() const;
+    unsigned long long getNumFixedConstraints() const;
+
+    void print() const;
+
+private:
+    struct Entry
+    {
+        String _queryId;
+        List<Tightening> _tightenings;
+        Entry *_next;
+    };
+
+    std::atomic<Entry *> _head;
+
+    /*
+      Statistics
+    */
+    std::atomic_ullong _numPublished;
+    std::atomic_ullong _numImported;
+    std::atomic_ullong _numImportedTightenings;
+    std::atomic_ullong _numFixedConstraints;
+    std::atomic_ullong _numSubQueriesImproved;
+    std::atomic_ullong _numPivotsImproved;
+    std::atomic_ullong _numSubQueriesNotImproved;
+    std::atomic_ullong _numPivotsNotImproved;
+};
+
+#endif // __DnCKnowledgeStore_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
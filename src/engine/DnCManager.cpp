@@ -16,6 +16,9 @@
 #include "DnCManager.h"
 
 #include "Debug.h"
+#include "DnCCoordinator.h"
+#include "DnCProtocol.h"
+#include "DnCRemoteWorker.h"
 #include "DnCWorker.h"
 #include "GetCPUData.h"
 #include "GlobalConfiguration.h"
@@ -32,15 +35,21 @@
 #include "Vector.h"
 
 #include <atomic>
-#include <chrono>
+#include <cerrno>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <sys/wait.h>
 #include <thread>
+#include <unistd.h>
 
 #ifdef ENABLE_OPENBLAS
 #include "cblas.h"
 #endif
 
-void DnCManager::dncSolve( WorkerQueue *workload,
+void DnCManager::dncSolve( WorkStealingQueue *workload,
+                           DnCKnowledgeStore *knowledge,
+                           DnCCheckpoint *checkpoint,
                            std::shared_ptr<Engine> engine,
                            std::unique_ptr<Query> inputQuery,
                            std::atomic_int &numUnsolvedSubQueries,
@@ -66,6 +75,8 @@ void DnCManager::dncSolve( WorkerQueue *workload,
         engine->processInputQuery( *inputQuery, false );
 
     DnCWorker worker( workload,
+                      knowledge,
+                      checkpoint,
                       engine,
                       std::ref( numUnsolvedSubQueries ),
                       std::ref( shouldQuitSolving ),
@@ -102,13 +113,7 @@ void DnCManager::freeMemoryIfNeeded()
 {
     if ( _workload )
     {
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
-        {
-            _workload->pop( subQuery );
-            delete subQuery;
-        }
-
+        // Deletes the pending subQueries
         delete _workload;
         _workload = NULL;
     }
@@ -127,6 +132,21 @@ void DnCManager::solve()
 
     struct timespec startTime = TimeUtils::sampleMicro();
 
+    String coordinatorAddress = Options::get()->getString( Options::DNC_CONNECT_ADDRESS );
+    if ( coordinatorAddress.length() > 0 )
+    {
+        solveAsRemoteWorker( coordinatorAddress );
+        return;
+    }
+
+    String listenAddress = Options::get()->getString( Options::DNC_LISTEN_ADDRESS );
+    unsigned numLocalWorkers = Options::get()->getInt( Options::NUM_DNC_PROCESSES );
+    if ( listenAddress.length() > 0 || numLocalWorkers > 0 )
+    {
+        solveAsCoordinator( listenAddress, numLocalWorkers, startTime, timeoutInMicroSeconds );
+        return;
+    }
+
     unsigned numWorkers = Options::get()->getInt( Options::NUM_WORKERS );
 
 #ifdef ENABLE_OPENBLAS
@@ -154,13 +174,22 @@ void DnCManager::solve()
 
     // Partition the input query into initial subqueries, and place these
     // queries in the queue
-    _workload = new WorkerQueue( 0 );
+    _workload = new WorkStealingQueue( numWorkers );
     if ( !_workload )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
 
     SubQueries subQueries;
     if ( !_runParallelDeepSoI )
-        initialDivide( subQueries );
+    {
+        createInitialSubQueries( subQueries );
+        if ( subQueries.empty() )
+        {
+            // Resumed from the checkpoint of a solve that was over
+            _exitCode = DnCManager::UNSAT;
+            return;
+        }
+        startCheckpoint( subQueries );
+    }
     else
     {
         for ( unsigned i = 0; i < numWorkers; ++i )
@@ -179,14 +208,13 @@ void DnCManager::solve()
     // Create objects shared across workers
     _numUnsolvedSubQueries = _runParallelDeepSoI ? 1 : subQueries.size();
     std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
+    // Deal the initial subqueries round-robin, so that every worker
+    // starts on its own deque
+    unsigned worker = 0;
     for ( auto &subQuery : subQueries )
     {
-        if ( !workload->push( subQuery ) )
-        {
-            // This should never happen
-            ASSERT( false );
-        }
+        _workload->push( worker, subQuery );
+        worker = ( worker + 1 ) % numWorkers;
     }
 
     unsigned onlineDivides = Options::get()->getInt( Options::NUM_ONLINE_DIVIDES );
@@ -196,6 +224,9 @@ void DnCManager::solve()
 
     auto baseQuery = std::unique_ptr<Query>( new Query( *( _baseEngine->getQuery() ) ) );
 
+    // Tightenings learned by the workers, shared across subqueries
+    DnCKnowledgeStore knowledge;
+
     // Spawn threads and start solving
     std::list<std::thread> threads;
     for ( unsigned threadId = 0; threadId < numWorkers; ++threadId )
@@ -206,7 +237,9 @@ void DnCManager::solve()
             inputQuery = std::unique_ptr<Query>( new Query( *( baseQuery ) ) );
 
         threads.push_back( std::thread( dncSolve,
-                                        workload,
+                                        _workload,
+                                        &knowledge,
+                                        _checkpoint.get(),
                                         _engines[threadId],
                                         threadId != 0 ? std::move( inputQuery ) : nullptr,
                                         std::ref( _numUnsolvedSubQueries ),
@@ -222,17 +255,20 @@ void DnCManager::solve()
     }
 
     // Wait until either all subQueries are solved or a satisfying assignment is
-    // found by some worker
+    // found by some worker. The workers wake us up when they raise the flag.
     while ( !shouldQuitSolving.load() )
     {
         updateTimeoutReached( startTime, timeoutInMicroSeconds );
         if ( _timeoutReached )
+        {
             shouldQuitSolving = true;
+            _workload->wakeUpAll();
+        }
         else
-            std::this_thread::sleep_for( std::chrono::milliseconds( numWorkers ) );
+            _workload->waitForQuit( shouldQuitSolving,
+                                    remainingTime( startTime, timeoutInMicroSeconds ) );
     }
 
-
     // Now that we are done, tell all workers to quit
     for ( auto &quitThread : quitThreads )
         *quitThread = true;
@@ -240,10 +276,156 @@ void DnCManager::solve()
     for ( auto &thread : threads )
         thread.join();
 
+    stopCheckpoint();
+
+    if ( _verbosity > 0 && !_runParallelDeepSoI )
+        knowledge.print();
+
     updateDnCExitCode();
     return;
 }
 
+void DnCManager::solveAsCoordinator( const String &listenAddress,
+                                     unsigned numLocalWorkers,
+                                     timespec startTime,
+                                     unsigned long long timeoutInMicroSeconds )
+{
+    // Listen before forking, so that the local workers can connect as soon
+    // as they are done preprocessing
+    DnCListener listener( listenAddress.length() > 0 ? listenAddress
+                                                     : DnCListener::localAddress() );
+    List<pid_t> localWorkers;
+    forkLocalWorkers( listener, numLocalWorkers, localWorkers );
+
+    if ( !createEngines( 1 ) )
+        // Solved by preprocessing, and so are the workers
+        _exitCode = DnCManager::UNSAT;
+    else
+    {
+        SubQueries subQueries;
+        createInitialSubQueries( subQueries );
+        startCheckpoint( subQueries );
+
+        DnCProtocol::DivideConfig config;
+        config._divideStrategy = _sncSplittingStrategy;
+        config._onlineDivides = Options::get()->getInt( Options::NUM_ONLINE_DIVIDES );
+        config._timeoutFactor = Options::get()->getFloat( Options::TIMEOUT_FACTOR );
+
+        DnCCoordinator coordinator( &listener,
+                                    DnCProtocol::encodeHello( *_baseEngine->getQuery() ),
+                                    config,
+                                    _verbosity,
+                                    _checkpoint.get() );
+
+        // Without a listen address, only the local workers can join
+        std::function<bool()> workersMayJoin = nullptr;
+        if ( listenAddress.length() == 0 )
+            workersMayJoin = [&localWorkers] { return localWorkersRunning( localWorkers ); };
+
+        IEngine::ExitCode result = coordinator.solve(
+            subQueries, remainingTime( startTime, timeoutInMicroSeconds ), workersMayJoin );
+        stopCheckpoint();
+
+        if ( _verbosity > 0 )
+            printf( "DnCCoordinator: %u workers joined\n", coordinator.getNumWorkersJoined() );
+
+        if ( result == IEngine::SAT )
+        {
+            _remoteSolution = coordinator.getSolution();
+            _exitCode = DnCManager::SAT;
+        }
+        else if ( result == IEngine::UNSAT )
+            _exitCode = DnCManager::UNSAT;
+        else if ( result == IEngine::TIMEOUT )
+        {
+            _timeoutReached = true;
+            _exitCode = DnCManager::TIMEOUT;
+        }
+        else
+            _exitCode = DnCManager::ERROR;
+    }
+
+    // The coordinator has told the local workers to quit
+    for ( const auto &pid : localWorkers )
+        waitpid( pid, NULL, 0 );
+}
+
+void DnCManager::solveAsRemoteWorker( const String &coordinatorAddress )
+{
+    if ( !createEngines( 1 ) )
+    {
+        // Solved by preprocessing, and so is the query of the coordinator
+        _exitCode = DnCManager::UNSAT;
+        return;
+    }
+    _baseEngine->setRandomSeed( Options::get()->getInt( Options::SEED ) );
+
+    std::unique_ptr<DnCConnection> connection( DnCConnection::connect(
+        coordinatorAddress, GlobalConfiguration::DNC_CONNECT_TIMEOUT_IN_SECONDS ) );
+    DnCRemoteWorker worker( connection.get(), _baseEngine, _baseQuery, _verbosity );
+    worker.run();
+
+    // The result of the solve is reported by the coordinator
+    _exitCode = DnCManager::QUIT_REQUESTED;
+}
+
+void DnCManager::forkLocalWorkers( DnCListener &listener,
+                                   unsigned numLocalWorkers,
+                                   List<pid_t> &pids )
+{
+    // Buffered output would otherwise be printed by every process
+    fflush( stdout );
+    fflush( stderr );
+
+    for ( unsigned i = 0; i < numLocalWorkers; ++i )
+    {
+        pid_t pid = fork();
+        if ( pid < 0 )
+            throw MarabouError( MarabouError::DNC_WORKER_PROCESS_FAILED, strerror( errno ) );
+
+        if ( pid == 0 )
+        {
+            // The socket file belongs to the coordinator
+            listener.release();
+            _verbosity = 0;
+
+            int status = 0;
+            try
+            {
+                solveAsRemoteWorker( listener.getAddress() );
+            }
+            catch ( const Error &e )
+            {
+                fprintf( stderr,
+                         "DnC worker process %u: caught a %s error. Code: %u, Message: %s.\n",
+                         i,
+                         e.getErrorClass(),
+                         e.getCode(),
+                         e.getUserMessage() );
+                status = 1;
+            }
+
+            // Leave without running the destructors of the coordinator's state
+            fflush( stdout );
+            _exit( status );
+        }
+
+        pids.append( pid );
+    }
+}
+
+bool DnCManager::localWorkersRunning( List<pid_t> &pids )
+{
+    List<pid_t> running;
+    for ( const auto &pid : pids )
+    {
+        if ( waitpid( pid, NULL, WNOHANG ) == 0 )
+            running.append( pid );
+    }
+    pids = running;
+    return !pids.empty();
+}
+
 DnCManager::DnCExitCode DnCManager::getExitCode() const
 {
     return _exitCode;
@@ -309,6 +491,14 @@ String DnCManager::getResultString()
 
 void DnCManager::extractSolution( IQuery &inputQuery )
 {
+    if ( _engineWithSATAssignment == nullptr && !_remoteSolution.empty() )
+    {
+        // The assignment was found by a worker process
+        for ( const auto &value : _remoteSolution )
+            inputQuery.setSolutionValue( value.first, value.second );
+        return;
+    }
+
     ASSERT( _engineWithSATAssignment != nullptr );
     _engineWithSATAssignment->extractSolution( inputQuery, _baseEngine->getPreprocessor() );
 }
@@ -376,6 +566,7 @@ bool DnCManager::createEngines( unsigned numberOfEngines )
 {
     // Create the base engine
     _baseEngine = std::make_shared<Engine>();
+    _baseEngine->setVerbosity( _verbosity );
     _engines.append( _baseEngine );
     if ( !_baseEngine->processInputQuery( *_baseQuery ) )
         // Solved by preprocessing, we are done!
@@ -394,7 +585,29 @@ bool DnCManager::createEngines( unsigned numberOfEngines )
     return true;
 }
 
-void DnCManager::initialDivide( SubQueries &subQueries )
+void DnCManager::createInitialSubQueries( SubQueries &subQueries )
+{
+    chooseDivideStrategy();
+
+    if ( !Options::get()->getBool( Options::DNC_RESUME ) )
+    {
+        initialDivide( subQueries );
+        return;
+    }
+
+    String path = Options::get()->getString( Options::DNC_CHECKPOINT_FILE );
+    if ( path.length() == 0 )
+        throw MarabouError( MarabouError::DNC_CHECKPOINT_FAILED,
+                            "no checkpoint file to resume from" );
+
+    DnCCheckpoint::read( path, DnCProtocol::encodeHello( *_baseEngine->getQuery() ), subQueries );
+    if ( _verbosity > 0 )
+        printf( "DnCManager: resuming with the %u subqueries left in %s\n",
+                subQueries.size(),
+                path.ascii() );
+}
+
+void DnCManager::chooseDivideStrategy()
 {
     if ( _sncSplittingStrategy == SnCDivideStrategy::Auto )
     {
@@ -413,7 +626,10 @@ void DnCManager::initialDivide( SubQueries &subQueries )
             _sncSplittingStrategy = SnCDivideStrategy::Polarity;
         }
     }
+}
 
+void DnCManager::initialDivide( SubQueries &subQueries )
+{
     auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit() );
     std::unique_ptr<QueryDivider> queryDivider = nullptr;
     if ( _sncSplittingStrategy == SnCDivideStrategy::Polarity )
@@ -446,6 +662,36 @@ void DnCManager::initialDivide( SubQueries &subQueries )
         pow( 2, initialDivides ), queryId, 0, *split, initialTimeout, subQueries );
 }
 
+void DnCManager::startCheckpoint( const SubQueries &subQueries )
+{
+    String path = Options::get()->getString( Options::DNC_CHECKPOINT_FILE );
+    if ( path.length() == 0 )
+        return;
+
+    _checkpoint = std::unique_ptr<DnCCheckpoint>(
+        new DnCCheckpoint( path, DnCProtocol::encodeHello( *_baseEngine->getQuery() ) ) );
+    _checkpoint->add( subQueries );
+    _checkpoint->startWriting( Options::get()->getInt( Options::DNC_CHECKPOINT_INTERVAL ) );
+}
+
+void DnCManager::stopCheckpoint()
+{
+    if ( !_checkpoint )
+        return;
+
+    try
+    {
+        _checkpoint->stopWriting();
+        if ( _verbosity > 0 )
+            printf( "DnCManager: %u subqueries left in the checkpoint\n", _checkpoint->size() );
+    }
+    catch ( const MarabouError &e )
+    {
+        // The result of the solve still stands
+        printf( "DnCManager: %s\n", e.getUserMessage() );
+    }
+}
+
 void DnCManager::updateTimeoutReached( timespec startTime,
                                        unsigned long long timeoutInMicroSeconds )
 {
@@ -454,3 +700,13 @@ void DnCManager::updateTimeoutReached( timespec startTime,
     struct timespec now = TimeUtils::sampleMicro();
     _timeoutReached = TimeUtils::timePassed( startTime, now ) >= timeoutInMicroSeconds;
 }
+
+unsigned long long DnCManager::remainingTime( timespec startTime,
+                                              unsigned long long timeoutInMicroSeconds )
+{
+    if ( timeoutInMicroSeconds == 0 )
+        return 0;
+    struct timespec now = TimeUtils::sampleMicro();
+    unsigned long long passed = TimeUtils::timePassed( startTime, now );
+    return passed < timeoutInMicroSeconds ? timeoutInMicroSeconds - passed : 1;
+}
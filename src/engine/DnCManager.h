@@ -16,13 +16,19 @@
 #ifndef __DnCManager_h__
 #define __DnCManager_h__
 
+#include "DnCCheckpoint.h"
+#include "DnCConnection.h"
+#include "DnCKnowledgeStore.h"
 #include "Engine.h"
 #include "IQuery.h"
+#include "Map.h"
 #include "SnCDivideStrategy.h"
 #include "SubQuery.h"
 #include "Vector.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
+#include <sys/types.h>
 
 #define DNC_MANAGER_LOG( x, ... )                                                                  \
     LOG( GlobalConfiguration::DNC_MANAGER_LOGGING, "DnCManager: %s\n", x )
@@ -49,7 +55,9 @@ public:
     void freeMemoryIfNeeded();
 
     /*
-      Perform the Divide-and-conquer solving
+      Perform the Divide-and-conquer solving. With a coordinator address,
+      serve the subqueries of that coordinator instead; with a listen
+      address or local worker processes, coordinate a distributed solve.
     */
     void solve();
 
@@ -84,7 +92,9 @@ private:
     /*
       Create and run a DnCWorker
     */
-    static void dncSolve( WorkerQueue *workload,
+    static void dncSolve( WorkStealingQueue *workload,
+                          DnCKnowledgeStore *knowledge,
+                          DnCCheckpoint *checkpoint,
                           std::shared_ptr<Engine> engine,
                           std::unique_ptr<Query> inputQuery,
                           std::atomic_int &numUnsolvedSubQueries,
@@ -98,18 +108,68 @@ private:
                           unsigned seed,
                           bool parallelDeepSoI );
 
+    /*
+      Coordinate a distributed solve: divide the query, and solve the
+      subqueries with the worker processes that connect to the listen
+      address (a local one if empty), including the given number of local
+      worker processes forked here
+    */
+    void solveAsCoordinator( const String &listenAddress,
+                             unsigned numLocalWorkers,
+                             timespec startTime,
+                             unsigned long long timeoutInMicroSeconds );
+
+    /*
+      Serve as a worker of the distributed solve coordinated at the address
+    */
+    void solveAsRemoteWorker( const String &coordinatorAddress );
+
+    /*
+      Fork the local worker processes, which connect to the listener
+    */
+    void forkLocalWorkers( DnCListener &listener, unsigned numLocalWorkers, List<pid_t> &pids );
+
+    /*
+      Reap the local worker processes that have exited. Return true if any
+      is still running.
+    */
+    static bool localWorkersRunning( List<pid_t> &pids );
+
     /*
       Create the base engine from the network and property files,
       and if necessary, create engines for workers
     */
     bool createEngines( unsigned numberOfEngines );
 
+    /*
+      Invoked in SnC mode.
+      Create the subqueries to start with: divide up the input region, or
+      when resuming, read the subqueries left in the checkpoint
+    */
+    void createInitialSubQueries( SubQueries &subQueries );
+
+    /*
+      Resolve the Auto divide strategy for the preprocessed query
+    */
+    void chooseDivideStrategy();
+
     /*
       Invoked in SnC mode.
       Divide up the input region and store them in subqueries
     */
     void initialDivide( SubQueries &subQueries );
 
+    /*
+      If a checkpoint file is given, record the initial subqueries in the
+      checkpoint of the solve and start writing it periodically
+    */
+    void startCheckpoint( const SubQueries &subQueries );
+
+    /*
+      Write the final checkpoint of the solve, once the workers are done
+    */
+    void stopCheckpoint();
+
     /*
       Read the exitCode of the engine of each thread, and update the manager's
       exitCode.
@@ -121,6 +181,13 @@ private:
     */
     void updateTimeoutReached( timespec startTime, unsigned long long timeoutInMicroSeconds );
 
+    /*
+      The number of microseconds left before the timeout (at least 1), or
+      0 if there is no timeout
+    */
+    static unsigned long long remainingTime( timespec startTime,
+                                             unsigned long long timeoutInMicroSeconds );
+
     /*
       The base engine that is used to perform the initial divides
     */
@@ -136,6 +203,12 @@ private:
     */
     std::shared_ptr<Engine> _engineWithSATAssignment;
 
+    /*
+      The satisfying assignment found by a worker process, in a
+      distributed solve
+    */
+    Map<unsigned, double> _remoteSolution;
+
     /*
       Alternatively, we could construct the DnCManager by directly providing the
       inputQuery instead of the network and property filepaths.
@@ -148,9 +221,14 @@ private:
     DnCExitCode _exitCode;
 
     /*
-      Set of subQueries to be solved by workers
+      The subQueries to be solved by workers, in one deque per worker
+    */
+    WorkStealingQueue *_workload;
+
+    /*
+      The frontier of the solve, saved to the checkpoint file (if any)
     */
-    WorkerQueue *_workload;
+    std::unique_ptr<DnCCheckpoint> _checkpoint;
 
     /*
       Whether the timeout has been reached
@@ -117,6 +117,10 @@ void DnCMarabou::run()
 
     struct timespec end = TimeUtils::sampleMicro();
 
+    // A worker of a distributed solve leaves the results to its coordinator
+    if ( Options::get()->getString( Options::DNC_CONNECT_ADDRESS ).length() > 0 )
+        return;
+
     unsigned long long totalElapsed = TimeUtils::timePassed( start, end );
     displayResults( totalElapsed );
 }
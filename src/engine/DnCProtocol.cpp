@@ -0,0 +1,382 @@
+/*********************                                                        */
+/*! \file DnCProtocol.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCProtocol.h"
+
+#include "Equation.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "NonlinearConstraint.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "PiecewiseLinearConstraint.h"
+#include "Query.h"
+#include "Tightening.h"
+
+#include <cstdlib>
+#include <cstring>
+
+DnCProtocol::MessageType DnCProtocol::getType( const String &message )
+{
+    List<String> lines = message.tokenize( "\n" );
+    if ( lines.empty() )
+        throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE, "empty message" );
+
+    List<String> tokens = lines.front().tokenize( " " );
+    String type = tokens.empty() ? "" : tokens.front();
+    if ( type == "hello" )
+        return HELLO;
+    if ( type == "config" )
+        return CONFIG;
+    if ( type == "solve" )
+        return SOLVE;
+    if ( type == "result" )
+        return RESULT;
+    if ( type == "quit" )
+        return QUIT;
+
+    throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                        Stringf( "unknown message type: %s", type.ascii() ).ascii() );
+}
+
+String DnCProtocol::encodeHello( const Query &query )
+{
+    return Stringf( "hello %u %u %u %016llx",
+                    query.getNumberOfVariables(),
+                    query.getNumberOfEquations(),
+                    query.getPiecewiseLinearConstraints().size(),
+                    fingerprint( query ) );
+}
+
+unsigned long long DnCProtocol::fingerprint( const Query &query )
+{
+    unsigned long long hash = FNV_OFFSET_BASIS;
+
+    hashValue( hash, query.getLowerBounds().size() );
+    for ( const auto &bound : query.getLowerBounds() )
+    {
+        hashValue( hash, bound.first );
+        hashValue( hash, bound.second );
+    }
+    hashValue( hash, query.getUpperBounds().size() );
+    for ( const auto &bound : query.getUpperBounds() )
+    {
+        hashValue( hash, bound.first );
+        hashValue( hash, bound.second );
+    }
+
+    for ( const auto &equation : query.getEquations() )
+    {
+        hashValue( hash, (unsigned)equation._type );
+        hashValue( hash, equation._scalar );
+        hashValue( hash, equation._addends.size() );
+        for ( const auto &addend : equation._addends )
+        {
+            hashValue( hash, addend._coefficient );
+            hashValue( hash, addend._variable );
+        }
+    }
+
+    for ( const auto &constraint : query.getPiecewiseLinearConstraints() )
+    {
+        List<unsigned> participants = constraint->getParticipatingVariables();
+        hashValue( hash, (unsigned)constraint->getType() );
+        hashValue( hash, participants.size() );
+        for ( unsigned variable : participants )
+            hashValue( hash, variable );
+    }
+
+    for ( const auto &constraint : query.getNonlinearConstraints() )
+    {
+        List<unsigned> participants = constraint->getParticipatingVariables();
+        hashValue( hash, (unsigned)constraint->getType() );
+        hashValue( hash, participants.size() );
+        for ( unsigned variable : participants )
+            hashValue( hash, variable );
+    }
+
+    return hash;
+}
+
+void DnCProtocol::hashValue( unsigned long long &hash, unsigned value )
+{
+    unsigned char bytes[sizeof( value )];
+    memcpy( bytes, &value, sizeof( value ) );
+    for ( unsigned char byte : bytes )
+    {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    }
+}
+
+void DnCProtocol::hashValue( unsigned long long &hash, double value )
+{
+    // Adding zero turns -0 into 0, which compare equal
+    value += 0.0;
+    unsigned char bytes[sizeof( value )];
+    memcpy( bytes, &value, sizeof( value ) );
+    for ( unsigned char byte : bytes )
+    {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    }
+}
+
+String DnCProtocol::encodeConfig( const DivideConfig &config )
+{
+    return Stringf( "config %u %u %s",
+                    (unsigned)config._divideStrategy,
+                    config._onlineDivides,
+                    encodeDouble( config._timeoutFactor ).ascii() );
+}
+
+String DnCProtocol::encodeSolve( const SubQuery &subQuery )
+{
+    String message = "solve\n";
+    encodeSubQuery( subQuery, message );
+    return message;
+}
+
+String DnCProtocol::encodeResult( IEngine::ExitCode exitCode,
+                                  const SubQueries &subQueries,
+                                  const Map<unsigned, double> &solution )
+{
+    String message =
+        Stringf( "result %u %u %u\n", (unsigned)exitCode, subQueries.size(), solution.size() );
+    for ( const auto &subQuery : subQueries )
+        encodeSubQuery( *subQuery, message );
+    for ( const auto &value : solution )
+        message += Stringf( "%u %s\n", value.first, encodeDouble( value.second ).ascii() );
+    return message;
+}
+
+String DnCProtocol::encodeQuit()
+{
+    return "quit";
+}
+
+DnCProtocol::DivideConfig DnCProtocol::decodeConfig( const String &message )
+{
+    List<String> lines = message.tokenize( "\n" );
+    LineIterator line = lines.begin();
+    Vector<String> tokens = readLine( line, lines.end(), "config", 4 );
+
+    unsigned divideStrategy = atoi( tokens[1].ascii() );
+    if ( divideStrategy > (unsigned)SnCDivideStrategy::Auto )
+        throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                            Stringf( "unknown divide strategy: %u", divideStrategy ).ascii() );
+
+    DivideConfig config;
+    config._divideStrategy = (SnCDivideStrategy)divideStrategy;
+    config._onlineDivides = atoi( tokens[2].ascii() );
+    config._timeoutFactor = atof( tokens[3].ascii() );
+    return config;
+}
+
+SubQuery *DnCProtocol::decodeSolve( const String &message )
+{
+    List<String> lines = message.tokenize( "\n" );
+    LineIterator line = lines.begin();
+    readLine( line, lines.end(), "solve", 1 );
+    return decodeSubQuery( line, lines.end() );
+}
+
+void DnCProtocol::decodeResult( const String &message,
+                                IEngine::ExitCode &exitCode,
+                                SubQueries &subQueries,
+                                Map<unsigned, double> &solution )
+{
+    List<String> lines = message.tokenize( "\n" );
+    LineIterator line = lines.begin();
+    Vector<String> tokens = readLine( line, lines.end(), "result", 4 );
+
+    exitCode = (IEngine::ExitCode)atoi( tokens[1].ascii() );
+    unsigned numSubQueries = atoi( tokens[2].ascii() );
+    unsigned numValues = atoi( tokens[3].ascii() );
+
+    SubQueries decoded;
+    try
+    {
+        for ( unsigned i = 0; i < numSubQueries; ++i )
+            decoded.append( decodeSubQuery( line, lines.end() ) );
+
+        solution.clear();
+        for ( unsigned i = 0; i < numValues; ++i )
+        {
+            tokens = readLine( line, lines.end(), NULL, 2 );
+            solution[atoi( tokens[0].ascii() )] = atof( tokens[1].ascii() );
+        }
+    }
+    catch ( const MarabouError & )
+    {
+        for ( const auto &subQuery : decoded )
+            delete subQuery;
+        throw;
+    }
+
+    subQueries.append( decoded );
+}
+
+String DnCProtocol::encodeCheckpointHeader( const String &hello, unsigned numSubQueries )
+{
+    return Stringf( "checkpoint %u\n%s\n", numSubQueries, hello.ascii() );
+}
+
+void DnCProtocol::decodeCheckpoint( const List<String> &lines,
+                                    String &hello,
+                                    SubQueries &subQueries )
+{
+    LineIterator line = lines.begin();
+    Vector<String> tokens = readLine( line, lines.end(), "checkpoint", 2 );
+    unsigned numSubQueries = atoi( tokens[1].ascii() );
+
+    if ( line != lines.end() )
+        hello = *line;
+    readLine( line, lines.end(), "hello", 5 );
+
+    SubQueries decoded;
+    try
+    {
+        for ( unsigned i = 0; i < numSubQueries; ++i )
+            decoded.append( decodeSubQuery( line, lines.end() ) );
+    }
+    catch ( const MarabouError & )
+    {
+        for ( const auto &subQuery : decoded )
+            delete subQuery;
+        throw;
+    }
+
+    subQueries.append( decoded );
+}
+
+void DnCProtocol::encodeSubQuery( const SubQuery &subQuery, String &message )
+{
+    message += Stringf( "query %s\n", subQuery._queryId.ascii() );
+    message +=
+        Stringf( "depth %u timeout %u\n", subQuery._depth, subQuery._timeoutInSeconds );
+
+    const List<Tightening> &bounds = subQuery._split->getBoundTightenings();
+    message += Stringf( "bounds %u\n", bounds.size() );
+    for ( const auto &bound : bounds )
+        message += Stringf( "%s %u %s\n",
+                            bound._type == Tightening::LB ? "l" : "u",
+                            bound._variable,
+                            encodeDouble( bound._value ).ascii() );
+
+    const List<Equation> &equations = subQuery._split->getEquations();
+    message += Stringf( "equations %u\n", equations.size() );
+    for ( const auto &equation : equations )
+    {
+        message += Stringf( "%u %s %u",
+                            (unsigned)equation._type,
+                            encodeDouble( equation._scalar ).ascii(),
+                            equation._addends.size() );
+        for ( const auto &addend : equation._addends )
+            message +=
+                Stringf( " %s %u", encodeDouble( addend._coefficient ).ascii(), addend._variable );
+        message += "\n";
+    }
+}
+
+SubQuery *DnCProtocol::decodeSubQuery( LineIterator &line, const LineIterator &end )
+{
+    // The id of the root query is empty, and so is its token
+    Vector<String> tokens = readLine( line, end, "query", 1 );
+    String queryId = tokens.size() > 1 ? tokens[1] : "";
+
+    tokens = readLine( line, end, "depth", 4 );
+    unsigned depth = atoi( tokens[1].ascii() );
+    unsigned timeoutInSeconds = atoi( tokens[3].ascii() );
+
+    auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+
+    tokens = readLine( line, end, "bounds", 2 );
+    unsigned numBounds = atoi( tokens[1].ascii() );
+    for ( unsigned i = 0; i < numBounds; ++i )
+    {
+        tokens = readLine( line, end, NULL, 3 );
+        if ( tokens[0] != "l" && tokens[0] != "u" )
+            throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                                Stringf( "unknown bound type: %s", tokens[0].ascii() ).ascii() );
+        split->storeBoundTightening( Tightening( atoi( tokens[1].ascii() ),
+                                                 atof( tokens[2].ascii() ),
+                                                 tokens[0] == "l" ? Tightening::LB
+                                                                  : Tightening::UB ) );
+    }
+
+    tokens = readLine( line, end, "equations", 2 );
+    unsigned numEquations = atoi( tokens[1].ascii() );
+    for ( unsigned i = 0; i < numEquations; ++i )
+    {
+        tokens = readLine( line, end, NULL, 3 );
+        unsigned type = atoi( tokens[0].ascii() );
+        unsigned numAddends = atoi( tokens[2].ascii() );
+        if ( type > Equation::LE || tokens.size() != 3 + 2 * numAddends )
+            throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE, "invalid equation" );
+
+        Equation equation( (Equation::EquationType)type );
+        equation.setScalar( atof( tokens[1].ascii() ) );
+        for ( unsigned j = 0; j < numAddends; ++j )
+            equation.addAddend( atof( tokens[3 + 2 * j].ascii() ),
+                                atoi( tokens[4 + 2 * j].ascii() ) );
+        split->addEquation( equation );
+    }
+
+    SubQuery *subQuery = new SubQuery;
+    subQuery->_queryId = queryId;
+    subQuery->_split = std::move( split );
+    subQuery->_timeoutInSeconds = timeoutInSeconds;
+    subQuery->_depth = depth;
+    return subQuery;
+}
+
+Vector<String> DnCProtocol::readLine( LineIterator &line,
+                                      const LineIterator &end,
+                                      const char *keyword,
+                                      unsigned numTokens )
+{
+    if ( line == end )
+        throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE, "truncated message" );
+
+    String text = *line;
+    ++line;
+
+    Vector<String> tokens;
+    for ( const auto &token : text.tokenize( " " ) )
+        tokens.append( token );
+
+    if ( tokens.size() < numTokens || ( keyword && tokens[0] != keyword ) )
+        throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                            Stringf( "expected %s, got: %s",
+                                     keyword ? keyword : "values",
+                                     text.substring( 0, 100 ).ascii() )
+                                .ascii() );
+
+    return tokens;
+}
+
+String DnCProtocol::encodeDouble( double value )
+{
+    // Enough digits for the value to be decoded exactly
+    return Stringf( "%.17g", value );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,180 @@
+/*********************                                                        */
+/*! \file DnCProtocol.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __DnCProtocol_h__
+#define __DnCProtocol_h__
+
+#include "IEngine.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "SnCDivideStrategy.h"
+#include "SubQuery.h"
+#include "Vector.h"
+
+class Query;
+
+/*
+  The messages exchanged between the coordinator and the workers of a
+  distributed DnC solve.
+
+  A worker loads the network once, preprocesses it like the coordinator
+  does, and introduces itself with a hello message describing the
+  preprocessed query: its dimensions, and a fingerprint of its bounds,
+  equations and constraints, so that a worker given another property of the
+  same network is dismissed. The coordinator answers with the configuration of the
+  divide, and then sends one subquery at a time. The worker answers each
+  one with a result message, carrying the subqueries its divider created if
+  the subquery timed out, or the satisfying assignment of the input query if
+  it was found. When the solve is over, the coordinator sends a quit message.
+
+  Messages are plain text, one field per line:
+
+    hello <#variables> <#equations> <#constraints> <fingerprint>
+    config <divide strategy> <online divides> <timeout factor>
+    solve
+      <subquery>
+    result <exit code> <#subqueries> <#solution values>
+      <subquery>...
+      <variable> <value>...
+    quit
+
+  where a subquery is
+
+    query <id>
+    depth <depth> timeout <timeout>
+    bounds <#bounds>
+      <l|u> <variable> <value>...
+    equations <#equations>
+      <type> <scalar> <#addends> <coefficient> <variable>...
+
+  The splits are exchanged in terms of the variables of the preprocessed
+  query, and the solution in terms of those of the input query. The
+  SmtState of a subquery is not exchanged, as it refers to the constraints
+  of the engine that stored it.
+
+  A DnC checkpoint (see DnCCheckpoint) is saved in the same format:
+
+    checkpoint <#subqueries>
+    hello <#variables> <#equations> <#constraints> <fingerprint>
+      <subquery>...
+*/
+class DnCProtocol
+{
+public:
+    enum MessageType {
+        HELLO = 0,
+        CONFIG = 1,
+        SOLVE = 2,
+        RESULT = 3,
+        QUIT = 4,
+    };
+
+    /*
+      How the workers divide the subqueries that time out
+    */
+    struct DivideConfig
+    {
+        SnCDivideStrategy _divideStrategy;
+        unsigned _onlineDivides;
+        float _timeoutFactor;
+    };
+
+    /*
+      Return the type of a message, or throw if it is unknown
+    */
+    static MessageType getType( const String &message );
+
+    static String encodeHello( const Query &query );
+    static String encodeConfig( const DivideConfig &config );
+    static String encodeSolve( const SubQuery &subQuery );
+    static String encodeResult( IEngine::ExitCode exitCode,
+                                const SubQueries &subQueries,
+                                const Map<unsigned, double> &solution );
+    static String encodeQuit();
+
+    static DivideConfig decodeConfig( const String &message );
+
+    /*
+      The caller owns the returned subquery
+    */
+    static SubQuery *decodeSolve( const String &message );
+
+    /*
+      The caller owns the subqueries appended to subQueries
+    */
+    static void decodeResult( const String &message,
+                              IEngine::ExitCode &exitCode,
+                              SubQueries &subQueries,
+                              Map<unsigned, double> &solution );
+
+    /*
+      Append the encoding of a subquery to the message
+    */
+    static void encodeSubQuery( const SubQuery &subQuery, String &message );
+
+    /*
+      The first lines of a checkpoint of the query introduced by the hello
+      message, which the given number of encoded subqueries follow. They are
+      written one at a time, not to copy a large checkpoint in memory.
+    */
+    static String encodeCheckpointHeader( const String &hello, unsigned numSubQueries );
+
+    /*
+      Decode the lines of a checkpoint. The caller owns the subqueries
+      appended to subQueries.
+    */
+    static void
+    decodeCheckpoint( const List<String> &lines, String &hello, SubQueries &subQueries );
+
+private:
+    typedef List<String>::const_iterator LineIterator;
+
+    /*
+      A 64-bit FNV-1a hash of the bounds, the equations and the constraint
+      participants of a preprocessed query, which is the same in every
+      process that preprocessed the same query
+    */
+    static unsigned long long fingerprint( const Query &query );
+    static void hashValue( unsigned long long &hash, unsigned value );
+    static void hashValue( unsigned long long &hash, double value );
+
+    static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+    static SubQuery *decodeSubQuery( LineIterator &line, const LineIterator &end );
+
+    /*
+      Split the next line into tokens and advance, throwing if there are
+      fewer than numTokens tokens or if the first one is not the keyword
+      (when given)
+    */
+    static Vector<String> readLine( LineIterator &line,
+                                    const LineIterator &end,
+                                    const char *keyword,
+                                    unsigned numTokens );
+
+    static String encodeDouble( double value );
+};
+
+#endif // __DnCProtocol_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,148 @@
+/*********************                                                        */
+/*! \file DnCRemoteWorker.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "DnCRemoteWorker.h"
+
+#include "DnCProtocol.h"
+#include "MarabouError.h"
+
+#include <thread>
+
+DnCRemoteWorker::DnCRemoteWorker( DnCConnection *connection,
+                                  std::shared_ptr<Engine> engine,
+                                  IQuery *inputQuery,
+                                  unsigned verbosity )
+    : _connection( connection )
+    , _engine( engine )
+    , _inputQuery( inputQuery )
+    , _verbosity( verbosity )
+    , _workload( 1 )
+    , _numUnsolvedSubQueries( 0 )
+    , _shouldQuitSolving( false )
+{
+}
+
+unsigned DnCRemoteWorker::run()
+{
+    _connection->send( DnCProtocol::encodeHello( *_engine->getQuery() ) );
+
+    String message;
+    if ( !_connection->receive( message ) || DnCProtocol::getType( message ) == DnCProtocol::QUIT )
+    {
+        printf( "DnCRemoteWorker: dismissed by the coordinator\n" );
+        return 0;
+    }
+
+    // Divide the subqueries that time out like the coordinator would
+    DnCProtocol::DivideConfig config = DnCProtocol::decodeConfig( message );
+    DnCWorker worker( &_workload,
+                      &_knowledge,
+                      NULL,
+                      _engine,
+                      _numUnsolvedSubQueries,
+                      _shouldQuitSolving,
+                      0,
+                      config._onlineDivides,
+                      config._timeoutFactor,
+                      config._divideStrategy,
+                      0,
+                      false );
+
+    unsigned numSolved = 0;
+    while ( _connection->receive( message ) )
+    {
+        DnCProtocol::MessageType type = DnCProtocol::getType( message );
+        if ( type == DnCProtocol::QUIT )
+            break;
+        if ( type != DnCProtocol::SOLVE )
+            throw MarabouError( MarabouError::DNC_MALFORMED_MESSAGE,
+                                "unexpected message from the coordinator" );
+
+        ++numSolved;
+        if ( !solve( DnCProtocol::decodeSolve( message ), worker ) )
+            break;
+    }
+
+    if ( _verbosity > 0 )
+        printf( "DnCRemoteWorker: solved %u subqueries\n", numSolved );
+    return numSolved;
+}
+
+bool DnCRemoteWorker::solve( SubQuery *subQuery, DnCWorker &worker )
+{
+    _workload.push( 0, subQuery );
+    _numUnsolvedSubQueries = 1;
+    _shouldQuitSolving = false;
+
+    // The coordinator only sends a message during a solve when it quits,
+    // so anything to read (or a closed connection) stops the engine
+    std::atomic_bool solving( true );
+    std::thread watcher( [&] {
+        while ( solving.load() )
+        {
+            if ( _connection->waitForMessage( WATCH_INTERVAL_IN_MILLISECONDS ) )
+            {
+                _shouldQuitSolving = true;
+                _engine->quitSignal();
+                return;
+            }
+        }
+    } );
+
+    worker.popOneSubQueryAndSolve();
+    solving = false;
+    watcher.join();
+
+    // The subqueries created if the subquery timed out, in the order in
+    // which they were pushed
+    SubQueries subQueries;
+    while ( SubQuery *newSubQuery = _workload.tryPop( 0 ) )
+        subQueries.appendHead( newSubQuery );
+
+    IEngine::ExitCode result = _engine->getExitCode();
+    bool quit = ( result == IEngine::QUIT_REQUESTED );
+    if ( !quit )
+    {
+        Map<unsigned, double> solution;
+        if ( result == IEngine::SAT )
+        {
+            _engine->extractSolution( *_inputQuery, _engine->getPreprocessor() );
+            for ( unsigned i = 0; i < _inputQuery->getNumberOfVariables(); ++i )
+                solution[i] = _inputQuery->getSolutionValue( i );
+        }
+        try
+        {
+            _connection->send( DnCProtocol::encodeResult( result, subQueries, solution ) );
+        }
+        catch ( const MarabouError & )
+        {
+            // The coordinator was done before this subquery
+            quit = true;
+        }
+    }
+
+    for ( const auto &newSubQuery : subQueries )
+        delete newSubQuery;
+
+    return !quit;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
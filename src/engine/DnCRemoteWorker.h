@@ -0,0 +1,94 @@
+/*********************                                                        */
+/*! \file DnCRemoteWorker.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __DnCRemoteWorker_h__
+#define __DnCRemoteWorker_h__
+
+#include "DnCConnection.h"
+#include "DnCKnowledgeStore.h"
+#include "DnCWorker.h"
+#include "Engine.h"
+#include "IQuery.h"
+#include "WorkStealingQueue.h"
+
+#include <atomic>
+#include <memory>
+
+/*
+  A worker of a distributed DnC solve. The worker holds one engine, which
+  has processed the query, and solves the subqueries that the coordinator
+  sends it one at a time with a DnCWorker. The subqueries the DnCWorker
+  creates when a subquery times out are sent back to the coordinator, and
+  so is the satisfying assignment of the input query, if one is found.
+
+  While a subquery is being solved, the connection is watched, so that the
+  engine stops as soon as the coordinator quits.
+*/
+class DnCRemoteWorker
+{
+public:
+    /*
+      The engine must have processed the input query
+    */
+    DnCRemoteWorker( DnCConnection *connection,
+                     std::shared_ptr<Engine> engine,
+                     IQuery *inputQuery,
+                     unsigned verbosity );
+
+    /*
+      Serve the coordinator until it quits or disconnects. Return the
+      number of subqueries solved.
+    */
+    unsigned run();
+
+private:
+    enum {
+        WATCH_INTERVAL_IN_MILLISECONDS = 100,
+    };
+
+    /*
+      Solve the subquery, which the worker takes ownership of, and send the
+      result. Return false if the coordinator quit in the meantime.
+    */
+    bool solve( SubQuery *subQuery, DnCWorker &worker );
+
+    DnCConnection *_connection;
+    std::shared_ptr<Engine> _engine;
+    IQuery *_inputQuery;
+    unsigned _verbosity;
+
+    /*
+      The state shared with the DnCWorker, which solves the subqueries
+      pushed to its workload, and pushes back the subqueries it creates
+    */
+    WorkStealingQueue _workload;
+    std::atomic_int _numUnsolvedSubQueries;
+    std::atomic_bool _shouldQuitSolving;
+
+    /*
+      The tightenings learned on the subqueries solved by this worker
+    */
+    DnCKnowledgeStore _knowledge;
+};
+
+#endif // __DnCRemoteWorker_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -28,11 +28,11 @@
 #include "TableauStateStorageLevel.h"
 
 #include <atomic>
-#include <chrono>
 #include <cmath>
-#include <thread>
 
-DnCWorker::DnCWorker( WorkerQueue *workload,
+DnCWorker::DnCWorker( WorkStealingQueue *workload,
+                      DnCKnowledgeStore *knowledge,
+                      DnCCheckpoint *checkpoint,
                       std::shared_ptr<IEngine> engine,
                       std::atomic_int &numUnsolvedSubQueries,
                       std::atomic_bool &shouldQuitSolving,
@@ -43,6 +43,8 @@ DnCWorker::DnCWorker( WorkerQueue *workload,
                       unsigned verbosity,
                       bool parallelDeepSoI )
     : _workload( workload )
+    , _knowledge( knowledge )
+    , _checkpoint( checkpoint )
     , _engine( engine )
     , _numUnsolvedSubQueries( &numUnsolvedSubQueries )
     , _shouldQuitSolving( &shouldQuitSolving )
@@ -76,11 +78,8 @@ void DnCWorker::setQueryDivider( SnCDivideStrategy divideStrategy )
 
 void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 {
-    SubQuery *subQuery = NULL;
-    // Boost queue stores the next element into the passed-in pointer
-    // and returns true if the pop is successful (aka, the queue is not empty
-    // in most cases)
-    if ( _workload->pop( subQuery ) )
+    SubQuery *subQuery = _workload->pop( _threadId, *_shouldQuitSolving );
+    if ( subQuery )
     {
         String queryId = subQuery->_queryId;
         unsigned depth = subQuery->_depth;
@@ -90,8 +89,10 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             smtState = std::move( subQuery->_smtState );
         unsigned timeoutInSeconds = subQuery->_timeoutInSeconds;
 
-        // Reset the engine state
-        _engine->restoreState( *_initialState );
+        // Reset the engine state. In parallel DeepSoI mode, every worker
+        // solves a single subQuery and no initial state is stored.
+        if ( _initialState )
+            _engine->restoreState( *_initialState );
         _engine->reset();
 
         // TODO: each worker is going to keep a map from *CaseSplit to an
@@ -100,6 +101,7 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
 
         // Apply the split and solve
         _engine->applySnCSplit( *split, queryId );
+        bool improvedByImports = importTightenings( queryId );
 
         bool fullSolveNeeded = true; // denotes whether we need to solve the subquery
         if ( restoreTreeStates && smtState )
@@ -109,6 +111,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         {
             _engine->solve( timeoutInSeconds );
             result = _engine->getExitCode();
+            if ( _knowledge )
+                _knowledge->recordSubQuery( improvedByImports, _engine->getNumberOfPivots() );
         }
         else
         {
@@ -122,15 +126,26 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
         if ( result == IEngine::UNSAT )
         {
             // If UNSAT, continue to solve
+            if ( _checkpoint )
+                _checkpoint->remove( queryId );
             *_numUnsolvedSubQueries -= 1;
             if ( _numUnsolvedSubQueries->load() == 0 || _parallelDeepSoI )
-                *_shouldQuitSolving = true;
+                quitSolving();
             delete subQuery;
         }
         else if ( result == IEngine::TIMEOUT )
         {
-            // If TIMEOUT, split the current input region and add the
-            // new subQueries to the current queue
+            // If TIMEOUT, share what was learned at the root of the search
+            // with the descendants of the subQuery
+            if ( _knowledge )
+            {
+                List<Tightening> tightenings;
+                _engine->getRootLevelTightenings( tightenings );
+                _knowledge->publish( queryId, tightenings );
+            }
+
+            // Split the current input region and add the new subQueries to
+            // the current queue
             SubQueries subQueries;
             unsigned newTimeout = ( depth >= GlobalConfiguration::DNC_DEPTH_THRESHOLD - 1
                                         ? 0
@@ -150,6 +165,15 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             _queryDivider->createSubQueries(
                 numNewSubQueries, queryId, depth, *split, newTimeout, subQueries );
 
+            // Record the new subQueries before other workers can solve them
+            if ( _checkpoint )
+                _checkpoint->replace( queryId, subQueries );
+
+            // Count the new subQueries, in place of the current one, before
+            // pushing them: another worker may steal and refute one right
+            // away, and must not see the count drop to zero
+            *_numUnsolvedSubQueries += (int)subQueries.size() - 1;
+
             unsigned i = 0;
             for ( auto &newSubQuery : subQueries )
             {
@@ -159,14 +183,8 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
                     newSubQuery->_smtState = std::move( newSmtStates[i++] );
                 }
 
-                if ( !_workload->push( std::move( newSubQuery ) ) )
-                {
-                    throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
-                }
-
-                *_numUnsolvedSubQueries += 1;
+                _workload->push( _threadId, newSubQuery );
             }
-            *_numUnsolvedSubQueries -= 1;
             delete subQuery;
         }
         else if ( result == IEngine::QUIT_REQUESTED )
@@ -181,7 +199,7 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             // We must set the quit flag to true  if the result is not UNSAT or
             // TIMEOUT. This way, the DnCManager will kill all the DnCWorkers.
 
-            *_shouldQuitSolving = true;
+            quitSolving();
             if ( result == IEngine::SAT )
             {
                 // case SAT
@@ -203,11 +221,28 @@ void DnCWorker::popOneSubQueryAndSolve( bool restoreTreeStates )
             }
         }
     }
-    else
-    {
-        // If the queue is empty but the pop fails, wait and retry
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-    }
+}
+
+void DnCWorker::quitSolving()
+{
+    *_shouldQuitSolving = true;
+    _workload->wakeUpAll();
+}
+
+bool DnCWorker::importTightenings( const String &queryId )
+{
+    if ( !_knowledge )
+        return false;
+
+    List<Tightening> tightenings;
+    _knowledge->collect( queryId, tightenings );
+    if ( tightenings.empty() )
+        return false;
+
+    unsigned numFixedConstraints = 0;
+    unsigned numTightenings = _engine->importTightenings( tightenings, numFixedConstraints );
+    _knowledge->recordImport( tightenings.size(), numTightenings, numFixedConstraints );
+    return numTightenings > 0;
 }
 
 void DnCWorker::printProgress( String queryId, IEngine::ExitCode result ) const
@@ -16,17 +16,22 @@
 #ifndef __DnCWorker_h__
 #define __DnCWorker_h__
 
+#include "DnCCheckpoint.h"
+#include "DnCKnowledgeStore.h"
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
 #include "SnCDivideStrategy.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
 class DnCWorker
 {
 public:
-    DnCWorker( WorkerQueue *workload,
+    DnCWorker( WorkStealingQueue *workload,
+               DnCKnowledgeStore *knowledge,
+               DnCCheckpoint *checkpoint,
                std::shared_ptr<IEngine> engine,
                std::atomic_int &numUnsolvedSubqueries,
                std::atomic_bool &shouldQuitSolving,
@@ -38,11 +43,22 @@ public:
                bool parallelDeepSoI );
 
     /*
-      Pop one subQuery, solve it and handle the result
-      Return true if the DnCWorker should continue running
+      Pop one subQuery, solve it and handle the result. The subQuery is
+      taken from this worker's deque of the workload if possible, and
+      stolen from another worker otherwise; if there is none, block until
+      one is pushed or solving is over. Before solving, the tightenings
+      learned on the ancestors of the subQuery are imported; if it times
+      out, the tightenings that hold at the root of its search are
+      published for its descendants. The subQueries that are solved or
+      divided are recorded in the checkpoint.
     */
     void popOneSubQueryAndSolve( bool restoreTreeStates = false );
 
+    /*
+      Convert the exitCode to string
+    */
+    static String exitCodeToString( IEngine::ExitCode result );
+
 private:
     /*
       Initiate the query-divider object
@@ -50,19 +66,37 @@ private:
     void setQueryDivider( SnCDivideStrategy divideStrategy );
 
     /*
-      Convert the exitCode to string
+      Print the current progress
     */
-    static String exitCodeToString( IEngine::ExitCode result );
+    void printProgress( String queryId, IEngine::ExitCode result ) const;
 
     /*
-      Print the current progress
+      Raise the quit flag and wake up the other workers and the manager
     */
-    void printProgress( String queryId, IEngine::ExitCode result ) const;
+    void quitSolving();
 
     /*
-      The queue of subqueries (shared across threads)
+      Import into the engine the tightenings published for the subQuery
+      and its ancestors. Return true if they improved the engine's bounds.
     */
-    WorkerQueue *_workload;
+    bool importTightenings( const String &queryId );
+
+    /*
+      The subqueries, shared across threads. This worker pushes and pops
+      at its own deque, the one of index _threadId.
+    */
+    WorkStealingQueue *_workload;
+
+    /*
+      The tightenings shared across threads (may be NULL)
+    */
+    DnCKnowledgeStore *_knowledge;
+
+    /*
+      The frontier of the solve, saved to a file (may be NULL)
+    */
+    DnCCheckpoint *_checkpoint;
+
     std::shared_ptr<IEngine> _engine;
 
     /*
@@ -28,6 +28,7 @@
 #include "PiecewiseLinearConstraint.h"
 #include "Preprocessor.h"
 #include "Query.h"
+#include "SparseUnsortedArrays.h"
 #include "TableauRow.h"
 #include "TimeUtils.h"
 #include "VariableOutOfBoundDuringOptimizationException.h"
@@ -46,6 +47,8 @@ Engine::Engine()
     , _preprocessingEnabled( false )
     , _initialStateStored( false )
     , _work( NULL )
+    , _dualSimplexBasisAvailable( false )
+    , _dualSimplexStepsLeft( 0 )
     , _basisRestorationRequired( Engine::RESTORATION_NOT_NEEDED )
     , _basisRestorationPerformed( Engine::NO_RESTORATION_PERFORMED )
     , _costFunctionManager( _tableau )
@@ -63,7 +66,6 @@ Engine::Engine()
     , _milpEncoder( nullptr )
     , _soiManager( nullptr )
     , _simulationSize( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) )
-    , _isGurobyEnabled( Options::get()->gurobiEnabled() )
     , _performLpTighteningAfterSplit(
           Options::get()->getBool( Options::PERFORM_LP_TIGHTENING_AFTER_SPLIT ) )
     , _milpSolverBoundTighteningType( Options::get()->getMILPSolverBoundTighteningType() )
@@ -78,7 +80,29 @@ Engine::Engine()
     _rowBoundTightener->setStatistics( &_statistics );
     _preprocessor.setStatistics( &_statistics );
 
-    _activeEntryStrategy = _projectedSteepestEdgeRule;
+    switch ( Options::get()->getEntrySelectionStrategyType() )
+    {
+    case EntrySelectionStrategyType::DEVEX:
+        _activeEntryStrategy = &_devexRule;
+        break;
+    case EntrySelectionStrategyType::DANTZIG:
+        _activeEntryStrategy = &_dantzigsRule;
+        break;
+    case EntrySelectionStrategyType::BLAND:
+        _activeEntryStrategy = &_blandsRule;
+        break;
+    case EntrySelectionStrategyType::PROJECTED_STEEPEST_EDGE:
+        _activeEntryStrategy = _projectedSteepestEdgeRule;
+        break;
+    }
+
+    int partialPricingPoolSize = Options::get()->getInt( Options::PARTIAL_PRICING_POOL_SIZE );
+    if ( partialPricingPoolSize > 0 )
+    {
+        _partialPricingRule.setUnderlyingStrategy( _activeEntryStrategy );
+        _partialPricingRule.setPoolSize( partialPricingPoolSize );
+        _activeEntryStrategy = &_partialPricingRule;
+    }
     _activeEntryStrategy->setStatistics( &_statistics );
     _statistics.stampStartingTime();
     setRandomSeed( Options::get()->getInt( Options::SEED ) );
@@ -147,6 +171,68 @@ bool Engine::inSnCMode() const
     return _sncMode;
 }
 
+void Engine::getRootLevelTightenings( List<Tightening> &tightenings ) const
+{
+    tightenings.clear();
+    if ( _produceUNSATProofs )
+        return;
+
+    List<PiecewiseLinearCaseSplit> splits;
+    _smtCore.rootValidSplits( splits );
+    for ( const auto &split : splits )
+    {
+        // Splits that add equations cannot be shared as bounds
+        if ( !split.getEquations().empty() )
+            continue;
+
+        for ( const auto &tightening : split.getBoundTightenings() )
+            tightenings.append( tightening );
+    }
+}
+
+unsigned Engine::importTightenings( const List<Tightening> &tightenings,
+                                    unsigned &numFixedConstraints )
+{
+    numFixedConstraints = 0;
+    if ( _produceUNSATProofs )
+        return 0;
+
+    PiecewiseLinearCaseSplit split;
+    for ( const auto &tightening : tightenings )
+    {
+        unsigned variable = _tableau->getVariableAfterMerging( tightening._variable );
+        if ( tightening._type == Tightening::LB
+                 ? FloatUtils::gt( tightening._value, _boundManager.getLowerBound( variable ) )
+                 : FloatUtils::lt( tightening._value, _boundManager.getUpperBound( variable ) ) )
+            split.storeBoundTightening( tightening );
+    }
+
+    unsigned numTightenings = split.getBoundTightenings().size();
+    if ( numTightenings == 0 )
+        return 0;
+
+    unsigned numFixedBefore = 0;
+    for ( const auto &constraint : _plConstraints )
+        if ( constraint->isActive() && constraint->phaseFixed() )
+            ++numFixedBefore;
+
+    applySplit( split );
+    _boundManager.propagateTightenings();
+
+    for ( const auto &constraint : _plConstraints )
+        if ( constraint->isActive() && constraint->phaseFixed() )
+            ++numFixedConstraints;
+    numFixedConstraints =
+        numFixedConstraints > numFixedBefore ? numFixedConstraints - numFixedBefore : 0;
+
+    return numTightenings;
+}
+
+unsigned long long Engine::getNumberOfPivots() const
+{
+    return _statistics.getLongAttribute( Statistics::NUM_TABLEAU_PIVOTS );
+}
+
 void Engine::setRandomSeed( unsigned seed )
 {
     srand( seed );
@@ -295,6 +381,10 @@ bool Engine::solve( double timeoutInSeconds )
                 performBoundTighteningAfterCaseSplit();
                 informLPSolverOfBounds();
                 splitJustPerformed = false;
+
+                // Only the bounds have changed since the last feasible basis, if there was one
+                if ( _dualSimplexBasisAvailable )
+                    _dualSimplexStepsLeft = GlobalConfiguration::DUAL_SIMPLEX_MAX_ITERATIONS;
             }
 
             // Perform any SmtCore-initiated case splits
@@ -313,6 +403,12 @@ bool Engine::solve( double timeoutInSeconds )
 
             if ( allVarsWithinBounds() )
             {
+                if ( _lpSolverType == LPSolverType::NATIVE )
+                {
+                    _dualSimplexBasisAvailable = true;
+                    _dualSimplexStepsLeft = 0;
+                }
+
                 // It's possible that a disjunction constraint is fixed and additional constraints
                 // are introduced, making the linear portion unsatisfied. So we need to make sure
                 // there are no valid case splits that we do not know of.
@@ -376,7 +472,12 @@ bool Engine::solve( double timeoutInSeconds )
 
             // We have out-of-bounds variables.
             if ( _lpSolverType == LPSolverType::NATIVE )
-                performSimplexStep();
+            {
+                if ( shouldPerformDualSimplexStep() )
+                    performDualSimplexStep();
+                else
+                    performSimplexStep();
+            }
             else
             {
                 ENGINE_LOG( "Checking LP feasibility with Gurobi..." );
@@ -581,6 +682,8 @@ bool Engine::handleMalformedBasisException()
     printf( "MalformedBasisException caught!\n" );
     //
 
+    invalidateDualSimplexBasis();
+
     if ( _basisRestorationPerformed == Engine::NO_RESTORATION_PERFORMED )
     {
         if ( _numVisitedStatesAtPreviousRestoration !=
@@ -679,7 +782,7 @@ bool Engine::performSimplexStep()
 
     // Obtain all eligible entering variables
     List<unsigned> enteringVariableCandidates;
-    _tableau->getEntryCandidates( enteringVariableCandidates );
+    _activeEntryStrategy->getEntryCandidates( _tableau, enteringVariableCandidates );
 
     unsigned bestLeaving = 0;
     double bestChangeRatio = 0.0;
@@ -825,6 +928,118 @@ bool Engine::performSimplexStep()
     return false;
 }
 
+bool Engine::shouldPerformDualSimplexStep() const
+{
+    return GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES &&
+           ( _dualSimplexStepsLeft > 0 ) && !_tableau->isOptimizing();
+}
+
+void Engine::invalidateDualSimplexBasis()
+{
+    _dualSimplexBasisAvailable = false;
+    _dualSimplexStepsLeft = 0;
+}
+
+void Engine::performDualSimplexStep()
+{
+    // Statistics
+    _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_STEPS );
+    struct timespec start = TimeUtils::sampleMicro();
+
+    /*
+      The dual simplex keeps the basis dual feasible (trivially so, as
+      we are only looking for a feasible point) and works towards
+      primal feasibility:
+
+      1. Pick the basic variable with the largest bound violation as
+         the leaving variable.
+      2. Compute its row in the tableau, using BTRAN.
+      3. Pick an entering variable that can move the leaving variable
+         to its violated bound.
+      4. Compute the change column (FTRAN) and pivot.
+
+      When the subproblem takes too many steps or a numerically
+      unstable pivot is encountered, we fall back to the primal simplex.
+    */
+
+    --_dualSimplexStepsLeft;
+
+    if ( !_tableau->pickDualLeavingVariable() )
+    {
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.incLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO,
+                                      TimeUtils::timePassed( start, end ) );
+        return;
+    }
+
+    _tableau->computePivotRow();
+    _rowBoundTightener->examinePivotRow();
+
+    if ( !_tableau->pickDualEnteringVariable() )
+    {
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.incLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO,
+                                      TimeUtils::timePassed( start, end ) );
+
+        if ( _tableau->getBasicAssignmentStatus() != ITableau::BASIC_ASSIGNMENT_JUST_COMPUTED )
+        {
+            // This failure might have resulted from a corrupt basic assignment.
+            _tableau->computeAssignment();
+            return;
+        }
+
+        /*
+          No non-basic variable can move the leaving variable towards
+          its violated bound. If the pivot row proves this under the
+          current bounds, the subproblem is infeasible; otherwise, the
+          failure is numerical and we let the primal simplex take over.
+        */
+        const TableauRow &row = *_tableau->getPivotRow();
+        unsigned leavingIndex = _tableau->getLeavingVariableIndex();
+        unsigned leaving = _tableau->basicIndexToVariable( leavingIndex );
+        if ( _tableau->basicTooLow( leavingIndex )
+                 ? FloatUtils::lt( _boundManager.computeRowBound( row, true ),
+                                   _tableau->getLowerBound( leaving ) )
+                 : FloatUtils::gt( _boundManager.computeRowBound( row, false ),
+                                   _tableau->getUpperBound( leaving ) ) )
+            throw InfeasibleQueryException();
+
+        _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_FALLBACKS );
+        _dualSimplexStepsLeft = 0;
+        return;
+    }
+
+    _tableau->computeChangeColumn();
+
+    double pivotEntry =
+        FloatUtils::abs( _tableau->getChangeColumn()[_tableau->getLeavingVariableIndex()] );
+    if ( pivotEntry < GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+    {
+        // The primal simplex is better equipped to avoid small pivots
+        _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_FALLBACKS );
+        _dualSimplexStepsLeft = 0;
+
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.incLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO,
+                                      TimeUtils::timePassed( start, end ) );
+        return;
+    }
+
+    // Perform the actual pivot
+    _activeEntryStrategy->prePivotHook( _tableau, false );
+    _tableau->performPivot();
+    _activeEntryStrategy->postPivotHook( _tableau, false );
+    _boundManager.propagateTightenings();
+    _costFunctionManager->invalidateCostFunction();
+
+    if ( _dualSimplexStepsLeft == 0 && _tableau->existsBasicOutOfBounds() )
+        _statistics.incLongAttribute( Statistics::NUM_DUAL_SIMPLEX_FALLBACKS );
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.incLongAttribute( Statistics::TIME_DUAL_SIMPLEX_STEPS_MICRO,
+                                  TimeUtils::timePassed( start, end ) );
+}
+
 void Engine::fixViolatedPlConstraintIfPossible()
 {
     List<PiecewiseLinearConstraint::Fix> fixes;
@@ -1053,29 +1268,41 @@ void Engine::storeEquationsInDegradationChecker()
     _degradationChecker.storeEquations( *_preprocessedQuery );
 }
 
-double *Engine::createConstraintMatrix()
+SparseUnsortedArrays *Engine::createConstraintMatrix()
 {
     const List<Equation> &equations( _preprocessedQuery->getEquations() );
     unsigned m = equations.size();
     unsigned n = _preprocessedQuery->getNumberOfVariables();
 
-    // Step 1: create a constraint matrix from the equations
-    double *constraintMatrix = new double[n * m];
+    // Step 1: create a sparse constraint matrix from the equations. Its size
+    // is proportional to the number of addends, and not to n * m
+    SparseUnsortedArrays *constraintMatrix = new SparseUnsortedArrays;
     if ( !constraintMatrix )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::constraintMatrix" );
-    std::fill_n( constraintMatrix, n * m, 0.0 );
+    constraintMatrix->initializeToEmpty( m, n );
+
+    // A dense row, used in case a variable appears in an equation more than once
+    Vector<double> row( n, 0.0 );
 
     unsigned equationIndex = 0;
     for ( const auto &equation : equations )
     {
         if ( equation._type != Equation::EQ )
         {
+            delete constraintMatrix;
             _exitCode = Engine::ERROR;
             throw MarabouError( MarabouError::NON_EQUALITY_INPUT_EQUATION_DISCOVERED );
         }
 
         for ( const auto &addend : equation._addends )
-            constraintMatrix[equationIndex * n + addend._variable] = addend._coefficient;
+            row[addend._variable] = addend._coefficient;
+
+        for ( const auto &addend : equation._addends )
+        {
+            if ( !FloatUtils::isZero( row[addend._variable] ) )
+                constraintMatrix->append( equationIndex, addend._variable, row[addend._variable] );
+            row[addend._variable] = 0.0;
+        }
 
         ++equationIndex;
     }
@@ -1083,7 +1310,7 @@ double *Engine::createConstraintMatrix()
     return constraintMatrix;
 }
 
-void Engine::removeRedundantEquations( const double *constraintMatrix )
+void Engine::removeRedundantEquations( const SparseUnsortedArrays *constraintMatrix )
 {
     const List<Equation> &equations( _preprocessedQuery->getEquations() );
     unsigned m = equations.size();
@@ -1107,7 +1334,7 @@ void Engine::removeRedundantEquations( const double *constraintMatrix )
     }
 }
 
-void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
+void Engine::selectInitialVariablesForBasis( const SparseUnsortedArrays *constraintMatrix,
                                              List<unsigned> &initialBasis,
                                              List<unsigned> &basicRows )
 {
@@ -1119,6 +1346,11 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
 
       (It is possible that not enough variables are obtained this way, in which
       case the initial basis will have to be augmented later).
+
+      The matrix is only accessed through its sparse rows and columns, and
+      the singleton rows and the densest column are tracked in ordered sets,
+      so that the running time is roughly proportional to the number of
+      non-zero entries.
     */
 
     const List<Equation> &equations( _preprocessedQuery->getEquations() );
@@ -1135,6 +1367,10 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
         return;
     }
 
+    SparseUnsortedArrays columns;
+    constraintMatrix->transposeIntoOther( &columns );
+
+    // The counters are indexed by the current positions of rows and columns
     unsigned *nnzInRow = new unsigned[m];
     unsigned *nnzInColumn = new unsigned[n];
 
@@ -1143,22 +1379,32 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
 
     unsigned *columnOrdering = new unsigned[n];
     unsigned *rowOrdering = new unsigned[m];
+    unsigned *columnPosition = new unsigned[n];
+    unsigned *rowPosition = new unsigned[m];
 
     for ( unsigned i = 0; i < m; ++i )
+    {
         rowOrdering[i] = i;
+        rowPosition[i] = i;
+    }
 
     for ( unsigned i = 0; i < n; ++i )
+    {
         columnOrdering[i] = i;
+        columnPosition[i] = i;
+    }
 
     // Initialize the counters
     for ( unsigned i = 0; i < m; ++i )
     {
-        for ( unsigned j = 0; j < n; ++j )
+        const SparseUnsortedArray *row = constraintMatrix->getRow( i );
+        const SparseUnsortedArray::Entry *entries = row->getArray();
+        for ( unsigned j = 0; j < row->getNnz(); ++j )
         {
-            if ( !FloatUtils::isZero( constraintMatrix[i * n + j] ) )
+            if ( !FloatUtils::isZero( entries[j]._value ) )
             {
                 ++nnzInRow[i];
-                ++nnzInColumn[j];
+                ++nnzInColumn[entries[j]._index];
             }
         }
     }
@@ -1170,6 +1416,28 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
         }
     } );
 
+    // Positions of the remaining singleton rows, and the remaining columns
+    // ordered by decreasing density (ties broken by position)
+    Set<unsigned> singletonRows;
+    Set<std::pair<int, unsigned>> columnsByDensity;
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        if ( nnzInRow[i] == 1 )
+            singletonRows.insert( i );
+    }
+
+    for ( unsigned i = 0; i < n; ++i )
+        columnsByDensity.insert( std::make_pair( -(int)nnzInColumn[i], i ) );
+
+    auto decrementRowCounter = [&]( unsigned position ) {
+        --nnzInRow[position];
+        if ( nnzInRow[position] == 1 )
+            singletonRows.insert( position );
+        else if ( nnzInRow[position] == 0 )
+            singletonRows.erase( position );
+    };
+
     unsigned numExcluded = 0;
     unsigned numTriangularRows = 0;
     unsigned temp;
@@ -1177,22 +1445,23 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
     while ( numExcluded + numTriangularRows < n )
     {
         // Do we have a singleton row?
-        unsigned singletonRow = m;
-        for ( unsigned i = numTriangularRows; i < m; ++i )
+        if ( !singletonRows.empty() )
         {
-            if ( nnzInRow[i] == 1 )
+            unsigned singletonRow = *singletonRows.begin();
+            singletonRows.erase( singletonRow );
+
+            // Have a singleton row! Swap it to the top and update counters
+            if ( singletonRows.exists( numTriangularRows ) )
             {
-                singletonRow = i;
-                break;
+                singletonRows.erase( numTriangularRows );
+                singletonRows.insert( singletonRow );
             }
-        }
 
-        if ( singletonRow < m )
-        {
-            // Have a singleton row! Swap it to the top and update counters
             temp = rowOrdering[singletonRow];
             rowOrdering[singletonRow] = rowOrdering[numTriangularRows];
             rowOrdering[numTriangularRows] = temp;
+            rowPosition[rowOrdering[singletonRow]] = singletonRow;
+            rowPosition[rowOrdering[numTriangularRows]] = numTriangularRows;
 
             temp = nnzInRow[numTriangularRows];
             nnzInRow[numTriangularRows] = nnzInRow[singletonRow];
@@ -1200,32 +1469,48 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
 
             // Find the non-zero entry in the row and swap it to the diagonal
             DEBUG( bool foundNonZero = false );
-            for ( unsigned i = numTriangularRows; i < n - numExcluded; ++i )
+            const SparseUnsortedArray *row =
+                constraintMatrix->getRow( rowOrdering[numTriangularRows] );
+            const SparseUnsortedArray::Entry *entries = row->getArray();
+            for ( unsigned j = 0; j < row->getNnz(); ++j )
             {
-                if ( !FloatUtils::isZero( constraintMatrix[rowOrdering[numTriangularRows] * n +
-                                                           columnOrdering[i]] ) )
-                {
-                    temp = columnOrdering[i];
-                    columnOrdering[i] = columnOrdering[numTriangularRows];
-                    columnOrdering[numTriangularRows] = temp;
+                unsigned i = columnPosition[entries[j]._index];
+                if ( i < numTriangularRows || i >= n - numExcluded ||
+                     FloatUtils::isZero( entries[j]._value ) )
+                    continue;
 
-                    temp = nnzInColumn[numTriangularRows];
-                    nnzInColumn[numTriangularRows] = nnzInColumn[i];
-                    nnzInColumn[i] = temp;
+                columnsByDensity.erase( std::make_pair( -(int)nnzInColumn[i], i ) );
+                columnsByDensity.erase(
+                    std::make_pair( -(int)nnzInColumn[numTriangularRows], numTriangularRows ) );
 
-                    DEBUG( foundNonZero = true );
-                    break;
-                }
+                temp = columnOrdering[i];
+                columnOrdering[i] = columnOrdering[numTriangularRows];
+                columnOrdering[numTriangularRows] = temp;
+                columnPosition[columnOrdering[i]] = i;
+                columnPosition[columnOrdering[numTriangularRows]] = numTriangularRows;
+
+                temp = nnzInColumn[numTriangularRows];
+                nnzInColumn[numTriangularRows] = nnzInColumn[i];
+                nnzInColumn[i] = temp;
+
+                if ( i != numTriangularRows )
+                    columnsByDensity.insert( std::make_pair( -(int)nnzInColumn[i], i ) );
+
+                DEBUG( foundNonZero = true );
+                break;
             }
 
             ASSERT( foundNonZero );
 
             // Remove all entries under the diagonal entry from the row counters
-            for ( unsigned i = numTriangularRows + 1; i < m; ++i )
+            const SparseUnsortedArray *column =
+                columns.getRow( columnOrdering[numTriangularRows] );
+            entries = column->getArray();
+            for ( unsigned j = 0; j < column->getNnz(); ++j )
             {
-                if ( !FloatUtils::isZero( constraintMatrix[rowOrdering[i] * n +
-                                                           columnOrdering[numTriangularRows]] ) )
-                    --nnzInRow[i];
+                if ( rowPosition[entries[j]._index] > numTriangularRows &&
+                     !FloatUtils::isZero( entries[j]._value ) )
+                    decrementRowCounter( rowPosition[entries[j]._index] );
             }
 
             ++numTriangularRows;
@@ -1233,31 +1518,35 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
         else
         {
             // No singleton rows. Exclude the densest column
-            unsigned maxDensity = nnzInColumn[numTriangularRows];
-            unsigned column = numTriangularRows;
+            unsigned column = columnsByDensity.begin()->second;
+            unsigned last = n - 1 - numExcluded;
 
-            for ( unsigned i = numTriangularRows; i < n - numExcluded; ++i )
+            // Update the row counters to account for the excluded column
+            const SparseUnsortedArray *excluded = columns.getRow( columnOrdering[column] );
+            const SparseUnsortedArray::Entry *entries = excluded->getArray();
+            for ( unsigned j = 0; j < excluded->getNnz(); ++j )
             {
-                if ( nnzInColumn[i] > maxDensity )
+                if ( rowPosition[entries[j]._index] >= numTriangularRows &&
+                     !FloatUtils::isZero( entries[j]._value ) )
                 {
-                    maxDensity = nnzInColumn[i];
-                    column = i;
+                    ASSERT( nnzInRow[rowPosition[entries[j]._index]] > 1 );
+                    decrementRowCounter( rowPosition[entries[j]._index] );
                 }
             }
 
-            // Update the row counters to account for the excluded column
-            for ( unsigned i = numTriangularRows; i < m; ++i )
+            columnsByDensity.erase( std::make_pair( -(int)nnzInColumn[column], column ) );
+            columnsByDensity.erase( std::make_pair( -(int)nnzInColumn[last], last ) );
+
+            columnPosition[columnOrdering[column]] = n;
+            columnOrdering[column] = columnOrdering[last];
+            nnzInColumn[column] = nnzInColumn[last];
+
+            if ( column != last )
             {
-                double element = constraintMatrix[rowOrdering[i] * n + columnOrdering[column]];
-                if ( !FloatUtils::isZero( element ) )
-                {
-                    ASSERT( nnzInRow[i] > 1 );
-                    --nnzInRow[i];
-                }
+                columnPosition[columnOrdering[column]] = column;
+                columnsByDensity.insert( std::make_pair( -(int)nnzInColumn[column], column ) );
             }
 
-            columnOrdering[column] = columnOrdering[n - 1 - numExcluded];
-            nnzInColumn[column] = nnzInColumn[n - 1 - numExcluded];
             ++numExcluded;
         }
     }
@@ -1280,6 +1569,8 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix,
     delete[] nnzInColumn;
     delete[] columnOrdering;
     delete[] rowOrdering;
+    delete[] columnPosition;
+    delete[] rowPosition;
 }
 
 void Engine::addAuxiliaryVariables()
@@ -1322,7 +1613,8 @@ void Engine::augmentInitialBasisIfNeeded( List<unsigned> &initialBasis,
     }
 }
 
-void Engine::initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis )
+void Engine::initializeTableau( const SparseUnsortedArrays *constraintMatrix,
+                                const List<unsigned> &initialBasis )
 {
     const List<Equation> &equations( _preprocessedQuery->getEquations() );
     unsigned m = equations.size();
@@ -1393,11 +1685,13 @@ void Engine::initializeBoundsAndConstraintWatchersInTableau( unsigned numberOfVa
 void Engine::initializeNetworkLevelReasoning()
 {
     _networkLevelReasoner = _preprocessedQuery->getNetworkLevelReasoner();
+    _conflictAnalysisNetworkLevelReasoner = nullptr;
 
     if ( _networkLevelReasoner )
     {
         _networkLevelReasoner->computeSuccessorLayers();
         _networkLevelReasoner->setTableau( _tableau );
+        _networkLevelReasoner->setQuitRequested( &_quitRequested );
         if ( Options::get()->getBool( Options::DUMP_TOPOLOGY ) )
         {
             _networkLevelReasoner->dumpTopology( false );
@@ -1454,11 +1748,11 @@ bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
 
         if ( _lpSolverType == LPSolverType::NATIVE )
         {
-            double *constraintMatrix = createConstraintMatrix();
+            SparseUnsortedArrays *constraintMatrix = createConstraintMatrix();
             removeRedundantEquations( constraintMatrix );
 
             // The equations have changed, recreate the constraint matrix
-            delete[] constraintMatrix;
+            delete constraintMatrix;
             constraintMatrix = createConstraintMatrix();
 
             List<unsigned> initialBasis;
@@ -1470,7 +1764,7 @@ bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
             storeEquationsInDegradationChecker();
 
             // The equations have changed, recreate the constraint matrix
-            delete[] constraintMatrix;
+            delete constraintMatrix;
             constraintMatrix = createConstraintMatrix();
 
             unsigned n = _preprocessedQuery->getNumberOfVariables();
@@ -1478,7 +1772,7 @@ bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
 
             initializeTableau( constraintMatrix, initialBasis );
             _boundManager.initializeBoundExplainer( n, _tableau->getM() );
-            delete[] constraintMatrix;
+            delete constraintMatrix;
 
             if ( _produceUNSATProofs )
             {
@@ -1569,7 +1863,8 @@ bool Engine::processInputQuery( const IQuery &inputQuery, bool preprocess )
 
 void Engine::performMILPSolverBoundedTightening( Query *inputQuery )
 {
-    if ( _networkLevelReasoner && Options::get()->gurobiEnabled() )
+    if ( _networkLevelReasoner &&
+         _milpSolverBoundTighteningType != MILPSolverBoundTighteningType::NONE )
     {
         // Obtain from and store bounds into inputquery if it is not null.
         if ( inputQuery )
@@ -1661,7 +1956,7 @@ void Engine::performMILPSolverBoundedTighteningForSingleLayer( unsigned targetIn
     if ( _produceUNSATProofs )
         return;
 
-    if ( _networkLevelReasoner && _isGurobyEnabled && _performLpTighteningAfterSplit &&
+    if ( _networkLevelReasoner && _performLpTighteningAfterSplit &&
          _milpSolverBoundTighteningType != MILPSolverBoundTighteningType::NONE )
     {
         _networkLevelReasoner->obtainCurrentBounds();
@@ -1814,8 +2109,19 @@ void Engine::storeState( EngineState &state, TableauStateStorageLevel level ) co
     _tableau->storeState( state._tableauState, level );
     state._tableauStateStorageLevel = level;
 
+    // Only the constraints that changed since their last stored state are copied
     for ( const auto &constraint : _plConstraints )
-        state._plConstraintToState[constraint] = constraint->duplicateConstraint();
+    {
+        std::shared_ptr<const PiecewiseLinearConstraint> &stored = _plConstraintStates[constraint];
+        if ( !stored || stored->getStateVersion() != constraint->getStateVersion() )
+        {
+            PiecewiseLinearConstraint *copy = constraint->duplicateConstraint();
+            copy->cdoCleanupOfState();
+            stored = std::shared_ptr<const PiecewiseLinearConstraint>( copy );
+        }
+
+        state._plConstraintToState[constraint] = stored;
+    }
 
     state._numPlConstraintsDisabledByValidSplits = _numPlConstraintsDisabledByValidSplits;
 }
@@ -1827,8 +2133,13 @@ void Engine::restoreState( const EngineState &state )
     if ( state._tableauStateStorageLevel == TableauStateStorageLevel::STORE_NONE )
         throw MarabouError( MarabouError::RESTORING_ENGINE_FROM_INVALID_STATE );
 
+    unsigned m = _tableau->getM();
+    unsigned n = _tableau->getN();
+
     ENGINE_LOG( "\tRestoring tableau state" );
     _tableau->restoreState( state._tableauState, state._tableauStateStorageLevel );
+    if ( state._tableauStateStorageLevel == TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE )
+        invalidateDualSimplexBasis();
 
     ENGINE_LOG( "\tRestoring constraint states" );
     for ( auto &constraint : _plConstraints )
@@ -1836,18 +2147,38 @@ void Engine::restoreState( const EngineState &state )
         if ( !state._plConstraintToState.exists( constraint ) )
             throw MarabouError( MarabouError::MISSING_PL_CONSTRAINT_STATE );
 
-        constraint->restoreState( state._plConstraintToState[constraint] );
+        // A constraint that did not change since the state was stored is kept
+        const std::shared_ptr<const PiecewiseLinearConstraint> &stored =
+            state._plConstraintToState[constraint];
+        if ( stored->getStateVersion() != constraint->getStateVersion() )
+        {
+            constraint->restoreState( stored.get() );
+            _plConstraintStates[constraint] = stored;
+        }
     }
 
     _numPlConstraintsDisabledByValidSplits = state._numPlConstraintsDisabledByValidSplits;
 
     if ( _lpSolverType == LPSolverType::NATIVE )
     {
-        // Make sure the data structures are initialized to the correct size
-        _rowBoundTightener->setDimensions();
-        adjustWorkMemorySize();
-        _activeEntryStrategy->resizeHook( _tableau );
-        _costFunctionManager->initialize();
+        if ( _tableau->getM() != m || _tableau->getN() != n )
+        {
+            // Make sure the data structures are initialized to the correct size
+            _rowBoundTightener->setDimensions();
+            adjustWorkMemorySize();
+            _activeEntryStrategy->resizeHook( _tableau );
+            _costFunctionManager->initialize();
+        }
+        else
+        {
+            // The dimensions are unchanged, but the bounds were restored, and
+            // so was the basis if the entire tableau was
+            _rowBoundTightener->scheduleAllRows();
+            if ( state._tableauStateStorageLevel ==
+                 TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE )
+                _activeEntryStrategy->resizeHook( _tableau );
+            _costFunctionManager->invalidateCostFunction();
+        }
     }
 
     // Reset the violation counts in the SMT core
@@ -1945,6 +2276,7 @@ bool Engine::attemptToMergeVariables( unsigned x1, unsigned x2 )
     }
 
     // Both variables are now non-basic, so we can merge their columns
+    invalidateDualSimplexBasis();
     _tableau->mergeColumns( x1, x2 );
     DEBUG( _tableau->verifyInvariants() );
 
@@ -2032,6 +2364,7 @@ void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
         if ( !columnsSuccessfullyMerged )
         {
             // General case: add a new equation to the tableau
+            invalidateDualSimplexBasis();
             unsigned auxVariable = _tableau->addEquation( equation );
             _activeEntryStrategy->resizeHook( _tableau );
 
@@ -2194,6 +2527,7 @@ bool Engine::highDegradation()
 
     double degradation = _degradationChecker.computeDegradation( *_tableau );
     _statistics.setDoubleAttribute( Statistics::CURRENT_DEGRADATION, degradation );
+    _tableau->notifyDegradation( degradation );
     if ( FloatUtils::gt( degradation,
                          _statistics.getDoubleAttribute( Statistics::MAX_DEGRADATION ) ) )
         _statistics.setDoubleAttribute( Statistics::MAX_DEGRADATION, degradation );
@@ -2260,6 +2594,8 @@ void Engine::performPrecisionRestoration( PrecisionRestorer::RestoreBasics resto
 {
     struct timespec start = TimeUtils::sampleMicro();
 
+    invalidateDualSimplexBasis();
+
     // debug
     double before = _degradationChecker.computeDegradation( *_tableau );
     //
@@ -2393,24 +2729,22 @@ void Engine::performSimulation()
         return;
     }
 
-    // outer vector is for neuron
-    // inner vector is for simulation value
-    Vector<Vector<double>> simulations;
+    // The inputs of the simulations are stored one simulation after the
+    // other. The values of every input neuron are drawn consecutively.
+    const NLR::Layer *inputLayer = _networkLevelReasoner->getLayer( 0 );
+    unsigned inputSize = inputLayer->getSize();
+    Vector<double> simulations( inputSize * _simulationSize );
 
     std::mt19937 mt( GlobalConfiguration::SIMULATION_RANDOM_SEED );
 
-    for ( unsigned i = 0; i < _networkLevelReasoner->getLayer( 0 )->getSize(); ++i )
+    for ( unsigned i = 0; i < inputSize; ++i )
     {
-        std::uniform_real_distribution<double> distribution(
-            _networkLevelReasoner->getLayer( 0 )->getLb( i ),
-            _networkLevelReasoner->getLayer( 0 )->getUb( i ) );
-        Vector<double> simulationInput( _simulationSize );
-
+        std::uniform_real_distribution<double> distribution( inputLayer->getLb( i ),
+                                                             inputLayer->getUb( i ) );
         for ( unsigned j = 0; j < _simulationSize; ++j )
-            simulationInput[j] = distribution( mt );
-        simulations.append( simulationInput );
+            simulations[j * inputSize + i] = distribution( mt );
     }
-    _networkLevelReasoner->simulate( &simulations );
+    _networkLevelReasoner->simulate( simulations.data(), _simulationSize );
 }
 
 unsigned Engine::performSymbolicBoundTightening( Query *inputQuery )
@@ -2438,8 +2772,18 @@ unsigned Engine::performSymbolicBoundTightening( Query *inputQuery )
     // Step 2: perform SBT
     if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
         _networkLevelReasoner->symbolicBoundPropagation();
-    else if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::DEEP_POLY )
-        _networkLevelReasoner->deepPolyPropagation();
+    else if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::DEEP_POLY ||
+              _symbolicBoundTighteningType == SymbolicBoundTighteningType::ALPHA_DEEP_POLY )
+    {
+        if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::ALPHA_DEEP_POLY )
+            _networkLevelReasoner->alphaDeepPolyPropagation();
+        else
+            _networkLevelReasoner->deepPolyPropagation();
+        _statistics.incLongAttribute( Statistics::NUM_DEEP_POLY_LAYERS_EXECUTED,
+                                      _networkLevelReasoner->getNumDeepPolyLayersExecuted() );
+        _statistics.incLongAttribute( Statistics::NUM_DEEP_POLY_LAYERS_SKIPPED,
+                                      _networkLevelReasoner->getNumDeepPolyLayersSkipped() );
+    }
 
     // Step 3: Extract the bounds
     List<Tightening> tightenings;
@@ -2512,6 +2856,19 @@ void Engine::preContextPushHook()
     _boundManager.storeLocalBounds();
     if ( _produceUNSATProofs )
         _groundBoundManager.storeLocalBounds();
+
+    // Leaving the root of the search tree (which, in SnC mode, is below the SnC split)
+    if ( (unsigned)_context.getLevel() == ( _sncMode ? 1U : 0U ) )
+    {
+        unsigned numberOfVariables = _boundManager.getNumberOfVariables();
+        _rootLowerBounds.clear();
+        _rootUpperBounds.clear();
+        for ( unsigned i = 0; i < numberOfVariables; ++i )
+        {
+            _rootLowerBounds.append( _boundManager.getLowerBound( i ) );
+            _rootUpperBounds.append( _boundManager.getUpperBound( i ) );
+        }
+    }
     struct timespec end = TimeUtils::sampleMicro();
 
     _statistics.incLongAttribute( Statistics::TIME_CONTEXT_PUSH_HOOK,
@@ -2795,6 +3152,11 @@ PiecewiseLinearConstraint *Engine::pickSplitPLConstraintBasedOnIntervalWidth()
     }
 }
 
+bool Engine::isTemporaryConstraint( const PiecewiseLinearConstraint *constraint ) const
+{
+    return constraint != NULL && constraint == _disjunctionForSplitting.get();
+}
+
 PiecewiseLinearConstraint *Engine::pickSplitPLConstraint( DivideStrategy strategy )
 {
     ENGINE_LOG( Stringf( "Picking a split PLConstraint..." ).ascii() );
@@ -3279,6 +3641,76 @@ bool Engine::consistentBounds() const
     return _boundManager.consistentBounds();
 }
 
+bool Engine::caseSplitsRefutedAtRoot( const List<PiecewiseLinearCaseSplit> &splits )
+{
+    if ( _rootLowerBounds.empty() )
+        return false;
+
+    unsigned numberOfVariables = _rootLowerBounds.size();
+    Query bounds;
+    bounds.setNumberOfVariables( numberOfVariables );
+    for ( unsigned i = 0; i < numberOfVariables; ++i )
+    {
+        bounds.setLowerBound( i, _rootLowerBounds[i] );
+        bounds.setUpperBound( i, _rootUpperBounds[i] );
+    }
+
+    List<Tightening> tightenings;
+    for ( const auto &split : splits )
+    {
+        for ( const auto &tightening : split.getBoundTightenings() )
+            tightenings.append( tightening );
+    }
+
+    // Apply the splits, and then whatever the NLR derives from them
+    for ( unsigned round = 0; round < 2; ++round )
+    {
+        for ( const auto &tightening : tightenings )
+        {
+            unsigned variable = tightening._variable;
+            if ( variable >= numberOfVariables )
+                continue;
+
+            if ( tightening._type == Tightening::LB &&
+                 FloatUtils::gt( tightening._value, bounds.getLowerBound( variable ) ) )
+                bounds.setLowerBound( variable, tightening._value );
+            else if ( tightening._type == Tightening::UB &&
+                      FloatUtils::lt( tightening._value, bounds.getUpperBound( variable ) ) )
+                bounds.setUpperBound( variable, tightening._value );
+
+            if ( FloatUtils::gt( bounds.getLowerBound( variable ),
+                                 bounds.getUpperBound( variable ) ) )
+                return true;
+        }
+
+        if ( round > 0 || !_networkLevelReasoner || _produceUNSATProofs )
+            break;
+
+        if ( !_conflictAnalysisNetworkLevelReasoner )
+        {
+            _conflictAnalysisNetworkLevelReasoner =
+                std::unique_ptr<NLR::NetworkLevelReasoner>( new NLR::NetworkLevelReasoner );
+            _networkLevelReasoner->storeIntoOther( *_conflictAnalysisNetworkLevelReasoner );
+            _conflictAnalysisNetworkLevelReasoner->setQuitRequested( &_quitRequested );
+        }
+
+        NLR::NetworkLevelReasoner &networkLevelReasoner = *_conflictAnalysisNetworkLevelReasoner;
+        networkLevelReasoner.obtainCurrentBounds( bounds );
+        if ( _symbolicBoundTighteningType == SymbolicBoundTighteningType::NONE )
+            networkLevelReasoner.intervalArithmeticBoundPropagation();
+        else if ( _symbolicBoundTighteningType ==
+                  SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
+            networkLevelReasoner.symbolicBoundPropagation();
+        else
+            networkLevelReasoner.deepPolyPropagation();
+
+        tightenings.clear();
+        networkLevelReasoner.getConstraintTightenings( tightenings );
+    }
+
+    return false;
+}
+
 Query Engine::buildQueryFromCurrentState() const
 {
     Query query = *_preprocessedQuery;
@@ -25,6 +25,7 @@
 #include "Checker.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
+#include "DevexRule.h"
 #include "DivideStrategy.h"
 #include "GlobalConfiguration.h"
 #include "GurobiWrapper.h"
@@ -36,6 +37,7 @@
 #include "MILPEncoder.h"
 #include "Map.h"
 #include "Options.h"
+#include "PartialPricingRule.h"
 #include "PrecisionRestorer.h"
 #include "Preprocessor.h"
 #include "Query.h"
@@ -50,6 +52,7 @@
 #include "UnsatCertificateNode.h"
 
 #include <atomic>
+#include <memory>
 #include <context/context.h>
 
 
@@ -62,6 +65,7 @@
 class EngineState;
 class Query;
 class PiecewiseLinearConstraint;
+class SparseUnsortedArrays;
 class String;
 
 
@@ -215,6 +219,11 @@ public:
     */
     PiecewiseLinearConstraint *pickSplitPLConstraintSnC( SnCDivideStrategy strategy );
 
+    /*
+      Returns true if the constraint is the disjunction created for the last input split
+    */
+    bool isTemporaryConstraint( const PiecewiseLinearConstraint *constraint ) const;
+
     /*
       PSA: The following two methods are for DnC only and should be used very
       cautiously.
@@ -230,6 +239,17 @@ public:
 
     bool inSnCMode() const;
 
+    /*
+      Share tightenings between DnC workers: the tightenings of the splits
+      that hold at the root of the search, and the import of such
+      tightenings learned on ancestor subqueries. Nothing is shared when
+      producing proofs, as imported tightenings have no explanations.
+    */
+    void getRootLevelTightenings( List<Tightening> &tightenings ) const;
+    unsigned importTightenings( const List<Tightening> &tightenings,
+                                unsigned &numFixedConstraints );
+    unsigned long long getNumberOfPivots() const;
+
     /*
        Apply bound tightenings stored in the bound manager.
      */
@@ -338,6 +358,13 @@ private:
      */
     BoundManager _boundManager;
 
+    /*
+      The bounds of all variables when the search last left the root of the search tree, against
+      which the SmtCore checks sets of case splits during conflict analysis.
+    */
+    Vector<double> _rootLowerBounds;
+    Vector<double> _rootUpperBounds;
+
     /*
       Collect and print various statistics.
     */
@@ -353,6 +380,13 @@ private:
     */
     List<PiecewiseLinearConstraint *> _plConstraints;
 
+    /*
+      The last state stored or restored for each of the PL constraints,
+      which engine states share until the constraint changes.
+    */
+    mutable Map<PiecewiseLinearConstraint *, std::shared_ptr<const PiecewiseLinearConstraint>>
+        _plConstraintStates;
+
     /*
       The existing nonlinear constraints.
     */
@@ -379,6 +413,8 @@ private:
     BlandsRule _blandsRule;
     DantzigsRule _dantzigsRule;
     AutoProjectedSteepestEdgeRule _projectedSteepestEdgeRule;
+    DevexRule _devexRule;
+    PartialPricingRule _partialPricingRule;
     EntrySelectionStrategy *_activeEntryStrategy;
 
     /*
@@ -421,6 +457,16 @@ private:
     */
     double *_work;
 
+    /*
+      Dual simplex state. _dualSimplexBasisAvailable indicates that the
+      tableau holds a basis that was feasible before the bounds were
+      last changed, and _dualSimplexStepsLeft is the number of dual
+      simplex steps the engine may still perform in the current
+      subproblem before falling back to the primal simplex.
+    */
+    bool _dualSimplexBasisAvailable;
+    unsigned _dualSimplexStepsLeft;
+
     /*
       Restoration status.
     */
@@ -461,6 +507,15 @@ private:
      */
     NLR::NetworkLevelReasoner *_networkLevelReasoner;
 
+    /*
+      A copy of the network level reasoner, created on first use, on which
+      caseSplitsRefutedAtRoot() propagates bounds. The bounds, pending
+      tightenings and DeepPoly snapshots of the search are thus left as they
+      were, and the copy keeps snapshots of its own across the checks of a
+      conflict, which differ in a single split.
+    */
+    std::unique_ptr<NLR::NetworkLevelReasoner> _conflictAnalysisNetworkLevelReasoner;
+
     /*
       Verbosity level:
       0: print out minimal information
@@ -520,7 +575,6 @@ private:
       there is a chance that multiple Engine object be accessing the Options object.
     */
     unsigned _simulationSize;
-    bool _isGurobyEnabled;
     bool _performLpTighteningAfterSplit;
     MILPSolverBoundTighteningType _milpSolverBoundTighteningType;
 
@@ -550,6 +604,23 @@ private:
     */
     bool performSimplexStep();
 
+    /*
+      Perform a dual simplex step: pick the leaving variable by dual
+      pricing, compute its pivot row using BTRAN, pick the entering
+      variable by the dual ratio test and perform the pivot. Used for
+      re-solving subproblems in which only bounds have changed since the
+      last feasible basis.
+    */
+    void performDualSimplexStep();
+    bool shouldPerformDualSimplexStep() const;
+
+    /*
+      Invoked when the basis is replaced or the tableau changes
+      structurally, so that the previous feasible basis can no longer be
+      used as a starting point for the dual simplex.
+    */
+    void invalidateDualSimplexBasis();
+
     /*
       Perform a constraint-fixing step: select a violated piece-wise
       linear constraint and attempt to fix it.
@@ -720,14 +791,15 @@ private:
     void invokePreprocessor( const IQuery &inputQuery, bool preprocess );
     void printInputBounds( const IQuery &inputQuery ) const;
     void storeEquationsInDegradationChecker();
-    void removeRedundantEquations( const double *constraintMatrix );
-    void selectInitialVariablesForBasis( const double *constraintMatrix,
+    void removeRedundantEquations( const SparseUnsortedArrays *constraintMatrix );
+    void selectInitialVariablesForBasis( const SparseUnsortedArrays *constraintMatrix,
                                          List<unsigned> &initialBasis,
                                          List<unsigned> &basicRows );
-    void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
+    void initializeTableau( const SparseUnsortedArrays *constraintMatrix,
+                            const List<unsigned> &initialBasis );
     void initializeBoundsAndConstraintWatchersInTableau( unsigned numberOfVariables );
     void initializeNetworkLevelReasoning();
-    double *createConstraintMatrix();
+    SparseUnsortedArrays *createConstraintMatrix();
     void addAuxiliaryVariables();
     void augmentInitialBasisIfNeeded( List<unsigned> &initialBasis,
                                       const List<unsigned> &basicRows );
@@ -822,6 +894,12 @@ private:
      */
     bool consistentBounds() const;
 
+    /*
+      Returns true if bound propagation from the root bounds proves that the given case splits
+      cannot all hold together. Used by the SmtCore for conflict analysis.
+    */
+    bool caseSplitsRefutedAtRoot( const List<PiecewiseLinearCaseSplit> &splits );
+
     /*
       DEBUG only
       Check that the variable bounds in Gurobi is up-to-date.
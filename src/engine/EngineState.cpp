@@ -21,15 +21,6 @@ EngineState::EngineState()
 
 EngineState::~EngineState()
 {
-    for ( auto &kv : _plConstraintToState )
-    {
-        PiecewiseLinearConstraint *state = kv.second;
-        if ( state )
-        {
-            delete state;
-            kv.second = NULL;
-        }
-    }
 }
 
 //
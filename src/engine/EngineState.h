@@ -22,6 +22,8 @@
 #include "TableauState.h"
 #include "TableauStateStorageLevel.h"
 
+#include <memory>
+
 class EngineState
 {
 public:
@@ -35,9 +37,12 @@ public:
     TableauState _tableauState;
 
     /*
-      The state of each of the PL constraints
+      The state of each of the PL constraints. A state is shared by the
+      engine states stored while the constraint did not change (see
+      PiecewiseLinearConstraint::getStateVersion()).
     */
-    Map<PiecewiseLinearConstraint *, PiecewiseLinearConstraint *> _plConstraintToState;
+    Map<PiecewiseLinearConstraint *, std::shared_ptr<const PiecewiseLinearConstraint>>
+        _plConstraintToState;
     unsigned _numPlConstraintsDisabledByValidSplits;
 
     /*
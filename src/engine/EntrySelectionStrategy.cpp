@@ -15,6 +15,8 @@
 
 #include "EntrySelectionStrategy.h"
 
+#include "ITableau.h"
+
 #include <cstring>
 
 EntrySelectionStrategy::EntrySelectionStrategy()
@@ -22,6 +24,12 @@ EntrySelectionStrategy::EntrySelectionStrategy()
 {
 }
 
+void EntrySelectionStrategy::getEntryCandidates( const ITableau &tableau,
+                                                 List<unsigned> &candidates )
+{
+    tableau.getEntryCandidates( candidates );
+}
+
 void EntrySelectionStrategy::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
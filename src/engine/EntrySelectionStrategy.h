@@ -34,6 +34,12 @@ public:
     */
     virtual void initialize( const ITableau & /* tableau */ ){};
 
+    /*
+      Collect the non-basic variables that are eligible to enter the basis, to
+      be passed on to select(). By default, all eligible variables are collected.
+    */
+    virtual void getEntryCandidates( const ITableau &tableau, List<unsigned> &candidates );
+
     /*
       Choose the entrying variable for the given tableau. Do not pick
       a variable from the excluded set.
@@ -61,7 +67,7 @@ public:
     /*
       For reporting statistics
     */
-    void setStatistics( Statistics *statistics );
+    virtual void setStatistics( Statistics *statistics );
 
 protected:
     /*
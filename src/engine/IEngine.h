@@ -35,6 +35,7 @@ class PiecewiseLinearCaseSplit;
 class PLCLemma;
 class SmtState;
 class String;
+class Tightening;
 class PiecewiseLinearConstraint;
 class UnsatCertificateNode;
 
@@ -65,6 +66,25 @@ public:
     virtual void applySnCSplit( PiecewiseLinearCaseSplit split, String queryId ) = 0;
     virtual bool inSnCMode() const = 0;
 
+    /*
+      Store the bound tightenings of the case splits that hold at the root of the search tree
+      (below the SnC split, if any). They hold in every solution of the current (sub)query.
+    */
+    virtual void getRootLevelTightenings( List<Tightening> &tightenings ) const = 0;
+
+    /*
+      Apply bound tightenings that are known to hold in the current (sub)query, e.g. learned by
+      another DnC worker on an ancestor subquery. Returns the number of tightenings that improved
+      the current bounds, and stores the number of constraints whose phase they fixed.
+    */
+    virtual unsigned importTightenings( const List<Tightening> &tightenings,
+                                        unsigned &numFixedConstraints ) = 0;
+
+    /*
+      The number of simplex pivots performed since the last reset
+    */
+    virtual unsigned long long getNumberOfPivots() const = 0;
+
     /*
       Hooks invoked before/after context push/pop to store/restore/update context independent data.
     */
@@ -115,6 +135,12 @@ public:
       Pick the piecewise linear constraint for SnC splitting
     */
     virtual PiecewiseLinearConstraint *pickSplitPLConstraintSnC( SnCDivideStrategy strategy ) = 0;
+
+    /*
+      Returns true if the given constraint, picked for splitting, was created for this split only,
+      e.g. the disjunction of an input split, and is deleted when the next constraint is picked.
+    */
+    virtual bool isTemporaryConstraint( const PiecewiseLinearConstraint *constraint ) const = 0;
     /*
       Return the value of a variable bound, as expressed by the bounds explainer and the initial
       bounds
@@ -137,6 +163,12 @@ public:
 
     virtual bool consistentBounds() const = 0;
 
+    /*
+      Returns true if bound propagation, starting from the bounds at the root of the search tree,
+      proves that the given case splits cannot all hold together. A false answer is inconclusive.
+    */
+    virtual bool caseSplitsRefutedAtRoot( const List<PiecewiseLinearCaseSplit> &splits ) = 0;
+
     /*
       Returns true iff the engine is in proof production mode
     */
@@ -31,6 +31,12 @@ public:
     */
     virtual void setDimensions() = 0;
 
+    /*
+      Schedule all rows of the constraint matrix, e.g. after the bounds were
+      restored to those of another search state.
+    */
+    virtual void scheduleAllRows() = 0;
+
     /*
       Derive and enqueue new bounds for all varaibles, using the
       inverse of the explicit basis matrix, inv(B0), which should be available
@@ -56,6 +62,12 @@ public:
     */
     virtual void examineConstraintMatrix( bool untilSaturation ) = 0;
 
+    /*
+      Callback from the bound manager, invoked whenever the bound of a
+      variable is tightened.
+    */
+    virtual void notifyBoundTightened( unsigned variable ) = 0;
+
     /*
       Derive and enqueue new bounds immedaitely following a pivot
       operation in the given tableau. The tightening is performed for
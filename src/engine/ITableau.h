@@ -29,6 +29,7 @@ class IBoundManager;
 class ICostFunctionManager;
 class PiecewiseLinearCaseSplit;
 class SparseMatrix;
+class SparseUnsortedArrays;
 class SparseUnsortedList;
 class SparseVector;
 class Statistics;
@@ -100,6 +101,7 @@ public:
 
     virtual void setDimensions( unsigned m, unsigned n ) = 0;
     virtual void setConstraintMatrix( const double *A ) = 0;
+    virtual void setConstraintMatrix( const SparseUnsortedArrays *A ) = 0;
     virtual void setRightHandSide( const double *b ) = 0;
     virtual void setRightHandSide( unsigned index, double value ) = 0;
     virtual void markAsBasic( unsigned variable ) = 0;
@@ -132,6 +134,8 @@ public:
     virtual unsigned getEnteringVariableIndex() const = 0;
     virtual void pickLeavingVariable() = 0;
     virtual void pickLeavingVariable( double *d ) = 0;
+    virtual bool pickDualLeavingVariable() = 0;
+    virtual bool pickDualEnteringVariable() = 0;
     virtual unsigned getLeavingVariable() const = 0;
     virtual unsigned getLeavingVariableIndex() const = 0;
     virtual double getChangeRatio() const = 0;
@@ -163,7 +167,7 @@ public:
     virtual unsigned getM() const = 0;
     virtual unsigned getN() const = 0;
     virtual void getTableauRow( unsigned index, TableauRow *row ) = 0;
-    virtual const double *getAColumn( unsigned variable ) const = 0;
+    virtual void getAColumn( unsigned variable, double *result ) const = 0;
     virtual void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const = 0;
     virtual void getSparseARow( unsigned row, SparseUnsortedList *result ) const = 0;
     virtual const SparseUnsortedList *getSparseAColumn( unsigned variable ) const = 0;
@@ -188,6 +192,7 @@ public:
     virtual bool basisMatrixAvailable() const = 0;
     virtual double *getInverseBasisMatrix() const = 0;
     virtual void refreshBasisFactorization() = 0;
+    virtual void notifyDegradation( double degradation ) = 0;
     virtual void mergeColumns( unsigned x1, unsigned x2 ) = 0;
     virtual bool areLinearlyDependent( unsigned x1,
                                        unsigned x2,
@@ -586,6 +586,8 @@ void LeakyReluConstraint::dump( String &output ) const
 
 void LeakyReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    stateChanged();
+
     // Variable reindexing can only occur in preprocessing before Gurobi is
     // registered.
     ASSERT( _gurobi == NULL );
@@ -619,6 +621,8 @@ void LeakyReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIn
 void LeakyReluConstraint::eliminateVariable( __attribute__( ( unused ) ) unsigned variable,
                                              __attribute__( ( unused ) ) double fixedValue )
 {
+    stateChanged();
+
     ASSERT( participatingVariable( variable ) );
     DEBUG( {
         if ( variable == _f || variable == _b )
@@ -770,6 +774,8 @@ String LeakyReluConstraint::phaseToString( PhaseStatus phase )
 
 void LeakyReluConstraint::transformToUseAuxVariables( Query &inputQuery )
 {
+    stateChanged();
+
     /*
       We want to add the equations
 
@@ -959,6 +965,8 @@ const List<unsigned> LeakyReluConstraint::getNativeAuxVars() const
 
 void LeakyReluConstraint::addTableauAuxVar( unsigned tableauAuxVar, unsigned constraintAuxVar )
 {
+    stateChanged();
+
     ASSERT( constraintAuxVar == _inactiveAux || constraintAuxVar == _activeAux );
     if ( _tableauAuxVars.size() == 2 )
         return;
@@ -56,6 +56,12 @@ public:
 
         INPUT_QUERY_VARIABLE_BOUND_ALREADY_SET = 31,
 
+        // Error codes for distributed and checkpointed DnC
+        DNC_CONNECTION_FAILED = 32,
+        DNC_MALFORMED_MESSAGE = 33,
+        DNC_WORKER_PROCESS_FAILED = 34,
+        DNC_CHECKPOINT_FAILED = 35,
+
         // Error codes for Query Loader
         FILE_DOES_NOT_EXIST = 100,
         INVALID_EQUATION_TYPE = 101,
@@ -78,6 +78,14 @@ int marabouMain( int argc, char **argv )
             return 0;
         };
 
+        // The distributed solving modes and checkpoints are built on top of SnC
+        if ( options->getInt( Options::NUM_DNC_PROCESSES ) > 0 ||
+             options->getString( Options::DNC_LISTEN_ADDRESS ).length() > 0 ||
+             options->getString( Options::DNC_CONNECT_ADDRESS ).length() > 0 ||
+             options->getString( Options::DNC_CHECKPOINT_FILE ).length() > 0 ||
+             options->getBool( Options::DNC_RESUME ) )
+            options->setBool( Options::DNC_MODE, true );
+
         if ( options->getBool( Options::PRODUCE_PROOFS ) )
         {
             GlobalConfiguration::USE_DEEPSOI_LOCAL_SEARCH = false;
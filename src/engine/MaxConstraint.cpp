@@ -165,6 +165,7 @@ void MaxConstraint::notifyLowerBound( unsigned variable, double value )
         // cases when the new lowerBound is greater than the _maxLowerBound.
         if ( FloatUtils::gt( value, _maxLowerBound ) )
         {
+            stateChanged();
             _maxLowerBound = value;
             List<unsigned> toRemove;
             for ( auto element : _elements )
@@ -235,6 +236,7 @@ void MaxConstraint::notifyUpperBound( unsigned variable, double value )
             toRemove.erase( currentElement );
             for ( const auto &element : toRemove )
                 eliminateCase( element );
+            stateChanged();
             _haveFeasibleEliminatedPhases = false;
         }
     }
@@ -462,6 +464,8 @@ PiecewiseLinearCaseSplit MaxConstraint::getCaseSplit( PhaseStatus phase ) const
 
 void MaxConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    stateChanged();
+
     // Variable re-indexing can only occur in preprocessing before Gurobi is
     // registered.
     ASSERT( _gurobi == NULL );
@@ -501,6 +505,8 @@ bool MaxConstraint::constraintObsolete() const
 
 void MaxConstraint::eliminateVariable( unsigned var, double value )
 {
+    stateChanged();
+
     if ( var == _f )
     {
         _obsolete = true;
@@ -542,6 +548,8 @@ void MaxConstraint::eliminateVariable( unsigned var, double value )
 
 void MaxConstraint::transformToUseAuxVariables( Query &inputQuery )
 {
+    stateChanged();
+
     if ( _auxToElement.size() > 0 )
         return;
 
@@ -660,6 +668,7 @@ void MaxConstraint::eliminateCase( unsigned variable )
     }
     else
     {
+        stateChanged();
         _elements.erase( variable );
         _eliminatedElements.insert( variable );
 
@@ -734,6 +743,8 @@ const List<unsigned> MaxConstraint::getNativeAuxVars() const
 
 void MaxConstraint::addTableauAuxVar( unsigned tableauAuxVar, unsigned constraintAuxVar )
 {
+    stateChanged();
+
     unsigned element = _auxToElement[constraintAuxVar];
     _elementToTableauAux[element] = tableauAuxVar;
     _elementToTighteningRow[element] = nullptr;
@@ -0,0 +1,161 @@
+/*********************                                                        */
+/*! \file PartialPricingRule.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "PartialPricingRule.h"
+
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "Statistics.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+PartialPricingRule::PartialPricingRule()
+    : _strategy( NULL )
+    , _poolSize( 0 )
+    , _poolIsComplete( false )
+    , _iterationsSinceRefresh( 0 )
+{
+}
+
+void PartialPricingRule::setUnderlyingStrategy( EntrySelectionStrategy *strategy )
+{
+    _strategy = strategy;
+}
+
+void PartialPricingRule::setPoolSize( unsigned poolSize )
+{
+    _poolSize = poolSize;
+}
+
+void PartialPricingRule::setStatistics( Statistics *statistics )
+{
+    EntrySelectionStrategy::setStatistics( statistics );
+    if ( _strategy )
+        _strategy->setStatistics( statistics );
+}
+
+void PartialPricingRule::initialize( const ITableau &tableau )
+{
+    ASSERT( _strategy );
+    _strategy->initialize( tableau );
+    _pool.clear();
+}
+
+void PartialPricingRule::refreshPool( const ITableau &tableau )
+{
+    tableau.getEntryCandidates( _allCandidates );
+    _iterationsSinceRefresh = 0;
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::PARTIAL_PRICING_NUM_POOL_REFRESHES );
+
+    if ( _allCandidates.size() <= _poolSize )
+    {
+        _pool = _allCandidates;
+        _poolIsComplete = true;
+        return;
+    }
+
+    // Keep the candidates with the largest reduced costs, in index order
+    const double *costFunction = tableau.getCostFunction();
+    std::vector<std::pair<double, unsigned>> scores;
+    scores.reserve( _allCandidates.size() );
+    for ( const auto &candidate : _allCandidates )
+        scores.push_back(
+            std::make_pair( -FloatUtils::abs( costFunction[candidate] ), candidate ) );
+
+    std::nth_element( scores.begin(), scores.begin() + _poolSize, scores.end() );
+
+    std::vector<unsigned> best;
+    best.reserve( _poolSize );
+    for ( unsigned i = 0; i < _poolSize; ++i )
+        best.push_back( scores[i].second );
+    std::sort( best.begin(), best.end() );
+
+    _pool.clear();
+    for ( const auto &candidate : best )
+        _pool.append( candidate );
+    _poolIsComplete = false;
+}
+
+void PartialPricingRule::getEntryCandidates( const ITableau &tableau, List<unsigned> &candidates )
+{
+    if ( _iterationsSinceRefresh >= GlobalConfiguration::PARTIAL_PRICING_ITERATIONS_BEFORE_REFRESH )
+        _pool.clear();
+
+    _poolIsComplete = false;
+
+    // Reduced costs change with every pivot, so candidates may have become ineligible
+    const double *costFunction = tableau.getCostFunction();
+    List<unsigned>::iterator it = _pool.begin();
+    while ( it != _pool.end() )
+    {
+        if ( !tableau.eligibleForEntry( *it, costFunction ) )
+            it = _pool.erase( it );
+        else
+            ++it;
+    }
+
+    if ( _pool.empty() )
+        refreshPool( tableau );
+
+    candidates = _pool;
+}
+
+bool PartialPricingRule::select( ITableau &tableau,
+                                 const List<unsigned> &candidates,
+                                 const Set<unsigned> &excluded )
+{
+    ASSERT( _strategy );
+    if ( _strategy->select( tableau, candidates, excluded ) )
+        return true;
+
+    if ( _poolIsComplete )
+        return false;
+
+    // The pool is exhausted: price all eligible variables, and rebuild the pool next time
+    tableau.getEntryCandidates( _allCandidates );
+    _pool.clear();
+    return _strategy->select( tableau, _allCandidates, excluded );
+}
+
+void PartialPricingRule::prePivotHook( const ITableau &tableau, bool fakePivot )
+{
+    _strategy->prePivotHook( tableau, fakePivot );
+}
+
+void PartialPricingRule::postPivotHook( const ITableau &tableau, bool fakePivot )
+{
+    _strategy->postPivotHook( tableau, fakePivot );
+    ++_iterationsSinceRefresh;
+}
+
+void PartialPricingRule::resizeHook( const ITableau &tableau )
+{
+    _strategy->resizeHook( tableau );
+    _pool.clear();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,100 @@
+/*********************                                                        */
+/*! \file PartialPricingRule.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __PartialPricingRule_h__
+#define __PartialPricingRule_h__
+
+#include "EntrySelectionStrategy.h"
+
+/*
+  Partial (multiple) pricing. Instead of scanning all the non-basic
+  variables for entering candidates on every iteration, keep a small pool
+  of the most promising candidates, and only rescan every few iterations
+  or when the pool runs dry. The actual choice among the candidates, as
+  well as the pivot hooks, are delegated to an underlying strategy.
+*/
+class PartialPricingRule : public EntrySelectionStrategy
+{
+public:
+    PartialPricingRule();
+
+    /*
+      Set the strategy that picks the entering variable among the pool
+      candidates, and the size of the pool.
+    */
+    void setUnderlyingStrategy( EntrySelectionStrategy *strategy );
+    void setPoolSize( unsigned poolSize );
+
+    void initialize( const ITableau &tableau );
+
+    /*
+      Return the current pool, after discarding candidates that are no
+      longer eligible. The pool is rebuilt from all eligible variables
+      when it is due for a refresh or when it becomes empty.
+    */
+    void getEntryCandidates( const ITableau &tableau, List<unsigned> &candidates );
+
+    /*
+      Let the underlying strategy pick from the given candidates. If it
+      fails, fall back to all eligible variables, so that the simplex only
+      stops when no eligible variable remains.
+    */
+    bool
+    select( ITableau &tableau, const List<unsigned> &candidates, const Set<unsigned> &excluded );
+
+    void prePivotHook( const ITableau &tableau, bool fakePivot );
+    void postPivotHook( const ITableau &tableau, bool fakePivot );
+    void resizeHook( const ITableau &tableau );
+
+    void setStatistics( Statistics *statistics );
+
+private:
+    EntrySelectionStrategy *_strategy;
+    unsigned _poolSize;
+
+    /*
+      Whether the candidates last returned by getEntryCandidates() were all
+      the eligible variables, in which case there is nothing to fall back to.
+    */
+    bool _poolIsComplete;
+
+    /*
+      The candidate pool, and the number of iterations since it was last
+      rebuilt.
+    */
+    List<unsigned> _pool;
+    unsigned _iterationsSinceRefresh;
+
+    /*
+      Work space for full pricing passes.
+    */
+    List<unsigned> _allCandidates;
+
+    /*
+      Rebuild the pool from all eligible variables, keeping those with the
+      largest reduced costs.
+    */
+    void refreshPool( const ITableau &tableau );
+};
+
+#endif // __PartialPricingRule_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
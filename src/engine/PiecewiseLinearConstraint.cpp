@@ -17,6 +17,8 @@
 
 #include "Statistics.h"
 
+std::atomic<unsigned long long> PiecewiseLinearConstraint::_nextStateVersion( 1 );
+
 PiecewiseLinearConstraint::PiecewiseLinearConstraint()
     : _numCases( 0 )
     , _constraintActive( true )
@@ -31,6 +33,7 @@ PiecewiseLinearConstraint::PiecewiseLinearConstraint()
     , _statistics( NULL )
     , _gurobi( NULL )
     , _tableauAuxVars()
+    , _stateVersion( _nextStateVersion++ )
 {
 }
 
@@ -47,6 +50,7 @@ PiecewiseLinearConstraint::PiecewiseLinearConstraint( unsigned numCases )
     , _score( FloatUtils::negativeInfinity() )
     , _statistics( NULL )
     , _gurobi( NULL )
+    , _stateVersion( _nextStateVersion++ )
 {
 }
 
@@ -55,7 +59,10 @@ void PiecewiseLinearConstraint::setActiveConstraint( bool active )
     if ( _cdConstraintActive != nullptr )
         *_cdConstraintActive = active;
     else
+    {
         _constraintActive = active;
+        stateChanged();
+    }
 }
 
 bool PiecewiseLinearConstraint::isActive() const
@@ -70,6 +77,7 @@ void PiecewiseLinearConstraint::registerBoundManager( IBoundManager *boundManage
 {
     ASSERT( _boundManager == nullptr );
     _boundManager = boundManager;
+    stateChanged();
 }
 
 void PiecewiseLinearConstraint::initializeCDOs( CVC4::context::Context *context )
@@ -104,6 +112,13 @@ void PiecewiseLinearConstraint::initializeCDPhaseStatus()
 }
 
 void PiecewiseLinearConstraint::cdoCleanup()
+{
+    cdoCleanupOfState();
+
+    _context = nullptr;
+}
+
+void PiecewiseLinearConstraint::cdoCleanupOfState()
 {
     if ( _cdConstraintActive != nullptr )
         _cdConstraintActive->deleteSelf();
@@ -119,8 +134,6 @@ void PiecewiseLinearConstraint::cdoCleanup()
         _cdInfeasibleCases->deleteSelf();
 
     _cdInfeasibleCases = nullptr;
-
-    _context = nullptr;
 }
 
 PhaseStatus PiecewiseLinearConstraint::getPhaseStatus() const
@@ -136,7 +149,10 @@ void PiecewiseLinearConstraint::setPhaseStatus( PhaseStatus phaseStatus )
     if ( _cdPhaseStatus != nullptr )
         *_cdPhaseStatus = phaseStatus;
     else
+    {
         _phaseStatus = phaseStatus;
+        stateChanged();
+    }
 }
 
 void PiecewiseLinearConstraint::initializeDuplicateCDOs( PiecewiseLinearConstraint *clone ) const
@@ -63,6 +63,8 @@
 #include "context/cdo.h"
 #include "context/context.h"
 
+#include <atomic>
+
 class Equation;
 class BoundManager;
 class ITableau;
@@ -140,6 +142,19 @@ public:
     */
     virtual void restoreState( const PiecewiseLinearConstraint *state ) = 0;
 
+    /*
+      The version of the state of this constraint that is not
+      context-dependent, i.e. of the state that restoreState() restores. A
+      copy made by duplicateConstraint() has the version of the original, so
+      that a state need not be stored or restored again while the versions
+      agree. The heuristic scores and directions, which are recomputed from
+      the bounds before they are used, do not change the version.
+    */
+    unsigned long long getStateVersion() const
+    {
+        return _stateVersion;
+    }
+
     /*
       Register/unregister the constraint with a talbeau.
     */
@@ -387,6 +402,13 @@ public:
      */
     void cdoCleanup();
 
+    /*
+       Clean up the CDOs of a copy that only serves as a state for
+       restoreState(), which keeps the CDOs of the restored constraint. The
+       copy can then outlive the context level at which it was made.
+     */
+    void cdoCleanupOfState();
+
     /**********************************************************************/
     /*             Context-dependent Search State Interface               */
     /**********************************************************************/
@@ -597,8 +619,13 @@ protected:
      */
     inline void setLowerBound( unsigned var, double value )
     {
-        ( _boundManager != nullptr ) ? _boundManager->setLowerBound( var, value )
-                                     : _lowerBounds[var] = value;
+        if ( _boundManager != nullptr )
+            _boundManager->setLowerBound( var, value );
+        else
+        {
+            _lowerBounds[var] = value;
+            stateChanged();
+        }
     }
 
     /*
@@ -606,8 +633,13 @@ protected:
      */
     inline void setUpperBound( unsigned var, double value )
     {
-        ( _boundManager != nullptr ) ? _boundManager->setUpperBound( var, value )
-                                     : _upperBounds[var] = value;
+        if ( _boundManager != nullptr )
+            _boundManager->setUpperBound( var, value );
+        else
+        {
+            _upperBounds[var] = value;
+            stateChanged();
+        }
     }
 
     /**********************************************************************/
@@ -634,6 +666,21 @@ protected:
     }
 
     List<unsigned> _tableauAuxVars;
+
+    /*
+      Record a change to the state that is not context-dependent, by
+      drawing a new version from a global counter (so that the states of
+      distinct constraints, or of distinct branches of the search, never
+      share a version).
+    */
+    void stateChanged()
+    {
+        _stateVersion = _nextStateVersion++;
+    }
+
+private:
+    unsigned long long _stateVersion;
+    static std::atomic<unsigned long long> _nextStateVersion;
 };
 
 #endif // __PiecewiseLinearConstraint_h__
@@ -48,6 +48,20 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
     EngineState targetEngineState;
     engine.storeState( targetEngineState, TableauStateStorageLevel::STORE_NONE );
 
+    // The status of the constraints is context-dependent, and is thus not in
+    // the states that the engine stores for them
+    struct ConstraintStatus
+    {
+        bool _active;
+        bool _phaseFixed;
+        bool _obsolete;
+    };
+    Map<PiecewiseLinearConstraint *, ConstraintStatus> targetStatus;
+    for ( const auto &pair : targetEngineState._plConstraintToState )
+        targetStatus[pair.first] = { pair.first->isActive(),
+                                     pair.first->phaseFixed(),
+                                     pair.first->constraintObsolete() };
+
     BoundExplainer boundExplainerBackup( targetN, targetM, engine.getContext() );
     Vector<double> groundUpperBoundsBackup;
     Vector<double> groundLowerBoundsBackup;
@@ -154,8 +168,8 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
     }
 
     // Restore constraint status
-    for ( const auto &pair : targetEngineState._plConstraintToState )
-        pair.first->setActiveConstraint( pair.second->isActive() );
+    for ( const auto &pair : targetStatus )
+        pair.first->setActiveConstraint( pair.second._active );
 
     engine.setNumPlConstraintsDisabledByValidSplits(
         targetEngineState._numPlConstraintsDisabledByValidSplits );
@@ -166,13 +180,12 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
         ASSERT( GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS || tableau.getM() == targetM );
 
         // Constraints should be in the same state before and after restoration
-        for ( const auto &pair : targetEngineState._plConstraintToState )
+        for ( const auto &pair : targetStatus )
         {
-            ASSERT( pair.second->isActive() == pair.first->isActive() );
+            ASSERT( pair.second._active == pair.first->isActive() );
             // Only active constraints need to be synchronized
-            ASSERT( !pair.second->isActive() ||
-                    pair.second->phaseFixed() == pair.first->phaseFixed() );
-            ASSERT( pair.second->constraintObsolete() == pair.first->constraintObsolete() );
+            ASSERT( !pair.second._active || pair.second._phaseFixed == pair.first->phaseFixed() );
+            ASSERT( pair.second._obsolete == pair.first->constraintObsolete() );
         }
 
         EngineState currentEngineState;
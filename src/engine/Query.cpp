@@ -32,8 +32,11 @@
     LOG( GlobalConfiguration::INPUT_QUERY_LOGGING, "Input Query: %s\n", x )
 
 Query::Query()
-    : _ensureSameSourceLayerInNLR( Options::get()->getSymbolicBoundTighteningType() ==
-                                   SymbolicBoundTighteningType::DEEP_POLY )
+    : _ensureSameSourceLayerInNLR(
+          Options::get()->getSymbolicBoundTighteningType() ==
+              SymbolicBoundTighteningType::DEEP_POLY ||
+          Options::get()->getSymbolicBoundTighteningType() ==
+              SymbolicBoundTighteningType::ALPHA_DEEP_POLY )
     , _networkLevelReasoner( NULL )
 {
 }
@@ -1028,6 +1031,31 @@ bool Query::constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
 
     nlr->addLayer( newLayerIndex, NLR::Layer::WEIGHTED_SUM, newNeurons.size() );
 
+    /*
+      Mark the layer dependencies. The weights from a source layer are
+      stored in sparse form if only a small fraction of them are non-zero,
+      as is the case for convolutions.
+    */
+    Map<unsigned, unsigned> sourceLayerToNumWeights;
+    for ( const auto &newNeuron : newNeurons )
+    {
+        for ( const auto &addend : newNeuron._eq->_addends )
+        {
+            if ( addend._variable == newNeuron._variable )
+                continue;
+
+            ++sourceLayerToNumWeights[handledVariableToLayer[addend._variable]];
+        }
+    }
+
+    for ( const auto &pair : sourceLayerToNumWeights )
+    {
+        double numEntries = (double)nlr->getLayer( pair.first )->getSize() * newNeurons.size();
+        bool sparseWeights =
+            pair.second < GlobalConfiguration::NLR_SPARSE_WEIGHTS_DENSITY_THRESHOLD * numEntries;
+        nlr->addLayerDependency( pair.first, newLayerIndex, sparseWeights );
+    }
+
     NLR::Layer *layer = nlr->getLayer( newLayerIndex );
     for ( const auto &newNeuron : newNeurons )
     {
@@ -1069,9 +1097,6 @@ bool Query::constructWeighedSumLayer( NLR::NetworkLevelReasoner *nlr,
             unsigned sourceNeuron =
                 nlr->getLayer( sourceLayer )->variableToNeuron( addend._variable );
 
-            // Mark the layer dependency
-            nlr->addLayerDependency( sourceLayer, newLayerIndex );
-
             nlr->setWeight( sourceLayer,
                             sourceNeuron,
                             newLayerIndex,
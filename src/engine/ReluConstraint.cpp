@@ -712,6 +712,8 @@ void ReluConstraint::dump( String &output ) const
 
 void ReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    stateChanged();
+
     // Variable reindexing can only occur in preprocessing before Gurobi is
     // registered.
     ASSERT( _gurobi == NULL );
@@ -743,6 +745,8 @@ void ReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 void ReluConstraint::eliminateVariable( __attribute__( ( unused ) ) unsigned variable,
                                         __attribute__( ( unused ) ) double fixedValue )
 {
+    stateChanged();
+
     ASSERT( variable == _b || variable == _f || ( _auxVarInUse && variable == _aux ) );
 
     DEBUG( {
@@ -892,6 +896,8 @@ String ReluConstraint::phaseToString( PhaseStatus phase )
 
 void ReluConstraint::transformToUseAuxVariables( Query &inputQuery )
 {
+    stateChanged();
+
     /*
       We want to add the equation
 
@@ -1083,6 +1089,8 @@ const List<unsigned> ReluConstraint::getNativeAuxVars() const
 
 void ReluConstraint::addTableauAuxVar( unsigned tableauAuxVar, unsigned constraintAuxVar )
 {
+    stateChanged();
+
     ASSERT( _tableauAuxVars.empty() );
 
     if ( constraintAuxVar == _aux )
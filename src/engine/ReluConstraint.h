@@ -70,10 +70,11 @@ public:
 
     /*
       These callbacks are invoked when a watched variable's value
-      changes, or when its bounds change.
+      changes, or when its bounds change. They are final, so that the
+      tableau can call them without virtual dispatch.
     */
-    void notifyLowerBound( unsigned variable, double bound ) override;
-    void notifyUpperBound( unsigned variable, double bound ) override;
+    void notifyLowerBound( unsigned variable, double bound ) final;
+    void notifyUpperBound( unsigned variable, double bound ) final;
 
     /*
        Check conditions that fix Phase and met update phase status
@@ -28,9 +28,17 @@ RowBoundTightener::RowBoundTightener( const ITableau &tableau )
     , _upperBounds( nullptr )
     , _rows( NULL )
     , _z( NULL )
+    , _ANColumn( NULL )
     , _ciTimesLb( NULL )
     , _ciTimesUb( NULL )
     , _ciSign( NULL )
+    , _variableIsDirty( NULL )
+    , _dirtyVariables( NULL )
+    , _numDirtyVariables( 0 )
+    , _rowIsQueued( NULL )
+    , _numRowsExamined( 0 )
+    , _numRowsSkipped( 0 )
+    , _numRowsTightened( 0 )
     , _statistics( NULL )
 {
 }
@@ -42,26 +50,38 @@ void RowBoundTightener::setDimensions()
     _n = _tableau.getN();
     _m = _tableau.getM();
 
+    // The dense rows of the inverted basis matrix tighteners, m * (n - m)
+    // entries, are only allocated once these are used (see allocateRows())
     if ( GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE ==
-         GlobalConfiguration::COMPUTE_INVERTED_BASIS_MATRIX )
+         GlobalConfiguration::USE_IMPLICIT_INVERTED_BASIS_MATRIX )
     {
-        _rows = new TableauRow *[_m];
-        for ( unsigned i = 0; i < _m; ++i )
-            _rows[i] = new TableauRow( _n - _m );
-    }
-    else if ( GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE ==
-              GlobalConfiguration::USE_IMPLICIT_INVERTED_BASIS_MATRIX )
-    {
-        _rows = new TableauRow *[_m];
-        for ( unsigned i = 0; i < _m; ++i )
-            _rows[i] = new TableauRow( _n - _m );
-
         _z = new double[_m];
+        _ANColumn = new double[_m];
     }
 
     _ciTimesLb = new double[_n];
     _ciTimesUb = new double[_n];
     _ciSign = new char[_n];
+
+    _variableIsDirty = new bool[_n];
+    _dirtyVariables = new unsigned[_n];
+    _rowIsQueued = new bool[_m];
+    scheduleAllRows();
+}
+
+void RowBoundTightener::notifyDimensionChange( unsigned /* m */, unsigned /* n */ )
+{
+    setDimensions();
+}
+
+void RowBoundTightener::allocateRows()
+{
+    if ( _rows )
+        return;
+
+    _rows = new TableauRow *[_m];
+    for ( unsigned i = 0; i < _m; ++i )
+        _rows[i] = new TableauRow( _n - _m );
 }
 
 RowBoundTightener::~RowBoundTightener()
@@ -85,6 +105,12 @@ void RowBoundTightener::freeMemoryIfNeeded()
         _z = NULL;
     }
 
+    if ( _ANColumn )
+    {
+        delete[] _ANColumn;
+        _ANColumn = NULL;
+    }
+
     if ( _ciTimesLb )
     {
         delete[] _ciTimesLb;
@@ -102,6 +128,24 @@ void RowBoundTightener::freeMemoryIfNeeded()
         delete[] _ciSign;
         _ciSign = NULL;
     }
+
+    if ( _variableIsDirty )
+    {
+        delete[] _variableIsDirty;
+        _variableIsDirty = NULL;
+    }
+
+    if ( _dirtyVariables )
+    {
+        delete[] _dirtyVariables;
+        _dirtyVariables = NULL;
+    }
+
+    if ( _rowIsQueued )
+    {
+        delete[] _rowIsQueued;
+        _rowIsQueued = NULL;
+    }
 }
 
 void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation )
@@ -112,6 +156,8 @@ void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation
          xB = inv(B)*b - inv(B)*An
     */
 
+    allocateRows();
+
     // Find z = inv(B) * b, by solving the forward transformation Bz = b
     _tableau.forwardTransformation( _tableau.getRightHandSide(), _z );
     for ( unsigned i = 0; i < _m; ++i )
@@ -125,8 +171,8 @@ void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation
     for ( unsigned i = 0; i < _n - _m; ++i )
     {
         unsigned nonBasic = _tableau.nonBasicIndexToVariable( i );
-        const double *ANColumn = _tableau.getAColumn( nonBasic );
-        _tableau.forwardTransformation( ANColumn, _z );
+        _tableau.getAColumn( nonBasic, _ANColumn );
+        _tableau.forwardTransformation( _ANColumn, _z );
 
         for ( unsigned j = 0; j < _m; ++j )
         {
@@ -164,6 +210,8 @@ void RowBoundTightener::examineInvertedBasisMatrix( bool untilSaturation )
       We compute one row at a time.
     */
 
+    allocateRows();
+
     const double *b = _tableau.getRightHandSide();
     const double *invB = _tableau.getInverseBasisMatrix();
 
@@ -402,6 +450,36 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 }
 
 void RowBoundTightener::examineConstraintMatrix( bool untilSaturation )
+{
+    _numRowsExamined = 0;
+    _numRowsSkipped = 0;
+    _numRowsTightened = 0;
+
+    if ( GlobalConfiguration::ROW_BOUND_TIGHTENER_USE_WORKLIST )
+    {
+        unsigned newBoundsLearned = examineScheduledRows( untilSaturation );
+
+        if ( _statistics && ( newBoundsLearned > 0 ) )
+            _statistics->incLongAttribute( Statistics::NUM_TIGHTENINGS_FROM_CONSTRAINT_MATRIX,
+                                           newBoundsLearned );
+    }
+    else
+    {
+        examineEntireConstraintMatrix( untilSaturation );
+    }
+
+    if ( _statistics )
+    {
+        _statistics->incLongAttribute( Statistics::NUM_ROWS_EXAMINED_ON_CONSTRAINT_MATRIX,
+                                       _numRowsExamined );
+        _statistics->incLongAttribute( Statistics::NUM_ROWS_SKIPPED_ON_CONSTRAINT_MATRIX,
+                                       _numRowsSkipped );
+        _statistics->incLongAttribute( Statistics::NUM_ROWS_TIGHTENED_ON_CONSTRAINT_MATRIX,
+                                       _numRowsTightened );
+    }
+}
+
+void RowBoundTightener::examineEntireConstraintMatrix( bool untilSaturation )
 {
     unsigned newBoundsLearned;
 
@@ -436,52 +514,93 @@ unsigned RowBoundTightener::onePassOverConstraintMatrix()
     return result;
 }
 
-unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
+unsigned RowBoundTightener::examineScheduledRows( bool untilSaturation )
 {
-    /*
-      The cosntraint matrix A satisfies Ax = b.
-      Each row is of the form:
-
-          sum ci xi - b = 0
+    scheduleRowsOfDirtyVariables();
 
-      We first compute the lower and upper bounds for the expression
-
-          sum ci xi - b
-   */
-    unsigned n = _tableau.getN();
+    // Without saturation, only the rows that are currently scheduled are examined
+    unsigned rowsToExamine = untilSaturation
+                               ? GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS * _m
+                               : _rowQueue.size();
 
     unsigned result = 0;
+    while ( rowsToExamine > 0 && !_rowQueue.empty() )
+    {
+        unsigned row = _rowQueue.peak();
+        _rowQueue.pop();
+        _rowIsQueued[row] = false;
+        --rowsToExamine;
 
-    const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
-    const double *b = _tableau.getRightHandSide();
+        result += tightenOnSingleConstraintRow( row );
 
-    double ci;
-    unsigned index;
+        if ( untilSaturation )
+            scheduleRowsOfDirtyVariables();
+    }
 
-    // Compute ci * lb, ci * ub, flag signs for all entries
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-    };
+    return result;
+}
 
-    std::fill_n( _ciSign, n, ZERO );
-    std::fill_n( _ciTimesLb, n, 0 );
-    std::fill_n( _ciTimesUb, n, 0 );
+void RowBoundTightener::notifyBoundTightened( unsigned variable )
+{
+    if ( !_variableIsDirty || variable >= _n || _variableIsDirty[variable] )
+        return;
 
-    for ( const auto &entry : *sparseRow )
+    _variableIsDirty[variable] = true;
+    _dirtyVariables[_numDirtyVariables++] = variable;
+}
+
+void RowBoundTightener::scheduleRowsOfDirtyVariables()
+{
+    for ( unsigned i = 0; i < _numDirtyVariables; ++i )
     {
-        index = entry._index;
-        ci = entry._value;
+        unsigned variable = _dirtyVariables[i];
+        _variableIsDirty[variable] = false;
+
+        for ( const auto &entry : *_tableau.getSparseAColumn( variable ) )
+        {
+            if ( !_rowIsQueued[entry._index] )
+            {
+                _rowIsQueued[entry._index] = true;
+                _rowQueue.push( entry._index );
+            }
+        }
+    }
 
-        _ciSign[index] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
-        _ciTimesLb[index] = ci * getLowerBound( index );
-        _ciTimesUb[index] = ci * getUpperBound( index );
+    _numDirtyVariables = 0;
+}
+
+void RowBoundTightener::scheduleAllRows()
+{
+    std::fill_n( _variableIsDirty, _n, false );
+    _numDirtyVariables = 0;
+
+    _rowQueue.clear();
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        _rowIsQueued[i] = true;
+        _rowQueue.push( i );
     }
+}
+
+unsigned RowBoundTightener::getNumRowsExaminedInLastCall() const
+{
+    return _numRowsExamined;
+}
 
+unsigned RowBoundTightener::getNumRowsTightenedInLastCall() const
+{
+    return _numRowsTightened;
+}
+
+unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
+{
     /*
-      Do a pass for each of the rhs variables.
-      For this, we wish to logically transform the equation into:
+      The cosntraint matrix A satisfies Ax = b.
+      Each row is of the form:
+
+          sum ci xi - b = 0
+
+      We wish to logically transform the equation into:
 
           xi = 1/ci * ( b - sum cj xj )
 
@@ -493,25 +612,51 @@ unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
               b - sum ci xi
 
       Then, when we consider xi we adjust the computed lower and upper
-      bounds accordingly.
-    */
+      bounds accordingly. Infinite terms are counted rather than summed,
+      so that a bound of the expression that is infinite only because of
+      xi itself can still be used for xi.
+   */
+    ++_numRowsExamined;
+
+    unsigned result = 0;
+
+    const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
+    const double *b = _tableau.getRightHandSide();
 
     double auxLb = b[row];
     double auxUb = b[row];
+    unsigned numInfiniteLb = 0;
+    unsigned numInfiniteUb = 0;
 
-    // Now add ALL xi's
-    for ( unsigned i = 0; i < n; ++i )
+    double ci;
+    unsigned index;
+
+    for ( const auto &entry : *sparseRow )
     {
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            auxLb -= _ciTimesLb[i];
-            auxUb -= _ciTimesUb[i];
-        }
+        index = entry._index;
+        ci = entry._value;
+
+        // The bounds of xi that contribute to the lower and upper bounds of the expression
+        bool positive = FloatUtils::isPositive( ci );
+        double forLb = positive ? getUpperBound( index ) : getLowerBound( index );
+        double forUb = positive ? getLowerBound( index ) : getUpperBound( index );
+
+        if ( FloatUtils::isFinite( forLb ) )
+            auxLb -= ci * forLb;
         else
-        {
-            auxLb -= _ciTimesUb[i];
-            auxUb -= _ciTimesLb[i];
-        }
+            ++numInfiniteLb;
+
+        if ( FloatUtils::isFinite( forUb ) )
+            auxUb -= ci * forUb;
+        else
+            ++numInfiniteUb;
+    }
+
+    // If both bounds of the expression are infinite for every xi, nothing can be learned
+    if ( numInfiniteLb > 1 && numInfiniteUb > 1 )
+    {
+        ++_numRowsSkipped;
+        return 0;
     }
 
     double lowerBound;
@@ -521,45 +666,65 @@ unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
     for ( const auto &entry : *sparseRow )
     {
         index = entry._index;
+        ci = entry._value;
 
-        lowerBound = auxLb;
-        upperBound = auxUb;
+        if ( FloatUtils::lt( abs( ci ), GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING ) )
+            continue;
 
         // Adjust the aux bounds to remove xi
-        if ( _ciSign[index] == NEGATIVE )
+        bool positive = FloatUtils::isPositive( ci );
+        double forLb = positive ? getUpperBound( index ) : getLowerBound( index );
+        double forUb = positive ? getLowerBound( index ) : getUpperBound( index );
+
+        bool hasLb;
+        if ( FloatUtils::isFinite( forLb ) )
         {
-            lowerBound += _ciTimesLb[index];
-            upperBound += _ciTimesUb[index];
+            hasLb = ( numInfiniteLb == 0 );
+            lowerBound = auxLb + ci * forLb;
         }
         else
         {
-            lowerBound += _ciTimesUb[index];
-            upperBound += _ciTimesLb[index];
+            hasLb = ( numInfiniteLb == 1 );
+            lowerBound = auxLb;
         }
 
-        // Now divide everything by ci, switching signs if needed.
-        ci = entry._value;
-        if ( FloatUtils::lt( abs( ci ), GlobalConfiguration::MINIMAL_COEFFICIENT_FOR_TIGHTENING ) )
-            continue;
-
-        lowerBound = lowerBound / ci;
-        upperBound = upperBound / ci;
+        bool hasUb;
+        if ( FloatUtils::isFinite( forUb ) )
+        {
+            hasUb = ( numInfiniteUb == 0 );
+            upperBound = auxUb + ci * forUb;
+        }
+        else
+        {
+            hasUb = ( numInfiniteUb == 1 );
+            upperBound = auxUb;
+        }
 
-        if ( _ciSign[index] == NEGATIVE )
+        // Now divide everything by ci, switching signs if needed.
+        if ( !positive )
         {
             double temp = upperBound;
             upperBound = lowerBound;
             lowerBound = temp;
+
+            bool tempHas = hasUb;
+            hasUb = hasLb;
+            hasLb = tempHas;
         }
 
         // If a tighter bound is found, store it
-        result += registerTighterLowerBound( index, lowerBound, *sparseRow );
-        result += registerTighterUpperBound( index, upperBound, *sparseRow );
+        if ( hasLb )
+            result += registerTighterLowerBound( index, lowerBound / ci, *sparseRow );
+        if ( hasUb )
+            result += registerTighterUpperBound( index, upperBound / ci, *sparseRow );
 
         if ( FloatUtils::gt( getLowerBound( index ), getUpperBound( index ) ) )
             throw InfeasibleQueryException();
     }
 
+    if ( result > 0 )
+        ++_numRowsTightened;
+
     return result;
 }
 
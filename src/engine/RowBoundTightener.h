@@ -35,6 +35,11 @@ public:
     */
     void setDimensions();
 
+    /*
+      Schedule all rows of the constraint matrix.
+    */
+    void scheduleAllRows();
+
     /*
        Method obtains lower bound of *var*.
      */
@@ -130,9 +135,32 @@ public:
       original constraint matrix A and right hands side vector b. Can
       also do this until saturation, meaning that we continue until no
       new bounds are learned.
+
+      If ROW_BOUND_TIGHTENER_USE_WORKLIST is set, only the rows that
+      contain variables whose bounds were tightened since the rows were
+      last examined are considered.
     */
     void examineConstraintMatrix( bool untilSaturation );
 
+    /*
+      Schedule the rows of the constraint matrix in which the variable
+      appears for examination.
+    */
+    void notifyBoundTightened( unsigned variable );
+
+    /*
+      The tableau has been resized: reallocate the work memory, and
+      schedule all rows for examination.
+    */
+    void notifyDimensionChange( unsigned m, unsigned n );
+
+    /*
+      The number of rows examined, and the number of rows that yielded
+      tighter bounds, during the last call to examineConstraintMatrix().
+    */
+    unsigned getNumRowsExaminedInLastCall() const;
+    unsigned getNumRowsTightenedInLastCall() const;
+
     /*
       Derive and enqueue new bounds immedaitely following a pivot
       operation in the given tableau. The tightening is performed for
@@ -177,10 +205,29 @@ private:
     */
     TableauRow **_rows;
     double *_z;
+    double *_ANColumn;
     double *_ciTimesLb;
     double *_ciTimesUb;
     char *_ciSign;
 
+    /*
+      The worklist for tightening on the constraint matrix: variables
+      whose bounds were tightened since their rows were last scheduled,
+      and the queue of scheduled rows.
+    */
+    bool *_variableIsDirty;
+    unsigned *_dirtyVariables;
+    unsigned _numDirtyVariables;
+    bool *_rowIsQueued;
+    Queue<unsigned> _rowQueue;
+
+    /*
+      Counters for the last call to examineConstraintMatrix()
+    */
+    unsigned _numRowsExamined;
+    unsigned _numRowsSkipped;
+    unsigned _numRowsTightened;
+
     /*
       Statistics collection
     */
@@ -191,6 +238,12 @@ private:
     */
     void freeMemoryIfNeeded();
 
+    /*
+      Allocate the rows of the inverted basis matrix tighteners, if not
+      allocated since the last call to setDimensions()
+    */
+    void allocateRows();
+
     /*
       Do a single pass over the constraint matrix and derive any
       tighter bounds. Return the number of new bounds learned.
@@ -198,9 +251,29 @@ private:
     unsigned onePassOverConstraintMatrix();
 
     /*
-      Process the tableau row and attempt to derive tighter
-      lower/upper bounds for the specified variable. Return the number of
-      tighter bounds found.
+      Sweep over all rows of the constraint matrix, possibly until
+      saturation.
+    */
+    void examineEntireConstraintMatrix( bool untilSaturation );
+
+    /*
+      Examine the scheduled rows of the constraint matrix. Rows that
+      become scheduled during the pass are also examined if working until
+      saturation, up to a total equivalent to
+      ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS passes over the matrix.
+      Return the number of new bounds learned.
+    */
+    unsigned examineScheduledRows( bool untilSaturation );
+
+    /*
+      Move the rows of all dirty variables into the row queue.
+    */
+    void scheduleRowsOfDirtyVariables();
+
+    /*
+      Process the constraint matrix row and attempt to derive tighter
+      lower/upper bounds for its variables. Return the number of tighter
+      bounds found.
      */
     unsigned tightenOnSingleConstraintRow( unsigned row );
 
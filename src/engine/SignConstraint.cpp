@@ -532,6 +532,8 @@ void SignConstraint::getEntailedTightenings( List<Tightening> &tightenings ) con
 
 void SignConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 {
+    stateChanged();
+
     // Variable reindexing can only occur in preprocessing before Gurobi is
     // registered.
     ASSERT( _gurobi == NULL );
@@ -562,6 +564,8 @@ void SignConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
 void SignConstraint::eliminateVariable( __attribute__( ( unused ) ) unsigned variable,
                                         __attribute__( ( unused ) ) double fixedValue )
 {
+    stateChanged();
+
     ASSERT( variable == _b || variable == _f );
 
     DEBUG( {
@@ -0,0 +1,815 @@
+/*********************                                                        */
+/*! \file SimplexSolver.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "SimplexSolver.h"
+
+#include "BasisFactorizationFactory.h"
+#include "Debug.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "MalformedBasisException.h"
+#include "MarabouError.h"
+#include "SparseColumnsOfBasis.h"
+#include "SparseUnsortedList.h"
+#include "TimeUtils.h"
+
+SimplexSolver::SimplexSolver()
+    : _m( 0 )
+    , _costConstant( 0 )
+    , _maximize( false )
+    , _cutoffInUse( false )
+    , _cutoffValue( 0 )
+    , _basisFactorization( NULL )
+    , _factorizationSize( 0 )
+    , _status( UNSOLVED )
+    , _optimalValue( 0 )
+    , _objectiveBound( 0 )
+    , _numIterations( 0 )
+    , _timeLimit( FloatUtils::infinity() )
+{
+}
+
+SimplexSolver::~SimplexSolver()
+{
+    freeMemoryIfNeeded();
+}
+
+void SimplexSolver::freeMemoryIfNeeded()
+{
+    for ( auto &column : _columns )
+        delete column;
+    _columns.clear();
+
+    if ( _basisFactorization )
+    {
+        delete _basisFactorization;
+        _basisFactorization = NULL;
+    }
+    _factorizationSize = 0;
+}
+
+void SimplexSolver::resetModel()
+{
+    freeMemoryIfNeeded();
+
+    _nameToVariable.clear();
+    _rowToSlack.clear();
+    _lowerBounds.clear();
+    _upperBounds.clear();
+    _m = 0;
+
+    _costs.clear();
+    _costConstant = 0;
+    _maximize = false;
+
+    _basicIndexToVariable.clear();
+    _variableToBasicIndex.clear();
+    _assignment.clear();
+
+    reset();
+}
+
+void SimplexSolver::reset()
+{
+    _status = UNSOLVED;
+    _optimalValue = 0;
+    _objectiveBound = 0;
+    _numIterations = 0;
+}
+
+unsigned SimplexSolver::addVariable( double lb, double ub )
+{
+    unsigned variable = _lowerBounds.size();
+
+    _lowerBounds.append( lb );
+    _upperBounds.append( ub );
+    _columns.append( new SparseUnsortedList( _m ) );
+    _costs.append( 0 );
+    _variableToBasicIndex.append( 0 );
+    _assignment.append( 0 );
+
+    return variable;
+}
+
+void SimplexSolver::addVariable( String name, double lb, double ub )
+{
+    if ( _nameToVariable.exists( name ) )
+    {
+        unsigned variable = _nameToVariable[name];
+        if ( lb > _lowerBounds[variable] )
+            setLowerBound( name, lb );
+        if ( ub < _upperBounds[variable] )
+            setUpperBound( name, ub );
+        return;
+    }
+
+    unsigned variable = addVariable( lb, ub );
+    _nameToVariable[name] = variable;
+    setToNearestBound( variable );
+}
+
+bool SimplexSolver::containsVariable( String name ) const
+{
+    return _nameToVariable.exists( name );
+}
+
+unsigned SimplexSolver::getVariable( const String &name ) const
+{
+    if ( !_nameToVariable.exists( name ) )
+        throw MarabouError( MarabouError::VARIABLE_INDEX_OUT_OF_RANGE,
+                            Stringf( "Unknown variable %s", name.ascii() ).ascii() );
+
+    return _nameToVariable.get( name );
+}
+
+void SimplexSolver::setLowerBound( String name, double lb )
+{
+    unsigned variable = getVariable( name );
+    _lowerBounds[variable] = lb;
+    if ( !isBasic( variable ) )
+        setToNearestBound( variable );
+}
+
+void SimplexSolver::setUpperBound( String name, double ub )
+{
+    unsigned variable = getVariable( name );
+    _upperBounds[variable] = ub;
+    if ( !isBasic( variable ) )
+        setToNearestBound( variable );
+}
+
+double SimplexSolver::getLowerBound( const String &name ) const
+{
+    return _lowerBounds[getVariable( name )];
+}
+
+double SimplexSolver::getUpperBound( const String &name ) const
+{
+    return _upperBounds[getVariable( name )];
+}
+
+void SimplexSolver::addLeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, FloatUtils::negativeInfinity(), scalar );
+}
+
+void SimplexSolver::addGeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, FloatUtils::infinity() );
+}
+
+void SimplexSolver::addEqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, scalar );
+}
+
+void SimplexSolver::addConstraint( const List<Term> &terms, double lb, double ub )
+{
+    // Merge repeated variables
+    Map<unsigned, double> coefficients;
+    for ( const auto &term : terms )
+    {
+        unsigned variable = getVariable( term._variable );
+        if ( coefficients.exists( variable ) )
+            coefficients[variable] += term._coefficient;
+        else
+            coefficients[variable] = term._coefficient;
+    }
+
+    /*
+      The new row is a * x - s = 0. The slack variable s is basic in the
+      new row, so the basis remains non-singular.
+    */
+    unsigned row = _m;
+    double value = 0;
+    for ( const auto &pair : coefficients )
+    {
+        if ( FloatUtils::isZero( pair.second ) )
+            continue;
+
+        _columns[pair.first]->append( row, pair.second );
+        value += pair.second * _assignment[pair.first];
+    }
+
+    ++_m;
+    unsigned slack = addVariable( lb, ub );
+    _columns[slack]->append( row, -1 );
+    _rowToSlack.append( slack );
+    _assignment[slack] = value;
+
+    _basicIndexToVariable.append( slack );
+    _variableToBasicIndex[slack] = row;
+}
+
+void SimplexSolver::setCost( const List<Term> &terms, double constant )
+{
+    setCostFunction( terms, constant, false );
+}
+
+void SimplexSolver::setObjective( const List<Term> &terms, double constant )
+{
+    setCostFunction( terms, constant, true );
+}
+
+void SimplexSolver::setCostFunction( const List<Term> &terms, double constant, bool maximize )
+{
+    std::fill( _costs.begin(), _costs.end(), 0 );
+    for ( const auto &term : terms )
+        _costs[getVariable( term._variable )] += maximize ? -term._coefficient : term._coefficient;
+
+    _costConstant = constant;
+    _maximize = maximize;
+}
+
+void SimplexSolver::setCutoff( double cutoff )
+{
+    _cutoffInUse = true;
+    _cutoffValue = cutoff;
+}
+
+void SimplexSolver::setTimeLimit( double seconds )
+{
+    _timeLimit = seconds;
+}
+
+bool SimplexSolver::isBasic( unsigned variable ) const
+{
+    unsigned index = _variableToBasicIndex[variable];
+    return index < _m && _basicIndexToVariable[index] == variable;
+}
+
+void SimplexSolver::setToNearestBound( unsigned variable )
+{
+    double lb = _lowerBounds[variable];
+    double ub = _upperBounds[variable];
+    double &value = _assignment[variable];
+
+    if ( FloatUtils::isFinite( lb ) && ( value < lb || !FloatUtils::isFinite( ub ) ) )
+        value = lb;
+    else if ( FloatUtils::isFinite( ub ) )
+        value = ( value > ub || !FloatUtils::isFinite( lb ) || ub - value < value - lb ) ? ub : lb;
+    else
+        value = 0;
+}
+
+void SimplexSolver::prepareBasisFactorization()
+{
+    for ( auto &column : _columns )
+    {
+        while ( column->getSize() < _m )
+            column->incrementSize();
+    }
+
+    if ( _factorizationSize != _m )
+    {
+        if ( _basisFactorization )
+            delete _basisFactorization;
+
+        _basisFactorization = BasisFactorizationFactory::createBasisFactorization( _m, *this );
+        _factorizationSize = _m;
+
+        _basicCosts.clear();
+        _multipliers.clear();
+        _changeColumn.clear();
+        _enteringColumn.clear();
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            _basicCosts.append( 0 );
+            _multipliers.append( 0 );
+            _changeColumn.append( 0 );
+            _enteringColumn.append( 0 );
+        }
+    }
+
+    try
+    {
+        _basisFactorization->obtainFreshBasis();
+    }
+    catch ( const MalformedBasisException & )
+    {
+        // Revert to the slack basis, which is always non-singular
+        for ( unsigned row = 0; row < _m; ++row )
+        {
+            _basicIndexToVariable[row] = _rowToSlack[row];
+            _variableToBasicIndex[_rowToSlack[row]] = row;
+        }
+
+        for ( unsigned variable = 0; variable < _assignment.size(); ++variable )
+        {
+            if ( !isBasic( variable ) )
+                setToNearestBound( variable );
+        }
+
+        _basisFactorization->obtainFreshBasis();
+    }
+}
+
+void SimplexSolver::computeBasicAssignment()
+{
+    // B * xB = -N * xN
+    std::fill( _enteringColumn.begin(), _enteringColumn.end(), 0 );
+    for ( unsigned variable = 0; variable < _assignment.size(); ++variable )
+    {
+        double value = _assignment[variable];
+        if ( value == 0 || isBasic( variable ) )
+            continue;
+
+        for ( const auto &entry : *_columns[variable] )
+            _enteringColumn[entry._index] -= entry._value * value;
+    }
+
+    _basisFactorization->forwardTransformation( _enteringColumn.data(), _changeColumn.data() );
+    for ( unsigned i = 0; i < _m; ++i )
+        _assignment[_basicIndexToVariable[i]] = _changeColumn[i];
+}
+
+bool SimplexSolver::computeBasicCosts()
+{
+    double tolerance = GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE;
+
+    bool feasible = true;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        unsigned variable = _basicIndexToVariable[i];
+        double value = _assignment[variable];
+        if ( value < _lowerBounds[variable] - tolerance )
+        {
+            _basicCosts[i] = -1;
+            feasible = false;
+        }
+        else if ( value > _upperBounds[variable] + tolerance )
+        {
+            _basicCosts[i] = 1;
+            feasible = false;
+        }
+        else
+            _basicCosts[i] = 0;
+    }
+
+    if ( feasible )
+    {
+        for ( unsigned i = 0; i < _m; ++i )
+            _basicCosts[i] = _costs[_basicIndexToVariable[i]];
+    }
+
+    return feasible;
+}
+
+double SimplexSolver::computeReducedCost( unsigned variable, bool feasible ) const
+{
+    // In phase 1 the non-basic variables have no cost
+    double reducedCost = feasible ? _costs[variable] : 0;
+    for ( const auto &entry : *_columns[variable] )
+        reducedCost -= _multipliers[entry._index] * entry._value;
+    return reducedCost;
+}
+
+bool SimplexSolver::isEligibleForEntry( unsigned variable, double reducedCost ) const
+{
+    double tolerance = GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE;
+
+    // A negative reduced cost calls for increasing the variable, and vice versa
+    if ( reducedCost < -tolerance )
+        return _assignment[variable] < _upperBounds[variable];
+    if ( reducedCost > tolerance )
+        return _assignment[variable] > _lowerBounds[variable];
+    return false;
+}
+
+unsigned SimplexSolver::selectEnteringVariable( bool feasible,
+                                                bool useBlandsRule,
+                                                double &reducedCost ) const
+{
+    unsigned numVariables = _assignment.size();
+    unsigned entering = numVariables;
+    double bestScore = 0;
+
+    for ( unsigned variable = 0; variable < numVariables; ++variable )
+    {
+        if ( isBasic( variable ) || _lowerBounds[variable] == _upperBounds[variable] )
+            continue;
+
+        double candidateReducedCost = computeReducedCost( variable, feasible );
+        if ( !isEligibleForEntry( variable, candidateReducedCost ) )
+            continue;
+
+        // Dantzig's rule, or Bland's rule (the first eligible variable) to escape cycles
+        if ( useBlandsRule )
+        {
+            reducedCost = candidateReducedCost;
+            return variable;
+        }
+
+        if ( FloatUtils::abs( candidateReducedCost ) > bestScore )
+        {
+            bestScore = FloatUtils::abs( candidateReducedCost );
+            reducedCost = candidateReducedCost;
+            entering = variable;
+        }
+    }
+
+    return entering;
+}
+
+bool SimplexSolver::performRatioTest( unsigned entering,
+                                      int direction,
+                                      bool feasible,
+                                      bool useBlandsRule,
+                                      double &step,
+                                      unsigned &leavingIndex,
+                                      double &leavingValue ) const
+{
+    double pivotTolerance = GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE;
+    double harrisTolerance =
+        useBlandsRule ? 0 : GlobalConfiguration::HARRIS_RATIO_CONSTRAINT_ADDITIVE_TOLERANCE;
+    double boundTolerance = GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE;
+
+    /*
+      The two passes of Harris' ratio test. First, find the largest step
+      that keeps all basic variables within their (slightly relaxed)
+      bounds. Then, among the basic variables that block a step of that
+      size, pick the one with the largest pivot element.
+    */
+    double maxStep = FloatUtils::infinity();
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( FloatUtils::abs( _changeColumn[i] ) <= pivotTolerance )
+            continue;
+
+        unsigned variable = _basicIndexToVariable[i];
+        double value = _assignment[variable];
+        double lb = _lowerBounds[variable];
+        double ub = _upperBounds[variable];
+        double delta = -direction * _changeColumn[i];
+
+        // In phase 1, infeasible variables may move until they reach their bound
+        if ( !feasible && value < lb - boundTolerance )
+        {
+            if ( delta > 0 )
+                maxStep = FloatUtils::min( maxStep, ( lb - value + harrisTolerance ) / delta );
+        }
+        else if ( !feasible && value > ub + boundTolerance )
+        {
+            if ( delta < 0 )
+                maxStep = FloatUtils::min( maxStep, ( ub - value - harrisTolerance ) / delta );
+        }
+        else if ( delta < 0 && FloatUtils::isFinite( lb ) )
+            maxStep = FloatUtils::min( maxStep, ( lb - value - harrisTolerance ) / delta );
+        else if ( delta > 0 && FloatUtils::isFinite( ub ) )
+            maxStep = FloatUtils::min( maxStep, ( ub - value + harrisTolerance ) / delta );
+    }
+
+    double range = _upperBounds[entering] - _lowerBounds[entering];
+    if ( FloatUtils::isFinite( range ) && range <= maxStep )
+    {
+        // The entering variable hits its other bound first
+        step = range;
+        leavingIndex = _m;
+        return true;
+    }
+
+    if ( !FloatUtils::isFinite( maxStep ) )
+        return false;
+
+    leavingIndex = _m;
+    double bestPivot = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( FloatUtils::abs( _changeColumn[i] ) <= pivotTolerance )
+            continue;
+
+        unsigned variable = _basicIndexToVariable[i];
+        double value = _assignment[variable];
+        double lb = _lowerBounds[variable];
+        double ub = _upperBounds[variable];
+        double delta = -direction * _changeColumn[i];
+
+        double bound;
+        if ( !feasible && value < lb - boundTolerance )
+            bound = delta > 0 ? lb : FloatUtils::infinity();
+        else if ( !feasible && value > ub + boundTolerance )
+            bound = delta < 0 ? ub : FloatUtils::infinity();
+        else
+            bound = delta < 0 ? lb : ub;
+
+        if ( !FloatUtils::isFinite( bound ) )
+            continue;
+
+        double ratio = ( bound - value ) / delta;
+        if ( ratio > maxStep )
+            continue;
+
+        bool better = useBlandsRule
+                        ? ( leavingIndex == _m || ratio < step ||
+                            ( ratio == step && variable < _basicIndexToVariable[leavingIndex] ) )
+                        : FloatUtils::abs( _changeColumn[i] ) > bestPivot;
+        if ( better )
+        {
+            bestPivot = FloatUtils::abs( _changeColumn[i] );
+            step = ratio;
+            leavingIndex = i;
+            leavingValue = bound;
+        }
+    }
+
+    if ( leavingIndex == _m )
+        return false;
+
+    if ( step < 0 )
+        step = 0;
+
+    return true;
+}
+
+bool SimplexSolver::timeLimitExceeded() const
+{
+    if ( !FloatUtils::isFinite( _timeLimit ) )
+        return false;
+
+    struct timespec now = TimeUtils::sampleMicro();
+    return TimeUtils::timePassed( _startTime, now ) > _timeLimit * 1000000;
+}
+
+void SimplexSolver::solve()
+{
+    reset();
+    _startTime = TimeUtils::sampleMicro();
+
+    if ( _m > 0 )
+    {
+        prepareBasisFactorization();
+        computeBasicAssignment();
+    }
+
+    unsigned degenerateSteps = 0;
+    bool assignmentRecomputed = true;
+    bool refactorized = true;
+
+    while ( true )
+    {
+        if ( _numIterations >= GlobalConfiguration::SIMPLEX_SOLVER_MAX_ITERATIONS ||
+             timeLimitExceeded() )
+        {
+            _status = TIMEOUT;
+            return;
+        }
+
+        bool feasible = computeBasicCosts();
+
+        if ( _m > 0 )
+        {
+            // Solve y * B = cB for the simplex multipliers
+            _basisFactorization->backwardTransformation( _basicCosts.data(),
+                                                         _multipliers.data() );
+        }
+
+        bool useBlandsRule =
+            degenerateSteps >= GlobalConfiguration::SIMPLEX_SOLVER_DEGENERATE_STEPS_BEFORE_BLAND;
+        double reducedCost = 0;
+        unsigned entering = selectEnteringVariable( feasible, useBlandsRule, reducedCost );
+
+        if ( entering == _assignment.size() )
+        {
+            // No improving direction. Confirm with a fresh assignment, to rule out drift.
+            if ( !assignmentRecomputed && _m > 0 )
+            {
+                computeBasicAssignment();
+                assignmentRecomputed = true;
+                continue;
+            }
+
+            if ( !feasible )
+            {
+                // Rule out a drifted factorization before concluding
+                if ( !refactorized && _m > 0 )
+                {
+                    prepareBasisFactorization();
+                    computeBasicAssignment();
+                    refactorized = true;
+                    continue;
+                }
+
+                _status = FloatUtils::isPositive( computeDualBound( false ) ) ? INFEASIBLE : TIMEOUT;
+                return;
+            }
+
+            _optimalValue = computeOptimalValue();
+            double costBound = computeDualBound( true );
+            _objectiveBound = ( _maximize ? -costBound : costBound ) + _costConstant;
+            if ( _cutoffInUse && ( _maximize ? _objectiveBound < _cutoffValue
+                                             : _objectiveBound > _cutoffValue ) )
+                _status = CUTOFF;
+            else
+                _status = OPTIMAL;
+            return;
+        }
+
+        int direction = reducedCost < 0 ? 1 : -1;
+
+        double step = 0;
+        unsigned leavingIndex = _m;
+        double leavingValue = 0;
+        if ( _m > 0 )
+        {
+            _columns[entering]->toDense( _enteringColumn.data() );
+            _basisFactorization->forwardTransformation( _enteringColumn.data(),
+                                                        _changeColumn.data() );
+        }
+
+        if ( !performRatioTest(
+                 entering, direction, feasible, useBlandsRule, step, leavingIndex, leavingValue ) )
+        {
+            // Phase 1 is bounded, so an unbounded step there indicates numerical trouble
+            _status = feasible ? UNBOUNDED : TIMEOUT;
+            return;
+        }
+
+        ++_numIterations;
+        assignmentRecomputed = false;
+        refactorized = false;
+        degenerateSteps = FloatUtils::isZero( step ) ? degenerateSteps + 1 : 0;
+
+        // Update the assignment
+        _assignment[entering] += direction * step;
+        for ( unsigned i = 0; i < _m; ++i )
+            _assignment[_basicIndexToVariable[i]] -= direction * step * _changeColumn[i];
+
+        if ( leavingIndex == _m )
+        {
+            // A bound flip: the entering variable remains non-basic
+            _assignment[entering] =
+                direction > 0 ? _upperBounds[entering] : _lowerBounds[entering];
+            continue;
+        }
+
+        unsigned leaving = _basicIndexToVariable[leavingIndex];
+        _assignment[leaving] = leavingValue;
+        _basicIndexToVariable[leavingIndex] = entering;
+        _variableToBasicIndex[entering] = leavingIndex;
+
+        try
+        {
+            _basisFactorization->updateToAdjacentBasis(
+                leavingIndex, _changeColumn.data(), _enteringColumn.data() );
+        }
+        catch ( const MalformedBasisException & )
+        {
+            _status = TIMEOUT;
+            return;
+        }
+    }
+}
+
+double SimplexSolver::computeOptimalValue() const
+{
+    double value = 0;
+    for ( unsigned variable = 0; variable < _assignment.size(); ++variable )
+        value += _costs[variable] * _assignment[variable];
+
+    return ( _maximize ? -value : value ) + _costConstant;
+}
+
+double SimplexSolver::computeDualBound( bool withCosts ) const
+{
+    /*
+      For multipliers y, c * x = c * x - y * ( A * x - s ) on the feasible
+      region, and the latter is at least the sum over all variables of
+      min d_j * x_j over the bounds of x_j, with d = c - y * [A -I].
+    */
+    Vector<double> multipliers( _multipliers );
+    for ( unsigned row = 0; row < _m; ++row )
+    {
+        // The reduced cost of the slack variable is y_i
+        unsigned slack = _rowToSlack[row];
+        if ( multipliers[row] > 0 && !FloatUtils::isFinite( _lowerBounds[slack] ) )
+            multipliers[row] = 0;
+        else if ( multipliers[row] < 0 && !FloatUtils::isFinite( _upperBounds[slack] ) )
+            multipliers[row] = 0;
+    }
+
+    double bound = 0;
+    double magnitude = 0;
+    for ( unsigned variable = 0; variable < _assignment.size(); ++variable )
+    {
+        double reducedCost = withCosts ? _costs[variable] : 0;
+        double scale = FloatUtils::abs( reducedCost );
+        for ( const auto &entry : *_columns[variable] )
+        {
+            reducedCost -= multipliers[entry._index] * entry._value;
+            scale += FloatUtils::abs( multipliers[entry._index] * entry._value );
+        }
+
+        if ( reducedCost == 0 )
+            continue;
+
+        double value = reducedCost > 0 ? _lowerBounds[variable] : _upperBounds[variable];
+        if ( !FloatUtils::isFinite( value ) )
+            return FloatUtils::negativeInfinity();
+
+        bound += reducedCost * value;
+        magnitude += scale * FloatUtils::abs( value );
+    }
+
+    return bound - GlobalConfiguration::SIMPLEX_SOLVER_DUAL_BOUND_RELATIVE_TOLERANCE * magnitude;
+}
+
+bool SimplexSolver::optimal() const
+{
+    return _status == OPTIMAL;
+}
+
+bool SimplexSolver::infeasible() const
+{
+    return _status == INFEASIBLE;
+}
+
+bool SimplexSolver::unbounded() const
+{
+    return _status == UNBOUNDED;
+}
+
+bool SimplexSolver::cutoffOccurred() const
+{
+    return _status == CUTOFF;
+}
+
+bool SimplexSolver::timeout() const
+{
+    return _status == TIMEOUT;
+}
+
+bool SimplexSolver::haveFeasibleSolution() const
+{
+    return _status == OPTIMAL || _status == CUTOFF;
+}
+
+void SimplexSolver::extractSolution( Map<String, double> &values, double &costOrObjective ) const
+{
+    values.clear();
+    for ( const auto &pair : _nameToVariable )
+        values[pair.first] = _assignment[pair.second];
+
+    costOrObjective = _optimalValue;
+}
+
+double SimplexSolver::getObjectiveBound() const
+{
+    if ( _status == OPTIMAL || _status == CUTOFF )
+        return _objectiveBound;
+
+    return _maximize ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
+}
+
+unsigned SimplexSolver::getNumberOfSimplexIterations() const
+{
+    return _numIterations;
+}
+
+unsigned SimplexSolver::getNumberOfVariables() const
+{
+    return _nameToVariable.size();
+}
+
+unsigned SimplexSolver::getNumberOfConstraints() const
+{
+    return _m;
+}
+
+void SimplexSolver::getColumnOfBasis( unsigned column, double *result ) const
+{
+    ASSERT( column < _m );
+    _columns[_basicIndexToVariable[column]]->toDense( result );
+}
+
+void SimplexSolver::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const
+{
+    ASSERT( column < _m );
+    _columns[_basicIndexToVariable[column]]->storeIntoOther( result );
+}
+
+void SimplexSolver::getSparseBasis( SparseColumnsOfBasis &basis ) const
+{
+    for ( unsigned i = 0; i < _m; ++i )
+        basis._columns[i] = _columns[_basicIndexToVariable[i]];
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
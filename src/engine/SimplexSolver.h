@@ -0,0 +1,282 @@
+/*********************                                                        */
+/*! \file SimplexSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __SimplexSolver_h__
+#define __SimplexSolver_h__
+
+#include "IBasisFactorization.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "Vector.h"
+
+#include <ctime>
+
+class SparseUnsortedList;
+
+/*
+  A stand-alone LP solver: a bounded-variable, revised primal simplex
+  over the basis factorizations of the engine. It exposes the subset of
+  the GurobiWrapper interface that is needed for LP-relaxation based
+  bound tightening, so that the same code can build and solve the
+  relaxation with either solver.
+
+  Every constraint a * x (<=, >=, =) b is stored as the row a * x - s = 0
+  over a new slack variable s, bounded according to the constraint type.
+  The initial basis consists of the slack variables. Phase 1 minimizes
+  the sum of infeasibilities of the basic variables, and phase 2
+  optimizes the objective.
+
+  Neither infeasibility nor the optimal value are taken from the final
+  basis as is, since it is only optimal within tolerances. The simplex
+  multipliers y of the final basis give, for any y, a bound on the
+  Lagrangian min c * x - y * ( A * x - s ) over the bounds of x and s,
+  which is a lower bound on the optimal cost. When phase 1 stalls, the
+  basis is refactorized and the assignment recomputed, and the problem is
+  only declared infeasible if the phase 1 multipliers prove it, i.e. if
+  the same bound is positive with a zero cost. Otherwise the solver gives
+  up with a timeout.
+
+  The basis is kept between calls to solve(): adding variables or
+  constraints extends it, and changing bounds or the objective only
+  changes the starting point. Consecutive solves of similar problems,
+  e.g. the maximization and minimization of the same variable, are thus
+  warm started.
+*/
+class SimplexSolver : public IBasisFactorization::BasisColumnOracle
+{
+public:
+    enum Status {
+        UNSOLVED = 0,
+        OPTIMAL = 1,
+        INFEASIBLE = 2,
+        UNBOUNDED = 3,
+        CUTOFF = 4,
+        TIMEOUT = 5,
+    };
+
+    struct Term
+    {
+        Term( double coefficient, String variable )
+            : _coefficient( coefficient )
+            , _variable( variable )
+        {
+        }
+
+        Term()
+            : _coefficient( 0 )
+            , _variable( "" )
+        {
+        }
+
+        double _coefficient;
+        String _variable;
+    };
+
+    SimplexSolver();
+    ~SimplexSolver();
+
+    /*
+      Add a new variable to the model. Adding an existing variable again
+      intersects its bounds, e.g. when two neurons of the network share a
+      variable.
+    */
+    void addVariable( String name, double lb, double ub );
+    bool containsVariable( String name ) const;
+
+    /*
+      Change or retrieve the bounds of a variable
+    */
+    void setLowerBound( String name, double lb );
+    void setUpperBound( String name, double ub );
+    double getLowerBound( const String &name ) const;
+    double getUpperBound( const String &name ) const;
+
+    /*
+      Add a new constraint over existing variables
+    */
+    void addLeqConstraint( const List<Term> &terms, double scalar );
+    void addGeqConstraint( const List<Term> &terms, double scalar );
+    void addEqConstraint( const List<Term> &terms, double scalar );
+
+    /*
+      A cost function to minimize, or an objective function to maximize
+    */
+    void setCost( const List<Term> &terms, double constant = 0 );
+    void setObjective( const List<Term> &terms, double constant = 0 );
+
+    /*
+      If an optimal value is worse than the cutoff, the solver reports
+      cutoffOccurred() instead of optimal()
+    */
+    void setCutoff( double cutoff );
+
+    /*
+      Limit the time spent in a single call to solve(). The solver also
+      gives up, and reports a timeout, if it exceeds its iteration limit
+      or runs into numerical trouble.
+    */
+    void setTimeLimit( double seconds );
+
+    void solve();
+
+    /*
+      Discard the result of the last solve, but keep the basis. Discard
+      the entire model.
+    */
+    void reset();
+    void resetModel();
+
+    bool optimal() const;
+    bool infeasible() const;
+    bool unbounded() const;
+    bool cutoffOccurred() const;
+    bool timeout() const;
+    bool haveFeasibleSolution() const;
+
+    /*
+      Retrieve the optimal assignment and the value of the cost or
+      objective function
+    */
+    void extractSolution( Map<String, double> &values, double &costOrObjective ) const;
+
+    /*
+      A bound on the optimal value (a lower bound on the cost, or an upper
+      bound on the objective) proven by the multipliers of the final basis,
+      and loosened for rounding errors. It is infinite if no optimum was
+      found, or if the multipliers prove no finite bound.
+    */
+    double getObjectiveBound() const;
+
+    unsigned getNumberOfSimplexIterations() const;
+    unsigned getNumberOfVariables() const;
+    unsigned getNumberOfConstraints() const;
+
+    /*
+      BasisColumnOracle methods
+    */
+    void getColumnOfBasis( unsigned column, double *result ) const;
+    void getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const;
+    void getSparseBasis( SparseColumnsOfBasis &basis ) const;
+
+private:
+    /*
+      The model. Variables are either structural variables, added by
+      addVariable(), or slack variables, one per constraint. Every
+      variable owns a sparse column of the constraint matrix.
+    */
+    Map<String, unsigned> _nameToVariable;
+    Vector<unsigned> _rowToSlack;
+    Vector<double> _lowerBounds;
+    Vector<double> _upperBounds;
+    Vector<SparseUnsortedList *> _columns;
+    unsigned _m;
+
+    /*
+      The cost of every variable, negated for maximization so that the
+      solver always minimizes
+    */
+    Vector<double> _costs;
+    double _costConstant;
+    bool _maximize;
+    bool _cutoffInUse;
+    double _cutoffValue;
+
+    /*
+      The basis and the current assignment. Non-basic variables are at
+      one of their bounds, or at zero if they have none.
+    */
+    Vector<unsigned> _basicIndexToVariable;
+    Vector<unsigned> _variableToBasicIndex;
+    Vector<double> _assignment;
+    IBasisFactorization *_basisFactorization;
+    unsigned _factorizationSize;
+
+    Status _status;
+    double _optimalValue;
+    double _objectiveBound;
+    unsigned _numIterations;
+    double _timeLimit;
+    struct timespec _startTime;
+
+    /*
+      Work memory, of size m
+    */
+    Vector<double> _basicCosts;
+    Vector<double> _multipliers;
+    Vector<double> _changeColumn;
+    Vector<double> _enteringColumn;
+
+    unsigned addVariable( double lb, double ub );
+    unsigned getVariable( const String &name ) const;
+    void addConstraint( const List<Term> &terms, double lb, double ub );
+    void setCostFunction( const List<Term> &terms, double constant, bool maximize );
+
+    bool isBasic( unsigned variable ) const;
+    void setToNearestBound( unsigned variable );
+    void freeMemoryIfNeeded();
+
+    /*
+      Make sure that the basis factorization matches the current basis,
+      reverting to the slack basis if it is singular
+    */
+    void prepareBasisFactorization();
+    void computeBasicAssignment();
+
+    /*
+      Compute the costs of the basic variables, for phase 1 if any of them
+      is out of bounds (returning false), or for phase 2 otherwise
+    */
+    bool computeBasicCosts();
+    unsigned selectEnteringVariable( bool feasible, bool useBlandsRule, double &reducedCost ) const;
+    double computeReducedCost( unsigned variable, bool feasible ) const;
+    bool isEligibleForEntry( unsigned variable, double reducedCost ) const;
+
+    /*
+      The ratio test: find the step size and the leaving basic index
+      (m if the entering variable hits its other bound, or if the step is
+      unbounded)
+    */
+    bool performRatioTest( unsigned entering,
+                           int direction,
+                           bool feasible,
+                           bool useBlandsRule,
+                           double &step,
+                           unsigned &leavingIndex,
+                           double &leavingValue ) const;
+
+    double computeOptimalValue() const;
+
+    /*
+      The lower bound on min c * x over the feasible region, proven by
+      the current multipliers, where c is the cost if withCosts is true and
+      zero otherwise. The multipliers of the rows whose slack variable is
+      unbounded in the wrong direction are replaced by zero, which keeps
+      the bound finite and valid.
+    */
+    double computeDualBound( bool withCosts ) const;
+
+    bool timeLimitExceeded() const;
+};
+
+#endif // __SimplexSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -21,12 +21,15 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "IEngine.h"
+#include "InfeasibleQueryException.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "Options.h"
 #include "PseudoImpactTracker.h"
 #include "ReluConstraint.h"
+#include "Set.h"
 #include "UnsatCertificateNode.h"
+#include "Vector.h"
 
 SmtCore::SmtCore( IEngine *engine )
     : _statistics( NULL )
@@ -41,6 +44,7 @@ SmtCore::SmtCore( IEngine *engine )
     , _branchingHeuristic( Options::get()->getDivideStrategy() )
     , _scoreTracker( nullptr )
     , _numRejectedPhasePatternProposal( 0 )
+    , _learnConflicts( Options::get()->getBool( Options::CONFLICT_DRIVEN_LEARNING ) )
 {
 }
 
@@ -71,6 +75,7 @@ void SmtCore::reset()
     _stateId = 0;
     _constraintToViolationCount.clear();
     _numRejectedPhasePatternProposal = 0;
+    _conflictClauses.clear();
 }
 
 void SmtCore::reportViolatedConstraint( PiecewiseLinearConstraint *constraint )
@@ -199,6 +204,9 @@ void SmtCore::performSplit()
 
     _engine->applySplit( *split );
     stackEntry->_activeSplit = *split;
+    // A constraint created for this split only would dangle once the next split is picked
+    if ( !_engine->isTemporaryConstraint( _constraintForSplitting ) )
+        stackEntry->_constraint = _constraintForSplitting;
 
     // Store the remaining splits on the stack, for later
     stackEntry->_engineState = stateBeforeSplits;
@@ -223,6 +231,9 @@ void SmtCore::performSplit()
     }
 
     _constraintForSplitting = NULL;
+
+    if ( learningConflicts() && !propagateConflictClauses() )
+        throw InfeasibleQueryException();
 }
 
 unsigned SmtCore::getStackDepth() const
@@ -280,6 +291,21 @@ bool SmtCore::popSplit()
     bool inconsistent = true;
     while ( inconsistent )
     {
+        if ( learningConflicts() )
+        {
+            bool asserted = false;
+            if ( !backjump( asserted ) )
+                return false;
+
+            if ( asserted )
+            {
+                inconsistent = !_engine->consistentBounds() || !propagateConflictClauses();
+                if ( inconsistent && _stack.empty() )
+                    return false;
+                continue;
+            }
+        }
+
         // Remove any entries that have no alternatives
         String error;
         while ( _stack.back()->_alternativeSplits.empty() )
@@ -291,10 +317,7 @@ bool SmtCore::popSplit()
                 throw MarabouError( MarabouError::DEBUGGING_ERROR );
             }
 
-            delete _stack.back()->_engineState;
-            delete _stack.back();
-            _stack.popBack();
-            popContext();
+            discardTopStackEntry();
 
             if ( _engine->shouldProduceProofs() && _engine->getUNSATCertificateCurrentPointer() )
             {
@@ -359,6 +382,8 @@ bool SmtCore::popSplit()
         stackEntry->_alternativeSplits.erase( split );
 
         inconsistent = !_engine->consistentBounds();
+        if ( !inconsistent && learningConflicts() )
+            inconsistent = !propagateConflictClauses();
 
         if ( _engine->shouldProduceProofs() && inconsistent )
             _engine->explainSimplexFailure();
@@ -380,6 +405,251 @@ bool SmtCore::popSplit()
     return true;
 }
 
+bool SmtCore::learningConflicts() const
+{
+    return _learnConflicts && !_engine->shouldProduceProofs();
+}
+
+bool SmtCore::analyzeConflict( List<unsigned> &conflict ) const
+{
+    // Stack entries replayed from a stored SmtState, or split on a temporary constraint, do not
+    // record their constraints
+    Vector<PiecewiseLinearCaseSplit> decisions;
+    for ( const auto &stackEntry : _stack )
+    {
+        if ( !stackEntry->_constraint )
+            return false;
+        decisions.append( stackEntry->_activeSplit );
+    }
+
+    List<PiecewiseLinearCaseSplit> splits;
+    for ( const auto &decision : decisions )
+        splits.append( decision );
+    if ( !_engine->caseSplitsRefutedAtRoot( splits ) )
+        return false;
+
+    // Try to drop the most recent decisions first, within the propagation budget
+    Set<unsigned> dropped;
+    unsigned numPropagations = 0;
+    for ( unsigned i = decisions.size();
+          i-- > 0 && numPropagations < GlobalConfiguration::MAX_CONFLICT_ANALYSIS_PROPAGATIONS; )
+    {
+        ++numPropagations;
+        splits.clear();
+        for ( unsigned j = 0; j < decisions.size(); ++j )
+        {
+            if ( j != i && !dropped.exists( j ) )
+                splits.append( decisions[j] );
+        }
+
+        if ( _engine->caseSplitsRefutedAtRoot( splits ) )
+            dropped.insert( i );
+    }
+
+    conflict.clear();
+    for ( unsigned i = 0; i < decisions.size(); ++i )
+    {
+        if ( !dropped.exists( i ) )
+            conflict.append( i );
+    }
+
+    return true;
+}
+
+bool SmtCore::backjump( bool &asserted )
+{
+    asserted = false;
+
+    struct timespec start = TimeUtils::sampleMicro();
+    List<unsigned> conflict;
+    bool learned = analyzeConflict( conflict );
+    struct timespec end = TimeUtils::sampleMicro();
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::TOTAL_TIME_CONFLICT_ANALYSIS_MICRO,
+                                       TimeUtils::timePassed( start, end ) );
+
+    if ( !learned )
+        return true;
+
+    if ( _statistics )
+        _statistics->incLongAttribute( Statistics::NUM_CONFLICT_CLAUSES_LEARNED );
+
+    if ( conflict.empty() )
+    {
+        // The root itself is refuted
+        SMT_LOG( "Conflict analysis: the root bounds are infeasible" );
+        while ( !_stack.empty() )
+            discardTopStackEntry();
+        return false;
+    }
+
+    ConflictClause clause;
+    unsigned level = 0;
+    for ( const auto &stackEntry : _stack )
+    {
+        if ( conflict.exists( level ) )
+            clause.append( Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>(
+                stackEntry->_constraint, stackEntry->_activeSplit ) );
+        ++level;
+    }
+
+    _conflictClauses.append( clause );
+    if ( _conflictClauses.size() > GlobalConfiguration::MAX_NUMBER_OF_CONFLICT_CLAUSES )
+        _conflictClauses.erase( _conflictClauses.begin() );
+
+    SMT_LOG( Stringf( "Conflict analysis: learned a clause of size %u, stack depth is %u",
+                      conflict.size(),
+                      _stack.size() )
+                 .ascii() );
+
+    // All the alternatives above the deepest decision of the clause are refuted as well
+    unsigned deepest = conflict.back();
+    bool skippedAlternatives = false;
+    while ( _stack.size() > deepest + 1 )
+    {
+        if ( !_stack.back()->_alternativeSplits.empty() )
+            skippedAlternatives = true;
+        discardTopStackEntry();
+    }
+
+    SmtStackEntry *stackEntry = _stack.back();
+    PiecewiseLinearConstraint *constraint = stackEntry->_constraint;
+    if ( stackEntry->_alternativeSplits.size() != 1 || !hasTwoPhases( constraint ) )
+    {
+        if ( skippedAlternatives && _statistics )
+            _statistics->incLongAttribute( Statistics::NUM_NON_CHRONOLOGICAL_BACKJUMPS );
+        return true;
+    }
+
+    // The clause implies the other phase of the deepest decision as soon as the other
+    // decisions of the clause hold, i.e. at the level of the second-deepest one
+    PiecewiseLinearCaseSplit impliedSplit = *stackEntry->_alternativeSplits.begin();
+    unsigned assertionLevel = 0;
+    for ( const auto &index : conflict )
+    {
+        if ( index != deepest )
+            assertionLevel = index + 1;
+    }
+
+    while ( _stack.size() > assertionLevel + 1 )
+    {
+        if ( _stack.back() != stackEntry && !_stack.back()->_alternativeSplits.empty() )
+            skippedAlternatives = true;
+        discardTopStackEntry();
+    }
+
+    // The engine state at the assertion level is the one stored by the split that followed it,
+    // except that the constraint of that split was already disabled there
+    SmtStackEntry *splitAfterAssertionLevel = _stack.back();
+    popContext();
+    _engine->postContextPopHook();
+    _engine->restoreState( *( splitAfterAssertionLevel->_engineState ) );
+    splitAfterAssertionLevel->_constraint->setActiveConstraint( true );
+    delete splitAfterAssertionLevel->_engineState;
+    delete splitAfterAssertionLevel;
+    _stack.popBack();
+
+    constraint->setActiveConstraint( false );
+    recordImpliedValidSplit( impliedSplit );
+    _engine->applySplit( impliedSplit );
+    asserted = true;
+
+    if ( _statistics )
+    {
+        _statistics->incLongAttribute( Statistics::NUM_CASE_SPLITS_IMPLIED_BY_CONFLICT_CLAUSES );
+        if ( skippedAlternatives )
+            _statistics->incLongAttribute( Statistics::NUM_NON_CHRONOLOGICAL_BACKJUMPS );
+    }
+
+    return true;
+}
+
+bool SmtCore::propagateConflictClauses()
+{
+    bool propagated = true;
+    while ( propagated )
+    {
+        propagated = false;
+
+        List<PiecewiseLinearCaseSplit> trail;
+        allSplitsSoFar( trail );
+
+        for ( const auto &clause : _conflictClauses )
+        {
+            // A case split holds if its constraint is disabled and the split is on the trail.
+            // Clauses with a case split that does not hold, or with two or more constraints that
+            // are still active, imply nothing.
+            const Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit> *open = NULL;
+            unsigned numOpen = 0;
+            bool satisfied = false;
+            for ( const auto &literal : clause )
+            {
+                if ( literal.first()->isActive() )
+                {
+                    open = &literal;
+                    if ( ++numOpen > 1 )
+                        break;
+                }
+                else if ( !trail.exists( literal.second() ) )
+                {
+                    satisfied = true;
+                    break;
+                }
+            }
+
+            if ( satisfied || numOpen > 1 )
+                continue;
+
+            if ( numOpen == 0 )
+                return false;
+
+            PiecewiseLinearConstraint *constraint = open->first();
+            if ( !hasTwoPhases( constraint ) || constraint->phaseFixed() )
+                continue;
+
+            List<PiecewiseLinearCaseSplit> splits = constraint->getCaseSplits();
+            if ( splits.size() != 2 )
+                continue;
+
+            PiecewiseLinearCaseSplit impliedSplit =
+                ( *splits.begin() == open->second() ) ? splits.back() : splits.front();
+
+            constraint->setActiveConstraint( false );
+            recordImpliedValidSplit( impliedSplit );
+            _engine->applySplit( impliedSplit );
+
+            if ( _statistics )
+                _statistics->incLongAttribute(
+                    Statistics::NUM_CASE_SPLITS_IMPLIED_BY_CONFLICT_CLAUSES );
+
+            propagated = true;
+            break;
+        }
+    }
+
+    return true;
+}
+
+bool SmtCore::hasTwoPhases( const PiecewiseLinearConstraint *constraint ) const
+{
+    PiecewiseLinearFunctionType type = constraint->getType();
+    return type == RELU || type == ABSOLUTE_VALUE || type == SIGN || type == LEAKY_RELU;
+}
+
+void SmtCore::discardTopStackEntry()
+{
+    delete _stack.back()->_engineState;
+    delete _stack.back();
+    _stack.popBack();
+    popContext();
+}
+
+unsigned SmtCore::getNumberOfConflictClauses() const
+{
+    return _conflictClauses.size();
+}
+
 void SmtCore::resetSplitConditions()
 {
     _constraintToViolationCount.clear();
@@ -412,6 +682,24 @@ void SmtCore::allSplitsSoFar( List<PiecewiseLinearCaseSplit> &result ) const
     }
 }
 
+void SmtCore::rootValidSplits( List<PiecewiseLinearCaseSplit> &result ) const
+{
+    result.clear();
+
+    for ( const auto &it : _impliedValidSplitsAtRoot )
+        result.append( it );
+
+    for ( const auto &it : _stack )
+    {
+        if ( !it->_alternativeSplits.empty() )
+            break;
+
+        result.append( it->_activeSplit );
+        for ( const auto &impliedSplit : it->_impliedValidSplits )
+            result.append( impliedSplit );
+    }
+}
+
 void SmtCore::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
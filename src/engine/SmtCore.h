@@ -18,6 +18,7 @@
 
 #include "DivideStrategy.h"
 #include "PLConstraintScoreTracker.h"
+#include "Pair.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "SmtStackEntry.h"
@@ -110,6 +111,16 @@ public:
     /*
       Pop an old split from the stack, and perform a new split as
       needed. Return true if successful, false if the stack is empty.
+
+      With conflict-driven learning (--conflict-learning), the core
+      first looks for a small set of decisions on the stack that
+      bound propagation from the root refutes, and stores it as a
+      conflict clause. Stack entries above the deepest decision of
+      the clause are then discarded without trying their
+      alternatives. If that decision is on a two-phase constraint,
+      the core further backjumps to the level of the second-deepest
+      decision of the clause, where the clause implies the other
+      phase of the constraint.
     */
     bool popSplit();
 
@@ -140,6 +151,13 @@ public:
     */
     void allSplitsSoFar( List<PiecewiseLinearCaseSplit> &result ) const;
 
+    /*
+      Return the splits that hold at the root of the search tree: the valid
+      splits implied at the root, and the splits of the bottom stack entries
+      whose alternatives have all been refuted, with their implied splits.
+    */
+    void rootValidSplits( List<PiecewiseLinearCaseSplit> &result ) const;
+
     /*
       Have the SMT core start reporting statistics.
     */
@@ -173,6 +191,11 @@ public:
     */
     bool pickSplitPLConstraint();
 
+    /*
+      The number of conflict clauses currently stored.
+    */
+    unsigned getNumberOfConflictClauses() const;
+
     /*
       For debugging purposes only - store a correct possible solution
     */
@@ -254,6 +277,59 @@ private:
       current search state.
     */
     unsigned _numRejectedPhasePatternProposal;
+
+    /*
+      A conflict clause: case splits, each with the constraint it belongs
+      to, that cannot all hold together.
+    */
+    typedef List<Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>> ConflictClause;
+
+    /*
+      Whether conflict-driven learning is enabled, and the conflict clauses
+      learned so far, oldest first.
+    */
+    bool _learnConflicts;
+    List<ConflictClause> _conflictClauses;
+
+    /*
+      Conflict-driven learning is not used when producing proofs, as the
+      proof tree follows the case splits.
+    */
+    bool learningConflicts() const;
+
+    /*
+      Find a subset of the decisions on the stack that bound propagation
+      from the root refutes, by dropping the decisions one at a time, most
+      recent first. The (0-based, increasing) stack levels of the remaining
+      decisions are stored in conflict. Return false if even the whole
+      stack is not refuted.
+    */
+    bool analyzeConflict( List<unsigned> &conflict ) const;
+
+    /*
+      Learn a conflict clause for the current (infeasible) search state and
+      backjump as described for popSplit(). Set asserted if a phase was
+      implied at the new level; otherwise, the caller still needs to pop
+      the top of the stack. Return false if the query is refuted.
+    */
+    bool backjump( bool &asserted );
+
+    /*
+      Apply the phases implied by the conflict clauses at the current
+      search state. Return false if some clause is violated.
+    */
+    bool propagateConflictClauses();
+
+    /*
+      Whether excluding one phase of the constraint implies the other one,
+      regardless of the search state.
+    */
+    bool hasTwoPhases( const PiecewiseLinearConstraint *constraint ) const;
+
+    /*
+      Discard the top entry of the stack without restoring the engine state.
+    */
+    void discardTopStackEntry();
 };
 
 #endif // __SmtCore_h__
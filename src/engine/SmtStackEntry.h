@@ -23,20 +23,32 @@
   A stack entry consists of the engine state before the split,
   the active split, the alternative splits (in case of backtrack),
   and also any implied splits that were discovered subsequently.
+  It also records the constraint that was split on, which conflict
+  analysis needs; this is NULL for entries that were replayed from
+  a stored SmtState, and for splits on a temporary constraint of the
+  engine, such as the disjunction of an input split.
 */
 struct SmtStackEntry
 {
 public:
+    SmtStackEntry()
+        : _engineState( NULL )
+        , _constraint( NULL )
+    {
+    }
+
     PiecewiseLinearCaseSplit _activeSplit;
     List<PiecewiseLinearCaseSplit> _impliedValidSplits;
     List<PiecewiseLinearCaseSplit> _alternativeSplits;
     EngineState *_engineState;
+    PiecewiseLinearConstraint *_constraint;
 
     /*
       Create a copy of the SmtStackEntry on the stack and returns a pointer to
       the copy.
       We do not copy the engineState for now, since where this method is called,
-      we recreate the engineState by replaying the caseSplits.
+      we recreate the engineState by replaying the caseSplits. Nor do we copy the
+      constraint, as the copy may be replayed by a different engine.
     */
     SmtStackEntry *duplicateSmtStackEntry()
     {
@@ -21,7 +21,7 @@
 #include "PiecewiseLinearCaseSplit.h"
 #include "SmtState.h"
 
-#include <boost/lockfree/queue.hpp>
+#include <memory>
 #include <utility>
 
 // Struct representing a subquery
@@ -38,9 +38,6 @@ struct SubQuery
     unsigned _depth;
 };
 
-// Synchronized Queue containing the Sub-Queries shared by workers
-typedef boost::lockfree::queue<SubQuery *, boost::lockfree::fixed_sized<false>> WorkerQueue;
-
 // A vector of Sub-Queries
 
 // Guy: consider using our wrapper class Vector instead of std::vector
@@ -23,6 +23,7 @@ enum class SymbolicBoundTighteningType {
     SYMBOLIC_BOUND_TIGHTENING = 0,
     DEEP_POLY = 1,
     NONE = 2,
+    ALPHA_DEEP_POLY = 3,
 };
 
 #endif // __SymbolicBoundTighteningType_h__
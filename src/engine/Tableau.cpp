@@ -30,13 +30,17 @@
 #include "MarabouError.h"
 #include "Options.h"
 #include "PiecewiseLinearCaseSplit.h"
+#include "ReluConstraint.h"
 #include "TableauRow.h"
 #include "TableauState.h"
 
 #include <string.h>
 
+std::atomic<unsigned long long> Tableau::_nextConstraintMatrixVersion( 1 );
+
 Tableau::Tableau( IBoundManager &boundManager )
-    : _boundManager( boundManager )
+    : _watcherIndexIsValid( false )
+    , _boundManager( boundManager )
     , _lowerBounds( _boundManager.getLowerBounds() )
     , _upperBounds( _boundManager.getUpperBounds() )
     , _n( 0 )
@@ -44,12 +48,13 @@ Tableau::Tableau( IBoundManager &boundManager )
     , _A( NULL )
     , _sparseColumnsOfA( NULL )
     , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
     , _changeColumn( NULL )
     , _pivotRow( NULL )
     , _b( NULL )
     , _workM( NULL )
     , _workN( NULL )
+    , _hypersparseIndices( NULL )
+    , _hypersparseResultIndices( NULL )
     , _unitVector( NULL )
     , _basisFactorization( NULL )
     , _multipliers( NULL )
@@ -62,9 +67,13 @@ Tableau::Tableau( IBoundManager &boundManager )
     , _basicAssignmentStatus( ITableau::BASIC_ASSIGNMENT_INVALID )
     , _statistics( NULL )
     , _costFunctionManager( NULL )
+    , _constraintMatrixVersion( 0 )
     , _rhsIsAllZeros( true )
     , _lpSolverType( Options::get()->getLPSolverType() )
     , _gurobi( nullptr )
+    , _longStepEnteringVariable( 0 )
+    , _longStepLeavingVariable( 0 )
+    , _longStepBreakpointsPassed( 0 )
 {
 }
 
@@ -111,12 +120,6 @@ void Tableau::freeMemoryIfNeeded()
         _sparseRowsOfA = NULL;
     }
 
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
-
     if ( _changeColumn )
     {
         delete[] _changeColumn;
@@ -200,6 +203,18 @@ void Tableau::freeMemoryIfNeeded()
         delete[] _workN;
         _workN = NULL;
     }
+
+    if ( _hypersparseIndices )
+    {
+        delete[] _hypersparseIndices;
+        _hypersparseIndices = NULL;
+    }
+
+    if ( _hypersparseResultIndices )
+    {
+        delete[] _hypersparseResultIndices;
+        _hypersparseResultIndices = NULL;
+    }
 }
 
 void Tableau::setDimensions( unsigned m, unsigned n )
@@ -209,6 +224,8 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 
     if ( _lpSolverType == LPSolverType::NATIVE )
     {
+        constraintMatrixChanged();
+
         _A = new CSRMatrix();
         if ( !_A )
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::A" );
@@ -236,10 +253,6 @@ void Tableau::setDimensions( unsigned m, unsigned n )
                 throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA[i]" );
         }
 
-        _denseA = new double[m * n];
-        if ( !_denseA )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseA" );
-
         _changeColumn = new double[m];
         if ( !_changeColumn )
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::changeColumn" );
@@ -298,6 +311,15 @@ void Tableau::setDimensions( unsigned m, unsigned n )
         if ( !_workN )
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::work" );
 
+        _hypersparseIndices = new unsigned[m];
+        if ( !_hypersparseIndices )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::hypersparseIndices" );
+
+        _hypersparseResultIndices = new unsigned[m];
+        if ( !_hypersparseResultIndices )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                                "Tableau::hypersparseResultIndices" );
+
         if ( _statistics )
         {
             _statistics->setUnsignedAttribute( Statistics::CURRENT_TABLEAU_M, _m );
@@ -308,18 +330,43 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 
 void Tableau::setConstraintMatrix( const double *A )
 {
-    _A->initialize( A, _m, _n );
+    constraintMatrixChanged();
 
-    for ( unsigned column = 0; column < _n; ++column )
+    for ( unsigned row = 0; row < _m; ++row )
+        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
+
+    initializeColumnsFromRows();
+}
+
+void Tableau::setConstraintMatrix( const SparseUnsortedArrays *A )
+{
+    constraintMatrixChanged();
+
+    for ( unsigned row = 0; row < _m; ++row )
     {
-        for ( unsigned row = 0; row < _m; ++row )
-            _denseA[column * _m + row] = A[row * _n + column];
+        _sparseRowsOfA[row]->clear();
 
-        _sparseColumnsOfA[column]->initialize( _denseA + ( column * _m ), _m );
+        const SparseUnsortedArray *sparseRow = A->getRow( row );
+        const SparseUnsortedArray::Entry *entries = sparseRow->getArray();
+        for ( unsigned i = 0; i < sparseRow->getNnz(); ++i )
+            _sparseRowsOfA[row]->append( entries[i]._index, entries[i]._value );
     }
 
+    initializeColumnsFromRows();
+}
+
+void Tableau::initializeColumnsFromRows()
+{
+    for ( unsigned column = 0; column < _n; ++column )
+        _sparseColumnsOfA[column]->clear();
+
     for ( unsigned row = 0; row < _m; ++row )
-        _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
+    {
+        for ( const auto &entry : *_sparseRowsOfA[row] )
+            _sparseColumnsOfA[entry._index]->append( row, entry._value );
+    }
+
+    _A->initialize( (const SparseUnsortedList **)_sparseRowsOfA, _m, _n );
 }
 
 void Tableau::markAsBasic( unsigned variable )
@@ -527,6 +574,8 @@ unsigned Tableau::variableToIndex( unsigned index ) const
 
 void Tableau::setRightHandSide( const double *b )
 {
+    constraintMatrixChanged();
+
     memcpy( _b, b, sizeof( double ) * _m );
 
     for ( unsigned i = 0; i < _m; ++i )
@@ -538,6 +587,8 @@ void Tableau::setRightHandSide( const double *b )
 
 void Tableau::setRightHandSide( unsigned index, double value )
 {
+    constraintMatrixChanged();
+
     _b[index] = value;
 
     if ( !FloatUtils::isZero( value ) )
@@ -580,7 +631,7 @@ void Tableau::computeCostFunction()
 
 void Tableau::computeMultipliers( double *rowCoefficients )
 {
-    _basisFactorization->backwardTransformation( rowCoefficients, _multipliers );
+    backwardTransformation( rowCoefficients, _multipliers );
 }
 
 unsigned Tableau::getBasicStatus( unsigned basic )
@@ -699,6 +750,17 @@ void Tableau::performPivot()
     unsigned nonBasic;
     (void)decrease;
     (void)nonBasic;
+    if ( _statistics && _longStepBreakpointsPassed > 0 &&
+         _enteringVariable == _longStepEnteringVariable &&
+         _leavingVariable == _longStepLeavingVariable )
+    {
+        _statistics->incLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED,
+                                       _longStepBreakpointsPassed );
+        if ( _leavingVariable == _m )
+            _statistics->incLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BOUND_FLIPS );
+    }
+    _longStepBreakpointsPassed = 0;
+
     if ( _leavingVariable == _m )
     {
         if ( _statistics )
@@ -789,8 +851,8 @@ void Tableau::performPivot()
 
     // Update the basis factorization. The column corresponding to the
     // leaving variable is the one that has changed
-    _basisFactorization->updateToAdjacentBasis(
-        _leavingVariable, _changeColumn, getAColumn( currentNonBasic ) );
+    getAColumn( currentNonBasic, _workM );
+    _basisFactorization->updateToAdjacentBasis( _leavingVariable, _changeColumn, _workM );
 
     if ( _statistics )
     {
@@ -831,8 +893,8 @@ void Tableau::performDegeneratePivot()
     _variableToIndex[currentNonBasic] = _leavingVariable;
 
     // Update the basis factorization
-    _basisFactorization->updateToAdjacentBasis(
-        _leavingVariable, _changeColumn, getAColumn( currentNonBasic ) );
+    getAColumn( currentNonBasic, _workM );
+    _basisFactorization->updateToAdjacentBasis( _leavingVariable, _changeColumn, _workM );
 
     // Switch assignment values. No call to notify is required,
     // because values haven't changed.
@@ -955,7 +1017,9 @@ void Tableau::pickLeavingVariable()
 
 void Tableau::pickLeavingVariable( double *changeColumn )
 {
-    if ( GlobalConfiguration::USE_HARRIS_RATIO_TEST )
+    if ( GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST && !isOptimizing() )
+        boundFlippingRatioTest( changeColumn );
+    else if ( GlobalConfiguration::USE_HARRIS_RATIO_TEST )
         harrisRatioTest( changeColumn );
     else
         standardRatioTest( changeColumn );
@@ -1439,6 +1503,323 @@ void Tableau::harrisRatioTest( double *changeColumn )
     ASSERT( _leavingVariable != _m );
 }
 
+void Tableau::boundFlippingRatioTest( double *changeColumn )
+{
+    /*
+      A long-step variant of the Harris ratio test, used while
+      minimizing the sum of infeasibilities.
+
+      Let t >= 0 denote the step taken by the entering variable in its
+      improving direction. The slope of the cost function along this
+      direction is the sum of the rates of change of the out-of-bounds
+      basics, each signed by its basic cost. Whenever an out-of-bounds basic
+      variable that is moving towards its violated bound reaches it,
+      its contribution to the cost function disappears, and the slope
+      increases by the rate at which that basic changes. These are the
+      breakpoints. The Harris test stops at the first breakpoint,
+      whereas here we keep going for as long as the slope remains
+      negative, i.e. the sum of infeasibilities keeps decreasing. The
+      step is bounded by (i) basic variables that are within their
+      bounds, which must not leave them; (ii) the far bounds of the
+      out-of-bounds basics; and (iii) the range of the entering
+      variable itself. The steps are computed with the Harris
+      tolerances, and the leaving variable is:
+
+      1. The basic variable of the breakpoint at which the slope
+         becomes non-negative, if we reach one; otherwise,
+      2. If the entering variable's range is the tightest limit, a
+         fake pivot: the entering variable flips to its other bound;
+      3. If a within-bounds basic is the tightest limit, the one with
+         the largest pivot element among those that hit their bound,
+         as in the Harris test;
+      4. If a far bound is the tightest limit, we stop at the last
+         breakpoint passed (at worst, the near bound of that same
+         basic).
+    */
+
+    ASSERT( !isOptimizing() );
+    ASSERT( !FloatUtils::isZero( _costFunctionManager->getCostFunction()[_enteringVariable] ) );
+
+    double reducedCost = _costFunctionManager->getCostFunction()[_enteringVariable];
+    bool enteringDecreases = FloatUtils::isPositive( reducedCost );
+    double direction = enteringDecreases ? -1 : 1;
+
+    _longStepBreakpointsPassed = 0;
+    _longStepEnteringVariable = _enteringVariable;
+
+    // Limit (iii): the range of the entering variable
+    unsigned entering = _nonBasicIndexToVariable[_enteringVariable];
+    double enteringRange = enteringDecreases
+                             ? _nonBasicAssignment[_enteringVariable] - getLowerBound( entering )
+                             : getUpperBound( entering ) - _nonBasicAssignment[_enteringVariable];
+    if ( enteringRange < 0 )
+        enteringRange = 0;
+
+    // Limits (i) and (ii), and the breakpoints
+    double feasibleBasicLimit = FloatUtils::infinity();
+    double farBoundLimit = FloatUtils::infinity();
+    double slope = 0;
+    _breakpoints.clear();
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( FloatUtils::abs( changeColumn[i] ) <
+             GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        // The rate at which the basic variable changes, per unit step
+        double rate = -changeColumn[i] * direction;
+        unsigned basic = _basicIndexToVariable[i];
+        double basicCost = _costFunctionManager->getBasicCost( i );
+        slope += basicCost * rate;
+
+        // Out-of-bounds basics moving away from their violated bounds impose no limit
+        if ( ( basicCost > 0 && rate > 0 ) || ( basicCost < 0 && rate < 0 ) )
+            continue;
+
+        bool isBreakpoint = ( basicCost < 0 && _basicStatus[i] == Tableau::BELOW_LB ) ||
+                            ( basicCost > 0 && _basicStatus[i] == Tableau::ABOVE_UB );
+
+        // The bound that stops this basic: the far bound for breakpoints, or as in Harris
+        double bound;
+        if ( isBreakpoint || basicCost == 0 )
+            bound = rate > 0 ? getUpperBound( basic ) : getLowerBound( basic );
+        else
+            bound = rate > 0 ? getLowerBound( basic ) : getUpperBound( basic );
+
+        double delta = GlobalConfiguration::HARRIS_RATIO_CONSTRAINT_ADDITIVE_TOLERANCE +
+                       FloatUtils::abs( bound ) *
+                           GlobalConfiguration::HARRIS_RATIO_CONSTRAINT_MULTIPLICATIVE_TOLERANCE;
+        double relaxedBound = rate > 0 ? bound + delta : bound - delta;
+        double step = ( relaxedBound - _basicAssignment[i] ) / rate;
+        if ( step < 0 )
+            step = 0;
+
+        if ( !isBreakpoint )
+        {
+            if ( step < feasibleBasicLimit )
+                feasibleBasicLimit = step;
+            continue;
+        }
+
+        if ( step < farBoundLimit )
+            farBoundLimit = step;
+
+        Breakpoint breakpoint;
+        double nearBound = rate > 0 ? getLowerBound( basic ) : getUpperBound( basic );
+        breakpoint._step = ( nearBound - _basicAssignment[i] ) / rate;
+        if ( breakpoint._step < 0 )
+            breakpoint._step = 0;
+        breakpoint._basicIndex = i;
+        breakpoint._slopeChange = FloatUtils::abs( rate );
+        _breakpoints.append( breakpoint );
+    }
+
+    double limit = FloatUtils::min(
+        enteringRange, FloatUtils::min( feasibleBasicLimit, farBoundLimit ) );
+
+    // The reduced cost may be inaccurate; if this direction does not improve, be conservative
+    if ( !FloatUtils::isNegative( slope ) )
+    {
+        harrisRatioTest( changeColumn );
+        return;
+    }
+
+    // Walk the breakpoints in order, for as long as the cost keeps decreasing
+    _breakpoints.sort();
+    unsigned lastPassed = _m;
+    double lastPassedStep = 0;
+    for ( const auto &breakpoint : _breakpoints )
+    {
+        if ( breakpoint._step > limit )
+            break;
+
+        slope += breakpoint._slopeChange;
+        if ( !FloatUtils::isNegative( slope ) )
+        {
+            // Case 1: the cost no longer decreases beyond this breakpoint
+            _leavingVariable = breakpoint._basicIndex;
+            _changeRatio = direction * breakpoint._step;
+            _leavingVariableIncreases = ( direction * -changeColumn[_leavingVariable] ) > 0;
+            _longStepLeavingVariable = _leavingVariable;
+            return;
+        }
+
+        ++_longStepBreakpointsPassed;
+        lastPassed = breakpoint._basicIndex;
+        lastPassedStep = breakpoint._step;
+    }
+
+    if ( enteringRange <= feasibleBasicLimit && enteringRange <= farBoundLimit )
+    {
+        // Case 2: the entering variable flips to its other bound
+        _leavingVariable = _m;
+        _changeRatio = direction * enteringRange;
+        _longStepLeavingVariable = _m;
+        return;
+    }
+
+    if ( feasibleBasicLimit <= farBoundLimit )
+    {
+        // Case 3: a basic variable within its bounds hits one of them
+        double largestPivot = 0;
+        _leavingVariable = _m;
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            if ( FloatUtils::abs( changeColumn[i] ) <
+                 GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+                continue;
+
+            if ( _costFunctionManager->getBasicCost( i ) != 0 ||
+                 _basicStatus[i] == Tableau::BELOW_LB || _basicStatus[i] == Tableau::ABOVE_UB )
+                continue;
+
+            double rate = -changeColumn[i] * direction;
+            unsigned basic = _basicIndexToVariable[i];
+            double bound = rate > 0 ? getUpperBound( basic ) : getLowerBound( basic );
+            double step = ( bound - _basicAssignment[i] ) / rate;
+            if ( step < 0 )
+                step = 0;
+
+            double pivot = FloatUtils::abs( changeColumn[i] );
+            if ( step <= feasibleBasicLimit && pivot > largestPivot )
+            {
+                largestPivot = pivot;
+                _leavingVariable = i;
+                _changeRatio = direction * step;
+                _leavingVariableIncreases = rate > 0;
+            }
+        }
+
+        if ( _leavingVariable != _m )
+        {
+            _longStepLeavingVariable = _leavingVariable;
+            return;
+        }
+    }
+
+    /*
+      Case 4, or a degenerate case 3 where the tightest limit was
+      imposed by a basic whose cost and status disagree. If no
+      breakpoint was passed, fall back to the Harris test.
+    */
+    if ( lastPassed == _m )
+    {
+        _longStepBreakpointsPassed = 0;
+        harrisRatioTest( changeColumn );
+        return;
+    }
+
+    --_longStepBreakpointsPassed;
+    _leavingVariable = lastPassed;
+    _changeRatio = direction * lastPassedStep;
+    _leavingVariableIncreases = ( direction * -changeColumn[_leavingVariable] ) > 0;
+    _longStepLeavingVariable = _leavingVariable;
+}
+
+bool Tableau::pickDualLeavingVariable()
+{
+    /*
+      Dual pricing: among the out-of-bounds basic variables, pick the
+      one with the largest bound violation.
+    */
+    _leavingVariable = _m;
+    double largestViolation = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        double violation;
+        if ( _basicStatus[i] == Tableau::BELOW_LB )
+            violation = getLowerBound( _basicIndexToVariable[i] ) - _basicAssignment[i];
+        else if ( _basicStatus[i] == Tableau::ABOVE_UB )
+            violation = _basicAssignment[i] - getUpperBound( _basicIndexToVariable[i] );
+        else
+            continue;
+
+        if ( violation > largestViolation )
+        {
+            largestViolation = violation;
+            _leavingVariable = i;
+        }
+    }
+
+    if ( _leavingVariable == _m )
+        return false;
+
+    // The leaving variable moves towards its violated bound
+    _leavingVariableIncreases = ( _basicStatus[_leavingVariable] == Tableau::BELOW_LB );
+    return true;
+}
+
+bool Tableau::pickDualEnteringVariable()
+{
+    /*
+      The dual ratio test. The pivot row expresses the leaving
+      variable as x_r = sum_j alpha_j * x_j + scalar.
+
+      Because the engine searches for a feasible point, the objective
+      is zero and every basis is dual feasible: all dual ratios tie at
+      zero. A non-basic x_j is thus eligible if it can move x_r towards
+      its violated bound, i.e. if it can increase (decrease) when
+      alpha_j and the direction of x_r agree (disagree). Among the
+      eligible variables we prefer those that can absorb the entire
+      change without crossing their own bounds, and then the largest
+      |alpha_j|, for numerical stability.
+    */
+    ASSERT( _leavingVariable < _m );
+
+    unsigned leaving = _basicIndexToVariable[_leavingVariable];
+    double targetValue =
+        _leavingVariableIncreases ? getLowerBound( leaving ) : getUpperBound( leaving );
+    double basicDelta = targetValue - _basicAssignment[_leavingVariable];
+
+    unsigned bestEntering = _n - _m;
+    double largestPivot = 0;
+    unsigned bestEnteringWithinBounds = _n - _m;
+    double largestPivotWithinBounds = 0;
+
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        double alpha = _pivotRow->_row[i]._coefficient;
+        double pivot = FloatUtils::abs( alpha );
+        if ( pivot < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        bool nonBasicIncreases = ( alpha > 0 ) == _leavingVariableIncreases;
+        if ( nonBasicIncreases ? !nonBasicCanIncrease( i ) : !nonBasicCanDecrease( i ) )
+            continue;
+
+        if ( pivot > largestPivot )
+        {
+            largestPivot = pivot;
+            bestEntering = i;
+        }
+
+        unsigned nonBasic = _nonBasicIndexToVariable[i];
+        double newValue = _nonBasicAssignment[i] + basicDelta / alpha;
+        bool withinBounds = nonBasicIncreases
+                              ? FloatUtils::lte( newValue, getUpperBound( nonBasic ) )
+                              : FloatUtils::gte( newValue, getLowerBound( nonBasic ) );
+
+        if ( withinBounds && pivot > largestPivotWithinBounds )
+        {
+            largestPivotWithinBounds = pivot;
+            bestEnteringWithinBounds = i;
+        }
+    }
+
+    if ( bestEntering == _n - _m )
+        return false;
+
+    if ( bestEnteringWithinBounds != _n - _m &&
+         largestPivotWithinBounds >= GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+        _enteringVariable = bestEnteringWithinBounds;
+    else
+        _enteringVariable = bestEntering;
+
+    _changeRatio = basicDelta / _pivotRow->_row[_enteringVariable]._coefficient;
+    return true;
+}
+
 double Tableau::getChangeRatio() const
 {
     return _changeRatio;
@@ -1452,8 +1833,8 @@ void Tableau::setChangeRatio( double changeRatio )
 void Tableau::computeChangeColumn()
 {
     // Compute d = inv(B) * a using the basis factorization
-    const double *a = getAColumn( _nonBasicIndexToVariable[_enteringVariable] );
-    _basisFactorization->forwardTransformation( a, _changeColumn );
+    getAColumn( _nonBasicIndexToVariable[_enteringVariable], _workM );
+    forwardTransformation( _workM, _changeColumn );
 }
 
 const double *Tableau::getChangeColumn() const
@@ -1584,10 +1965,13 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
         row->_row[i]._var = _nonBasicIndexToVariable[i];
         row->_row[i]._coefficient = 0;
 
-        SparseUnsortedList *column = _sparseColumnsOfA[_nonBasicIndexToVariable[i]];
+        const SparseUnsortedList *column = _sparseColumnsOfA[_nonBasicIndexToVariable[i]];
+        const unsigned *indices = column->getIndices();
+        const double *values = column->getValues();
+        unsigned nnz = column->getNnz();
 
-        for ( const auto &entry : *column )
-            row->_row[i]._coefficient -= ( _multipliers[entry._index] * entry._value );
+        for ( unsigned j = 0; j < nnz; ++j )
+            row->_row[i]._coefficient -= ( _multipliers[indices[j]] * values[j] );
     }
 
     /*
@@ -1611,9 +1995,9 @@ const SparseMatrix *Tableau::getSparseA() const
     return _A;
 }
 
-const double *Tableau::getAColumn( unsigned variable ) const
+void Tableau::getAColumn( unsigned variable, double *result ) const
 {
-    return _denseA + ( variable * _m );
+    _sparseColumnsOfA[variable]->toDense( result );
 }
 
 void Tableau::getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const
@@ -1661,16 +2045,27 @@ void Tableau::storeState( TableauState &state, TableauStateStorageLevel level )
         // Set the dimensions
         state.setDimensions( _m, _n, *this );
 
-        // Store matrix A
-        _A->storeIntoOther( state._A );
-        for ( unsigned i = 0; i < _n; ++i )
-            _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
-        for ( unsigned i = 0; i < _m; ++i )
-            _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
-        memcpy( state._denseA, _denseA, sizeof( double ) * _m * _n );
+        // Copy matrix A, the right hand side vector _b and the merged variables, unless they
+        // are unchanged since the last copy
+        if ( !_storedConstraintMatrix ||
+             _storedConstraintMatrix->_version != _constraintMatrixVersion )
+        {
+            TableauState::ConstraintMatrix *constraintMatrix =
+                new TableauState::ConstraintMatrix( _m, _n, _constraintMatrixVersion );
 
-        // Store right hand side vector _b
-        memcpy( state._b, _b, sizeof( double ) * _m );
+            _A->storeIntoOther( constraintMatrix->_A );
+            for ( unsigned i = 0; i < _n; ++i )
+                _sparseColumnsOfA[i]->storeIntoOther( constraintMatrix->_sparseColumnsOfA[i] );
+            for ( unsigned i = 0; i < _m; ++i )
+                _sparseRowsOfA[i]->storeIntoOther( constraintMatrix->_sparseRowsOfA[i] );
+
+            memcpy( constraintMatrix->_b, _b, sizeof( double ) * _m );
+
+            constraintMatrix->_mergedVariables = _mergedVariables;
+
+            _storedConstraintMatrix.reset( constraintMatrix );
+        }
+        state._constraintMatrix = _storedConstraintMatrix;
 
         // Basic variables
         state._basicVariables = _basicVariables;
@@ -1689,9 +2084,6 @@ void Tableau::storeState( TableauState &state, TableauStateStorageLevel level )
 
         // Store the basis factorization
         _basisFactorization->storeFactorization( state._basisFactorization );
-
-        // Store the merged variables
-        state._mergedVariables = _mergedVariables;
     }
     else
     {
@@ -1724,20 +2116,35 @@ void Tableau::restoreState( const TableauState &state, TableauStateStorageLevel
     }
     else if ( level == TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE )
     {
-        freeMemoryIfNeeded();
+        /*
+          If the constraint matrix is the one that was stored, only the basis and the
+          assignment need to be restored. Otherwise, rebuild the tableau from the state.
+        */
+        const TableauState::ConstraintMatrix &constraintMatrix = *state._constraintMatrix;
+        if ( constraintMatrix._version != _constraintMatrixVersion )
+        {
+            freeMemoryIfNeeded();
 
-        setDimensions( state._m, state._n );
+            setDimensions( state._m, state._n );
 
-        // Restore matrix A
-        state._A->storeIntoOther( _A );
-        for ( unsigned i = 0; i < _n; ++i )
-            state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
-        for ( unsigned i = 0; i < _m; ++i )
-            state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
-        memcpy( _denseA, state._denseA, sizeof( double ) * _m * _n );
+            // Restore matrix A
+            constraintMatrix._A->storeIntoOther( _A );
+            for ( unsigned i = 0; i < _n; ++i )
+                constraintMatrix._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
+            for ( unsigned i = 0; i < _m; ++i )
+                constraintMatrix._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
 
-        // Restore right hand side vector _b
-        memcpy( _b, state._b, sizeof( double ) * _m );
+            // Restore right hand side vector _b
+            memcpy( _b, constraintMatrix._b, sizeof( double ) * _m );
+
+            // Restore the merged variables
+            _mergedVariables = constraintMatrix._mergedVariables;
+
+            _constraintMatrixVersion = constraintMatrix._version;
+            _storedConstraintMatrix = state._constraintMatrix;
+        }
+        else if ( _statistics )
+            _statistics->incLongAttribute( Statistics::NUM_INCREMENTAL_TABLEAU_RESTORATIONS );
 
         // Basic variables
         _basicVariables = state._basicVariables;
@@ -1757,9 +2164,6 @@ void Tableau::restoreState( const TableauState &state, TableauStateStorageLevel
         // Restore the basis factorization
         _basisFactorization->restoreFactorization( state._basisFactorization );
 
-        // Restore the merged variables
-        _mergedVariables = state._mergedVariables;
-
         computeAssignment();
         _costFunctionManager->initialize();
         computeCostFunction();
@@ -1876,13 +2280,11 @@ unsigned Tableau::addEquation( const Equation &equation )
         _workN[addend._variable] = addend._coefficient;
         _sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
         _sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
-        _denseA[( addend._variable * _m ) + _m - 1] = addend._coefficient;
     }
 
     _workN[auxVariable] = 1;
     _sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
     _sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
-    _denseA[( auxVariable * _m ) + _m - 1] = 1;
     _A->addLastRow( _workN );
 
     // Invalidate the cost function, so that it is recomputed in the next iteration.
@@ -1981,6 +2383,8 @@ unsigned Tableau::addEquation( const Equation &equation )
 
 void Tableau::addRow()
 {
+    constraintMatrixChanged();
+
     unsigned newM = _m + 1;
     unsigned newN = _n + 1;
 
@@ -2028,21 +2432,6 @@ void Tableau::addRow()
     delete[] _sparseRowsOfA;
     _sparseRowsOfA = newSparseRowsOfA;
 
-    // Allocate a larger _denseA, keep old entries
-    double *newDenseA = new double[newM * newN];
-    if ( !newDenseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseA" );
-
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        memcpy( newDenseA + ( column * newM ), _denseA + ( column * _m ), sizeof( double ) * _m );
-        newDenseA[column * newM + newM - 1] = 0.0;
-    }
-    std::fill_n( newDenseA + ( newN - 1 ) * newM, newM, 0.0 );
-
-    delete[] _denseA;
-    _denseA = newDenseA;
-
     // Allocate a new changeColumn. Don't need to initialize
     double *newChangeColumn = new double[newM];
     if ( !newChangeColumn )
@@ -2128,6 +2517,19 @@ void Tableau::addRow()
     delete[] _workN;
     _workN = newWorkN;
 
+    unsigned *newHypersparseIndices = new unsigned[newM];
+    if ( !newHypersparseIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newHypersparseIndices" );
+    delete[] _hypersparseIndices;
+    _hypersparseIndices = newHypersparseIndices;
+
+    unsigned *newHypersparseResultIndices = new unsigned[newM];
+    if ( !newHypersparseResultIndices )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                            "Tableau::newHypersparseResultIndices" );
+    delete[] _hypersparseResultIndices;
+    _hypersparseResultIndices = newHypersparseResultIndices;
+
     _m = newM;
     _n = newN;
     _costFunctionManager->initialize();
@@ -2143,14 +2545,21 @@ void Tableau::addRow()
     }
 }
 
+void Tableau::constraintMatrixChanged()
+{
+    _constraintMatrixVersion = _nextConstraintMatrixVersion++;
+}
+
 void Tableau::registerToWatchVariable( VariableWatcher *watcher, unsigned variable )
 {
     _variableToWatchers[variable].append( watcher );
+    _watcherIndexIsValid = false;
 }
 
 void Tableau::unregisterToWatchVariable( VariableWatcher *watcher, unsigned variable )
 {
     _variableToWatchers[variable].erase( watcher );
+    _watcherIndexIsValid = false;
 }
 
 void Tableau::registerToWatchAllVariables( VariableWatcher *watcher )
@@ -2163,15 +2572,60 @@ void Tableau::registerResizeWatcher( ResizeWatcher *watcher )
     _resizeWatchers.append( watcher );
 }
 
+void Tableau::buildWatcherIndex()
+{
+    unsigned numVariables = 0;
+    for ( const auto &pair : _variableToWatchers )
+    {
+        if ( !pair.second.empty() && pair.first >= numVariables )
+            numVariables = pair.first + 1;
+    }
+
+    _watcherOffsets.assign( numVariables + 1, 0 );
+    for ( const auto &pair : _variableToWatchers )
+    {
+        if ( pair.first < numVariables )
+            _watcherOffsets[pair.first + 1] = pair.second.size();
+    }
+
+    for ( unsigned i = 0; i < numVariables; ++i )
+        _watcherOffsets[i + 1] += _watcherOffsets[i];
+
+    WatcherIndexEntry empty = { NULL, NULL };
+    _watcherIndex.assign( _watcherOffsets[numVariables], empty );
+    for ( const auto &pair : _variableToWatchers )
+    {
+        unsigned position = _watcherOffsets[pair.first];
+        for ( const auto &watcher : pair.second )
+        {
+            _watcherIndex[position]._watcher = watcher;
+            _watcherIndex[position]._relu = dynamic_cast<ReluConstraint *>( watcher );
+            ++position;
+        }
+    }
+
+    _watcherIndexIsValid = true;
+}
+
 void Tableau::notifyLowerBound( unsigned variable, double bound )
 {
     for ( auto &watcher : _globalWatchers )
         watcher->notifyLowerBound( variable, bound );
 
-    if ( _variableToWatchers.exists( variable ) )
+    if ( !_watcherIndexIsValid )
+        buildWatcherIndex();
+
+    if ( variable + 1 >= _watcherOffsets.size() )
+        return;
+
+    const unsigned *offsets = _watcherOffsets.data();
+    const WatcherIndexEntry *entries = _watcherIndex.data();
+    for ( unsigned i = offsets[variable]; i < offsets[variable + 1]; ++i )
     {
-        for ( auto &watcher : _variableToWatchers[variable] )
-            watcher->notifyLowerBound( variable, bound );
+        if ( entries[i]._relu )
+            entries[i]._relu->notifyLowerBound( variable, bound );
+        else
+            entries[i]._watcher->notifyLowerBound( variable, bound );
     }
 }
 
@@ -2180,10 +2634,20 @@ void Tableau::notifyUpperBound( unsigned variable, double bound )
     for ( auto &watcher : _globalWatchers )
         watcher->notifyUpperBound( variable, bound );
 
-    if ( _variableToWatchers.exists( variable ) )
+    if ( !_watcherIndexIsValid )
+        buildWatcherIndex();
+
+    if ( variable + 1 >= _watcherOffsets.size() )
+        return;
+
+    const unsigned *offsets = _watcherOffsets.data();
+    const WatcherIndexEntry *entries = _watcherIndex.data();
+    for ( unsigned i = offsets[variable]; i < offsets[variable + 1]; ++i )
     {
-        for ( auto &watcher : _variableToWatchers[variable] )
-            watcher->notifyUpperBound( variable, bound );
+        if ( entries[i]._relu )
+            entries[i]._relu->notifyUpperBound( variable, bound );
+        else
+            entries[i]._watcher->notifyUpperBound( variable, bound );
     }
 }
 
@@ -2192,14 +2656,53 @@ const double *Tableau::getRightHandSide() const
     return _b;
 }
 
+bool Tableau::useHypersparseTransformation( const double *y, unsigned &nnz ) const
+{
+    if ( !_basisFactorization->supportsHypersparseTransformations() )
+        return false;
+
+    unsigned maxNnz =
+        (unsigned)( _m * GlobalConfiguration::HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD );
+
+    nnz = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( y[i] != 0.0 )
+        {
+            if ( nnz == maxNnz )
+                return false;
+
+            _hypersparseIndices[nnz++] = i;
+        }
+    }
+
+    return true;
+}
+
 void Tableau::forwardTransformation( const double *y, double *x ) const
 {
-    _basisFactorization->forwardTransformation( y, x );
+    unsigned nnz;
+    if ( useHypersparseTransformation( y, nnz ) )
+    {
+        std::fill_n( x, _m, 0.0 );
+        _basisFactorization->hypersparseForwardTransformation(
+            y, _hypersparseIndices, nnz, x, _hypersparseResultIndices );
+    }
+    else
+        _basisFactorization->forwardTransformation( y, x );
 }
 
 void Tableau::backwardTransformation( const double *y, double *x ) const
 {
-    _basisFactorization->backwardTransformation( y, x );
+    unsigned nnz;
+    if ( useHypersparseTransformation( y, nnz ) )
+    {
+        std::fill_n( x, _m, 0.0 );
+        _basisFactorization->hypersparseBackwardTransformation(
+            y, _hypersparseIndices, nnz, x, _hypersparseResultIndices );
+    }
+    else
+        _basisFactorization->backwardTransformation( y, x );
 }
 
 double Tableau::getSumOfInfeasibilities() const
@@ -2541,6 +3044,11 @@ void Tableau::refreshBasisFactorization()
     _basisFactorization->obtainFreshBasis();
 }
 
+void Tableau::notifyDegradation( double degradation )
+{
+    _basisFactorization->notifyDegradation( degradation );
+}
+
 unsigned Tableau::getVariableAfterMerging( unsigned variable ) const
 {
     unsigned answer = variable;
@@ -2574,6 +3082,8 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
       Merge column x2 of the constraint matrix into x1
       and zero-out column x2
     */
+    constraintMatrixChanged();
+
     _A->mergeColumns( x1, x2 );
     _mergedVariables[x2] = x1;
 
@@ -2584,11 +3094,6 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
     for ( unsigned i = 0; i < _m; ++i )
         _sparseRowsOfA[i]->mergeEntries( x2, x1 );
 
-    // And the dense ones, too
-    for ( unsigned i = 0; i < _m; ++i )
-        _denseA[x1 * _m + i] += _denseA[x2 * _m + i];
-    std::fill_n( _denseA + x2 * _m, _m, 0 );
-
     computeAssignment();
     computeCostFunction();
 
@@ -2614,8 +3119,8 @@ bool Tableau::areLinearlyDependent( unsigned x1,
     unsigned nonBasic = oneIsBasic ? x2 : x1;
 
     // Find the column of the non-basic
-    const double *a = getAColumn( nonBasic );
-    _basisFactorization->forwardTransformation( a, _workM );
+    getAColumn( nonBasic, _workN );
+    _basisFactorization->forwardTransformation( _workN, _workM );
 
     // Find the correct entry in the column
     unsigned basicIndex = _variableToIndex[basic];
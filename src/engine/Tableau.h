@@ -26,15 +26,21 @@
 #include "Set.h"
 #include "SparseColumnsOfBasis.h"
 #include "SparseMatrix.h"
+#include "SparseUnsortedArrays.h"
 #include "SparseUnsortedList.h"
 #include "Statistics.h"
+#include "TableauState.h"
+#include "Vector.h"
+
+#include <atomic>
+#include <memory>
 
 #define TABLEAU_LOG( x, ... ) LOG( GlobalConfiguration::TABLEAU_LOGGING, "Tableau: %s\n", x )
 
 class Equation;
 class ICostFunctionManager;
 class PiecewiseLinearCaseSplit;
-class TableauState;
+class ReluConstraint;
 
 class Tableau
     : public ITableau
@@ -52,9 +58,11 @@ public:
     void setDimensions( unsigned m, unsigned n );
 
     /*
-      Initialize the constraint matrix
+      Initialize the constraint matrix, given either in dense
+      (row-major) form or as a collection of sparse rows
     */
     void setConstraintMatrix( const double *A );
+    void setConstraintMatrix( const SparseUnsortedArrays *A );
 
     /*
       Set which variable will enter the basis. The input is the
@@ -83,6 +91,8 @@ public:
 
     /*
       Perform backward/forward transformations using the basis factorization.
+      Sparse right-hand sides are handled hypersparsely, if the factorization
+      supports it.
     */
     void forwardTransformation( const double *y, double *x ) const;
     void backwardTransformation( const double *y, double *x ) const;
@@ -237,6 +247,20 @@ public:
     double getChangeRatio() const;
     void setChangeRatio( double changeRatio );
 
+    /*
+      Dual simplex support. The dual pricing rule picks the basic
+      variable with the largest bound violation as the leaving
+      variable, and returns false if all basic variables are within
+      bounds. The dual ratio test, invoked once the pivot row for the
+      leaving variable has been computed, picks an entering variable
+      that can move the leaving variable towards its violated bound.
+      It returns false if no such variable exists, in which case the
+      pivot row proves that the leaving variable's bound cannot be
+      satisfied.
+    */
+    bool pickDualLeavingVariable();
+    bool pickDualEnteringVariable();
+
     /*
       Returns true iff the current iteration is a fake pivot, i.e. the
       entering variable jumping from one bound to the other.
@@ -335,11 +359,11 @@ public:
     void getTableauRow( unsigned index, TableauRow *row );
 
     /*
-      Get the original constraint matrix A or a column thereof,
-      in dense form.
+      Get the original constraint matrix A, or a column thereof
+      in dense form (written into result, of size m).
     */
     const SparseMatrix *getSparseA() const;
-    const double *getAColumn( unsigned variable ) const;
+    void getAColumn( unsigned variable, double *result ) const;
     void getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const;
     void getSparseARow( unsigned row, SparseUnsortedList *result ) const;
     const SparseUnsortedList *getSparseAColumn( unsigned variable ) const;
@@ -444,6 +468,12 @@ public:
     */
     void refreshBasisFactorization();
 
+    /*
+      Inform the basis factorization of the numerical degradation
+      measured by the engine, which may cause it to be recomputed.
+    */
+    void notifyDegradation( double degradation );
+
     /*
       Merge two columns of the constraint matrix and re-initialize
       the tableau.
@@ -492,6 +522,27 @@ private:
     HashMap<unsigned, VariableWatchers> _variableToWatchers;
     List<VariableWatcher *> _globalWatchers;
 
+    /*
+      A flat (CSR) copy of _variableToWatchers, used to dispatch bound
+      notifications: the watchers of variable x are entries
+      _watcherOffsets[x] to _watcherOffsets[x + 1] - 1 of _watcherIndex.
+      ReLU constraints, which make up most of the watchers in neural
+      network queries, are recognized when the index is built and are
+      notified without virtual dispatch. The index is rebuilt on the first
+      notification after a watcher is registered or unregistered.
+    */
+    struct WatcherIndexEntry
+    {
+        VariableWatcher *_watcher;
+        ReluConstraint *_relu;
+    };
+
+    bool _watcherIndexIsValid;
+    Vector<unsigned> _watcherOffsets;
+    Vector<WatcherIndexEntry> _watcherIndex;
+
+    void buildWatcherIndex();
+
     /*
       Resize watchers
     */
@@ -516,13 +567,13 @@ private:
 
     /*
       The constraint matrix A, and a collection of its
-      sparse columns. The matrix is also stored in dense
-      form (column-major).
+      sparse columns and rows. The matrix is never stored in
+      dense form, so that memory is proportional to its number
+      of non-zero entries.
     */
     SparseMatrix *_A;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
 
     /*
       Used to compute inv(B)*a
@@ -545,6 +596,13 @@ private:
     double *_workM;
     double *_workN;
 
+    /*
+      Non-zero patterns (of size m) of the input and output of hypersparse
+      transformations.
+    */
+    unsigned *_hypersparseIndices;
+    unsigned *_hypersparseResultIndices;
+
     /*
       A unit vector of size m
     */
@@ -638,6 +696,22 @@ private:
      */
     Map<unsigned, unsigned> _mergedVariables;
 
+    /*
+      Identifies the current contents of the constraint matrix, the
+      right hand side and the merged variables. A fresh version is drawn
+      whenever any of these change, so that a stored state with a matching
+      version can be restored without reallocating or copying the matrix.
+    */
+    unsigned long long _constraintMatrixVersion;
+    static std::atomic<unsigned long long> _nextConstraintMatrixVersion;
+
+    /*
+      The copy of the constraint matrix in the last state stored or
+      restored, which the states stored while the version is unchanged
+      share.
+    */
+    mutable std::shared_ptr<const TableauState::ConstraintMatrix> _storedConstraintMatrix;
+
     /*
       True if and only if the rhs vector _b is all zeros. This can
       simplify some of the computations.
@@ -657,11 +731,22 @@ private:
     */
     void freeMemoryIfNeeded();
 
+    /*
+      Once the sparse rows of A have been populated, populate its
+      sparse columns and its CSR representation.
+    */
+    void initializeColumnsFromRows();
+
     /*
       Resize the relevant data structures to add a new row to the tableau.
     */
     void addRow();
 
+    /*
+      Draw a fresh constraint matrix version.
+    */
+    void constraintMatrixChanged();
+
     /*
       Update the variable assignment to reflect a pivot operation,
       without re-computing it from scratch.
@@ -673,6 +758,38 @@ private:
     */
     void standardRatioTest( double *changeColumn );
     void harrisRatioTest( double *changeColumn );
+    void boundFlippingRatioTest( double *changeColumn );
+
+    /*
+      Book-keeping for the bound-flipping ratio test: a breakpoint is
+      a step size at which an out-of-bounds basic variable reaches its
+      violated bound. The number of breakpoints passed by the last
+      test is recorded, so that it can be reported if the
+      corresponding pivot is actually performed.
+    */
+    struct Breakpoint
+    {
+        double _step;
+        unsigned _basicIndex;
+        double _slopeChange;
+
+        bool operator<( const Breakpoint &other ) const
+        {
+            return _step < other._step;
+        }
+    };
+
+    Vector<Breakpoint> _breakpoints;
+    unsigned _longStepEnteringVariable;
+    unsigned _longStepLeavingVariable;
+    unsigned _longStepBreakpointsPassed;
+
+    /*
+      Check whether a transformation with the given right-hand side should
+      be performed hypersparsely. If so, its non-zero pattern is stored in
+      _hypersparseIndices, and nnz is set to its size.
+    */
+    bool useHypersparseTransformation( const double *y, unsigned &nnz ) const;
 
     /*
       For debugging purposes only
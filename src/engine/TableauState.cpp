@@ -21,12 +21,7 @@
 #include "SparseUnsortedList.h"
 
 TableauState::TableauState()
-    : _A( NULL )
-    , _sparseColumnsOfA( NULL )
-    , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
-    , _b( NULL )
-    , _lowerBounds( NULL )
+    : _lowerBounds( NULL )
     , _upperBounds( NULL )
     , _basicAssignment( NULL )
     , _nonBasicAssignment( NULL )
@@ -39,54 +34,6 @@ TableauState::TableauState()
 
 TableauState::~TableauState()
 {
-    if ( _A )
-    {
-        delete _A;
-        _A = NULL;
-    }
-
-    if ( _sparseColumnsOfA )
-    {
-        for ( unsigned i = 0; i < _n; ++i )
-        {
-            if ( _sparseColumnsOfA[i] )
-            {
-                delete _sparseColumnsOfA[i];
-                _sparseColumnsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseColumnsOfA;
-        _sparseColumnsOfA = NULL;
-    }
-
-    if ( _sparseRowsOfA )
-    {
-        for ( unsigned i = 0; i < _m; ++i )
-        {
-            if ( _sparseRowsOfA[i] )
-            {
-                delete _sparseRowsOfA[i];
-                _sparseRowsOfA[i] = NULL;
-            }
-        }
-
-        delete[] _sparseRowsOfA;
-        _sparseRowsOfA = NULL;
-    }
-
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
-
-    if ( _b )
-    {
-        delete[] _b;
-        _b = NULL;
-    }
-
     if ( _lowerBounds )
     {
         delete[] _lowerBounds;
@@ -143,41 +90,6 @@ void TableauState::setDimensions( unsigned m,
     _m = m;
     _n = n;
 
-    _A = new CSRMatrix();
-    if ( !_A )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::A" );
-
-    _sparseColumnsOfA = new SparseUnsortedList *[n];
-    if ( !_sparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseColumnsOfA" );
-
-    for ( unsigned i = 0; i < n; ++i )
-    {
-        _sparseColumnsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseColumnsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED,
-                                "TableauState::sparseColumnsOfA[i]" );
-    }
-
-    _sparseRowsOfA = new SparseUnsortedList *[m];
-    if ( !_sparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA" );
-
-    for ( unsigned i = 0; i < m; ++i )
-    {
-        _sparseRowsOfA[i] = new SparseUnsortedList;
-        if ( !_sparseRowsOfA[i] )
-            throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA[i]" );
-    }
-
-    _denseA = new double[m * n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::denseA" );
-
-    _b = new double[m];
-    if ( !_b )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::b" );
-
     _lowerBounds = new double[n];
     if ( !_lowerBounds )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::lowerBounds" );
@@ -223,6 +135,97 @@ void TableauState::initializeBounds( unsigned n )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::upperBounds" );
 }
 
+TableauState::ConstraintMatrix::ConstraintMatrix( unsigned m,
+                                                 unsigned n,
+                                                 unsigned long long version )
+    : _m( m )
+    , _n( n )
+    , _A( NULL )
+    , _sparseColumnsOfA( NULL )
+    , _sparseRowsOfA( NULL )
+    , _b( NULL )
+    , _version( version )
+{
+    _A = new CSRMatrix();
+    if ( !_A )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::ConstraintMatrix::A" );
+
+    _sparseColumnsOfA = new SparseUnsortedList *[n];
+    if ( !_sparseColumnsOfA )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                            "TableauState::ConstraintMatrix::sparseColumnsOfA" );
+
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        _sparseColumnsOfA[i] = new SparseUnsortedList;
+        if ( !_sparseColumnsOfA[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                                "TableauState::ConstraintMatrix::sparseColumnsOfA[i]" );
+    }
+
+    _sparseRowsOfA = new SparseUnsortedList *[m];
+    if ( !_sparseRowsOfA )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                            "TableauState::ConstraintMatrix::sparseRowsOfA" );
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        _sparseRowsOfA[i] = new SparseUnsortedList;
+        if ( !_sparseRowsOfA[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED,
+                                "TableauState::ConstraintMatrix::sparseRowsOfA[i]" );
+    }
+
+    _b = new double[m];
+    if ( !_b )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::ConstraintMatrix::b" );
+}
+
+TableauState::ConstraintMatrix::~ConstraintMatrix()
+{
+    if ( _A )
+    {
+        delete _A;
+        _A = NULL;
+    }
+
+    if ( _sparseColumnsOfA )
+    {
+        for ( unsigned i = 0; i < _n; ++i )
+        {
+            if ( _sparseColumnsOfA[i] )
+            {
+                delete _sparseColumnsOfA[i];
+                _sparseColumnsOfA[i] = NULL;
+            }
+        }
+
+        delete[] _sparseColumnsOfA;
+        _sparseColumnsOfA = NULL;
+    }
+
+    if ( _sparseRowsOfA )
+    {
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            if ( _sparseRowsOfA[i] )
+            {
+                delete _sparseRowsOfA[i];
+                _sparseRowsOfA[i] = NULL;
+            }
+        }
+
+        delete[] _sparseRowsOfA;
+        _sparseRowsOfA = NULL;
+    }
+
+    if ( _b )
+    {
+        delete[] _b;
+        _b = NULL;
+    }
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -22,6 +22,8 @@
 #include "Set.h"
 #include "SparseMatrix.h"
 
+#include <memory>
+
 class TableauState
 {
     /*
@@ -57,17 +59,47 @@ public:
     unsigned _n;
 
     /*
-      The matrix
-    */
-    SparseMatrix *_A;
-    SparseUnsortedList **_sparseColumnsOfA;
-    SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
-
-    /*
-      The right hand side
+      The matrix A, the right hand side and the merged variables, which
+      change far less often than the rest of the state, and are thus shared
+      by the states stored while they do not change.
     */
-    double *_b;
+    class ConstraintMatrix
+    {
+    public:
+        ConstraintMatrix( unsigned m, unsigned n, unsigned long long version );
+        ~ConstraintMatrix();
+
+        unsigned _m;
+        unsigned _n;
+
+        /*
+          The matrix
+        */
+        SparseMatrix *_A;
+        SparseUnsortedList **_sparseColumnsOfA;
+        SparseUnsortedList **_sparseRowsOfA;
+
+        /*
+          The right hand side
+        */
+        double *_b;
+
+        /*
+          _mergedVariables[x] = y means that x = y, and that
+          variable x has been merged into variable y. So, when
+          extracting a solution for x, we should read the value of y.
+        */
+        Map<unsigned, unsigned> _mergedVariables;
+
+        /*
+          The version of the tableau's constraint matrix that this is a copy
+          of. If the tableau still has this version when a state is restored,
+          its matrix, right hand side and merged variables are kept.
+        */
+        unsigned long long _version;
+    };
+
+    std::shared_ptr<const ConstraintMatrix> _constraintMatrix;
 
     /*
       Upper and lower bounds for all variables
@@ -119,13 +151,6 @@ public:
       Indicator whether the bounds are valid
     */
     bool _boundsValid;
-
-    /*
-      _mergedVariables[x] = y means that x = y, and that
-      variable x has been merged into variable y. So, when
-      extracting a solution for x, we should read the value of y.
-     */
-    Map<unsigned, unsigned> _mergedVariables;
 };
 
 #endif // __TableauState_h__
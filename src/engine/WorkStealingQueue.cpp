@@ -0,0 +1,158 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "WorkStealingQueue.h"
+
+#include "Debug.h"
+
+#include <chrono>
+
+WorkStealingQueue::WorkStealingQueue( unsigned numWorkers )
+    : _numWorkers( numWorkers > 0 ? numWorkers : 1 )
+    , _deques( new WorkerDeque[_numWorkers] )
+    , _size( 0 )
+    , _numSteals( 0 )
+{
+}
+
+WorkStealingQueue::~WorkStealingQueue()
+{
+    for ( unsigned i = 0; i < _numWorkers; ++i )
+    {
+        for ( const auto &subQuery : _deques[i]._subQueries )
+            delete subQuery;
+    }
+
+    delete[] _deques;
+    _deques = NULL;
+}
+
+unsigned WorkStealingQueue::getNumWorkers() const
+{
+    return _numWorkers;
+}
+
+void WorkStealingQueue::push( unsigned worker, SubQuery *subQuery )
+{
+    ASSERT( worker < _numWorkers );
+
+    {
+        std::lock_guard<std::mutex> lock( _deques[worker]._mutex );
+        _deques[worker]._subQueries.push_back( subQuery );
+        ++_size;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+    }
+    _workAvailable.notify_one();
+}
+
+SubQuery *WorkStealingQueue::tryPop( unsigned worker )
+{
+    ASSERT( worker < _numWorkers );
+
+    if ( _size.load() == 0 )
+        return NULL;
+
+    // Own deque, most recent subquery first
+    {
+        WorkerDeque &own = _deques[worker];
+        std::lock_guard<std::mutex> lock( own._mutex );
+        if ( !own._subQueries.empty() )
+        {
+            SubQuery *subQuery = own._subQueries.back();
+            own._subQueries.pop_back();
+            --_size;
+            return subQuery;
+        }
+    }
+
+    // Steal the oldest subquery of the next non-empty deque
+    for ( unsigned i = 1; i < _numWorkers; ++i )
+    {
+        WorkerDeque &victim = _deques[( worker + i ) % _numWorkers];
+        std::lock_guard<std::mutex> lock( victim._mutex );
+        if ( !victim._subQueries.empty() )
+        {
+            SubQuery *subQuery = victim._subQueries.front();
+            victim._subQueries.pop_front();
+            --_size;
+            ++_numSteals;
+            return subQuery;
+        }
+    }
+
+    return NULL;
+}
+
+SubQuery *WorkStealingQueue::pop( unsigned worker, const std::atomic_bool &shouldQuit )
+{
+    while ( true )
+    {
+        SubQuery *subQuery = tryPop( worker );
+        if ( subQuery )
+            return subQuery;
+
+        std::unique_lock<std::mutex> lock( _mutex );
+        _workAvailable.wait( lock, [&] { return shouldQuit.load() || _size.load() > 0; } );
+        if ( shouldQuit.load() )
+            return NULL;
+    }
+}
+
+void WorkStealingQueue::waitForQuit( const std::atomic_bool &shouldQuit,
+                                     unsigned long long timeoutInMicroSeconds )
+{
+    std::unique_lock<std::mutex> lock( _mutex );
+    if ( timeoutInMicroSeconds == 0 )
+        _quitRequested.wait( lock, [&] { return shouldQuit.load(); } );
+    else
+        _quitRequested.wait_for( lock, std::chrono::microseconds( timeoutInMicroSeconds ), [&] {
+            return shouldQuit.load();
+        } );
+}
+
+void WorkStealingQueue::wakeUpAll()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+    }
+    _workAvailable.notify_all();
+    _quitRequested.notify_all();
+}
+
+bool WorkStealingQueue::empty() const
+{
+    return _size.load() == 0;
+}
+
+unsigned WorkStealingQueue::size() const
+{
+    return _size.load();
+}
+
+unsigned long long WorkStealingQueue::getNumSteals() const
+{
+    return _numSteals.load();
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#ifndef __WorkStealingQueue_h__
+#define __WorkStealingQueue_h__
+
+#include "SubQuery.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/*
+  The subqueries shared by the DnC workers. Every worker owns a deque:
+  it pushes the subqueries it creates to the back of its own deque and
+  pops from the back, so that it keeps working on the most recent (and
+  deepest) splits of its subtree. A worker whose deque is empty steals
+  from the front of the other workers' deques, where the oldest and
+  typically largest subqueries are. Idle workers block until a subquery
+  is pushed or solving is over, instead of polling.
+*/
+class WorkStealingQueue
+{
+public:
+    WorkStealingQueue( unsigned numWorkers );
+
+    /*
+      Deletes the subqueries that are still pending
+    */
+    ~WorkStealingQueue();
+
+    unsigned getNumWorkers() const;
+
+    /*
+      Push a subquery to the deque of the given worker, and wake up an
+      idle worker. The queue takes ownership of the subquery.
+    */
+    void push( unsigned worker, SubQuery *subQuery );
+
+    /*
+      Pop a subquery for the given worker: the most recent one of its own
+      deque, or else the oldest one of another worker's deque. Return NULL
+      if all the deques are empty. The caller takes ownership of the
+      subquery.
+    */
+    SubQuery *tryPop( unsigned worker );
+
+    /*
+      Like tryPop(), but block while all the deques are empty. Return NULL
+      once shouldQuit is raised.
+    */
+    SubQuery *pop( unsigned worker, const std::atomic_bool &shouldQuit );
+
+    /*
+      Block until shouldQuit is raised, or for at most the given number of
+      microseconds (0 means no limit).
+    */
+    void waitForQuit( const std::atomic_bool &shouldQuit,
+                      unsigned long long timeoutInMicroSeconds );
+
+    /*
+      Wake up every blocked pop() and waitForQuit(). Must be called after
+      raising the quit flag.
+    */
+    void wakeUpAll();
+
+    bool empty() const;
+    unsigned size() const;
+
+    /*
+      The number of subqueries taken from the deque of another worker
+    */
+    unsigned long long getNumSteals() const;
+
+private:
+    struct WorkerDeque
+    {
+        std::mutex _mutex;
+        std::deque<SubQuery *> _subQueries;
+    };
+
+    unsigned _numWorkers;
+    WorkerDeque *_deques;
+
+    /*
+      The total number of subqueries in all the deques, used to decide
+      whether to block without locking every deque
+    */
+    std::atomic_uint _size;
+    std::atomic_ullong _numSteals;
+
+    /*
+      Blocked pop() calls wait on _workAvailable and blocked waitForQuit()
+      calls on _quitRequested. Both predicates are checked under _mutex,
+      which a pusher or quitter takes before notifying, so that no wakeup
+      is lost.
+    */
+    std::mutex _mutex;
+    std::condition_variable _workAvailable;
+    std::condition_variable _quitRequested;
+};
+
+#endif // __WorkStealingQueue_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,152 @@
+/*********************                                                        */
+/*! \file BoundNotificationBenchmark.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A microbenchmark of bound notification throughput. A network's worth
+ ** of ReLU constraints watch the tableau variables, and every variable
+ ** is notified of a new lower and upper bound, as happens when the
+ ** tightenings of a symbolic bound tightening pass are propagated. The
+ ** tableau's flat watcher index is compared with dispatching through a
+ ** hash map of watcher lists (the previous scheme).
+
+ **/
+
+#include "BoundManager.h"
+#include "HashMap.h"
+#include "List.h"
+#include "Options.h"
+#include "ReluConstraint.h"
+#include "Statistics.h"
+#include "Tableau.h"
+#include "TimeUtils.h"
+#include "context/context.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+int main( int argc, char *argv[] )
+{
+    unsigned numRelus = 20000;
+    unsigned repetitions = 50;
+
+    if ( argc > 1 )
+        repetitions = atoi( argv[1] );
+
+    Options::get()->setString( Options::LP_SOLVER, "native" );
+
+    unsigned numVariables = 2 * numRelus;
+
+    CVC4::context::Context context;
+    BoundManager boundManager( context );
+    boundManager.initialize( numVariables );
+
+    // Keep the phases of all constraints unfixed, so that every
+    // notification is processed in full
+    for ( unsigned i = 0; i < numRelus; ++i )
+    {
+        boundManager.setLowerBound( 2 * i, -1 );
+        boundManager.setUpperBound( 2 * i, 1 );
+        boundManager.setLowerBound( 2 * i + 1, 0 );
+        boundManager.setUpperBound( 2 * i + 1, 1 );
+    }
+
+    Tableau tableau( boundManager );
+    Statistics statistics;
+
+    HashMap<unsigned, List<ITableau::VariableWatcher *>> variableToWatchers;
+
+    List<ReluConstraint *> relus;
+    for ( unsigned i = 0; i < numRelus; ++i )
+    {
+        ReluConstraint *relu = new ReluConstraint( 2 * i, 2 * i + 1 );
+        relu->initializeCDOs( &context );
+        relu->registerBoundManager( &boundManager );
+        relu->setStatistics( &statistics );
+        relu->registerAsWatcher( &tableau );
+
+        variableToWatchers[2 * i].append( relu );
+        variableToWatchers[2 * i + 1].append( relu );
+        relus.append( relu );
+    }
+
+    // Build the flat index before timing
+    tableau.notifyLowerBound( 0, -1 );
+    statistics.setLongAttribute( Statistics::NUM_BOUND_NOTIFICATIONS_TO_PL_CONSTRAINTS, 0 );
+
+    struct timespec start = TimeUtils::sampleMicro();
+    for ( unsigned r = 0; r < repetitions; ++r )
+    {
+        for ( unsigned variable = 0; variable < numVariables; ++variable )
+        {
+            double lb = boundManager.getLowerBound( variable );
+            double ub = boundManager.getUpperBound( variable );
+
+            if ( variableToWatchers.exists( variable ) )
+            {
+                for ( auto &watcher : variableToWatchers[variable] )
+                    watcher->notifyLowerBound( variable, lb );
+            }
+
+            if ( variableToWatchers.exists( variable ) )
+            {
+                for ( auto &watcher : variableToWatchers[variable] )
+                    watcher->notifyUpperBound( variable, ub );
+            }
+        }
+    }
+    struct timespec end = TimeUtils::sampleMicro();
+    unsigned long long hashMapMicro = TimeUtils::timePassed( start, end );
+    unsigned long long hashMapNotifications =
+        statistics.getLongAttribute( Statistics::NUM_BOUND_NOTIFICATIONS_TO_PL_CONSTRAINTS );
+
+    statistics.setLongAttribute( Statistics::NUM_BOUND_NOTIFICATIONS_TO_PL_CONSTRAINTS, 0 );
+
+    start = TimeUtils::sampleMicro();
+    for ( unsigned r = 0; r < repetitions; ++r )
+    {
+        for ( unsigned variable = 0; variable < numVariables; ++variable )
+        {
+            tableau.notifyLowerBound( variable, boundManager.getLowerBound( variable ) );
+            tableau.notifyUpperBound( variable, boundManager.getUpperBound( variable ) );
+        }
+    }
+    end = TimeUtils::sampleMicro();
+    unsigned long long indexMicro = TimeUtils::timePassed( start, end );
+    unsigned long long indexNotifications =
+        statistics.getLongAttribute( Statistics::NUM_BOUND_NOTIFICATIONS_TO_PL_CONSTRAINTS );
+
+    printf( "Notifying %u variables watched by %u ReLU constraints, %u times\n",
+            numVariables,
+            numRelus,
+            repetitions );
+    printf( "\tHash map of lists: %8llu micro, %llu notifications (%.1lf per micro)\n",
+            hashMapMicro,
+            hashMapNotifications,
+            hashMapMicro > 0 ? (double)hashMapNotifications / hashMapMicro : 0 );
+    printf( "\tFlat index:        %8llu micro, %llu notifications (%.1lf per micro). "
+            "Speedup: %.2lfx\n",
+            indexMicro,
+            indexNotifications,
+            indexMicro > 0 ? (double)indexNotifications / indexMicro : 0,
+            indexMicro > 0 ? (double)hashMapMicro / indexMicro : 0 );
+
+    for ( const auto &relu : relus )
+        delete relu;
+
+    return 0;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -55,6 +55,10 @@ public:
     {
     }
 
+    void analyze( const SparseUnsortedArrays * /* matrix */, unsigned /* m */, unsigned /* n */ )
+    {
+    }
+
     unsigned getRank() const
     {
         return 0;
@@ -33,6 +33,10 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        numRefutationQueries = 0;
+        temporaryConstraint = NULL;
+        produceProofs = true;
+        numPivots = 0;
     }
 
     ~MockEngine()
@@ -185,6 +189,12 @@ public:
             return NULL;
     }
 
+    PiecewiseLinearConstraint *temporaryConstraint;
+    bool isTemporaryConstraint( const PiecewiseLinearConstraint *constraint ) const
+    {
+        return constraint == temporaryConstraint;
+    }
+
     PiecewiseLinearConstraint *pickSplitPLConstraintSnC( SnCDivideStrategy /**/ )
     {
         if ( !_constraintsToSplit.empty() )
@@ -211,6 +221,27 @@ public:
         return _snc;
     }
 
+    List<Tightening> rootLevelTightenings;
+    void getRootLevelTightenings( List<Tightening> &tightenings ) const
+    {
+        tightenings = rootLevelTightenings;
+    }
+
+    List<Tightening> importedTightenings;
+    unsigned importTightenings( const List<Tightening> &tightenings,
+                                unsigned &numFixedConstraints )
+    {
+        importedTightenings.append( tightenings );
+        numFixedConstraints = 0;
+        return tightenings.size();
+    }
+
+    unsigned long long numPivots;
+    unsigned long long getNumberOfPivots() const
+    {
+        return numPivots;
+    }
+
     void applyAllBoundTightenings(){};
 
     bool applyAllValidConstraintCaseSplits()
@@ -228,6 +259,31 @@ public:
         return true;
     }
 
+    /*
+      A set of case splits is refuted if it contains all the case splits of one of these
+      conflicts.
+    */
+    List<List<PiecewiseLinearCaseSplit>> conflicts;
+    unsigned numRefutationQueries;
+    bool caseSplitsRefutedAtRoot( const List<PiecewiseLinearCaseSplit> &splits )
+    {
+        ++numRefutationQueries;
+        for ( const auto &conflict : conflicts )
+        {
+            bool contained = true;
+            for ( const auto &split : conflict )
+            {
+                if ( !splits.exists( split ) )
+                    contained = false;
+            }
+
+            if ( contained )
+                return true;
+        }
+
+        return false;
+    }
+
     double explainBound( unsigned /* var */, bool /* isUpper */ ) const
     {
         return 0.0;
@@ -282,9 +338,10 @@ public:
     {
     }
 
+    bool produceProofs;
     bool shouldProduceProofs() const
     {
-        return true;
+        return produceProofs;
     }
 
     void addPLCLemma( std::shared_ptr<PLCLemma> & /*explanation*/ )
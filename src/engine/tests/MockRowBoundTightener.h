@@ -57,6 +57,10 @@ public:
         setDimensionsWasCalled = true;
     }
 
+    void scheduleAllRows()
+    {
+    }
+
     void resetBounds()
     {
     }
@@ -76,6 +80,9 @@ public:
     void examineConstraintMatrix( bool /* untilSaturation */ )
     {
     }
+    void notifyBoundTightened( unsigned /* variable */ )
+    {
+    }
     void examinePivotRow()
     {
     }
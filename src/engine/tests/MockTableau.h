@@ -20,6 +20,7 @@
 #include "ITableau.h"
 #include "Map.h"
 #include "MockBoundManager.h"
+#include "SparseUnsortedArrays.h"
 #include "SparseUnsortedList.h"
 #include "TableauRow.h"
 #include "context/context.h"
@@ -152,6 +153,12 @@ public:
         memcpy( lastEntries, A, sizeof( double ) * lastM * lastN );
     }
 
+    void setConstraintMatrix( const SparseUnsortedArrays *A )
+    {
+        TS_ASSERT( setDimensionsCalled );
+        A->toDense( lastEntries );
+    }
+
     double *lastRightHandSide;
     void setRightHandSide( const double *b )
     {
@@ -293,6 +300,16 @@ public:
     {
     }
 
+    bool pickDualLeavingVariable()
+    {
+        return false;
+    }
+
+    bool pickDualEnteringVariable()
+    {
+        return false;
+    }
+
     unsigned mockLeavingVariable;
     void setLeavingVariableIndex( unsigned basic )
     {
@@ -488,11 +505,11 @@ public:
     }
 
     Map<unsigned, const double *> nextAColumn;
-    const double *getAColumn( unsigned index ) const
+    void getAColumn( unsigned index, double *result ) const
     {
         TS_ASSERT( nextAColumn.exists( index ) );
         TS_ASSERT( nextAColumn.get( index ) );
-        return nextAColumn.get( index );
+        memcpy( result, nextAColumn.get( index ), sizeof( double ) * lastM );
     }
 
     void getSparseAColumn( unsigned index, SparseUnsortedList *result ) const
@@ -659,6 +676,10 @@ public:
     {
     }
 
+    void notifyDegradation( double /* degradation */ )
+    {
+    }
+
     void mergeColumns( unsigned /* x1 */, unsigned /* x2 */ )
     {
     }
@@ -0,0 +1,145 @@
+/*********************                                                        */
+/*! \file Test_DevexRule.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DevexRule.h"
+#include "MockTableau.h"
+#include "TableauRow.h"
+
+#include <cxxtest/TestSuite.h>
+#include <string.h>
+
+class MockForDevexRule
+{
+public:
+};
+
+class DevexRuleTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDevexRule *mock;
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDevexRule );
+        TS_ASSERT( tableau = new MockTableau );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_select_and_update_weights()
+    {
+        tableau->setDimensions( 2, 5 );
+
+        DevexRule devex;
+        TS_ASSERT_THROWS_NOTHING( devex.initialize( *tableau ) );
+
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( devex.getWeight( i ), 1.0 );
+
+        Set<unsigned> excluded;
+        List<unsigned> candidates = { 0, 1, 2 };
+        double costFunction[] = { -5.0, -3.0, -7.0 };
+        memcpy( tableau->nextCostFunction, costFunction, sizeof( costFunction ) );
+
+        // With unit weights, Devex behaves like Dantzig's rule
+        TS_ASSERT( devex.select( *tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 2U );
+
+        excluded.insert( 2 );
+        TS_ASSERT( devex.select( *tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 0U );
+
+        excluded.insert( 0 );
+        excluded.insert( 1 );
+        TS_ASSERT( !devex.select( *tableau, candidates, excluded ) );
+        excluded.clear();
+
+        // A fake pivot does not change the weights
+        tableau->nextEnteringVariableIndex = 1;
+        tableau->mockLeavingVariable = 0;
+        TS_ASSERT_THROWS_NOTHING( devex.prePivotHook( *tableau, true ) );
+        TS_ASSERT_THROWS_NOTHING( devex.postPivotHook( *tableau, true ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( devex.getWeight( i ), 1.0 );
+
+        // A real pivot: index 1 enters, basic index 0 leaves with pivot element 2
+        double changeColumn[] = { 2, 1 };
+        tableau->nextChangeColumn = changeColumn;
+
+        TableauRow pivotRow( 3 );
+        pivotRow._row[0]._coefficient = 4;
+        pivotRow._row[1]._coefficient = 2;
+        pivotRow._row[2]._coefficient = 1;
+        tableau->nextPivotRow = &pivotRow;
+
+        TS_ASSERT_THROWS_NOTHING( devex.prePivotHook( *tableau, false ) );
+        TS_ASSERT_THROWS_NOTHING( devex.postPivotHook( *tableau, false ) );
+
+        // weight[0] = (4/2)^2 * 1; weight[2] = max( 1, (1/2)^2 * 1 );
+        // the leaving variable gets max( 1, 1 / 2^2 )
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 0 ), 4.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 1 ), 1.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( devex.getWeight( 2 ), 1.0 ) );
+
+        // Variable 0 now has the largest reduced cost, but a heavier weight
+        costFunction[0] = -5.0;
+        costFunction[1] = -3.0;
+        costFunction[2] = -1.0;
+        memcpy( tableau->nextCostFunction, costFunction, sizeof( costFunction ) );
+
+        TS_ASSERT( devex.select( *tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 1U );
+    }
+
+    void test_reset_when_weights_grow_too_large()
+    {
+        tableau->setDimensions( 2, 5 );
+
+        DevexRule devex;
+        TS_ASSERT_THROWS_NOTHING( devex.initialize( *tableau ) );
+
+        tableau->nextEnteringVariableIndex = 1;
+        tableau->mockLeavingVariable = 0;
+
+        double changeColumn[] = { 0.0001, 1 };
+        tableau->nextChangeColumn = changeColumn;
+
+        TableauRow pivotRow( 3 );
+        pivotRow._row[0]._coefficient = 1;
+        pivotRow._row[1]._coefficient = 0.0001;
+        pivotRow._row[2]._coefficient = 0;
+        tableau->nextPivotRow = &pivotRow;
+
+        TS_ASSERT_THROWS_NOTHING( devex.prePivotHook( *tableau, false ) );
+        TS_ASSERT( devex.getWeight( 0 ) > GlobalConfiguration::DEVEX_MAXIMAL_WEIGHT );
+
+        TS_ASSERT_THROWS_NOTHING( devex.postPivotHook( *tableau, false ) );
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( devex.getWeight( i ), 1.0 );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,226 @@
+/*********************                                                        */
+/*! \file Test_DnCCheckpoint.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DnCCheckpoint.h"
+#include "DnCProtocol.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "Query.h"
+#include "ReluConstraint.h"
+
+#include <cstdio>
+#include <cxxtest/TestSuite.h>
+#include <unistd.h>
+
+static const char *HELLO = "hello 3 1 0 0123456789abcdef";
+
+class MockForDnCCheckpoint : public MockErrno
+{
+public:
+};
+
+class DnCCheckpointTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCCheckpoint *mock;
+
+    String path;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCCheckpoint );
+
+        path = Stringf( "/tmp/marabou-dnc-checkpoint-test-%d", getpid() );
+        unlink( path.ascii() );
+    }
+
+    void tearDown()
+    {
+        unlink( path.ascii() );
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    static SubQuery *createSubQuery( String queryId, unsigned depth )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split =
+            std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+        subQuery->_split->storeBoundTightening( Tightening( 0, depth, Tightening::LB ) );
+        subQuery->_split->storeBoundTightening( Tightening( 1, 0.1, Tightening::UB ) );
+        subQuery->_timeoutInSeconds = 5 * ( depth + 1 );
+        subQuery->_depth = depth;
+        return subQuery;
+    }
+
+    static void deleteSubQueries( SubQueries &subQueries )
+    {
+        for ( const auto &subQuery : subQueries )
+            delete subQuery;
+        subQueries.clear();
+    }
+
+    void test_frontier()
+    {
+        DnCCheckpoint checkpoint( path, HELLO );
+
+        SubQueries subQueries;
+        subQueries.append( createSubQuery( "1", 0 ) );
+        subQueries.append( createSubQuery( "2", 0 ) );
+        checkpoint.add( subQueries );
+        deleteSubQueries( subQueries );
+        TS_ASSERT_EQUALS( checkpoint.size(), 2U );
+
+        // "1" times out and is divided in two
+        subQueries.append( createSubQuery( "1-1", 1 ) );
+        subQueries.append( createSubQuery( "1-2", 1 ) );
+        checkpoint.replace( "1", subQueries );
+        deleteSubQueries( subQueries );
+        TS_ASSERT_EQUALS( checkpoint.size(), 3U );
+
+        // "2" and "1-1" are UNSAT
+        checkpoint.remove( "2" );
+        checkpoint.remove( "1-1" );
+        TS_ASSERT_EQUALS( checkpoint.size(), 1U );
+
+        TS_ASSERT_THROWS_NOTHING( checkpoint.write() );
+        TS_ASSERT_EQUALS( access( path.ascii(), F_OK ), 0 );
+        TS_ASSERT_DIFFERS( access( ( path + ".tmp" ).ascii(), F_OK ), 0 );
+
+        TS_ASSERT_THROWS_NOTHING( DnCCheckpoint::read( path, HELLO, subQueries ) );
+        TS_ASSERT_EQUALS( subQueries.size(), 1U );
+        SubQuery *subQuery = subQueries.front();
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1-2" );
+        TS_ASSERT_EQUALS( subQuery->_depth, 1U );
+        TS_ASSERT_EQUALS( subQuery->_timeoutInSeconds, 10U );
+        TS_ASSERT_EQUALS( subQuery->_split->getBoundTightenings().size(), 2U );
+        TS_ASSERT_EQUALS( subQuery->_split->getBoundTightenings().back()._value, 0.1 );
+        deleteSubQueries( subQueries );
+    }
+
+    void test_final_checkpoint()
+    {
+        DnCCheckpoint checkpoint( path, HELLO );
+
+        SubQueries subQueries;
+        subQueries.append( createSubQuery( "1", 0 ) );
+        subQueries.append( createSubQuery( "2", 0 ) );
+        checkpoint.add( subQueries );
+        deleteSubQueries( subQueries );
+
+        // The initial frontier is written right away
+        checkpoint.startWriting( 3600 );
+        TS_ASSERT_THROWS_NOTHING( DnCCheckpoint::read( path, HELLO, subQueries ) );
+        TS_ASSERT_EQUALS( subQueries.size(), 2U );
+        deleteSubQueries( subQueries );
+
+        // Stopping does not wait for the next periodic write
+        checkpoint.remove( "1" );
+        checkpoint.remove( "2" );
+        checkpoint.stopWriting();
+
+        // A solve that was over
+        TS_ASSERT_THROWS_NOTHING( DnCCheckpoint::read( path, HELLO, subQueries ) );
+        TS_ASSERT( subQueries.empty() );
+    }
+
+    void test_invalid_checkpoints()
+    {
+        SubQueries subQueries;
+        TS_ASSERT_THROWS_EQUALS( DnCCheckpoint::read( path, HELLO, subQueries ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_CHECKPOINT_FAILED );
+
+        DnCCheckpoint checkpoint( path, HELLO );
+        subQueries.append( createSubQuery( "1", 0 ) );
+        checkpoint.add( subQueries );
+        deleteSubQueries( subQueries );
+        checkpoint.write();
+
+        // The checkpoint of another query
+        TS_ASSERT_THROWS_EQUALS(
+            DnCCheckpoint::read( path, "hello 3 1 0 fedcba9876543210", subQueries ),
+            const MarabouError &e,
+            e.getCode(),
+            MarabouError::DNC_CHECKPOINT_FAILED );
+        TS_ASSERT( subQueries.empty() );
+        TS_ASSERT_THROWS_EQUALS(
+            DnCCheckpoint::read( path, "hello 4 1 0 0123456789abcdef", subQueries ),
+            const MarabouError &e,
+            e.getCode(),
+            MarabouError::DNC_CHECKPOINT_FAILED );
+        TS_ASSERT( subQueries.empty() );
+
+        // A truncated checkpoint
+        FILE *file = fopen( path.ascii(), "w" );
+        fputs( Stringf( "checkpoint 2\n%s\nquery 1\n", HELLO ).ascii(), file );
+        fclose( file );
+        TS_ASSERT_THROWS_EQUALS( DnCCheckpoint::read( path, HELLO, subQueries ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_MALFORMED_MESSAGE );
+        TS_ASSERT( subQueries.empty() );
+
+        // The checkpoint of another property of the same network, i.e. of
+        // a query with the same dimensions but other bounds
+        Query query;
+        query.setNumberOfVariables( 3 );
+        query.setLowerBound( 0, -0.5 );
+        query.setUpperBound( 0, 0.5 );
+        Equation equation;
+        equation.addAddend( 1, 0 );
+        equation.addAddend( -1, 1 );
+        query.addEquation( equation );
+        query.addPiecewiseLinearConstraint( new ReluConstraint( 1, 2 ) );
+
+        Query otherProperty( query );
+        otherProperty.setLowerBound( 0, -0.25 );
+        otherProperty.setUpperBound( 0, 0.25 );
+
+        DnCCheckpoint otherCheckpoint( path, DnCProtocol::encodeHello( otherProperty ) );
+        subQueries.append( createSubQuery( "1", 0 ) );
+        otherCheckpoint.add( subQueries );
+        deleteSubQueries( subQueries );
+        otherCheckpoint.write();
+        TS_ASSERT_THROWS_EQUALS(
+            DnCCheckpoint::read( path, DnCProtocol::encodeHello( query ), subQueries ),
+            const MarabouError &e,
+            e.getCode(),
+            MarabouError::DNC_CHECKPOINT_FAILED );
+        TS_ASSERT( subQueries.empty() );
+        TS_ASSERT_THROWS_NOTHING(
+            DnCCheckpoint::read( path, DnCProtocol::encodeHello( otherProperty ), subQueries ) );
+        TS_ASSERT_EQUALS( subQueries.size(), 1U );
+        deleteSubQueries( subQueries );
+
+        // A directory that does not exist
+        DnCCheckpoint unwritable( "/no-such-directory/checkpoint", HELLO );
+        TS_ASSERT_THROWS_EQUALS( unwritable.startWriting( 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_CHECKPOINT_FAILED );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file Test_DnCConnection.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DnCConnection.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <thread>
+
+class MockForDnCConnection : public MockErrno
+{
+public:
+};
+
+class DnCConnectionTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCConnection *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCConnection );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_exchange_messages_over_unix_socket()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+
+        String large;
+        for ( unsigned i = 0; i < 20000; ++i )
+            large += "0123456789";
+
+        String received;
+        std::thread peer( [&] {
+            std::unique_ptr<DnCConnection> connection(
+                DnCConnection::connect( listener.getAddress(), 5 ) );
+            connection->send( "hello" );
+            connection->receive( received );
+            connection->send( large );
+        } );
+
+        std::unique_ptr<DnCConnection> connection( listener.accept() );
+        String message;
+        TS_ASSERT( connection->receive( message ) );
+        TS_ASSERT_EQUALS( message, "hello" );
+
+        connection->send( "" );
+        TS_ASSERT( connection->receive( message ) );
+        TS_ASSERT_EQUALS( message, large );
+
+        // The peer closes the connection when done
+        peer.join();
+        TS_ASSERT( connection->waitForMessage( 0 ) );
+        TS_ASSERT( !connection->receive( message ) );
+        TS_ASSERT_EQUALS( received, "" );
+    }
+
+    void test_wait_for_message()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+        std::unique_ptr<DnCConnection> client( DnCConnection::connect( listener.getAddress(), 5 ) );
+        std::unique_ptr<DnCConnection> server( listener.accept() );
+
+        TS_ASSERT( !server->waitForMessage( 10 ) );
+        client->send( "quit" );
+        TS_ASSERT( server->waitForMessage( 1000 ) );
+
+        String message;
+        TS_ASSERT( server->receive( message ) );
+        TS_ASSERT_EQUALS( message, "quit" );
+        TS_ASSERT( !server->waitForMessage( 0 ) );
+    }
+
+    void test_invalid_addresses()
+    {
+        TS_ASSERT_THROWS_EQUALS( DnCListener( "localhost" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_CONNECTION_FAILED );
+        TS_ASSERT_THROWS_EQUALS( DnCListener( "unix:" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_CONNECTION_FAILED );
+
+        // Nobody listens there
+        TS_ASSERT_THROWS_EQUALS(
+            DnCConnection::connect( "unix:/tmp/marabou-dnc-test-no-such-socket.sock", 0 ),
+            const MarabouError &e,
+            e.getCode(),
+            MarabouError::DNC_CONNECTION_FAILED );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
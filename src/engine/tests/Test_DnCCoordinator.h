@@ -0,0 +1,239 @@
+/*********************                                                        */
+/*! \file Test_DnCCoordinator.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DnCCoordinator.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "PiecewiseLinearCaseSplit.h"
+
+#include <atomic>
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <thread>
+
+static const char *HELLO = "hello 3 1 0 0123456789abcdef";
+
+class MockForDnCCoordinator : public MockErrno
+{
+public:
+};
+
+class DnCCoordinatorTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCCoordinator *mock;
+
+    DnCProtocol::DivideConfig config;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCCoordinator );
+
+        config._divideStrategy = SnCDivideStrategy::LargestInterval;
+        config._onlineDivides = 1;
+        config._timeoutFactor = 1.5;
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    static SubQuery *createSubQuery( String queryId, unsigned depth )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split =
+            std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+        subQuery->_split->storeBoundTightening( Tightening( 0, depth, Tightening::LB ) );
+        subQuery->_timeoutInSeconds = 1;
+        subQuery->_depth = depth;
+        return subQuery;
+    }
+
+    /*
+      A worker process, as seen by the coordinator: subqueries at depth 0
+      time out and are divided in two, the others are UNSAT, except the one
+      of id satQueryId. Stop after maxSubQueries subqueries without
+      answering the last one.
+    */
+    static void serve( const String &address,
+                       const String &hello,
+                       const String &satQueryId,
+                       unsigned maxSubQueries,
+                       std::atomic_uint &numSolved )
+    {
+        try
+        {
+            std::unique_ptr<DnCConnection> connection( DnCConnection::connect( address, 5 ) );
+            connection->send( hello );
+
+            String message;
+            if ( !connection->receive( message ) ||
+                 DnCProtocol::getType( message ) != DnCProtocol::CONFIG )
+                return;
+            TS_ASSERT_EQUALS( DnCProtocol::decodeConfig( message )._onlineDivides, 1U );
+
+            unsigned count = 0;
+            while ( connection->receive( message ) &&
+                    DnCProtocol::getType( message ) == DnCProtocol::SOLVE )
+            {
+                std::unique_ptr<SubQuery> subQuery( DnCProtocol::decodeSolve( message ) );
+                if ( ++count == maxSubQueries )
+                    return;
+
+                IEngine::ExitCode result = IEngine::UNSAT;
+                SubQueries subQueries;
+                Map<unsigned, double> solution;
+                if ( subQuery->_queryId == satQueryId )
+                {
+                    result = IEngine::SAT;
+                    solution[0] = 1.5;
+                }
+                else if ( subQuery->_depth == 0 )
+                {
+                    result = IEngine::TIMEOUT;
+                    subQueries.append( createSubQuery( subQuery->_queryId + "-1", 1 ) );
+                    subQueries.append( createSubQuery( subQuery->_queryId + "-2", 1 ) );
+                }
+
+                ++numSolved;
+                connection->send( DnCProtocol::encodeResult( result, subQueries, solution ) );
+                for ( const auto &newSubQuery : subQueries )
+                    delete newSubQuery;
+            }
+        }
+        catch ( const MarabouError & )
+        {
+            // The coordinator is gone
+        }
+    }
+
+    void test_divide_until_unsat()
+    {
+        // Not written to the file
+        DnCCheckpoint checkpoint( "dnc-coordinator-test.checkpoint", HELLO );
+
+        DnCListener listener( DnCListener::localAddress() );
+        DnCCoordinator coordinator( &listener, HELLO, config, 0, &checkpoint );
+
+        std::atomic_uint numSolved( 0 );
+        std::thread first( serve, listener.getAddress(), HELLO, "", 0, std::ref( numSolved ) );
+        std::thread second( serve, listener.getAddress(), HELLO, "", 0, std::ref( numSolved ) );
+
+        SubQueries subQueries;
+        subQueries.append( createSubQuery( "1", 0 ) );
+        subQueries.append( createSubQuery( "2", 0 ) );
+        checkpoint.add( subQueries );
+        TS_ASSERT_EQUALS( coordinator.solve( subQueries, 0 ), IEngine::UNSAT );
+        TS_ASSERT( subQueries.empty() );
+        TS_ASSERT_EQUALS( checkpoint.size(), 0U );
+
+        // The workers are told to quit
+        first.join();
+        second.join();
+
+        // 2 subqueries, and the 4 created when they timed out
+        TS_ASSERT_EQUALS( numSolved.load(), 6U );
+        TS_ASSERT_EQUALS( coordinator.getNumWorkersJoined(), 2U );
+    }
+
+    void test_solution_from_worker()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+        DnCCoordinator coordinator( &listener, HELLO, config, 0 );
+
+        std::atomic_uint numSolved( 0 );
+        std::thread worker( serve, listener.getAddress(), HELLO, "2-1", 0, std::ref( numSolved ) );
+
+        SubQueries subQueries;
+        subQueries.append( createSubQuery( "1", 0 ) );
+        subQueries.append( createSubQuery( "2", 0 ) );
+        TS_ASSERT_EQUALS( coordinator.solve( subQueries, 0 ), IEngine::SAT );
+        worker.join();
+
+        TS_ASSERT_EQUALS( coordinator.getSolution().size(), 1U );
+        TS_ASSERT_EQUALS( coordinator.getSolution().at( 0 ), 1.5 );
+    }
+
+    void test_lost_and_mismatched_workers()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+        DnCCoordinator coordinator( &listener, HELLO, config, 0 );
+
+        std::atomic_uint numSolved( 0 );
+
+        // A worker with another query of the same dimensions, e.g. another
+        // property of the network, is dismissed right away
+        std::thread mismatched( serve,
+                                listener.getAddress(),
+                                "hello 3 1 0 fedcba9876543210",
+                                "",
+                                0,
+                                std::ref( numSolved ) );
+
+        // A worker that leaves while solving its first subquery, which is
+        // handed to the next worker
+        std::thread lost( serve, listener.getAddress(), HELLO, "", 1, std::ref( numSolved ) );
+
+        IEngine::ExitCode result = IEngine::NOT_DONE;
+        std::thread coordinating( [&] {
+            SubQueries subQueries;
+            subQueries.append( createSubQuery( "1-1", 1 ) );
+            subQueries.append( createSubQuery( "1-2", 1 ) );
+            result = coordinator.solve( subQueries, 0 );
+        } );
+
+        mismatched.join();
+        lost.join();
+        TS_ASSERT_EQUALS( numSolved.load(), 0U );
+
+        std::thread worker( serve, listener.getAddress(), HELLO, "", 0, std::ref( numSolved ) );
+        coordinating.join();
+        worker.join();
+
+        TS_ASSERT_EQUALS( result, IEngine::UNSAT );
+        TS_ASSERT_EQUALS( numSolved.load(), 2U );
+        TS_ASSERT_EQUALS( coordinator.getNumWorkersJoined(), 2U );
+    }
+
+    void test_timeout_and_no_workers()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+
+        {
+            DnCCoordinator coordinator( &listener, HELLO, config, 0 );
+            SubQueries subQueries;
+            subQueries.append( createSubQuery( "1", 0 ) );
+            TS_ASSERT_EQUALS( coordinator.solve( subQueries, 200000 ), IEngine::TIMEOUT );
+        }
+
+        {
+            DnCCoordinator coordinator( &listener, HELLO, config, 0 );
+            SubQueries subQueries;
+            subQueries.append( createSubQuery( "1", 0 ) );
+            TS_ASSERT_EQUALS( coordinator.solve( subQueries, 0, [] { return false; } ),
+                              IEngine::ERROR );
+        }
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,100 @@
+/*********************                                                        */
+/*! \file Test_DnCKnowledgeStore.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DnCKnowledgeStore.h"
+#include "MStringf.h"
+
+#include <cxxtest/TestSuite.h>
+#include <thread>
+#include <vector>
+
+class DnCKnowledgeStoreTestSuite : public CxxTest::TestSuite
+{
+public:
+    void test_is_descendant()
+    {
+        TS_ASSERT( DnCKnowledgeStore::isDescendant( "1-2", "" ) );
+        TS_ASSERT( DnCKnowledgeStore::isDescendant( "1-2", "1" ) );
+        TS_ASSERT( DnCKnowledgeStore::isDescendant( "1-2", "1-2" ) );
+        TS_ASSERT( DnCKnowledgeStore::isDescendant( "1-2-13", "1-2" ) );
+        TS_ASSERT( !DnCKnowledgeStore::isDescendant( "1-23", "1-2" ) );
+        TS_ASSERT( !DnCKnowledgeStore::isDescendant( "1", "1-2" ) );
+        TS_ASSERT( !DnCKnowledgeStore::isDescendant( "2-1", "1" ) );
+        TS_ASSERT( !DnCKnowledgeStore::isDescendant( "", "1" ) );
+    }
+
+    void test_collect_from_ancestors()
+    {
+        DnCKnowledgeStore knowledge;
+
+        knowledge.publish( "1", { Tightening( 0, 1, Tightening::LB ) } );
+        knowledge.publish(
+            "1-2", { Tightening( 1, 2, Tightening::UB ), Tightening( 2, 3, Tightening::LB ) } );
+        knowledge.publish( "1-3", { Tightening( 3, 4, Tightening::UB ) } );
+        knowledge.publish( "2", {} );
+        TS_ASSERT_EQUALS( knowledge.getNumPublished(), 4U );
+
+        List<Tightening> tightenings;
+        knowledge.collect( "1-2-1", tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 3U );
+        for ( const auto &tightening : tightenings )
+            TS_ASSERT( tightening._variable <= 2 );
+
+        knowledge.collect( "1-3", tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+
+        knowledge.collect( "2-1", tightenings );
+        TS_ASSERT( tightenings.empty() );
+
+        knowledge.recordImport( 3, 2, 1 );
+        knowledge.recordImport( 2, 0, 0 );
+        TS_ASSERT_EQUALS( knowledge.getNumImported(), 5U );
+        TS_ASSERT_EQUALS( knowledge.getNumImportedTightenings(), 2U );
+        TS_ASSERT_EQUALS( knowledge.getNumFixedConstraints(), 1U );
+    }
+
+    void test_concurrent_publish()
+    {
+        DnCKnowledgeStore knowledge;
+
+        std::vector<std::thread> threads;
+        for ( unsigned t = 0; t < 4; ++t )
+        {
+            threads.push_back( std::thread( [&knowledge, t] {
+                for ( unsigned i = 0; i < 250; ++i )
+                    knowledge.publish( Stringf( "%u", t + 1 ),
+                                       { Tightening( i, 0, Tightening::LB ) } );
+            } ) );
+        }
+        for ( auto &thread : threads )
+            thread.join();
+
+        TS_ASSERT_EQUALS( knowledge.getNumPublished(), 1000U );
+
+        List<Tightening> tightenings;
+        knowledge.collect( "", tightenings );
+        TS_ASSERT( tightenings.empty() );
+        knowledge.collect( "3-1", tightenings );
+        TS_ASSERT_EQUALS( tightenings.size(), 250U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
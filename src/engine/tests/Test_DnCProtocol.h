@@ -0,0 +1,238 @@
+/*********************                                                        */
+/*! \file Test_DnCProtocol.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DnCProtocol.h"
+#include "Equation.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "Query.h"
+#include "ReluConstraint.h"
+#include "Tightening.h"
+
+#include <cxxtest/TestSuite.h>
+
+class MockForDnCProtocol : public MockErrno
+{
+public:
+};
+
+class DnCProtocolTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDnCProtocol *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDnCProtocol );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    SubQuery *createSubQuery( String queryId, unsigned depth, unsigned timeout )
+    {
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+        split->storeBoundTightening( Tightening( 0, -0.1, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 0, 1.0 / 3, Tightening::UB ) );
+        split->storeBoundTightening( Tightening( 7, 0, Tightening::UB ) );
+
+        Equation equation( Equation::GE );
+        equation.addAddend( 1, 2 );
+        equation.addAddend( -2.5, 3 );
+        equation.setScalar( 1e-9 );
+        split->addEquation( equation );
+
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split = std::move( split );
+        subQuery->_timeoutInSeconds = timeout;
+        subQuery->_depth = depth;
+        return subQuery;
+    }
+
+    void assertSameSubQuery( const SubQuery &decoded, const SubQuery &original )
+    {
+        TS_ASSERT_EQUALS( decoded._queryId, original._queryId );
+        TS_ASSERT_EQUALS( decoded._depth, original._depth );
+        TS_ASSERT_EQUALS( decoded._timeoutInSeconds, original._timeoutInSeconds );
+        TS_ASSERT( !decoded._smtState );
+
+        // Values are exchanged exactly
+        TS_ASSERT( *decoded._split == *original._split );
+    }
+
+    void test_solve_round_trip()
+    {
+        SubQuery *subQuery = createSubQuery( "1-3-2", 2, 7 );
+        String message = DnCProtocol::encodeSolve( *subQuery );
+        TS_ASSERT_EQUALS( DnCProtocol::getType( message ), DnCProtocol::SOLVE );
+
+        SubQuery *decoded = NULL;
+        TS_ASSERT_THROWS_NOTHING( decoded = DnCProtocol::decodeSolve( message ) );
+        assertSameSubQuery( *decoded, *subQuery );
+        delete decoded;
+
+        // The root query has an empty id, and no bounds
+        SubQuery root;
+        root._split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+        root._timeoutInSeconds = 0;
+        root._depth = 0;
+        String rootMessage = DnCProtocol::encodeSolve( root );
+        TS_ASSERT_THROWS_NOTHING( decoded = DnCProtocol::decodeSolve( rootMessage ) );
+        assertSameSubQuery( *decoded, root );
+        delete decoded;
+
+        delete subQuery;
+    }
+
+    void test_result_round_trip()
+    {
+        SubQueries subQueries;
+        subQueries.append( createSubQuery( "1-1", 1, 3 ) );
+        subQueries.append( createSubQuery( "1-2", 1, 3 ) );
+        Map<unsigned, double> solution;
+        solution[0] = 0.1;
+        solution[5] = -1e30;
+
+        String message = DnCProtocol::encodeResult( IEngine::TIMEOUT, subQueries, solution );
+        TS_ASSERT_EQUALS( DnCProtocol::getType( message ), DnCProtocol::RESULT );
+
+        IEngine::ExitCode exitCode;
+        SubQueries decoded;
+        Map<unsigned, double> decodedSolution;
+        TS_ASSERT_THROWS_NOTHING(
+            DnCProtocol::decodeResult( message, exitCode, decoded, decodedSolution ) );
+        TS_ASSERT_EQUALS( exitCode, IEngine::TIMEOUT );
+        TS_ASSERT_EQUALS( decoded.size(), 2U );
+        TS_ASSERT_EQUALS( decodedSolution.size(), 2U );
+        TS_ASSERT_EQUALS( decodedSolution[0], 0.1 );
+        TS_ASSERT_EQUALS( decodedSolution[5], -1e30 );
+
+        auto original = subQueries.begin();
+        for ( const auto &subQuery : decoded )
+        {
+            assertSameSubQuery( *subQuery, **original );
+            ++original;
+            delete subQuery;
+        }
+
+        for ( const auto &subQuery : subQueries )
+            delete subQuery;
+    }
+
+    void test_hello_and_config()
+    {
+        Query query;
+        query.setNumberOfVariables( 4 );
+        Equation equation;
+        equation.addAddend( 1, 0 );
+        equation.addAddend( -1, 1 );
+        query.addEquation( equation );
+        query.setLowerBound( 0, -1 );
+        query.setUpperBound( 0, 1 );
+        String hello = DnCProtocol::encodeHello( query );
+        TS_ASSERT( hello.contains( "hello 4 1 0 " ) );
+        TS_ASSERT_EQUALS( hello.tokenize( " " ).size(), 5U );
+        TS_ASSERT_EQUALS( DnCProtocol::getType( hello ), DnCProtocol::HELLO );
+
+        // The same query is introduced the same way
+        Query same( query );
+        TS_ASSERT_EQUALS( DnCProtocol::encodeHello( same ), hello );
+
+        // Another property of the same dimensions is not
+        Query otherBounds( query );
+        otherBounds.setUpperBound( 0, 0.5 );
+        TS_ASSERT_DIFFERS( DnCProtocol::encodeHello( otherBounds ), hello );
+
+        Query otherEquation( query );
+        otherEquation.getEquations().front().setScalar( 1 );
+        TS_ASSERT_DIFFERS( DnCProtocol::encodeHello( otherEquation ), hello );
+
+        Query otherConstraint( query );
+        otherConstraint.addPiecewiseLinearConstraint( new ReluConstraint( 2, 3 ) );
+        Query otherParticipants( query );
+        otherParticipants.addPiecewiseLinearConstraint( new ReluConstraint( 3, 2 ) );
+        TS_ASSERT_DIFFERS( DnCProtocol::encodeHello( otherConstraint ),
+                           DnCProtocol::encodeHello( otherParticipants ) );
+
+        DnCProtocol::DivideConfig config;
+        config._divideStrategy = SnCDivideStrategy::Polarity;
+        config._onlineDivides = 3;
+        config._timeoutFactor = 1.5;
+        DnCProtocol::DivideConfig decoded =
+            DnCProtocol::decodeConfig( DnCProtocol::encodeConfig( config ) );
+        TS_ASSERT_EQUALS( decoded._divideStrategy, SnCDivideStrategy::Polarity );
+        TS_ASSERT_EQUALS( decoded._onlineDivides, 3U );
+        TS_ASSERT_EQUALS( decoded._timeoutFactor, 1.5 );
+
+        TS_ASSERT_EQUALS( DnCProtocol::getType( DnCProtocol::encodeQuit() ), DnCProtocol::QUIT );
+    }
+
+    void test_malformed_messages()
+    {
+        TS_ASSERT_THROWS_EQUALS( DnCProtocol::getType( "" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_MALFORMED_MESSAGE );
+        TS_ASSERT_THROWS_EQUALS( DnCProtocol::getType( "stop" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_MALFORMED_MESSAGE );
+        TS_ASSERT_THROWS_EQUALS( DnCProtocol::decodeConfig( "config 9 2 1.5" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_MALFORMED_MESSAGE );
+
+        // Truncated subqueries
+        SubQuery *subQuery = createSubQuery( "2", 0, 1 );
+        String message = DnCProtocol::encodeSolve( *subQuery );
+        delete subQuery;
+        TS_ASSERT_THROWS_EQUALS( DnCProtocol::decodeSolve( message.substring( 0, 30 ) ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_MALFORMED_MESSAGE );
+
+        IEngine::ExitCode exitCode;
+        SubQueries subQueries;
+        Map<unsigned, double> solution;
+        TS_ASSERT_THROWS_EQUALS(
+            DnCProtocol::decodeResult( "result 4 1 0\nquery 1\ndepth 1 timeout 1\nbounds 0",
+                                       exitCode,
+                                       subQueries,
+                                       solution ),
+            const MarabouError &e,
+            e.getCode(),
+            MarabouError::DNC_MALFORMED_MESSAGE );
+        TS_ASSERT( subQueries.empty() );
+
+        // An equation with fewer addends than announced
+        TS_ASSERT_THROWS_EQUALS( DnCProtocol::decodeSolve( "solve\nquery 1\ndepth 1 timeout 1\n"
+                                                           "bounds 0\nequations 1\n0 1 2 1 0" ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::DNC_MALFORMED_MESSAGE );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -18,11 +18,40 @@
 
 #include <cxxtest/TestSuite.h>
 #include <string.h>
+#include <thread>
+#include <vector>
+
+/*
+  A mock engine that times out on the subqueries given a timeout of at least
+  its time to solve, and refutes the others
+*/
+class MockEngineForStress : public MockEngine
+{
+public:
+    std::atomic_uint numRefuted;
+
+    MockEngineForStress()
+        : numRefuted( 0 )
+    {
+    }
+
+    bool solve( double timeoutInSeconds )
+    {
+        if ( timeoutInSeconds >= _timeToSolve )
+            _exitCode = IEngine::TIMEOUT;
+        else
+        {
+            _exitCode = IEngine::UNSAT;
+            ++numRefuted;
+        }
+        return false;
+    }
+};
 
 class DnCWorkerTestSuite : public CxxTest::TestSuite
 {
 public:
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<MockEngine> _engine;
 
     DnCWorkerTestSuite()
@@ -32,7 +61,7 @@ public:
 
     void setUp()
     {
-        _workload = new WorkerQueue( 0 );
+        _workload = new WorkStealingQueue( 1 );
 
         // Initialize the mockEngine
         _engine = std::make_shared<MockEngine>();
@@ -54,27 +83,25 @@ public:
     unsigned clearSubQueries()
     {
         unsigned counter = 0;
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
+        while ( SubQuery *subQuery = _workload->tryPop( 0 ) )
         {
-            _workload->pop( subQuery );
-            if ( subQuery )
-            {
-                delete subQuery;
-                subQuery = NULL;
-            }
+            delete subQuery;
             ++counter;
         }
 
         return counter;
     }
 
-    void createPlaceHolderSubQuery()
+    void createPlaceHolderSubQuery( String queryId = "" )
     {
         // Add a subQuery to workload.
         // This subQuery serves only as a placeholder, as the exitCode of the
         // mock engine after solving this subQuery does not depend on it.
+        _workload->push( 0, createSubQuery( queryId ) );
+    }
 
+    static SubQuery *createSubQuery( String queryId )
+    {
         SubQuery *subQuery = new SubQuery;
 
         auto split = std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
@@ -91,10 +118,11 @@ public:
         split->storeBoundTightening( bound5 );
         split->storeBoundTightening( bound6 );
 
-        subQuery->_queryId = "";
+        subQuery->_queryId = queryId;
         subQuery->_split = std::move( split );
         subQuery->_timeoutInSeconds = 5;
-        TS_ASSERT( _workload->push( std::move( subQuery ) ) );
+        subQuery->_depth = 0;
+        return subQuery;
     }
 
     // Test different branches of DnCWorker.popOneSubQueryAndSolve()
@@ -123,6 +151,8 @@ public:
         unsigned verbosity = 0;
         bool portfolio = false;
         DnCWorker dncWorker( _workload,
+                             NULL,
+                             NULL,
                              _engine,
                              numUnsolvedSubQueries,
                              shouldQuitSolving,
@@ -154,6 +184,8 @@ public:
         numUnsolvedSubQueries = 2;
         shouldQuitSolving = false;
         dncWorker = DnCWorker( _workload,
+                               NULL,
+                               NULL,
                                _engine,
                                numUnsolvedSubQueries,
                                shouldQuitSolving,
@@ -187,6 +219,8 @@ public:
         shouldQuitSolving = false;
 
         dncWorker = DnCWorker( _workload,
+                               NULL,
+                               NULL,
                                _engine,
                                numUnsolvedSubQueries,
                                shouldQuitSolving,
@@ -218,6 +252,8 @@ public:
         numUnsolvedSubQueries = ( 1 );
         shouldQuitSolving = ( false );
         dncWorker = DnCWorker( _workload,
+                               NULL,
+                               NULL,
                                _engine,
                                numUnsolvedSubQueries,
                                shouldQuitSolving,
@@ -248,6 +284,8 @@ public:
         numUnsolvedSubQueries = 1;
         shouldQuitSolving = true;
         dncWorker = DnCWorker( _workload,
+                               NULL,
+                               NULL,
                                _engine,
                                numUnsolvedSubQueries,
                                shouldQuitSolving,
@@ -277,6 +315,8 @@ public:
         shouldQuitSolving = false;
 
         dncWorker = DnCWorker( _workload,
+                               NULL,
+                               NULL,
                                _engine,
                                numUnsolvedSubQueries,
                                shouldQuitSolving,
@@ -292,6 +332,160 @@ public:
         TS_ASSERT( numUnsolvedSubQueries.load() == 1 );
         TS_ASSERT( shouldQuitSolving.load() );
     }
+
+    void test_no_early_unsat_when_stealing()
+    {
+        //  Many workers divide and refute a tree of subqueries: every subquery
+        //  above the depth threshold times out and is divided in 4, and the
+        //  ones below are refuted. Each of the 4^5 leaves must be refuted
+        //  before the count of unsolved subqueries drops to zero, however the
+        //  children are stolen.
+        const unsigned numWorkers = 8;
+        const unsigned numLeaves = 1024;
+
+        unsigned long long numSteals = 0;
+        for ( unsigned round = 0; round < 20; ++round )
+        {
+            WorkStealingQueue workload( numWorkers );
+            std::atomic_int numUnsolvedSubQueries( 1 );
+            std::atomic_bool shouldQuitSolving( false );
+
+            std::vector<std::shared_ptr<MockEngineForStress>> engines;
+            std::vector<std::unique_ptr<DnCWorker>> workers;
+            for ( unsigned i = 0; i < numWorkers; ++i )
+            {
+                auto engine = std::make_shared<MockEngineForStress>();
+                List<unsigned> inputVariables = { 1, 2, 3 };
+                engine->setInputVariables( inputVariables );
+                engine->setTimeToSolve( 1 );
+                engines.push_back( engine );
+                workers.push_back( std::unique_ptr<DnCWorker>(
+                    new DnCWorker( &workload,
+                                   NULL,
+                                   NULL,
+                                   engine,
+                                   numUnsolvedSubQueries,
+                                   shouldQuitSolving,
+                                   i,
+                                   2,
+                                   1,
+                                   SnCDivideStrategy::LargestInterval,
+                                   0,
+                                   false ) ) );
+            }
+
+            SubQuery *subQuery = createSubQuery( "1" );
+            subQuery->_timeoutInSeconds = 1;
+            workload.push( 0, subQuery );
+
+            std::vector<std::thread> threads;
+            for ( unsigned i = 0; i < numWorkers; ++i )
+                threads.push_back( std::thread( [&, i] {
+                    while ( !shouldQuitSolving.load() )
+                        workers[i]->popOneSubQueryAndSolve();
+                } ) );
+            for ( auto &thread : threads )
+                thread.join();
+
+            unsigned numRefuted = 0;
+            for ( const auto &engine : engines )
+                numRefuted += engine->numRefuted.load();
+            TS_ASSERT_EQUALS( numRefuted, numLeaves );
+            TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 0 );
+            TS_ASSERT( workload.empty() );
+            numSteals += workload.getNumSteals();
+        }
+        TS_ASSERT( numSteals > 0 );
+    }
+
+    void test_share_tightenings_with_descendants()
+    {
+        DnCKnowledgeStore knowledge;
+        std::atomic_int numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload,
+                             &knowledge,
+                             NULL,
+                             _engine,
+                             numUnsolvedSubQueries,
+                             shouldQuitSolving,
+                             0,
+                             1,
+                             1,
+                             SnCDivideStrategy::LargestInterval,
+                             0,
+                             false );
+
+        //  Subquery "2" times out, with a phase fixed at the root of its
+        //  search. The fact is published for its children "2-1" and "2-2".
+        createPlaceHolderSubQuery( "2" );
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+        _engine->rootLevelTightenings = { Tightening( 4, 0, Tightening::LB ) };
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT( _engine->importedTightenings.empty() );
+        TS_ASSERT_EQUALS( knowledge.getNumPublished(), 1U );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2 );
+
+        //  An unrelated subquery imports nothing
+        createPlaceHolderSubQuery( "3" );
+        _engine->setExitCode( IEngine::UNSAT );
+        _engine->rootLevelTightenings.clear();
+        numUnsolvedSubQueries += 1;
+
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT( _engine->importedTightenings.empty() );
+        TS_ASSERT_EQUALS( knowledge.getNumImported(), 0U );
+
+        //  A child of "2" imports the tightening
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( _engine->importedTightenings.size(), 1U );
+        TS_ASSERT_EQUALS( _engine->importedTightenings.front()._variable, 4U );
+        TS_ASSERT_EQUALS( knowledge.getNumImported(), 1U );
+        TS_ASSERT_EQUALS( knowledge.getNumImportedTightenings(), 1U );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 1 );
+        TS_ASSERT_EQUALS( clearSubQueries(), 1U );
+    }
+
+    void test_record_frontier_in_checkpoint()
+    {
+        // Not written to the file
+        DnCCheckpoint checkpoint( "dnc-worker-test.checkpoint", "hello 0 0 0 0000000000000000" );
+        std::atomic_int numUnsolvedSubQueries( 1 );
+        std::atomic_bool shouldQuitSolving( false );
+        DnCWorker dncWorker( _workload,
+                             NULL,
+                             &checkpoint,
+                             _engine,
+                             numUnsolvedSubQueries,
+                             shouldQuitSolving,
+                             0,
+                             1,
+                             1,
+                             SnCDivideStrategy::LargestInterval,
+                             0,
+                             false );
+
+        //  Subquery "2" times out, and is replaced by its children
+        createPlaceHolderSubQuery( "2" );
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( checkpoint.size(), 2U );
+
+        //  A child is UNSAT
+        _engine->setExitCode( IEngine::UNSAT );
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( checkpoint.size(), 1U );
+
+        //  The other child is left to solve when quitting
+        _engine->setExitCode( IEngine::QUIT_REQUESTED );
+        shouldQuitSolving = true;
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( checkpoint.size(), 1U );
+        TS_ASSERT_EQUALS( clearSubQueries(), 0U );
+    }
 };
 
 //
@@ -329,6 +329,43 @@ public:
         TS_ASSERT_EQUALS( *bounds.begin(), Tightening( 10, 0, Tightening::UB ) );
     }
 
+    void test_max_state_version()
+    {
+        unsigned f = 1;
+        Set<unsigned> elements;
+
+        for ( unsigned i = 2; i < 10; ++i )
+            elements.insert( i );
+
+        MaxConstraint max( f, elements );
+
+        Query ipq;
+        ipq.setNumberOfVariables( 10 );
+        TS_ASSERT_THROWS_NOTHING( max.transformToUseAuxVariables( ipq ) );
+
+        for ( unsigned i = 2; i < 10; i++ )
+        {
+            max.notifyUpperBound( i, 10 );
+            max.notifyLowerBound( i, 1 );
+        }
+
+        PiecewiseLinearConstraint *state = max.duplicateConstraint();
+        TS_ASSERT_EQUALS( state->getStateVersion(), max.getStateVersion() );
+
+        // Eliminating cases changes the state
+        max.notifyLowerBound( 2, 6 );
+        for ( unsigned i = 3; i < 10; i++ )
+            max.notifyUpperBound( i, 5 );
+        TS_ASSERT( max.phaseFixed() );
+        TS_ASSERT_DIFFERS( state->getStateVersion(), max.getStateVersion() );
+
+        max.restoreState( state );
+        TS_ASSERT( !max.phaseFixed() );
+        TS_ASSERT_EQUALS( state->getStateVersion(), max.getStateVersion() );
+
+        TS_ASSERT_THROWS_NOTHING( delete state );
+    }
+
     void test_max_var_elims()
     {
         unsigned f = 1;
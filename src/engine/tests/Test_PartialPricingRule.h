@@ -0,0 +1,151 @@
+/*********************                                                        */
+/*! \file Test_PartialPricingRule.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DantzigsRule.h"
+#include "MockTableau.h"
+#include "PartialPricingRule.h"
+
+#include <cxxtest/TestSuite.h>
+
+class MockForPartialPricingRule
+{
+public:
+};
+
+class PartialPricingRuleTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForPartialPricingRule *mock;
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForPartialPricingRule );
+        TS_ASSERT( tableau = new MockTableau );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_candidate_pool()
+    {
+        tableau->setDimensions( 10, 100 );
+
+        DantzigsRule dantzigsRule;
+        PartialPricingRule partialPricing;
+        partialPricing.setUnderlyingStrategy( &dantzigsRule );
+        partialPricing.setPoolSize( 2 );
+        TS_ASSERT_THROWS_NOTHING( partialPricing.initialize( *tableau ) );
+
+        tableau->mockCandidates = { 2, 3, 10, 51, 60 };
+        tableau->nextCostFunction[2] = -5;
+        tableau->nextCostFunction[3] = 7;
+        tableau->nextCostFunction[10] = -15;
+        tableau->nextCostFunction[51] = 12;
+        tableau->nextCostFunction[60] = 1;
+
+        Set<unsigned> excluded;
+        List<unsigned> candidates;
+
+        // The pool holds the two candidates with the largest reduced costs
+        partialPricing.getEntryCandidates( *tableau, candidates );
+        TS_ASSERT_EQUALS( candidates, List<unsigned>( { 10, 51 } ) );
+
+        TS_ASSERT( partialPricing.select( *tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 10U );
+        partialPricing.postPivotHook( *tableau, false );
+
+        // Variable 10 is no longer eligible, the pool is not rebuilt yet
+        tableau->mockCandidates = { 2, 3, 51, 60 };
+        tableau->nextCostFunction[2] = -20;
+        partialPricing.getEntryCandidates( *tableau, candidates );
+        TS_ASSERT_EQUALS( candidates, List<unsigned>( { 51 } ) );
+
+        // When the pool is exhausted, all eligible variables are priced
+        excluded.insert( 51 );
+        TS_ASSERT( partialPricing.select( *tableau, candidates, excluded ) );
+        TS_ASSERT_EQUALS( tableau->mockEnteringVariable, 2U );
+        excluded.clear();
+
+        // ... and the pool is rebuilt on the next iteration
+        partialPricing.getEntryCandidates( *tableau, candidates );
+        TS_ASSERT_EQUALS( candidates, List<unsigned>( { 2, 51 } ) );
+    }
+
+    void test_periodic_refresh()
+    {
+        tableau->setDimensions( 10, 100 );
+
+        DantzigsRule dantzigsRule;
+        PartialPricingRule partialPricing;
+        partialPricing.setUnderlyingStrategy( &dantzigsRule );
+        partialPricing.setPoolSize( 1 );
+        TS_ASSERT_THROWS_NOTHING( partialPricing.initialize( *tableau ) );
+
+        tableau->mockCandidates = { 2, 3 };
+        tableau->nextCostFunction[2] = -5;
+        tableau->nextCostFunction[3] = 7;
+
+        List<unsigned> candidates;
+        partialPricing.getEntryCandidates( *tableau, candidates );
+        TS_ASSERT_EQUALS( candidates, List<unsigned>( { 3 } ) );
+
+        tableau->nextCostFunction[2] = -9;
+        for ( unsigned i = 1; i < GlobalConfiguration::PARTIAL_PRICING_ITERATIONS_BEFORE_REFRESH;
+              ++i )
+        {
+            partialPricing.postPivotHook( *tableau, false );
+            partialPricing.getEntryCandidates( *tableau, candidates );
+            TS_ASSERT_EQUALS( candidates, List<unsigned>( { 3 } ) );
+        }
+
+        partialPricing.postPivotHook( *tableau, false );
+        partialPricing.getEntryCandidates( *tableau, candidates );
+        TS_ASSERT_EQUALS( candidates, List<unsigned>( { 2 } ) );
+    }
+
+    void test_complete_pool_does_not_fall_back()
+    {
+        tableau->setDimensions( 10, 100 );
+
+        DantzigsRule dantzigsRule;
+        PartialPricingRule partialPricing;
+        partialPricing.setUnderlyingStrategy( &dantzigsRule );
+        partialPricing.setPoolSize( 5 );
+        TS_ASSERT_THROWS_NOTHING( partialPricing.initialize( *tableau ) );
+
+        tableau->mockCandidates = { 2, 3 };
+        tableau->nextCostFunction[2] = -5;
+        tableau->nextCostFunction[3] = 7;
+
+        List<unsigned> candidates;
+        partialPricing.getEntryCandidates( *tableau, candidates );
+        TS_ASSERT_EQUALS( candidates, List<unsigned>( { 2, 3 } ) );
+
+        Set<unsigned> excluded = { 2, 3 };
+        TS_ASSERT( !partialPricing.select( *tableau, candidates, excluded ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
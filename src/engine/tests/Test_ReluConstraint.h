@@ -772,6 +772,44 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete relu2 );
     }
 
+    void test_state_version()
+    {
+        unsigned b = 1;
+        unsigned f = 4;
+
+        ReluConstraint relu( b, f );
+        ReluConstraint other( b, f );
+        TS_ASSERT_DIFFERS( relu.getStateVersion(), other.getStateVersion() );
+
+        // Registering a bound manager changes the state, which then refers to it
+        Context context;
+        BoundManager boundManager( context );
+        boundManager.initialize( 5 );
+        unsigned long long version = relu.getStateVersion();
+        relu.registerBoundManager( &boundManager );
+        TS_ASSERT_DIFFERS( relu.getStateVersion(), version );
+
+        // A copy has the version of the state it copies
+        PiecewiseLinearConstraint *state = relu.duplicateConstraint();
+        TS_ASSERT_EQUALS( state->getStateVersion(), relu.getStateVersion() );
+
+        // Bound notifications change no state outside of the bound manager
+        relu.notifyLowerBound( b, -1 );
+        relu.notifyUpperBound( b, 1 );
+        TS_ASSERT_EQUALS( state->getStateVersion(), relu.getStateVersion() );
+
+        // Renaming a variable does
+        relu.updateVariableIndex( f, 3 );
+        TS_ASSERT_DIFFERS( state->getStateVersion(), relu.getStateVersion() );
+
+        relu.restoreState( state );
+        TS_ASSERT_EQUALS( state->getStateVersion(), relu.getStateVersion() );
+        TS_ASSERT( relu.participatingVariable( f ) );
+        TS_ASSERT( !relu.participatingVariable( 3 ) );
+
+        TS_ASSERT_THROWS_NOTHING( delete state );
+    }
+
     void test_eliminate_variable_active()
     {
         unsigned b = 1;
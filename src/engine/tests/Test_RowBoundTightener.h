@@ -16,6 +16,7 @@
 #include "GlobalConfiguration.h"
 #include "MockTableau.h"
 #include "RowBoundTightener.h"
+#include "Statistics.h"
 
 #include <cxxtest/TestSuite.h>
 
@@ -418,4 +419,170 @@ public:
                                       Tightening( 2U, 2.0, Tightening::UB ) ),
                            tightenings.end() );
     }
+
+    void test_examine_constraint_matrix_worklist()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 2, 5 );
+        tightener.setBoundsPointers( tableau->getBoundManager().getLowerBounds(),
+                                     tableau->getBoundManager().getUpperBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 0, 3 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 1, -1 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 1, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, -10 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 2, 10 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 3, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 3, 1 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 2 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.setDimensions() );
+
+        /*
+           Equations:
+                x0 -2x1      +x3  +2x4 = 1
+                   -2x1 + x2           = -2
+        */
+
+        double A[] = {
+            1, -2, 0, 1, 2, //
+            0, -2, 1, 0, 0, //
+        };
+
+        double b[] = { 1, -2 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        List<Tightening> dontCare;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( dontCare ) );
+
+        // Initially, all rows are examined
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 4U );
+
+        TS_ASSERT_EQUALS( tightener.getNumRowsExaminedInLastCall(), 2U );
+        TS_ASSERT_EQUALS( tightener.getNumRowsTightenedInLastCall(), 2U );
+
+        if ( !GlobalConfiguration::ROW_BOUND_TIGHTENER_USE_WORKLIST )
+            return;
+
+        // No bound has changed since, so there is nothing to examine
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( true ) );
+        TS_ASSERT_EQUALS( tightener.getNumRowsExaminedInLastCall(), 0U );
+
+        /*
+          Tightening x2 <= 1.5 only affects the second equation, which
+          gives x1 <= 1.75
+        */
+        double column2[] = { 0, 1 };
+        tableau->nextAColumn[2] = column2;
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 2, 1.5 ) );
+        tightener.notifyBoundTightened( 2 );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+        TS_ASSERT_EQUALS( tightener.getNumRowsExaminedInLastCall(), 1U );
+        TS_ASSERT_EQUALS( tightener.getNumRowsTightenedInLastCall(), 1U );
+
+        tightenings.clear();
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+        TS_ASSERT_EQUALS( *tightenings.begin(), Tightening( 1U, 1.75, Tightening::UB ) );
+    }
+
+    void test_examine_constraint_matrix_skips_unbounded_rows()
+    {
+        RowBoundTightener tightener( *tableau );
+        Statistics statistics;
+        tightener.setStatistics( &statistics );
+
+        tableau->setDimensions( 1, 3 );
+        tightener.setBoundsPointers( tableau->getBoundManager().getLowerBounds(),
+                                     tableau->getBoundManager().getUpperBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, FloatUtils::negativeInfinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 0, FloatUtils::infinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 1, FloatUtils::negativeInfinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 1, FloatUtils::infinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 2, 1 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.setDimensions() );
+
+        /*
+           Equation:
+                x0 + x1 - x2 = 0
+
+           x0 and x1 are both unbounded, so nothing can be learned
+        */
+
+        double A[] = { 1, 1, -1 };
+        double b[] = { 0 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        List<Tightening> dontCare;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( dontCare ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT( tightenings.empty() );
+
+        TS_ASSERT_EQUALS( tightener.getNumRowsExaminedInLastCall(), 1U );
+        TS_ASSERT_EQUALS( tightener.getNumRowsTightenedInLastCall(), 0U );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_ROWS_SKIPPED_ON_CONSTRAINT_MATRIX ),
+            1ULL );
+    }
+
+    void test_examine_constraint_matrix_single_infinite_term()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 1, 3 );
+        tightener.setBoundsPointers( tableau->getBoundManager().getLowerBounds(),
+                                     tableau->getBoundManager().getUpperBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, FloatUtils::negativeInfinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 0, FloatUtils::infinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 1, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 1, FloatUtils::infinity() ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 2, 1 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.setDimensions() );
+
+        /*
+           Equation:
+                x0 + x1 - x2 = 0
+
+           The upper bound of x2 - x1 is finite, so x0 <= 1
+        */
+
+        double A[] = { 1, 1, -1 };
+        double b[] = { 0 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        List<Tightening> dontCare;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( dontCare ) );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 1U );
+        TS_ASSERT_EQUALS( *tightenings.begin(), Tightening( 0U, 1.0, Tightening::UB ) );
+    }
 };
@@ -0,0 +1,348 @@
+/*********************                                                        */
+/*! \file Test_SimplexSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief [[ Add one-line brief description here ]]
+ **
+ ** [[ Add lengthier description here ]]
+ **/
+
+#include "FloatUtils.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "SimplexSolver.h"
+
+#include <cstdlib>
+#include <cxxtest/TestSuite.h>
+
+class MockForSimplexSolver : public MockErrno
+{
+public:
+};
+
+class SimplexSolverTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForSimplexSolver *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForSimplexSolver );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    typedef SimplexSolver::Term Term;
+
+    double solveFor( SimplexSolver &solver, const List<Term> &terms, bool maximize )
+    {
+        solver.reset();
+        if ( maximize )
+            solver.setObjective( terms );
+        else
+            solver.setCost( terms );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+
+        Map<String, double> solution;
+        double value = 0;
+        solver.extractSolution( solution, value );
+        return value;
+    }
+
+    void test_small_lp()
+    {
+        SimplexSolver solver;
+
+        // x + 2y <= 4, 3x + y <= 6, 0 <= x, y <= 10
+        solver.addVariable( "x", 0, 10 );
+        solver.addVariable( "y", 0, 10 );
+        solver.addLeqConstraint( { Term( 1, "x" ), Term( 2, "y" ) }, 4 );
+        solver.addLeqConstraint( { Term( 3, "x" ), Term( 1, "y" ) }, 6 );
+
+        TS_ASSERT_EQUALS( solver.getNumberOfVariables(), 2U );
+        TS_ASSERT_EQUALS( solver.getNumberOfConstraints(), 2U );
+
+        solver.setObjective( { Term( 1, "x" ), Term( 1, "y" ) }, 1 );
+        TS_ASSERT_THROWS_NOTHING( solver.solve() );
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( !solver.infeasible() );
+
+        Map<String, double> solution;
+        double value = 0;
+        solver.extractSolution( solution, value );
+        TS_ASSERT( FloatUtils::areEqual( value, 3.8 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 1.6 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 1.2 ) );
+
+        // The bound proven by the multipliers is at least the maximum, and
+        // only loosened slightly for rounding errors
+        TS_ASSERT( solver.getObjectiveBound() >= 3.8 );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), 3.8, 0.000001 ) );
+
+        solver.setCost( { Term( 1, "x" ), Term( -1, "y" ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+        TS_ASSERT( solver.getObjectiveBound() <= -2 );
+        TS_ASSERT( FloatUtils::areEqual( solver.getObjectiveBound(), -2, 0.000001 ) );
+
+        TS_ASSERT( FloatUtils::areEqual(
+            solveFor( solver, { Term( 1, "x" ), Term( 1, "y" ) }, false ), 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x" ) }, true ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "y" ) }, true ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( -1, "y" ) }, false ), -2 ) );
+
+        // Adding an existing variable again intersects its bounds
+        TS_ASSERT_THROWS_NOTHING( solver.addVariable( "x", -1, 1 ) );
+        TS_ASSERT_EQUALS( solver.getLowerBound( "x" ), 0 );
+        TS_ASSERT_EQUALS( solver.getUpperBound( "x" ), 1 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x" ) }, true ), 1 ) );
+
+        TS_ASSERT_THROWS_EQUALS( solver.addLeqConstraint( { Term( 1, "z" ) }, 0 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::VARIABLE_INDEX_OUT_OF_RANGE );
+    }
+
+    void test_equalities_and_free_variables()
+    {
+        SimplexSolver solver;
+
+        // x - y = 1, y + z = 2, x free, 0 <= y <= 3, z >= -1
+        solver.addVariable( "x", FloatUtils::negativeInfinity(), FloatUtils::infinity() );
+        solver.addVariable( "y", 0, 3 );
+        solver.addVariable( "z", -1, FloatUtils::infinity() );
+        solver.addEqConstraint( { Term( 1, "x" ), Term( -1, "y" ) }, 1 );
+        solver.addEqConstraint( { Term( 1, "y" ), Term( 1, "z" ) }, 2 );
+
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x" ) }, true ), 4 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x" ) }, false ), 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "z" ) }, true ), 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "z" ) }, false ), -1 ) );
+
+        // Repeated variables are merged: 2x - x >= 3
+        solver.addGeqConstraint( { Term( 2, "x" ), Term( -1, "x" ) }, 3 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x" ) }, false ), 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "z" ) }, true ), 0 ) );
+    }
+
+    void test_infeasible_and_unbounded()
+    {
+        SimplexSolver solver;
+
+        solver.addVariable( "x", 0, 2 );
+        solver.addVariable( "y", 0, FloatUtils::infinity() );
+        solver.addLeqConstraint( { Term( 1, "x" ), Term( -1, "y" ) }, 1 );
+
+        solver.setObjective( { Term( 1, "y" ) } );
+        solver.solve();
+        TS_ASSERT( solver.unbounded() );
+        TS_ASSERT( !solver.optimal() );
+        TS_ASSERT_EQUALS( solver.getObjectiveBound(), FloatUtils::infinity() );
+
+        solver.setCost( { Term( 1, "y" ) } );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+
+        // x + y <= 3 and y >= 4 require x <= -1
+        solver.addLeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 3 );
+        solver.setLowerBound( "y", 4 );
+        TS_ASSERT_EQUALS( solver.getLowerBound( "y" ), 4 );
+        solver.solve();
+        TS_ASSERT( solver.infeasible() );
+        TS_ASSERT( !solver.haveFeasibleSolution() );
+        TS_ASSERT_EQUALS( solver.getObjectiveBound(), FloatUtils::negativeInfinity() );
+
+        solver.setLowerBound( "y", 1 );
+        solver.setUpperBound( "x", 1 );
+        TS_ASSERT_EQUALS( solver.getUpperBound( "x" ), 1 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "y" ) }, true ), 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x" ) }, true ), 1 ) );
+    }
+
+    void test_certified_infeasibility()
+    {
+        SimplexSolver solver;
+
+        // x + y <= 1 and x + y >= 1 + 1e-6, over a large box
+        solver.addVariable( "x", -1000, 1000 );
+        solver.addVariable( "y", -1000, 1000 );
+        solver.addLeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 1 );
+        solver.addGeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 1.000001 );
+        solver.setCost( { Term( 1, "x" ) } );
+        solver.solve();
+        TS_ASSERT( solver.infeasible() );
+
+        // A free variable leaves nothing to prove the optimal value with
+        SimplexSolver unbounded;
+        unbounded.addVariable( "x", FloatUtils::negativeInfinity(), FloatUtils::infinity() );
+        unbounded.addVariable( "y", 0, 1 );
+        unbounded.addEqConstraint( { Term( 1, "x" ), Term( -1, "y" ) }, 0 );
+        unbounded.setObjective( { Term( 1, "y" ) } );
+        unbounded.solve();
+        TS_ASSERT( unbounded.optimal() );
+        TS_ASSERT( unbounded.getObjectiveBound() >= 1 );
+    }
+
+    void test_cutoff()
+    {
+        SimplexSolver solver;
+
+        solver.addVariable( "x", 0, 1 );
+        solver.addVariable( "y", 0, 1 );
+        solver.addLeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 1.5 );
+
+        solver.setCutoff( 2 );
+        solver.setObjective( { Term( 1, "x" ), Term( 1, "y" ) } );
+        solver.solve();
+        TS_ASSERT( solver.cutoffOccurred() );
+        TS_ASSERT( !solver.optimal() );
+
+        solver.setCutoff( 1 );
+        solver.solve();
+        TS_ASSERT( solver.optimal() );
+    }
+
+    void test_warm_start()
+    {
+        SimplexSolver solver;
+
+        // A chain of 20 variables, x_i+1 <= x_i + 1 and x_i+1 >= x_i - 1
+        for ( unsigned i = 0; i < 20; ++i )
+            solver.addVariable( Stringf( "x%u", i ), -100, 100 );
+        solver.setLowerBound( "x0", 0 );
+        solver.setUpperBound( "x0", 0 );
+        for ( unsigned i = 0; i + 1 < 20; ++i )
+        {
+            Stringf current( "x%u", i );
+            Stringf next( "x%u", i + 1 );
+            solver.addLeqConstraint( { Term( 1, next ), Term( -1, current ) }, 1 );
+            solver.addGeqConstraint( { Term( 1, next ), Term( -1, current ) }, -1 );
+        }
+
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x19" ) }, true ), 19 ) );
+        unsigned coldIterations = solver.getNumberOfSimplexIterations();
+        TS_ASSERT( coldIterations > 0 );
+
+        // Warm started from the optimal basis of the first solve
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x18" ) }, true ), 18 ) );
+        TS_ASSERT( solver.getNumberOfSimplexIterations() < coldIterations );
+
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x19" ) }, false ), -19 ) );
+
+        // After a new constraint, the basis is extended rather than discarded
+        solver.addLeqConstraint( { Term( 1, "x19" ) }, 10 );
+        TS_ASSERT( FloatUtils::areEqual( solveFor( solver, { Term( 1, "x19" ) }, true ), 10 ) );
+
+        solver.resetModel();
+        TS_ASSERT_EQUALS( solver.getNumberOfVariables(), 0U );
+        TS_ASSERT_EQUALS( solver.getNumberOfConstraints(), 0U );
+        TS_ASSERT( !solver.containsVariable( "x0" ) );
+    }
+
+    void test_random_lps()
+    {
+        std::srand( 7 );
+
+        for ( unsigned run = 0; run < 50; ++run )
+        {
+            SimplexSolver solver;
+
+            unsigned numVariables = 3;
+            for ( unsigned i = 0; i < numVariables; ++i )
+                solver.addVariable( Stringf( "x%u", i ), -1, 1 );
+
+            // Random constraints that are satisfied by the origin
+            Vector<Vector<double>> rows;
+            Vector<double> scalars;
+            for ( unsigned j = 0; j < 4; ++j )
+            {
+                List<Term> terms;
+                Vector<double> row;
+                for ( unsigned i = 0; i < numVariables; ++i )
+                {
+                    double coefficient = ( std::rand() % 21 - 10 ) / 5.0;
+                    row.append( coefficient );
+                    terms.append( Term( coefficient, Stringf( "x%u", i ) ) );
+                }
+                double scalar = ( std::rand() % 10 + 1 ) / 10.0;
+                rows.append( row );
+                scalars.append( scalar );
+                solver.addLeqConstraint( terms, scalar );
+            }
+
+            List<Term> objective;
+            Vector<double> costs;
+            for ( unsigned i = 0; i < numVariables; ++i )
+            {
+                double cost = ( std::rand() % 21 - 10 ) / 5.0;
+                costs.append( cost );
+                objective.append( Term( cost, Stringf( "x%u", i ) ) );
+            }
+
+            solver.setObjective( objective );
+            solver.solve();
+            TS_ASSERT( solver.optimal() );
+
+            Map<String, double> solution;
+            double optimum = 0;
+            solver.extractSolution( solution, optimum );
+
+            // The solution is feasible
+            for ( unsigned j = 0; j < rows.size(); ++j )
+            {
+                double value = 0;
+                for ( unsigned i = 0; i < numVariables; ++i )
+                    value += rows[j][i] * solution[Stringf( "x%u", i )];
+                TS_ASSERT( FloatUtils::lte( value, scalars[j] ) );
+            }
+
+            // No point of a grid over the feasible region is better
+            for ( int a = -10; a <= 10; ++a )
+            {
+                for ( int b = -10; b <= 10; ++b )
+                {
+                    for ( int c = -10; c <= 10; ++c )
+                    {
+                        double point[3] = { a / 10.0, b / 10.0, c / 10.0 };
+                        bool feasible = true;
+                        for ( unsigned j = 0; j < rows.size() && feasible; ++j )
+                        {
+                            double value = 0;
+                            for ( unsigned i = 0; i < numVariables; ++i )
+                                value += rows[j][i] * point[i];
+                            feasible = value <= scalars[j];
+                        }
+
+                        if ( !feasible )
+                            continue;
+
+                        double value = 0;
+                        for ( unsigned i = 0; i < numVariables; ++i )
+                            value += costs[i] * point[i];
+                        TS_ASSERT( FloatUtils::lte( value, optimum ) );
+                    }
+                }
+            }
+        }
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -13,6 +13,7 @@
 
  **/
 
+#include "GlobalConfiguration.h"
 #include "MockEngine.h"
 #include "MockErrno.h"
 #include "Options.h"
@@ -561,6 +562,186 @@ public:
         TS_ASSERT_THROWS_NOTHING( smtCore.popSplit() );
     }
 
+    void splitOn( SmtCore &smtCore, PiecewiseLinearConstraint *constraint )
+    {
+        for ( unsigned i = 0;
+              i < (unsigned)Options::get()->getInt( Options::CONSTRAINT_VIOLATION_THRESHOLD );
+              ++i )
+            smtCore.reportViolatedConstraint( constraint );
+
+        TS_ASSERT( smtCore.needToSplit() );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+    }
+
+    void test_conflict_driven_learning()
+    {
+        // ReLU(x0, x1)
+        // ReLU(x2, x3)
+        // ReLU(x4, x5)
+
+        Query inputQuery;
+        inputQuery.setNumberOfVariables( 6 );
+
+        ReluConstraint relu1 = ReluConstraint( 0, 1 );
+        ReluConstraint relu2 = ReluConstraint( 2, 3 );
+        ReluConstraint relu3 = ReluConstraint( 4, 5 );
+
+        relu1.transformToUseAuxVariables( inputQuery );
+        relu2.transformToUseAuxVariables( inputQuery );
+        relu3.transformToUseAuxVariables( inputQuery );
+
+        // The first case of each constraint is taken first, the second one is its alternative
+        PiecewiseLinearCaseSplit first1 = relu1.getCaseSplits().front();
+        PiecewiseLinearCaseSplit second1 = relu1.getCaseSplits().back();
+        PiecewiseLinearCaseSplit first2 = relu2.getCaseSplits().front();
+        PiecewiseLinearCaseSplit second2 = relu2.getCaseSplits().back();
+        PiecewiseLinearCaseSplit first3 = relu3.getCaseSplits().front();
+        PiecewiseLinearCaseSplit second3 = relu3.getCaseSplits().back();
+
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, true );
+        engine->produceProofs = false;
+        SmtCore smtCore( engine );
+        Statistics statistics;
+        smtCore.setStatistics( &statistics );
+
+        // Decide relu3, relu1 and relu2, when relu1 and relu2 cannot take their first cases
+        // together
+        engine->conflicts.append( List<PiecewiseLinearCaseSplit>( { first1, first2 } ) );
+        splitOn( smtCore, &relu3 );
+        splitOn( smtCore, &relu1 );
+        splitOn( smtCore, &relu2 );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 3U );
+
+        // The learned clause is { first1, first2 }. The first case of relu2 is excluded at the
+        // level of relu1's decision.
+        EngineState *stateBeforeRelu2 = engine->lastStoredState;
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( engine->lastRestoredState, stateBeforeRelu2 );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+        TS_ASSERT_EQUALS( smtCore.getNumberOfConflictClauses(), 1U );
+
+        List<PiecewiseLinearCaseSplit> allSplits;
+        smtCore.allSplitsSoFar( allSplits );
+        TS_ASSERT_EQUALS( allSplits,
+                          List<PiecewiseLinearCaseSplit>( { first3, first1, second2 } ) );
+        TS_ASSERT( !relu2.isActive() );
+
+        // Now the first case of relu3 is refuted on its own. The search backjumps to the root,
+        // skipping the alternative of relu1, and excludes that case there.
+        engine->conflicts.append( List<PiecewiseLinearCaseSplit>( { first3 } ) );
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+        TS_ASSERT_EQUALS( smtCore.getNumberOfConflictClauses(), 2U );
+
+        smtCore.allSplitsSoFar( allSplits );
+        TS_ASSERT_EQUALS( allSplits, List<PiecewiseLinearCaseSplit>( { second3 } ) );
+        TS_ASSERT( !relu3.isActive() );
+
+        // The mock engine does not restore constraint states
+        relu1.setActiveConstraint( true );
+        relu2.setActiveConstraint( true );
+
+        // Deciding the first case of relu1 now implies the second case of relu2
+        splitOn( smtCore, &relu1 );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT( !relu2.isActive() );
+
+        smtCore.allSplitsSoFar( allSplits );
+        TS_ASSERT_EQUALS( allSplits,
+                          List<PiecewiseLinearCaseSplit>( { second3, first1, second2 } ) );
+
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_CONFLICT_CLAUSES_LEARNED ),
+                          2U );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_NON_CHRONOLOGICAL_BACKJUMPS ), 1U );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute(
+                              Statistics::NUM_CASE_SPLITS_IMPLIED_BY_CONFLICT_CLAUSES ),
+                          3U );
+
+        // When bound propagation does not refute the decisions, the pop is chronological
+        engine->conflicts.clear();
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        TS_ASSERT_EQUALS( smtCore.getNumberOfConflictClauses(), 2U );
+
+        smtCore.allSplitsSoFar( allSplits );
+        TS_ASSERT_EQUALS( allSplits, List<PiecewiseLinearCaseSplit>( { second3, second1 } ) );
+
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, false );
+    }
+
+    void test_conflict_analysis_propagation_budget()
+    {
+        // More decisions than conflict analysis may try to drop
+        unsigned numberOfConstraints = GlobalConfiguration::MAX_CONFLICT_ANALYSIS_PROPAGATIONS + 4;
+
+        Query inputQuery;
+        inputQuery.setNumberOfVariables( 2 * numberOfConstraints );
+
+        Vector<ReluConstraint *> relus;
+        for ( unsigned i = 0; i < numberOfConstraints; ++i )
+        {
+            relus.append( new ReluConstraint( 2 * i, 2 * i + 1 ) );
+            relus[i]->transformToUseAuxVariables( inputQuery );
+        }
+
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, true );
+        engine->produceProofs = false;
+        SmtCore smtCore( engine );
+
+        // Only the oldest decision is refuted
+        engine->conflicts.append(
+            List<PiecewiseLinearCaseSplit>( { relus[0]->getCaseSplits().front() } ) );
+        for ( const auto &relu : relus )
+            splitOn( smtCore, relu );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), numberOfConstraints );
+
+        // The most recent decisions are dropped from the conflict, but the four oldest ones are
+        // kept once the budget is spent. The search backjumps to the third of them.
+        engine->numRefutationQueries = 0;
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( engine->numRefutationQueries,
+                          GlobalConfiguration::MAX_CONFLICT_ANALYSIS_PROPAGATIONS + 1 );
+        TS_ASSERT_EQUALS( smtCore.getNumberOfConflictClauses(), 1U );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 3U );
+
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, false );
+        for ( const auto &relu : relus )
+            delete relu;
+    }
+
+    void test_conflict_analysis_skips_temporary_constraints()
+    {
+        Query inputQuery;
+        inputQuery.setNumberOfVariables( 4 );
+
+        ReluConstraint relu1 = ReluConstraint( 0, 1 );
+        ReluConstraint relu2 = ReluConstraint( 2, 3 );
+        relu1.transformToUseAuxVariables( inputQuery );
+        relu2.transformToUseAuxVariables( inputQuery );
+
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, true );
+        engine->produceProofs = false;
+        SmtCore smtCore( engine );
+
+        // relu1 stands for a constraint that the engine deletes once the next split is picked
+        engine->temporaryConstraint = &relu1;
+        engine->conflicts.append(
+            List<PiecewiseLinearCaseSplit>( { relu2.getCaseSplits().front() } ) );
+        splitOn( smtCore, &relu1 );
+        splitOn( smtCore, &relu2 );
+
+        // No clause may refer to it, so the pop is chronological
+        engine->numRefutationQueries = 0;
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( engine->numRefutationQueries, 0U );
+        TS_ASSERT_EQUALS( smtCore.getNumberOfConflictClauses(), 0U );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+
+        engine->temporaryConstraint = NULL;
+        Options::get()->setBool( Options::CONFLICT_DRIVEN_LEARNING, false );
+    }
+
     void clearSmtState( SmtState &smtState )
     {
         for ( const auto &stackEntry : smtState._stack )
@@ -20,6 +20,8 @@
 #include "MockCostFunctionManager.h"
 #include "MockErrno.h"
 #include "Options.h"
+#include "ReluConstraint.h"
+#include "Statistics.h"
 #include "Tableau.h"
 #include "TableauRow.h"
 #include "TableauState.h"
@@ -127,6 +129,54 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_set_sparse_constraint_matrix()
+    {
+        Tableau *tableau = NULL;
+        Context context;
+        BoundManager boundManager( context );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+
+        double A[] = {
+            3, 2, 1, 2, 1, 0, 0, //
+            1, 1, 1, 1, 0, 1, 0, //
+            4, 3, 3, 4, 0, 0, 1, //
+        };
+
+        SparseUnsortedArrays sparseA;
+        sparseA.initializeToEmpty( 3, 7 );
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            // Insert the entries in reverse order
+            for ( int j = 6; j >= 0; --j )
+            {
+                if ( A[i * 7 + j] != 0 )
+                    sparseA.append( i, j, A[i * 7 + j] );
+            }
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setConstraintMatrix( &sparseA ) );
+
+        double column[3];
+        for ( unsigned j = 0; j < 7; ++j )
+        {
+            tableau->getAColumn( j, column );
+            for ( unsigned i = 0; i < 3; ++i )
+            {
+                TS_ASSERT_EQUALS( column[i], A[i * 7 + j] );
+                TS_ASSERT_EQUALS( tableau->getSparseAColumn( j )->get( i ), A[i * 7 + j] );
+                TS_ASSERT_EQUALS( tableau->getSparseARow( i )->get( j ), A[i * 7 + j] );
+                TS_ASSERT_EQUALS( tableau->getSparseA()->get( i, j ), A[i * 7 + j] );
+            }
+        }
+
+        TS_ASSERT_EQUALS( tableau->getSparseA()->getNnz(), 15U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_initalize_basis_get_value()
     {
         Tableau *tableau = NULL;
@@ -382,9 +432,20 @@ public:
         // Var 4 will hit its lower bound: constraint is 4
         // Var 5 poses no constraint
         // Var 6 will hit its upper bound: constraint is 40
+        // With the bound-flipping ratio test, var 4 becoming feasible
+        // still leaves the sum of infeasibilities decreasing, so the
+        // entering variable jumps to its upper bound instead.
         TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d6 ) );
-        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 4u );
-        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 4.0 );
+        if ( GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+        {
+            TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 2u );
+            TS_ASSERT_EQUALS( tableau->getChangeRatio(), 9.0 );
+        }
+        else
+        {
+            TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 4u );
+            TS_ASSERT_EQUALS( tableau->getChangeRatio(), 4.0 );
+        }
 
         double d7[] = { 1, 0, 0.00001 };
         // The entering variable (2) can change by 9 at most. Here
@@ -396,6 +457,183 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_get_leaving_variable_bound_flipping()
+    {
+        if ( !GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+            return;
+
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+        Statistics statistics;
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        tableau->setStatistics( &statistics );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeCostFunction() );
+
+        costFunctionManager.nextCostFunction = new double[4];
+        costFunctionManager.nextCostFunction[0] = -1;
+        costFunctionManager.nextCostFunction[1] = -1;
+        costFunctionManager.nextCostFunction[2] = -1;
+        costFunctionManager.nextCostFunction[3] = -1;
+
+        costFunctionManager.nextBasicCost[0] = -1;
+        costFunctionManager.nextBasicCost[1] = 0;
+        costFunctionManager.nextBasicCost[2] = +1;
+
+        tableau->setEnteringVariableIndex( 2u );
+        TS_ASSERT( hasCandidates( *tableau ) );
+
+        // Entering variable is 2, and it needs to increase, by 9 at most.
+        // Current basic values are: 217 (too low), 113, 406 (too high)
+
+        double d1[] = { -1, 0, 0.5 };
+        // Slope is -1.5. Var 4 becomes feasible after 2 (slope -0.5), and
+        // var 6 after 8 (slope 0): var 6 leaves
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d1 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 8.0 );
+
+        double d2[] = { -2, 0, 0.1 };
+        // Var 4 becomes feasible after 1, but then hits its upper bound
+        // after 5.5: stop at its lower bound
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d2 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 4u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 1.0 );
+
+        double d3[] = { -1, 0.25, 0.1 };
+        // Var 4 becomes feasible after 2, and var 5 hits its lower
+        // bound after 4: var 5 leaves
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d3 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 5u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 4.0 );
+
+        double d4[] = { -0.5, 0, 0.1 };
+        // Var 4 becomes feasible after 4, and the slope is still
+        // negative: the entering variable jumps to its upper bound
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d4 ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 2u );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 9.0 );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_perform_pivot_bound_flipping()
+    {
+        if ( !GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+            return;
+
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+        Statistics statistics;
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        tableau->setStatistics( &statistics );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 200 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 215 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 120 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 300 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 370 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_EQUALS( tableau->getBasicStatus( 4 ), Tableau::ABOVE_UB );
+        TS_ASSERT_EQUALS( tableau->getBasicStatus( 5 ), Tableau::BETWEEN );
+        TS_ASSERT_EQUALS( tableau->getBasicStatus( 6 ), Tableau::ABOVE_UB );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeCostFunction() );
+
+        costFunctionManager.nextCostFunction = new double[4];
+        costFunctionManager.nextCostFunction[0] = -1;
+        costFunctionManager.nextCostFunction[1] = -1;
+        costFunctionManager.nextCostFunction[2] = -1;
+        costFunctionManager.nextCostFunction[3] = -1;
+
+        costFunctionManager.nextBasicCost[0] = +1;
+        costFunctionManager.nextBasicCost[1] = 0;
+        costFunctionManager.nextBasicCost[2] = +1;
+
+        tableau->setEnteringVariableIndex( 2u );
+        TS_ASSERT( hasCandidates( *tableau ) );
+
+        /*
+          Entering variable is 2, and it increases by 9 at most.
+          x5 = 217 - x3: becomes feasible after 2
+          x6 = 113 - x3: hits its lower bound after 13
+          x7 = 406 - 3x3: becomes feasible after 12
+
+          So, the sum of infeasibilities keeps decreasing for the whole
+          range of x3, which jumps to its upper bound.
+        */
+        TS_ASSERT_THROWS_NOTHING( tableau->computeChangeColumn() );
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable() );
+        TS_ASSERT( tableau->performingFakePivot() );
+        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 9.0 );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->performPivot() );
+
+        TS_ASSERT( !tableau->isBasic( 2u ) );
+        TS_ASSERT_EQUALS( tableau->getValue( 2u ), 10.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 4u ), 208.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 5u ), 104.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 6u ), 379.0 );
+        TS_ASSERT_EQUALS( tableau->getBasicStatus( 4 ), Tableau::BETWEEN );
+        TS_ASSERT_EQUALS( tableau->getBasicStatus( 6 ), Tableau::ABOVE_UB );
+
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BREAKPOINTS_PASSED ),
+            1U );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_TABLEAU_LONG_STEP_BOUND_FLIPS ), 1U );
+        TS_ASSERT_EQUALS( statistics.getLongAttribute( Statistics::NUM_TABLEAU_BOUND_HOPPING ),
+                          1U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_perform_pivot_nonbasic_goes_to_opposite_bound()
     {
         Tableau *tableau = NULL;
@@ -540,6 +778,108 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_dual_simplex_step()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 210 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 220 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 110 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // x4 = 217 and x5 = 113 are within bounds, x6 = 406 is too high
+        TS_ASSERT_EQUALS( tableau->getValue( 4u ), 217.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 5u ), 113.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 6u ), 406.0 );
+
+        TS_ASSERT( tableau->pickDualLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+
+        // x6 = 420 - 4x1 - 3x2 - 3x3 - 4x4. All non-basics can increase,
+        // so the one with the largest coefficient enters.
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT( tableau->pickDualEnteringVariable() );
+        TS_ASSERT_EQUALS( tableau->getEnteringVariable(), 0u );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeChangeColumn() );
+        TS_ASSERT_THROWS_NOTHING( tableau->performPivot() );
+
+        TS_ASSERT( tableau->isBasic( 0u ) );
+        TS_ASSERT( !tableau->isBasic( 6u ) );
+
+        // x6 is now at its upper bound, and the assignment is feasible
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 6u ), 402.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 0u ), 2.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 4u ), 214.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 5u ), 112.0 ) );
+        TS_ASSERT( !tableau->existsBasicOutOfBounds() );
+        TS_ASSERT( !tableau->pickDualLeavingVariable() );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_dual_simplex_step_no_entering_variable()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 1000 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 1000 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 500 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 1000 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // x6 = 420 - 4x1 - 3x2 - 3x3 - 4x4 = 406 is too low, and could
+        // only increase if a non-basic decreased. But all non-basics are
+        // at their lower bounds, so the row proves infeasibility.
+        TS_ASSERT( tableau->pickDualLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT( !tableau->pickDualEnteringVariable() );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_get_row()
     {
         Tableau *tableau = NULL;
@@ -955,6 +1295,67 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_variable_watchers()
+    {
+        Tableau *tableau = NULL;
+        Context context;
+        BoundManager boundManager( context );
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+
+        MockVariableWatcher watcher1;
+        MockVariableWatcher watcher2;
+        MockVariableWatcher globalWatcher;
+
+        Statistics statistics;
+        ReluConstraint relu( 1, 4 );
+        relu.setStatistics( &statistics );
+
+        tableau->registerToWatchVariable( &watcher1, 2 );
+        tableau->registerToWatchVariable( &watcher2, 2 );
+        tableau->registerToWatchVariable( &watcher2, 5 );
+        tableau->registerToWatchAllVariables( &globalWatcher );
+        relu.registerAsWatcher( tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, 1 ) );
+        TS_ASSERT_EQUALS( watcher1.lastNotifiedLowerBounds[2], 1 );
+        TS_ASSERT_EQUALS( watcher2.lastNotifiedLowerBounds[2], 1 );
+        TS_ASSERT_EQUALS( globalWatcher.lastNotifiedLowerBounds[2], 1 );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 3 ) );
+        TS_ASSERT( !watcher1.lastNotifiedUpperBounds.exists( 5 ) );
+        TS_ASSERT_EQUALS( watcher2.lastNotifiedUpperBounds[5], 3 );
+        TS_ASSERT_EQUALS( globalWatcher.lastNotifiedUpperBounds[5], 3 );
+
+        // ReLU constraints are notified of bounds on their variables only
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 1, 5 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 5 ) );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_BOUND_NOTIFICATIONS_TO_PL_CONSTRAINTS ),
+            2ULL );
+
+        // Variables without watchers are skipped
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, 1 ) );
+        TS_ASSERT( !watcher1.lastNotifiedLowerBounds.exists( 0 ) );
+
+        // Unregistered watchers are no longer notified
+        tableau->unregisterToWatchVariable( &watcher1, 2 );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, 2 ) );
+        TS_ASSERT_EQUALS( watcher1.lastNotifiedLowerBounds[2], 1 );
+        TS_ASSERT_EQUALS( watcher2.lastNotifiedLowerBounds[2], 2 );
+
+        relu.unregisterAsWatcher( tableau );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 1 ) );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_BOUND_NOTIFICATIONS_TO_PL_CONSTRAINTS ),
+            2ULL );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_store_and_restore()
     {
         Tableau *tableau = NULL;
@@ -1089,6 +1490,108 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_store_and_restore_after_adding_equation()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+        Context context;
+        BoundManager boundManager( context );
+        Statistics statistics;
+
+        TS_ASSERT_THROWS_NOTHING( boundManager.initialize( 7 ) );
+        TS_ASSERT( tableau = new Tableau( boundManager ) );
+        TS_ASSERT_THROWS_NOTHING( boundManager.registerTableau( tableau ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        tableau->setStatistics( &statistics );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        double values[7];
+        for ( unsigned i = 0; i < 7; ++i )
+            values[i] = tableau->getValue( i );
+
+        TableauState *tableauState = NULL;
+        TS_ASSERT( tableauState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState(
+            *tableauState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+
+        // The states stored while the constraint matrix does not change share its copy
+        TableauState *sameMatrixState = NULL;
+        TS_ASSERT( sameMatrixState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState(
+            *sameMatrixState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+        TS_ASSERT( tableauState->_constraintMatrix );
+        TS_ASSERT_EQUALS( sameMatrixState->_constraintMatrix, tableauState->_constraintMatrix );
+        TS_ASSERT_THROWS_NOTHING( delete sameMatrixState );
+
+        // The constraint matrix has not changed, so it is kept as is
+        const SparseUnsortedList *row = tableau->getSparseARow( 0 );
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState(
+            *tableauState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+        TS_ASSERT_EQUALS( tableau->getSparseARow( 0 ), row );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_INCREMENTAL_TABLEAU_RESTORATIONS ),
+            1ULL );
+
+        // Adding an equation changes the constraint matrix
+        Equation equation;
+        equation.addAddend( 2, 1 );
+        equation.addAddend( -4, 2 );
+        equation.setScalar( 5 );
+        TS_ASSERT_THROWS_NOTHING( tableau->addEquation( equation ) );
+        TS_ASSERT_EQUALS( tableau->getM(), 4U );
+        TS_ASSERT_EQUALS( tableau->getN(), 8U );
+
+        TableauState *otherMatrixState = NULL;
+        TS_ASSERT( otherMatrixState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState(
+            *otherMatrixState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+        TS_ASSERT_DIFFERS( otherMatrixState->_constraintMatrix, tableauState->_constraintMatrix );
+        TS_ASSERT_EQUALS( otherMatrixState->_constraintMatrix->_m, 4U );
+        TS_ASSERT_THROWS_NOTHING( delete otherMatrixState );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState(
+            *tableauState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+        TS_ASSERT_EQUALS( tableau->getM(), 3U );
+        TS_ASSERT_EQUALS( tableau->getN(), 7U );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_INCREMENTAL_TABLEAU_RESTORATIONS ),
+            1ULL );
+
+        for ( unsigned i = 0; i < 7; ++i )
+            TS_ASSERT_EQUALS( tableau->getValue( i ), values[i] );
+
+        // Once restored, the matrix matches the state again
+        row = tableau->getSparseARow( 0 );
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState(
+            *tableauState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+        TS_ASSERT_EQUALS( tableau->getSparseARow( 0 ), row );
+        TS_ASSERT_EQUALS(
+            statistics.getLongAttribute( Statistics::NUM_INCREMENTAL_TABLEAU_RESTORATIONS ),
+            2ULL );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableauState );
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_add_equation()
     {
         Tableau *tableau = NULL;
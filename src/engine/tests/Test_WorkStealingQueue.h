@@ -0,0 +1,140 @@
+/*********************                                                        */
+/*! \file Test_WorkStealingQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "WorkStealingQueue.h"
+
+#include <atomic>
+#include <cxxtest/TestSuite.h>
+#include <thread>
+
+class WorkStealingQueueTestSuite : public CxxTest::TestSuite
+{
+public:
+    SubQuery *createSubQuery( String queryId )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split =
+            std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+        subQuery->_timeoutInSeconds = 0;
+        subQuery->_depth = 0;
+        return subQuery;
+    }
+
+    String popId( WorkStealingQueue &queue, unsigned worker )
+    {
+        SubQuery *subQuery = queue.tryPop( worker );
+        TS_ASSERT( subQuery );
+        if ( !subQuery )
+            return "";
+        String queryId = subQuery->_queryId;
+        delete subQuery;
+        return queryId;
+    }
+
+    void test_local_lifo_and_stealing_fifo()
+    {
+        WorkStealingQueue queue( 3 );
+        TS_ASSERT_EQUALS( queue.getNumWorkers(), 3U );
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT( !queue.tryPop( 0 ) );
+
+        queue.push( 0, createSubQuery( "a" ) );
+        queue.push( 0, createSubQuery( "b" ) );
+        queue.push( 0, createSubQuery( "c" ) );
+        queue.push( 2, createSubQuery( "d" ) );
+        TS_ASSERT_EQUALS( queue.size(), 4U );
+
+        // Worker 0 takes its most recent subquery
+        TS_ASSERT_EQUALS( popId( queue, 0 ), "c" );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 0U );
+
+        // Worker 1 has nothing, and steals the oldest subquery of worker 2
+        TS_ASSERT_EQUALS( popId( queue, 1 ), "d" );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 1U );
+
+        // Then the oldest subquery of worker 0
+        TS_ASSERT_EQUALS( popId( queue, 1 ), "a" );
+        TS_ASSERT_EQUALS( queue.getNumSteals(), 2U );
+
+        TS_ASSERT_EQUALS( popId( queue, 0 ), "b" );
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT( !queue.tryPop( 2 ) );
+
+        // Pending subqueries are deleted with the queue
+        queue.push( 1, createSubQuery( "e" ) );
+    }
+
+    void test_pop_blocks_until_push()
+    {
+        WorkStealingQueue queue( 2 );
+        std::atomic_bool shouldQuit( false );
+
+        String queryId;
+        std::thread worker( [&] {
+            SubQuery *subQuery = queue.pop( 1, shouldQuit );
+            if ( subQuery )
+            {
+                queryId = subQuery->_queryId;
+                delete subQuery;
+            }
+        } );
+
+        queue.push( 0, createSubQuery( "a" ) );
+        worker.join();
+
+        TS_ASSERT_EQUALS( queryId, "a" );
+        TS_ASSERT( queue.empty() );
+    }
+
+    void test_pop_and_wait_return_on_quit()
+    {
+        WorkStealingQueue queue( 2 );
+        std::atomic_bool shouldQuit( false );
+
+        SubQuery *popped = createSubQuery( "placeholder" );
+        std::thread worker( [&] {
+            delete popped;
+            popped = queue.pop( 0, shouldQuit );
+        } );
+        std::thread manager( [&] { queue.waitForQuit( shouldQuit, 0 ); } );
+
+        shouldQuit = true;
+        queue.wakeUpAll();
+        worker.join();
+        manager.join();
+
+        TS_ASSERT( !popped );
+
+        // Subqueries already pushed are still handed out
+        queue.push( 1, createSubQuery( "a" ) );
+        SubQuery *subQuery = queue.pop( 0, shouldQuit );
+        TS_ASSERT( subQuery );
+        delete subQuery;
+
+        // Without the flag, waitForQuit returns after the timeout
+        shouldQuit = false;
+        queue.waitForQuit( shouldQuit, 1000 );
+        TS_ASSERT( !shouldQuit.load() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
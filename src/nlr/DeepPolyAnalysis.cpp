@@ -33,6 +33,7 @@
 #include "MStringf.h"
 #include "MatrixMultiplication.h"
 #include "NLRError.h"
+#include "Options.h"
 #include "TimeUtils.h"
 
 #include <boost/thread.hpp>
@@ -41,24 +42,29 @@ namespace NLR {
 
 DeepPolyAnalysis::DeepPolyAnalysis( LayerOwner *layerOwner )
     : _layerOwner( layerOwner )
-    , _work1SymbolicLb( NULL )
-    , _work1SymbolicUb( NULL )
-    , _work2SymbolicLb( NULL )
-    , _work2SymbolicUb( NULL )
-    , _workSymbolicLowerBias( NULL )
-    , _workSymbolicUpperBias( NULL )
+    , _threadPool( getNumberOfThreads() )
+    , _hasRun( false )
+    , _numLayersExecuted( 0 )
+    , _numLayersSkipped( 0 )
 {
     const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
     // Get the maximal layer size
     unsigned maxLayerSize = 0;
+    unsigned numNeurons = 0;
     for ( const auto &pair : layers )
     {
         unsigned thisLayerSize = pair.second->getSize();
         if ( thisLayerSize > maxLayerSize )
             maxLayerSize = thisLayerSize;
+        numNeurons += thisLayerSize;
     }
     _maxLayerSize = maxLayerSize;
 
+    _previousStartLbs.assign( numNeurons, 0 );
+    _previousStartUbs.assign( numNeurons, 0 );
+    _previousEndLbs.assign( numNeurons, 0 );
+    _previousEndUbs.assign( numNeurons, 0 );
+
     allocateMemory();
     for ( const auto &pair : layers )
     {
@@ -73,6 +79,8 @@ DeepPolyAnalysis::DeepPolyAnalysis( LayerOwner *layerOwner )
         _deepPolyElements[index] = deepPolyElement;
         log( Stringf( "Creating deeppoly element for layer %u - done", index ) );
     }
+
+    computeSlopeOptimizationChain();
 }
 
 DeepPolyAnalysis::~DeepPolyAnalysis()
@@ -87,36 +95,11 @@ void DeepPolyAnalysis::freeMemoryIfNeeded()
         if ( pair.second )
             delete pair.second;
     }
-    if ( _work1SymbolicLb )
-    {
-        delete[] _work1SymbolicLb;
-        _work1SymbolicLb = NULL;
-    }
-    if ( _work2SymbolicLb )
-    {
-        delete[] _work2SymbolicLb;
-        _work2SymbolicLb = NULL;
-    }
-    if ( _work1SymbolicUb )
-    {
-        delete[] _work1SymbolicUb;
-        _work1SymbolicUb = NULL;
-    }
-    if ( _work2SymbolicUb )
-    {
-        delete[] _work2SymbolicUb;
-        _work2SymbolicUb = NULL;
-    }
-    if ( _workSymbolicLowerBias )
-    {
-        delete[] _workSymbolicLowerBias;
-        _workSymbolicLowerBias = NULL;
-    }
-    if ( _workSymbolicUpperBias )
-    {
-        delete[] _workSymbolicUpperBias;
-        _workSymbolicUpperBias = NULL;
-    }
+    _deepPolyElements.clear();
+
+    for ( const auto &memory : _workMemory )
+        delete memory;
+    _workMemory.clear();
 }
 
 void DeepPolyAnalysis::run()
@@ -128,6 +111,18 @@ void DeepPolyAnalysis::run()
 
     deepPolyStart = TimeUtils::sampleMicro();
 
+    _numLayersExecuted = 0;
+    _numLayersSkipped = 0;
+
+    /*
+      Layers are only skipped while all of the preceding layers are too.
+      If this run is interrupted (e.g., by an infeasibility), the next
+      one starts from scratch.
+    */
+    bool skipLayers = _hasRun && GlobalConfiguration::DEEP_POLY_INCREMENTAL_ANALYSIS;
+    _hasRun = false;
+    unsigned offset = 0;
+
     const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
     for ( const auto &pair : layers )
     {
@@ -139,11 +134,29 @@ void DeepPolyAnalysis::run()
         Layer *layer = pair.second;
 
         ASSERT( _deepPolyElements.exists( index ) );
-        log( Stringf( "Running deeppoly analysis for layer %u...", index ) );
         DeepPolyElement *deepPolyElement = _deepPolyElements[index];
-        deepPolyElement->execute( _deepPolyElements );
 
-        // Extract updated bounds
+        skipLayers = skipLayers && layerBoundsUnchanged( layer, offset );
+        storeStartBounds( layer, offset );
+
+        if ( skipLayers )
+        {
+            log( Stringf( "Bounds of layer %u unchanged, reusing deeppoly results", index ) );
+            ++_numLayersSkipped;
+        }
+        else
+        {
+            log( Stringf( "Running deeppoly analysis for layer %u...", index ) );
+            deepPolyElement->execute( _deepPolyElements );
+            ++_numLayersExecuted;
+        }
+
+        /*
+          Extract updated bounds. This is done for skipped layers as well,
+          as tightenings found by previous runs may since have been lost
+          (e.g., by backtracking).
+        */
+
         for ( unsigned j = 0; j < deepPolyElement->getSize(); ++j )
         {
             if ( layer->neuronEliminated( j ) )
@@ -173,28 +186,389 @@ void DeepPolyAnalysis::run()
                     Tightening( layer->neuronToVariable( j ), ub, Tightening::UB ) );
             }
         }
+        storeEndBounds( layer, offset );
+        offset += layer->getSize();
         log( Stringf( "Running deeppoly analysis for layer %u - done", index ) );
     }
+
+    _hasRun = true;
+}
+
+void DeepPolyAnalysis::runWithOptimizedSlopes()
+{
+    if ( _slopeOptimizationChain.empty() )
+    {
+        run();
+        return;
+    }
+
+    for ( const auto &index : _slopeOptimizationChain )
+    {
+        if ( _deepPolyElements[index]->getLayerType() == Layer::RELU )
+            static_cast<DeepPolyReLUElement *>( _deepPolyElements[index] )
+                ->enableOptimizableSlopes();
+    }
+
+    unsigned numLayersExecuted = 0;
+    unsigned numLayersSkipped = 0;
+    double stepSize = GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_STEP_SIZE;
+    double previousObjective = FloatUtils::negativeInfinity();
+    for ( unsigned iteration = 0;; ++iteration )
+    {
+        run();
+        numLayersExecuted += _numLayersExecuted;
+        numLayersSkipped += _numLayersSkipped;
+
+        if ( iteration == GlobalConfiguration::DEEP_POLY_SLOPE_OPTIMIZATION_ITERATIONS )
+            break;
+
+        double objective = 0;
+        Map<unsigned, Vector<double>> gradients;
+        if ( !computeSlopeGradients( objective, gradients ) )
+            break;
+
+        log( Stringf( "Slope optimization iteration %u: objective %f", iteration, objective ) );
+        if ( objective <= previousObjective )
+            stepSize /= 2;
+        previousObjective = objective;
+
+        // The step is scaled so that the largest change to a slope is the step size
+        double largestEntry = 0;
+        for ( const auto &pair : gradients )
+        {
+            for ( const auto &entry : pair.second )
+                largestEntry = std::max( largestEntry, FloatUtils::abs( entry ) );
+        }
+        if ( FloatUtils::isZero( largestEntry ) )
+            break;
+
+        for ( const auto &pair : gradients )
+        {
+            DeepPolyReLUElement *element =
+                static_cast<DeepPolyReLUElement *>( _deepPolyElements[pair.first] );
+            for ( unsigned i = 0; i < pair.second.size(); ++i )
+            {
+                if ( !element->slopeInUse( i ) )
+                    continue;
+                double slope = element->getSlope( i ) + stepSize * pair.second[i] / largestEntry;
+                element->setSlope( i, std::min( std::max( slope, 0.0 ), 1.0 ) );
+            }
+        }
+
+        // The abstract elements no longer match the slopes, none can be reused
+        _hasRun = false;
+    }
+
+    _numLayersExecuted = numLayersExecuted;
+    _numLayersSkipped = numLayersSkipped;
+}
+
+void DeepPolyAnalysis::computeSlopeOptimizationChain()
+{
+    _slopeOptimizationChain.clear();
+
+    const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
+    if ( layers.empty() )
+        return;
+
+    unsigned index = layers.rbegin()->first;
+    while ( true )
+    {
+        const Layer *layer = layers[index];
+        _slopeOptimizationChain.append( index );
+
+        Layer::Type type = layer->getLayerType();
+        if ( type == Layer::INPUT )
+            return;
+
+        if ( ( type != Layer::WEIGHTED_SUM && type != Layer::RELU ) ||
+             layer->getSourceLayers().size() != 1 )
+        {
+            _slopeOptimizationChain.clear();
+            return;
+        }
+
+        index = layer->getSourceLayers().begin()->first;
+    }
+}
+
+bool DeepPolyAnalysis::computeSlopeGradients( double &objective,
+                                              Map<unsigned, Vector<double>> &gradients )
+{
+    const Map<unsigned, Layer *> &layers = _layerOwner->getLayerIndexToLayer();
+    const Vector<unsigned> &chain = _slopeOptimizationChain;
+
+    /*
+      Back-substitute the bounds of the output layer, starting from the
+      identity, down to the input layer. The coefficients in terms of
+      each ReLU layer are kept, as their signs determine which of the
+      linear bounds of each ReLU was substituted.
+    */
+    unsigned numTargets = _deepPolyElements[chain[0]]->getSize();
+    Vector<double> symbolicLb;
+    Vector<double> symbolicUb;
+    symbolicLb.assign( numTargets * numTargets, 0 );
+    symbolicUb.assign( numTargets * numTargets, 0 );
+    for ( unsigned j = 0; j < numTargets; ++j )
+    {
+        symbolicLb[j * numTargets + j] = 1;
+        symbolicUb[j * numTargets + j] = 1;
+    }
+    Vector<double> symbolicLowerBias;
+    Vector<double> symbolicUpperBias;
+    symbolicLowerBias.assign( numTargets, 0 );
+    symbolicUpperBias.assign( numTargets, 0 );
+
+    Map<unsigned, Vector<double>> reluSymbolicLb;
+    Map<unsigned, Vector<double>> reluSymbolicUb;
+    for ( unsigned k = 0; k + 1 < chain.size(); ++k )
+    {
+        DeepPolyElement *element = _deepPolyElements[chain[k]];
+        DeepPolyElement *predecessor = _deepPolyElements[chain[k + 1]];
+        if ( element->getLayerType() == Layer::RELU )
+        {
+            reluSymbolicLb[chain[k]] = symbolicLb;
+            reluSymbolicUb[chain[k]] = symbolicUb;
+        }
+
+        Vector<double> predecessorSymbolicLb;
+        Vector<double> predecessorSymbolicUb;
+        predecessorSymbolicLb.assign( predecessor->getSize() * numTargets, 0 );
+        predecessorSymbolicUb.assign( predecessor->getSize() * numTargets, 0 );
+        element->symbolicBoundInTermsOfPredecessor( symbolicLb.data(),
+                                                    symbolicUb.data(),
+                                                    symbolicLowerBias.data(),
+                                                    symbolicUpperBias.data(),
+                                                    predecessorSymbolicLb.data(),
+                                                    predecessorSymbolicUb.data(),
+                                                    numTargets,
+                                                    predecessor );
+        symbolicLb = predecessorSymbolicLb;
+        symbolicUb = predecessorSymbolicUb;
+    }
+
+    /*
+      Each output bound is attained at the input vertex picked by the
+      signs of its coefficients. Evaluating the network forward from that
+      vertex, with every ReLU replaced by the linear bound substituted for
+      it, gives the value of each neuron at the optimum. The derivative of
+      the bound with respect to the slope of a ReLU is then its
+      coefficient times the value of the ReLU's input.
+    */
+    DeepPolyElement *inputElement = _deepPolyElements[chain.last()];
+    Vector<double> lbValues;
+    Vector<double> ubValues;
+    lbValues.assign( inputElement->getSize() * numTargets, 0 );
+    ubValues.assign( inputElement->getSize() * numTargets, 0 );
+
+    objective = 0;
+    for ( unsigned i = 0; i < inputElement->getSize(); ++i )
+    {
+        double lb = inputElement->getLowerBound( i );
+        double ub = inputElement->getUpperBound( i );
+        for ( unsigned j = 0; j < numTargets; ++j )
+        {
+            unsigned entry = i * numTargets + j;
+            lbValues[entry] = symbolicLb[entry] >= 0 ? lb : ub;
+            ubValues[entry] = symbolicUb[entry] >= 0 ? ub : lb;
+            objective += symbolicLb[entry] * lbValues[entry] - symbolicUb[entry] * ubValues[entry];
+        }
+    }
+    for ( unsigned j = 0; j < numTargets; ++j )
+        objective += symbolicLowerBias[j] - symbolicUpperBias[j];
+
+    if ( !FloatUtils::isFinite( objective ) )
+        return false;
+
+    for ( unsigned k = chain.size() - 1; k-- > 0; )
+    {
+        unsigned sourceIndex = chain[k + 1];
+        const Layer *layer = layers[chain[k]];
+        unsigned size = layer->getSize();
+
+        Vector<double> newLbValues;
+        Vector<double> newUbValues;
+        newLbValues.assign( size * numTargets, 0 );
+        newUbValues.assign( size * numTargets, 0 );
+
+        if ( layer->getLayerType() == Layer::WEIGHTED_SUM )
+        {
+            const double *biases = layer->getBiases();
+            for ( unsigned i = 0; i < size; ++i )
+            {
+                for ( unsigned j = 0; j < numTargets; ++j )
+                {
+                    newLbValues[i * numTargets + j] = biases[i];
+                    newUbValues[i * numTargets + j] = biases[i];
+                }
+            }
+
+            if ( layer->hasSparseWeights( sourceIndex ) )
+            {
+                const SparseWeightMatrix *weights = layer->getSparseWeights( sourceIndex );
+                const unsigned *sources = weights->getSources();
+                const double *values = weights->getWeights();
+                for ( unsigned i = 0; i < size; ++i )
+                {
+                    unsigned end = weights->getTargetEnd( i );
+                    for ( unsigned entry = weights->getTargetBegin( i ); entry < end; ++entry )
+                    {
+                        for ( unsigned j = 0; j < numTargets; ++j )
+                        {
+                            newLbValues[i * numTargets + j] +=
+                                values[entry] * lbValues[sources[entry] * numTargets + j];
+                            newUbValues[i * numTargets + j] +=
+                                values[entry] * ubValues[sources[entry] * numTargets + j];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                const double *weights = layer->getWeights( sourceIndex );
+                unsigned sourceSize = layers[sourceIndex]->getSize();
+                for ( unsigned source = 0; source < sourceSize; ++source )
+                {
+                    for ( unsigned i = 0; i < size; ++i )
+                    {
+                        double weight = weights[source * size + i];
+                        if ( weight == 0 )
+                            continue;
+                        for ( unsigned j = 0; j < numTargets; ++j )
+                        {
+                            newLbValues[i * numTargets + j] +=
+                                weight * lbValues[source * numTargets + j];
+                            newUbValues[i * numTargets + j] +=
+                                weight * ubValues[source * numTargets + j];
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            DeepPolyReLUElement *element =
+                static_cast<DeepPolyReLUElement *>( _deepPolyElements[chain[k]] );
+            const double *coeffLb = element->getSymbolicLb();
+            const double *coeffUb = element->getSymbolicUb();
+            const double *lowerBias = element->getSymbolicLowerBias();
+            const double *upperBias = element->getSymbolicUpperBias();
+            const Vector<double> &weightsLb = reluSymbolicLb[chain[k]];
+            const Vector<double> &weightsUb = reluSymbolicUb[chain[k]];
+
+            Vector<double> &gradient = gradients[chain[k]];
+            gradient.assign( size, 0 );
+            for ( unsigned i = 0; i < size; ++i )
+            {
+                unsigned source = layer->getActivationSources( i ).begin()->_neuron;
+                for ( unsigned j = 0; j < numTargets; ++j )
+                {
+                    unsigned entry = i * numTargets + j;
+
+                    // The lower bound of the target uses the lower bound of
+                    // the ReLU if its coefficient is non-negative
+                    double value = lbValues[source * numTargets + j];
+                    if ( weightsLb[entry] >= 0 )
+                    {
+                        newLbValues[entry] = coeffLb[i] * value + lowerBias[i];
+                        gradient[i] += weightsLb[entry] * value;
+                    }
+                    else
+                        newLbValues[entry] = coeffUb[i] * value + upperBias[i];
+
+                    // The upper bound of the target uses it if its coefficient is negative
+                    value = ubValues[source * numTargets + j];
+                    if ( weightsUb[entry] >= 0 )
+                        newUbValues[entry] = coeffUb[i] * value + upperBias[i];
+                    else
+                    {
+                        newUbValues[entry] = coeffLb[i] * value + lowerBias[i];
+                        gradient[i] -= weightsUb[entry] * value;
+                    }
+                }
+            }
+        }
+
+        lbValues = newLbValues;
+        ubValues = newUbValues;
+    }
+
+    return true;
+}
+
+unsigned DeepPolyAnalysis::getNumLayersExecuted() const
+{
+    return _numLayersExecuted;
+}
+
+unsigned DeepPolyAnalysis::getNumLayersSkipped() const
+{
+    return _numLayersSkipped;
+}
+
+bool DeepPolyAnalysis::layerBoundsUnchanged( const Layer *layer, unsigned offset ) const
+{
+    /*
+      Elements only tighten the bounds they start from, so starting from
+      the bounds reached at the end of the previous run yields the same
+      element. The exception is softmax, whose relaxation depends on its
+      own starting bounds.
+    */
+    bool matchesStart = true;
+    bool matchesEnd = layer->getLayerType() != Layer::SOFTMAX;
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        double lb = layer->getLb( i );
+        double ub = layer->getUb( i );
+        if ( lb != _previousStartLbs[offset + i] || ub != _previousStartUbs[offset + i] )
+            matchesStart = false;
+        if ( lb != _previousEndLbs[offset + i] || ub != _previousEndUbs[offset + i] )
+            matchesEnd = false;
+        if ( !matchesStart && !matchesEnd )
+            return false;
+    }
+    return true;
+}
+
+void DeepPolyAnalysis::storeStartBounds( const Layer *layer, unsigned offset )
+{
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        _previousStartLbs[offset + i] = layer->getLb( i );
+        _previousStartUbs[offset + i] = layer->getUb( i );
+    }
+}
+
+void DeepPolyAnalysis::storeEndBounds( const Layer *layer, unsigned offset )
+{
+    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    {
+        _previousEndLbs[offset + i] = layer->getLb( i );
+        _previousEndUbs[offset + i] = layer->getUb( i );
+    }
 }
 
 void DeepPolyAnalysis::allocateMemory()
 {
     freeMemoryIfNeeded();
-    _work1SymbolicLb = new double[_maxLayerSize * _maxLayerSize];
-    _work1SymbolicUb = new double[_maxLayerSize * _maxLayerSize];
-    _work2SymbolicLb = new double[_maxLayerSize * _maxLayerSize];
-    _work2SymbolicUb = new double[_maxLayerSize * _maxLayerSize];
 
-    _workSymbolicLowerBias = new double[_maxLayerSize];
-    _workSymbolicUpperBias = new double[_maxLayerSize];
+    unsigned blockSize =
+        std::min( _maxLayerSize, GlobalConfiguration::DEEP_POLY_BACK_SUBSTITUTION_BLOCK_SIZE );
+    for ( unsigned i = 0; i < _threadPool.getNumThreads(); ++i )
+        _workMemory.append( new DeepPolyWorkMemory( _maxLayerSize, blockSize ) );
+}
+
+unsigned DeepPolyAnalysis::getNumberOfThreads()
+{
+    const Options *options = Options::get();
+    int numThreads = options->getInt( Options::NUM_BLAS_THREADS );
 
-    std::fill_n( _work1SymbolicLb, _maxLayerSize * _maxLayerSize, 0 );
-    std::fill_n( _work1SymbolicUb, _maxLayerSize * _maxLayerSize, 0 );
-    std::fill_n( _work2SymbolicLb, _maxLayerSize * _maxLayerSize, 0 );
-    std::fill_n( _work2SymbolicUb, _maxLayerSize * _maxLayerSize, 0 );
+    if ( options->getBool( Options::DNC_MODE ) ||
+         ( options->getBool( Options::PARALLEL_DEEPSOI ) &&
+           options->getInt( Options::NUM_WORKERS ) > 1 ) )
+        numThreads /= std::max( options->getInt( Options::NUM_WORKERS ), 1 );
 
-    std::fill_n( _workSymbolicLowerBias, _maxLayerSize, 0 );
-    std::fill_n( _workSymbolicUpperBias, _maxLayerSize, 0 );
+    return numThreads > 1 ? numThreads : 1;
 }
 
 DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
@@ -207,12 +581,7 @@ DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
     {
         deepPolyElement = new DeepPolyWeightedSumElement( layer );
         // Weighted sum layers need working memory for back substitution
-        deepPolyElement->setWorkingMemory( _work1SymbolicLb,
-                                           _work1SymbolicUb,
-                                           _work2SymbolicLb,
-                                           _work2SymbolicUb,
-                                           _workSymbolicLowerBias,
-                                           _workSymbolicUpperBias );
+        deepPolyElement->setWorkingMemory( &_threadPool, &_workMemory );
     }
     else if ( type == Layer::RELU )
         deepPolyElement = new DeepPolyReLUElement( layer );
@@ -229,7 +598,7 @@ DeepPolyElement *DeepPolyAnalysis::createDeepPolyElement( Layer *layer )
     else if ( type == Layer::SIGMOID )
         deepPolyElement = new DeepPolySigmoidElement( layer );
     else if ( type == Layer::SOFTMAX )
-        deepPolyElement = new DeepPolySoftmaxElement( layer, _maxLayerSize );
+        deepPolyElement = new DeepPolySoftmaxElement( layer );
     else if ( type == Layer::BILINEAR )
         deepPolyElement = new DeepPolyBilinearElement( layer );
     else
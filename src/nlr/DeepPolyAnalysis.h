@@ -17,9 +17,12 @@
 #define __DeepPolyAnalysis_h__
 
 #include "DeepPolyElement.h"
+#include "DeepPolyWorkMemory.h"
 #include "Layer.h"
 #include "LayerOwner.h"
 #include "Map.h"
+#include "ThreadPool.h"
+#include "Vector.h"
 
 #include <climits>
 
@@ -33,6 +36,31 @@ public:
 
     void run();
 
+    /*
+      Run DeepPoly several times, optimizing the lower-bound slopes of
+      the unstable ReLUs (see DeepPolyReLUElement) in between: each step
+      moves the slopes along the gradient of the sum of the widths of the
+      output bounds, and projects them back onto [0, 1]. Every run is
+      sound, and starts from the bounds found by the previous ones. If
+      the network is not supported (see _slopeOptimizationChain), this is
+      a single DeepPoly run.
+    */
+    void runWithOptimizedSlopes();
+
+    /*
+      The number of layers whose abstract elements were executed, and
+      skipped, during the last run.
+    */
+    unsigned getNumLayersExecuted() const;
+    unsigned getNumLayersSkipped() const;
+
+    /*
+      The number of threads for back substitution (and other parallel
+      work of the network-level reasoner): the BLAS thread budget, shared
+      among the workers when several of them run concurrently.
+    */
+    static unsigned getNumberOfThreads();
+
 private:
     LayerOwner *_layerOwner;
 
@@ -41,23 +69,65 @@ private:
     */
     Map<unsigned, DeepPolyElement *> _deepPolyElements;
 
+    unsigned _maxLayerSize;
+
     /*
-      Working memory for the abstract elements to execute
+      The threads among which the back substitution of each layer is
+      split, and their working memory
     */
-    double *_work1SymbolicLb;
-    double *_work1SymbolicUb;
-    double *_work2SymbolicLb;
-    double *_work2SymbolicUb;
-    double *_workSymbolicLowerBias;
-    double *_workSymbolicUpperBias;
+    ThreadPool _threadPool;
+    Vector<DeepPolyWorkMemory *> _workMemory;
 
-    unsigned _maxLayerSize;
+    /*
+      The concrete bounds of all neurons, ordered by layer index, at the
+      start and at the end of the previous run. A layer whose bounds
+      match one of these snapshots, and all of whose preceding layers
+      match as well, would produce exactly the same abstract element as
+      before: its execution is skipped, and the previous results are
+      reused.
+    */
+    bool _hasRun;
+    Vector<double> _previousStartLbs;
+    Vector<double> _previousStartUbs;
+    Vector<double> _previousEndLbs;
+    Vector<double> _previousEndUbs;
+
+    unsigned _numLayersExecuted;
+    unsigned _numLayersSkipped;
+
+    /*
+      The layers from the output layer back to the input layer, if they
+      form a chain of weighted-sum and ReLU layers with a single source
+      layer each, which is what slope optimization supports. Empty
+      otherwise.
+    */
+    Vector<unsigned> _slopeOptimizationChain;
+
+    void computeSlopeOptimizationChain();
+
+    /*
+      Back-substitute the bounds of the output layer to the input layer,
+      using the current abstract elements, and compute the sum of its
+      lower bounds minus the sum of its upper bounds, and the gradient of
+      that objective with respect to the slopes in use of each ReLU layer.
+      Returns false if the objective is not finite.
+    */
+    bool computeSlopeGradients( double &objective, Map<unsigned, Vector<double>> &gradients );
 
     void allocateMemory();
     void freeMemoryIfNeeded();
 
     DeepPolyElement *createDeepPolyElement( Layer *layer );
 
+    /*
+      Compare the current bounds of a layer, whose first neuron is stored
+      at the given offset, with the snapshots of the previous run, and
+      record them as the bounds at the start or end of this run.
+    */
+    bool layerBoundsUnchanged( const Layer *layer, unsigned offset ) const;
+    void storeStartBounds( const Layer *layer, unsigned offset );
+    void storeEndBounds( const Layer *layer, unsigned offset );
+
     void log( const String &message );
 };
 
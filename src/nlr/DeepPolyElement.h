@@ -16,10 +16,13 @@
 #ifndef __DeepPolyElement_h__
 #define __DeepPolyElement_h__
 
+#include "DeepPolyWorkMemory.h"
 #include "Layer.h"
 #include "MStringf.h"
 #include "Map.h"
 #include "NLRError.h"
+#include "ThreadPool.h"
+#include "Vector.h"
 
 #include <climits>
 
@@ -69,12 +72,12 @@ public:
     double getLowerBound( unsigned index ) const;
     double getUpperBound( unsigned index ) const;
 
-    void setWorkingMemory( double *work1SymbolicLb,
-                           double *work1SymbolicUb,
-                           double *work2SymbolicLb,
-                           double *work2SymbolicUb,
-                           double *workSymbolicLowerBias,
-                           double *workSymbolicUpperBias );
+    /*
+      Provide the thread pool, and the working memory of each of its
+      threads, for back substitution.
+    */
+    void setWorkingMemory( ThreadPool *threadPool,
+                           const Vector<DeepPolyWorkMemory *> *workMemory );
 
     double getLowerBoundFromLayer( unsigned index ) const;
     double getUpperBoundFromLayer( unsigned index ) const;
@@ -96,12 +99,8 @@ protected:
     double *_lb;
     double *_ub;
 
-    double *_work1SymbolicLb;
-    double *_work1SymbolicUb;
-    double *_work2SymbolicLb;
-    double *_work2SymbolicUb;
-    double *_workSymbolicLowerBias;
-    double *_workSymbolicUpperBias;
+    ThreadPool *_threadPool;
+    const Vector<DeepPolyWorkMemory *> *_workMemory;
 
     void allocateMemory();
     void freeMemoryIfNeeded();
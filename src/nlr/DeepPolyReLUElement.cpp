@@ -20,6 +20,7 @@
 namespace NLR {
 
 DeepPolyReLUElement::DeepPolyReLUElement( Layer *layer )
+    : _optimizableSlopes( false )
 {
     _layer = layer;
     _size = layer->getSize();
@@ -36,6 +37,7 @@ void DeepPolyReLUElement::execute( const Map<unsigned, DeepPolyElement *> &deepP
     log( "Executing..." );
     ASSERT( hasPredecessor() );
     allocateMemory();
+    _neuronsUsingSlopes.clear();
 
     // Update the symbolic and concrete upper- and lower- bounds
     // of each neuron
@@ -86,8 +88,21 @@ void DeepPolyReLUElement::execute( const Map<unsigned, DeepPolyElement *> &deepP
             // 0 <= lambda <= 1, would be a sound lower bound. We
             // use the heuristic described in section 4.1 of
             // https://files.sri.inf.ethz.ch/website/papers/DeepPoly.pdf
-            // to set the value of lambda (either 0 or 1 is considered).
-            if ( sourceUb > -sourceLb )
+            // to set the value of lambda (either 0 or 1 is considered),
+            // unless lambda is being optimized.
+            if ( _optimizableSlopes )
+            {
+                if ( _slopes[i] < 0 )
+                    _slopes[i] = sourceUb > -sourceLb ? 1 : 0;
+                _neuronsUsingSlopes.insert( i );
+
+                // Symbolic lower bound: x_f >= lambda * x_b
+                // Concrete lower bound: x_f >= lambda * sourceLb
+                _symbolicLb[i] = _slopes[i];
+                _symbolicLowerBias[i] = 0;
+                _lb[i] = _slopes[i] * sourceLb;
+            }
+            else if ( sourceUb > -sourceLb )
             {
                 // lambda = 1
                 // Symbolic lower bound: x_f >= x_b
@@ -195,6 +210,31 @@ void DeepPolyReLUElement::symbolicBoundInTermsOfPredecessor( const double *symbo
     }
 }
 
+void DeepPolyReLUElement::enableOptimizableSlopes()
+{
+    if ( _optimizableSlopes )
+        return;
+
+    _optimizableSlopes = true;
+    _slopes.assign( _size, -1 );
+}
+
+bool DeepPolyReLUElement::slopeInUse( unsigned index ) const
+{
+    return _neuronsUsingSlopes.exists( index );
+}
+
+double DeepPolyReLUElement::getSlope( unsigned index ) const
+{
+    return _slopes[index];
+}
+
+void DeepPolyReLUElement::setSlope( unsigned index, double slope )
+{
+    ASSERT( _optimizableSlopes );
+    _slopes[index] = slope;
+}
+
 void DeepPolyReLUElement::allocateMemory()
 {
     freeMemoryIfNeeded();
@@ -20,6 +20,7 @@
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
+#include "Set.h"
 
 #include <climits>
 
@@ -42,7 +43,24 @@ public:
                                             unsigned targetLayerSize,
                                             DeepPolyElement *predecessor );
 
+    /*
+      Optimizable lower-bound slopes, as in alpha-CROWN
+      (https://arxiv.org/abs/2011.13824). Once enabled, the symbolic lower
+      bound of an unstable ReLU is x_f >= alpha * x_b, where the slope
+      alpha in [0, 1] is kept per neuron across executions. A slope is
+      initialized by the DeepPoly heuristic the first time its neuron is
+      unstable, and may then be changed by the caller between executions.
+    */
+    void enableOptimizableSlopes();
+    bool slopeInUse( unsigned index ) const;
+    double getSlope( unsigned index ) const;
+    void setSlope( unsigned index, double slope );
+
 private:
+    bool _optimizableSlopes;
+    Vector<double> _slopes;
+    Set<unsigned> _neuronsUsingSlopes;
+
     void allocateMemory();
     void freeMemoryIfNeeded();
     void log( const String &message );
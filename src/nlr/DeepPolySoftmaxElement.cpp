@@ -24,10 +24,8 @@
 
 namespace NLR {
 
-DeepPolySoftmaxElement::DeepPolySoftmaxElement( Layer *layer, unsigned maxLayerSize )
+DeepPolySoftmaxElement::DeepPolySoftmaxElement( Layer *layer )
     : _boundType( Options::get()->getSoftmaxBoundType() )
-    , _maxLayerSize( maxLayerSize )
-    , _work( NULL )
 {
     log( Stringf( "Softmax bound type: %s",
                   Options::get()->getString( Options::SOFTMAX_BOUND_TYPE ).ascii() ) );
@@ -46,7 +44,7 @@ void DeepPolySoftmaxElement::execute(
 {
     log( "Executing..." );
     ASSERT( hasPredecessor() );
-    allocateMemory( _maxLayerSize );
+    allocateMemory();
     getConcreteBounds();
 
     // This function rely on the assumptions described in the
@@ -204,84 +202,88 @@ void DeepPolySoftmaxElement::symbolicBoundInTermsOfPredecessor(
     unsigned predecessorSize = predecessor->getSize();
     ASSERT( predecessorSize == _size );
 
+    // Local working memory, as this may be invoked by several threads at once
+    Vector<double> workVector( _size * targetLayerSize, 0 );
+    double *work = workVector.data();
+
     for ( unsigned i = 0; i < _size * targetLayerSize; ++i )
     {
         if ( symbolicLb[i] > 0 )
-            _work[i] = symbolicLb[i];
+            work[i] = symbolicLb[i];
         else
-            _work[i] = 0;
+            work[i] = 0;
     }
-    // _work is now positive weights in symbolicLb
+    // work is now positive weights in symbolicLb
     matrixMultiplication( _symbolicLb,
-                          _work,
+                          work,
                           symbolicLbInTermsOfPredecessor,
                           predecessorSize,
                           _size,
                           targetLayerSize );
     if ( symbolicLowerBias )
         matrixMultiplication(
-            _symbolicLowerBias, _work, symbolicLowerBias, 1, _size, targetLayerSize );
+            _symbolicLowerBias, work, symbolicLowerBias, 1, _size, targetLayerSize );
 
     for ( unsigned i = 0; i < _size * targetLayerSize; ++i )
     {
         if ( symbolicLb[i] < 0 )
-            _work[i] = symbolicLb[i];
+            work[i] = symbolicLb[i];
         else
-            _work[i] = 0;
+            work[i] = 0;
     }
-    // _work is now negative weights in symbolicLb
+    // work is now negative weights in symbolicLb
     matrixMultiplication( _symbolicUb,
-                          _work,
+                          work,
                           symbolicLbInTermsOfPredecessor,
                           predecessorSize,
                           _size,
                           targetLayerSize );
     if ( symbolicLowerBias )
         matrixMultiplication(
-            _symbolicUpperBias, _work, symbolicLowerBias, 1, _size, targetLayerSize );
+            _symbolicUpperBias, work, symbolicLowerBias, 1, _size, targetLayerSize );
 
     for ( unsigned i = 0; i < _size * targetLayerSize; ++i )
     {
         if ( symbolicUb[i] > 0 )
-            _work[i] = symbolicUb[i];
+            work[i] = symbolicUb[i];
         else
-            _work[i] = 0;
+            work[i] = 0;
     }
-    // _work is now positive weights in symbolicUb
+    // work is now positive weights in symbolicUb
     matrixMultiplication( _symbolicUb,
-                          _work,
+                          work,
                           symbolicUbInTermsOfPredecessor,
                           predecessorSize,
                           _size,
                           targetLayerSize );
     if ( symbolicUpperBias )
         matrixMultiplication(
-            _symbolicUpperBias, _work, symbolicUpperBias, 1, _size, targetLayerSize );
+            _symbolicUpperBias, work, symbolicUpperBias, 1, _size, targetLayerSize );
 
     for ( unsigned i = 0; i < _size * targetLayerSize; ++i )
     {
         if ( symbolicUb[i] < 0 )
-            _work[i] = symbolicUb[i];
+            work[i] = symbolicUb[i];
         else
-            _work[i] = 0;
+            work[i] = 0;
     }
-    // _work is now positive weights in symbolicUb
+    // work is now positive weights in symbolicUb
     matrixMultiplication( _symbolicLb,
-                          _work,
+                          work,
                           symbolicUbInTermsOfPredecessor,
                           predecessorSize,
                           _size,
                           targetLayerSize );
     if ( symbolicUpperBias )
         matrixMultiplication(
-            _symbolicLowerBias, _work, symbolicUpperBias, 1, _size, targetLayerSize );
+            _symbolicLowerBias, work, symbolicUpperBias, 1, _size, targetLayerSize );
 
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done",
                   predecessor->getLayerIndex() ) );
 }
 
 
-void DeepPolySoftmaxElement::allocateMemory( unsigned maxLayerSize )
+void DeepPolySoftmaxElement::allocateMemory()
 {
     freeMemoryIfNeeded();
 
@@ -299,9 +301,6 @@ void DeepPolySoftmaxElement::allocateMemory( unsigned maxLayerSize )
 
     std::fill_n( _symbolicLowerBias, _size, 0 );
     std::fill_n( _symbolicUpperBias, _size, 0 );
-
-    _work = new double[_size * maxLayerSize];
-    std::fill_n( _work, _size * maxLayerSize, 0 );
 }
 
 void DeepPolySoftmaxElement::freeMemoryIfNeeded()
@@ -327,11 +326,6 @@ void DeepPolySoftmaxElement::freeMemoryIfNeeded()
         delete[] _symbolicUpperBias;
         _symbolicUpperBias = NULL;
     }
-    if ( _work )
-    {
-        delete[] _work;
-        _work = NULL;
-    }
 }
 
 double DeepPolySoftmaxElement::LSELowerBound( const Vector<double> &inputs,
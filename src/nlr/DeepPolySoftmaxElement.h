@@ -29,7 +29,7 @@ namespace NLR {
 class DeepPolySoftmaxElement : public DeepPolyElement
 {
 public:
-    DeepPolySoftmaxElement( Layer *layer, unsigned maxLayerSize );
+    DeepPolySoftmaxElement( Layer *layer );
     ~DeepPolySoftmaxElement();
 
     void execute( const Map<unsigned, DeepPolyElement *> &deepPolyElements );
@@ -99,10 +99,8 @@ public:
 
 private:
     SoftmaxBoundType _boundType;
-    unsigned _maxLayerSize;
-    double *_work;
 
-    void allocateMemory( unsigned maxLayerSize );
+    void allocateMemory();
     void freeMemoryIfNeeded();
     void log( const String &message );
 };
@@ -22,8 +22,6 @@
 namespace NLR {
 
 DeepPolyWeightedSumElement::DeepPolyWeightedSumElement( Layer *layer )
-    : _workLb( NULL )
-    , _workUb( NULL )
 {
     _layer = layer;
     _size = layer->getSize();
@@ -32,7 +30,6 @@ DeepPolyWeightedSumElement::DeepPolyWeightedSumElement( Layer *layer )
 
 DeepPolyWeightedSumElement::~DeepPolyWeightedSumElement()
 {
-    freeMemoryIfNeeded();
 }
 
 void DeepPolyWeightedSumElement::execute(
@@ -40,18 +37,37 @@ void DeepPolyWeightedSumElement::execute(
 {
     log( "Executing..." );
     ASSERT( hasPredecessor() );
+    ASSERT( _threadPool && _workMemory );
     allocateMemory();
     getConcreteBounds();
-    // Compute bounds with back-substitution
-    computeBoundWithBackSubstitution( deepPolyElementsBefore );
+
+    /*
+      Compute bounds with back-substitution. The bounds of different
+      neurons are independent of each other, so the layer is split into
+      blocks of neurons, which are processed in parallel. The partition
+      does not depend on the number of threads, and every block is
+      processed the same way regardless of the thread running it, so the
+      results are deterministic.
+    */
+    unsigned blockSize = ( *_workMemory )[0]->getBlockSize();
+    unsigned numBlocks = ( _size + blockSize - 1 ) / blockSize;
+    _threadPool->run( numBlocks, [&]( unsigned block, unsigned thread ) {
+        unsigned begin = block * blockSize;
+        unsigned end = std::min( begin + blockSize, _size );
+        computeBoundWithBackSubstitution(
+            deepPolyElementsBefore, begin, end, *( *_workMemory )[thread] );
+    } );
     log( "Executing - done" );
 }
 
 void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
-    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
+    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+    unsigned begin,
+    unsigned end,
+    DeepPolyWorkMemory &memory )
 {
-    log( "Computing bounds with back substitution..." );
-
+    log( Stringf( "Computing bounds of neurons %u-%u with back substitution...", begin, end ) );
+    unsigned blockSize = end - begin;
     // Start with the symbolic upper-/lower- bounds of this layer with
     // respect to its immediate predecessor.
     Map<unsigned, unsigned> predecessorIndices = getPredecessorIndices();
@@ -72,12 +88,11 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
         if ( counter < numPredecessors - 1 )
         {
             log( Stringf( "Adding residual from layer %u...", predecessorIndex ) );
-            allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
-            const double *weights = _layer->getWeights( predecessorIndex );
-            memcpy(
-                _residualLb[predecessorIndex], weights, _size * pair.second * sizeof( double ) );
-            memcpy(
-                _residualUb[predecessorIndex], weights, _size * pair.second * sizeof( double ) );
+            memory.addResidualLayer( predecessorIndex, pair.second );
+            copyWeightsOfBlock(
+                predecessorIndex, pair.second, begin, end, memory._residualLb[predecessorIndex] );
+            copyWeightsOfBlock(
+                predecessorIndex, pair.second, begin, end, memory._residualUb[predecessorIndex] );
             ++counter;
             log( Stringf( "Adding residual from layer %u - done", pair.first ) );
         }
@@ -87,24 +102,26 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
     DeepPolyElement *precedingElement = deepPolyElementsBefore[predecessorIndex];
     unsigned sourceLayerSize = precedingElement->getSize();
 
-    const double *weights = _layer->getWeights( predecessorIndex );
-    memcpy( _work1SymbolicLb, weights, _size * sourceLayerSize * sizeof( double ) );
-    memcpy( _work1SymbolicUb, weights, _size * sourceLayerSize * sizeof( double ) );
+    copyWeightsOfBlock( predecessorIndex, sourceLayerSize, begin, end, memory._work1SymbolicLb );
+    copyWeightsOfBlock( predecessorIndex, sourceLayerSize, begin, end, memory._work1SymbolicUb );
 
     double *bias = _layer->getBiases();
-    memcpy( _workSymbolicLowerBias, bias, _size * sizeof( double ) );
-    memcpy( _workSymbolicUpperBias, bias, _size * sizeof( double ) );
+    memcpy( memory._workSymbolicLowerBias, bias + begin, blockSize * sizeof( double ) );
+    memcpy( memory._workSymbolicUpperBias, bias + begin, blockSize * sizeof( double ) );
 
     DeepPolyElement *currentElement = precedingElement;
-    concretizeSymbolicBound( _work1SymbolicLb,
-                             _work1SymbolicUb,
-                             _workSymbolicLowerBias,
-                             _workSymbolicUpperBias,
+    concretizeSymbolicBound( memory._work1SymbolicLb,
+                             memory._work1SymbolicUb,
+                             memory._workSymbolicLowerBias,
+                             memory._workSymbolicUpperBias,
                              currentElement,
-                             deepPolyElementsBefore );
+                             deepPolyElementsBefore,
+                             begin,
+                             end,
+                             memory );
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done", predecessorIndex ) );
 
-    while ( currentElement->hasPredecessor() || !_residualLayerIndices.empty() )
+    while ( currentElement->hasPredecessor() || !memory._residualLayerIndices.empty() )
     {
         // We have the symbolic bounds in terms of the current abstract
         // element--currentElement, stored in _work1SymbolicLb,
@@ -127,89 +144,91 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
                 {
                     unsigned predecessorIndex = pair.first;
                     log( Stringf( "Adding residual from layer %u...", predecessorIndex ) );
-                    allocateMemoryForResidualsIfNeeded( predecessorIndex, pair.second );
+                    memory.addResidualLayer( predecessorIndex, pair.second );
                     // Do we need to add bias here?
                     currentElement->symbolicBoundInTermsOfPredecessor(
-                        _work1SymbolicLb,
-                        _work1SymbolicUb,
+                        memory._work1SymbolicLb,
+                        memory._work1SymbolicUb,
                         NULL,
                         NULL,
-                        _residualLb[predecessorIndex],
-                        _residualUb[predecessorIndex],
-                        _size,
+                        memory._residualLb[predecessorIndex],
+                        memory._residualUb[predecessorIndex],
+                        blockSize,
                         precedingElement );
                     ++counter;
                     log( Stringf( "Adding residual from layer %u - done", pair.first ) );
                 }
             }
 
-            std::fill_n( _work2SymbolicLb, _size * precedingElement->getSize(), 0 );
-            std::fill_n( _work2SymbolicUb, _size * precedingElement->getSize(), 0 );
-            currentElement->symbolicBoundInTermsOfPredecessor( _work1SymbolicLb,
-                                                               _work1SymbolicUb,
-                                                               _workSymbolicLowerBias,
-                                                               _workSymbolicUpperBias,
-                                                               _work2SymbolicLb,
-                                                               _work2SymbolicUb,
-                                                               _size,
+            std::fill_n( memory._work2SymbolicLb, blockSize * precedingElement->getSize(), 0 );
+            std::fill_n( memory._work2SymbolicUb, blockSize * precedingElement->getSize(), 0 );
+            currentElement->symbolicBoundInTermsOfPredecessor( memory._work1SymbolicLb,
+                                                               memory._work1SymbolicUb,
+                                                               memory._workSymbolicLowerBias,
+                                                               memory._workSymbolicUpperBias,
+                                                               memory._work2SymbolicLb,
+                                                               memory._work2SymbolicUb,
+                                                               blockSize,
                                                                precedingElement );
 
             // The symbolic lower-bound is
-            // _work2SymbolicLb * precedingElement + residualLb1 * residualElement1 +
+            // memory._work2SymbolicLb * precedingElement + residualLb1 * residualElement1 +
             // residualLb2 * residualElement2 + ...
             // If the precedingElement is a residual source layer, we can merge
             // in the residualWeights, and remove it from the residual source layers.
-            if ( _residualLayerIndices.exists( predecessorIndex ) )
+            if ( memory._residualLayerIndices.exists( predecessorIndex ) )
             {
                 log( Stringf( "merge residual from layer %u...", predecessorIndex ) );
                 // Add weights of this residual layer
-                for ( unsigned i = 0; i < _size * precedingElement->getSize(); ++i )
+                unsigned matrixSize = blockSize * precedingElement->getSize();
+                for ( unsigned i = 0; i < matrixSize; ++i )
                 {
-                    _work2SymbolicLb[i] += _residualLb[predecessorIndex][i];
-                    _work2SymbolicUb[i] += _residualUb[predecessorIndex][i];
+                    memory._work2SymbolicLb[i] += memory._residualLb[predecessorIndex][i];
+                    memory._work2SymbolicUb[i] += memory._residualUb[predecessorIndex][i];
                 }
-                _residualLayerIndices.erase( predecessorIndex );
-                std::fill_n(
-                    _residualLb[predecessorIndex], _size * precedingElement->getSize(), 0 );
-                std::fill_n(
-                    _residualUb[predecessorIndex], _size * precedingElement->getSize(), 0 );
+                memory._residualLayerIndices.erase( predecessorIndex );
+                std::fill_n( memory._residualLb[predecessorIndex], matrixSize, 0 );
+                std::fill_n( memory._residualUb[predecessorIndex], matrixSize, 0 );
                 log( Stringf( "merge residual from layer %u - done", predecessorIndex ) );
             }
 
-            double *temp = _work1SymbolicLb;
-            _work1SymbolicLb = _work2SymbolicLb;
-            _work2SymbolicLb = temp;
+            double *temp = memory._work1SymbolicLb;
+            memory._work1SymbolicLb = memory._work2SymbolicLb;
+            memory._work2SymbolicLb = temp;
 
-            temp = _work1SymbolicUb;
-            _work1SymbolicUb = _work2SymbolicUb;
-            _work2SymbolicUb = temp;
+            temp = memory._work1SymbolicUb;
+            memory._work1SymbolicUb = memory._work2SymbolicUb;
+            memory._work2SymbolicUb = temp;
 
             currentElement = precedingElement;
-            concretizeSymbolicBound( _work1SymbolicLb,
-                                     _work1SymbolicUb,
-                                     _workSymbolicLowerBias,
-                                     _workSymbolicUpperBias,
+            concretizeSymbolicBound( memory._work1SymbolicLb,
+                                     memory._work1SymbolicUb,
+                                     memory._workSymbolicLowerBias,
+                                     memory._workSymbolicUpperBias,
                                      currentElement,
-                                     deepPolyElementsBefore );
+                                     deepPolyElementsBefore,
+                                     begin,
+                                     end,
+                                     memory );
         }
-        else if ( !_residualLayerIndices.empty() )
+        else if ( !memory._residualLayerIndices.empty() )
         {
             // The current element has no predecessor (i.e., it has been pushed to the input layer
             // but there are still elements in the residual layers. In this case, we should swap
             // the first residual element with the current element.
 
             // Add the current element in the residual element
-            unsigned newCurrentIndex = *_residualLayerIndices.begin();
+            unsigned newCurrentIndex = *memory._residualLayerIndices.begin();
             unsigned residualIndex = currentElement->getLayerIndex();
             log( Stringf( "Adding layer %u to the residual layer\n", residualIndex ).ascii() );
             ASSERT( residualIndex == 0 );
 
-            allocateMemoryForResidualsIfNeeded( residualIndex, currentElement->getSize() );
-            unsigned matrixSize = currentElement->getSize() * _size;
+            memory.addResidualLayer( residualIndex, currentElement->getSize() );
+            unsigned matrixSize = currentElement->getSize() * blockSize;
             for ( unsigned i = 0; i < matrixSize; ++i )
             {
-                _residualLb[residualIndex][i] += _work1SymbolicLb[i];
-                _residualUb[residualIndex][i] += _work1SymbolicUb[i];
+                memory._residualLb[residualIndex][i] += memory._work1SymbolicLb[i];
+                memory._residualUb[residualIndex][i] += memory._work1SymbolicUb[i];
             }
 
             // Make the first residual element the current element and get ready for the next
@@ -218,19 +237,19 @@ void DeepPolyWeightedSumElement::computeBoundWithBackSubstitution(
 
             currentElement = deepPolyElementsBefore[newCurrentIndex];
 
-            unsigned currentMatrixSize = currentElement->getSize() * _size;
-            memcpy( _work1SymbolicLb,
-                    _residualLb[newCurrentIndex],
+            unsigned currentMatrixSize = currentElement->getSize() * blockSize;
+            memcpy( memory._work1SymbolicLb,
+                    memory._residualLb[newCurrentIndex],
                     currentMatrixSize * sizeof( double ) );
-            memcpy( _work1SymbolicUb,
-                    _residualUb[newCurrentIndex],
+            memcpy( memory._work1SymbolicUb,
+                    memory._residualUb[newCurrentIndex],
                     currentMatrixSize * sizeof( double ) );
-            _residualLayerIndices.erase( newCurrentIndex );
-            std::fill_n( _residualLb[newCurrentIndex], currentMatrixSize, 0 );
-            std::fill_n( _residualUb[newCurrentIndex], currentMatrixSize, 0 );
+            memory._residualLayerIndices.erase( newCurrentIndex );
+            std::fill_n( memory._residualLb[newCurrentIndex], currentMatrixSize, 0 );
+            std::fill_n( memory._residualUb[newCurrentIndex], currentMatrixSize, 0 );
         }
     }
-    ASSERT( _residualLayerIndices.empty() );
+    ASSERT( memory._residualLayerIndices.empty() );
     log( "Computing bounds with back substitution - done" );
 }
 
@@ -240,32 +259,45 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBound(
     double const *symbolicLowerBias,
     const double *symbolicUpperBias,
     DeepPolyElement *sourceElement,
-    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore )
+    const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+    unsigned begin,
+    unsigned end,
+    DeepPolyWorkMemory &memory )
 {
     log( "Concretizing bound..." );
-    std::fill_n( _workLb, _size, 0 );
-    std::fill_n( _workUb, _size, 0 );
-
-    concretizeSymbolicBoundForSourceLayer(
-        symbolicLb, symbolicUb, symbolicLowerBias, symbolicUpperBias, sourceElement );
-
-    for ( const auto &residualLayerIndex : _residualLayerIndices )
+    unsigned blockSize = end - begin;
+    std::fill_n( memory._workLb, blockSize, 0 );
+    std::fill_n( memory._workUb, blockSize, 0 );
+
+    concretizeSymbolicBoundForSourceLayer( symbolicLb,
+                                           symbolicUb,
+                                           symbolicLowerBias,
+                                           symbolicUpperBias,
+                                           sourceElement,
+                                           blockSize,
+                                           memory );
+
+    for ( const auto &residualLayerIndex : memory._residualLayerIndices )
     {
         DeepPolyElement *residualElement = deepPolyElementsBefore[residualLayerIndex];
-        concretizeSymbolicBoundForSourceLayer( _residualLb[residualLayerIndex],
-                                               _residualUb[residualLayerIndex],
+        concretizeSymbolicBoundForSourceLayer( memory._residualLb[residualLayerIndex],
+                                               memory._residualUb[residualLayerIndex],
                                                NULL,
                                                NULL,
-                                               residualElement );
+                                               residualElement,
+                                               blockSize,
+                                               memory );
     }
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = 0; i < blockSize; ++i )
     {
-        if ( _lb[i] < _workLb[i] )
-            _lb[i] = _workLb[i];
-        if ( _ub[i] > _workUb[i] )
-            _ub[i] = _workUb[i];
-        log( Stringf( "Neuron%u working LB: %f, UB: %f", i, _workLb[i], _workUb[i] ) );
-        log( Stringf( "Neuron%u LB: %f, UB: %f", i, _lb[i], _ub[i] ) );
+        unsigned neuron = begin + i;
+        if ( _lb[neuron] < memory._workLb[i] )
+            _lb[neuron] = memory._workLb[i];
+        if ( _ub[neuron] > memory._workUb[i] )
+            _ub[neuron] = memory._workUb[i];
+        log( Stringf(
+            "Neuron%u working LB: %f, UB: %f", neuron, memory._workLb[i], memory._workUb[i] ) );
+        log( Stringf( "Neuron%u LB: %f, UB: %f", neuron, _lb[neuron], _ub[neuron] ) );
     }
 
     log( "Concretizing bound - done" );
@@ -276,17 +308,19 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
     const double *symbolicUb,
     const double *symbolicLowerBias,
     const double *symbolicUpperBias,
-    DeepPolyElement *sourceElement )
+    DeepPolyElement *sourceElement,
+    unsigned blockSize,
+    DeepPolyWorkMemory &memory )
 {
     /*
     DEBUG({
             log( Stringf( "Source layer: %u", sourceElement->getLayerIndex() ) );
             String s = Stringf( "Symbolic lowerbounds w.r.t. layer %u: \n ",
-    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <_size; ++i )
+    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <blockSize; ++i )
             {
                 for ( unsigned j = 0; j < sourceElement->getSize(); ++j )
                 {
-                    s += Stringf( "%f ", symbolicLb[j * _size + i] );
+                    s += Stringf( "%f ", symbolicLb[j * blockSize + i] );
                 }
                 s += "\n";
             }
@@ -294,18 +328,18 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
             if ( symbolicLowerBias )
             {
                 s += Stringf( "Symbolic lower bias w.r.t. layer %u: \n ",
-    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <_size; ++i )
+    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <blockSize; ++i )
                 {
                     s += Stringf( "%f ", symbolicLowerBias[i] );
                 }
                 s += "\n";
             }
             s += Stringf( "Symbolic upperbounds w.r.t. layer %u: \n ",
-    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <_size; ++i )
+    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <blockSize; ++i )
             {
                 for ( unsigned j = 0; j < sourceElement->getSize(); ++j )
                 {
-                    s += Stringf( "%f ", symbolicUb[j * _size + i] );
+                    s += Stringf( "%f ", symbolicUb[j * blockSize + i] );
                 }
                 s += "\n";
             }
@@ -313,7 +347,7 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
             if ( symbolicUpperBias )
             {
                 s += Stringf( "Symbolic upper bias w.r.t. layer %u: \n ",
-    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <_size; ++i )
+    sourceElement->getLayerIndex() ); for ( unsigned i = 0; i <blockSize; ++i )
                 {
                     s += Stringf( "%f ", symbolicUpperBias[i] );
                 }
@@ -337,42 +371,72 @@ void DeepPolyWeightedSumElement::concretizeSymbolicBoundForSourceLayer(
                       sourceLb,
                       sourceUb ) );
 
-        for ( unsigned j = 0; j < _size; ++j )
+        for ( unsigned j = 0; j < blockSize; ++j )
         {
             // Compute lower bound
-            double weight = symbolicLb[i * _size + j];
+            double weight = symbolicLb[i * blockSize + j];
             if ( weight >= 0 )
             {
-                _workLb[j] += ( weight * sourceLb );
+                memory._workLb[j] += ( weight * sourceLb );
             }
             else
             {
-                _workLb[j] += ( weight * sourceUb );
+                memory._workLb[j] += ( weight * sourceUb );
             }
 
             // Compute upper bound
-            weight = symbolicUb[i * _size + j];
+            weight = symbolicUb[i * blockSize + j];
             if ( weight >= 0 )
             {
-                _workUb[j] += ( weight * sourceUb );
+                memory._workUb[j] += ( weight * sourceUb );
             }
             else
             {
-                _workUb[j] += ( weight * sourceLb );
+                memory._workUb[j] += ( weight * sourceLb );
             }
         }
     }
 
-    for ( unsigned i = 0; i < _size; ++i )
+    for ( unsigned i = 0; i < blockSize; ++i )
     {
         if ( symbolicLowerBias )
-            _workLb[i] += symbolicLowerBias[i];
+            memory._workLb[i] += symbolicLowerBias[i];
         if ( symbolicUpperBias )
-            _workUb[i] += symbolicUpperBias[i];
+            memory._workUb[i] += symbolicUpperBias[i];
     }
 }
 
 
+void DeepPolyWeightedSumElement::copyWeightsOfBlock( unsigned sourceLayerIndex,
+                                                     unsigned sourceLayerSize,
+                                                     unsigned begin,
+                                                     unsigned end,
+                                                     double *blockWeights ) const
+{
+    unsigned blockSize = end - begin;
+    if ( _layer->hasSparseWeights( sourceLayerIndex ) )
+    {
+        const SparseWeightMatrix *weights = _layer->getSparseWeights( sourceLayerIndex );
+        const unsigned *sources = weights->getSources();
+        const double *values = weights->getWeights();
+
+        std::fill_n( blockWeights, sourceLayerSize * blockSize, 0 );
+        for ( unsigned j = begin; j < end; ++j )
+        {
+            unsigned entryEnd = weights->getTargetEnd( j );
+            for ( unsigned k = weights->getTargetBegin( j ); k < entryEnd; ++k )
+                blockWeights[sources[k] * blockSize + j - begin] = values[k];
+        }
+        return;
+    }
+
+    const double *weights = _layer->getWeights( sourceLayerIndex );
+    for ( unsigned i = 0; i < sourceLayerSize; ++i )
+        memcpy( blockWeights + i * blockSize,
+                weights + i * _size + begin,
+                blockSize * sizeof( double ) );
+}
+
 void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     const double *symbolicLb,
     const double *symbolicUb,
@@ -387,23 +451,50 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     log( Stringf( "Computing symbolic bounds with respect to layer %u...", predecessorIndex ) );
     unsigned predecessorSize = predecessor->getSize();
 
-    double *weights = _layer->getWeights( predecessorIndex );
     double *biases = _layer->getBiases();
 
     // newSymbolicLb = weights * symbolicLb
     // newSymbolicUb = weights * symbolicUb
-    matrixMultiplication( weights,
-                          symbolicLb,
-                          symbolicLbInTermsOfPredecessor,
-                          predecessorSize,
-                          _size,
-                          targetLayerSize );
-    matrixMultiplication( weights,
-                          symbolicUb,
-                          symbolicUbInTermsOfPredecessor,
-                          predecessorSize,
-                          _size,
-                          targetLayerSize );
+    if ( _layer->hasSparseWeights( predecessorIndex ) )
+    {
+        const SparseWeightMatrix *weights = _layer->getSparseWeights( predecessorIndex );
+        const unsigned *sources = weights->getSources();
+        const double *values = weights->getWeights();
+
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            const double *lbRow = symbolicLb + i * targetLayerSize;
+            const double *ubRow = symbolicUb + i * targetLayerSize;
+            unsigned end = weights->getTargetEnd( i );
+            for ( unsigned k = weights->getTargetBegin( i ); k < end; ++k )
+            {
+                double weight = values[k];
+                double *newLbRow = symbolicLbInTermsOfPredecessor + sources[k] * targetLayerSize;
+                double *newUbRow = symbolicUbInTermsOfPredecessor + sources[k] * targetLayerSize;
+                for ( unsigned j = 0; j < targetLayerSize; ++j )
+                {
+                    newLbRow[j] += weight * lbRow[j];
+                    newUbRow[j] += weight * ubRow[j];
+                }
+            }
+        }
+    }
+    else
+    {
+        double *weights = _layer->getWeights( predecessorIndex );
+        matrixMultiplication( weights,
+                              symbolicLb,
+                              symbolicLbInTermsOfPredecessor,
+                              predecessorSize,
+                              _size,
+                              targetLayerSize );
+        matrixMultiplication( weights,
+                              symbolicUb,
+                              symbolicUbInTermsOfPredecessor,
+                              predecessorSize,
+                              _size,
+                              targetLayerSize );
+    }
 
     // symbolicLowerBias = biases * symbolicLb
     // symbolicUpperBias = biases * symbolicUb
@@ -414,62 +505,16 @@ void DeepPolyWeightedSumElement::symbolicBoundInTermsOfPredecessor(
     log( Stringf( "Computing symbolic bounds with respect to layer %u - done", predecessorIndex ) );
 }
 
-void DeepPolyWeightedSumElement::allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
-                                                                     unsigned residualLayerSize )
-{
-    _residualLayerIndices.insert( residualLayerIndex );
-    unsigned matrixSize = residualLayerSize * _size;
-    if ( !_residualLb.exists( residualLayerIndex ) )
-    {
-        double *residualLb = new double[matrixSize];
-        std::fill_n( residualLb, matrixSize, 0 );
-        _residualLb[residualLayerIndex] = residualLb;
-    }
-    if ( !_residualUb.exists( residualLayerIndex ) )
-    {
-        double *residualUb = new double[matrixSize];
-        std::fill_n( residualUb, matrixSize, 0 );
-        _residualUb[residualLayerIndex] = residualUb;
-    }
-}
-
 void DeepPolyWeightedSumElement::allocateMemory()
 {
     freeMemoryIfNeeded();
 
     DeepPolyElement::allocateMemory();
-
-    _workLb = new double[_size];
-    _workUb = new double[_size];
-
-    std::fill_n( _workLb, _size, FloatUtils::negativeInfinity() );
-    std::fill_n( _workUb, _size, FloatUtils::infinity() );
 }
 
 void DeepPolyWeightedSumElement::freeMemoryIfNeeded()
 {
     DeepPolyElement::freeMemoryIfNeeded();
-    if ( _workLb )
-    {
-        delete[] _workLb;
-        _workLb = NULL;
-    }
-    if ( _workUb )
-    {
-        delete[] _workUb;
-        _workUb = NULL;
-    }
-    for ( auto const &pair : _residualLb )
-    {
-        delete[] pair.second;
-    }
-    _residualLb.clear();
-    for ( auto const &pair : _residualUb )
-    {
-        delete[] pair.second;
-    }
-    _residualUb.clear();
-    _residualLayerIndices.clear();
 }
 
 void DeepPolyWeightedSumElement::log( const String &message )
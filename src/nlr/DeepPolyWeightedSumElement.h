@@ -43,42 +43,48 @@ public:
 
 private:
     /*
-      Memory allocated to store concrete bounds computed at different stages
-      of back substitution.
-    */
-    double *_workLb;
-    double *_workUb;
-
-    Set<unsigned> _residualLayerIndices;
-    Map<unsigned, double *> _residualLb;
-    Map<unsigned, double *> _residualUb;
-
-    /*
-      Compute the concrete upper- and lower- bounds of this layer by concretizing
-      the symbolic bounds with respect to every preceding element.
+      Compute the concrete upper- and lower- bounds of neurons [begin, end)
+      of this layer by concretizing their symbolic bounds with respect to
+      every preceding element, using the given working memory.
     */
     void computeBoundWithBackSubstitution(
-        const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
+        const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+        unsigned begin,
+        unsigned end,
+        DeepPolyWorkMemory &memory );
 
     /*
-      Compute concrete bounds using symbolic bounds with respect to a
-      sourceElement.
+      Compute concrete bounds of neurons [begin, end) using their symbolic
+      bounds with respect to a sourceElement.
     */
     void concretizeSymbolicBound( const double *symbolicLb,
                                   const double *symbolicUb,
                                   const double *symbolicLowerBias,
                                   const double *symbolicUpperBias,
                                   DeepPolyElement *sourceElement,
-                                  const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore );
+                                  const Map<unsigned, DeepPolyElement *> &deepPolyElementsBefore,
+                                  unsigned begin,
+                                  unsigned end,
+                                  DeepPolyWorkMemory &memory );
 
     void concretizeSymbolicBoundForSourceLayer( const double *symbolicLb,
                                                 const double *symbolicUb,
                                                 const double *symbolicLowerBias,
                                                 const double *symbolicUpperBias,
-                                                DeepPolyElement *sourceElement );
+                                                DeepPolyElement *sourceElement,
+                                                unsigned blockSize,
+                                                DeepPolyWorkMemory &memory );
+
+    /*
+      Copy the weights from a source layer to neurons [begin, end) of this
+      layer, in the layout of the working memory.
+    */
+    void copyWeightsOfBlock( unsigned sourceLayerIndex,
+                             unsigned sourceLayerSize,
+                             unsigned begin,
+                             unsigned end,
+                             double *blockWeights ) const;
 
-    void allocateMemoryForResidualsIfNeeded( unsigned residualLayerIndex,
-                                             unsigned residualLayerSize );
     void allocateMemory();
     void freeMemoryIfNeeded();
     void log( const String &message );
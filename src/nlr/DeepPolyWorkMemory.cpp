@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file DeepPolyWorkMemory.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Andrew Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "DeepPolyWorkMemory.h"
+
+#include <algorithm>
+
+namespace NLR {
+
+DeepPolyWorkMemory::DeepPolyWorkMemory( unsigned maxLayerSize, unsigned blockSize )
+    : _blockSize( blockSize )
+{
+    unsigned matrixSize = maxLayerSize * blockSize;
+
+    _work1SymbolicLb = new double[matrixSize];
+    _work1SymbolicUb = new double[matrixSize];
+    _work2SymbolicLb = new double[matrixSize];
+    _work2SymbolicUb = new double[matrixSize];
+
+    _workSymbolicLowerBias = new double[blockSize];
+    _workSymbolicUpperBias = new double[blockSize];
+    _workLb = new double[blockSize];
+    _workUb = new double[blockSize];
+
+    std::fill_n( _work1SymbolicLb, matrixSize, 0 );
+    std::fill_n( _work1SymbolicUb, matrixSize, 0 );
+    std::fill_n( _work2SymbolicLb, matrixSize, 0 );
+    std::fill_n( _work2SymbolicUb, matrixSize, 0 );
+
+    std::fill_n( _workSymbolicLowerBias, blockSize, 0 );
+    std::fill_n( _workSymbolicUpperBias, blockSize, 0 );
+    std::fill_n( _workLb, blockSize, 0 );
+    std::fill_n( _workUb, blockSize, 0 );
+}
+
+DeepPolyWorkMemory::~DeepPolyWorkMemory()
+{
+    delete[] _work1SymbolicLb;
+    delete[] _work1SymbolicUb;
+    delete[] _work2SymbolicLb;
+    delete[] _work2SymbolicUb;
+
+    delete[] _workSymbolicLowerBias;
+    delete[] _workSymbolicUpperBias;
+    delete[] _workLb;
+    delete[] _workUb;
+
+    for ( const auto &pair : _residualLb )
+        delete[] pair.second;
+    for ( const auto &pair : _residualUb )
+        delete[] pair.second;
+}
+
+unsigned DeepPolyWorkMemory::getBlockSize() const
+{
+    return _blockSize;
+}
+
+void DeepPolyWorkMemory::addResidualLayer( unsigned residualLayerIndex,
+                                           unsigned residualLayerSize )
+{
+    _residualLayerIndices.insert( residualLayerIndex );
+    unsigned matrixSize = residualLayerSize * _blockSize;
+    if ( !_residualLb.exists( residualLayerIndex ) )
+    {
+        double *residualLb = new double[matrixSize];
+        std::fill_n( residualLb, matrixSize, 0 );
+        _residualLb[residualLayerIndex] = residualLb;
+    }
+    if ( !_residualUb.exists( residualLayerIndex ) )
+    {
+        double *residualUb = new double[matrixSize];
+        std::fill_n( residualUb, matrixSize, 0 );
+        _residualUb[residualLayerIndex] = residualUb;
+    }
+}
+
+} // namespace NLR
@@ -0,0 +1,78 @@
+/*********************                                                        */
+/*! \file DeepPolyWorkMemory.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Andrew Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __DeepPolyWorkMemory_h__
+#define __DeepPolyWorkMemory_h__
+
+#include "Map.h"
+#include "Set.h"
+
+namespace NLR {
+
+/*
+  Working memory for back-substituting the symbolic bounds of a block of
+  (at most blockSize) neurons through layers of at most maxLayerSize
+  neurons. Symbolic bounds are stored source-major: the coefficient of
+  source neuron i in the bound of the j-th neuron of the block is at
+  i * blockSize + j. Every thread of the DeepPoly analysis owns one
+  instance, so that blocks can be processed in parallel.
+*/
+class DeepPolyWorkMemory
+{
+public:
+    DeepPolyWorkMemory( unsigned maxLayerSize, unsigned blockSize );
+    ~DeepPolyWorkMemory();
+
+    unsigned getBlockSize() const;
+
+    /*
+      Mark a residual layer as having pending symbolic bounds, allocating
+      them if needed. Newly allocated bounds are all zeros, and the
+      back-substitution resets them to zeros once they are consumed.
+    */
+    void addResidualLayer( unsigned residualLayerIndex, unsigned residualLayerSize );
+
+    /*
+      Symbolic bounds of the block with respect to the current layer, and
+      the next one.
+    */
+    double *_work1SymbolicLb;
+    double *_work1SymbolicUb;
+    double *_work2SymbolicLb;
+    double *_work2SymbolicUb;
+    double *_workSymbolicLowerBias;
+    double *_workSymbolicUpperBias;
+
+    /*
+      Concrete bounds of the block computed at the current stage.
+    */
+    double *_workLb;
+    double *_workUb;
+
+    /*
+      Symbolic bounds of the block with respect to residual layers that
+      the back-substitution has not reached yet.
+    */
+    Set<unsigned> _residualLayerIndices;
+    Map<unsigned, double *> _residualLb;
+    Map<unsigned, double *> _residualUb;
+
+private:
+    unsigned _blockSize;
+};
+
+} // namespace NLR
+
+#endif // __DeepPolyWorkMemory_h__
@@ -21,6 +21,7 @@
 #include "MStringf.h"
 #include "NLRError.h"
 #include "Options.h"
+#include "ThreadPool.h"
 #include "TimeUtils.h"
 #include "Vector.h"
 
@@ -30,43 +31,73 @@ LPFormulator::LPFormulator( LayerOwner *layerOwner )
     : _layerOwner( layerOwner )
     , _cutoffInUse( false )
     , _cutoffValue( 0 )
+    , _lpSolverType( Options::get()->getLPSolverType() )
+    , _quitRequested( NULL )
+    , _numberOfWorkers( Options::get()->getInt( Options::NUM_WORKERS ) )
+    , _threadPool( nullptr )
 {
 }
 
 LPFormulator::~LPFormulator()
 {
+    for ( auto &solver : _gurobiSolvers )
+        delete solver;
+    _gurobiSolvers.clear();
+
+    for ( auto &solver : _simplexSolvers )
+        delete solver;
+    _simplexSolvers.clear();
 }
 
-double LPFormulator::solveLPRelaxation( GurobiWrapper &gurobi,
+template <class LPSolver>
+double LPFormulator::solveLPRelaxation( LPSolver &solver,
                                         const Map<unsigned, Layer *> &layers,
                                         MinOrMax minOrMax,
                                         String variableName,
                                         unsigned lastLayer )
 {
-    gurobi.resetModel();
-    createLPRelaxation( layers, gurobi, lastLayer );
-    return optimizeWithGurobi( gurobi, minOrMax, variableName, _cutoffValue );
+    solver.resetModel();
+    createLPRelaxation( layers, solver, lastLayer );
+    return optimizeWithLpSolver( solver, minOrMax, variableName, _cutoffValue );
+}
+
+template <>
+double LPFormulator::getOptimalBound<GurobiWrapper>( GurobiWrapper &gurobi )
+{
+    Map<String, double> dontCare;
+    double result = 0;
+    gurobi.extractSolution( dontCare, result );
+    return result;
+}
+
+template <>
+double LPFormulator::getOptimalBound<SimplexSolver>( SimplexSolver &solver )
+{
+    return solver.getObjectiveBound();
 }
 
-double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
-                                         MinOrMax minOrMax,
-                                         String variableName,
-                                         double cutoffValue,
-                                         std::atomic_bool *infeasible )
+template <class LPSolver>
+double LPFormulator::optimizeWithLpSolver( LPSolver &solver,
+                                           MinOrMax minOrMax,
+                                           String variableName,
+                                           double cutoffValue,
+                                           std::atomic_bool *infeasible )
 {
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
+    typedef typename LPSolver::Term Term;
+
+    List<Term> terms;
+    terms.append( Term( 1, variableName ) );
 
     if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
+        solver.setObjective( terms );
     else
-        gurobi.setCost( terms );
+        solver.setCost( terms );
 
-    gurobi.setTimeLimit( FloatUtils::infinity() );
+    solver.setTimeLimit( FloatUtils::infinity() );
 
-    gurobi.solve();
+    solver.solve();
 
-    if ( gurobi.infeasible() )
+    if ( solver.infeasible() )
     {
         if ( infeasible )
         {
@@ -77,19 +108,16 @@ double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
             throw InfeasibleQueryException();
     }
 
-    if ( gurobi.cutoffOccurred() )
+    if ( solver.cutoffOccurred() )
         return cutoffValue;
 
-    if ( gurobi.optimal() )
+    if ( solver.optimal() )
     {
-        Map<String, double> dontCare;
-        double result = 0;
-        gurobi.extractSolution( dontCare, result );
-        return result;
+        return getOptimalBound( solver );
     }
-    else if ( gurobi.timeout() )
+    else if ( solver.timeout() )
     {
-        return gurobi.getObjectiveBound();
+        return solver.getObjectiveBound();
     }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -97,10 +125,25 @@ double LPFormulator::optimizeWithGurobi( GurobiWrapper &gurobi,
 
 void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers )
 {
-    GurobiWrapper gurobi;
+    if ( _lpSolverType == LPSolverType::NATIVE )
+    {
+        SimplexSolver solver;
+        optimizeBoundsWithIncrementalLpRelaxation( layers, solver );
+    }
+    else
+    {
+        GurobiWrapper gurobi;
+        optimizeBoundsWithIncrementalLpRelaxation( layers, gurobi );
+    }
+}
 
-    List<GurobiWrapper::Term> terms;
-    Map<String, double> dontCare;
+template <class LPSolver>
+void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                              LPSolver &solver )
+{
+    typedef typename LPSolver::Term Term;
+
+    List<Term> terms;
     double lb = 0;
     double ub = 0;
     double currentLb = 0;
@@ -125,7 +168,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
         */
         ASSERT( layers.exists( i ) );
         Layer *layer = layers[i];
-        addLayerToModel( gurobi, layer, false );
+        addLayerToModel( solver, layer, false );
 
         for ( unsigned j = 0; j < layer->getSize(); ++j )
         {
@@ -142,27 +185,27 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             Stringf variableName( "x%u", variable );
 
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, variableName ) );
+            terms.append( Term( 1, variableName ) );
 
             // Maximize
-            gurobi.reset();
-            gurobi.setObjective( terms );
-            gurobi.solve();
+            solver.reset();
+            solver.setObjective( terms );
+            solver.solve();
 
-            if ( gurobi.infeasible() )
+            if ( solver.infeasible() )
                 throw InfeasibleQueryException();
 
-            if ( gurobi.cutoffOccurred() )
+            if ( solver.cutoffOccurred() )
             {
                 ub = _cutoffValue;
             }
-            else if ( gurobi.optimal() )
+            else if ( solver.optimal() )
             {
-                gurobi.extractSolution( dontCare, ub );
+                ub = getOptimalBound( solver );
             }
-            else if ( gurobi.timeout() )
+            else if ( solver.timeout() )
             {
-                ub = gurobi.getObjectiveBound();
+                ub = solver.getObjectiveBound();
             }
             else
             {
@@ -172,7 +215,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             // If the bound is tighter, store it
             if ( ub < currentUb )
             {
-                gurobi.setUpperBound( variableName, ub );
+                solver.setUpperBound( variableName, ub );
 
                 if ( FloatUtils::isPositive( currentUb ) && !FloatUtils::isPositive( ub ) )
                     ++signChanges;
@@ -189,24 +232,24 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             }
 
             // Minimize
-            gurobi.reset();
-            gurobi.setCost( terms );
-            gurobi.solve();
+            solver.reset();
+            solver.setCost( terms );
+            solver.solve();
 
-            if ( gurobi.infeasible() )
+            if ( solver.infeasible() )
                 throw InfeasibleQueryException();
 
-            if ( gurobi.cutoffOccurred() )
+            if ( solver.cutoffOccurred() )
             {
                 lb = _cutoffValue;
             }
-            else if ( gurobi.optimal() )
+            else if ( solver.optimal() )
             {
-                gurobi.extractSolution( dontCare, lb );
+                lb = getOptimalBound( solver );
             }
-            else if ( gurobi.timeout() )
+            else if ( solver.timeout() )
             {
-                lb = gurobi.getObjectiveBound();
+                lb = solver.getObjectiveBound();
             }
             else
             {
@@ -216,7 +259,7 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             // If the bound is tighter, store it
             if ( lb > currentLb )
             {
-                gurobi.setLowerBound( variableName, lb );
+                solver.setLowerBound( variableName, lb );
 
                 if ( FloatUtils::isNegative( currentLb ) && !FloatUtils::isNegative( lb ) )
                     ++signChanges;
@@ -250,383 +293,286 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
 void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers,
                                                    bool backward )
 {
-    unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
-
-    Map<GurobiWrapper *, unsigned> solverToIndex;
-    // Create a queue of free workers
-    // When a worker is working, it is popped off the queue, when it is done, it
-    // is added back to the queue.
-    SolverQueue freeSolvers( numberOfWorkers );
-    for ( unsigned i = 0; i < numberOfWorkers; ++i )
+    List<unsigned> targetIndices;
+    for ( unsigned i = 0; i < layers.size(); ++i )
     {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
+        // A backward pass skips the input layer
+        if ( backward && i > 0 )
+            targetIndices.appendHead( i );
+        else if ( !backward )
+            targetIndices.append( i );
     }
 
-    boost::thread *threads = new boost::thread[numberOfWorkers];
-    std::mutex mtx;
-    std::atomic_bool infeasible( false );
+    if ( _lpSolverType == LPSolverType::NATIVE )
+        optimizeBoundsOfLayersWithLpRelaxation<SimplexSolver>(
+            layers, targetIndices, backward, false );
+    else
+        optimizeBoundsOfLayersWithLpRelaxation<GurobiWrapper>(
+            layers, targetIndices, backward, false );
+}
 
-    std::atomic_uint tighterBoundCounter( 0 );
-    std::atomic_uint signChanges( 0 );
-    std::atomic_uint cutoffs( 0 );
+void LPFormulator::optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                             unsigned targetIndex )
+{
+    List<unsigned> targetIndices;
+    targetIndices.append( targetIndex );
 
-    struct timespec gurobiStart;
-    (void)gurobiStart;
-    struct timespec gurobiEnd;
-    (void)gurobiEnd;
+    if ( _lpSolverType == LPSolverType::NATIVE )
+        optimizeBoundsOfLayersWithLpRelaxation<SimplexSolver>( layers, targetIndices, false, true );
+    else
+        optimizeBoundsOfLayersWithLpRelaxation<GurobiWrapper>( layers, targetIndices, false, true );
+}
 
-    gurobiStart = TimeUtils::sampleMicro();
+void LPFormulator::checkSimulationsForCutoff( unsigned targetIndex,
+                                              unsigned neuron,
+                                              bool &skipTightenLb,
+                                              bool &skipTightenUb ) const
+{
+    skipTightenLb = false;
+    skipTightenUb = false;
 
-    unsigned startIndex = backward ? layers.size() - 1 : 0;
-    unsigned endIndex = backward ? 0 : layers.size();
-    for ( unsigned layerIndex = startIndex; layerIndex != endIndex;
-          backward ? --layerIndex : ++layerIndex )
-    {
-        LPFormulator_LOG( Stringf( "Tightening bound for layer %u...", layerIndex ).ascii() );
-        Layer *layer = layers[layerIndex];
-
-        ThreadArgument argument( layer,
-                                 &layers,
-                                 std::ref( freeSolvers ),
-                                 std::ref( mtx ),
-                                 std::ref( infeasible ),
-                                 std::ref( tighterBoundCounter ),
-                                 std::ref( signChanges ),
-                                 std::ref( cutoffs ),
-                                 layer->getLayerIndex(),
-                                 layerIndex,
-                                 threads,
-                                 &solverToIndex );
-
-        // optimize every neuron of layer
-        optimizeBoundsOfNeuronsWithLpRlaxation( argument, backward );
-        LPFormulator_LOG( Stringf( "Tightening bound for layer %u - done", layerIndex ).ascii() );
-    }
+    if ( !_cutoffInUse )
+        return;
 
-    for ( unsigned i = 0; i < numberOfWorkers; ++i )
+    const Layer *simulatedLayer = _layerOwner->getLayer( targetIndex );
+    const double *simulations = simulatedLayer->getSimulations();
+    unsigned numberOfSimulations = simulatedLayer->getNumberOfSimulations();
+    unsigned simulatedLayerSize = simulatedLayer->getSize();
+
+    for ( unsigned j = 0; j < numberOfSimulations; ++j )
     {
-        threads[i].join();
-    }
+        double simValue = simulations[j * simulatedLayerSize + neuron];
 
-    gurobiEnd = TimeUtils::sampleMicro();
+        // If x_lower < 0 < x_sim, do not try to call tightning upper bound.
+        if ( _cutoffValue < simValue )
+            skipTightenUb = true;
 
-    LPFormulator_LOG(
-        Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
-                 tighterBoundCounter.load(),
-                 signChanges.load(),
-                 cutoffs.load() )
-            .ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n",
-                               TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 )
-                          .ascii() );
-
-    clearSolverQueue( freeSolvers );
+        // If x_sim < 0 < x_upper, do not try to call tightning lower bound.
+        if ( simValue < _cutoffValue )
+            skipTightenLb = true;
 
-    if ( infeasible )
-        throw InfeasibleQueryException();
+        if ( skipTightenUb && skipTightenLb )
+            break;
+    }
 }
 
-void LPFormulator::optimizeBoundsOfOneLayerWithLpRelaxation( const Map<unsigned, Layer *> &layers,
-                                                             unsigned targetIndex )
+template <>
+Vector<GurobiWrapper *> &LPFormulator::getWorkerSolvers<GurobiWrapper>()
 {
-    unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
-
-    Map<GurobiWrapper *, unsigned> solverToIndex;
-    // Create a queue of free workers
-    // When a worker is working, it is popped off the queue, when it is done, it
-    // is added back to the queue.
-    SolverQueue freeSolvers( numberOfWorkers );
-    for ( unsigned i = 0; i < numberOfWorkers; ++i )
-    {
-        GurobiWrapper *gurobi = new GurobiWrapper();
-        solverToIndex[gurobi] = i;
-        enqueueSolver( freeSolvers, gurobi );
-    }
-
-    boost::thread *threads = new boost::thread[numberOfWorkers];
-    std::mutex mtx;
-    std::atomic_bool infeasible( false );
-
-    std::atomic_uint tighterBoundCounter( 0 );
-    std::atomic_uint signChanges( 0 );
-    std::atomic_uint cutoffs( 0 );
+    return _gurobiSolvers;
+}
 
-    struct timespec gurobiStart;
-    (void)gurobiStart;
-    struct timespec gurobiEnd;
-    (void)gurobiEnd;
+template <>
+Vector<SimplexSolver *> &LPFormulator::getWorkerSolvers<SimplexSolver>()
+{
+    return _simplexSolvers;
+}
 
-    gurobiStart = TimeUtils::sampleMicro();
+bool LPFormulator::quitRequested() const
+{
+    return _quitRequested && *_quitRequested;
+}
 
-    Layer *layer = layers[targetIndex];
-
-    ThreadArgument argument( layer,
-                             &layers,
-                             std::ref( freeSolvers ),
-                             std::ref( mtx ),
-                             std::ref( infeasible ),
-                             std::ref( tighterBoundCounter ),
-                             std::ref( signChanges ),
-                             std::ref( cutoffs ),
-                             layers.size() - 1,
-                             targetIndex,
-                             threads,
-                             &solverToIndex );
-
-    // optimize every neuron of layer
-    optimizeBoundsOfNeuronsWithLpRlaxation( argument, false );
-
-    for ( unsigned i = 0; i < numberOfWorkers; ++i )
+template <class LPSolver>
+void LPFormulator::prepareWorkerModel( const Map<unsigned, Layer *> &layers,
+                                       LPSolver &solver,
+                                       unsigned &lastEncodedLayer,
+                                       unsigned targetIndex,
+                                       bool backward,
+                                       bool wholeNetwork )
+{
+    if ( backward || wholeNetwork || lastEncodedLayer == UINT_MAX ||
+         lastEncodedLayer > targetIndex )
     {
-        threads[i].join();
+        solver.resetModel();
+        if ( backward )
+            createLPRelaxationAfter( layers, solver, targetIndex );
+        else
+            createLPRelaxation( layers, solver, wholeNetwork ? UINT_MAX : targetIndex );
+        lastEncodedLayer = targetIndex;
+        return;
     }
 
-    gurobiEnd = TimeUtils::sampleMicro();
-
-    LPFormulator_LOG(
-        Stringf( "Number of tighter bounds found by Gurobi: %u. Sign changes: %u. Cutoffs: %u\n",
-                 tighterBoundCounter.load(),
-                 signChanges.load(),
-                 cutoffs.load() )
-            .ascii() );
-    LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n",
-                               TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 )
-                          .ascii() );
+    /*
+      The layers before the last encoded layer were final when they were
+      encoded, but the last encoded layer was a target layer itself
+    */
+    const Layer *encodedLayer = layers[lastEncodedLayer];
+    for ( unsigned i = 0; i < encodedLayer->getSize(); ++i )
+    {
+        if ( encodedLayer->neuronEliminated( i ) )
+            continue;
 
-    clearSolverQueue( freeSolvers );
+        Stringf variableName( "x%u", encodedLayer->neuronToVariable( i ) );
+        solver.setLowerBound( variableName, encodedLayer->getLb( i ) );
+        solver.setUpperBound( variableName, encodedLayer->getUb( i ) );
+    }
 
-    if ( infeasible )
-        throw InfeasibleQueryException();
+    for ( const auto &layer : layers )
+    {
+        if ( layer.first > lastEncodedLayer && layer.first <= targetIndex )
+            addLayerToModel( solver, layer.second, false );
+    }
+    lastEncodedLayer = targetIndex;
 }
 
-void LPFormulator::optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args, bool backward )
+template <class LPSolver>
+void LPFormulator::optimizeBoundsOfLayersWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                          const List<unsigned> &targetIndices,
+                                                          bool backward,
+                                                          bool wholeNetwork )
 {
-    unsigned numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
+    if ( !_threadPool )
+        _threadPool = std::unique_ptr<ThreadPool>( new ThreadPool( _numberOfWorkers ) );
+    unsigned numberOfWorkers = _threadPool->getNumThreads();
 
-    // Time to wait if no idle worker is availble
-    boost::chrono::milliseconds waitTime( numberOfWorkers - 1 );
+    Vector<LPSolver *> &solvers = getWorkerSolvers<LPSolver>();
+    while ( solvers.size() < numberOfWorkers )
+        solvers.append( new LPSolver() );
 
-    Layer *layer = args._layer;
-    const Map<unsigned, Layer *> layers = *args._layers;
-    unsigned targetIndex = args._targetIndex;
-    unsigned lastIndexOfRelaxation = args._lastIndexOfRelaxation;
+    /*
+      The last layer encoded in the model of every worker. The bounds may
+      have changed since the previous call, so the models are rebuilt.
+    */
+    Vector<unsigned> lastEncodedLayer( numberOfWorkers, UINT_MAX );
+    Vector<unsigned> workerTarget( numberOfWorkers, UINT_MAX );
 
-    const Map<GurobiWrapper *, unsigned> solverToIndex = *args._solverToIndex;
-    SolverQueue &freeSolvers = args._freeSolvers;
-    std::mutex &mtx = args._mtx;
-    std::atomic_bool &infeasible = args._infeasible;
-    std::atomic_uint &tighterBoundCounter = args._tighterBoundCounter;
-    std::atomic_uint &signChanges = args._signChanges;
-    std::atomic_uint &cutoffs = args._cutoffs;
-    boost::thread *threads = args._threads;
+    std::mutex mtx;
+    std::atomic_bool infeasible( false );
 
-    double currentLb;
-    double currentUb;
+    std::atomic_uint tighterBoundCounter( 0 );
+    std::atomic_uint signChanges( 0 );
+    std::atomic_uint cutoffs( 0 );
 
-    bool skipTightenLb = false; // If true, skip lower bound tightening
-    bool skipTightenUb = false; // If true, skip upper bound tightening
+    struct timespec solverStart;
+    (void)solverStart;
+    struct timespec solverEnd;
+    (void)solverEnd;
 
-    // declare simulations as local var to avoid a problem which can happen due to multi thread
-    // process.
-    const Vector<Vector<double>> *simulations =
-        _layerOwner->getLayer( targetIndex )->getSimulations();
+    solverStart = TimeUtils::sampleMicro();
 
-    for ( unsigned i = 0; i < layer->getSize(); ++i )
+    for ( unsigned targetIndex : targetIndices )
     {
-        if ( layer->neuronEliminated( i ) )
-            continue;
+        if ( quitRequested() )
+            break;
 
-        currentLb = layer->getLb( i );
-        currentUb = layer->getUb( i );
+        LPFormulator_LOG( Stringf( "Tightening bound for layer %u...", targetIndex ).ascii() );
+        Layer *layer = layers[targetIndex];
 
-        if ( _cutoffInUse && ( currentLb >= _cutoffValue || currentUb <= _cutoffValue ) )
-            continue;
+        _threadPool->run( layer->getSize(), [&]( unsigned neuron, unsigned thread ) {
+            if ( infeasible || quitRequested() || layer->neuronEliminated( neuron ) )
+                return;
 
-        skipTightenLb = false;
-        skipTightenUb = false;
+            double currentLb = layer->getLb( neuron );
+            double currentUb = layer->getUb( neuron );
 
-        // Loop for simulation
-        for ( const auto &simValue : ( *simulations ).get( i ) )
-        {
-            if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to
-                                                           // call tightning upper bound.
-                skipTightenUb = true;
-
-            if ( _cutoffInUse && simValue < _cutoffValue ) // If x_sim < 0 < x_upper, do not try to
-                                                           // call tightning lower bound.
-                skipTightenLb = true;
+            if ( _cutoffInUse && ( currentLb >= _cutoffValue || currentUb <= _cutoffValue ) )
+                return;
 
-            if ( skipTightenUb && skipTightenLb )
-                break;
-        }
+            bool skipTightenLb = false;
+            bool skipTightenUb = false;
+            checkSimulationsForCutoff( targetIndex, neuron, skipTightenLb, skipTightenUb );
+            if ( skipTightenLb && skipTightenUb )
+                return;
 
-        // If no tightning is needed, continue
-        if ( skipTightenUb && skipTightenLb )
-        {
-            LPFormulator_LOG(
-                Stringf(
-                    "Skip tightening lower and upper bounds for layer %d index %u", targetIndex, i )
-                    .ascii() );
-            continue;
-        }
-        else if ( skipTightenUb )
-        {
-            LPFormulator_LOG(
-                Stringf( "Skip tightening upper bound for layer %u index %u", targetIndex, i )
-                    .ascii() );
-        }
-        else if ( skipTightenLb )
-        {
-            LPFormulator_LOG(
-                Stringf( "Skip tightening lower bound for layer %u index %u", targetIndex, i )
-                    .ascii() );
-        }
-
-        if ( infeasible )
-        {
-            // infeasibility is derived, interupt all active threads
-            for ( unsigned i = 0; i < numberOfWorkers; ++i )
+            /*
+              Every worker prepares its model on its first neuron of the
+              layer, and reuses it for the rest. Bounds tightened since then
+              are missing from the model, which only makes it looser.
+            */
+            LPSolver &solver = *solvers[thread];
+            if ( workerTarget[thread] != targetIndex )
             {
-                threads[i].interrupt();
-                threads[i].join();
+                std::lock_guard<std::mutex> lock( mtx );
+                prepareWorkerModel( layers,
+                                    solver,
+                                    lastEncodedLayer[thread],
+                                    targetIndex,
+                                    backward,
+                                    wholeNetwork );
+                workerTarget[thread] = targetIndex;
             }
-            clearSolverQueue( freeSolvers );
-            throw InfeasibleQueryException();
-        }
 
-        // Wait until there is an idle solver
-        GurobiWrapper *freeSolver;
-        while ( !freeSolvers.pop( freeSolver ) )
-            boost::this_thread::sleep_for( waitTime );
+            unsigned variable = layer->neuronToVariable( neuron );
+            Stringf variableName( "x%u", variable );
 
-        freeSolver->resetModel();
+            if ( !skipTightenUb )
+            {
+                solver.reset();
+                double ub = optimizeWithLpSolver(
+                    solver, MinOrMax::MAX, variableName, _cutoffValue, &infeasible );
+                if ( infeasible )
+                    return;
 
-        mtx.lock();
-        if ( backward )
-            createLPRelaxationAfter( layers, *freeSolver, lastIndexOfRelaxation );
-        else
-            createLPRelaxation( layers, *freeSolver, lastIndexOfRelaxation );
-        mtx.unlock();
-
-        // spawn a thread to tighten the bounds for the current variable
-        ThreadArgument argument( freeSolver,
-                                 layer,
-                                 i,
-                                 currentLb,
-                                 currentUb,
-                                 _cutoffInUse,
-                                 _cutoffValue,
-                                 _layerOwner,
-                                 std::ref( freeSolvers ),
-                                 std::ref( mtx ),
-                                 std::ref( infeasible ),
-                                 std::ref( tighterBoundCounter ),
-                                 std::ref( signChanges ),
-                                 std::ref( cutoffs ),
-                                 skipTightenLb,
-                                 skipTightenUb );
-
-        if ( numberOfWorkers == 1 )
-            tightenSingleVariableBoundsWithLPRelaxation( argument );
-        else
-            threads[solverToIndex[freeSolver]] =
-                boost::thread( tightenSingleVariableBoundsWithLPRelaxation, argument );
-    }
-}
+                if ( ub < currentUb )
+                {
+                    if ( FloatUtils::isPositive( currentUb ) && !FloatUtils::isPositive( ub ) )
+                        ++signChanges;
 
+                    mtx.lock();
+                    layer->setUb( neuron, ub );
+                    _layerOwner->receiveTighterBound( Tightening( variable, ub, Tightening::UB ) );
+                    mtx.unlock();
 
-void LPFormulator::tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &argument )
-{
-    try
-    {
-        GurobiWrapper *gurobi = argument._gurobi;
-        Layer *layer = argument._layer;
-        unsigned index = argument._index;
-        double currentLb = argument._currentLb;
-        double currentUb = argument._currentUb;
-        bool cutoffInUse = argument._cutoffInUse;
-        double cutoffValue = argument._cutoffValue;
-        LayerOwner *layerOwner = argument._layerOwner;
-        SolverQueue &freeSolvers = argument._freeSolvers;
-        std::mutex &mtx = argument._mtx;
-        std::atomic_bool &infeasible = argument._infeasible;
-        std::atomic_uint &tighterBoundCounter = argument._tighterBoundCounter;
-        std::atomic_uint &signChanges = argument._signChanges;
-        std::atomic_uint &cutoffs = argument._cutoffs;
-        bool skipTightenLb = argument._skipTightenLb;
-        bool skipTightenUb = argument._skipTightenUb;
-
-        LPFormulator_LOG(
-            Stringf( "Tightening bounds for layer %u index %u", layer->getLayerIndex(), index )
-                .ascii() );
-
-        unsigned variable = layer->neuronToVariable( index );
-        Stringf variableName( "x%u", variable );
-
-        if ( !skipTightenUb )
-        {
-            LPFormulator_LOG( Stringf( "Computing upperbound..." ).ascii() );
-            double ub = optimizeWithGurobi(
-                *gurobi, MinOrMax::MAX, variableName, cutoffValue, &infeasible );
-            LPFormulator_LOG( Stringf( "Upperbound computed %f", ub ).ascii() );
+                    ++tighterBoundCounter;
 
-            // Store the new bound if it is tighter
-            if ( ub < currentUb )
+                    if ( _cutoffInUse && ub < _cutoffValue )
+                    {
+                        ++cutoffs;
+                        return;
+                    }
+                }
+            }
+
+            if ( !skipTightenLb )
             {
-                if ( FloatUtils::isPositive( currentUb ) && !FloatUtils::isPositive( ub ) )
-                    ++signChanges;
+                solver.reset();
+                double lb = optimizeWithLpSolver(
+                    solver, MinOrMax::MIN, variableName, _cutoffValue, &infeasible );
+                if ( infeasible )
+                    return;
 
-                mtx.lock();
-                layer->setUb( index, ub );
-                layerOwner->receiveTighterBound( Tightening( variable, ub, Tightening::UB ) );
-                mtx.unlock();
+                if ( lb > currentLb )
+                {
+                    if ( FloatUtils::isNegative( currentLb ) && !FloatUtils::isNegative( lb ) )
+                        ++signChanges;
 
-                ++tighterBoundCounter;
+                    mtx.lock();
+                    layer->setLb( neuron, lb );
+                    _layerOwner->receiveTighterBound( Tightening( variable, lb, Tightening::LB ) );
+                    mtx.unlock();
 
-                if ( cutoffInUse && ub < cutoffValue )
-                {
-                    ++cutoffs;
-                    enqueueSolver( freeSolvers, gurobi );
-                    return;
+                    ++tighterBoundCounter;
+
+                    if ( _cutoffInUse && lb > _cutoffValue )
+                        ++cutoffs;
                 }
             }
-        }
+        } );
 
-        if ( !skipTightenLb )
-        {
-            LPFormulator_LOG( Stringf( "Computing lowerbound..." ).ascii() );
-            gurobi->reset();
-            double lb = optimizeWithGurobi(
-                *gurobi, MinOrMax::MIN, variableName, cutoffValue, &infeasible );
-            LPFormulator_LOG( Stringf( "Lowerbound computed: %f", lb ).ascii() );
-            // Store the new bound if it is tighter
-            if ( lb > currentLb )
-            {
-                if ( FloatUtils::isNegative( currentLb ) && !FloatUtils::isNegative( lb ) )
-                    ++signChanges;
-
-                mtx.lock();
-                layer->setLb( index, lb );
-                layerOwner->receiveTighterBound( Tightening( variable, lb, Tightening::LB ) );
-                mtx.unlock();
-                ++tighterBoundCounter;
+        if ( infeasible )
+            throw InfeasibleQueryException();
 
-                if ( cutoffInUse && lb > cutoffValue )
-                    ++cutoffs;
-            }
-        }
-        enqueueSolver( freeSolvers, gurobi );
-    }
-    catch ( boost::thread_interrupted & )
-    {
-        enqueueSolver( argument._freeSolvers, argument._gurobi );
+        LPFormulator_LOG( Stringf( "Tightening bound for layer %u - done", targetIndex ).ascii() );
     }
+
+    solverEnd = TimeUtils::sampleMicro();
+
+    LPFormulator_LOG(
+        Stringf( "Number of tighter bounds found by the LP solver: %u. Sign changes: %u. "
+                 "Cutoffs: %u\n",
+                 tighterBoundCounter.load(),
+                 signChanges.load(),
+                 cutoffs.load() )
+            .ascii() );
+    LPFormulator_LOG( Stringf( "Seconds spent in the LP solver: %llu\n",
+                               TimeUtils::timePassed( solverStart, solverEnd ) / 1000000 )
+                          .ascii() );
 }
 
+template <class LPSolver>
 void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                                       GurobiWrapper &gurobi,
+                                       LPSolver &solver,
                                        unsigned lastLayer )
 {
     for ( const auto &layer : layers )
@@ -634,12 +580,13 @@ void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
         if ( layer.second->getLayerIndex() > lastLayer )
             continue;
 
-        addLayerToModel( gurobi, layer.second, false );
+        addLayerToModel( solver, layer.second, false );
     }
 }
 
+template <class LPSolver>
 void LPFormulator::createLPRelaxationAfter( const Map<unsigned, Layer *> &layers,
-                                            GurobiWrapper &gurobi,
+                                            LPSolver &solver,
                                             unsigned firstLayer )
 {
     unsigned depth = GlobalConfiguration::BACKWARD_BOUND_PROPAGATION_DEPTH;
@@ -658,7 +605,7 @@ void LPFormulator::createLPRelaxationAfter( const Map<unsigned, Layer *> &layers
             continue;
         else
         {
-            addLayerToModel( gurobi, currentLayer, true );
+            addLayerToModel( solver, currentLayer, true );
             for ( const auto &nextLayer : currentLayer->getSuccessorLayers() )
             {
                 if ( layerToDepth.exists( nextLayer ) )
@@ -671,34 +618,33 @@ void LPFormulator::createLPRelaxationAfter( const Map<unsigned, Layer *> &layers
 }
 
 
-void LPFormulator::addLayerToModel( GurobiWrapper &gurobi,
-                                    const Layer *layer,
-                                    bool createVariables )
+template <class LPSolver>
+void LPFormulator::addLayerToModel( LPSolver &solver, const Layer *layer, bool createVariables )
 {
     switch ( layer->getLayerType() )
     {
     case Layer::INPUT:
-        addInputLayerToLpRelaxation( gurobi, layer );
+        addInputLayerToLpRelaxation( solver, layer );
         break;
 
     case Layer::RELU:
-        addReluLayerToLpRelaxation( gurobi, layer, createVariables );
+        addReluLayerToLpRelaxation( solver, layer, createVariables );
         break;
 
     case Layer::WEIGHTED_SUM:
-        addWeightedSumLayerToLpRelaxation( gurobi, layer, createVariables );
+        addWeightedSumLayerToLpRelaxation( solver, layer, createVariables );
         break;
 
     case Layer::LEAKY_RELU:
-        addLeakyReluLayerToLpRelaxation( gurobi, layer, createVariables );
+        addLeakyReluLayerToLpRelaxation( solver, layer, createVariables );
         break;
 
     case Layer::SIGN:
-        addSignLayerToLpRelaxation( gurobi, layer, createVariables );
+        addSignLayerToLpRelaxation( solver, layer, createVariables );
         break;
 
     case Layer::MAX:
-        addMaxLayerToLpRelaxation( gurobi, layer, createVariables );
+        addMaxLayerToLpRelaxation( solver, layer, createVariables );
         break;
 
     default:
@@ -707,19 +653,23 @@ void LPFormulator::addLayerToModel( GurobiWrapper &gurobi,
     }
 }
 
-void LPFormulator::addInputLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer )
+template <class LPSolver>
+void LPFormulator::addInputLayerToLpRelaxation( LPSolver &solver, const Layer *layer )
 {
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         unsigned variable = layer->neuronToVariable( i );
-        gurobi.addVariable( Stringf( "x%u", variable ), layer->getLb( i ), layer->getUb( i ) );
+        solver.addVariable( Stringf( "x%u", variable ), layer->getLb( i ), layer->getUb( i ) );
     }
 }
 
-void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+template <class LPSolver>
+void LPFormulator::addReluLayerToLpRelaxation( LPSolver &solver,
                                                const Layer *layer,
                                                bool createVariables )
 {
+    typedef typename LPSolver::Term Term;
+
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         if ( !layer->neuronEliminated( i ) )
@@ -736,7 +686,7 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
                 double targetValue = sourceValue > 0 ? sourceValue : 0;
 
-                gurobi.addVariable( Stringf( "x%u", targetVariable ), targetValue, targetValue );
+                solver.addVariable( Stringf( "x%u", targetVariable ), targetValue, targetValue );
 
                 continue;
             }
@@ -745,10 +695,10 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceLb = sourceLayer->getLb( sourceNeuron );
             double sourceUb = sourceLayer->getUb( sourceNeuron );
             String sourceName = Stringf( "x%u", sourceVariable );
-            if ( createVariables && !gurobi.containsVariable( sourceName ) )
-                gurobi.addVariable( sourceName, sourceLb, sourceUb );
+            if ( createVariables && !solver.containsVariable( sourceName ) )
+                solver.addVariable( sourceName, sourceLb, sourceUb );
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), 0, layer->getUb( i ) );
+            solver.addVariable( Stringf( "x%u", targetVariable ), 0, layer->getUb( i ) );
 
             if ( !FloatUtils::isNegative( sourceLb ) )
             {
@@ -756,17 +706,17 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 if ( sourceLb < 0 )
                     sourceLb = 0;
 
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<Term> terms;
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else if ( !FloatUtils::isPositive( sourceUb ) )
             {
                 // The ReLU is inactive, y = 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<Term> terms;
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else
             {
@@ -781,15 +731,15 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 */
 
                 // y >= 0
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                List<Term> terms;
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 // y >= x, i.e. y - x >= 0
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 /*
                          u        ul
@@ -797,20 +747,23 @@ void LPFormulator::addReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                        u - l     u - l
                 */
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -sourceUb / ( sourceUb - sourceLb ),
-                                                   Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addLeqConstraint( terms,
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append(
+                    Term( -sourceUb / ( sourceUb - sourceLb ), Stringf( "x%u", sourceVariable ) ) );
+                solver.addLeqConstraint( terms,
                                          ( -sourceUb * sourceLb ) / ( sourceUb - sourceLb ) );
             }
         }
     }
 }
 
-void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
+template <class LPSolver>
+void LPFormulator::addSignLayerToLpRelaxation( LPSolver &solver,
                                                const Layer *layer,
                                                bool createVariables )
 {
+    typedef typename LPSolver::Term Term;
+
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         if ( layer->neuronEliminated( i ) )
@@ -828,7 +781,7 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
             double targetValue = FloatUtils::isNegative( sourceValue ) ? -1 : 1;
 
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), targetValue, targetValue );
+            solver.addVariable( Stringf( "x%u", targetVariable ), targetValue, targetValue );
 
             continue;
         }
@@ -837,18 +790,18 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
         double sourceLb = sourceLayer->getLb( sourceNeuron );
         double sourceUb = sourceLayer->getUb( sourceNeuron );
         String sourceName = Stringf( "x%u", sourceVariable );
-        if ( createVariables && !gurobi.containsVariable( sourceName ) )
-            gurobi.addVariable( sourceName, sourceLb, sourceUb );
+        if ( createVariables && !solver.containsVariable( sourceName ) )
+            solver.addVariable( sourceName, sourceLb, sourceUb );
 
         if ( !FloatUtils::isNegative( sourceLb ) )
         {
             // The Sign is positive, y = 1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), 1, 1 );
+            solver.addVariable( Stringf( "x%u", targetVariable ), 1, 1 );
         }
         else if ( FloatUtils::isNegative( sourceUb ) )
         {
             // The Sign is negative, y = -1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), -1, -1 );
+            solver.addVariable( Stringf( "x%u", targetVariable ), -1, -1 );
         }
         else
         {
@@ -864,17 +817,17 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
             */
 
             // -1 <= y <= 1
-            gurobi.addVariable( Stringf( "x%u", targetVariable ), -1, 1 );
+            solver.addVariable( Stringf( "x%u", targetVariable ), -1, 1 );
 
             /*
                      2
               y <= ----- x + 1
                     - l
             */
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( 2.0 / sourceLb, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addLeqConstraint( terms, 1 );
+            List<Term> terms;
+            terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( Term( 2.0 / sourceLb, Stringf( "x%u", sourceVariable ) ) );
+            solver.addLeqConstraint( terms, 1 );
 
             /*
                      2
@@ -882,25 +835,27 @@ void LPFormulator::addSignLayerToLpRelaxation( GurobiWrapper &gurobi,
                      u
             */
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append(
-                GurobiWrapper::Term( -2.0 / sourceUb, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addGeqConstraint( terms, -1 );
+            terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( Term( -2.0 / sourceUb, Stringf( "x%u", sourceVariable ) ) );
+            solver.addGeqConstraint( terms, -1 );
         }
     }
 }
 
-void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
+template <class LPSolver>
+void LPFormulator::addMaxLayerToLpRelaxation( LPSolver &solver,
                                               const Layer *layer,
                                               bool createVariables )
 {
+    typedef typename LPSolver::Term Term;
+
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
         if ( layer->neuronEliminated( i ) )
             continue;
 
         unsigned targetVariable = layer->neuronToVariable( i );
-        gurobi.addVariable(
+        solver.addVariable(
             Stringf( "x%u", targetVariable ), layer->getLb( i ), layer->getUb( i ) );
 
         List<NeuronIndex> sources = layer->getActivationSources( i );
@@ -910,7 +865,7 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
 
         double maxConcreteUb = FloatUtils::negativeInfinity();
 
-        List<GurobiWrapper::Term> terms;
+        List<Term> terms;
 
         for ( const auto &source : sources )
         {
@@ -930,15 +885,15 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceLb = sourceLayer->getLb( sourceNeuron );
             double sourceUb = sourceLayer->getUb( sourceNeuron );
             String sourceName = Stringf( "x%u", sourceVariable );
-            if ( createVariables && !gurobi.containsVariable( sourceName ) )
-                gurobi.addVariable( sourceName, sourceLb, sourceUb );
+            if ( createVariables && !solver.containsVariable( sourceName ) )
+                solver.addVariable( sourceName, sourceLb, sourceUb );
 
 
             // Target is at least source: target - source >= 0
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-            gurobi.addGeqConstraint( terms, 0 );
+            terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+            terms.append( Term( -1, Stringf( "x%u", sourceVariable ) ) );
+            solver.addGeqConstraint( terms, 0 );
 
             // Find maximal concrete upper bound
             if ( sourceUb > maxConcreteUb )
@@ -950,8 +905,8 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             // At least one of the sources has a fixed value,
             // and this fixed value dominates other sources.
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            gurobi.addEqConstraint( terms, maxFixedSourceValue );
+            terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+            solver.addEqConstraint( terms, maxFixedSourceValue );
         }
         else
         {
@@ -959,22 +914,25 @@ void LPFormulator::addMaxLayerToLpRelaxation( GurobiWrapper &gurobi,
             if ( haveFixedSourceValue )
             {
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                gurobi.addGeqConstraint( terms, maxFixedSourceValue );
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                solver.addGeqConstraint( terms, maxFixedSourceValue );
             }
 
             // Target must be smaller than greatest concrete upper bound
             terms.clear();
-            terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-            gurobi.addLeqConstraint( terms, maxConcreteUb );
+            terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+            solver.addLeqConstraint( terms, maxConcreteUb );
         }
     }
 }
 
-void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
+template <class LPSolver>
+void LPFormulator::addWeightedSumLayerToLpRelaxation( LPSolver &solver,
                                                       const Layer *layer,
                                                       bool createVariables )
 {
+    typedef typename LPSolver::Term Term;
+
     if ( createVariables )
     {
         for ( const auto &sourceLayerPair : layer->getSourceLayers() )
@@ -987,9 +945,9 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
                 if ( !sourceLayer->neuronEliminated( j ) )
                 {
                     Stringf sourceVariableName( "x%u", sourceLayer->neuronToVariable( j ) );
-                    if ( !gurobi.containsVariable( sourceVariableName ) )
+                    if ( !solver.containsVariable( sourceVariableName ) )
                     {
-                        gurobi.addVariable(
+                        solver.addVariable(
                             sourceVariableName, sourceLayer->getLb( j ), sourceLayer->getUb( j ) );
                     }
                 }
@@ -1003,10 +961,10 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
         {
             unsigned variable = layer->neuronToVariable( i );
 
-            gurobi.addVariable( Stringf( "x%u", variable ), layer->getLb( i ), layer->getUb( i ) );
+            solver.addVariable( Stringf( "x%u", variable ), layer->getLb( i ), layer->getUb( i ) );
 
-            List<GurobiWrapper::Term> terms;
-            terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", variable ) ) );
+            List<Term> terms;
+            terms.append( Term( -1, Stringf( "x%u", variable ) ) );
 
             double bias = -layer->getBias( i );
 
@@ -1021,7 +979,7 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
                     if ( !sourceLayer->neuronEliminated( j ) )
                     {
                         Stringf sourceVariableName( "x%u", sourceLayer->neuronToVariable( j ) );
-                        terms.append( GurobiWrapper::Term( weight, sourceVariableName ) );
+                        terms.append( Term( weight, sourceVariableName ) );
                     }
                     else
                     {
@@ -1030,15 +988,18 @@ void LPFormulator::addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
                 }
             }
 
-            gurobi.addEqConstraint( terms, bias );
+            solver.addEqConstraint( terms, bias );
         }
     }
 }
 
-void LPFormulator::addLeakyReluLayerToLpRelaxation( GurobiWrapper &gurobi,
+template <class LPSolver>
+void LPFormulator::addLeakyReluLayerToLpRelaxation( LPSolver &solver,
                                                     const Layer *layer,
                                                     bool createVariables )
 {
+    typedef typename LPSolver::Term Term;
+
     double slope = layer->getAlpha();
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -1056,7 +1017,7 @@ void LPFormulator::addLeakyReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 double sourceValue = sourceLayer->getEliminatedNeuronValue( sourceNeuron );
                 double targetValue = sourceValue > 0 ? sourceValue : 0;
 
-                gurobi.addVariable( Stringf( "x%u", targetVariable ), targetValue, targetValue );
+                solver.addVariable( Stringf( "x%u", targetVariable ), targetValue, targetValue );
 
                 continue;
             }
@@ -1066,28 +1027,28 @@ void LPFormulator::addLeakyReluLayerToLpRelaxation( GurobiWrapper &gurobi,
             double sourceUb = sourceLayer->getUb( sourceNeuron );
 
             String sourceName = Stringf( "x%u", sourceVariable );
-            if ( createVariables && !gurobi.containsVariable( sourceName ) )
-                gurobi.addVariable( sourceName, sourceLb, sourceUb );
+            if ( createVariables && !solver.containsVariable( sourceName ) )
+                solver.addVariable( sourceName, sourceLb, sourceUb );
 
-            gurobi.addVariable(
+            solver.addVariable(
                 Stringf( "x%u", targetVariable ), layer->getLb( i ), layer->getUb( i ) );
 
             if ( !FloatUtils::isNegative( sourceLb ) )
             {
                 // The ReLU is active, y = x
 
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<Term> terms;
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else if ( !FloatUtils::isPositive( sourceUb ) )
             {
                 // The ReLU is inactive, y = alpha * x
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -slope, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addEqConstraint( terms, 0 );
+                List<Term> terms;
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -slope, Stringf( "x%u", sourceVariable ) ) );
+                solver.addEqConstraint( terms, 0 );
             }
             else
             {
@@ -1104,21 +1065,21 @@ void LPFormulator::addLeakyReluLayerToLpRelaxation( GurobiWrapper &gurobi,
                 */
 
                 // y >= alpha * x
-                List<GurobiWrapper::Term> terms;
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -slope, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                List<Term> terms;
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -slope, Stringf( "x%u", sourceVariable ) ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 // y >= x, i.e. y - x >= 0
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -1, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addGeqConstraint( terms, 0 );
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -1, Stringf( "x%u", sourceVariable ) ) );
+                solver.addGeqConstraint( terms, 0 );
 
                 terms.clear();
-                terms.append( GurobiWrapper::Term( 1, Stringf( "x%u", targetVariable ) ) );
-                terms.append( GurobiWrapper::Term( -coeff, Stringf( "x%u", sourceVariable ) ) );
-                gurobi.addLeqConstraint( terms, bias );
+                terms.append( Term( 1, Stringf( "x%u", targetVariable ) ) );
+                terms.append( Term( -coeff, Stringf( "x%u", sourceVariable ) ) );
+                solver.addLeqConstraint( terms, bias );
             }
         }
     }
@@ -1130,4 +1091,34 @@ void LPFormulator::setCutoff( double cutoff )
     _cutoffValue = cutoff;
 }
 
+void LPFormulator::setQuitRequested( const std::atomic_bool *quitRequested )
+{
+    _quitRequested = quitRequested;
+}
+
+template void LPFormulator::createLPRelaxation<GurobiWrapper>( const Map<unsigned, Layer *> &,
+                                                               GurobiWrapper &,
+                                                               unsigned );
+template void LPFormulator::createLPRelaxation<SimplexSolver>( const Map<unsigned, Layer *> &,
+                                                               SimplexSolver &,
+                                                               unsigned );
+template void LPFormulator::createLPRelaxationAfter<GurobiWrapper>( const Map<unsigned, Layer *> &,
+                                                                    GurobiWrapper &,
+                                                                    unsigned );
+template void LPFormulator::createLPRelaxationAfter<SimplexSolver>( const Map<unsigned, Layer *> &,
+                                                                    SimplexSolver &,
+                                                                    unsigned );
+template double LPFormulator::solveLPRelaxation<GurobiWrapper>( GurobiWrapper &,
+                                                                const Map<unsigned, Layer *> &,
+                                                                MinOrMax,
+                                                                String,
+                                                                unsigned );
+template double LPFormulator::solveLPRelaxation<SimplexSolver>( SimplexSolver &,
+                                                                const Map<unsigned, Layer *> &,
+                                                                MinOrMax,
+                                                                String,
+                                                                unsigned );
+template void LPFormulator::addLayerToModel<GurobiWrapper>( GurobiWrapper &, const Layer *, bool );
+template void LPFormulator::addLayerToModel<SimplexSolver>( SimplexSolver &, const Layer *, bool );
+
 } // namespace NLR
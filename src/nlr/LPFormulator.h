@@ -17,15 +17,16 @@
 #define __LPFormulator_h__
 
 #include "GurobiWrapper.h"
+#include "LPSolverType.h"
 #include "LayerOwner.h"
 #include "Map.h"
-#include "ParallelSolver.h"
+#include "SimplexSolver.h"
+#include "ThreadPool.h"
+#include "Vector.h"
 
 #include <atomic>
-#include <boost/chrono.hpp>
-#include <boost/lockfree/queue.hpp>
-#include <boost/thread.hpp>
 #include <climits>
+#include <memory>
 #include <mutex>
 
 namespace NLR {
@@ -33,7 +34,7 @@ namespace NLR {
 #define LPFormulator_LOG( x, ... )                                                                 \
     LOG( GlobalConfiguration::PREPROCESSOR_LOGGING, "LP Preprocessor: %s\n", x )
 
-class LPFormulator : public ParallelSolver
+class LPFormulator
 {
 public:
     enum MinOrMax {
@@ -64,66 +65,145 @@ public:
     */
     void setCutoff( double cutoff );
 
+    /*
+      A flag that, once raised, makes the bound tightening stop after the
+      queries in progress. The bounds found so far are kept.
+    */
+    void setQuitRequested( const std::atomic_bool *quitRequested );
+
     /*
       Calls for creating an LP relaxation instance and solving it for
       a particular variable. These calls are useful if invoked as part
       of a larger procedure, e.g. as part of a MILP-based bound
-      tightening
+      tightening. The LP solver is either a GurobiWrapper or a
+      SimplexSolver.
     */
+    template <class LPSolver>
     void createLPRelaxation( const Map<unsigned, Layer *> &layers,
-                             GurobiWrapper &gurobi,
+                             LPSolver &solver,
                              unsigned lastLayer = UINT_MAX );
+    template <class LPSolver>
     void createLPRelaxationAfter( const Map<unsigned, Layer *> &layers,
-                                  GurobiWrapper &gurobi,
+                                  LPSolver &solver,
                                   unsigned firstLayer );
-    double solveLPRelaxation( GurobiWrapper &gurobi,
+    template <class LPSolver>
+    double solveLPRelaxation( LPSolver &solver,
                               const Map<unsigned, Layer *> &layers,
                               MinOrMax minOrMax,
                               String variableName,
                               unsigned lastLayer = UINT_MAX );
 
-    void addLayerToModel( GurobiWrapper &gurobi, const Layer *layer, bool createVariables );
+    template <class LPSolver>
+    void addLayerToModel( LPSolver &solver, const Layer *layer, bool createVariables );
 
 private:
     LayerOwner *_layerOwner;
     bool _cutoffInUse;
     double _cutoffValue;
 
-    void addInputLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer );
+    /*
+      The solver for the LP relaxations: Gurobi, or the native simplex
+      solver if Gurobi is not available or not requested
+    */
+    LPSolverType _lpSolverType;
 
-    void
-    addReluLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer, bool createVariables );
+    const std::atomic_bool *_quitRequested;
 
-    void addLeakyReluLayerToLpRelaxation( GurobiWrapper &gurobi,
-                                          const Layer *layer,
-                                          bool createVariables );
+    /*
+      The worker threads, created on first use and sized by the number of
+      workers, and one LP solver per worker. The solvers and their models
+      are kept across neurons and layers, and across calls.
+    */
+    unsigned _numberOfWorkers;
+    std::unique_ptr<ThreadPool> _threadPool;
+    Vector<GurobiWrapper *> _gurobiSolvers;
+    Vector<SimplexSolver *> _simplexSolvers;
+
+    template <class LPSolver>
+    Vector<LPSolver *> &getWorkerSolvers();
+    bool quitRequested() const;
+
+    /*
+      The bound on the optimal value of the last solve, once the solver
+      reported an optimum. For the native solver, this is the bound proven
+      by its multipliers rather than the value of its final vertex.
+    */
+    template <class LPSolver>
+    static double getOptimalBound( LPSolver &solver );
 
+    template <class LPSolver>
+    void addInputLayerToLpRelaxation( LPSolver &solver, const Layer *layer );
+
+    template <class LPSolver>
+    void addReluLayerToLpRelaxation( LPSolver &solver, const Layer *layer, bool createVariables );
+
+    template <class LPSolver>
     void
-    addSignLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer, bool createVariables );
+    addLeakyReluLayerToLpRelaxation( LPSolver &solver, const Layer *layer, bool createVariables );
+
+    template <class LPSolver>
+    void addSignLayerToLpRelaxation( LPSolver &solver, const Layer *layer, bool createVariables );
 
+    template <class LPSolver>
+    void addMaxLayerToLpRelaxation( LPSolver &solver, const Layer *layer, bool createVariables );
+
+    template <class LPSolver>
     void
-    addMaxLayerToLpRelaxation( GurobiWrapper &gurobi, const Layer *layer, bool createVariables );
+    addWeightedSumLayerToLpRelaxation( LPSolver &solver, const Layer *layer, bool createVariables );
 
-    void addWeightedSumLayerToLpRelaxation( GurobiWrapper &gurobi,
-                                            const Layer *layer,
-                                            bool createVariables );
+    template <class LPSolver>
+    void optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                    LPSolver &solver );
 
-    void optimizeBoundsOfNeuronsWithLpRlaxation( ThreadArgument &args, bool backward );
+    /*
+      Optimize the bounds of the neurons of the target layers, one layer
+      after the other. The neurons of a layer are tasks for the thread
+      pool, and every worker solves its tasks over its own model. The
+      relaxation of a target layer covers the layers up to the target,
+      all layers if wholeNetwork is set, or the layers after the target if
+      backward is set. In a forward pass, a worker's model is extended
+      with the new layers instead of being rebuilt.
+    */
+    template <class LPSolver>
+    void optimizeBoundsOfLayersWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                 const List<unsigned> &targetIndices,
+                                                 bool backward,
+                                                 bool wholeNetwork );
 
     /*
-      Optimize for the min/max value of variableName with respect to the constraints
-      encoded in gurobi. If the query is infeasible, *infeasible is set to true.
+      Prepare the model of a worker for the given target layer: encode it
+      from scratch, or extend the model of a preceding target layer, whose
+      bounds may have been tightened since it was encoded
     */
-    static double optimizeWithGurobi( GurobiWrapper &gurobi,
-                                      MinOrMax minOrMax,
-                                      String variableName,
-                                      double cutoffValue,
-                                      std::atomic_bool *infeasible = NULL );
+    template <class LPSolver>
+    void prepareWorkerModel( const Map<unsigned, Layer *> &layers,
+                             LPSolver &solver,
+                             unsigned &lastEncodedLayer,
+                             unsigned targetIndex,
+                             bool backward,
+                             bool wholeNetwork );
 
     /*
-      Tighten the upper- and lower- bound of a varaible with LPRelaxation
+      Use the simulations of the target layer to decide whether the
+      lower or upper bound of a neuron can be skipped: if the bound is on
+      the same side of the cutoff value as some simulated value, it can
+      not cross it.
+    */
+    void checkSimulationsForCutoff( unsigned targetIndex,
+                                    unsigned neuron,
+                                    bool &skipTightenLb,
+                                    bool &skipTightenUb ) const;
+
+    /*
+      Optimize for the min/max value of variableName with respect to the constraints
+      encoded in the solver. If the query is infeasible, *infeasible is set to true.
     */
-    static void tightenSingleVariableBoundsWithLPRelaxation( ThreadArgument &argument );
+    template <class LPSolver>
+    static double optimizeWithLpSolver( LPSolver &solver,
+                                        MinOrMax minOrMax,
+                                        String variableName,
+                                        double cutoffValue,
+                                        std::atomic_bool *infeasible = NULL );
 };
 
 } // namespace NLR
@@ -15,11 +15,14 @@
 
 #include "Layer.h"
 
+#include "GlobalConfiguration.h"
 #include "Options.h"
 #include "Query.h"
 #include "SoftmaxConstraint.h"
 #include "SymbolicBoundTighteningType.h"
 
+#include <limits>
+
 namespace NLR {
 
 Layer::~Layer()
@@ -44,6 +47,8 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _inputLayerSize( 0 )
     , _symbolicLb( NULL )
     , _symbolicUb( NULL )
+    , _singleSymbolicLb( NULL )
+    , _singleSymbolicUb( NULL )
     , _symbolicLowerBias( NULL )
     , _symbolicUpperBias( NULL )
     , _symbolicLbOfLb( NULL )
@@ -70,19 +75,10 @@ void Layer::allocateMemory()
 
     _assignment = new double[_size];
 
-    _simulations.assign(
-        _size, Vector<double>( Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS ) ) );
-
     _inputLayerSize = ( _type == INPUT ) ? _size : _layerOwner->getLayer( 0 )->getSize();
     if ( Options::get()->getSymbolicBoundTighteningType() ==
          SymbolicBoundTighteningType::SYMBOLIC_BOUND_TIGHTENING )
     {
-        _symbolicLb = new double[_size * _inputLayerSize];
-        _symbolicUb = new double[_size * _inputLayerSize];
-
-        std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
-        std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
-
         _symbolicLowerBias = new double[_size];
         _symbolicUpperBias = new double[_size];
 
@@ -117,16 +113,6 @@ double Layer::getAssignment( unsigned neuron ) const
     return _assignment[neuron];
 }
 
-void Layer::setSimulations( const Vector<Vector<double>> *values )
-{
-    _simulations = *values;
-}
-
-const Vector<Vector<double>> *Layer::getSimulations() const
-{
-    return &_simulations;
-}
-
 void Layer::computeAssignment()
 {
     ASSERT( _type != INPUT );
@@ -142,6 +128,22 @@ void Layer::computeAssignment()
             const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
             const double *sourceAssignment = sourceLayer->getAssignment();
             unsigned sourceSize = sourceLayerEntry.second;
+
+            if ( _layerToSparseWeights.exists( sourceLayerEntry.first ) )
+            {
+                const SparseWeightMatrix *weights = _layerToSparseWeights[sourceLayerEntry.first];
+                const unsigned *sources = weights->getSources();
+                const double *values = weights->getWeights();
+
+                for ( unsigned j = 0; j < _size; ++j )
+                {
+                    unsigned end = weights->getTargetEnd( j );
+                    for ( unsigned k = weights->getTargetBegin( j ); k < end; ++k )
+                        _assignment[j] += ( sourceAssignment[sources[k]] * values[k] );
+                }
+                continue;
+            }
+
             const double *weights = _layerToWeights[sourceLayerEntry.first];
 
             for ( unsigned i = 0; i < sourceSize; ++i )
@@ -289,133 +291,286 @@ void Layer::computeAssignment()
         _assignment[eliminated.first] = eliminated.second;
 }
 
-void Layer::computeSimulations()
+void Layer::setBatchAssignment( const double *values, unsigned batchSize )
+{
+    ASSERT( _eliminatedNeurons.empty() );
+    if ( _batchAssignment.size() != batchSize * _size )
+        _batchAssignment.assign( batchSize * _size, 0 );
+    memcpy( _batchAssignment.data(), values, batchSize * _size * sizeof( double ) );
+}
+
+const double *Layer::getBatchAssignment() const
+{
+    return _batchAssignment.data();
+}
+
+void Layer::computeBatchAssignment( unsigned batchSize, ThreadPool *threadPool )
+{
+    computeBatch( &Layer::_batchAssignment, batchSize, threadPool );
+}
+
+void Layer::setSimulations( const double *values, unsigned numberOfSimulations )
+{
+    if ( _simulations.size() != numberOfSimulations * _size )
+        _simulations.assign( numberOfSimulations * _size, 0 );
+    memcpy( _simulations.data(), values, numberOfSimulations * _size * sizeof( double ) );
+}
+
+void Layer::computeSimulations( ThreadPool *threadPool )
+{
+    ASSERT( !_sourceLayers.empty() );
+    const Layer *sourceLayer = _layerOwner->getLayer( _sourceLayers.begin()->first );
+    computeBatch( &Layer::_simulations, sourceLayer->getNumberOfSimulations(), threadPool );
+}
+
+const double *Layer::getSimulations() const
+{
+    return _simulations.data();
+}
+
+unsigned Layer::getNumberOfSimulations() const
+{
+    return _size > 0 ? _simulations.size() / _size : 0;
+}
+
+void Layer::computeBatch( BatchBuffer buffer, unsigned batchSize, ThreadPool *threadPool )
 {
     ASSERT( _type != INPUT );
 
-    unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
+    Vector<double> &values = this->*buffer;
+    if ( values.size() != batchSize * _size )
+        values.assign( batchSize * _size, 0 );
+
     if ( _type == WEIGHTED_SUM )
+        computeBatchForWeightedSum( buffer, batchSize, threadPool );
+    else if ( _type == RELU || _type == ROUND || _type == LEAKY_RELU ||
+              _type == ABSOLUTE_VALUE || _type == SIGN || _type == SIGMOID )
+        computeBatchForSingleSource( buffer, batchSize, threadPool );
+    else if ( _type == MAX || _type == SOFTMAX || _type == BILINEAR )
+        computeBatchForMultipleSources( buffer, batchSize, threadPool );
+    else
     {
-        // Process each of the source layers
-        for ( auto &sourceLayerEntry : _sourceLayers )
-        {
-            const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
-            const Vector<Vector<double>> *sourceSimulations = sourceLayer->getSimulations();
+        printf( "Error! Neuron type %u unsupported\n", _type );
+        throw MarabouError( MarabouError::NETWORK_LEVEL_REASONER_ACTIVATION_NOT_SUPPORTED );
+    }
 
-            unsigned sourceSize = sourceLayerEntry.second;
-            const double *weights = _layerToWeights[sourceLayerEntry.first];
+    // Eliminated variables supersede anything else, as in
+    // computeAssignment()
+    double *output = values.data();
+    for ( const auto &eliminated : _eliminatedNeurons )
+        for ( unsigned b = 0; b < batchSize; ++b )
+            output[b * _size + eliminated.first] = eliminated.second;
+}
 
-            for ( unsigned i = 0; i < _size; i++ )
-            {
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    _simulations[i][j] = _bias[i];
-            }
+void Layer::forEachSampleBlock( unsigned batchSize,
+                                ThreadPool *threadPool,
+                                const std::function<void( unsigned, unsigned )> &process ) const
+{
+    unsigned numBlocks = 1;
+    if ( threadPool && batchSize * _size >= GlobalConfiguration::NLR_PARALLEL_BATCH_MIN_SIZE )
+        numBlocks = std::min( batchSize, threadPool->getNumThreads() );
 
-            for ( unsigned i = 0; i < sourceSize; ++i )
-                for ( unsigned j = 0; j < simulationSize; ++j )
-                    for ( unsigned k = 0; k < _size; ++k )
-                        _simulations[k][j] +=
-                            ( ( *sourceSimulations ).get( i ).get( j ) * weights[i * _size + k] );
-        }
+    if ( numBlocks <= 1 )
+    {
+        process( 0, batchSize );
+        return;
     }
-    else if ( _type == RELU )
+
+    unsigned blockSize = ( batchSize + numBlocks - 1 ) / numBlocks;
+    threadPool->run( numBlocks, [&]( unsigned block, unsigned ) {
+        unsigned begin = block * blockSize;
+        unsigned end = std::min( begin + blockSize, batchSize );
+        if ( begin < end )
+            process( begin, end );
+    } );
+}
+
+void Layer::computeBatchForWeightedSum( BatchBuffer buffer,
+                                        unsigned batchSize,
+                                        ThreadPool *threadPool )
+{
+    double *output = ( this->*buffer ).data();
+
+    // Initialize to bias
+    for ( unsigned b = 0; b < batchSize; ++b )
+        memcpy( output + b * _size, _bias, sizeof( double ) * _size );
+
+    // Process each of the source layers. With dense weights, the batch of
+    // source values (batchSize x sourceSize) is multiplied by the
+    // source-major weight matrix (sourceSize x _size) in a single product.
+    for ( auto &sourceLayerEntry : _sourceLayers )
     {
-        for ( unsigned i = 0; i < _size; ++i )
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
+        const double *sourceValues = ( sourceLayer->*buffer ).data();
+        unsigned sourceSize = sourceLayerEntry.second;
+
+        if ( _layerToSparseWeights.exists( sourceLayerEntry.first ) )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) )
-                    .get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::max( simulations.get( j ), 0 );
+            const SparseWeightMatrix *weights = _layerToSparseWeights[sourceLayerEntry.first];
+            const unsigned *sources = weights->getSources();
+            const double *values = weights->getWeights();
+
+            forEachSampleBlock( batchSize, threadPool, [&]( unsigned begin, unsigned end ) {
+                for ( unsigned b = begin; b < end; ++b )
+                {
+                    const double *sourceRow = sourceValues + b * sourceSize;
+                    double *row = output + b * _size;
+                    for ( unsigned j = 0; j < _size; ++j )
+                    {
+                        unsigned entriesEnd = weights->getTargetEnd( j );
+                        for ( unsigned k = weights->getTargetBegin( j ); k < entriesEnd; ++k )
+                            row[j] += ( sourceRow[sources[k]] * values[k] );
+                    }
+                }
+            } );
+            continue;
         }
+
+        matrixMultiplication( sourceValues,
+                              _layerToWeights[sourceLayerEntry.first],
+                              output,
+                              batchSize,
+                              sourceSize,
+                              _size );
     }
-    else if ( _type == LEAKY_RELU )
+}
+
+void Layer::computeBatchForSingleSource( BatchBuffer buffer,
+                                         unsigned batchSize,
+                                         ThreadPool *threadPool )
+{
+    double *output = ( this->*buffer ).data();
+
+    /*
+      Gather the input of every neuron into the output buffer. When all
+      neurons are fed, in order, by a source layer of the same size, whole
+      blocks of samples are copied at once.
+    */
+    Vector<const double *> sourceValues( _size );
+    Vector<unsigned> sourceSizes( _size );
+    bool inOrder = true;
+    for ( unsigned i = 0; i < _size; ++i )
     {
-        for ( unsigned i = 0; i < _size; ++i )
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+        sourceValues[i] = ( sourceLayer->*buffer ).data() + sourceIndex._neuron;
+        sourceSizes[i] = sourceLayer->getSize();
+        inOrder = inOrder && sourceSizes[i] == _size && sourceValues[i] == sourceValues[0] + i;
+    }
+
+    ASSERT( _type != LEAKY_RELU || ( _alpha > 0 && _alpha < 1 ) );
+
+    forEachSampleBlock( batchSize, threadPool, [&]( unsigned begin, unsigned end ) {
+        double *blockOutput = output + begin * _size;
+        unsigned blockSize = ( end - begin ) * _size;
+
+        if ( inOrder )
+            memcpy( blockOutput, sourceValues[0] + begin * _size, sizeof( double ) * blockSize );
+        else
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) )
-                    .get( sourceIndex._neuron );
-            ASSERT( _alpha > 0 && _alpha < 1 );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] =
-                    FloatUtils::max( simulations.get( j ), _alpha * simulations.get( j ) );
+            for ( unsigned b = begin; b < end; ++b )
+                for ( unsigned i = 0; i < _size; ++i )
+                    output[b * _size + i] = sourceValues[i][b * sourceSizes[i]];
         }
-    }
-    else if ( _type == ABSOLUTE_VALUE )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
+
+        // Apply the activation function over the contiguous block
+        if ( _type == RELU )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) )
-                    .get( sourceIndex._neuron );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::abs( simulations.get( j ) );
+            for ( unsigned i = 0; i < blockSize; ++i )
+                blockOutput[i] = FloatUtils::max( blockOutput[i], 0 );
         }
-    }
-    else if ( _type == MAX )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
+        else if ( _type == ROUND )
         {
-            for ( unsigned j = 0; j < simulationSize; ++j )
-            {
-                _simulations[i][j] = FloatUtils::negativeInfinity();
-
-                for ( const auto &input : _neuronToActivationSources[i] )
-                {
-                    // double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() )
-                    // )[input._neuron][j];
-                    double value = ( *( _layerOwner->getLayer( input._layer )->getSimulations() ) )
-                                       .get( input._neuron )
-                                       .get( j );
-                    if ( value > _simulations[i][j] )
-                        _simulations[i][j] = value;
-                }
-            }
+            for ( unsigned i = 0; i < blockSize; ++i )
+                blockOutput[i] = FloatUtils::round( blockOutput[i] );
         }
-    }
-    else if ( _type == SIGN )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
+        else if ( _type == LEAKY_RELU )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = FloatUtils::isNegative( simulations.get( j ) ) ? -1 : 1;
+            for ( unsigned i = 0; i < blockSize; ++i )
+                blockOutput[i] = FloatUtils::max( blockOutput[i], _alpha * blockOutput[i] );
         }
-    }
-    else if ( _type == SIGMOID )
-    {
-        for ( unsigned i = 0; i < _size; ++i )
+        else if ( _type == ABSOLUTE_VALUE )
         {
-            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
-            const Vector<double> &simulations =
-                ( *( _layerOwner->getLayer( sourceIndex._layer )->getSimulations() ) ).get( i );
-            for ( unsigned j = 0; j < simulationSize; ++j )
-                _simulations[i][j] = 1 / ( 1 + std::exp( -simulations.get( j ) ) );
+            for ( unsigned i = 0; i < blockSize; ++i )
+                blockOutput[i] = FloatUtils::abs( blockOutput[i] );
         }
-    }
-    else
-    {
-        printf( "Error! Neuron type %u unsupported\n", _type );
-        throw MarabouError( MarabouError::NETWORK_LEVEL_REASONER_ACTIVATION_NOT_SUPPORTED );
-    }
+        else if ( _type == SIGN )
+        {
+            for ( unsigned i = 0; i < blockSize; ++i )
+                blockOutput[i] = FloatUtils::isNegative( blockOutput[i] ) ? -1 : 1;
+        }
+        else if ( _type == SIGMOID )
+        {
+            for ( unsigned i = 0; i < blockSize; ++i )
+                blockOutput[i] = 1 / ( 1 + std::exp( -blockOutput[i] ) );
+        }
+    } );
+}
 
-    // Eliminated variables supersede anything else - no matter what
-    // was computed due to left-over weights, etc, their set values
-    // prevail.
-    for ( const auto &eliminated : _eliminatedNeurons )
+void Layer::computeBatchForMultipleSources( BatchBuffer buffer,
+                                            unsigned batchSize,
+                                            ThreadPool *threadPool )
+{
+    double *output = ( this->*buffer ).data();
+
+    // The sources of neuron i are entries sourceStart[i] up to
+    // sourceStart[i + 1] of sourceValues and sourceSizes
+    Vector<const double *> sourceValues;
+    Vector<unsigned> sourceSizes;
+    Vector<unsigned> sourceStart;
+    Vector<unsigned> outputIndex( _size, 0 );
+    for ( unsigned i = 0; i < _size; ++i )
     {
-        for ( unsigned j = 0; j < simulationSize; ++j )
-            _simulations[eliminated.first][j] = eliminated.second;
+        sourceStart.append( sourceValues.size() );
+        for ( const auto &input : _neuronToActivationSources[i] )
+        {
+            if ( input._neuron == i )
+                outputIndex[i] = sourceValues.size() - sourceStart[i];
+            const Layer *sourceLayer = _layerOwner->getLayer( input._layer );
+            sourceValues.append( ( sourceLayer->*buffer ).data() + input._neuron );
+            sourceSizes.append( sourceLayer->getSize() );
+        }
     }
+    sourceStart.append( sourceValues.size() );
+
+    forEachSampleBlock( batchSize, threadPool, [&]( unsigned begin, unsigned end ) {
+        Vector<double> inputs;
+        Vector<double> outputs;
+        for ( unsigned b = begin; b < end; ++b )
+        {
+            for ( unsigned i = 0; i < _size; ++i )
+            {
+                double &result = output[b * _size + i];
+                if ( _type == MAX )
+                {
+                    result = FloatUtils::negativeInfinity();
+                    for ( unsigned k = sourceStart[i]; k < sourceStart[i + 1]; ++k )
+                    {
+                        double value = sourceValues[k][b * sourceSizes[k]];
+                        if ( value > result )
+                            result = value;
+                    }
+                }
+                else if ( _type == SOFTMAX )
+                {
+                    inputs.clear();
+                    for ( unsigned k = sourceStart[i]; k < sourceStart[i + 1]; ++k )
+                        inputs.append( sourceValues[k][b * sourceSizes[k]] );
+                    SoftmaxConstraint::softmax( inputs, outputs );
+                    result = outputs[outputIndex[i]];
+                }
+                else if ( _type == BILINEAR )
+                {
+                    result = 1;
+                    for ( unsigned k = sourceStart[i]; k < sourceStart[i + 1]; ++k )
+                        result *= sourceValues[k][b * sourceSizes[k]];
+                }
+            }
+        }
+    } );
 }
 
-void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
+void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize, bool sparseWeights )
 {
     ASSERT( _type != INPUT );
 
@@ -424,7 +579,11 @@ void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 
     _sourceLayers[layerNumber] = layerSize;
 
-    if ( _type == WEIGHTED_SUM )
+    if ( _type == WEIGHTED_SUM && sparseWeights )
+    {
+        _layerToSparseWeights[layerNumber] = new SparseWeightMatrix( layerSize, _size );
+    }
+    else if ( _type == WEIGHTED_SUM )
     {
         _layerToWeights[layerNumber] = new double[layerSize * _size];
         _layerToPositiveWeights[layerNumber] = new double[layerSize * _size];
@@ -454,6 +613,7 @@ const Set<unsigned> &Layer::getSuccessorLayers() const
 const double *Layer::getWeightMatrix( unsigned sourceLayer ) const
 {
     ASSERT( _layerToWeights.exists( sourceLayer ) );
+    ASSERT( !_layerToSparseWeights.exists( sourceLayer ) );
     return _layerToWeights[sourceLayer];
 }
 
@@ -461,11 +621,19 @@ void Layer::removeSourceLayer( unsigned sourceLayer )
 {
     ASSERT( _sourceLayers.exists( sourceLayer ) );
 
+    _sourceLayers.erase( sourceLayer );
+
+    if ( _layerToSparseWeights.exists( sourceLayer ) )
+    {
+        delete _layerToSparseWeights[sourceLayer];
+        _layerToSparseWeights.erase( sourceLayer );
+        return;
+    }
+
     delete[] _layerToWeights[sourceLayer];
     delete[] _layerToPositiveWeights[sourceLayer];
     delete[] _layerToNegativeWeights[sourceLayer];
 
-    _sourceLayers.erase( sourceLayer );
     _layerToWeights.erase( sourceLayer );
     _layerToPositiveWeights.erase( sourceLayer );
     _layerToNegativeWeights.erase( sourceLayer );
@@ -476,6 +644,12 @@ void Layer::setWeight( unsigned sourceLayer,
                        unsigned targetNeuron,
                        double weight )
 {
+    if ( _layerToSparseWeights.exists( sourceLayer ) )
+    {
+        _layerToSparseWeights[sourceLayer]->set( sourceNeuron, targetNeuron, weight );
+        return;
+    }
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     _layerToWeights[sourceLayer][index] = weight;
 
@@ -493,25 +667,42 @@ void Layer::setWeight( unsigned sourceLayer,
 
 double Layer::getWeight( unsigned sourceLayer, unsigned sourceNeuron, unsigned targetNeuron ) const
 {
+    if ( _layerToSparseWeights.exists( sourceLayer ) )
+        return _layerToSparseWeights[sourceLayer]->get( sourceNeuron, targetNeuron );
+
     unsigned index = sourceNeuron * _size + targetNeuron;
     return _layerToWeights[sourceLayer][index];
 }
 
 double *Layer::getWeights( unsigned sourceLayerIndex ) const
 {
+    ASSERT( !_layerToSparseWeights.exists( sourceLayerIndex ) );
     return _layerToWeights[sourceLayerIndex];
 }
 
 double *Layer::getPositiveWeights( unsigned sourceLayerIndex ) const
 {
+    ASSERT( !_layerToSparseWeights.exists( sourceLayerIndex ) );
     return _layerToPositiveWeights[sourceLayerIndex];
 }
 
 double *Layer::getNegativeWeights( unsigned sourceLayerIndex ) const
 {
+    ASSERT( !_layerToSparseWeights.exists( sourceLayerIndex ) );
     return _layerToNegativeWeights[sourceLayerIndex];
 }
 
+bool Layer::hasSparseWeights( unsigned sourceLayerIndex ) const
+{
+    return _layerToSparseWeights.exists( sourceLayerIndex );
+}
+
+const SparseWeightMatrix *Layer::getSparseWeights( unsigned sourceLayerIndex ) const
+{
+    ASSERT( _layerToSparseWeights.exists( sourceLayerIndex ) );
+    return _layerToSparseWeights[sourceLayerIndex];
+}
+
 void Layer::setBias( unsigned neuron, double bias )
 {
     _bias[neuron] = bias;
@@ -693,6 +884,37 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         unsigned sourceLayerIndex = sourceLayerEntry.first;
         unsigned sourceLayerSize = sourceLayerEntry.second;
         const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerIndex );
+
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            const SparseWeightMatrix *weights = _layerToSparseWeights[sourceLayerIndex];
+            const unsigned *sources = weights->getSources();
+            const double *values = weights->getWeights();
+
+            for ( unsigned i = 0; i < _size; ++i )
+            {
+                unsigned end = weights->getTargetEnd( i );
+                for ( unsigned k = weights->getTargetBegin( i ); k < end; ++k )
+                {
+                    double previousLb = sourceLayer->getLb( sources[k] );
+                    double previousUb = sourceLayer->getUb( sources[k] );
+                    double weight = values[k];
+
+                    if ( weight > 0 )
+                    {
+                        newLb[i] += weight * previousLb;
+                        newUb[i] += weight * previousUb;
+                    }
+                    else
+                    {
+                        newLb[i] += weight * previousUb;
+                        newUb[i] += weight * previousLb;
+                    }
+                }
+            }
+            continue;
+        }
+
         const double *weights = _layerToWeights[sourceLayerIndex];
 
         for ( unsigned i = 0; i < _size; ++i )
@@ -867,6 +1089,8 @@ void Layer::computeIntervalArithmeticBoundsForSign()
 
 void Layer::computeSymbolicBounds()
 {
+    allocateSymbolicBounds();
+
     switch ( _type )
     {
     case INPUT:
@@ -889,6 +1113,26 @@ void Layer::computeSymbolicBounds()
         computeSymbolicBoundsForAbsoluteValue();
         break;
 
+    case LEAKY_RELU:
+        computeSymbolicBoundsForLeakyRelu();
+        break;
+
+    case SIGMOID:
+        computeSymbolicBoundsForSigmoid();
+        break;
+
+    case ROUND:
+        computeSymbolicBoundsForRound();
+        break;
+
+    case MAX:
+        computeSymbolicBoundsForMax();
+        break;
+
+    case BILINEAR:
+        computeSymbolicBoundsForBilinear();
+        break;
+
     default:
         computeSymbolicBoundsDefault();
         break;
@@ -1007,15 +1251,13 @@ void Layer::computeSymbolicBoundsForRelu()
           for its input variable
         */
         unsigned sourceLayerSize = sourceLayer->getSize();
-        const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
-        const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
 
         for ( unsigned j = 0; j < _inputLayerSize; ++j )
         {
             _symbolicLb[j * _size + i] =
-                sourceSymbolicLb[j * sourceLayerSize + sourceIndex._neuron];
+                sourceLayer->getSymbolicLbEntry( j * sourceLayerSize + sourceIndex._neuron );
             _symbolicUb[j * _size + i] =
-                sourceSymbolicUb[j * sourceLayerSize + sourceIndex._neuron];
+                sourceLayer->getSymbolicUbEntry( j * sourceLayerSize + sourceIndex._neuron );
         }
         _symbolicLowerBias[i] = sourceLayer->getSymbolicLowerBias()[sourceIndex._neuron];
         _symbolicUpperBias[i] = sourceLayer->getSymbolicUpperBias()[sourceIndex._neuron];
@@ -1175,15 +1417,13 @@ void Layer::computeSymbolicBoundsForSign()
           for its input variable
         */
         unsigned sourceLayerSize = sourceLayer->getSize();
-        const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
-        const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
 
         for ( unsigned j = 0; j < _inputLayerSize; ++j )
         {
             _symbolicLb[j * _size + i] =
-                sourceSymbolicLb[j * sourceLayerSize + sourceIndex._neuron];
+                sourceLayer->getSymbolicLbEntry( j * sourceLayerSize + sourceIndex._neuron );
             _symbolicUb[j * _size + i] =
-                sourceSymbolicUb[j * sourceLayerSize + sourceIndex._neuron];
+                sourceLayer->getSymbolicUbEntry( j * sourceLayerSize + sourceIndex._neuron );
         }
         _symbolicLowerBias[i] = sourceLayer->getSymbolicLowerBias()[sourceIndex._neuron];
         _symbolicUpperBias[i] = sourceLayer->getSymbolicUpperBias()[sourceIndex._neuron];
@@ -1347,15 +1587,13 @@ void Layer::computeSymbolicBoundsForAbsoluteValue()
         const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
 
         unsigned sourceLayerSize = sourceLayer->getSize();
-        const double *sourceSymbolicLb = sourceLayer->getSymbolicLb();
-        const double *sourceSymbolicUb = sourceLayer->getSymbolicUb();
 
         for ( unsigned j = 0; j < _inputLayerSize; ++j )
         {
             _symbolicLb[j * _size + i] =
-                sourceSymbolicLb[j * sourceLayerSize + sourceIndex._neuron];
+                sourceLayer->getSymbolicLbEntry( j * sourceLayerSize + sourceIndex._neuron );
             _symbolicUb[j * _size + i] =
-                sourceSymbolicUb[j * sourceLayerSize + sourceIndex._neuron];
+                sourceLayer->getSymbolicUbEntry( j * sourceLayerSize + sourceIndex._neuron );
         }
 
         _symbolicLowerBias[i] = sourceLayer->getSymbolicLowerBias()[sourceIndex._neuron];
@@ -1452,8 +1690,10 @@ void Layer::computeSymbolicBoundsForAbsoluteValue()
     }
 }
 
-void Layer::computeSymbolicBoundsForWeightedSum()
+void Layer::computeSymbolicBoundsForLeakyRelu()
 {
+    ASSERT( _alpha > 0 && _alpha < 1 );
+
     std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
     std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
 
@@ -1461,58 +1701,387 @@ void Layer::computeSymbolicBoundsForWeightedSum()
     {
         if ( _eliminatedNeurons.exists( i ) )
         {
-            _symbolicLowerBias[i] = _eliminatedNeurons[i];
-            _symbolicUpperBias[i] = _eliminatedNeurons[i];
+            setSymbolicBoundsToConstants( i, _eliminatedNeurons[i], _eliminatedNeurons[i] );
+            continue;
+        }
 
-            _symbolicLbOfLb[i] = _eliminatedNeurons[i];
-            _symbolicUbOfLb[i] = _eliminatedNeurons[i];
-            _symbolicLbOfUb[i] = _eliminatedNeurons[i];
-            _symbolicUbOfUb[i] = _eliminatedNeurons[i];
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+        double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+        double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+
+        if ( !FloatUtils::isNegative( sourceLb ) )
+        {
+            // Active phase, the bounds are propagated as is
+            setSymbolicBoundsToConstants( i, 0, 0 );
+            addSymbolicBoundsOfSource( i, sourceIndex, 1, 1 );
+        }
+        else if ( !FloatUtils::isPositive( sourceUb ) )
+        {
+            // Inactive phase, the bounds are scaled by alpha
+            setSymbolicBoundsToConstants( i, 0, 0 );
+            addSymbolicBoundsOfSource( i, sourceIndex, _alpha, _alpha );
+        }
+        else if ( !FloatUtils::isFinite( sourceLb ) || !FloatUtils::isFinite( sourceUb ) )
+        {
+            // Unbounded source, keep the current concrete bounds
+            setSymbolicBoundsToConstants( i, _lb[i], _ub[i] );
+            continue;
         }
         else
         {
-            _symbolicLowerBias[i] = _bias[i];
-            _symbolicUpperBias[i] = _bias[i];
+            /*
+              The phase is not fixed. As in DeepPoly, the upper bound
+              is the line through (lb, alpha * lb) and (ub, ub), and
+              the lower bound is either alpha * x or x, whichever
+              gives the smaller relaxation.
+            */
+            double width = sourceUb - sourceLb;
+            double upperCoefficient = ( sourceUb - _alpha * sourceLb ) / width;
+            double upperBias = ( _alpha - 1 ) * sourceUb * sourceLb / width;
+            double lowerCoefficient = ( sourceUb > -sourceLb ) ? 1 : _alpha;
+
+            setSymbolicBoundsToConstants( i, 0, upperBias );
+            addSymbolicBoundsOfSource( i, sourceIndex, lowerCoefficient, upperCoefficient );
         }
-    }
 
-    for ( const auto &sourceLayerEntry : _sourceLayers )
-    {
-        unsigned sourceLayerIndex = sourceLayerEntry.first;
-        unsigned sourceLayerSize = sourceLayerEntry.second;
-        const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
+        concretizeSymbolicBounds( i );
 
-        /*
-          Perform the multiplication
+        // LeakyReLU is monotone, so its range over the source's bounds also holds
+        storeSymbolicBounds( i,
+                             FloatUtils::max( _symbolicLbOfLb[i],
+                                              FloatUtils::max( sourceLb, _alpha * sourceLb ) ),
+                             FloatUtils::min( _symbolicUbOfUb[i],
+                                              FloatUtils::max( sourceUb, _alpha * sourceUb ) ) );
+    }
+}
 
-          newUB = oldUB * posWeights + oldLB * negWeights
-          newLB = oldUB * negWeights + oldLB * posWeights
-        */
+void Layer::computeSymbolicBoundsForSigmoid()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
 
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicUb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicLb(),
-                              _layerToPositiveWeights[sourceLayerIndex],
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
-        matrixMultiplication( sourceLayer->getSymbolicUb(),
-                              _layerToNegativeWeights[sourceLayerIndex],
-                              _symbolicLb,
-                              _inputLayerSize,
-                              sourceLayerSize,
-                              _size );
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            setSymbolicBoundsToConstants( i, _eliminatedNeurons[i], _eliminatedNeurons[i] );
+            continue;
+        }
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+        double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+        double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+
+        double sigmoidLb = SigmoidConstraint::sigmoid( sourceLb );
+        double sigmoidUb = SigmoidConstraint::sigmoid( sourceUb );
+
+        if ( FloatUtils::areEqual( sourceLb, sourceUb ) || !FloatUtils::isFinite( sourceLb ) ||
+             !FloatUtils::isFinite( sourceUb ) )
+        {
+            setSymbolicBoundsToConstants( i, sigmoidLb, sigmoidUb );
+        }
+        else
+        {
+            /*
+              The relaxation of DeepPoly: the chord between the bounds
+              is a lower bound where the sigmoid is convex (lb > 0), and
+              an upper bound where it is concave (ub <= 0). Otherwise,
+              lines through the end points with the smaller of the two
+              derivatives are used.
+            */
+            double lambda = ( sigmoidUb - sigmoidLb ) / ( sourceUb - sourceLb );
+            double lambdaPrime =
+                FloatUtils::min( SigmoidConstraint::sigmoidDerivative( sourceLb ),
+                                 SigmoidConstraint::sigmoidDerivative( sourceUb ) );
+
+            double lowerCoefficient = FloatUtils::isPositive( sourceLb ) ? lambda : lambdaPrime;
+            double upperCoefficient = !FloatUtils::isPositive( sourceUb ) ? lambda : lambdaPrime;
+
+            setSymbolicBoundsToConstants( i,
+                                          sigmoidLb - lowerCoefficient * sourceLb,
+                                          sigmoidUb - upperCoefficient * sourceUb );
+            addSymbolicBoundsOfSource( i, sourceIndex, lowerCoefficient, upperCoefficient );
+        }
+
+        concretizeSymbolicBounds( i );
+
+        storeSymbolicBounds( i,
+                             FloatUtils::max( _symbolicLbOfLb[i], sigmoidLb ),
+                             FloatUtils::min( _symbolicUbOfUb[i], sigmoidUb ) );
+    }
+}
+
+void Layer::computeSymbolicBoundsForRound()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            setSymbolicBoundsToConstants( i, _eliminatedNeurons[i], _eliminatedNeurons[i] );
+            continue;
+        }
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+        double sourceLbRound = FloatUtils::round( sourceLayer->getLb( sourceIndex._neuron ) );
+        double sourceUbRound = FloatUtils::round( sourceLayer->getUb( sourceIndex._neuron ) );
+
+        if ( FloatUtils::areEqual( sourceLbRound, sourceUbRound ) )
+        {
+            // The round is fixed
+            setSymbolicBoundsToConstants( i, sourceLbRound, sourceUbRound );
+        }
+        else
+        {
+            // x - 0.5 <= round( x ) <= x + 0.5
+            setSymbolicBoundsToConstants( i, -0.5, 0.5 );
+            addSymbolicBoundsOfSource( i, sourceIndex, 1, 1 );
+        }
+
+        concretizeSymbolicBounds( i );
+
+        storeSymbolicBounds( i,
+                             FloatUtils::max( _symbolicLbOfLb[i], sourceLbRound ),
+                             FloatUtils::min( _symbolicUbOfUb[i], sourceUbRound ) );
+    }
+}
+
+void Layer::computeSymbolicBoundsForMax()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            setSymbolicBoundsToConstants( i, _eliminatedNeurons[i], _eliminatedNeurons[i] );
+            continue;
+        }
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        const List<NeuronIndex> &sources = _neuronToActivationSources[i];
+
+        NeuronIndex indexOfMaxLowerBound = *sources.begin();
+        double maxLowerBound = FloatUtils::negativeInfinity();
+        double maxUpperBound = FloatUtils::negativeInfinity();
+
+        for ( const auto &sourceIndex : sources )
+        {
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            double sourceLb = sourceLayer->getLb( sourceIndex._neuron );
+            double sourceUb = sourceLayer->getUb( sourceIndex._neuron );
+
+            if ( maxLowerBound < sourceLb )
+            {
+                indexOfMaxLowerBound = sourceIndex;
+                maxLowerBound = sourceLb;
+            }
+            if ( maxUpperBound < sourceUb )
+                maxUpperBound = sourceUb;
+        }
+
+        /*
+          The phase is fixed if the lower bound of one source is at
+          least the upper bounds of all the others. Then, the max
+          inherits the symbolic bounds of that source. Otherwise, as in
+          DeepPoly, the source with the largest lower bound gives the
+          symbolic lower bound, and the largest upper bound is a
+          constant upper bound.
+        */
+        bool phaseFixed = true;
+        for ( const auto &sourceIndex : sources )
+        {
+            if ( sourceIndex != indexOfMaxLowerBound &&
+                 FloatUtils::gt( _layerOwner->getLayer( sourceIndex._layer )
+                                     ->getUb( sourceIndex._neuron ),
+                                 maxLowerBound ) )
+            {
+                phaseFixed = false;
+                break;
+            }
+        }
+
+        if ( phaseFixed )
+        {
+            setSymbolicBoundsToConstants( i, 0, 0 );
+            addSymbolicBoundsOfSource( i, indexOfMaxLowerBound, 1, 1 );
+        }
+        else
+        {
+            setSymbolicBoundsToConstants( i, 0, maxUpperBound );
+            addSymbolicBoundsOfSource( i, indexOfMaxLowerBound, 1, 0 );
+        }
+
+        concretizeSymbolicBounds( i );
+
+        storeSymbolicBounds( i,
+                             FloatUtils::max( _symbolicLbOfLb[i], maxLowerBound ),
+                             FloatUtils::min( _symbolicUbOfUb[i], maxUpperBound ) );
+    }
+}
+
+void Layer::computeSymbolicBoundsForBilinear()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            setSymbolicBoundsToConstants( i, _eliminatedNeurons[i], _eliminatedNeurons[i] );
+            continue;
+        }
+
+        ASSERT( _neuronToActivationSources.exists( i ) );
+        const List<NeuronIndex> &sources = _neuronToActivationSources[i];
+        ASSERT( sources.size() == 2 );
+
+        NeuronIndex sourceIndices[2];
+        double sourceLbs[2];
+        double sourceUbs[2];
+        unsigned counter = 0;
+        for ( const auto &sourceIndex : sources )
+        {
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            sourceIndices[counter] = sourceIndex;
+            sourceLbs[counter] = sourceLayer->getLb( sourceIndex._neuron );
+            sourceUbs[counter] = sourceLayer->getUb( sourceIndex._neuron );
+            ++counter;
+        }
+
+        double lb = FloatUtils::infinity();
+        double ub = FloatUtils::negativeInfinity();
+        List<double> values = { sourceLbs[0] * sourceLbs[1],
+                                sourceLbs[0] * sourceUbs[1],
+                                sourceUbs[0] * sourceLbs[1],
+                                sourceUbs[0] * sourceUbs[1] };
+        for ( const auto &v : values )
+        {
+            if ( v < lb )
+                lb = v;
+            if ( v > ub )
+                ub = v;
+        }
+
+        if ( !FloatUtils::isFinite( lb ) || !FloatUtils::isFinite( ub ) )
+        {
+            // Unbounded sources, keep the current concrete bounds
+            setSymbolicBoundsToConstants( i, _lb[i], _ub[i] );
+            continue;
+        }
+
+        /*
+          The McCormick relaxation used by DeepPoly, for out = x * y:
+
+            out >= lb_y * x + lb_x * y - lb_x * lb_y
+            out <= ub_y * x + lb_x * y - lb_x * ub_y
+        */
+        setSymbolicBoundsToConstants(
+            i, -sourceLbs[0] * sourceLbs[1], -sourceLbs[0] * sourceUbs[1] );
+        addSymbolicBoundsOfSource( i, sourceIndices[0], sourceLbs[1], sourceUbs[1] );
+        addSymbolicBoundsOfSource( i, sourceIndices[1], sourceLbs[0], sourceLbs[0] );
+
+        concretizeSymbolicBounds( i );
+
+        storeSymbolicBounds( i,
+                             FloatUtils::max( _symbolicLbOfLb[i], lb ),
+                             FloatUtils::min( _symbolicUbOfUb[i], ub ) );
+    }
+}
+
+void Layer::computeSymbolicBoundsForWeightedSum()
+{
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        if ( _eliminatedNeurons.exists( i ) )
+        {
+            _symbolicLowerBias[i] = _eliminatedNeurons[i];
+            _symbolicUpperBias[i] = _eliminatedNeurons[i];
+
+            _symbolicLbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfLb[i] = _eliminatedNeurons[i];
+            _symbolicLbOfUb[i] = _eliminatedNeurons[i];
+            _symbolicUbOfUb[i] = _eliminatedNeurons[i];
+        }
+        else
+        {
+            _symbolicLowerBias[i] = _bias[i];
+            _symbolicUpperBias[i] = _bias[i];
+        }
+    }
+
+    Vector<double> lbBuffer;
+    Vector<double> ubBuffer;
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+    {
+        unsigned sourceLayerIndex = sourceLayerEntry.first;
+        unsigned sourceLayerSize = sourceLayerEntry.second;
+        const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
+
+        if ( _layerToSparseWeights.exists( sourceLayerIndex ) )
+        {
+            computeSymbolicBoundsForSparseWeights(
+                sourceLayer, _layerToSparseWeights[sourceLayerIndex], lbBuffer, ubBuffer );
+            continue;
+        }
+
+        /*
+          Perform the multiplication
+
+          newUB = oldUB * posWeights + oldLB * negWeights
+          newLB = oldUB * negWeights + oldLB * posWeights
+
+          The rows of the source's bounds are processed in blocks, so
+          that bounds stored in single precision are converted to double
+          precision a block at a time.
+        */
+        unsigned rowsPerBlock = sourceLayer->getSymbolicBoundRowsPerBlock();
+        for ( unsigned begin = 0; begin < _inputLayerSize; begin += rowsPerBlock )
+        {
+            unsigned end = std::min( begin + rowsPerBlock, _inputLayerSize );
+            const double *sourceSymbolicLb;
+            const double *sourceSymbolicUb;
+            sourceLayer->getSymbolicBoundRows(
+                begin, end, lbBuffer, ubBuffer, sourceSymbolicLb, sourceSymbolicUb );
+
+            matrixMultiplication( sourceSymbolicUb,
+                                  _layerToPositiveWeights[sourceLayerIndex],
+                                  _symbolicUb + begin * _size,
+                                  end - begin,
+                                  sourceLayerSize,
+                                  _size );
+            matrixMultiplication( sourceSymbolicLb,
+                                  _layerToNegativeWeights[sourceLayerIndex],
+                                  _symbolicUb + begin * _size,
+                                  end - begin,
+                                  sourceLayerSize,
+                                  _size );
+            matrixMultiplication( sourceSymbolicLb,
+                                  _layerToPositiveWeights[sourceLayerIndex],
+                                  _symbolicLb + begin * _size,
+                                  end - begin,
+                                  sourceLayerSize,
+                                  _size );
+            matrixMultiplication( sourceSymbolicUb,
+                                  _layerToNegativeWeights[sourceLayerIndex],
+                                  _symbolicLb + begin * _size,
+                                  end - begin,
+                                  sourceLayerSize,
+                                  _size );
+        }
 
         // Restore the zero bound on eliminated neurons
         unsigned index;
@@ -1565,64 +2134,367 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         if ( _eliminatedNeurons.exists( i ) )
             continue;
 
-        _symbolicLbOfLb[i] = _symbolicLowerBias[i];
-        _symbolicUbOfLb[i] = _symbolicLowerBias[i];
-        _symbolicLbOfUb[i] = _symbolicUpperBias[i];
-        _symbolicUbOfUb[i] = _symbolicUpperBias[i];
+        concretizeSymbolicBounds( i );
 
-        for ( unsigned j = 0; j < _inputLayerSize; ++j )
+        /*
+          We now have the tightest bounds we can for the
+          weighted sum variable. If they are tigheter than
+          what was previously known, store them.
+        */
+        storeSymbolicBounds( i, _symbolicLbOfLb[i], _symbolicUbOfUb[i] );
+    }
+}
+
+void Layer::computeSymbolicBoundsForSparseWeights( const Layer *sourceLayer,
+                                                   const SparseWeightMatrix *weights,
+                                                   Vector<double> &lbBuffer,
+                                                   Vector<double> &ubBuffer )
+{
+    unsigned sourceLayerSize = weights->getSourceSize();
+    const unsigned *sources = weights->getSources();
+    const double *values = weights->getWeights();
+
+    const double *sourceLowerBias = sourceLayer->getSymbolicLowerBias();
+    const double *sourceUpperBias = sourceLayer->getSymbolicUpperBias();
+
+    /*
+      Same as the dense multiplication, but only over the non-zero
+      weights. Eliminated neurons keep their zero symbolic bounds.
+    */
+    unsigned rowsPerBlock = sourceLayer->getSymbolicBoundRowsPerBlock();
+    const double *sourceSymbolicLb = NULL;
+    const double *sourceSymbolicUb = NULL;
+    unsigned blockBegin = 0;
+    for ( unsigned i = 0; i < _inputLayerSize; ++i )
+    {
+        if ( i % rowsPerBlock == 0 )
         {
-            double inputLb = _layerOwner->getLayer( 0 )->getLb( j );
-            double inputUb = _layerOwner->getLayer( 0 )->getUb( j );
+            blockBegin = i;
+            sourceLayer->getSymbolicBoundRows( i,
+                                               std::min( i + rowsPerBlock, _inputLayerSize ),
+                                               lbBuffer,
+                                               ubBuffer,
+                                               sourceSymbolicLb,
+                                               sourceSymbolicUb );
+        }
 
-            double entry = _symbolicLb[j * _size + i];
+        const double *sourceLbRow = sourceSymbolicLb + ( i - blockBegin ) * sourceLayerSize;
+        const double *sourceUbRow = sourceSymbolicUb + ( i - blockBegin ) * sourceLayerSize;
+        double *lbRow = _symbolicLb + i * _size;
+        double *ubRow = _symbolicUb + i * _size;
 
-            if ( entry >= 0 )
-            {
-                _symbolicLbOfLb[i] += ( entry * inputLb );
-                _symbolicUbOfLb[i] += ( entry * inputUb );
-            }
-            else
+        for ( unsigned j = 0; j < _size; ++j )
+        {
+            if ( _eliminatedNeurons.exists( j ) )
+                continue;
+
+            unsigned end = weights->getTargetEnd( j );
+            for ( unsigned k = weights->getTargetBegin( j ); k < end; ++k )
             {
-                _symbolicLbOfLb[i] += ( entry * inputUb );
-                _symbolicUbOfLb[i] += ( entry * inputLb );
+                double weight = values[k];
+                if ( weight > 0 )
+                {
+                    lbRow[j] += sourceLbRow[sources[k]] * weight;
+                    ubRow[j] += sourceUbRow[sources[k]] * weight;
+                }
+                else
+                {
+                    lbRow[j] += sourceUbRow[sources[k]] * weight;
+                    ubRow[j] += sourceLbRow[sources[k]] * weight;
+                }
             }
+        }
+    }
 
-            entry = _symbolicUb[j * _size + i];
+    for ( unsigned j = 0; j < _size; ++j )
+    {
+        if ( _eliminatedNeurons.exists( j ) )
+            continue;
 
-            if ( entry >= 0 )
+        unsigned end = weights->getTargetEnd( j );
+        for ( unsigned k = weights->getTargetBegin( j ); k < end; ++k )
+        {
+            double weight = values[k];
+            if ( weight > 0 )
             {
-                _symbolicLbOfUb[i] += ( entry * inputLb );
-                _symbolicUbOfUb[i] += ( entry * inputUb );
+                _symbolicLowerBias[j] += sourceLowerBias[sources[k]] * weight;
+                _symbolicUpperBias[j] += sourceUpperBias[sources[k]] * weight;
             }
             else
             {
-                _symbolicLbOfUb[i] += ( entry * inputUb );
-                _symbolicUbOfUb[i] += ( entry * inputLb );
+                _symbolicLowerBias[j] += sourceUpperBias[sources[k]] * weight;
+                _symbolicUpperBias[j] += sourceLowerBias[sources[k]] * weight;
             }
         }
+    }
+}
 
-        /*
-          We now have the tightest bounds we can for the
-          weighted sum variable. If they are tigheter than
-          what was previously known, store them.
-        */
-        if ( _lb[i] < _symbolicLbOfLb[i] )
+void Layer::allocateSymbolicBounds()
+{
+    if ( _symbolicLb )
+        return;
+
+    // Bounds that are recomputed replace those stored in single precision
+    freeSymbolicBounds();
+
+    _symbolicLb = new double[_size * _inputLayerSize];
+    _symbolicUb = new double[_size * _inputLayerSize];
+
+    std::fill_n( _symbolicLb, _size * _inputLayerSize, 0 );
+    std::fill_n( _symbolicUb, _size * _inputLayerSize, 0 );
+}
+
+void Layer::freeSymbolicBounds()
+{
+    if ( _symbolicLb )
+    {
+        delete[] _symbolicLb;
+        _symbolicLb = NULL;
+    }
+
+    if ( _symbolicUb )
+    {
+        delete[] _symbolicUb;
+        _symbolicUb = NULL;
+    }
+
+    if ( _singleSymbolicLb )
+    {
+        delete[] _singleSymbolicLb;
+        _singleSymbolicLb = NULL;
+    }
+
+    if ( _singleSymbolicUb )
+    {
+        delete[] _singleSymbolicUb;
+        _singleSymbolicUb = NULL;
+    }
+}
+
+bool Layer::hasSymbolicBounds() const
+{
+    return _symbolicLb || _singleSymbolicLb;
+}
+
+void Layer::storeSymbolicBoundsInSinglePrecision()
+{
+    if ( !_symbolicLb )
+        return;
+
+    // Bounds with coefficients out of the range of floats stay in double precision
+    unsigned entries = _size * _inputLayerSize;
+    for ( unsigned i = 0; i < entries; ++i )
+    {
+        if ( FloatUtils::abs( _symbolicLb[i] ) > std::numeric_limits<float>::max() ||
+             FloatUtils::abs( _symbolicUb[i] ) > std::numeric_limits<float>::max() )
+            return;
+    }
+
+    _singleSymbolicLb = new float[entries];
+    _singleSymbolicUb = new float[entries];
+
+    /*
+      Rounding a coefficient changes the value of a bound by at most the
+      rounding error times the largest magnitude of its input neuron.
+      The lower bias is moved down by the sum of these changes, so that
+      the rounded lower bound stays below the original one, and the
+      upper bias is moved up. The rounded bounds are then within twice
+      this sum of the original ones, and their concrete ranges are
+      widened accordingly.
+    */
+    Vector<double> lowerError( _size, 0 );
+    Vector<double> upperError( _size, 0 );
+    const Layer *inputLayer = _layerOwner->getLayer( 0 );
+    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+    {
+        double magnitude = FloatUtils::max( FloatUtils::abs( inputLayer->getLb( j ) ),
+                                            FloatUtils::abs( inputLayer->getUb( j ) ) );
+
+        for ( unsigned i = 0; i < _size; ++i )
         {
-            _lb[i] = _symbolicLbOfLb[i];
-            _layerOwner->receiveTighterBound(
-                Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            unsigned index = j * _size + i;
+            _singleSymbolicLb[index] = static_cast<float>( _symbolicLb[index] );
+            _singleSymbolicUb[index] = static_cast<float>( _symbolicUb[index] );
+
+            double error = FloatUtils::abs( _symbolicLb[index] - _singleSymbolicLb[index] );
+            if ( error > 0 )
+                lowerError[i] += error * magnitude;
+
+            error = FloatUtils::abs( _symbolicUb[index] - _singleSymbolicUb[index] );
+            if ( error > 0 )
+                upperError[i] += error * magnitude;
         }
+    }
 
-        if ( _ub[i] > _symbolicUbOfUb[i] )
+    for ( unsigned i = 0; i < _size; ++i )
+    {
+        _symbolicLowerBias[i] -= lowerError[i];
+        _symbolicUpperBias[i] += upperError[i];
+
+        _symbolicLbOfLb[i] -= 2 * lowerError[i];
+        _symbolicUbOfUb[i] += 2 * upperError[i];
+    }
+
+    delete[] _symbolicLb;
+    _symbolicLb = NULL;
+    delete[] _symbolicUb;
+    _symbolicUb = NULL;
+}
+
+unsigned Layer::getSymbolicBoundRowsPerBlock() const
+{
+    // Bounds stored in double precision are read in place, all at once
+    if ( _symbolicLb || _size == 0 )
+        return std::max( _inputLayerSize, 1u );
+
+    return std::max( GlobalConfiguration::SYMBOLIC_BOUND_TIGHTENING_CONVERSION_BLOCK_SIZE / _size,
+                     1u );
+}
+
+void Layer::getSymbolicBoundRows( unsigned begin,
+                                  unsigned end,
+                                  Vector<double> &lbBuffer,
+                                  Vector<double> &ubBuffer,
+                                  const double *&lb,
+                                  const double *&ub ) const
+{
+    ASSERT( hasSymbolicBounds() );
+
+    if ( _symbolicLb )
+    {
+        lb = _symbolicLb + begin * _size;
+        ub = _symbolicUb + begin * _size;
+        return;
+    }
+
+    unsigned entries = ( end - begin ) * _size;
+    if ( lbBuffer.size() < entries )
+    {
+        lbBuffer.assign( entries, 0 );
+        ubBuffer.assign( entries, 0 );
+    }
+
+    std::copy( _singleSymbolicLb + begin * _size,
+               _singleSymbolicLb + end * _size,
+               lbBuffer.data() );
+    std::copy( _singleSymbolicUb + begin * _size,
+               _singleSymbolicUb + end * _size,
+               ubBuffer.data() );
+
+    lb = lbBuffer.data();
+    ub = ubBuffer.data();
+}
+
+void Layer::setSymbolicBoundsToConstants( unsigned neuron, double lb, double ub )
+{
+    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+    {
+        _symbolicLb[j * _size + neuron] = 0;
+        _symbolicUb[j * _size + neuron] = 0;
+    }
+
+    _symbolicLowerBias[neuron] = lb;
+    _symbolicUpperBias[neuron] = ub;
+
+    _symbolicLbOfLb[neuron] = lb;
+    _symbolicUbOfLb[neuron] = lb;
+    _symbolicLbOfUb[neuron] = ub;
+    _symbolicUbOfUb[neuron] = ub;
+}
+
+void Layer::addSymbolicBoundsOfSource( unsigned neuron,
+                                       const NeuronIndex &sourceIndex,
+                                       double lowerCoefficient,
+                                       double upperCoefficient )
+{
+    const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+    unsigned sourceLayerSize = sourceLayer->getSize();
+    unsigned sourceNeuron = sourceIndex._neuron;
+
+    /*
+      A positive coefficient scales the source's bound of the same
+      kind, and a negative one scales the opposite bound
+    */
+    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+    {
+        unsigned sourceEntry = j * sourceLayerSize + sourceNeuron;
+        _symbolicLb[j * _size + neuron] +=
+            lowerCoefficient * ( ( lowerCoefficient >= 0 )
+                                     ? sourceLayer->getSymbolicLbEntry( sourceEntry )
+                                     : sourceLayer->getSymbolicUbEntry( sourceEntry ) );
+        _symbolicUb[j * _size + neuron] +=
+            upperCoefficient * ( ( upperCoefficient >= 0 )
+                                     ? sourceLayer->getSymbolicUbEntry( sourceEntry )
+                                     : sourceLayer->getSymbolicLbEntry( sourceEntry ) );
+    }
+
+    _symbolicLowerBias[neuron] +=
+        lowerCoefficient * ( ( lowerCoefficient >= 0 )
+                                 ? sourceLayer->getSymbolicLowerBias()[sourceNeuron]
+                                 : sourceLayer->getSymbolicUpperBias()[sourceNeuron] );
+    _symbolicUpperBias[neuron] +=
+        upperCoefficient * ( ( upperCoefficient >= 0 )
+                                 ? sourceLayer->getSymbolicUpperBias()[sourceNeuron]
+                                 : sourceLayer->getSymbolicLowerBias()[sourceNeuron] );
+}
+
+void Layer::concretizeSymbolicBounds( unsigned neuron )
+{
+    _symbolicLbOfLb[neuron] = _symbolicLowerBias[neuron];
+    _symbolicUbOfLb[neuron] = _symbolicLowerBias[neuron];
+    _symbolicLbOfUb[neuron] = _symbolicUpperBias[neuron];
+    _symbolicUbOfUb[neuron] = _symbolicUpperBias[neuron];
+
+    for ( unsigned j = 0; j < _inputLayerSize; ++j )
+    {
+        double inputLb = _layerOwner->getLayer( 0 )->getLb( j );
+        double inputUb = _layerOwner->getLayer( 0 )->getUb( j );
+
+        double entry = _symbolicLb[j * _size + neuron];
+
+        if ( entry >= 0 )
         {
-            _ub[i] = _symbolicUbOfUb[i];
-            _layerOwner->receiveTighterBound(
-                Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            _symbolicLbOfLb[neuron] += ( entry * inputLb );
+            _symbolicUbOfLb[neuron] += ( entry * inputUb );
+        }
+        else
+        {
+            _symbolicLbOfLb[neuron] += ( entry * inputUb );
+            _symbolicUbOfLb[neuron] += ( entry * inputLb );
+        }
+
+        entry = _symbolicUb[j * _size + neuron];
+
+        if ( entry >= 0 )
+        {
+            _symbolicLbOfUb[neuron] += ( entry * inputLb );
+            _symbolicUbOfUb[neuron] += ( entry * inputUb );
+        }
+        else
+        {
+            _symbolicLbOfUb[neuron] += ( entry * inputUb );
+            _symbolicUbOfUb[neuron] += ( entry * inputLb );
         }
     }
 }
 
+void Layer::storeSymbolicBounds( unsigned neuron, double lb, double ub )
+{
+    if ( _lb[neuron] < lb )
+    {
+        _lb[neuron] = lb;
+        _layerOwner->receiveTighterBound(
+            Tightening( _neuronToVariable[neuron], _lb[neuron], Tightening::LB ) );
+    }
+
+    if ( _ub[neuron] > ub )
+    {
+        _ub[neuron] = ub;
+        _layerOwner->receiveTighterBound(
+            Tightening( _neuronToVariable[neuron], _ub[neuron], Tightening::UB ) );
+    }
+}
+
 void Layer::eliminateVariable( unsigned variable, double value )
 {
     if ( !_variableToNeuron.exists( variable ) )
@@ -1697,6 +2569,8 @@ Layer::Layer( const Layer *other )
     , _inputLayerSize( 0 )
     , _symbolicLb( NULL )
     , _symbolicUb( NULL )
+    , _singleSymbolicLb( NULL )
+    , _singleSymbolicUb( NULL )
     , _symbolicLowerBias( NULL )
     , _symbolicUpperBias( NULL )
     , _symbolicLbOfLb( NULL )
@@ -1714,6 +2588,14 @@ Layer::Layer( const Layer *other )
 
     for ( auto &sourceLayerEntry : other->_sourceLayers )
     {
+        if ( other->_layerToSparseWeights.exists( sourceLayerEntry.first ) )
+        {
+            _sourceLayers[sourceLayerEntry.first] = sourceLayerEntry.second;
+            _layerToSparseWeights[sourceLayerEntry.first] =
+                new SparseWeightMatrix( *other->_layerToSparseWeights[sourceLayerEntry.first] );
+            continue;
+        }
+
         addSourceLayer( sourceLayerEntry.first, sourceLayerEntry.second );
 
         if ( other->_layerToWeights.exists( sourceLayerEntry.first ) )
@@ -1800,6 +2682,10 @@ void Layer::freeMemoryIfNeeded()
         delete[] weights.second;
     _layerToNegativeWeights.clear();
 
+    for ( const auto &weights : _layerToSparseWeights )
+        delete weights.second;
+    _layerToSparseWeights.clear();
+
     if ( _bias )
     {
         delete[] _bias;
@@ -1824,17 +2710,7 @@ void Layer::freeMemoryIfNeeded()
         _ub = NULL;
     }
 
-    if ( _symbolicLb )
-    {
-        delete[] _symbolicLb;
-        _symbolicLb = NULL;
-    }
-
-    if ( _symbolicUb )
-    {
-        delete[] _symbolicUb;
-        _symbolicUb = NULL;
-    }
+    freeSymbolicBounds();
 
     if ( _symbolicLowerBias )
     {
@@ -1959,7 +2835,7 @@ void Layer::dump() const
                 const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
                 for ( unsigned j = 0; j < sourceLayer->getSize(); ++j )
                 {
-                    double weight = _layerToWeights[sourceLayerEntry.first][j * _size + i];
+                    double weight = getWeight( sourceLayerEntry.first, j, i );
                     if ( !FloatUtils::isZero( weight ) )
                     {
                         if ( sourceLayer->_neuronToVariable.exists( j ) )
@@ -2056,6 +2932,7 @@ void Layer::reduceIndexFromAllMaps( unsigned startIndex )
     adjustWeightMapIndexing( _layerToWeights, startIndex );
     adjustWeightMapIndexing( _layerToPositiveWeights, startIndex );
     adjustWeightMapIndexing( _layerToNegativeWeights, startIndex );
+    adjustWeightMapIndexing( _layerToSparseWeights, startIndex );
 
     // Adjust the neuron activations
     for ( auto &neuronToSources : _neuronToActivationSources )
@@ -2076,6 +2953,15 @@ void Layer::adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned star
         map[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
 }
 
+void Layer::adjustWeightMapIndexing( Map<unsigned, SparseWeightMatrix *> &map,
+                                     unsigned startIndex )
+{
+    Map<unsigned, SparseWeightMatrix *> copyOfWeights = map;
+    map.clear();
+    for ( const auto &pair : copyOfWeights )
+        map[pair.first >= startIndex ? pair.first - 1 : pair.first] = pair.second;
+}
+
 void Layer::reduceIndexAfterMerge( unsigned startIndex )
 {
     if ( _layerIndex >= startIndex )
@@ -2108,6 +2994,10 @@ bool Layer::operator==( const Layer &layer ) const
     if ( _sourceLayers != layer._sourceLayers )
         return false;
 
+    // Weights stored in different formats are compared value by value
+    if ( !_layerToSparseWeights.empty() || !layer._layerToSparseWeights.empty() )
+        return compareWeightValues( layer );
+
     if ( !compareWeights( _layerToWeights, layer._layerToWeights ) )
         return false;
 
@@ -2144,6 +3034,24 @@ bool Layer::compareWeights( const Map<unsigned, double *> &map,
     return true;
 }
 
+bool Layer::compareWeightValues( const Layer &layer ) const
+{
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+    {
+        for ( unsigned i = 0; i < sourceLayerEntry.second; ++i )
+        {
+            for ( unsigned j = 0; j < _size; ++j )
+            {
+                if ( getWeight( sourceLayerEntry.first, i, j ) !=
+                     layer.getWeight( sourceLayerEntry.first, i, j ) )
+                    return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 unsigned Layer::getMaxVariable() const
 {
     unsigned result = 0;
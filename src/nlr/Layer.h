@@ -27,6 +27,8 @@
 #include "ReluConstraint.h"
 #include "SigmoidConstraint.h"
 #include "SignConstraint.h"
+#include "SparseWeightMatrix.h"
+#include "ThreadPool.h"
 #include "Vector.h"
 
 namespace NLR {
@@ -60,7 +62,13 @@ public:
     ~Layer();
 
     void setLayerOwner( LayerOwner *layerOwner );
-    void addSourceLayer( unsigned layerNumber, unsigned layerSize );
+
+    /*
+      Add a source layer. The weights from a source layer are stored
+      either as a dense matrix, or, if sparseWeights is set, as a
+      SparseWeightMatrix.
+    */
+    void addSourceLayer( unsigned layerNumber, unsigned layerSize, bool sparseWeights = false );
     void addSuccessorLayer( unsigned layerNumber );
     void removeSourceLayer( unsigned sourceLayer );
     const Map<unsigned, unsigned> &getSourceLayers() const;
@@ -80,6 +88,8 @@ public:
     double *getWeights( unsigned sourceLayerIndex ) const;
     double *getPositiveWeights( unsigned sourceLayerIndex ) const;
     double *getNegativeWeights( unsigned sourceLayerIndex ) const;
+    bool hasSparseWeights( unsigned sourceLayerIndex ) const;
+    const SparseWeightMatrix *getSparseWeights( unsigned sourceLayerIndex ) const;
 
     void setBias( unsigned neuron, double bias );
     double getBias( unsigned neuron ) const;
@@ -107,11 +117,25 @@ public:
     void computeAssignment();
 
     /*
-      Set/get the simulations, or compute it from source layers
+      Set/get the assignments of a batch of inputs, or compute them from
+      source layers. The assignments are stored contiguously, sample by
+      sample: the value of neuron i for sample b is at b * getSize() + i.
+      If a thread pool is given, activation functions are applied to
+      blocks of samples in parallel.
     */
-    void setSimulations( const Vector<Vector<double>> *values );
-    void computeSimulations();
-    const Vector<Vector<double>> *getSimulations() const;
+    void setBatchAssignment( const double *values, unsigned batchSize );
+    const double *getBatchAssignment() const;
+    void computeBatchAssignment( unsigned batchSize, ThreadPool *threadPool = NULL );
+
+    /*
+      Set/get the simulations, or compute them from source layers. The
+      simulations are stored like a batch assignment: the value of neuron
+      i in simulation j is at j * getSize() + i.
+    */
+    void setSimulations( const double *values, unsigned numberOfSimulations );
+    void computeSimulations( ThreadPool *threadPool = NULL );
+    const double *getSimulations() const;
+    unsigned getNumberOfSimulations() const;
 
     /*
       Bound related functionality: grab the current bounds from the
@@ -139,6 +163,19 @@ public:
     void computeSymbolicBounds();
     void computeIntervalArithmeticBounds();
 
+    /*
+      The symbolic bounds of a layer are two matrices of size
+      inputLayerSize * size, allocated when the layer first computes
+      them. They can be freed once every layer that reads them has
+      computed its own bounds, or stored in single precision: the
+      coefficients are rounded to the nearest float, and the biases are
+      moved outwards by the largest error this may cause over the input
+      domain, so that the stored bounds remain sound.
+    */
+    void freeSymbolicBounds();
+    void storeSymbolicBoundsInSinglePrecision();
+    bool hasSymbolicBounds() const;
+
     /*
       Preprocessing functionality: variable elimination and reindexing
     */
@@ -175,11 +212,13 @@ private:
     Map<unsigned, double *> _layerToWeights;
     Map<unsigned, double *> _layerToPositiveWeights;
     Map<unsigned, double *> _layerToNegativeWeights;
+    Map<unsigned, SparseWeightMatrix *> _layerToSparseWeights;
     double *_bias;
 
     double *_assignment;
+    Vector<double> _batchAssignment;
 
-    Vector<Vector<double>> _simulations;
+    Vector<double> _simulations;
 
     double *_lb;
     double *_ub;
@@ -193,6 +232,8 @@ private:
     unsigned _inputLayerSize;
     double *_symbolicLb;
     double *_symbolicUb;
+    float *_singleSymbolicLb;
+    float *_singleSymbolicUb;
     double *_symbolicLowerBias;
     double *_symbolicUpperBias;
     double *_symbolicLbOfLb;
@@ -208,6 +249,32 @@ private:
     void allocateMemory();
     void freeMemoryIfNeeded();
 
+    /*
+      Helper functions for batched evaluation. The values of the batch are
+      stored in the given buffer (the batch assignment or the
+      simulations), and read from the same buffer of the source layers.
+    */
+    typedef Vector<double> Layer::*BatchBuffer;
+    void computeBatch( BatchBuffer buffer, unsigned batchSize, ThreadPool *threadPool );
+    void computeBatchForWeightedSum( BatchBuffer buffer,
+                                     unsigned batchSize,
+                                     ThreadPool *threadPool );
+    void computeBatchForSingleSource( BatchBuffer buffer,
+                                      unsigned batchSize,
+                                      ThreadPool *threadPool );
+    void computeBatchForMultipleSources( BatchBuffer buffer,
+                                         unsigned batchSize,
+                                         ThreadPool *threadPool );
+
+    /*
+      Invoke process( begin, end ) on blocks of samples that cover the
+      batch, in parallel if the thread pool has several threads and the
+      batch is large enough
+    */
+    void forEachSampleBlock( unsigned batchSize,
+                             ThreadPool *threadPool,
+                             const std::function<void( unsigned, unsigned )> &process ) const;
+
     /*
       Helper functions for symbolic bound tightening
     */
@@ -215,8 +282,57 @@ private:
     void computeSymbolicBoundsForRelu();
     void computeSymbolicBoundsForSign();
     void computeSymbolicBoundsForAbsoluteValue();
+    void computeSymbolicBoundsForLeakyRelu();
+    void computeSymbolicBoundsForSigmoid();
+    void computeSymbolicBoundsForRound();
+    void computeSymbolicBoundsForMax();
+    void computeSymbolicBoundsForBilinear();
     void computeSymbolicBoundsForWeightedSum();
+    void computeSymbolicBoundsForSparseWeights( const Layer *sourceLayer,
+                                                const SparseWeightMatrix *weights,
+                                                Vector<double> &lbBuffer,
+                                                Vector<double> &ubBuffer );
     void computeSymbolicBoundsDefault();
+    void allocateSymbolicBounds();
+
+    /*
+      Read the symbolic bounds of a source layer, in whichever precision
+      they are stored: single entries, or blocks of rows (one row per
+      input neuron) that are converted to double precision in the given
+      buffers if needed
+    */
+    double getSymbolicLbEntry( unsigned index ) const
+    {
+        return _symbolicLb ? _symbolicLb[index] : _singleSymbolicLb[index];
+    }
+    double getSymbolicUbEntry( unsigned index ) const
+    {
+        return _symbolicUb ? _symbolicUb[index] : _singleSymbolicUb[index];
+    }
+    unsigned getSymbolicBoundRowsPerBlock() const;
+    void getSymbolicBoundRows( unsigned begin,
+                               unsigned end,
+                               Vector<double> &lbBuffer,
+                               Vector<double> &ubBuffer,
+                               const double *&lb,
+                               const double *&ub ) const;
+
+    /*
+      Helpers for activations whose symbolic bounds are linear
+      relaxations over the symbolic bounds of their sources. The bounds
+      of a neuron start as constants, and each source neuron adds its
+      own symbolic bounds, scaled by the coefficients of the lower and
+      upper relaxation. The result is then concretized over the input
+      layer, and concrete bounds that are tighter than the current ones
+      are reported.
+    */
+    void setSymbolicBoundsToConstants( unsigned neuron, double lb, double ub );
+    void addSymbolicBoundsOfSource( unsigned neuron,
+                                    const NeuronIndex &sourceIndex,
+                                    double lowerCoefficient,
+                                    double upperCoefficient );
+    void concretizeSymbolicBounds( unsigned neuron );
+    void storeSymbolicBounds( unsigned neuron, double lb, double ub );
 
     /*
       Helper functions for interval bound tightening
@@ -236,6 +352,9 @@ private:
     double getSymbolicUbOfUb( unsigned neuron ) const;
 
     void adjustWeightMapIndexing( Map<unsigned, double *> &map, unsigned indexToStart );
+    void adjustWeightMapIndexing( Map<unsigned, SparseWeightMatrix *> &map,
+                                  unsigned indexToStart );
+    bool compareWeightValues( const Layer &layer ) const;
 };
 
 } // namespace NLR
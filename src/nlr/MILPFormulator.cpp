@@ -308,8 +308,10 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
 
     // declare simulations as local var to avoid a problem which can happen due to multi thread
     // process.
-    const Vector<Vector<double>> *simulations =
-        _layerOwner->getLayer( targetIndex )->getSimulations();
+    const Layer *simulatedLayer = _layerOwner->getLayer( targetIndex );
+    const double *simulations = simulatedLayer->getSimulations();
+    unsigned numberOfSimulations = simulatedLayer->getNumberOfSimulations();
+    unsigned simulatedLayerSize = simulatedLayer->getSize();
 
     for ( unsigned i = 0; i < layer->getSize(); ++i )
     {
@@ -326,8 +328,9 @@ void MILPFormulator::optimizeBoundsOfNeuronsWithMILPEncoding( ThreadArgument &ar
         skipTightenUb = false;
 
         // Loop for simulation
-        for ( const auto &simValue : ( *simulations ).get( i ) )
+        for ( unsigned j = 0; j < numberOfSimulations; ++j )
         {
+            double simValue = simulations[j * simulatedLayerSize + i];
             if ( _cutoffInUse && _cutoffValue < simValue ) // If x_lower < 0 < x_sim, do not try to
                                                            // call tightning upper bound.
                 skipTightenUb = true;
@@ -19,6 +19,7 @@
 #include "GurobiWrapper.h"
 #include "LPFormulator.h"
 #include "LayerOwner.h"
+#include "ParallelSolver.h"
 
 #include <atomic>
 #include <boost/chrono.hpp>
@@ -32,6 +32,7 @@
 #include "ReluConstraint.h"
 #include "SignConstraint.h"
 
+#include <algorithm>
 #include <cstring>
 
 #define NLR_LOG( x, ... ) LOG( GlobalConfiguration::NETWORK_LEVEL_REASONER_LOGGING, "NLR: %s\n", x )
@@ -41,6 +42,9 @@ namespace NLR {
 NetworkLevelReasoner::NetworkLevelReasoner()
     : _tableau( NULL )
     , _deepPolyAnalysis( nullptr )
+    , _lpFormulator( nullptr )
+    , _quitRequested( NULL )
+    , _threadPool( nullptr )
 {
 }
 
@@ -69,10 +73,12 @@ void NetworkLevelReasoner::addLayer( unsigned layerIndex, Layer::Type type, unsi
     _layerIndexToLayer[layerIndex] = layer;
 }
 
-void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer, unsigned targetLayer )
+void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer,
+                                               unsigned targetLayer,
+                                               bool sparseWeights )
 {
-    _layerIndexToLayer[targetLayer]->addSourceLayer( sourceLayer,
-                                                     _layerIndexToLayer[sourceLayer]->getSize() );
+    _layerIndexToLayer[targetLayer]->addSourceLayer(
+        sourceLayer, _layerIndexToLayer[sourceLayer]->getSize(), sparseWeights );
 }
 
 void NetworkLevelReasoner::computeSuccessorLayers()
@@ -128,6 +134,19 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
     memcpy( output, outputLayer->getAssignment(), sizeof( double ) * outputLayer->getSize() );
 }
 
+void NetworkLevelReasoner::evaluate( const double *inputs, unsigned batchSize, double *outputs )
+{
+    ThreadPool *threadPool = getThreadPool();
+    _layerIndexToLayer[0]->setBatchAssignment( inputs, batchSize );
+    for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
+        _layerIndexToLayer[i]->computeBatchAssignment( batchSize, threadPool );
+
+    const Layer *outputLayer = _layerIndexToLayer[_layerIndexToLayer.size() - 1];
+    memcpy( outputs,
+            outputLayer->getBatchAssignment(),
+            sizeof( double ) * outputLayer->getSize() * batchSize );
+}
+
 void NetworkLevelReasoner::concretizeInputAssignment( Map<unsigned, double> &assignment )
 {
     Layer *inputLayer = _layerIndexToLayer[0];
@@ -170,11 +189,24 @@ void NetworkLevelReasoner::concretizeInputAssignment( Map<unsigned, double> &ass
     delete[] input;
 }
 
-void NetworkLevelReasoner::simulate( Vector<Vector<double>> *input )
+void NetworkLevelReasoner::simulate( const double *input, unsigned numberOfSimulations )
 {
-    _layerIndexToLayer[0]->setSimulations( input );
+    ThreadPool *threadPool = getThreadPool();
+    _layerIndexToLayer[0]->setSimulations( input, numberOfSimulations );
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
-        _layerIndexToLayer[i]->computeSimulations();
+        _layerIndexToLayer[i]->computeSimulations( threadPool );
+}
+
+ThreadPool *NetworkLevelReasoner::getThreadPool()
+{
+    if ( _threadPool == nullptr )
+    {
+        unsigned numThreads = DeepPolyAnalysis::getNumberOfThreads();
+        if ( numThreads <= 1 )
+            return NULL;
+        _threadPool = std::unique_ptr<ThreadPool>( new ThreadPool( numThreads ) );
+    }
+    return _threadPool.get();
 }
 
 void NetworkLevelReasoner::setNeuronVariable( NeuronIndex index, unsigned variable )
@@ -200,8 +232,44 @@ void NetworkLevelReasoner::clearConstraintTightenings()
 
 void NetworkLevelReasoner::symbolicBoundPropagation()
 {
+    bool streaming = Options::get()->getBool( Options::STREAM_SYMBOLIC_BOUNDS );
+    bool singlePrecision = Options::get()->getBool( Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS );
+
+    /*
+      When streaming, the symbolic bounds of a layer are freed right
+      after the last layer that reads them has computed its own. For a
+      feed-forward network without skip connections, at most two layers
+      hold symbolic bounds at any time.
+    */
+    Vector<unsigned> lastReader;
+    if ( streaming )
+    {
+        for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
+            lastReader.append( i );
+
+        for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
+        {
+            for ( const auto &sourceLayer : _layerIndexToLayer[i]->getSourceLayers() )
+                lastReader[sourceLayer.first] = std::max( lastReader[sourceLayer.first], i );
+        }
+    }
+
     for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
+    {
         _layerIndexToLayer[i]->computeSymbolicBounds();
+
+        if ( singlePrecision )
+            _layerIndexToLayer[i]->storeSymbolicBoundsInSinglePrecision();
+
+        if ( streaming )
+        {
+            for ( unsigned j = 0; j <= i; ++j )
+            {
+                if ( lastReader[j] == i )
+                    _layerIndexToLayer[j]->freeSymbolicBounds();
+            }
+        }
+    }
 }
 
 void NetworkLevelReasoner::deepPolyPropagation()
@@ -211,32 +279,58 @@ void NetworkLevelReasoner::deepPolyPropagation()
     _deepPolyAnalysis->run();
 }
 
+void NetworkLevelReasoner::alphaDeepPolyPropagation()
+{
+    if ( _deepPolyAnalysis == nullptr )
+        _deepPolyAnalysis = std::unique_ptr<DeepPolyAnalysis>( new DeepPolyAnalysis( this ) );
+    _deepPolyAnalysis->runWithOptimizedSlopes();
+}
+
+unsigned NetworkLevelReasoner::getNumDeepPolyLayersExecuted() const
+{
+    return _deepPolyAnalysis ? _deepPolyAnalysis->getNumLayersExecuted() : 0;
+}
+
+unsigned NetworkLevelReasoner::getNumDeepPolyLayersSkipped() const
+{
+    return _deepPolyAnalysis ? _deepPolyAnalysis->getNumLayersSkipped() : 0;
+}
+
+LPFormulator *NetworkLevelReasoner::getLPFormulator()
+{
+    if ( _lpFormulator == nullptr )
+    {
+        _lpFormulator = std::unique_ptr<LPFormulator>( new LPFormulator( this ) );
+        _lpFormulator->setCutoff( 0 );
+    }
+    _lpFormulator->setQuitRequested( _quitRequested );
+    return _lpFormulator.get();
+}
+
 void NetworkLevelReasoner::lpRelaxationPropagation()
 {
-    LPFormulator lpFormulator( this );
-    lpFormulator.setCutoff( 0 );
+    LPFormulator *lpFormulator = getLPFormulator();
 
     if ( Options::get()->getMILPSolverBoundTighteningType() ==
              MILPSolverBoundTighteningType::BACKWARD_ANALYSIS_ONCE ||
          Options::get()->getMILPSolverBoundTighteningType() ==
              MILPSolverBoundTighteningType::BACKWARD_ANALYSIS_CONVERGE )
-        lpFormulator.optimizeBoundsWithLpRelaxation( _layerIndexToLayer, true );
+        lpFormulator->optimizeBoundsWithLpRelaxation( _layerIndexToLayer, true );
     else if ( Options::get()->getMILPSolverBoundTighteningType() ==
               MILPSolverBoundTighteningType::LP_RELAXATION )
-        lpFormulator.optimizeBoundsWithLpRelaxation( _layerIndexToLayer );
+        lpFormulator->optimizeBoundsWithLpRelaxation( _layerIndexToLayer );
     else if ( Options::get()->getMILPSolverBoundTighteningType() ==
               MILPSolverBoundTighteningType::LP_RELAXATION_INCREMENTAL )
-        lpFormulator.optimizeBoundsWithIncrementalLpRelaxation( _layerIndexToLayer );
+        lpFormulator->optimizeBoundsWithIncrementalLpRelaxation( _layerIndexToLayer );
 }
 
 void NetworkLevelReasoner::LPTighteningForOneLayer( unsigned targetIndex )
 {
-    LPFormulator lpFormulator( this );
-    lpFormulator.setCutoff( 0 );
+    LPFormulator *lpFormulator = getLPFormulator();
 
     if ( Options::get()->getMILPSolverBoundTighteningType() ==
          MILPSolverBoundTighteningType::LP_RELAXATION )
-        lpFormulator.optimizeBoundsOfOneLayerWithLpRelaxation( _layerIndexToLayer, targetIndex );
+        lpFormulator->optimizeBoundsOfOneLayerWithLpRelaxation( _layerIndexToLayer, targetIndex );
 
     // TODO: implement for LP_RELAXATION_INCREMENTAL
 }
@@ -333,6 +427,11 @@ const ITableau *NetworkLevelReasoner::getTableau() const
     return _tableau;
 }
 
+void NetworkLevelReasoner::setQuitRequested( const std::atomic_bool *quitRequested )
+{
+    _quitRequested = quitRequested;
+}
+
 void NetworkLevelReasoner::eliminateVariable( unsigned variable, double value )
 {
     for ( auto &layer : _layerIndexToLayer )
@@ -652,6 +751,15 @@ bool NetworkLevelReasoner::suitableForMerging(
     if ( firstLayer->getLayerType() != Layer::WEIGHTED_SUM )
         return false;
 
+    // Sparse weights are not merged, as their product may be much denser
+    if ( secondLayer->hasSparseWeights( firstLayerIndex ) )
+        return false;
+    for ( const auto &pair : firstLayer->getSourceLayers() )
+    {
+        if ( firstLayer->hasSparseWeights( pair.first ) )
+            return false;
+    }
+
     // First layer should not feed into any other layer
     unsigned count = 0;
     for ( unsigned i = 0; i < getNumberOfLayers(); ++i )
@@ -18,6 +18,7 @@
 
 #include "DeepPolyAnalysis.h"
 #include "ITableau.h"
+#include "LPFormulator.h"
 #include "Layer.h"
 #include "LayerOwner.h"
 #include "Map.h"
@@ -45,10 +46,13 @@ public:
     static bool functionTypeSupported( PiecewiseLinearFunctionType type );
 
     /*
-      Populate the NLR by specifying the network's topology.
+      Populate the NLR by specifying the network's topology. The weights
+      of a layer dependency are stored in sparse form if sparseWeights is
+      set.
     */
     void addLayer( unsigned layerIndex, Layer::Type type, unsigned layerSize );
-    void addLayerDependency( unsigned sourceLayer, unsigned targetLayer );
+    void
+    addLayerDependency( unsigned sourceLayer, unsigned targetLayer, bool sparseWeights = false );
     void computeSuccessorLayers();
     void setWeight( unsigned sourceLayer,
                     unsigned sourceNeuron,
@@ -75,6 +79,14 @@ public:
     */
     void evaluate( double *input, double *output );
 
+    /*
+      Perform an evaluation of the network for a batch of inputs. The
+      inputs (and the outputs) of the samples are stored contiguously, one
+      sample after the other. Weighted-sum layers are evaluated as a
+      single matrix product for the whole batch.
+    */
+    void evaluate( const double *inputs, unsigned batchSize, double *outputs );
+
     /*
       Perform an evaluation of the network for the current input variable
       assignment and store the resulting variable assignment in the assignment.
@@ -82,9 +94,11 @@ public:
     void concretizeInputAssignment( Map<unsigned, double> &assignment );
 
     /*
-      Perform a simulation of the network for a specific input
+      Perform simulations of the network for a batch of inputs, stored
+      contiguously one simulation after the other. The simulations of
+      every layer are then available through Layer::getSimulations().
     */
-    void simulate( Vector<Vector<double>> *input );
+    void simulate( const double *input, unsigned numberOfSimulations );
 
     /*
       Bound propagation methods:
@@ -103,6 +117,11 @@ public:
           bound on the upper bound of a ReLU node is negative, that
           ReLU is inactive and its output can be set to 0.
 
+        - DeepPoly: symbolic bounds in terms of the preceding layer,
+          back-substituted to the input layer. With optimized slopes
+          (alpha-DeepPoly), the lower bounds of unstable ReLUs are
+          refined by projected gradient steps between several runs.
+
         - LP Relaxation: invoking an LP solver on a series of LP
           relaxations of the problem we're trying to solve, and
           optimizing the lower and upper bounds of each of the
@@ -119,11 +138,18 @@ public:
     void setTableau( const ITableau *tableau );
     const ITableau *getTableau() const;
 
+    /*
+      A flag through which the owner of the NLR can interrupt the
+      LP-based bound tightening
+    */
+    void setQuitRequested( const std::atomic_bool *quitRequested );
+
     void obtainCurrentBounds( const Query &inputQuery );
     void obtainCurrentBounds();
     void intervalArithmeticBoundPropagation();
     void symbolicBoundPropagation();
     void deepPolyPropagation();
+    void alphaDeepPolyPropagation();
     void lpRelaxationPropagation();
     void LPTighteningForOneLayer( unsigned targetIndex );
     void MILPPropagation();
@@ -134,6 +160,14 @@ public:
     void getConstraintTightenings( List<Tightening> &tightenings );
     void clearConstraintTightenings();
 
+    /*
+      The number of layers executed, and skipped because their bounds
+      were unchanged, by the last invocation of deepPolyPropagation() or
+      alphaDeepPolyPropagation().
+    */
+    unsigned getNumDeepPolyLayersExecuted() const;
+    unsigned getNumDeepPolyLayersSkipped() const;
+
     /*
       For debugging purposes: dump the network topology
     */
@@ -204,6 +238,21 @@ private:
 
     std::unique_ptr<DeepPolyAnalysis> _deepPolyAnalysis;
 
+    /*
+      The LP formulator, with its worker threads and solvers, is kept
+      between calls
+    */
+    std::unique_ptr<LPFormulator> _lpFormulator;
+    const std::atomic_bool *_quitRequested;
+    LPFormulator *getLPFormulator();
+
+    /*
+      Threads for batched evaluations and simulations, created on first
+      use. NULL if only a single thread is available.
+    */
+    std::unique_ptr<ThreadPool> _threadPool;
+    ThreadPool *getThreadPool();
+
     void freeMemoryIfNeeded();
 
     List<PiecewiseLinearConstraint *> _constraintsInTopologicalOrder;
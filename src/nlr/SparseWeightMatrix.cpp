@@ -0,0 +1,138 @@
+/*********************                                                        */
+/*! \file SparseWeightMatrix.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "SparseWeightMatrix.h"
+
+#include "Debug.h"
+
+#include <algorithm>
+
+namespace NLR {
+
+SparseWeightMatrix::SparseWeightMatrix( unsigned sourceSize, unsigned targetSize )
+    : _sourceSize( sourceSize )
+    , _targetSize( targetSize )
+{
+}
+
+unsigned SparseWeightMatrix::getSourceSize() const
+{
+    return _sourceSize;
+}
+
+unsigned SparseWeightMatrix::getTargetSize() const
+{
+    return _targetSize;
+}
+
+unsigned SparseWeightMatrix::getNnz() const
+{
+    return _sources.size();
+}
+
+unsigned SparseWeightMatrix::findEntry( unsigned sourceNeuron, unsigned targetNeuron ) const
+{
+    const unsigned *begin = _sources.data() + getTargetBegin( targetNeuron );
+    const unsigned *end = _sources.data() + getTargetEnd( targetNeuron );
+    return std::lower_bound( begin, end, sourceNeuron ) - _sources.data();
+}
+
+void SparseWeightMatrix::set( unsigned sourceNeuron, unsigned targetNeuron, double weight )
+{
+    ASSERT( sourceNeuron < _sourceSize );
+    ASSERT( targetNeuron < _targetSize );
+
+    unsigned entry = findEntry( sourceNeuron, targetNeuron );
+    if ( entry < getTargetEnd( targetNeuron ) && _sources[entry] == sourceNeuron )
+    {
+        if ( weight != 0 )
+        {
+            _weights[entry] = weight;
+            return;
+        }
+
+        // Remove the entry, and shift the following target neurons
+        auto sourceIt = _sources.begin() + entry;
+        auto weightIt = _weights.begin() + entry;
+        _sources.erase( sourceIt );
+        _weights.erase( weightIt );
+        for ( unsigned i = targetNeuron + 1; i < _targetStart.size(); ++i )
+            --_targetStart[i];
+        return;
+    }
+
+    if ( weight == 0 )
+        return;
+
+    while ( _targetStart.size() <= targetNeuron )
+        _targetStart.append( _sources.size() );
+
+    auto sourceIt = _sources.begin() + entry;
+    auto weightIt = _weights.begin() + entry;
+    _sources.insert( sourceIt, sourceNeuron );
+    _weights.insert( weightIt, weight );
+    for ( unsigned i = targetNeuron + 1; i < _targetStart.size(); ++i )
+        ++_targetStart[i];
+}
+
+double SparseWeightMatrix::get( unsigned sourceNeuron, unsigned targetNeuron ) const
+{
+    ASSERT( sourceNeuron < _sourceSize );
+    ASSERT( targetNeuron < _targetSize );
+
+    unsigned entry = findEntry( sourceNeuron, targetNeuron );
+    if ( entry < getTargetEnd( targetNeuron ) && _sources[entry] == sourceNeuron )
+        return _weights[entry];
+    return 0;
+}
+
+const unsigned *SparseWeightMatrix::getSources() const
+{
+    return _sources.data();
+}
+
+const double *SparseWeightMatrix::getWeights() const
+{
+    return _weights.data();
+}
+
+void SparseWeightMatrix::toDense( double *result ) const
+{
+    std::fill_n( result, _sourceSize * _targetSize, 0 );
+    for ( unsigned i = 0; i < _targetSize; ++i )
+    {
+        for ( unsigned entry = getTargetBegin( i ); entry < getTargetEnd( i ); ++entry )
+            result[_sources[entry] * _targetSize + i] = _weights[entry];
+    }
+}
+
+bool SparseWeightMatrix::operator==( const SparseWeightMatrix &other ) const
+{
+    if ( _sourceSize != other._sourceSize || _targetSize != other._targetSize )
+        return false;
+
+    if ( _sources != other._sources || _weights != other._weights )
+        return false;
+
+    for ( unsigned i = 0; i < _targetSize; ++i )
+    {
+        if ( getTargetBegin( i ) != other.getTargetBegin( i ) )
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace NLR
@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file SparseWeightMatrix.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#ifndef __SparseWeightMatrix_h__
+#define __SparseWeightMatrix_h__
+
+#include "Vector.h"
+
+namespace NLR {
+
+/*
+  A sparse matrix of the weights from a source layer into a target
+  layer, used instead of the dense sourceSize x targetSize matrix for
+  layers in which most weights are zero, e.g. convolutions.
+
+  The matrix is stored in a compressed format by target neuron: the
+  non-zero weights into every target neuron are stored contiguously,
+  sorted by source neuron. Entries getTargetBegin( t ) up to (but not
+  including) getTargetEnd( t ) of getSources() and getWeights() hold the
+  weights into target neuron t.
+
+  Weights set in increasing order of target neurons (as done when a
+  network is constructed neuron by neuron) are appended in amortized
+  constant time; other updates are linear in the number of non-zeros.
+*/
+class SparseWeightMatrix
+{
+public:
+    SparseWeightMatrix( unsigned sourceSize, unsigned targetSize );
+
+    unsigned getSourceSize() const;
+    unsigned getTargetSize() const;
+    unsigned getNnz() const;
+
+    /*
+      Set/get a single weight. Setting a weight to zero removes it.
+    */
+    void set( unsigned sourceNeuron, unsigned targetNeuron, double weight );
+    double get( unsigned sourceNeuron, unsigned targetNeuron ) const;
+
+    /*
+      Access to the compressed representation
+    */
+    inline unsigned getTargetBegin( unsigned targetNeuron ) const
+    {
+        return targetNeuron < _targetStart.size() ? _targetStart[targetNeuron] : _sources.size();
+    }
+
+    inline unsigned getTargetEnd( unsigned targetNeuron ) const
+    {
+        return getTargetBegin( targetNeuron + 1 );
+    }
+
+    const unsigned *getSources() const;
+    const double *getWeights() const;
+
+    /*
+      Store the matrix in dense, source-major form
+    */
+    void toDense( double *result ) const;
+
+    bool operator==( const SparseWeightMatrix &other ) const;
+
+private:
+    unsigned _sourceSize;
+    unsigned _targetSize;
+
+    /*
+      The index of the first entry of every target neuron. Entries are
+      only stored up to the last target neuron with non-zero weights;
+      the rest begin (and end) at the number of non-zeros.
+    */
+    Vector<unsigned> _targetStart;
+
+    Vector<unsigned> _sources;
+    Vector<double> _weights;
+
+    /*
+      Locate the entry of a weight, or the position where it should be
+      inserted, within the entries of its target neuron
+    */
+    unsigned findEntry( unsigned sourceNeuron, unsigned targetNeuron ) const;
+};
+
+} // namespace NLR
+
+#endif // __SparseWeightMatrix_h__
@@ -211,6 +211,357 @@ public:
             TS_ASSERT( existsBound( bounds, bound ) );
     }
 
+    void test_deeppoly_incremental()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetwork( nlr, tableau );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        // The first run executes all layers
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersExecuted(), 6U );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersSkipped(), 0U );
+
+        List<Tightening> expectedBounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( expectedBounds ) );
+        TS_ASSERT_EQUALS( expectedBounds.size(), 20U );
+
+        // Unchanged bounds: all layers are skipped, the tightenings are reported again
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersExecuted(), 0U );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersSkipped(), 6U );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( bounds, expectedBounds );
+
+        // Once the tightenings are applied, the layers are still skipped
+        for ( const auto &bound : expectedBounds )
+        {
+            if ( bound._type == Tightening::LB )
+                tableau.setLowerBound( bound._variable, bound._value );
+            else
+                tableau.setUpperBound( bound._variable, bound._value );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersExecuted(), 0U );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersSkipped(), 6U );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+
+        // Tightening x7 invalidates layer 3 and its successors only
+        tableau.setLowerBound( 7, 0 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersExecuted(), 3U );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersSkipped(), 3U );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        // The results match those of a fresh analysis
+        NLR::NetworkLevelReasoner freshNlr;
+        MockTableau freshTableau;
+        freshNlr.setTableau( &freshTableau );
+        populateNetwork( freshNlr, freshTableau );
+
+        for ( unsigned i = 0; i < 12; ++i )
+        {
+            freshTableau.setLowerBound( i, tableau.getLowerBound( i ) );
+            freshTableau.setUpperBound( i, tableau.getUpperBound( i ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( freshNlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( freshNlr.deepPolyPropagation() );
+        TS_ASSERT_EQUALS( freshNlr.getNumDeepPolyLayersExecuted(), 6U );
+
+        TS_ASSERT_THROWS_NOTHING( freshNlr.getConstraintTightenings( expectedBounds ) );
+        TS_ASSERT( !expectedBounds.empty() );
+        TS_ASSERT_EQUALS( bounds, expectedBounds );
+    }
+
+    void populateSlopeNetwork( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
+    {
+        /*
+                 1      R
+          x0 ------ x1 ---> x3
+            \                 \  1
+             \                 \
+              \ 1       R       x5 + 5
+               \---- x2 ---> x4 /
+                     +10         / -0.5
+
+          x5 = relu( x0 ) - 0.5 x0, as x2 is always positive
+        */
+
+        nlr.addLayer( 0, NLR::Layer::INPUT, 1 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 2, NLR::Layer::RELU, 2 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        nlr.setWeight( 0, 0, 1, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1, 1 );
+        nlr.setBias( 1, 1, 10 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, -0.5 );
+        nlr.setBias( 3, 0, 5 );
+
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 1 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 3 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 4 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 5 );
+
+        double large = 1000000;
+        tableau.getBoundManager().initialize( 6 );
+        for ( unsigned i = 1; i < 6; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        tableau.setLowerBound( 0, -2 );
+        tableau.setUpperBound( 0, 1 );
+    }
+
+    void test_alpha_deeppoly_slopes()
+    {
+        /*
+          x1 is in [-2, 1], so DeepPoly picks the lower bound x3 >= 0 for
+          its ReLU, which gives x5 >= -0.5 x0 >= -0.5. The optimal slope
+          is 0.5: x3 >= 0.5 x1 gives x5 >= 0, which is exact.
+        */
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateSlopeNetwork( nlr, tableau );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 3 )->getLb( 0 ), -0.5 ) );
+        TS_ASSERT( FloatUtils::areEqual( nlr.getLayer( 3 )->getUb( 0 ), 1 ) );
+
+        NLR::NetworkLevelReasoner alphaNlr;
+        MockTableau alphaTableau;
+        alphaNlr.setTableau( &alphaTableau );
+        populateSlopeNetwork( alphaNlr, alphaTableau );
+
+        TS_ASSERT_THROWS_NOTHING( alphaNlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( alphaNlr.alphaDeepPolyPropagation() );
+        TS_ASSERT( FloatUtils::areEqual( alphaNlr.getLayer( 3 )->getLb( 0 ), 0, 0.0001 ) );
+        TS_ASSERT( FloatUtils::areEqual( alphaNlr.getLayer( 3 )->getUb( 0 ), 1 ) );
+        TS_ASSERT( alphaNlr.getNumDeepPolyLayersExecuted() > 4U );
+
+        // The bounds of the other neurons are those of DeepPoly
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            const NLR::Layer *layer = nlr.getLayer( i );
+            const NLR::Layer *alphaLayer = alphaNlr.getLayer( i );
+            for ( unsigned j = 0; j < layer->getSize(); ++j )
+            {
+                TS_ASSERT( FloatUtils::areEqual( layer->getLb( j ), alphaLayer->getLb( j ) ) );
+                TS_ASSERT( FloatUtils::areEqual( layer->getUb( j ), alphaLayer->getUb( j ) ) );
+            }
+        }
+    }
+
+    void test_alpha_deeppoly_no_looser_than_deeppoly()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetwork( nlr, tableau );
+
+        NLR::NetworkLevelReasoner alphaNlr;
+        MockTableau alphaTableau;
+        alphaNlr.setTableau( &alphaTableau );
+        populateNetwork( alphaNlr, alphaTableau );
+
+        for ( MockTableau *t : { &tableau, &alphaTableau } )
+        {
+            t->setLowerBound( 0, -1 );
+            t->setUpperBound( 0, 1 );
+            t->setLowerBound( 1, -1 );
+            t->setUpperBound( 1, 1 );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT_THROWS_NOTHING( alphaNlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( alphaNlr.alphaDeepPolyPropagation() );
+
+        for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+        {
+            const NLR::Layer *layer = nlr.getLayer( i );
+            const NLR::Layer *alphaLayer = alphaNlr.getLayer( i );
+            for ( unsigned j = 0; j < layer->getSize(); ++j )
+            {
+                TS_ASSERT( FloatUtils::gte( alphaLayer->getLb( j ), layer->getLb( j ) ) );
+                TS_ASSERT( FloatUtils::lte( alphaLayer->getUb( j ), layer->getUb( j ) ) );
+            }
+        }
+
+        // The output bounds hold on a grid of inputs
+        double output[2];
+        for ( double x0 = -1; x0 <= 1; x0 += 0.25 )
+        {
+            for ( double x1 = -1; x1 <= 1; x1 += 0.25 )
+            {
+                double input[2] = { x0, x1 };
+                TS_ASSERT_THROWS_NOTHING( alphaNlr.evaluate( input, output ) );
+                const NLR::Layer *outputLayer = alphaNlr.getLayer( 5 );
+                for ( unsigned j = 0; j < 2; ++j )
+                {
+                    TS_ASSERT( FloatUtils::gte( output[j], outputLayer->getLb( j ) ) );
+                    TS_ASSERT( FloatUtils::lte( output[j], outputLayer->getUb( j ) ) );
+                }
+            }
+        }
+    }
+
+    void populateWideNetwork( NLR::NetworkLevelReasoner &nlr,
+                              MockTableau &tableau,
+                              bool sparseWeights = false )
+    {
+        /*
+          A network whose hidden layers are wider than the back-substitution
+          block size, with a residual connection from layer 1 to layer 3:
+
+          x (3) -> WS (300) -> R (300) -> WS (300) -> R (300) -> WS (2)
+        */
+        unsigned sizes[] = { 3, 300, 300, 300, 300, 2 };
+        nlr.addLayer( 0, NLR::Layer::INPUT, sizes[0] );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, sizes[1] );
+        nlr.addLayer( 2, NLR::Layer::RELU, sizes[2] );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, sizes[3] );
+        nlr.addLayer( 4, NLR::Layer::RELU, sizes[4] );
+        nlr.addLayer( 5, NLR::Layer::WEIGHTED_SUM, sizes[5] );
+
+        for ( unsigned i = 1; i <= 5; ++i )
+            nlr.addLayerDependency( i - 1, i, sparseWeights );
+        nlr.addLayerDependency( 1, 3, sparseWeights );
+
+        // Arbitrary, but fixed, weights and biases
+        auto weight = []( unsigned layer, unsigned source, unsigned target ) {
+            return ( ( layer * 7 + source * 31 + target * 17 ) % 13 - 6.0 ) / 6;
+        };
+
+        for ( unsigned layer : { 1, 3, 5 } )
+        {
+            for ( unsigned target = 0; target < sizes[layer]; ++target )
+            {
+                for ( unsigned source = 0; source < sizes[layer - 1]; ++source )
+                    nlr.setWeight(
+                        layer - 1, source, layer, target, weight( layer, source, target ) );
+                nlr.setBias( layer, target, weight( layer, target, target ) );
+            }
+        }
+
+        for ( unsigned target = 0; target < sizes[3]; ++target )
+            for ( unsigned source = 0; source < sizes[1]; ++source )
+                nlr.setWeight( 1, source, 3, target, weight( 0, source, target ) / 4 );
+
+        for ( unsigned neuron = 0; neuron < sizes[2]; ++neuron )
+        {
+            nlr.addActivationSource( 1, neuron, 2, neuron );
+            nlr.addActivationSource( 3, neuron, 4, neuron );
+        }
+
+        // Variable indexing and very loose bounds for neurons except inputs
+        double large = 1000000;
+        unsigned numVariables = 0;
+        for ( unsigned layer = 0; layer <= 5; ++layer )
+            numVariables += sizes[layer];
+        tableau.getBoundManager().initialize( numVariables );
+
+        unsigned variable = 0;
+        for ( unsigned layer = 0; layer <= 5; ++layer )
+        {
+            for ( unsigned neuron = 0; neuron < sizes[layer]; ++neuron )
+            {
+                nlr.setNeuronVariable( NLR::NeuronIndex( layer, neuron ), variable );
+                tableau.setLowerBound( variable, layer == 0 ? -1 : -large );
+                tableau.setUpperBound( variable, layer == 0 ? 1 : large );
+                ++variable;
+            }
+        }
+    }
+
+    void runDeepPolyOnWideNetwork( unsigned numThreads,
+                                   List<Tightening> &bounds,
+                                   bool sparseWeights = false )
+    {
+        Options::get()->setInt( Options::NUM_BLAS_THREADS, numThreads );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateWideNetwork( nlr, tableau, sparseWeights );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.deepPolyPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        Options::get()->setInt( Options::NUM_BLAS_THREADS, 1 );
+    }
+
+    void test_deeppoly_parallel_back_substitution()
+    {
+        List<Tightening> serialBounds;
+        runDeepPolyOnWideNetwork( 1, serialBounds );
+        TS_ASSERT( !serialBounds.empty() );
+
+        // The results do not depend on the number of threads, and are reproducible
+        for ( unsigned numThreads : { 2, 4, 4 } )
+        {
+            List<Tightening> parallelBounds;
+            runDeepPolyOnWideNetwork( numThreads, parallelBounds );
+            TS_ASSERT_EQUALS( parallelBounds, serialBounds );
+        }
+    }
+
+    void test_deeppoly_sparse_weights()
+    {
+        List<Tightening> denseBounds;
+        runDeepPolyOnWideNetwork( 1, denseBounds );
+
+        // Sparse weights give the same bounds, up to the order of summation
+        for ( unsigned numThreads : { 1, 2 } )
+        {
+            List<Tightening> sparseBounds;
+            runDeepPolyOnWideNetwork( numThreads, sparseBounds, true );
+            TS_ASSERT_EQUALS( sparseBounds.size(), denseBounds.size() );
+
+            auto denseBound = denseBounds.begin();
+            for ( const auto &sparseBound : sparseBounds )
+            {
+                TS_ASSERT_EQUALS( sparseBound._variable, denseBound->_variable );
+                TS_ASSERT_EQUALS( sparseBound._type, denseBound->_type );
+                TS_ASSERT( FloatUtils::areEqual( sparseBound._value, denseBound->_value ) );
+                ++denseBound;
+            }
+        }
+    }
+
     void populateResidualNetwork1( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
     {
         /*
@@ -327,6 +678,42 @@ public:
             TS_ASSERT( existsBound( bounds, bound ) );
     }
 
+    void test_alpha_deeppoly_residual_falls_back_to_deeppoly()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateResidualNetwork1( nlr, tableau );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+
+        // Slopes are not optimized through residual connections: DeepPoly runs once
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.alphaDeepPolyPropagation() );
+        TS_ASSERT_EQUALS( nlr.getNumDeepPolyLayersExecuted(), nlr.getNumberOfLayers() );
+
+        List<Tightening> expectedBounds( {
+            Tightening( 1, -1, Tightening::LB ),
+            Tightening( 1, 1, Tightening::UB ),
+            Tightening( 2, 0, Tightening::LB ),
+            Tightening( 2, 1, Tightening::UB ),
+            Tightening( 3, -1, Tightening::LB ),
+            Tightening( 3, 2, Tightening::UB ),
+            Tightening( 4, -1, Tightening::LB ),
+            Tightening( 4, 2, Tightening::UB ),
+            Tightening( 5, 1, Tightening::LB ),
+            Tightening( 5, 6, Tightening::UB ),
+        } );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : expectedBounds )
+            TS_ASSERT( existsBound( bounds, bound ) );
+    }
+
     void populateResidualNetwork2( NLR::NetworkLevelReasoner &nlr, MockTableau &tableau )
     {
         /*
@@ -44,7 +44,7 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete mock );
     }
 
-    void populateNetwork( NLR::NetworkLevelReasoner &nlr )
+    void populateNetwork( NLR::NetworkLevelReasoner &nlr, bool sparseWeights = false )
     {
         /*
                 a
@@ -64,7 +64,7 @@ public:
 
         // Mark layer dependencies
         for ( unsigned i = 1; i <= 5; ++i )
-            nlr.addLayerDependency( i - 1, i );
+            nlr.addLayerDependency( i - 1, i, sparseWeights );
 
         // Set the weights and biases for the weighted sum layers
         nlr.setWeight( 0, 0, 1, 0, 1 );
@@ -395,6 +395,118 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
     }
 
+    void checkBatchEvaluation( NLR::NetworkLevelReasoner &nlr,
+                               unsigned inputSize,
+                               unsigned outputSize,
+                               const Vector<double> &inputs )
+    {
+        unsigned batchSize = inputs.size() / inputSize;
+        Vector<double> outputs( batchSize * outputSize, 0 );
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluate( inputs.data(), batchSize, outputs.data() ) );
+
+        Vector<double> input( inputSize );
+        Vector<double> output( outputSize );
+        for ( unsigned b = 0; b < batchSize; ++b )
+        {
+            for ( unsigned i = 0; i < inputSize; ++i )
+                input[i] = inputs[b * inputSize + i];
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input.data(), output.data() ) );
+            for ( unsigned i = 0; i < outputSize; ++i )
+                TS_ASSERT( FloatUtils::areEqual( outputs[b * outputSize + i], output[i] ) );
+        }
+    }
+
+    void test_evaluate_batch()
+    {
+        Vector<double> inputs( { 1, 1, 1, 2, 0, 0, -3, 0.5, 2.5, -1 } );
+
+        NLR::NetworkLevelReasoner reluNlr;
+        populateNetwork( reluNlr );
+        checkBatchEvaluation( reluNlr, 2, 2, inputs );
+
+        NLR::NetworkLevelReasoner sparseNlr;
+        populateNetwork( sparseNlr, true );
+        checkBatchEvaluation( sparseNlr, 2, 2, inputs );
+
+        NLR::NetworkLevelReasoner sigmoidNlr;
+        populateNetworkWithSigmoids( sigmoidNlr );
+        checkBatchEvaluation( sigmoidNlr, 2, 2, inputs );
+
+        // Batches of a single sample, and repeated evaluations of
+        // different sizes
+        checkBatchEvaluation( reluNlr, 2, 2, Vector<double>( { -1, 3 } ) );
+        checkBatchEvaluation( reluNlr, 2, 2, inputs );
+    }
+
+    void test_evaluate_batch_other_activations()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 3 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 4 );
+        nlr.addLayer( 2, NLR::Layer::LEAKY_RELU, 4 );
+        nlr.addLayer( 3, NLR::Layer::MAX, 2 );
+        nlr.addLayer( 4, NLR::Layer::SOFTMAX, 2 );
+        nlr.addLayer( 5, NLR::Layer::BILINEAR, 1 );
+        nlr.addLayer( 6, NLR::Layer::ROUND, 2 );
+        nlr.addLayer( 7, NLR::Layer::SIGN, 1 );
+        nlr.addLayer( 8, NLR::Layer::WEIGHTED_SUM, 2 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 5; ++i )
+            nlr.addLayerDependency( i - 1, i );
+        nlr.addLayerDependency( 1, 6 );
+        nlr.addLayerDependency( 0, 7 );
+        nlr.addLayerDependency( 5, 8 );
+        nlr.addLayerDependency( 6, 8 );
+        nlr.addLayerDependency( 7, 8 );
+
+        nlr.getLayer( 2 )->setAlpha( 0.1 );
+
+        // Set the weights and biases for the weighted sum layers
+        for ( unsigned i = 0; i < 3; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                nlr.setWeight( 0, i, 1, j, ( i + j ) % 3 ? 1.0 + i - j : -0.5 * j );
+        nlr.setBias( 1, 1, 0.25 );
+        nlr.setBias( 1, 3, -1 );
+
+        nlr.setWeight( 5, 0, 8, 0, 2 );
+        nlr.setWeight( 5, 0, 8, 1, -1 );
+        nlr.setWeight( 6, 0, 8, 0, 1 );
+        nlr.setWeight( 6, 1, 8, 1, 3 );
+        nlr.setWeight( 7, 0, 8, 0, -2 );
+        nlr.setBias( 8, 1, 0.5 );
+
+        // Mark the activation sources
+        for ( unsigned i = 0; i < 4; ++i )
+            nlr.addActivationSource( 1, i, 2, i );
+
+        nlr.addActivationSource( 2, 0, 3, 0 );
+        nlr.addActivationSource( 2, 1, 3, 0 );
+        nlr.addActivationSource( 2, 2, 3, 1 );
+        nlr.addActivationSource( 2, 3, 3, 1 );
+
+        for ( unsigned i = 0; i < 2; ++i )
+            for ( unsigned j = 0; j < 2; ++j )
+                nlr.addActivationSource( 3, j, 4, i );
+
+        nlr.addActivationSource( 4, 0, 5, 0 );
+        nlr.addActivationSource( 4, 1, 5, 0 );
+
+        // Out of order sources, from a non-consecutive layer
+        nlr.addActivationSource( 1, 3, 6, 0 );
+        nlr.addActivationSource( 1, 0, 6, 1 );
+        nlr.addActivationSource( 0, 2, 7, 0 );
+
+        // An eliminated neuron
+        nlr.setNeuronVariable( NLR::NeuronIndex( 6, 1 ), 20 );
+        nlr.eliminateVariable( 20, 7 );
+
+        Vector<double> inputs( { 1, 1, 1, 2, 0, -0.5, -3, 0.5, 2.5, -1, 0, 0, 0.3, -2.2, 4 } );
+        checkBatchEvaluation( nlr, 3, 2, inputs );
+    }
+
     void test_store_into_other()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -1667,6 +1779,453 @@ public:
             TS_ASSERT( expectedBounds.exists( bound ) );
     }
 
+    void populateNetworkSBTWithActivation( NLR::NetworkLevelReasoner &nlr,
+                                           MockTableau &tableau,
+                                           NLR::Layer::Type type )
+    {
+        /*
+          Element-wise activations A:
+
+              2      A       1
+          x0 --- x2 ---> x4 --- x6
+            \    /              /
+           1 \  /              /
+              \/           -1 /
+              /\             /
+           3 /  \           /
+            /    \   A     /
+          x1 --- x3 ---> x5
+              1
+
+          Max and Bilinear, over both x2 and x3, with a skip connection
+          from x2 to the output:
+
+          x4 = A( x2, x3 )
+          x5 = x4 - x2
+        */
+
+        bool elementWise = ( type != NLR::Layer::MAX && type != NLR::Layer::BILINEAR );
+
+        // Create the layers
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 2, type, elementWise ? 2 : 1 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 1 );
+
+        // Mark layer dependencies
+        for ( unsigned i = 1; i <= 3; ++i )
+            nlr.addLayerDependency( i - 1, i );
+
+        // Weights
+        nlr.setWeight( 0, 0, 1, 0, 2 );
+        nlr.setWeight( 0, 0, 1, 1, 1 );
+        nlr.setWeight( 0, 1, 1, 0, 3 );
+        nlr.setWeight( 0, 1, 1, 1, 1 );
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 0 ), 0 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 0, 1 ), 1 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 0 ), 2 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 1, 1 ), 3 );
+        nlr.setNeuronVariable( NLR::NeuronIndex( 2, 0 ), 4 );
+
+        if ( elementWise )
+        {
+            nlr.setWeight( 2, 1, 3, 0, -1 );
+
+            nlr.addActivationSource( 1, 0, 2, 0 );
+            nlr.addActivationSource( 1, 1, 2, 1 );
+
+            nlr.setNeuronVariable( NLR::NeuronIndex( 2, 1 ), 5 );
+            nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 6 );
+        }
+        else
+        {
+            nlr.addLayerDependency( 1, 3 );
+            nlr.setWeight( 1, 0, 3, 0, -1 );
+
+            nlr.addActivationSource( 1, 0, 2, 0 );
+            nlr.addActivationSource( 1, 1, 2, 0 );
+
+            nlr.setNeuronVariable( NLR::NeuronIndex( 3, 0 ), 5 );
+        }
+
+        // Very loose bounds for neurons except inputs
+        double large = 1000000;
+
+        tableau.getBoundManager().initialize( 7 );
+        for ( unsigned i = 2; i < 7; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+    }
+
+    void checkTightenings( const List<Tightening> &expectedBounds, const List<Tightening> &bounds )
+    {
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &expected : expectedBounds )
+        {
+            bool found = false;
+            for ( const auto &bound : bounds )
+            {
+                if ( bound._variable == expected._variable && bound._type == expected._type &&
+                     FloatUtils::areEqual( bound._value, expected._value ) )
+                    found = true;
+            }
+            TS_ASSERT( found );
+        }
+    }
+
+    void test_sbt_leaky_relu()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBTWithActivation( nlr, tableau, NLR::Layer::LEAKY_RELU );
+        nlr.getLayer( 2 )->setAlpha( 0.2 );
+        nlr.setBias( 1, 0, -15 );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        // Invoke SBT
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        /*
+          Input ranges:
+
+          x0: [4, 6]
+          x1: [1, 5]
+
+          Layer 1:
+
+          x2 = 2x0 + 3x1 - 15   : [-4, 12]
+          x3 =  x0 +  x1        : [5, 11]
+
+          The first LeakyReLU is not fixed. Its upper bound is the line
+          through (-4, -0.8) and (12, 12), and since 12 > 4 its lower
+          bound is x2:
+
+          x4.lb = 2x0 + 3x1 - 15               : [-4, 12]
+          x4.ub = 0.8 ( 2x0 + 3x1 - 15 ) + 2.4 : [-0.8, 12]
+
+          The range of the LeakyReLU gives x4 >= -0.8. The second
+          LeakyReLU is active:
+
+          x5.lb = x5.ub = x0 + x1   : [5, 11]
+
+          Layer 2:
+
+          x6.lb = x0 + 2x1 - 15         : [-9, 1]
+          x6.ub = 0.6x0 + 1.4x1 - 9.6   : [-5.8, 1]
+
+          Concretizing x4 and x5 would have given [-11.8, 7].
+        */
+
+        List<Tightening> expectedBounds( {
+            Tightening( 2, -4, Tightening::LB ),
+            Tightening( 2, 12, Tightening::UB ),
+            Tightening( 3, 5, Tightening::LB ),
+            Tightening( 3, 11, Tightening::UB ),
+
+            Tightening( 4, -0.8, Tightening::LB ),
+            Tightening( 4, 12, Tightening::UB ),
+            Tightening( 5, 5, Tightening::LB ),
+            Tightening( 5, 11, Tightening::UB ),
+
+            Tightening( 6, -9, Tightening::LB ),
+            Tightening( 6, 1, Tightening::UB ),
+        } );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        checkTightenings( expectedBounds, bounds );
+        checkBoundsAreSound( nlr, bounds, 4, 6, 1, 5 );
+    }
+
+    void test_sbt_round()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBTWithActivation( nlr, tableau, NLR::Layer::ROUND );
+
+        tableau.setLowerBound( 0, 0 );
+        tableau.setUpperBound( 0, 0.5 );
+        tableau.setLowerBound( 1, 0 );
+        tableau.setUpperBound( 1, 0.5 );
+
+        // Invoke SBT
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        /*
+          Input ranges:
+
+          x0: [0, 0.5]
+          x1: [0, 0.5]
+
+          Layer 1:
+
+          x2 = 2x0 + 3x1   : [0, 2.5]
+          x3 =  x0 +  x1   : [0, 1]
+
+          Neither round is fixed, and x - 0.5 <= round( x ) <= x + 0.5.
+          The ranges of the rounds give x4 in [0, 2] (2.5 rounds to
+          even) and x5 in [0, 1]:
+
+          x4.lb = 2x0 + 3x1 - 0.5   : [-0.5, 2]
+          x4.ub = 2x0 + 3x1 + 0.5   : [0.5, 3]
+
+          x5.lb = x0 + x1 - 0.5     : [-0.5, 0.5]
+          x5.ub = x0 + x1 + 0.5     : [0.5, 1.5]
+
+          Layer 2:
+
+          x6.lb = x0 + 2x1 - 1   : [-1, 0.5]
+          x6.ub = x0 + 2x1 + 1   : [1, 2.5]
+        */
+
+        List<Tightening> expectedBounds( {
+            Tightening( 2, 0, Tightening::LB ),
+            Tightening( 2, 2.5, Tightening::UB ),
+            Tightening( 3, 0, Tightening::LB ),
+            Tightening( 3, 1, Tightening::UB ),
+
+            Tightening( 4, 0, Tightening::LB ),
+            Tightening( 4, 2, Tightening::UB ),
+            Tightening( 5, 0, Tightening::LB ),
+            Tightening( 5, 1, Tightening::UB ),
+
+            Tightening( 6, -1, Tightening::LB ),
+            Tightening( 6, 2.5, Tightening::UB ),
+        } );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        checkTightenings( expectedBounds, bounds );
+        checkBoundsAreSound( nlr, bounds, 0, 0.5, 0, 0.5 );
+    }
+
+    void test_sbt_sigmoid()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBTWithActivation( nlr, tableau, NLR::Layer::SIGMOID );
+        nlr.setBias( 1, 0, -15 );
+        nlr.setBias( 1, 1, -8 );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        // Invoke SBT
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        /*
+          x2 = 2x0 + 3x1 - 15   : [-4, 12]
+          x3 =  x0 +  x1 - 8    : [-3, 3]
+
+          The sigmoids are bounded by the ranges of their sources, and
+          the output x6 = x4 - x5 is tighter than what these ranges
+          alone would give.
+        */
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        checkBoundsAreSound( nlr, bounds, 4, 6, 1, 5 );
+
+        double outputLb = FloatUtils::negativeInfinity();
+        double outputUb = FloatUtils::infinity();
+        for ( const auto &bound : bounds )
+        {
+            if ( bound._variable == 4 && bound._type == Tightening::LB )
+            {
+                TS_ASSERT( FloatUtils::areEqual( bound._value, SigmoidConstraint::sigmoid( -4 ) ) );
+            }
+            else if ( bound._variable == 4 && bound._type == Tightening::UB )
+            {
+                TS_ASSERT( FloatUtils::areEqual( bound._value, SigmoidConstraint::sigmoid( 12 ) ) );
+            }
+            else if ( bound._variable == 6 && bound._type == Tightening::LB )
+            {
+                outputLb = bound._value;
+            }
+            else if ( bound._variable == 6 && bound._type == Tightening::UB )
+            {
+                outputUb = bound._value;
+            }
+        }
+
+        TS_ASSERT( FloatUtils::gt( outputLb,
+                                   SigmoidConstraint::sigmoid( -4 ) -
+                                       SigmoidConstraint::sigmoid( 3 ) ) );
+        TS_ASSERT( FloatUtils::lt( outputUb,
+                                   SigmoidConstraint::sigmoid( 12 ) -
+                                       SigmoidConstraint::sigmoid( -3 ) ) );
+    }
+
+    void test_sbt_max()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBTWithActivation( nlr, tableau, NLR::Layer::MAX );
+
+        tableau.setLowerBound( 0, 4 );
+        tableau.setUpperBound( 0, 6 );
+        tableau.setLowerBound( 1, 1 );
+        tableau.setUpperBound( 1, 5 );
+
+        // Invoke SBT
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        /*
+          x2 = 2x0 + 3x1   : [11, 27]
+          x3 =  x0 +  x1   : [5, 11]
+
+          The max is fixed to x2, and inherits its symbolic bounds:
+
+          x4 = 2x0 + 3x1   : [11, 27]
+          x5 = x4 - x2     : [0, 0]
+        */
+
+        List<Tightening> expectedBounds( {
+            Tightening( 2, 11, Tightening::LB ),
+            Tightening( 2, 27, Tightening::UB ),
+            Tightening( 3, 5, Tightening::LB ),
+            Tightening( 3, 11, Tightening::UB ),
+            Tightening( 4, 11, Tightening::LB ),
+            Tightening( 4, 27, Tightening::UB ),
+            Tightening( 5, 0, Tightening::LB ),
+            Tightening( 5, 0, Tightening::UB ),
+        } );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        checkTightenings( expectedBounds, bounds );
+        checkBoundsAreSound( nlr, bounds, 4, 6, 1, 5 );
+
+        NLR::NetworkLevelReasoner notFixedNlr;
+        MockTableau notFixedTableau;
+        notFixedNlr.setTableau( &notFixedTableau );
+        populateNetworkSBTWithActivation( notFixedNlr, notFixedTableau, NLR::Layer::MAX );
+        notFixedNlr.setBias( 1, 1, 4 );
+
+        notFixedTableau.setLowerBound( 0, 4 );
+        notFixedTableau.setUpperBound( 0, 6 );
+        notFixedTableau.setLowerBound( 1, 1 );
+        notFixedTableau.setUpperBound( 1, 5 );
+
+        TS_ASSERT_THROWS_NOTHING( notFixedNlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( notFixedNlr.symbolicBoundPropagation() );
+
+        /*
+          x2 = 2x0 + 3x1       : [11, 27]
+          x3 =  x0 +  x1 + 4   : [9, 15]
+
+          The max is not fixed. x2 has the largest lower bound, and 27
+          is the largest upper bound:
+
+          x4.lb = 2x0 + 3x1          : [11, 27]
+          x4.ub = 27
+
+          x5.lb = 0
+          x5.ub = 27 - 2x0 - 3x1     : [0, 16]
+
+          Concretizing x4 would have given x5 in [-16, 16].
+        */
+
+        List<Tightening> expectedNotFixedBounds( {
+            Tightening( 2, 11, Tightening::LB ),
+            Tightening( 2, 27, Tightening::UB ),
+            Tightening( 3, 9, Tightening::LB ),
+            Tightening( 3, 15, Tightening::UB ),
+            Tightening( 4, 11, Tightening::LB ),
+            Tightening( 4, 27, Tightening::UB ),
+            Tightening( 5, 0, Tightening::LB ),
+            Tightening( 5, 16, Tightening::UB ),
+        } );
+
+        List<Tightening> notFixedBounds;
+        TS_ASSERT_THROWS_NOTHING( notFixedNlr.getConstraintTightenings( notFixedBounds ) );
+        checkTightenings( expectedNotFixedBounds, notFixedBounds );
+        checkBoundsAreSound( notFixedNlr, notFixedBounds, 4, 6, 1, 5 );
+    }
+
+    void test_sbt_bilinear()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner nlr;
+        MockTableau tableau;
+        nlr.setTableau( &tableau );
+        populateNetworkSBTWithActivation( nlr, tableau, NLR::Layer::BILINEAR );
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, 0 );
+        tableau.setUpperBound( 1, 1 );
+
+        // Invoke SBT
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.symbolicBoundPropagation() );
+
+        /*
+          Input ranges:
+
+          x0: [-1, 1]
+          x1: [0, 1]
+
+          Layer 1:
+
+          x2 = 2x0 + 3x1   : [-2, 5]
+          x3 =  x0 +  x1   : [-1, 2]
+
+          The McCormick relaxation of x4 = x2 * x3:
+
+          x4.lb = -x2 - 2x3 - 2 = -4x0 - 5x1 - 2   : [-11, 2]
+          x4.ub = 2x2 - 2x3 + 4 = 2x0 + 4x1 + 4    : [2, 10]
+
+          The product of the ranges gives x4 >= -5. Finally:
+
+          x5.lb = -6x0 - 8x1 - 2   : [-16, 4]
+          x5.ub = x1 + 4           : [4, 5]
+        */
+
+        List<Tightening> expectedBounds( {
+            Tightening( 2, -2, Tightening::LB ),
+            Tightening( 2, 5, Tightening::UB ),
+            Tightening( 3, -1, Tightening::LB ),
+            Tightening( 3, 2, Tightening::UB ),
+            Tightening( 4, -5, Tightening::LB ),
+            Tightening( 4, 10, Tightening::UB ),
+            Tightening( 5, -16, Tightening::LB ),
+            Tightening( 5, 5, Tightening::UB ),
+        } );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        checkTightenings( expectedBounds, bounds );
+        checkBoundsAreSound( nlr, bounds, -1, 1, 0, 1 );
+    }
+
     void test_generate_input_query()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -1770,6 +2329,13 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
     }
 
+    double
+    getOutputSimulation( NLR::NetworkLevelReasoner &nlr, unsigned neuron, unsigned simulation )
+    {
+        const NLR::Layer *outputLayer = nlr.getLayer( nlr.getNumberOfLayers() - 1 );
+        return outputLayer->getSimulations()[simulation * outputLayer->getSize() + neuron];
+    }
+
     void test_simulate_relus()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -1779,66 +2345,51 @@ public:
         unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
 
         // With ReLUs, Inputs are zeros, only biases count
-        Vector<Vector<double>> simulations1;
-        simulations1.append( Vector<double>( simulationSize, 0 ) );
-        simulations1.append( Vector<double>( simulationSize, 0 ) );
+        Vector<double> simulations1;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations1.append( 0 );
+            simulations1.append( 0 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations1.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                1 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                4 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 4 ) );
         }
 
         // With ReLUs, case 1
-        Vector<Vector<double>> simulations2;
-        simulations2.append( Vector<double>( simulationSize, 1 ) );
-        simulations2.append( Vector<double>( simulationSize, 1 ) );
+        Vector<double> simulations2;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations2.append( 1 );
+            simulations2.append( 1 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations2.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                1 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                1 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 1 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 1 ) );
         }
 
         // With ReLUs, case 1 and 2
-        Vector<Vector<double>> simulations3;
-        simulations3.append( Vector<double>( simulationSize, 1 ) );
-        simulations3.append( Vector<double>( simulationSize, 2 ) );
+        Vector<double> simulations3;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations3.append( 1 );
+            simulations3.append( 2 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations3 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations3.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                0 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 0 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 0 ) );
         }
     }
 
@@ -1851,72 +2402,51 @@ public:
         unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
 
         // case 1
-        Vector<Vector<double>> simulations1;
-        simulations1.append( Vector<double>( simulationSize, 0 ) );
-        simulations1.append( Vector<double>( simulationSize, 0 ) );
+        Vector<double> simulations1;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations1.append( 0 );
+            simulations1.append( 0 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations1.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0.6750,
-                0.0001 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                3.0167,
-                0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 0.6750, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 3.0167, 0.0001 ) );
         }
 
         // case 2
-        Vector<Vector<double>> simulations2;
-        simulations2.append( Vector<double>( simulationSize, 1 ) );
-        simulations2.append( Vector<double>( simulationSize, 1 ) );
+        Vector<double> simulations2;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations2.append( 1 );
+            simulations2.append( 1 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations2.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0.6032,
-                0.0001 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                2.5790,
-                0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 0.6032, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 2.5790, 0.0001 ) );
         }
 
         // case 3
-        Vector<Vector<double>> simulations3;
-        simulations3.append( Vector<double>( simulationSize, 1 ) );
-        simulations3.append( Vector<double>( simulationSize, 2 ) );
+        Vector<double> simulations3;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations3.append( 1 );
+            simulations3.append( 2 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations3 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations3.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0.5045,
-                0.0001 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                2.1957,
-                0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 0.5045, 0.0001 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 2.1957, 0.0001 ) );
         }
     }
 
@@ -1967,32 +2497,30 @@ public:
         unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
 
         // Simulate1
-        Vector<Vector<double>> simulations1;
-        simulations1.append( Vector<double>( simulationSize, 1 ) );
-        simulations1.append( Vector<double>( simulationSize, 1 ) );
+        Vector<double> simulations1;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations1.append( 1 );
+            simulations1.append( 1 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations1.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                2 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 2 ) );
 
         // Simulate2
-        Vector<Vector<double>> simulations2;
-        simulations2.append( Vector<double>( simulationSize, -1 ) );
-        simulations2.append( Vector<double>( simulationSize, 2 ) );
+        Vector<double> simulations2;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations2.append( -1 );
+            simulations2.append( 2 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations2.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                0 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 0 ) );
     }
 
     void test_simulate_relus_and_abs()
@@ -2042,45 +2570,83 @@ public:
         unsigned simulationSize = Options::get()->getInt( Options::NUMBER_OF_SIMULATIONS );
 
         // Simulate1
-        Vector<Vector<double>> simulations1;
-        simulations1.append( Vector<double>( simulationSize, 1 ) );
-        simulations1.append( Vector<double>( simulationSize, 1 ) );
+        Vector<double> simulations1;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations1.append( 1 );
+            simulations1.append( 1 );
+        }
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations1 ) );
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations1.data(), simulationSize ) );
 
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                2 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                2 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 2 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 2 ) );
         }
 
         // Simulate2
-        Vector<Vector<double>> simulations2;
-        simulations2.append( Vector<double>( simulationSize, 1 ) );
-        simulations2.append( Vector<double>( simulationSize, 2 ) );
+        Vector<double> simulations2;
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            simulations2.append( 1 );
+            simulations2.append( 2 );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( nlr.simulate( simulations2.data(), simulationSize ) );
 
-        TS_ASSERT_THROWS_NOTHING( nlr.simulate( &simulations2 ) );
+        for ( unsigned i = 0; i < simulationSize; ++i )
+        {
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 0, i ), 4 ) );
+            TS_ASSERT( FloatUtils::areEqual( getOutputSimulation( nlr, 1, i ), 4 ) );
+        }
+    }
 
+    void test_simulate_in_parallel()
+    {
+        // Enough simulations for the activation layers to be split among
+        // threads
+        unsigned simulationSize = 10000;
+        Vector<double> simulations;
         for ( unsigned i = 0; i < simulationSize; ++i )
         {
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 0 )
-                    .get( i ),
-                4 ) );
-            TS_ASSERT( FloatUtils::areEqual(
-                ( *( nlr.getLayer( nlr.getNumberOfLayers() - 1 )->getSimulations() ) )
-                    .get( 1 )
-                    .get( i ),
-                4 ) );
+            simulations.append( ( i % 7 ) - 3.0 );
+            simulations.append( ( i % 5 ) * 0.5 );
+        }
+
+        NLR::NetworkLevelReasoner sequentialNlr;
+        populateNetwork( sequentialNlr );
+        TS_ASSERT_THROWS_NOTHING( sequentialNlr.simulate( simulations.data(), simulationSize ) );
+
+        Options::get()->setInt( Options::NUM_BLAS_THREADS, 4 );
+        NLR::NetworkLevelReasoner parallelNlr;
+        populateNetwork( parallelNlr );
+        TS_ASSERT_THROWS_NOTHING( parallelNlr.simulate( simulations.data(), simulationSize ) );
+        Options::get()->setInt( Options::NUM_BLAS_THREADS, 1 );
+
+        for ( unsigned i = 0; i < parallelNlr.getNumberOfLayers(); ++i )
+        {
+            const NLR::Layer *sequentialLayer = sequentialNlr.getLayer( i );
+            const NLR::Layer *parallelLayer = parallelNlr.getLayer( i );
+            TS_ASSERT_EQUALS( parallelLayer->getNumberOfSimulations(), simulationSize );
+
+            unsigned size = simulationSize * parallelLayer->getSize();
+            TS_ASSERT_EQUALS(
+                Vector<double>( sequentialLayer->getSimulations(),
+                                sequentialLayer->getSimulations() + size ),
+                Vector<double>( parallelLayer->getSimulations(),
+                                parallelLayer->getSimulations() + size ) );
+        }
+
+        // The simulations agree with evaluating each input
+        for ( unsigned i = 0; i < 20; ++i )
+        {
+            double output[2];
+            TS_ASSERT_THROWS_NOTHING( parallelNlr.evaluate( simulations.data() + 2 * i, output ) );
+            TS_ASSERT(
+                FloatUtils::areEqual( getOutputSimulation( parallelNlr, 0, i ), output[0] ) );
+            TS_ASSERT(
+                FloatUtils::areEqual( getOutputSimulation( parallelNlr, 1, i ), output[1] ) );
         }
     }
 
@@ -2207,4 +2773,352 @@ public:
         for ( const auto &bound : expectedBounds )
             TS_ASSERT( bounds.exists( bound ) );
     }
+
+    void test_sparse_weight_matrix()
+    {
+        NLR::SparseWeightMatrix matrix( 3, 4 );
+
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 2, 1, 5 ) );
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 0, 1, -1 ) );
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 1, 3, 2 ) );
+        // Out of order
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 0, 0, 4 ) );
+        // Overwrite and remove
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 2, 1, 6 ) );
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 1, 3, 0 ) );
+        TS_ASSERT_THROWS_NOTHING( matrix.set( 1, 2, 0 ) );
+
+        TS_ASSERT_EQUALS( matrix.getNnz(), 3U );
+        TS_ASSERT_EQUALS( matrix.get( 0, 0 ), 4 );
+        TS_ASSERT_EQUALS( matrix.get( 0, 1 ), -1 );
+        TS_ASSERT_EQUALS( matrix.get( 2, 1 ), 6 );
+        TS_ASSERT_EQUALS( matrix.get( 1, 3 ), 0 );
+        TS_ASSERT_EQUALS( matrix.get( 1, 1 ), 0 );
+
+        TS_ASSERT_EQUALS( matrix.getTargetBegin( 0 ), 0U );
+        TS_ASSERT_EQUALS( matrix.getTargetEnd( 0 ), 1U );
+        TS_ASSERT_EQUALS( matrix.getTargetBegin( 1 ), 1U );
+        TS_ASSERT_EQUALS( matrix.getTargetEnd( 1 ), 3U );
+        TS_ASSERT_EQUALS( matrix.getTargetBegin( 2 ), matrix.getTargetEnd( 2 ) );
+        TS_ASSERT_EQUALS( matrix.getTargetBegin( 3 ), matrix.getTargetEnd( 3 ) );
+
+        TS_ASSERT_EQUALS( Vector<unsigned>( matrix.getSources(), matrix.getSources() + 3 ),
+                          Vector<unsigned>( { 0, 0, 2 } ) );
+        TS_ASSERT_EQUALS( Vector<double>( matrix.getWeights(), matrix.getWeights() + 3 ),
+                          Vector<double>( { 4, -1, 6 } ) );
+
+        double dense[12];
+        matrix.toDense( dense );
+        TS_ASSERT_EQUALS( Vector<double>( dense, dense + 12 ),
+                          Vector<double>( { 4, -1, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0 } ) );
+    }
+
+    void runBoundPropagation( NLR::NetworkLevelReasoner &nlr,
+                              void ( NLR::NetworkLevelReasoner::*propagation )(),
+                              List<Tightening> &bounds )
+    {
+        MockTableau tableau;
+        tableau.getBoundManager().initialize( 14 );
+
+        tableau.setLowerBound( 0, -3 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 2 );
+
+        double large = 1000;
+        for ( unsigned i = 2; i < 14; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+        nlr.clearConstraintTightenings();
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( ( nlr.*propagation )() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+    }
+
+    void test_sparse_weights()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        NLR::NetworkLevelReasoner denseNlr;
+        NLR::NetworkLevelReasoner sparseNlr;
+        populateNetwork( denseNlr );
+        populateNetwork( sparseNlr, true );
+
+        TS_ASSERT( !denseNlr.getLayer( 3 )->hasSparseWeights( 2 ) );
+        TS_ASSERT( sparseNlr.getLayer( 3 )->hasSparseWeights( 2 ) );
+        TS_ASSERT_EQUALS( sparseNlr.getLayer( 3 )->getSparseWeights( 2 )->getNnz(), 6U );
+        TS_ASSERT_EQUALS( sparseNlr.getLayer( 5 )->getSparseWeights( 4 )->getNnz(), 3U );
+
+        // Layers with the same weights are equal, regardless of their format
+        for ( unsigned i = 0; i <= 5; ++i )
+            TS_ASSERT( *denseNlr.getLayer( i ) == *sparseNlr.getLayer( i ) );
+
+        // Evaluation
+        Vector<Vector<double>> inputs( { { 1, 1 }, { 1, 2 }, { -3, 0.5 } } );
+        for ( auto &input : inputs )
+        {
+            double denseOutput[2];
+            double sparseOutput[2];
+            TS_ASSERT_THROWS_NOTHING( denseNlr.evaluate( input.data(), denseOutput ) );
+            TS_ASSERT_THROWS_NOTHING( sparseNlr.evaluate( input.data(), sparseOutput ) );
+            TS_ASSERT( FloatUtils::areEqual( denseOutput[0], sparseOutput[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( denseOutput[1], sparseOutput[1] ) );
+        }
+
+        // Interval arithmetic, symbolic bound tightening and DeepPoly
+        List<void ( NLR::NetworkLevelReasoner::* )()> propagations = {
+            &NLR::NetworkLevelReasoner::intervalArithmeticBoundPropagation,
+            &NLR::NetworkLevelReasoner::symbolicBoundPropagation,
+            &NLR::NetworkLevelReasoner::deepPolyPropagation,
+        };
+
+        for ( const auto &propagation : propagations )
+        {
+            List<Tightening> denseBounds;
+            List<Tightening> sparseBounds;
+            runBoundPropagation( denseNlr, propagation, denseBounds );
+            runBoundPropagation( sparseNlr, propagation, sparseBounds );
+
+            TS_ASSERT( !denseBounds.empty() );
+            TS_ASSERT_EQUALS( denseBounds.size(), sparseBounds.size() );
+            for ( const auto &bound : denseBounds )
+                TS_ASSERT( sparseBounds.exists( bound ) );
+        }
+
+        // The generated queries are the same
+        Query denseQuery;
+        Query sparseQuery;
+        TS_ASSERT_THROWS_NOTHING( denseNlr.generateQuery( denseQuery ) );
+        TS_ASSERT_THROWS_NOTHING( sparseNlr.generateQuery( sparseQuery ) );
+        TS_ASSERT_EQUALS( denseQuery.getEquations(), sparseQuery.getEquations() );
+    }
+
+    void test_sbt_streaming_and_single_precision()
+    {
+        Options::get()->setString( Options::SYMBOLIC_BOUND_TIGHTENING_TYPE, "sbt" );
+
+        for ( bool sparseWeights : { false, true } )
+        {
+            // A weight that is not representable in single precision
+            NLR::NetworkLevelReasoner nlr;
+            populateNetwork( nlr, sparseWeights );
+            nlr.setWeight( 0, 0, 1, 0, 1.1 );
+
+            List<Tightening> expectedBounds;
+            runBoundPropagation(
+                nlr, &NLR::NetworkLevelReasoner::symbolicBoundPropagation, expectedBounds );
+            TS_ASSERT( !expectedBounds.empty() );
+            for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+                TS_ASSERT( nlr.getLayer( i )->hasSymbolicBounds() );
+
+            // Streaming gives the same bounds, and frees every layer once it has been consumed
+            Options::get()->setBool( Options::STREAM_SYMBOLIC_BOUNDS, true );
+            List<Tightening> streamedBounds;
+            runBoundPropagation(
+                nlr, &NLR::NetworkLevelReasoner::symbolicBoundPropagation, streamedBounds );
+            TS_ASSERT_EQUALS( expectedBounds.size(), streamedBounds.size() );
+            for ( const auto &bound : expectedBounds )
+                TS_ASSERT( streamedBounds.exists( bound ) );
+            for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+                TS_ASSERT( !nlr.getLayer( i )->hasSymbolicBounds() );
+
+            // Single precision storage only loosens the bounds by a rounding error
+            Options::get()->setBool( Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS, true );
+            List<Tightening> singleBounds;
+            runBoundPropagation(
+                nlr, &NLR::NetworkLevelReasoner::symbolicBoundPropagation, singleBounds );
+            TS_ASSERT_EQUALS( expectedBounds.size(), singleBounds.size() );
+            for ( const auto &expected : expectedBounds )
+            {
+                bool found = false;
+                for ( const auto &bound : singleBounds )
+                {
+                    if ( bound._variable == expected._variable && bound._type == expected._type &&
+                         FloatUtils::areEqual( bound._value, expected._value, 0.0001 ) )
+                        found = true;
+                }
+                TS_ASSERT( found );
+            }
+            checkBoundsAreSound( nlr, singleBounds );
+
+            Options::get()->setBool( Options::STREAM_SYMBOLIC_BOUNDS, false );
+            Options::get()->setBool( Options::SINGLE_PRECISION_SYMBOLIC_BOUNDS, false );
+        }
+    }
+
+    void test_sparse_weights_from_query()
+    {
+        /*
+          A convolution-like layer: each of the 30 neurons of the second
+          layer depends on a single neuron of the first layer
+        */
+        Query query;
+        query.setNumberOfVariables( 90 );
+        for ( unsigned i = 0; i < 30; ++i )
+        {
+            query.markInputVariable( i, i );
+            query.setLowerBound( i, -1 );
+            query.setUpperBound( i, 1 );
+
+            Equation equation;
+            equation.addAddend( 2, i );
+            equation.addAddend( -1, 30 + i );
+            equation.setScalar( 0 );
+            query.addEquation( equation );
+
+            query.addPiecewiseLinearConstraint( new ReluConstraint( 30 + i, 60 + i ) );
+            query.markOutputVariable( 60 + i, i );
+        }
+
+        List<Equation> unhandledEquations;
+        Set<unsigned> varsInUnhandledConstraints;
+        TS_ASSERT(
+            query.constructNetworkLevelReasoner( unhandledEquations, varsInUnhandledConstraints ) );
+        NLR::NetworkLevelReasoner *nlr = query.getNetworkLevelReasoner();
+        TS_ASSERT( nlr->getLayer( 1 )->hasSparseWeights( 0 ) );
+        TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getSparseWeights( 0 )->getNnz(), 30U );
+        TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getWeight( 0, 3, 3 ), 2 );
+        TS_ASSERT_EQUALS( nlr->getLayer( 1 )->getWeight( 0, 3, 4 ), 0 );
+
+        double input[30];
+        double output[30];
+        for ( unsigned i = 0; i < 30; ++i )
+            input[i] = i % 2 ? i : -1.0 * i;
+        TS_ASSERT_THROWS_NOTHING( nlr->evaluate( input, output ) );
+        for ( unsigned i = 0; i < 30; ++i )
+            TS_ASSERT( FloatUtils::areEqual( output[i], i % 2 ? 2.0 * i : 0 ) );
+    }
+    void checkBoundsAreSound( NLR::NetworkLevelReasoner &nlr,
+                              const List<Tightening> &bounds,
+                              double x0Lb = -3,
+                              double x0Ub = 1,
+                              double x1Lb = -1,
+                              double x1Ub = 2 )
+    {
+        unsigned steps = 16;
+        for ( unsigned xStep = 0; xStep <= steps; ++xStep )
+        {
+            for ( unsigned yStep = 0; yStep <= steps; ++yStep )
+            {
+                double x = x0Lb + ( x0Ub - x0Lb ) * xStep / steps;
+                double y = x1Lb + ( x1Ub - x1Lb ) * yStep / steps;
+                double input[2] = { x, y };
+                double output[2];
+                TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+
+                Map<unsigned, double> values;
+                for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+                {
+                    const NLR::Layer *layer = nlr.getLayer( i );
+                    for ( unsigned j = 0; j < layer->getSize(); ++j )
+                        values[layer->neuronToVariable( j )] = layer->getAssignment( j );
+                }
+
+                for ( const auto &bound : bounds )
+                {
+                    if ( bound._type == Tightening::LB )
+                    {
+                        TS_ASSERT( FloatUtils::gte( values[bound._variable], bound._value ) );
+                    }
+                    else
+                    {
+                        TS_ASSERT( FloatUtils::lte( values[bound._variable], bound._value ) );
+                    }
+                }
+            }
+        }
+    }
+
+    void test_lp_relaxation_with_native_solver()
+    {
+        String lpSolver = Options::get()->getString( Options::LP_SOLVER );
+        Options::get()->setString( Options::LP_SOLVER, "native" );
+        Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, "lp" );
+
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        List<Tightening> intervalBounds;
+        List<Tightening> lpBounds;
+        runBoundPropagation(
+            nlr, &NLR::NetworkLevelReasoner::intervalArithmeticBoundPropagation, intervalBounds );
+        runBoundPropagation( nlr, &NLR::NetworkLevelReasoner::lpRelaxationPropagation, lpBounds );
+
+        TS_ASSERT( !lpBounds.empty() );
+        checkBoundsAreSound( nlr, lpBounds );
+
+        // The relaxation is at least as tight as interval arithmetic, up to
+        // the loosening of the native solver's bounds for rounding errors
+        double tolerance = 0.000001;
+        for ( const auto &lpBound : lpBounds )
+        {
+            for ( const auto &intervalBound : intervalBounds )
+            {
+                if ( lpBound._variable != intervalBound._variable ||
+                     lpBound._type != intervalBound._type )
+                    continue;
+
+                if ( lpBound._type == Tightening::LB )
+                {
+                    TS_ASSERT(
+                        FloatUtils::gte( lpBound._value, intervalBound._value, tolerance ) );
+                }
+                else
+                {
+                    TS_ASSERT(
+                        FloatUtils::lte( lpBound._value, intervalBound._value, tolerance ) );
+                }
+            }
+        }
+
+        // Several workers find the same bounds
+        Options::get()->setInt( Options::NUM_WORKERS, 4 );
+        NLR::NetworkLevelReasoner parallelNlr;
+        populateNetwork( parallelNlr );
+        List<Tightening> parallelBounds;
+        runBoundPropagation(
+            parallelNlr, &NLR::NetworkLevelReasoner::lpRelaxationPropagation, parallelBounds );
+        Options::get()->setInt( Options::NUM_WORKERS, 1 );
+
+        TS_ASSERT_EQUALS( lpBounds.size(), parallelBounds.size() );
+        for ( const auto &bound : lpBounds )
+        {
+            bool found = false;
+            for ( const auto &parallelBound : parallelBounds )
+            {
+                if ( parallelBound._variable == bound._variable &&
+                     parallelBound._type == bound._type &&
+                     FloatUtils::areEqual( parallelBound._value, bound._value, tolerance ) )
+                    found = true;
+            }
+            TS_ASSERT( found );
+        }
+
+        // A raised quit flag stops the tightening
+        std::atomic_bool quitRequested( true );
+        nlr.setQuitRequested( &quitRequested );
+        List<Tightening> interruptedBounds;
+        runBoundPropagation(
+            nlr, &NLR::NetworkLevelReasoner::lpRelaxationPropagation, interruptedBounds );
+        TS_ASSERT( interruptedBounds.empty() );
+        nlr.setQuitRequested( NULL );
+
+        // The incremental and backward variants
+        List<String> types = { "lp-inc", "backward-once" };
+        for ( const auto &type : types )
+        {
+            Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, type.ascii() );
+            List<Tightening> bounds;
+            runBoundPropagation( nlr, &NLR::NetworkLevelReasoner::lpRelaxationPropagation, bounds );
+            TS_ASSERT( !bounds.empty() );
+            checkBoundsAreSound( nlr, bounds );
+        }
+
+        Options::get()->setString( Options::MILP_SOLVER_BOUND_TIGHTENING_TYPE, "none" );
+        Options::get()->setString( Options::LP_SOLVER, lpSolver.ascii() );
+    }
 };
@@ -120,7 +120,6 @@ void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper
     ASSERT( !FloatUtils::isZero( ci ) );
     Vector<double> rowCoefficients = Vector<double>( _numberOfRows, 0 );
     Vector<double> sum = Vector<double>( _numberOfRows, 0 );
-    SparseUnsortedList tempBound;
 
     for ( unsigned i = 0; i < row._size; ++i )
     {
@@ -144,8 +143,7 @@ void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper
              ( !tempUpper && *_trivialLowerBoundExplanation[curVar] ) )
             continue;
 
-        tempBound = tempUpper ? *_upperBoundExplanations[curVar] : *_lowerBoundExplanations[curVar];
-        addVecTimesScalar( sum, tempBound, realCoefficient );
+        addVecTimesScalar( sum, getExplanation( curVar, tempUpper ), realCoefficient );
     }
 
     // Include lhs as well, if needed
@@ -158,9 +156,7 @@ void BoundExplainer::updateBoundExplanation( const TableauRow &row, bool isUpper
             if ( !( tempUpper && *_trivialUpperBoundExplanation[row._lhs] ) &&
                  !( !tempUpper && *_trivialLowerBoundExplanation[row._lhs] ) )
             {
-                tempBound = tempUpper ? *_upperBoundExplanations[row._lhs]
-                                      : *_lowerBoundExplanations[row._lhs];
-                addVecTimesScalar( sum, tempBound, realCoefficient );
+                addVecTimesScalar( sum, getExplanation( row._lhs, tempUpper ), realCoefficient );
             }
         }
     }
@@ -197,7 +193,6 @@ void BoundExplainer::updateBoundExplanationSparse( const SparseUnsortedList &row
     ASSERT( !FloatUtils::isZero( ci ) );
     Vector<double> rowCoefficients = Vector<double>( _numberOfRows, 0 );
     Vector<double> sum = Vector<double>( _numberOfRows, 0 );
-    SparseUnsortedList tempBound;
 
     for ( const auto &entry : row )
     {
@@ -219,9 +214,7 @@ void BoundExplainer::updateBoundExplanationSparse( const SparseUnsortedList &row
              ( !tempUpper && *_trivialLowerBoundExplanation[entry._index] ) )
             continue;
 
-        tempBound = tempUpper ? *_upperBoundExplanations[entry._index]
-                              : *_lowerBoundExplanations[entry._index];
-        addVecTimesScalar( sum, tempBound, realCoefficient );
+        addVecTimesScalar( sum, getExplanation( entry._index, tempUpper ), realCoefficient );
     }
 
     // Update according to row coefficients
@@ -240,8 +233,11 @@ void BoundExplainer::addVecTimesScalar( Vector<double> &sum,
 
     ASSERT( sum.size() == _numberOfRows );
 
-    for ( const auto &entry : input )
-        sum[entry._index] += scalar * entry._value;
+    const unsigned *indices = input.getIndices();
+    const double *values = input.getValues();
+    unsigned nnz = input.getNnz();
+    for ( unsigned i = 0; i < nnz; ++i )
+        sum[indices[i]] += scalar * values[i];
 }
 
 void BoundExplainer::addVecTimesScalar( Vector<double> &sum,
@@ -0,0 +1,199 @@
+/*********************                                                        */
+/*! \file Test_DnCRemoteWorker.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   agent
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2024 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A DnC remote worker solving subqueries sent over a socket by a test
+ ** acting as the coordinator.
+
+**/
+
+#include "DnCConnection.h"
+#include "DnCProtocol.h"
+#include "DnCRemoteWorker.h"
+#include "Engine.h"
+#include "FloatUtils.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "Query.h"
+#include "ReluConstraint.h"
+
+#include <cxxtest/TestSuite.h>
+#include <memory>
+#include <thread>
+
+class DnCRemoteWorkerTestSuite : public CxxTest::TestSuite
+{
+public:
+    Query inputQuery;
+    std::shared_ptr<Engine> engine;
+
+    void setUp()
+    {
+        // x5 = relu( x0 ) + relu( -x0 ) = |x0|, with x0 in [-1, 1] and
+        // x5 <= 0.25
+        inputQuery = Query();
+        inputQuery.setNumberOfVariables( 6 );
+        inputQuery.setLowerBound( 0, -1 );
+        inputQuery.setUpperBound( 0, 1 );
+        inputQuery.setLowerBound( 5, 0 );
+        inputQuery.setUpperBound( 5, 0.25 );
+
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( -1, 1 );
+        equation1.setScalar( 0 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( 1, 2 );
+        equation2.setScalar( 0 );
+        inputQuery.addEquation( equation2 );
+
+        Equation equation3;
+        equation3.addAddend( 1, 3 );
+        equation3.addAddend( 1, 4 );
+        equation3.addAddend( -1, 5 );
+        equation3.setScalar( 0 );
+        inputQuery.addEquation( equation3 );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 1, 3 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 4 ) );
+
+        engine = std::make_shared<Engine>();
+        engine->setVerbosity( 0 );
+        TS_ASSERT( engine->processInputQuery( inputQuery ) );
+    }
+
+    void tearDown()
+    {
+        engine = nullptr;
+    }
+
+    static SubQuery *createSubQuery( String queryId, double lowerBound, double upperBound )
+    {
+        SubQuery *subQuery = new SubQuery;
+        subQuery->_queryId = queryId;
+        subQuery->_split =
+            std::unique_ptr<PiecewiseLinearCaseSplit>( new PiecewiseLinearCaseSplit );
+        subQuery->_split->storeBoundTightening( Tightening( 0, lowerBound, Tightening::LB ) );
+        subQuery->_split->storeBoundTightening( Tightening( 0, upperBound, Tightening::UB ) );
+        subQuery->_timeoutInSeconds = 0;
+        subQuery->_depth = 1;
+        return subQuery;
+    }
+
+    /*
+      Start a remote worker on its own thread, and accept its connection
+    */
+    DnCConnection *startWorker( DnCListener &listener, std::thread &thread, unsigned &numSolved )
+    {
+        String address = listener.getAddress();
+        thread = std::thread( [this, address, &numSolved] {
+            std::unique_ptr<DnCConnection> connection( DnCConnection::connect( address, 5 ) );
+            DnCRemoteWorker worker( connection.get(), engine, &inputQuery, 0 );
+            numSolved = worker.run();
+        } );
+        return listener.accept();
+    }
+
+    void test_solve_subqueries()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+        std::thread thread;
+        unsigned numSolved = 0;
+        std::unique_ptr<DnCConnection> connection( startWorker( listener, thread, numSolved ) );
+
+        // The worker introduces the query it processed
+        String message;
+        TS_ASSERT( connection->receive( message ) );
+        TS_ASSERT_EQUALS( message, DnCProtocol::encodeHello( *engine->getQuery() ) );
+
+        DnCProtocol::DivideConfig config;
+        config._divideStrategy = SnCDivideStrategy::LargestInterval;
+        config._onlineDivides = 1;
+        config._timeoutFactor = 1.5;
+        connection->send( DnCProtocol::encodeConfig( config ) );
+
+        IEngine::ExitCode result;
+        SubQueries subQueries;
+        Map<unsigned, double> solution;
+
+        // |x0| >= 0.5 on this subquery
+        std::unique_ptr<SubQuery> unsat( createSubQuery( "1", 0.5, 1 ) );
+        connection->send( DnCProtocol::encodeSolve( *unsat ) );
+        TS_ASSERT( connection->receive( message ) );
+        DnCProtocol::decodeResult( message, result, subQueries, solution );
+        TS_ASSERT_EQUALS( result, IEngine::UNSAT );
+        TS_ASSERT( subQueries.empty() );
+        TS_ASSERT( solution.empty() );
+
+        // The worker is reset between subqueries, and finds a solution of
+        // the input query on this one
+        std::unique_ptr<SubQuery> sat( createSubQuery( "2", -0.2, 0.2 ) );
+        connection->send( DnCProtocol::encodeSolve( *sat ) );
+        TS_ASSERT( connection->receive( message ) );
+        DnCProtocol::decodeResult( message, result, subQueries, solution );
+        TS_ASSERT_EQUALS( result, IEngine::SAT );
+        TS_ASSERT( subQueries.empty() );
+        TS_ASSERT_EQUALS( solution.size(), 6U );
+        TS_ASSERT( FloatUtils::gte( solution[0], -0.2 ) );
+        TS_ASSERT( FloatUtils::lte( solution[0], 0.2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution[5], FloatUtils::abs( solution[0] ) ) );
+
+        connection->send( DnCProtocol::encodeQuit() );
+        thread.join();
+        TS_ASSERT_EQUALS( numSolved, 2U );
+    }
+
+    void test_dismissed()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+        std::thread thread;
+        unsigned numSolved = 1;
+        std::unique_ptr<DnCConnection> connection( startWorker( listener, thread, numSolved ) );
+
+        // A coordinator of another query dismisses the worker
+        String message;
+        TS_ASSERT( connection->receive( message ) );
+        connection->send( DnCProtocol::encodeQuit() );
+        thread.join();
+        TS_ASSERT_EQUALS( numSolved, 0U );
+    }
+
+    void test_coordinator_disconnects()
+    {
+        DnCListener listener( DnCListener::localAddress() );
+        std::thread thread;
+        unsigned numSolved = 1;
+        std::unique_ptr<DnCConnection> connection( startWorker( listener, thread, numSolved ) );
+
+        String message;
+        TS_ASSERT( connection->receive( message ) );
+
+        DnCProtocol::DivideConfig config;
+        config._divideStrategy = SnCDivideStrategy::LargestInterval;
+        config._onlineDivides = 1;
+        config._timeoutFactor = 1.5;
+        connection->send( DnCProtocol::encodeConfig( config ) );
+
+        // The worker stops when the connection is closed
+        connection = nullptr;
+        thread.join();
+        TS_ASSERT_EQUALS( numSolved, 0U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//